@@ -18,6 +18,8 @@
 #include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
 #include "base/threading/thread_restrictions.h"
 #include "cc/base/switches.h"
 #include "content/public/browser/browser_main_runner.h"
@@ -78,6 +80,16 @@ bool AwMainDelegate::BasicStartupComplete(int* exit_code) {
   // Disable WebRTC.
   cl->AppendSwitch(switches::kDisableWebRTC);
 
+  // The app's onDraw waits on any visible tile that isn't rastered yet, so
+  // raster on more than the default single worker where there are cores to
+  // spare. That keeps tiles ahead of the viewport during flings.
+  const int kMaxRasterThreads = 2;
+  if (!cl->HasSwitch(cc::switches::kNumRasterThreads) &&
+      base::SysInfo::NumberOfProcessors() > kMaxRasterThreads) {
+    cl->AppendSwitchASCII(cc::switches::kNumRasterThreads,
+                          base::IntToString(kMaxRasterThreads));
+  }
+
   return false;
 }
 
@@ -16,7 +16,8 @@ namespace type_profiler {
 void* NewInterceptForTCMalloc(void* ptr,
                               size_t size,
                               const std::type_info& type) {
-  if (Controller::IsProfiling())
+  // A nothrow new may hand back NULL, and there is nothing to record for it.
+  if (ptr != NULL && Controller::IsProfiling())
     InsertType(ptr, size, type);
 
   return ptr;
@@ -25,7 +26,9 @@ void* NewInterceptForTCMalloc(void* ptr,
 void* DeleteInterceptForTCMalloc(void* ptr,
                                  size_t size,
                                  const std::type_info& type) {
-  if (Controller::IsProfiling())
+  // Deleting NULL is common and never has an entry, so don't take the
+  // profiler's lock for it.
+  if (ptr != NULL && Controller::IsProfiling())
     EraseType(ptr);
 
   return ptr;
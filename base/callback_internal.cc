@@ -4,11 +4,137 @@
 
 #include "base/callback_internal.h"
 
+#include "base/atomicops.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace base {
 namespace internal {
 
+namespace {
+
+// BindStates of up to kMaxRecycledSize bytes are rounded up to a multiple of
+// kSizeClassGranularity, so any freed block of a size class can hold any
+// BindState of that class.
+const size_t kSizeClassGranularity = 16;
+const size_t kMaxRecycledSize = 128;
+const size_t kNumSizeClasses = kMaxRecycledSize / kSizeClassGranularity;
+
+// Bounds the memory a thread can keep for reuse.
+const size_t kMaxFreeBlocksPerSizeClass = 64;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct ThreadFreeLists {
+  FreeBlock* heads[kNumSizeClasses];
+  size_t lengths[kNumSizeClasses];
+  int heap_allocations;
+  int free_list_allocations;
+};
+
+subtle::Atomic32 g_free_lists_enabled = 0;
+
+void DeleteThreadFreeLists(void* value) {
+  ThreadFreeLists* lists = static_cast<ThreadFreeLists*>(value);
+  for (size_t i = 0; i < kNumSizeClasses; ++i) {
+    while (lists->heads[i]) {
+      FreeBlock* block = lists->heads[i];
+      lists->heads[i] = block->next;
+      ::operator delete(block);
+    }
+  }
+  delete lists;
+}
+
+class FreeListsSlot : public ThreadLocalStorage::Slot {
+ public:
+  FreeListsSlot() : ThreadLocalStorage::Slot(&DeleteThreadFreeLists) {}
+};
+
+LazyInstance<FreeListsSlot>::Leaky g_free_lists_slot =
+    LAZY_INSTANCE_INITIALIZER;
+
+bool FreeListsEnabled() {
+  return subtle::NoBarrier_Load(&g_free_lists_enabled) != 0;
+}
+
+ThreadFreeLists* GetThreadFreeLists(bool create) {
+  ThreadFreeLists* lists =
+      static_cast<ThreadFreeLists*>(g_free_lists_slot.Get().Get());
+  if (!lists && create) {
+    lists = new ThreadFreeLists();
+    g_free_lists_slot.Get().Set(lists);
+  }
+  return lists;
+}
+
+size_t SizeClassIndex(size_t size) {
+  return (size - 1) / kSizeClassGranularity;
+}
+
+}  // namespace
+
+// static
+void* BindStateBase::operator new(size_t size) {
+  if (size == 0 || size > kMaxRecycledSize)
+    return ::operator new(size);
+
+  size_t index = SizeClassIndex(size);
+  if (FreeListsEnabled()) {
+    ThreadFreeLists* lists = GetThreadFreeLists(true);
+    FreeBlock* block = lists->heads[index];
+    if (block) {
+      lists->heads[index] = block->next;
+      --lists->lengths[index];
+      ++lists->free_list_allocations;
+      return block;
+    }
+    ++lists->heap_allocations;
+  }
+  return ::operator new((index + 1) * kSizeClassGranularity);
+}
+
+// static
+void BindStateBase::operator delete(void* ptr, size_t size) {
+  if (!ptr)
+    return;
+
+  if (size == 0 || size > kMaxRecycledSize || !FreeListsEnabled()) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  // Don't create free lists for a thread that only frees, e.g. one that is
+  // being torn down.
+  size_t index = SizeClassIndex(size);
+  ThreadFreeLists* lists = GetThreadFreeLists(false);
+  if (!lists || lists->lengths[index] >= kMaxFreeBlocksPerSizeClass) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  FreeBlock* block = static_cast<FreeBlock*>(ptr);
+  block->next = lists->heads[index];
+  lists->heads[index] = block;
+  ++lists->lengths[index];
+}
+
+// static
+void BindStateBase::SetFreeListsEnabled(bool enabled) {
+  subtle::NoBarrier_Store(&g_free_lists_enabled, enabled ? 1 : 0);
+}
+
+// static
+void BindStateBase::GetAllocationCountsForTesting(int* heap_allocations,
+                                                  int* free_list_allocations) {
+  ThreadFreeLists* lists = GetThreadFreeLists(false);
+  *heap_allocations = lists ? lists->heap_allocations : 0;
+  *free_list_allocations = lists ? lists->free_list_allocations : 0;
+}
+
 bool CallbackBase::is_null() const {
   return bind_state_.get() == NULL;
 }
@@ -26,7 +26,27 @@ namespace internal {
 // DoInvoke function to perform the function execution.  This allows
 // us to shield the Callback class from the types of the bound argument via
 // "type erasure."
-class BindStateBase : public RefCountedThreadSafe<BindStateBase> {
+class BASE_EXPORT BindStateBase
+    : public RefCountedThreadSafe<BindStateBase> {
+ public:
+  // A BindState is allocated by every Bind() and for posted tasks usually
+  // dies as soon as the task has run. Small BindStates are allocated in a few
+  // size classes, and once SetFreeListsEnabled(true) has been called they are
+  // recycled through per-thread free lists instead of going back to the heap.
+  // A block freed on another thread than the one that allocated it simply
+  // moves to that thread's free list.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
+  // Turns recycling of freed BindStates on or off for the whole process. Safe
+  // to call at any time and from any thread.
+  static void SetFreeListsEnabled(bool enabled);
+
+  // Returns the number of BindStates the calling thread allocated from the
+  // heap and from its free lists while free lists were enabled.
+  static void GetAllocationCountsForTesting(int* heap_allocations,
+                                            int* free_list_allocations);
+
  protected:
   friend class RefCountedThreadSafe<BindStateBase>;
   virtual ~BindStateBase() {}
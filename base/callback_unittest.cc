@@ -177,5 +177,37 @@ TEST_F(CallbackTest, CallbackHasLastRefOnContainingObject) {
   ASSERT_TRUE(deleted);
 }
 
+void AddToInt(int* value, int amount) {
+  *value += amount;
+}
+
+// Freed BindStates must be handed out again once free lists are enabled, so
+// binding in a loop only reaches the heap for the first callback.
+TEST_F(CallbackTest, BindStateFreeLists) {
+  internal::BindStateBase::SetFreeListsEnabled(true);
+  int start_heap_allocations;
+  int start_free_list_allocations;
+  internal::BindStateBase::GetAllocationCountsForTesting(
+      &start_heap_allocations, &start_free_list_allocations);
+
+  const int kNumCallbacks = 100;
+  int value = 0;
+  for (int i = 0; i < kNumCallbacks; ++i) {
+    Closure callback = Bind(&AddToInt, &value, 1);
+    callback.Run();
+  }
+  EXPECT_EQ(kNumCallbacks, value);
+
+  int heap_allocations;
+  int free_list_allocations;
+  internal::BindStateBase::GetAllocationCountsForTesting(
+      &heap_allocations, &free_list_allocations);
+  EXPECT_LE(heap_allocations - start_heap_allocations, 1);
+  EXPECT_GE(free_list_allocations - start_free_list_allocations,
+            kNumCallbacks - 1);
+
+  internal::BindStateBase::SetFreeListsEnabled(false);
+}
+
 }  // namespace
 }  // namespace base
@@ -0,0 +1,140 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_MAP_H_
+#define BASE_CONTAINERS_FLAT_MAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace base {
+
+// An STL-like associative container which keeps its items sorted by key in a
+// single vector, and finds them by binary search. Lookups and iteration touch
+// contiguous memory rather than chasing tree nodes, which makes this a good
+// fit for maps that are built once (preferably in bulk, with the constructor
+// below) and then mostly read.
+//
+// Inserting or erasing an item moves every item after it, so code which
+// changes a big map often should stick with std::map. Unlike std::map, any
+// insertion or erasure invalidates all iterators and references into the map.
+// Keys must not be modified through an iterator, as that would break the
+// ordering.
+//
+// Compare must be default constructible; comparators with state aren't
+// supported.
+template <typename Key, typename Value, typename Compare = std::less<Key> >
+class FlatMap {
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<Key, Value> value_type;
+  typedef std::vector<value_type> container_type;
+  typedef typename container_type::iterator iterator;
+  typedef typename container_type::const_iterator const_iterator;
+  typedef typename container_type::size_type size_type;
+
+  FlatMap() {}
+
+  // Takes over the contents of |items|, which needn't be sorted, leaving
+  // |items| empty. Where several items have the same key only the first one
+  // is kept. This sorts once, which is cheaper than inserting one at a time.
+  explicit FlatMap(container_type* items) {
+    items_.swap(*items);
+    std::stable_sort(items_.begin(), items_.end(), ItemCompare());
+    items_.erase(std::unique(items_.begin(), items_.end(), ItemEqual()),
+                 items_.end());
+  }
+
+  iterator begin() { return items_.begin(); }
+  const_iterator begin() const { return items_.begin(); }
+  iterator end() { return items_.end(); }
+  const_iterator end() const { return items_.end(); }
+
+  bool empty() const { return items_.empty(); }
+  size_type size() const { return items_.size(); }
+  void clear() { items_.clear(); }
+  void reserve(size_type size) { items_.reserve(size); }
+  void swap(FlatMap& other) { items_.swap(other.items_); }
+
+  iterator lower_bound(const Key& key) {
+    return std::lower_bound(items_.begin(), items_.end(), key, ItemCompare());
+  }
+  const_iterator lower_bound(const Key& key) const {
+    return std::lower_bound(items_.begin(), items_.end(), key, ItemCompare());
+  }
+
+  iterator find(const Key& key) {
+    iterator it = lower_bound(key);
+    if (it == items_.end() || Compare()(key, it->first))
+      return items_.end();
+    return it;
+  }
+  const_iterator find(const Key& key) const {
+    const_iterator it = lower_bound(key);
+    if (it == items_.end() || Compare()(key, it->first))
+      return items_.end();
+    return it;
+  }
+
+  size_type count(const Key& key) const {
+    return find(key) == items_.end() ? 0 : 1;
+  }
+
+  // Inserts |item| unless an item with the same key is already present.
+  // Returns the item with that key, and whether it was inserted.
+  std::pair<iterator, bool> insert(const value_type& item) {
+    iterator it = lower_bound(item.first);
+    if (it != items_.end() && !Compare()(item.first, it->first))
+      return std::make_pair(it, false);
+    return std::make_pair(items_.insert(it, item), true);
+  }
+
+  Value& operator[](const Key& key) {
+    iterator it = lower_bound(key);
+    if (it == items_.end() || Compare()(key, it->first))
+      it = items_.insert(it, value_type(key, Value()));
+    return it->second;
+  }
+
+  // Erases the item at |position| and returns the item which followed it.
+  iterator erase(iterator position) { return items_.erase(position); }
+
+  // Erases the item with |key|, if any, and returns how many were erased.
+  size_type erase(const Key& key) {
+    iterator it = find(key);
+    if (it == items_.end())
+      return 0;
+    items_.erase(it);
+    return 1;
+  }
+
+ private:
+  // Orders items by key, and items against bare keys for binary searches.
+  struct ItemCompare {
+    bool operator()(const value_type& a, const value_type& b) const {
+      return Compare()(a.first, b.first);
+    }
+    bool operator()(const value_type& item, const Key& key) const {
+      return Compare()(item.first, key);
+    }
+    bool operator()(const Key& key, const value_type& item) const {
+      return Compare()(key, item.first);
+    }
+  };
+
+  struct ItemEqual {
+    bool operator()(const value_type& a, const value_type& b) const {
+      return !Compare()(a.first, b.first) && !Compare()(b.first, a.first);
+    }
+  };
+
+  container_type items_;
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_MAP_H_
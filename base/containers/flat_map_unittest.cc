@@ -0,0 +1,103 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_map.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(FlatMap, General) {
+  FlatMap<int, int> m;
+  EXPECT_TRUE(m.empty());
+
+  m[9] = 2;
+  m[0] = 5;
+  EXPECT_FALSE(m.empty());
+  EXPECT_EQ(2u, m.size());
+  EXPECT_EQ(5, m[0]);
+  EXPECT_EQ(2, m[9]);
+
+  // Iteration is in key order.
+  FlatMap<int, int>::const_iterator it = m.begin();
+  EXPECT_EQ(0, it->first);
+  ++it;
+  EXPECT_EQ(9, it->first);
+  ++it;
+  EXPECT_TRUE(it == m.end());
+
+  EXPECT_TRUE(m.find(3) == m.end());
+  EXPECT_EQ(0u, m.count(3));
+  EXPECT_EQ(1u, m.count(9));
+
+  EXPECT_EQ(1u, m.erase(0));
+  EXPECT_EQ(0u, m.erase(0));
+  EXPECT_EQ(1u, m.size());
+  EXPECT_TRUE(m.find(0) == m.end());
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(FlatMap, Insert) {
+  FlatMap<std::string, int> m;
+  std::pair<FlatMap<std::string, int>::iterator, bool> result =
+      m.insert(std::make_pair(std::string("b"), 1));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ("b", result.first->first);
+
+  // An existing key keeps its value.
+  result = m.insert(std::make_pair(std::string("b"), 2));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(1, result.first->second);
+
+  m.insert(std::make_pair(std::string("a"), 3));
+  m.insert(std::make_pair(std::string("c"), 4));
+  ASSERT_EQ(3u, m.size());
+  EXPECT_EQ("a", m.begin()->first);
+  EXPECT_EQ(3, m.find("a")->second);
+  EXPECT_EQ(4, m.find("c")->second);
+
+  FlatMap<std::string, int>::iterator next = m.erase(m.find("a"));
+  EXPECT_EQ("b", next->first);
+}
+
+TEST(FlatMap, BulkConstruct) {
+  std::vector<std::pair<int, int> > items;
+  items.push_back(std::make_pair(3, 30));
+  items.push_back(std::make_pair(1, 10));
+  items.push_back(std::make_pair(3, 31));
+  items.push_back(std::make_pair(2, 20));
+
+  FlatMap<int, int> m(&items);
+  EXPECT_TRUE(items.empty());
+  ASSERT_EQ(3u, m.size());
+
+  // Of the duplicate keys, the first one given wins.
+  EXPECT_EQ(30, m[3]);
+
+  int expected_key = 1;
+  for (FlatMap<int, int>::const_iterator it = m.begin(); it != m.end();
+       ++it, ++expected_key) {
+    EXPECT_EQ(expected_key, it->first);
+    EXPECT_EQ(expected_key * 10, it->second);
+  }
+}
+
+TEST(FlatMap, CustomCompare) {
+  FlatMap<int, int, std::greater<int> > m;
+  m[1] = 1;
+  m[3] = 3;
+  m[2] = 2;
+  EXPECT_EQ(3, m.begin()->first);
+  EXPECT_EQ(2, m.find(2)->second);
+  EXPECT_TRUE(m.find(4) == m.end());
+}
+
+}  // namespace base
@@ -1036,13 +1036,14 @@ TraceEvent* TraceLog::ThreadLocalEventBuffer::AddTraceEvent(
     TraceEventHandle* handle) {
   CheckThisIsCurrentBuffer();
 
-  if (chunk_ && chunk_->IsFull()) {
-    AutoLock lock(trace_log_->lock_);
-    FlushWhileLocked();
-    chunk_.reset();
-  }
-  if (!chunk_) {
+  // Only swapping a full chunk for an empty one touches the shared buffer, so
+  // that is the only time the lock is taken; do it in a single acquisition.
+  if (!chunk_ || chunk_->IsFull()) {
     AutoLock lock(trace_log_->lock_);
+    if (chunk_) {
+      FlushWhileLocked();
+      chunk_.reset();
+    }
     chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
     trace_log_->CheckIfBufferIsFullWhileLocked(notifier);
   }
@@ -51,6 +51,10 @@
 #include "base/os_compat_android.h"
 #endif
 
+#if defined(OS_LINUX)
+#include <sys/sendfile.h>
+#endif
+
 #if !defined(OS_IOS)
 #include <grp.h>
 #endif
@@ -915,11 +919,37 @@ bool CopyFileUnsafe(const FilePath& from_path, const FilePath& to_path) {
     return false;
   }
 
-  const size_t kBufferSize = 32768;
-  std::vector<char> buffer(kBufferSize);
   bool result = true;
+  bool needs_read_write_copy = true;
+
+#if defined(OS_LINUX)
+  // Let the kernel copy the data rather than bouncing it through a user
+  // space buffer. sendfile() between regular files needs Linux 2.6.33; where
+  // it isn't supported it fails with EINVAL or ENOSYS before anything has
+  // been copied, and we fall back to read() and write() below.
+  const size_t kMaxSendfileSize = 0x7ffff000;
+  bool sent_any = false;
+  while (true) {
+    ssize_t bytes_sent =
+        HANDLE_EINTR(sendfile(outfile, infile, NULL, kMaxSendfileSize));
+    if (bytes_sent > 0) {
+      sent_any = true;
+      continue;
+    }
+    if (bytes_sent == 0) {
+      needs_read_write_copy = false;
+    } else if (sent_any || (errno != EINVAL && errno != ENOSYS)) {
+      result = false;
+      needs_read_write_copy = false;
+    }
+    break;
+  }
+#endif
+
+  const size_t kBufferSize = 32768;
+  std::vector<char> buffer(needs_read_write_copy ? kBufferSize : 0);
 
-  while (result) {
+  while (result && needs_read_write_copy) {
     ssize_t bytes_read = HANDLE_EINTR(read(infile, &buffer[0], buffer.size()));
     if (bytes_read < 0) {
       result = false;
@@ -9,6 +9,18 @@
 
 namespace base {
 
+const MemoryMappedFile::Region MemoryMappedFile::Region::kWholeFile(0, -1);
+
+MemoryMappedFile::Region::Region(int64 offset, int64 size)
+    : offset(offset),
+      size(size) {
+}
+
+bool MemoryMappedFile::Region::operator==(
+    const MemoryMappedFile::Region& other) const {
+  return other.offset == offset && other.size == size;
+}
+
 MemoryMappedFile::~MemoryMappedFile() {
   CloseHandles();
 }
@@ -26,12 +38,21 @@ bool MemoryMappedFile::Initialize(const FilePath& file_name) {
 }
 
 bool MemoryMappedFile::Initialize(PlatformFile file) {
+  return Initialize(file, Region::kWholeFile);
+}
+
+bool MemoryMappedFile::Initialize(PlatformFile file, const Region& region) {
   if (IsValid())
     return false;
 
+  if (!(region == Region::kWholeFile)) {
+    DCHECK_GE(region.offset, 0);
+    DCHECK_GT(region.size, 0);
+  }
+
   file_ = file;
 
-  if (!MapFileToMemoryInternal()) {
+  if (!MapFileToMemoryInternal(region)) {
     CloseHandles();
     return false;
   }
@@ -52,7 +73,7 @@ bool MemoryMappedFile::MapFileToMemory(const FilePath& file_name) {
     return false;
   }
 
-  return MapFileToMemoryInternal();
+  return MapFileToMemoryInternal(Region::kWholeFile);
 }
 
 }  // namespace base
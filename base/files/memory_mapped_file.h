@@ -20,6 +20,36 @@ class FilePath;
 
 class BASE_EXPORT MemoryMappedFile {
  public:
+  // The part of a file to map. |offset| need not be aligned to a page
+  // boundary; data() will point at |offset| regardless.
+  struct BASE_EXPORT Region {
+    static const Region kWholeFile;
+
+    Region(int64 offset, int64 size);
+
+    bool operator==(const Region& other) const;
+
+    // Start of the region (measured in bytes from the beginning of the file).
+    int64 offset;
+
+    // Length of the region in bytes.
+    int64 size;
+  };
+
+  // Hints about how the mapped memory is going to be read, used to tune the
+  // kernel's readahead. They are only advisory and are ignored on platforms
+  // that have no equivalent.
+  enum AccessHint {
+    // No particular pattern. This is the default.
+    ACCESS_NORMAL,
+    // The mapping will be read mostly from start to end.
+    ACCESS_SEQUENTIAL,
+    // The mapping will be read at scattered offsets; readahead is wasted.
+    ACCESS_RANDOM,
+    // The whole mapping will be needed soon; start reading it in now.
+    ACCESS_WILL_NEED,
+  };
+
   // The default constructor sets all members to invalid/null values.
   MemoryMappedFile();
   ~MemoryMappedFile();
@@ -34,6 +64,10 @@ class BASE_EXPORT MemoryMappedFile {
   // ownership of |file| and close it when done.
   bool Initialize(PlatformFile file);
 
+  // As above, but maps only the given |region| of |file|. The region must lie
+  // entirely within the file.
+  bool Initialize(PlatformFile file, const Region& region);
+
 #if defined(OS_WIN)
   // Opens an existing file and maps it as an image section. Please refer to
   // the Initialize function above for additional information.
@@ -46,13 +80,19 @@ class BASE_EXPORT MemoryMappedFile {
   // Is file_ a valid file handle that points to an open, memory mapped file?
   bool IsValid() const;
 
+  // Tells the system how the mapping is going to be accessed. Touching the
+  // pages is not required for the hint to take effect, so this is cheap
+  // enough to call right after Initialize() on the startup path.
+  void Advise(AccessHint hint);
+
  private:
   // Open the given file and pass it to MapFileToMemoryInternal().
   bool MapFileToMemory(const FilePath& file_name);
 
-  // Map the file to memory, set data_ to that memory address. Return true on
-  // success, false on any kind of failure. This is a helper for Initialize().
-  bool MapFileToMemoryInternal();
+  // Map |region| of the file to memory, set data_ to that memory address.
+  // Return true on success, false on any kind of failure. This is a helper
+  // for Initialize().
+  bool MapFileToMemoryInternal(const Region& region);
 
   // Closes all open handles. Later we may want to make this public.
   void CloseHandles();
@@ -60,11 +100,14 @@ class BASE_EXPORT MemoryMappedFile {
 #if defined(OS_WIN)
   // MapFileToMemoryInternal calls this function. It provides the ability to
   // pass in flags which control the mapped section.
-  bool MapFileToMemoryInternalEx(int flags);
+  bool MapFileToMemoryInternalEx(const Region& region, int flags);
 
   HANDLE file_mapping_;
 #endif
   PlatformFile file_;
+  // Start of the mapping. This differs from data_ when the requested region
+  // does not start on an allocation boundary.
+  uint8* map_start_;
   uint8* data_;
   size_t length_;
 
@@ -16,11 +16,12 @@ namespace base {
 
 MemoryMappedFile::MemoryMappedFile()
     : file_(kInvalidPlatformFileValue),
+      map_start_(NULL),
       data_(NULL),
       length_(0) {
 }
 
-bool MemoryMappedFile::MapFileToMemoryInternal() {
+bool MemoryMappedFile::MapFileToMemoryInternal(const Region& region) {
   ThreadRestrictions::AssertIOAllowed();
 
   struct stat file_stat;
@@ -28,24 +29,70 @@ bool MemoryMappedFile::MapFileToMemoryInternal() {
     DPLOG(ERROR) << "fstat " << file_;
     return false;
   }
-  length_ = file_stat.st_size;
 
-  data_ = static_cast<uint8*>(
-      mmap(NULL, length_, PROT_READ, MAP_SHARED, file_, 0));
-  if (data_ == MAP_FAILED)
+  off_t map_offset = 0;
+  size_t data_offset = 0;
+  if (region == Region::kWholeFile) {
+    length_ = file_stat.st_size;
+  } else {
+    if (region.offset + region.size > file_stat.st_size) {
+      DLOG(ERROR) << "Region exceeds the size of file " << file_;
+      return false;
+    }
+    // mmap() needs a page-aligned offset, so map from the start of the page
+    // holding |region.offset| and hand out a pointer into that mapping.
+    const int64 page_size = getpagesize();
+    map_offset = region.offset - region.offset % page_size;
+    data_offset = static_cast<size_t>(region.offset - map_offset);
+    length_ = static_cast<size_t>(region.size);
+  }
+
+  void* map_start = mmap(NULL, length_ + data_offset, PROT_READ, MAP_SHARED,
+                         file_, map_offset);
+  if (map_start == MAP_FAILED) {
     DPLOG(ERROR) << "mmap " << file_;
+    return false;
+  }
+
+  map_start_ = static_cast<uint8*>(map_start);
+  data_ = map_start_ + data_offset;
+  return true;
+}
+
+void MemoryMappedFile::Advise(AccessHint hint) {
+  if (!IsValid())
+    return;
+
+  int advice = MADV_NORMAL;
+  switch (hint) {
+    case ACCESS_NORMAL:
+      advice = MADV_NORMAL;
+      break;
+    case ACCESS_SEQUENTIAL:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case ACCESS_RANDOM:
+      advice = MADV_RANDOM;
+      break;
+    case ACCESS_WILL_NEED:
+      advice = MADV_WILLNEED;
+      break;
+  }
 
-  return data_ != MAP_FAILED;
+  size_t map_length = length_ + (data_ - map_start_);
+  if (madvise(map_start_, map_length, advice) != 0)
+    DPLOG(ERROR) << "madvise " << file_;
 }
 
 void MemoryMappedFile::CloseHandles() {
   ThreadRestrictions::AssertIOAllowed();
 
-  if (data_ != NULL)
-    munmap(data_, length_);
+  if (map_start_ != NULL)
+    munmap(map_start_, length_ + (data_ - map_start_));
   if (file_ != kInvalidPlatformFileValue)
     ignore_result(HANDLE_EINTR(close(file_)));
 
+  map_start_ = NULL;
   data_ = NULL;
   length_ = 0;
   file_ = kInvalidPlatformFileValue;
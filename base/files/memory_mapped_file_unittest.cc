@@ -0,0 +1,113 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/memory_mapped_file.h"
+
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/platform_file.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Each byte holds the low bits of its own offset, so any slice of the file
+// can be checked without keeping a copy around.
+std::string CreateTestContents(size_t size) {
+  std::string contents(size, '\0');
+  for (size_t i = 0; i < size; ++i)
+    contents[i] = static_cast<char>(i % 251);
+  return contents;
+}
+
+bool CheckBufferContents(const uint8* data, size_t size, size_t offset) {
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] != (offset + i) % 251)
+      return false;
+  }
+  return true;
+}
+
+class MemoryMappedFileTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.path().AppendASCII("mapped");
+  }
+
+  void CreateFile(size_t size) {
+    std::string contents = CreateTestContents(size);
+    ASSERT_EQ(static_cast<int>(size),
+              file_util::WriteFile(path_, contents.data(),
+                                   static_cast<int>(size)));
+  }
+
+  PlatformFile OpenFile() {
+    return CreatePlatformFile(path_, PLATFORM_FILE_OPEN | PLATFORM_FILE_READ,
+                              NULL, NULL);
+  }
+
+  ScopedTempDir temp_dir_;
+  FilePath path_;
+};
+
+TEST_F(MemoryMappedFileTest, MapWholeFile) {
+  const size_t kFileSize = 68 * 1024;
+  CreateFile(kFileSize);
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(path_));
+  ASSERT_EQ(kFileSize, map.length());
+  ASSERT_TRUE(map.data() != NULL);
+  EXPECT_TRUE(map.IsValid());
+  EXPECT_TRUE(CheckBufferContents(map.data(), kFileSize, 0));
+}
+
+TEST_F(MemoryMappedFileTest, MapPartialRegionAtBeginning) {
+  const size_t kFileSize = 68 * 1024;
+  const size_t kPartialSize = 4 * 1024 + 32;
+  CreateFile(kFileSize);
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile(),
+                             MemoryMappedFile::Region(0, kPartialSize)));
+  ASSERT_EQ(kPartialSize, map.length());
+  EXPECT_TRUE(CheckBufferContents(map.data(), kPartialSize, 0));
+}
+
+TEST_F(MemoryMappedFileTest, MapUnalignedRegionInTheMiddle) {
+  const size_t kFileSize = 157 * 1024;
+  const size_t kOffset = 1024 * 64 + 13;
+  const size_t kPartialSize = 16 * 1024 - 27;
+  CreateFile(kFileSize);
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile(),
+                             MemoryMappedFile::Region(kOffset, kPartialSize)));
+  ASSERT_EQ(kPartialSize, map.length());
+  EXPECT_TRUE(CheckBufferContents(map.data(), kPartialSize, kOffset));
+}
+
+TEST_F(MemoryMappedFileTest, RegionPastEndOfFileFails) {
+  const size_t kFileSize = 8 * 1024;
+  CreateFile(kFileSize);
+  MemoryMappedFile map;
+  EXPECT_FALSE(map.Initialize(OpenFile(),
+                              MemoryMappedFile::Region(4096, kFileSize)));
+  EXPECT_FALSE(map.IsValid());
+}
+
+TEST_F(MemoryMappedFileTest, AdviseKeepsContents) {
+  const size_t kFileSize = 32 * 1024;
+  CreateFile(kFileSize);
+  MemoryMappedFile map;
+  ASSERT_TRUE(map.Initialize(OpenFile(),
+                             MemoryMappedFile::Region(100, kFileSize - 100)));
+  map.Advise(MemoryMappedFile::ACCESS_WILL_NEED);
+  map.Advise(MemoryMappedFile::ACCESS_RANDOM);
+  EXPECT_TRUE(CheckBufferContents(map.data(), map.length(), 100));
+}
+
+}  // namespace
+
+}  // namespace base
@@ -15,6 +15,7 @@ namespace base {
 MemoryMappedFile::MemoryMappedFile()
     : file_(INVALID_HANDLE_VALUE),
       file_mapping_(INVALID_HANDLE_VALUE),
+      map_start_(NULL),
       data_(NULL),
       length_(INVALID_FILE_SIZE) {
 }
@@ -30,7 +31,7 @@ bool MemoryMappedFile::InitializeAsImageSection(const FilePath& file_name) {
     return false;
   }
 
-  if (!MapFileToMemoryInternalEx(SEC_IMAGE)) {
+  if (!MapFileToMemoryInternalEx(Region::kWholeFile, SEC_IMAGE)) {
     CloseHandles();
     return false;
   }
@@ -38,11 +39,12 @@ bool MemoryMappedFile::InitializeAsImageSection(const FilePath& file_name) {
   return true;
 }
 
-bool MemoryMappedFile::MapFileToMemoryInternal() {
-  return MapFileToMemoryInternalEx(0);
+bool MemoryMappedFile::MapFileToMemoryInternal(const Region& region) {
+  return MapFileToMemoryInternalEx(region, 0);
 }
 
-bool MemoryMappedFile::MapFileToMemoryInternalEx(int flags) {
+bool MemoryMappedFile::MapFileToMemoryInternalEx(const Region& region,
+                                                 int flags) {
   ThreadRestrictions::AssertIOAllowed();
 
   if (file_ == INVALID_HANDLE_VALUE)
@@ -52,6 +54,22 @@ bool MemoryMappedFile::MapFileToMemoryInternalEx(int flags) {
   if (length_ == INVALID_FILE_SIZE)
     return false;
 
+  uint64 map_offset = 0;
+  size_t data_offset = 0;
+  size_t map_length = 0;  // Zero maps to the end of the file.
+  if (!(region == Region::kWholeFile)) {
+    if (region.offset + region.size > static_cast<int64>(length_))
+      return false;
+    // Views must start on an allocation granularity boundary.
+    SYSTEM_INFO system_info;
+    ::GetSystemInfo(&system_info);
+    const int64 granularity = system_info.dwAllocationGranularity;
+    map_offset = region.offset - region.offset % granularity;
+    data_offset = static_cast<size_t>(region.offset - map_offset);
+    length_ = static_cast<size_t>(region.size);
+    map_length = length_ + data_offset;
+  }
+
   file_mapping_ = ::CreateFileMapping(file_, NULL, PAGE_READONLY | flags,
                                       0, 0, NULL);
   if (!file_mapping_) {
@@ -62,23 +80,33 @@ bool MemoryMappedFile::MapFileToMemoryInternalEx(int flags) {
     return false;
   }
 
-  data_ = static_cast<uint8*>(
-      ::MapViewOfFile(file_mapping_, FILE_MAP_READ, 0, 0, 0));
-  if (!data_) {
+  map_start_ = static_cast<uint8*>(
+      ::MapViewOfFile(file_mapping_, FILE_MAP_READ,
+                      static_cast<DWORD>(map_offset >> 32),
+                      static_cast<DWORD>(map_offset), map_length));
+  if (!map_start_) {
     UMA_HISTOGRAM_ENUMERATION("MemoryMappedFile.MapViewOfFile",
                               logging::GetLastSystemErrorCode(), 16000);
+    return false;
   }
-  return data_ != NULL;
+  data_ = map_start_ + data_offset;
+  return true;
+}
+
+void MemoryMappedFile::Advise(AccessHint hint) {
+  // There is no madvise() equivalent available on all supported versions of
+  // Windows; the file cache's own readahead is left to do its job.
 }
 
 void MemoryMappedFile::CloseHandles() {
-  if (data_)
-    ::UnmapViewOfFile(data_);
+  if (map_start_)
+    ::UnmapViewOfFile(map_start_);
   if (file_mapping_ != INVALID_HANDLE_VALUE)
     ::CloseHandle(file_mapping_);
   if (file_ != INVALID_HANDLE_VALUE)
     ::CloseHandle(file_);
 
+  map_start_ = NULL;
   data_ = NULL;
   file_mapping_ = file_ = INVALID_HANDLE_VALUE;
   length_ = INVALID_FILE_SIZE;
@@ -4,6 +4,7 @@
 
 #include "base/json/json_parser.h"
 
+#include "base/auto_reset.h"
 #include "base/float_util.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -186,6 +187,7 @@ class StackMarker {
 
 JSONParser::JSONParser(int options)
     : options_(options),
+      handler_(NULL),
       start_pos_(NULL),
       pos_(NULL),
       end_pos_(NULL),
@@ -203,15 +205,47 @@ JSONParser::~JSONParser() {
 
 Value* JSONParser::Parse(const StringPiece& input) {
   scoped_ptr<std::string> input_copy;
+  StringPiece json(input);
   // If the children of a JSON root can be detached, then hidden roots cannot
   // be used, so do not bother copying the input because StringPiece will not
   // be used anywhere.
   if (!(options_ & JSON_DETACHABLE_CHILDREN)) {
     input_copy.reset(new std::string(input.as_string()));
-    start_pos_ = input_copy->data();
-  } else {
-    start_pos_ = input.data();
+    json = *input_copy;
   }
+
+  JSONValueBuilder builder(json, options_);
+  if (!ParseWithHandler(json, &builder))
+    return NULL;
+  scoped_ptr<Value> root(builder.TakeRoot());
+  if (!root.get())
+    return NULL;
+
+  // Dictionaries and lists can contain JSONStringValues, so wrap them in a
+  // hidden root.
+  if (!(options_ & JSON_DETACHABLE_CHILDREN)) {
+    if (root->IsType(Value::TYPE_DICTIONARY)) {
+      return new DictionaryHiddenRootValue(input_copy.release(), root.get());
+    } else if (root->IsType(Value::TYPE_LIST)) {
+      return new ListHiddenRootValue(input_copy.release(), root.get());
+    } else if (root->IsType(Value::TYPE_STRING)) {
+      // A string type could be a JSONStringValue, but because there's no
+      // corresponding HiddenRootValue, the memory will be lost. Deep copy to
+      // preserve it.
+      return root->DeepCopy();
+    }
+  }
+
+  // All other values can be returned directly.
+  return root.release();
+}
+
+bool JSONParser::ParseWithHandler(const StringPiece& input,
+                                  JSONReader::Handler* handler) {
+  DCHECK(handler);
+  AutoReset<JSONReader::Handler*> auto_reset_handler(&handler_, handler);
+
+  start_pos_ = input.data();
   pos_ = start_pos_;
   end_pos_ = start_pos_ + input.length();
   index_ = 0;
@@ -233,35 +267,18 @@ Value* JSONParser::Parse(const StringPiece& input) {
   }
 
   // Parse the first and any nested tokens.
-  scoped_ptr<Value> root(ParseNextToken());
-  if (!root.get())
-    return NULL;
+  if (!ParseNextToken())
+    return false;
 
   // Make sure the input stream is at an end.
   if (GetNextToken() != T_END_OF_INPUT) {
     if (!CanConsume(1) || (NextChar() && GetNextToken() != T_END_OF_INPUT)) {
       ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
-      return NULL;
-    }
-  }
-
-  // Dictionaries and lists can contain JSONStringValues, so wrap them in a
-  // hidden root.
-  if (!(options_ & JSON_DETACHABLE_CHILDREN)) {
-    if (root->IsType(Value::TYPE_DICTIONARY)) {
-      return new DictionaryHiddenRootValue(input_copy.release(), root.get());
-    } else if (root->IsType(Value::TYPE_LIST)) {
-      return new ListHiddenRootValue(input_copy.release(), root.get());
-    } else if (root->IsType(Value::TYPE_STRING)) {
-      // A string type could be a JSONStringValue, but because there's no
-      // corresponding HiddenRootValue, the memory will be lost. Deep copy to
-      // preserve it.
-      return root->DeepCopy();
+      return false;
     }
   }
 
-  // All other values can be returned directly.
-  return root.release();
+  return true;
 }
 
 JSONReader::JsonParseError JSONParser::error_code() const {
@@ -453,11 +470,11 @@ bool JSONParser::EatComment() {
   return false;
 }
 
-Value* JSONParser::ParseNextToken() {
+bool JSONParser::ParseNextToken() {
   return ParseToken(GetNextToken());
 }
 
-Value* JSONParser::ParseToken(Token token) {
+bool JSONParser::ParseToken(Token token) {
   switch (token) {
     case T_OBJECT_BEGIN:
       return ConsumeDictionary();
@@ -473,36 +490,37 @@ Value* JSONParser::ParseToken(Token token) {
       return ConsumeLiteral();
     default:
       ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
-      return NULL;
+      return false;
   }
 }
 
-Value* JSONParser::ConsumeDictionary() {
+bool JSONParser::ConsumeDictionary() {
   if (*pos_ != '{') {
     ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
-    return NULL;
+    return false;
   }
 
   StackMarker depth_check(&stack_depth_);
   if (depth_check.IsTooDeep()) {
     ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 1);
-    return NULL;
+    return false;
   }
 
-  scoped_ptr<DictionaryValue> dict(new DictionaryValue);
+  if (!CheckHandlerResult(handler_->OnDictionaryBegin()))
+    return false;
 
   NextChar();
   Token token = GetNextToken();
   while (token != T_OBJECT_END) {
     if (token != T_STRING) {
       ReportError(JSONReader::JSON_UNQUOTED_DICTIONARY_KEY, 1);
-      return NULL;
+      return false;
     }
 
     // First consume the key.
     StringBuilder key;
     if (!ConsumeStringRaw(&key)) {
-      return NULL;
+      return false;
     }
 
     // Read the separator.
@@ -510,19 +528,21 @@ Value* JSONParser::ConsumeDictionary() {
     token = GetNextToken();
     if (token != T_OBJECT_PAIR_SEPARATOR) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
 
-    // The next token is the value. Ownership transfers to |dict|.
+    StringPiece key_piece = key.CanBeStringPiece() ? key.AsStringPiece() :
+                                                     key.AsString();
+    if (!CheckHandlerResult(handler_->OnDictionaryKey(key_piece)))
+      return false;
+
+    // The next token is the value.
     NextChar();
-    Value* value = ParseNextToken();
-    if (!value) {
+    if (!ParseNextToken()) {
       // ReportError from deeper level.
-      return NULL;
+      return false;
     }
 
-    dict->SetWithoutPathExpansion(key.AsString(), value);
-
     NextChar();
     token = GetNextToken();
     if (token == T_LIST_SEPARATOR) {
@@ -530,42 +550,40 @@ Value* JSONParser::ConsumeDictionary() {
       token = GetNextToken();
       if (token == T_OBJECT_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
         ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
-        return NULL;
+        return false;
       }
     } else if (token != T_OBJECT_END) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 0);
-      return NULL;
+      return false;
     }
   }
 
-  return dict.release();
+  return CheckHandlerResult(handler_->OnDictionaryEnd());
 }
 
-Value* JSONParser::ConsumeList() {
+bool JSONParser::ConsumeList() {
   if (*pos_ != '[') {
     ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
-    return NULL;
+    return false;
   }
 
   StackMarker depth_check(&stack_depth_);
   if (depth_check.IsTooDeep()) {
     ReportError(JSONReader::JSON_TOO_MUCH_NESTING, 1);
-    return NULL;
+    return false;
   }
 
-  scoped_ptr<ListValue> list(new ListValue);
+  if (!CheckHandlerResult(handler_->OnListBegin()))
+    return false;
 
   NextChar();
   Token token = GetNextToken();
   while (token != T_ARRAY_END) {
-    Value* item = ParseToken(token);
-    if (!item) {
+    if (!ParseToken(token)) {
       // ReportError from deeper level.
-      return NULL;
+      return false;
     }
 
-    list->Append(item);
-
     NextChar();
     token = GetNextToken();
     if (token == T_LIST_SEPARATOR) {
@@ -573,31 +591,26 @@ Value* JSONParser::ConsumeList() {
       token = GetNextToken();
       if (token == T_ARRAY_END && !(options_ & JSON_ALLOW_TRAILING_COMMAS)) {
         ReportError(JSONReader::JSON_TRAILING_COMMA, 1);
-        return NULL;
+        return false;
       }
     } else if (token != T_ARRAY_END) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
   }
 
-  return list.release();
+  return CheckHandlerResult(handler_->OnListEnd());
 }
 
-Value* JSONParser::ConsumeString() {
+bool JSONParser::ConsumeString() {
   StringBuilder string;
   if (!ConsumeStringRaw(&string))
-    return NULL;
+    return false;
 
-  // Create the Value representation, using a hidden root, if configured
-  // to do so, and if the string can be represented by StringPiece.
-  if (string.CanBeStringPiece() && !(options_ & JSON_DETACHABLE_CHILDREN)) {
-    return new JSONStringValue(string.AsStringPiece());
-  } else {
-    if (string.CanBeStringPiece())
-      string.Convert();
-    return new StringValue(string.AsString());
-  }
+  // Hand out the input itself when no escape sequence forced a copy.
+  StringPiece piece = string.CanBeStringPiece() ? string.AsStringPiece() :
+                                                  string.AsString();
+  return CheckHandlerResult(handler_->OnString(piece));
 }
 
 bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
@@ -803,7 +816,7 @@ void JSONParser::DecodeUTF8(const int32& point, StringBuilder* dest) {
   }
 }
 
-Value* JSONParser::ConsumeNumber() {
+bool JSONParser::ConsumeNumber() {
   const char* num_start = pos_;
   const int start_index = index_;
   int end_index = start_index;
@@ -813,7 +826,7 @@ Value* JSONParser::ConsumeNumber() {
 
   if (!ReadInt(false)) {
     ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-    return NULL;
+    return false;
   }
   end_index = index_;
 
@@ -821,12 +834,12 @@ Value* JSONParser::ConsumeNumber() {
   if (*pos_ == '.') {
     if (!CanConsume(1)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     NextChar();
     if (!ReadInt(true)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     end_index = index_;
   }
@@ -838,7 +851,7 @@ Value* JSONParser::ConsumeNumber() {
       NextChar();
     if (!ReadInt(true)) {
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
     }
     end_index = index_;
   }
@@ -858,7 +871,7 @@ Value* JSONParser::ConsumeNumber() {
       break;
     default:
       ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-      return NULL;
+      return false;
   }
 
   pos_ = exit_pos;
@@ -868,15 +881,15 @@ Value* JSONParser::ConsumeNumber() {
 
   int num_int;
   if (StringToInt(num_string, &num_int))
-    return new FundamentalValue(num_int);
+    return CheckHandlerResult(handler_->OnInteger(num_int));
 
   double num_double;
   if (base::StringToDouble(num_string.as_string(), &num_double) &&
       IsFinite(num_double)) {
-    return new FundamentalValue(num_double);
+    return CheckHandlerResult(handler_->OnDouble(num_double));
   }
 
-  return NULL;
+  return false;
 }
 
 bool JSONParser::ReadInt(bool allow_leading_zeros) {
@@ -898,7 +911,7 @@ bool JSONParser::ReadInt(bool allow_leading_zeros) {
   return true;
 }
 
-Value* JSONParser::ConsumeLiteral() {
+bool JSONParser::ConsumeLiteral() {
   switch (*pos_) {
     case 't': {
       const char* kTrueLiteral = "true";
@@ -906,10 +919,10 @@ Value* JSONParser::ConsumeLiteral() {
       if (!CanConsume(kTrueLen - 1) ||
           !StringsAreEqual(pos_, kTrueLiteral, kTrueLen)) {
         ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-        return NULL;
+        return false;
       }
       NextNChars(kTrueLen - 1);
-      return new FundamentalValue(true);
+      return CheckHandlerResult(handler_->OnBoolean(true));
     }
     case 'f': {
       const char* kFalseLiteral = "false";
@@ -917,10 +930,10 @@ Value* JSONParser::ConsumeLiteral() {
       if (!CanConsume(kFalseLen - 1) ||
           !StringsAreEqual(pos_, kFalseLiteral, kFalseLen)) {
         ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-        return NULL;
+        return false;
       }
       NextNChars(kFalseLen - 1);
-      return new FundamentalValue(false);
+      return CheckHandlerResult(handler_->OnBoolean(false));
     }
     case 'n': {
       const char* kNullLiteral = "null";
@@ -928,17 +941,23 @@ Value* JSONParser::ConsumeLiteral() {
       if (!CanConsume(kNullLen - 1) ||
           !StringsAreEqual(pos_, kNullLiteral, kNullLen)) {
         ReportError(JSONReader::JSON_SYNTAX_ERROR, 1);
-        return NULL;
+        return false;
       }
       NextNChars(kNullLen - 1);
-      return Value::CreateNullValue();
+      return CheckHandlerResult(handler_->OnNull());
     }
     default:
       ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
-      return NULL;
+      return false;
   }
 }
 
+bool JSONParser::CheckHandlerResult(bool handler_result) {
+  if (!handler_result)
+    ReportError(JSONReader::JSON_PARSE_ABORTED, 1);
+  return handler_result;
+}
+
 // static
 bool JSONParser::StringsAreEqual(const char* one, const char* two, size_t len) {
   return strncmp(one, two, len) == 0;
@@ -961,5 +980,100 @@ std::string JSONParser::FormatErrorMessage(int line, int column,
   return description;
 }
 
+// JSONValueBuilder ////////////////////////////////////////////////////////////
+
+JSONValueBuilder::JSONValueBuilder(const StringPiece& input, int options)
+    : input_(input),
+      use_string_pieces_(!(options & JSON_DETACHABLE_CHILDREN)) {
+}
+
+JSONValueBuilder::~JSONValueBuilder() {
+}
+
+Value* JSONValueBuilder::TakeRoot() {
+  DCHECK(open_containers_.empty());
+  return root_.release();
+}
+
+bool JSONValueBuilder::OnNull() {
+  AddValue(Value::CreateNullValue());
+  return true;
+}
+
+bool JSONValueBuilder::OnBoolean(bool value) {
+  AddValue(new FundamentalValue(value));
+  return true;
+}
+
+bool JSONValueBuilder::OnInteger(int value) {
+  AddValue(new FundamentalValue(value));
+  return true;
+}
+
+bool JSONValueBuilder::OnDouble(double value) {
+  AddValue(new FundamentalValue(value));
+  return true;
+}
+
+bool JSONValueBuilder::OnString(const StringPiece& value) {
+  // Create the Value representation, using a hidden root, if configured
+  // to do so, and if the string was not copied out of the input.
+  if (use_string_pieces_ && value.data() >= input_.data() &&
+      value.data() + value.length() <= input_.data() + input_.length()) {
+    AddValue(new JSONStringValue(value));
+  } else {
+    AddValue(new StringValue(value.as_string()));
+  }
+  return true;
+}
+
+bool JSONValueBuilder::OnDictionaryBegin() {
+  DictionaryValue* dict = new DictionaryValue;
+  AddValue(dict);
+  open_containers_.push_back(dict);
+  return true;
+}
+
+bool JSONValueBuilder::OnDictionaryKey(const StringPiece& key) {
+  key.CopyToString(&key_);
+  return true;
+}
+
+bool JSONValueBuilder::OnDictionaryEnd() {
+  DCHECK(open_containers_.back()->IsType(Value::TYPE_DICTIONARY));
+  open_containers_.pop_back();
+  return true;
+}
+
+bool JSONValueBuilder::OnListBegin() {
+  ListValue* list = new ListValue;
+  AddValue(list);
+  open_containers_.push_back(list);
+  return true;
+}
+
+bool JSONValueBuilder::OnListEnd() {
+  DCHECK(open_containers_.back()->IsType(Value::TYPE_LIST));
+  open_containers_.pop_back();
+  return true;
+}
+
+void JSONValueBuilder::AddValue(Value* value) {
+  if (open_containers_.empty()) {
+    DCHECK(!root_.get());
+    root_.reset(value);
+    return;
+  }
+
+  Value* container = open_containers_.back();
+  if (container->IsType(Value::TYPE_DICTIONARY)) {
+    static_cast<DictionaryValue*>(container)->SetWithoutPathExpansion(key_,
+                                                                      value);
+  } else {
+    DCHECK(container->IsType(Value::TYPE_LIST));
+    static_cast<ListValue*>(container)->Append(value);
+  }
+}
+
 }  // namespace internal
 }  // namespace base
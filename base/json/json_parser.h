@@ -6,11 +6,13 @@
 #define BASE_JSON_JSON_PARSER_H_
 
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
 #include "base/json/json_reader.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/strings/string_piece.h"
 
 #if !defined(OS_CHROMEOS)
@@ -46,6 +48,10 @@ class JSONParserTest;
 // base::StringValue by using StringPiece where possible when returning Value
 // objects by using "hidden roots," discussed in the implementation.
 //
+// The parser itself only reports what it reads to a JSONReader::Handler.
+// Parse() builds a Value tree by handing it a JSONValueBuilder, while
+// ParseWithHandler() lets callers consume the document without building one.
+//
 // Iteration happens on the byte level, with the functions CanConsume and
 // NextChar. The conversion from byte to JSON token happens without advancing
 // the parser in GetNextToken/ParseToken, that is tokenization operates on
@@ -66,6 +72,10 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // result as a Value owned by the caller.
   Value* Parse(const StringPiece& input);
 
+  // Parses the input string according to the set options, reporting its
+  // contents to |handler|. Returns true if the whole input was parsed.
+  bool ParseWithHandler(const StringPiece& input, JSONReader::Handler* handler);
+
   // Returns the error code.
   JSONReader::JsonParseError error_code() const;
 
@@ -164,24 +174,24 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // currently wound to a '/'.
   bool EatComment();
 
-  // Calls GetNextToken() and then ParseToken(). Caller owns the result.
-  Value* ParseNextToken();
+  // Calls GetNextToken() and then ParseToken().
+  bool ParseNextToken();
 
   // Takes a token that represents the start of a Value ("a structural token"
-  // in RFC terms) and consumes it, returning the result as an object the
-  // caller owns.
-  Value* ParseToken(Token token);
+  // in RFC terms) and consumes it, reporting it to |handler_|. All of the
+  // functions below that report to |handler_| return false if the input is
+  // invalid or the handler stopped the parse, with error information set.
+  bool ParseToken(Token token);
 
   // Assuming that the parser is currently wound to '{', this parses a JSON
-  // object into a DictionaryValue.
-  Value* ConsumeDictionary();
+  // object.
+  bool ConsumeDictionary();
 
-  // Assuming that the parser is wound to '[', this parses a JSON list into a
-  // ListValue.
-  Value* ConsumeList();
+  // Assuming that the parser is wound to '[', this parses a JSON list.
+  bool ConsumeList();
 
-  // Calls through ConsumeStringRaw and wraps it in a value.
-  Value* ConsumeString();
+  // Calls through ConsumeStringRaw and reports the result as a string value.
+  bool ConsumeString();
 
   // Assuming that the parser is wound to a double quote, this parses a string,
   // decoding any escape sequences and converts UTF-16 to UTF-8. Returns true on
@@ -201,14 +211,17 @@ class BASE_EXPORT_PRIVATE JSONParser {
 
   // Assuming that the parser is wound to the start of a valid JSON number,
   // this parses and converts it to either an int or double value.
-  Value* ConsumeNumber();
+  bool ConsumeNumber();
   // Helper that reads characters that are ints. Returns true if a number was
   // read and false on error.
   bool ReadInt(bool allow_leading_zeros);
 
   // Consumes the literal values of |true|, |false|, and |null|, assuming the
   // parser is wound to the first character of any of those.
-  Value* ConsumeLiteral();
+  bool ConsumeLiteral();
+
+  // Returns |handler_result|, reporting JSON_PARSE_ABORTED if it is false.
+  bool CheckHandlerResult(bool handler_result);
 
   // Compares two string buffers of a given length.
   static bool StringsAreEqual(const char* left, const char* right, size_t len);
@@ -226,6 +239,9 @@ class BASE_EXPORT_PRIVATE JSONParser {
   // base::JSONParserOptions that control parsing.
   int options_;
 
+  // Receives the parsed contents. Weak; only set during ParseWithHandler().
+  JSONReader::Handler* handler_;
+
   // Pointer to the start of the input data.
   const char* start_pos_;
 
@@ -265,6 +281,51 @@ class BASE_EXPORT_PRIVATE JSONParser {
   DISALLOW_COPY_AND_ASSIGN(JSONParser);
 };
 
+// The JSONReader::Handler behind JSONParser::Parse(), which builds a Value
+// tree out of the parsed contents. Unless |options| contains
+// JSON_DETACHABLE_CHILDREN, strings that lie within |input| are stored as
+// StringPieces into it, so |input| must then outlive the result.
+class BASE_EXPORT_PRIVATE JSONValueBuilder : public JSONReader::Handler {
+ public:
+  JSONValueBuilder(const StringPiece& input, int options);
+  virtual ~JSONValueBuilder();
+
+  // Returns the root of the built tree, or NULL if nothing was parsed. The
+  // caller takes ownership.
+  Value* TakeRoot();
+
+  // JSONReader::Handler:
+  virtual bool OnNull() OVERRIDE;
+  virtual bool OnBoolean(bool value) OVERRIDE;
+  virtual bool OnInteger(int value) OVERRIDE;
+  virtual bool OnDouble(double value) OVERRIDE;
+  virtual bool OnString(const StringPiece& value) OVERRIDE;
+  virtual bool OnDictionaryBegin() OVERRIDE;
+  virtual bool OnDictionaryKey(const StringPiece& key) OVERRIDE;
+  virtual bool OnDictionaryEnd() OVERRIDE;
+  virtual bool OnListBegin() OVERRIDE;
+  virtual bool OnListEnd() OVERRIDE;
+
+ private:
+  // Adds |value| to the innermost open container, or makes it the root.
+  // Takes ownership of |value|.
+  void AddValue(Value* value);
+
+  const StringPiece input_;
+  const bool use_string_pieces_;
+
+  scoped_ptr<Value> root_;
+
+  // The dictionaries and lists that have been begun but not ended, innermost
+  // last. Weak; they are owned by |root_|.
+  std::vector<Value*> open_containers_;
+
+  // The key under which the next value is added to the innermost dictionary.
+  std::string key_;
+
+  DISALLOW_COPY_AND_ASSIGN(JSONValueBuilder);
+};
+
 }  // namespace internal
 }  // namespace base
 
@@ -19,15 +19,26 @@ class JSONParserTest : public testing::Test {
     parser->start_pos_ = input.data();
     parser->pos_ = parser->start_pos_;
     parser->end_pos_ = parser->start_pos_ + input.length();
+    builder_.reset(new JSONValueBuilder(input, JSON_DETACHABLE_CHILDREN));
+    parser->handler_ = builder_.get();
     return parser;
   }
 
+  // Returns the value built by the last Consume call on the parser from
+  // NewTestParser(), if |consumed| reports that it succeeded.
+  Value* TakeValue(bool consumed) {
+    return consumed ? builder_->TakeRoot() : NULL;
+  }
+
   void TestLastThree(JSONParser* parser) {
     EXPECT_EQ(',', *parser->NextChar());
     EXPECT_EQ('|', *parser->NextChar());
     EXPECT_EQ('\0', *parser->NextChar());
     EXPECT_EQ(parser->end_pos_, parser->pos_);
   }
+
+ private:
+  scoped_ptr<JSONValueBuilder> builder_;
 };
 
 TEST_F(JSONParserTest, NextChar) {
@@ -44,7 +55,7 @@ TEST_F(JSONParserTest, NextChar) {
 TEST_F(JSONParserTest, ConsumeString) {
   std::string input("\"test\",|");
   scoped_ptr<JSONParser> parser(NewTestParser(input));
-  scoped_ptr<Value> value(parser->ConsumeString());
+  scoped_ptr<Value> value(TakeValue(parser->ConsumeString()));
   EXPECT_EQ('"', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -58,7 +69,7 @@ TEST_F(JSONParserTest, ConsumeString) {
 TEST_F(JSONParserTest, ConsumeList) {
   std::string input("[true, false],|");
   scoped_ptr<JSONParser> parser(NewTestParser(input));
-  scoped_ptr<Value> value(parser->ConsumeList());
+  scoped_ptr<Value> value(TakeValue(parser->ConsumeList()));
   EXPECT_EQ(']', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -72,7 +83,7 @@ TEST_F(JSONParserTest, ConsumeList) {
 TEST_F(JSONParserTest, ConsumeDictionary) {
   std::string input("{\"abc\":\"def\"},|");
   scoped_ptr<JSONParser> parser(NewTestParser(input));
-  scoped_ptr<Value> value(parser->ConsumeDictionary());
+  scoped_ptr<Value> value(TakeValue(parser->ConsumeDictionary()));
   EXPECT_EQ('}', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -89,7 +100,7 @@ TEST_F(JSONParserTest, ConsumeLiterals) {
   // Literal |true|.
   std::string input("true,|");
   scoped_ptr<JSONParser> parser(NewTestParser(input));
-  scoped_ptr<Value> value(parser->ConsumeLiteral());
+  scoped_ptr<Value> value(TakeValue(parser->ConsumeLiteral()));
   EXPECT_EQ('e', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -102,7 +113,7 @@ TEST_F(JSONParserTest, ConsumeLiterals) {
   // Literal |false|.
   input = "false,|";
   parser.reset(NewTestParser(input));
-  value.reset(parser->ConsumeLiteral());
+  value.reset(TakeValue(parser->ConsumeLiteral()));
   EXPECT_EQ('e', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -114,7 +125,7 @@ TEST_F(JSONParserTest, ConsumeLiterals) {
   // Literal |null|.
   input = "null,|";
   parser.reset(NewTestParser(input));
-  value.reset(parser->ConsumeLiteral());
+  value.reset(TakeValue(parser->ConsumeLiteral()));
   EXPECT_EQ('l', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -127,7 +138,7 @@ TEST_F(JSONParserTest, ConsumeNumbers) {
   // Integer.
   std::string input("1234,|");
   scoped_ptr<JSONParser> parser(NewTestParser(input));
-  scoped_ptr<Value> value(parser->ConsumeNumber());
+  scoped_ptr<Value> value(TakeValue(parser->ConsumeNumber()));
   EXPECT_EQ('4', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -140,7 +151,7 @@ TEST_F(JSONParserTest, ConsumeNumbers) {
   // Negative integer.
   input = "-1234,|";
   parser.reset(NewTestParser(input));
-  value.reset(parser->ConsumeNumber());
+  value.reset(TakeValue(parser->ConsumeNumber()));
   EXPECT_EQ('4', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -152,7 +163,7 @@ TEST_F(JSONParserTest, ConsumeNumbers) {
   // Double.
   input = "12.34,|";
   parser.reset(NewTestParser(input));
-  value.reset(parser->ConsumeNumber());
+  value.reset(TakeValue(parser->ConsumeNumber()));
   EXPECT_EQ('4', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -165,7 +176,7 @@ TEST_F(JSONParserTest, ConsumeNumbers) {
   // Scientific.
   input = "42e3,|";
   parser.reset(NewTestParser(input));
-  value.reset(parser->ConsumeNumber());
+  value.reset(TakeValue(parser->ConsumeNumber()));
   EXPECT_EQ('3', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -177,7 +188,7 @@ TEST_F(JSONParserTest, ConsumeNumbers) {
   // Negative scientific.
   input = "314159e-5,|";
   parser.reset(NewTestParser(input));
-  value.reset(parser->ConsumeNumber());
+  value.reset(TakeValue(parser->ConsumeNumber()));
   EXPECT_EQ('5', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -189,7 +200,7 @@ TEST_F(JSONParserTest, ConsumeNumbers) {
   // Positive scientific.
   input = "0.42e+3,|";
   parser.reset(NewTestParser(input));
-  value.reset(parser->ConsumeNumber());
+  value.reset(TakeValue(parser->ConsumeNumber()));
   EXPECT_EQ('3', *parser->pos_);
 
   TestLastThree(parser.get());
@@ -73,6 +73,39 @@ class BASE_EXPORT JSONReader {
     JSON_UNEXPECTED_DATA_AFTER_ROOT,
     JSON_UNSUPPORTED_ENCODING,
     JSON_UNQUOTED_DICTIONARY_KEY,
+    JSON_PARSE_ABORTED,
+  };
+
+  // Receives the contents of a JSON document as it is parsed, in document
+  // order, instead of having them built into a Value tree. This lets callers
+  // deserialize straight into their own structures. Each method returns true
+  // to continue parsing, or false to stop it, in which case the parse fails
+  // with JSON_PARSE_ABORTED.
+  //
+  // The StringPieces passed to OnString() and OnDictionaryKey() point either
+  // into the input or into a temporary buffer, and are only valid for the
+  // duration of the call.
+  class BASE_EXPORT Handler {
+   public:
+    virtual ~Handler() {}
+
+    virtual bool OnNull() = 0;
+    virtual bool OnBoolean(bool value) = 0;
+    virtual bool OnInteger(int value) = 0;
+    virtual bool OnDouble(double value) = 0;
+    virtual bool OnString(const StringPiece& value) = 0;
+
+    // A dictionary is reported as OnDictionaryBegin(), then for each entry
+    // OnDictionaryKey() followed by the events of its value, then
+    // OnDictionaryEnd().
+    virtual bool OnDictionaryBegin() = 0;
+    virtual bool OnDictionaryKey(const StringPiece& key) = 0;
+    virtual bool OnDictionaryEnd() = 0;
+
+    // A list is reported as OnListBegin(), the events of each element, then
+    // OnListEnd().
+    virtual bool OnListBegin() = 0;
+    virtual bool OnListEnd() = 0;
   };
 
   // String versions of parse error codes.
@@ -84,6 +117,7 @@ class BASE_EXPORT JSONReader {
   static const char* kUnexpectedDataAfterRoot;
   static const char* kUnsupportedEncoding;
   static const char* kUnquotedDictionaryKey;
+  static const char* kParseAborted;
 
   // Constructs a reader with the default options, JSON_PARSE_RFC.
   JSONReader();
@@ -111,6 +145,16 @@ class BASE_EXPORT JSONReader {
                                    int* error_code_out,
                                    std::string* error_msg_out);
 
+  // Parses |json| like ReadAndReturnError(), but reports its contents to
+  // |handler| rather than building a Value. Returns true if the whole input
+  // was parsed. Because events are delivered as they are parsed, |handler| may
+  // already have seen part of the document when false is returned.
+  static bool ReadWithHandler(const StringPiece& json,
+                              int options,  // JSONParserOptions
+                              Handler* handler,
+                              int* error_code_out,
+                              std::string* error_msg_out);
+
   // Converts a JSON parse error code into a human readable message.
   // Returns an empty string if error_code is JSON_NO_ERROR.
   static std::string ErrorCodeToString(JsonParseError error_code);
@@ -10,6 +10,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/path_service.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
 #include "build/build_config.h"
@@ -17,6 +18,67 @@
 
 namespace base {
 
+namespace {
+
+// Records the events of a parse as a string, optionally stopping the parse
+// at the first string value.
+class RecordingHandler : public JSONReader::Handler {
+ public:
+  explicit RecordingHandler(bool stop_at_string)
+      : stop_at_string_(stop_at_string) {}
+
+  const std::string& events() const { return events_; }
+
+  virtual bool OnNull() OVERRIDE {
+    events_ += "null ";
+    return true;
+  }
+  virtual bool OnBoolean(bool value) OVERRIDE {
+    events_ += value ? "true " : "false ";
+    return true;
+  }
+  virtual bool OnInteger(int value) OVERRIDE {
+    events_ += StringPrintf("i:%d ", value);
+    return true;
+  }
+  virtual bool OnDouble(double value) OVERRIDE {
+    events_ += StringPrintf("d:%g ", value);
+    return true;
+  }
+  virtual bool OnString(const StringPiece& value) OVERRIDE {
+    events_ += "s:" + value.as_string() + " ";
+    return !stop_at_string_;
+  }
+  virtual bool OnDictionaryBegin() OVERRIDE {
+    events_ += "{ ";
+    return true;
+  }
+  virtual bool OnDictionaryKey(const StringPiece& key) OVERRIDE {
+    events_ += key.as_string() + ": ";
+    return true;
+  }
+  virtual bool OnDictionaryEnd() OVERRIDE {
+    events_ += "} ";
+    return true;
+  }
+  virtual bool OnListBegin() OVERRIDE {
+    events_ += "[ ";
+    return true;
+  }
+  virtual bool OnListEnd() OVERRIDE {
+    events_ += "] ";
+    return true;
+  }
+
+ private:
+  const bool stop_at_string_;
+  std::string events_;
+
+  DISALLOW_COPY_AND_ASSIGN(RecordingHandler);
+};
+
+}  // namespace
+
 TEST(JSONReaderTest, Reading) {
   // some whitespace checking
   scoped_ptr<Value> root;
@@ -653,4 +715,36 @@ TEST(JSONReaderTest, IllegalTrailingNull) {
   EXPECT_EQ(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, reader.error_code());
 }
 
+TEST(JSONReaderTest, ReadWithHandler) {
+  RecordingHandler handler(false);
+  int error_code = 0;
+  std::string error_message;
+  EXPECT_TRUE(JSONReader::ReadWithHandler(
+      "{\"a\": [1, 2.5, \"x\\ty\", true, null], \"b\": {}, \"c\": false}",
+      JSON_PARSE_RFC, &handler, &error_code, &error_message));
+  EXPECT_EQ("{ a: [ i:1 d:2.5 s:x\ty true null ] b: { } c: false } ",
+            handler.events());
+  EXPECT_EQ(0, error_code);
+  EXPECT_TRUE(error_message.empty());
+
+  // Invalid input fails with the usual error, after the events for the part
+  // that was read.
+  RecordingHandler bad_input_handler(false);
+  EXPECT_FALSE(JSONReader::ReadWithHandler("[1, 2,]", JSON_PARSE_RFC,
+                                           &bad_input_handler, &error_code,
+                                           &error_message));
+  EXPECT_EQ("[ i:1 i:2 ", bad_input_handler.events());
+  EXPECT_EQ(JSONReader::JSON_TRAILING_COMMA, error_code);
+
+  // The handler can stop the parse.
+  RecordingHandler stopping_handler(true);
+  EXPECT_FALSE(JSONReader::ReadWithHandler("[1, \"x\", 3]", JSON_PARSE_RFC,
+                                           &stopping_handler, &error_code,
+                                           &error_message));
+  EXPECT_EQ("[ i:1 s:x ", stopping_handler.events());
+  EXPECT_EQ(JSONReader::JSON_PARSE_ABORTED, error_code);
+  EXPECT_NE(std::string::npos,
+            error_message.find(JSONReader::kParseAborted));
+}
+
 }  // namespace base
@@ -9,7 +9,6 @@
 #include "base/json/string_escape.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
-#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/values.h"
 
@@ -81,7 +80,7 @@ void JSONWriter::BuildJSONString(const Value* const node, int depth) {
         int value;
         bool result = node->GetAsInteger(&value);
         DCHECK(result);
-        base::StringAppendF(json_string_, "%d", value);
+        json_string_->append(IntToString(value));
         break;
       }
 
@@ -120,12 +119,17 @@ void JSONWriter::BuildJSONString(const Value* const node, int depth) {
 
     case Value::TYPE_STRING:
       {
-        std::string value;
-        bool result = node->GetAsString(&value);
-        DCHECK(result);
+        // Escaping works on UTF-16, so in that case convert straight out of
+        // the value rather than through an intermediate UTF-8 copy.
         if (escape_) {
-          JsonDoubleQuote(UTF8ToUTF16(value), true, json_string_);
+          string16 value;
+          bool result = node->GetAsString(&value);
+          DCHECK(result);
+          JsonDoubleQuote(value, true, json_string_);
         } else {
+          std::string value;
+          bool result = node->GetAsString(&value);
+          DCHECK(result);
           JsonDoubleQuote(value, true, json_string_);
         }
         break;
@@ -225,9 +229,7 @@ void JSONWriter::AppendQuotedString(const std::string& str) {
 }
 
 void JSONWriter::IndentLine(int depth) {
-  // It may be faster to keep an indent string so we don't have to keep
-  // reallocating.
-  json_string_->append(std::string(depth * 3, ' '));
+  json_string_->append(depth * 3, ' ');
 }
 
 }  // namespace base
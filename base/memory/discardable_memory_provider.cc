@@ -4,6 +4,8 @@
 
 #include "base/memory/discardable_memory_provider.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/containers/hash_tables.h"
 #include "base/containers/mru_cache.h"
@@ -31,12 +33,19 @@ static const size_t kDefaultDiscardableMemoryLimit = 32 * 1024 * 1024;
 static const size_t kDefaultBytesToReclaimUnderModeratePressure =
     kDefaultDiscardableMemoryLimit / 2;
 
+// Memory pressure never shrinks the budget below this fraction of the limit.
+static const size_t kMinimumBudgetDivisor = 8;
+
+// How long the budget stays reduced after the last memory pressure signal.
+static const int64 kBudgetRecoveryDelayMs = 10 * 1000;
+
 }  // namespace
 
 DiscardableMemoryProvider::DiscardableMemoryProvider()
     : allocations_(AllocationMap::NO_AUTO_EVICT),
       bytes_allocated_(0),
       discardable_memory_limit_(kDefaultDiscardableMemoryLimit),
+      budget_(kDefaultDiscardableMemoryLimit),
       bytes_to_reclaim_under_moderate_pressure_(
           kDefaultBytesToReclaimUnderModeratePressure),
       memory_pressure_listener_(
@@ -79,6 +88,7 @@ void DiscardableMemoryProvider::NotifyMemoryPressure(
 void DiscardableMemoryProvider::SetDiscardableMemoryLimit(size_t bytes) {
   AutoLock lock(lock_);
   discardable_memory_limit_ = bytes;
+  budget_ = bytes;
   EnforcePolicyWithLockAcquired();
 }
 
@@ -132,10 +142,11 @@ scoped_ptr<uint8, FreeDeleter> DiscardableMemoryProvider::Acquire(
   if (!bytes)
     return scoped_ptr<uint8, FreeDeleter>();
 
-  if (discardable_memory_limit_) {
+  size_t budget = GetBudgetWithLockAcquired();
+  if (budget) {
     size_t limit = 0;
-    if (bytes < discardable_memory_limit_)
-      limit = discardable_memory_limit_ - bytes;
+    if (bytes < budget)
+      limit = budget - bytes;
 
     PurgeLRUWithLockAcquiredUntilUsageIsWithin(limit);
   }
@@ -163,6 +174,8 @@ void DiscardableMemoryProvider::Release(
 void DiscardableMemoryProvider::PurgeAll() {
   AutoLock lock(lock_);
   PurgeLRUWithLockAcquiredUntilUsageIsWithin(0);
+  budget_ = discardable_memory_limit_ / kMinimumBudgetDivisor;
+  last_pressure_time_ = TimeTicks::Now();
 }
 
 bool DiscardableMemoryProvider::IsRegisteredForTest(
@@ -184,19 +197,41 @@ size_t DiscardableMemoryProvider::GetBytesAllocatedForTest() const {
   return bytes_allocated_;
 }
 
+size_t DiscardableMemoryProvider::GetBudgetForTest() const {
+  AutoLock lock(lock_);
+  return budget_;
+}
+
 void DiscardableMemoryProvider::Purge() {
   AutoLock lock(lock_);
 
   if (bytes_to_reclaim_under_moderate_pressure_ == 0)
     return;
 
+  budget_ = std::max(budget_ / 2,
+                     discardable_memory_limit_ / kMinimumBudgetDivisor);
+  last_pressure_time_ = TimeTicks::Now();
+
   size_t limit = 0;
-  if (bytes_to_reclaim_under_moderate_pressure_ < discardable_memory_limit_)
+  if (bytes_to_reclaim_under_moderate_pressure_ < bytes_allocated_)
     limit = bytes_allocated_ - bytes_to_reclaim_under_moderate_pressure_;
+  if (budget_)
+    limit = std::min(limit, budget_);
 
   PurgeLRUWithLockAcquiredUntilUsageIsWithin(limit);
 }
 
+size_t DiscardableMemoryProvider::GetBudgetWithLockAcquired() {
+  lock_.AssertAcquired();
+
+  if (budget_ != discardable_memory_limit_ &&
+      TimeTicks::Now() - last_pressure_time_ >
+          TimeDelta::FromMilliseconds(kBudgetRecoveryDelayMs)) {
+    budget_ = discardable_memory_limit_;
+  }
+  return budget_;
+}
+
 void DiscardableMemoryProvider::PurgeLRUWithLockAcquiredUntilUsageIsWithin(
     size_t limit) {
   TRACE_EVENT1(
@@ -10,6 +10,7 @@
 #include "base/containers/mru_cache.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 
 namespace base {
 class DiscardableMemory;
@@ -37,7 +38,9 @@ namespace internal {
 //
 // When notified of memory pressure, the provider either purges the LRU
 // memory -- if the pressure is moderate -- or all discardable memory
-// if the pressure is critical.
+// if the pressure is critical. Pressure also shrinks the budget that later
+// allocations are held to, so purged memory is not immediately reallocated;
+// the full limit is restored once no pressure has been reported for a while.
 //
 // NB - this class is an implementation detail. It has been exposed for testing
 // purposes. You should not need to use this class directly.
@@ -56,7 +59,8 @@ class BASE_EXPORT_PRIVATE DiscardableMemoryProvider {
 
   // The maximum number of bytes of discardable memory that may be allocated
   // before we assume moderate memory pressure. If this amount is zero, it is
-  // interpreted as having no limit at all.
+  // interpreted as having no limit at all. This also resets any reduction of
+  // the budget made in response to memory pressure.
   void SetDiscardableMemoryLimit(size_t bytes);
 
   // Sets the amount of memory to reclaim when we're under moderate pressure.
@@ -94,6 +98,11 @@ class BASE_EXPORT_PRIVATE DiscardableMemoryProvider {
   // be used by tests.
   size_t GetBytesAllocatedForTest() const;
 
+  // Returns the number of bytes that may currently be allocated, taking any
+  // pressure-induced reduction into account. This should only be used by
+  // tests.
+  size_t GetBudgetForTest() const;
+
  private:
   struct Allocation {
    explicit Allocation(size_t bytes)
@@ -111,9 +120,14 @@ class BASE_EXPORT_PRIVATE DiscardableMemoryProvider {
       MemoryPressureListener::MemoryPressureLevel pressure_level);
 
   // Purges least recently used memory based on the value of
-  // |bytes_to_reclaim_under_moderate_pressure_|.
+  // |bytes_to_reclaim_under_moderate_pressure_| and halves the budget.
   void Purge();
 
+  // Returns the number of bytes that may currently be allocated. Restores
+  // the full limit if no memory pressure has been reported recently.
+  // Caller must acquire |lock_| prior to calling this function.
+  size_t GetBudgetWithLockAcquired();
+
   // Purges least recently used memory until usage is less or equal to |limit|.
   // Caller must acquire |lock_| prior to calling this function.
   void PurgeLRUWithLockAcquiredUntilUsageIsWithin(size_t limit);
@@ -135,6 +149,14 @@ class BASE_EXPORT_PRIVATE DiscardableMemoryProvider {
   // before we assume moderate memory pressure.
   size_t discardable_memory_limit_;
 
+  // The maximum number of bytes of discardable memory that may be allocated
+  // at present. Equal to |discardable_memory_limit_| unless memory pressure
+  // was reported within the last kBudgetRecoveryDelayMs.
+  size_t budget_;
+
+  // When memory pressure was last reported.
+  TimeTicks last_pressure_time_;
+
   // Under moderate memory pressure, we will purge this amount of memory.
   size_t bytes_to_reclaim_under_moderate_pressure_;
 
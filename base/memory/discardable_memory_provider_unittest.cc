@@ -53,6 +53,10 @@ class DiscardableMemoryProviderTestBase {
     return discardable->Memory();
   }
 
+  size_t BudgetForTest() const {
+    return DiscardableMemoryProvider::GetInstance()->GetBudgetForTest();
+  }
+
   void SetDiscardableMemoryLimit(size_t bytes) {
     DiscardableMemoryProvider::GetInstance()->
         SetDiscardableMemoryLimit(bytes);
@@ -156,6 +160,40 @@ TEST_F(DiscardableMemoryProviderTest, LockAfterPurgeAndCannotReallocate) {
   EXPECT_FALSE(CanBePurged(discardable.get()));
 }
 
+TEST_F(DiscardableMemoryProviderTest, ModeratePressureShrinksBudget) {
+  SetDiscardableMemoryLimit(4096);
+  SetBytesToReclaimUnderModeratePressure(1024);
+
+  scoped_ptr<DiscardableMemory> discardables[4];
+  for (int i = 0; i < 4; ++i) {
+    discardables[i] = DiscardableMemory::CreateLockedMemory(1024);
+    discardables[i]->Unlock();
+  }
+  EXPECT_EQ(4096u, BytesAllocated());
+
+  MemoryPressureListener::NotifyMemoryPressure(
+      MemoryPressureListener::MEMORY_PRESSURE_MODERATE);
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ(2048u, BudgetForTest());
+  EXPECT_EQ(2048u, BytesAllocated());
+
+  // Reacquiring the purged memory must not grow usage past the budget.
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NE(DISCARDABLE_MEMORY_FAILED, discardables[i]->Lock());
+    discardables[i]->Unlock();
+    EXPECT_LE(BytesAllocated(), 2048u);
+  }
+
+  // Resetting the limit restores the full budget.
+  SetDiscardableMemoryLimit(4096);
+  EXPECT_EQ(4096u, BudgetForTest());
+  for (int i = 0; i < 4; ++i)
+    EXPECT_NE(DISCARDABLE_MEMORY_FAILED, discardables[i]->Lock());
+  EXPECT_EQ(4096u, BytesAllocated());
+  for (int i = 0; i < 4; ++i)
+    discardables[i]->Unlock();
+}
+
 class PermutationTestData {
  public:
   PermutationTestData(unsigned d0, unsigned d1, unsigned d2) {
@@ -28,6 +28,11 @@ bool WeakReference::Flag::IsValid() const {
   return is_valid_;
 }
 
+void WeakReference::Flag::DetachFromSequence() {
+  DCHECK(HasOneRef()) << "Cannot detach from a sequence while in use.";
+  sequence_checker_.DetachFromSequence();
+}
+
 WeakReference::Flag::~Flag() {
 }
 
@@ -50,9 +55,14 @@ WeakReferenceOwner::~WeakReferenceOwner() {
 }
 
 WeakReference WeakReferenceOwner::GetRef() const {
-  // If we hold the last reference to the Flag then create a new one.
-  if (!HasRefs())
+  // If we hold the last reference to the Flag, no WeakPtr can be checking it,
+  // so reuse it rather than allocating a new one for every batch of WeakPtrs.
+  // Detaching it keeps the owner free to move to another thread, as it would
+  // be with a new Flag.
+  if (!flag_.get())
     flag_ = new WeakReference::Flag();
+  else if (flag_->HasOneRef())
+    flag_->DetachFromSequence();
 
   return WeakReference(flag_.get());
 }
@@ -90,6 +90,10 @@ class BASE_EXPORT WeakReference {
     void Invalidate();
     bool IsValid() const;
 
+    // Lets the next validity check or invalidation bind the Flag to another
+    // sequenced thread. Only valid while nothing else refers to the Flag.
+    void DetachFromSequence();
+
    private:
     friend class base::RefCountedThreadSafe<Flag>;
 
@@ -4,17 +4,124 @@
 
 #include "base/message_loop/incoming_task_queue.h"
 
+#include <algorithm>
+
 #include "base/debug/trace_event.h"
+#include "base/lazy_instance.h"
 #include "base/location.h"
 #include "base/message_loop/message_loop.h"
-#include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace base {
 namespace internal {
 
+namespace {
+
+// Layout of IncomingTaskQueue::posting_state_.
+const subtle::Atomic32 kClosedBit = 1;
+const subtle::Atomic32 kPosterIncrement = 2;
+
+// Bounds the memory a thread can keep for reuse.
+const size_t kMaxFreeTaskNodesPerThread = 64;
+
+template <typename T>
+T* AcquireLoadPointer(volatile const subtle::AtomicWord* ptr) {
+  return reinterpret_cast<T*>(subtle::Acquire_Load(ptr));
+}
+
+struct FreeTaskNode {
+  FreeTaskNode* next;
+};
+
+struct TaskNodeFreeList {
+  FreeTaskNode* head;
+  size_t length;
+};
+
+void DeleteTaskNodeFreeList(void* value) {
+  TaskNodeFreeList* list = static_cast<TaskNodeFreeList*>(value);
+  while (list->head) {
+    FreeTaskNode* node = list->head;
+    list->head = node->next;
+    ::operator delete(node);
+  }
+  delete list;
+}
+
+class TaskNodeFreeListSlot : public ThreadLocalStorage::Slot {
+ public:
+  TaskNodeFreeListSlot() : ThreadLocalStorage::Slot(&DeleteTaskNodeFreeList) {}
+};
+
+LazyInstance<TaskNodeFreeListSlot>::Leaky g_task_node_free_list_slot =
+    LAZY_INSTANCE_INITIALIZER;
+
+TaskNodeFreeList* GetTaskNodeFreeList(bool create) {
+  TaskNodeFreeList* list =
+      static_cast<TaskNodeFreeList*>(g_task_node_free_list_slot.Get().Get());
+  if (!list && create) {
+    list = new TaskNodeFreeList();
+    g_task_node_free_list_slot.Get().Set(list);
+  }
+  return list;
+}
+
+}  // namespace
+
+IncomingTaskQueue::NodeBase::NodeBase() : next(0) {
+}
+
+IncomingTaskQueue::TaskNode::TaskNode(
+    const tracked_objects::Location& posted_from,
+    const Closure& task,
+    TimeTicks delayed_run_time,
+    bool nestable)
+    : pending_task(posted_from, task, delayed_run_time, nestable) {
+}
+
+// static
+void* IncomingTaskQueue::TaskNode::operator new(size_t size) {
+  DCHECK_EQ(sizeof(TaskNode), size);
+  TaskNodeFreeList* list = GetTaskNodeFreeList(true);
+  FreeTaskNode* node = list->head;
+  if (!node)
+    return ::operator new(size);
+  list->head = node->next;
+  --list->length;
+  return node;
+}
+
+// static
+void IncomingTaskQueue::TaskNode::operator delete(void* ptr) {
+  if (!ptr)
+    return;
+
+  // Don't create a free list for a thread that only frees, e.g. one that is
+  // being torn down.
+  TaskNodeFreeList* list = GetTaskNodeFreeList(false);
+  if (!list || list->length >= kMaxFreeTaskNodesPerThread) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  FreeTaskNode* node = static_cast<FreeTaskNode*>(ptr);
+  node->next = list->head;
+  list->head = node;
+  ++list->length;
+}
+
 IncomingTaskQueue::IncomingTaskQueue(MessageLoop* message_loop)
-    : message_loop_(message_loop),
+    : head_(reinterpret_cast<subtle::AtomicWord>(&stub_)),
+      tail_(&stub_),
+      pump_needs_wakeup_(1),
+      posting_state_(0),
+      message_loop_(message_loop),
       next_sequence_num_(0) {
+#if defined(OS_WIN)
+  high_resolution_timer_epoch_ = TimeTicks::Now();
+  subtle::NoBarrier_Store(&high_resolution_timer_expiration_ms_, 0);
+#endif
 }
 
 bool IncomingTaskQueue::AddToIncomingQueue(
@@ -22,29 +129,20 @@ bool IncomingTaskQueue::AddToIncomingQueue(
     const Closure& task,
     TimeDelta delay,
     bool nestable) {
-  AutoLock locked(incoming_queue_lock_);
-  PendingTask pending_task(
-      from_here, task, CalculateDelayedRuntime(delay), nestable);
-  return PostPendingTask(&pending_task);
+  return PostTaskNode(new TaskNode(
+      from_here, task, CalculateDelayedRuntime(delay), nestable));
 }
 
 bool IncomingTaskQueue::TryAddToIncomingQueue(
     const tracked_objects::Location& from_here,
     const Closure& task) {
-  if (!incoming_queue_lock_.Try()) {
-    // Reset |task|.
-    Closure local_task = task;
-    return false;
-  }
-
-  AutoLock locked(incoming_queue_lock_, AutoLock::AlreadyAcquired());
-  PendingTask pending_task(
-      from_here, task, CalculateDelayedRuntime(TimeDelta()), true);
-  return PostPendingTask(&pending_task);
+  return PostTaskNode(new TaskNode(
+      from_here, task, CalculateDelayedRuntime(TimeDelta()), true));
 }
 
 bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
 #if defined(OS_WIN)
+  AutoLock lock(high_resolution_timer_lock_);
   return !high_resolution_timer_expiration_.is_null();
 #else
   return true;
@@ -52,81 +150,99 @@ bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
 }
 
 bool IncomingTaskQueue::IsIdleForTesting() {
-  AutoLock lock(incoming_queue_lock_);
-  return incoming_queue_.empty();
-}
-
-void IncomingTaskQueue::LockWaitUnLockForTesting(WaitableEvent* caller_wait,
-                                                 WaitableEvent* caller_signal) {
-  AutoLock lock(incoming_queue_lock_);
-  caller_wait->Signal();
-  caller_signal->Wait();
+  // The queue is empty exactly when both ends point at the same node, which is
+  // then |stub_|; see PopNode().
+  return AcquireLoadPointer<NodeBase>(&head_) == tail_;
 }
 
 void IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
   // Make sure no tasks are lost.
   DCHECK(work_queue->empty());
 
-  // Acquire all we can from the inter-thread queue with one lock acquisition.
-  AutoLock lock(incoming_queue_lock_);
-  if (!incoming_queue_.empty())
-    incoming_queue_.Swap(work_queue);  // Constant time
+  DrainInto(work_queue);
+  if (!work_queue->empty())
+    return;
 
-  DCHECK(incoming_queue_.empty());
+  // The incoming queue looked empty. Ask the next producer to wake up the
+  // pump, then look again: a producer that pushed after the first look but
+  // before the flag was raised would otherwise not schedule any work. The
+  // barriers here and in PostTaskNode() guarantee that at least one side sees
+  // the other's write.
+  subtle::NoBarrier_Store(&pump_needs_wakeup_, 1);
+  subtle::MemoryBarrier();
+  DrainInto(work_queue);
 }
 
 void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
 #if defined(OS_WIN)
-  // If we left the high-resolution timer activated, deactivate it now.
-  // Doing this is not-critical, it is mainly to make sure we track
-  // the high resolution timer activations properly in our unit tests.
-  if (!high_resolution_timer_expiration_.is_null()) {
-    Time::ActivateHighResolutionTimer(false);
-    high_resolution_timer_expiration_ = TimeTicks();
+  {
+    // If we left the high-resolution timer activated, deactivate it now.
+    // Doing this is not-critical, it is mainly to make sure we track
+    // the high resolution timer activations properly in our unit tests.
+    AutoLock lock(high_resolution_timer_lock_);
+    if (!high_resolution_timer_expiration_.is_null()) {
+      Time::ActivateHighResolutionTimer(false);
+      SetHighResolutionTimerExpiration(TimeTicks());
+    }
   }
 #endif
 
-  AutoLock lock(incoming_queue_lock_);
+  // Reject new posts, then wait for those that already got past BeginPost() to
+  // stop using |message_loop_|. They only wake the pump, so the wait is short.
+  subtle::Atomic32 state =
+      subtle::Barrier_AtomicIncrement(&posting_state_, kClosedBit);
+  DCHECK_EQ(kClosedBit, state & kClosedBit);
+  while (subtle::Acquire_Load(&posting_state_) != kClosedBit)
+    PlatformThread::YieldCurrentThread();
+
   message_loop_ = NULL;
 }
 
 IncomingTaskQueue::~IncomingTaskQueue() {
   // Verify that WillDestroyCurrentMessageLoop() has been called.
   DCHECK(!message_loop_);
+
+  // No more producers can exist at this point, so every remaining node is
+  // reachable from |tail_|.
+  while (TaskNode* node = PopNode())
+    delete node;
+  DCHECK_EQ(reinterpret_cast<subtle::AtomicWord>(&stub_),
+            subtle::NoBarrier_Load(&head_));
 }
 
 TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
   TimeTicks delayed_run_time;
+#if defined(OS_WIN)
+  bool needs_high_res_timers = false;
+#endif
   if (delay > TimeDelta()) {
     delayed_run_time = TimeTicks::Now() + delay;
 
 #if defined(OS_WIN)
-    if (high_resolution_timer_expiration_.is_null()) {
-      // Windows timers are granular to 15.6ms.  If we only set high-res
-      // timers for those under 15.6ms, then a 18ms timer ticks at ~32ms,
-      // which as a percentage is pretty inaccurate.  So enable high
-      // res timers for any timer which is within 2x of the granularity.
-      // This is a tradeoff between accuracy and power management.
-      bool needs_high_res_timers = delay.InMilliseconds() <
-          (2 * Time::kMinLowResolutionThresholdMs);
-      if (needs_high_res_timers) {
-        if (Time::ActivateHighResolutionTimer(true)) {
-          high_resolution_timer_expiration_ = TimeTicks::Now() +
-              TimeDelta::FromMilliseconds(
-                  MessageLoop::kHighResolutionTimerModeLeaseTimeMs);
-        }
-      }
-    }
+    // Windows timers are granular to 15.6ms.  If we only set high-res
+    // timers for those under 15.6ms, then a 18ms timer ticks at ~32ms,
+    // which as a percentage is pretty inaccurate.  So enable high
+    // res timers for any timer which is within 2x of the granularity.
+    // This is a tradeoff between accuracy and power management.
+    needs_high_res_timers = delay.InMilliseconds() <
+        (2 * Time::kMinLowResolutionThresholdMs);
 #endif
   } else {
     DCHECK_EQ(delay.InMilliseconds(), 0) << "delay should not be negative";
   }
 
 #if defined(OS_WIN)
-  if (!high_resolution_timer_expiration_.is_null()) {
-    if (TimeTicks::Now() > high_resolution_timer_expiration_) {
+  if (HighResolutionTimerLeaseMayChange(needs_high_res_timers)) {
+    AutoLock lock(high_resolution_timer_lock_);
+    if (high_resolution_timer_expiration_.is_null()) {
+      if (needs_high_res_timers && Time::ActivateHighResolutionTimer(true)) {
+        SetHighResolutionTimerExpiration(TimeTicks::Now() +
+            TimeDelta::FromMilliseconds(
+                MessageLoop::kHighResolutionTimerModeLeaseTimeMs));
+      }
+    } else if (TimeTicks::Now() > high_resolution_timer_expiration_) {
       Time::ActivateHighResolutionTimer(false);
-      high_resolution_timer_expiration_ = TimeTicks();
+      SetHighResolutionTimerExpiration(TimeTicks());
     }
   }
 #endif
@@ -134,36 +250,140 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
   return delayed_run_time;
 }
 
-bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
+#if defined(OS_WIN)
+bool IncomingTaskQueue::HighResolutionTimerLeaseMayChange(
+    bool needs_high_res_timers) const {
+  subtle::Atomic32 expiration_ms =
+      subtle::NoBarrier_Load(&high_resolution_timer_expiration_ms_);
+  if (expiration_ms == 0)
+    return needs_high_res_timers;
+  return (TimeTicks::Now() - high_resolution_timer_epoch_).InMilliseconds() >=
+      expiration_ms;
+}
+
+void IncomingTaskQueue::SetHighResolutionTimerExpiration(
+    TimeTicks expiration) {
+  high_resolution_timer_lock_.AssertAcquired();
+  high_resolution_timer_expiration_ = expiration;
+  subtle::Atomic32 expiration_ms = 0;
+  if (!expiration.is_null()) {
+    expiration_ms = static_cast<subtle::Atomic32>(std::min<int64>(
+        std::max<int64>(
+            (expiration - high_resolution_timer_epoch_).InMilliseconds(), 1),
+        kint32max));
+  }
+  subtle::NoBarrier_Store(&high_resolution_timer_expiration_ms_,
+                          expiration_ms);
+}
+#endif
+
+bool IncomingTaskQueue::PostTaskNode(TaskNode* node) {
   // Warning: Don't try to short-circuit, and handle this thread's tasks more
   // directly, as it could starve handling of foreign threads.  Put every task
   // into this queue.
 
-  // This should only be called while the lock is taken.
-  incoming_queue_lock_.AssertAcquired();
-
-  if (!message_loop_) {
-    pending_task->task.Reset();
+  if (!BeginPost()) {
+    // Destroy the task here so that the posting call stack does not outlive
+    // it, as it would have if the task had been queued.
+    delete node;
     return false;
   }
 
   // Initialize the sequence number. The sequence number is used for delayed
   // tasks (to faciliate FIFO sorting when two tasks have the same
   // delayed_run_time value) and for identifying the task in about:tracing.
-  pending_task->sequence_num = next_sequence_num_++;
+  // Tasks posted from one thread get increasing numbers in posting order.
+  PendingTask* pending_task = &node->pending_task;
+  pending_task->sequence_num =
+      subtle::NoBarrier_AtomicIncrement(&next_sequence_num_, 1) - 1;
 
   TRACE_EVENT_FLOW_BEGIN0("task", "MessageLoop::PostTask",
       TRACE_ID_MANGLE(message_loop_->GetTaskTraceID(*pending_task)));
 
-  bool was_empty = incoming_queue_.empty();
-  incoming_queue_.push(*pending_task);
-  pending_task->task.Reset();
+  // |node| belongs to the consumer once pushed and must not be touched again.
+  PushNode(node);
+
+  // Pairs with the barrier in ReloadWorkQueue().
+  subtle::MemoryBarrier();
+  bool was_empty =
+      subtle::NoBarrier_AtomicExchange(&pump_needs_wakeup_, 0) != 0;
 
   // Wake up the pump.
   message_loop_->ScheduleWork(was_empty);
 
+  EndPost();
   return true;
 }
 
+void IncomingTaskQueue::PushNode(NodeBase* node) {
+  subtle::NoBarrier_Store(&node->next, 0);
+
+  // Publish the contents of |node| before it becomes reachable.
+  subtle::MemoryBarrier();
+  NodeBase* prev = reinterpret_cast<NodeBase*>(
+      subtle::NoBarrier_AtomicExchange(
+          &head_, reinterpret_cast<subtle::AtomicWord>(node)));
+
+  // Until this store lands the consumer cannot see |node| or anything pushed
+  // after it; PopNode() treats that window as a transiently empty queue.
+  subtle::Release_Store(&prev->next,
+                        reinterpret_cast<subtle::AtomicWord>(node));
+}
+
+IncomingTaskQueue::TaskNode* IncomingTaskQueue::PopNode() {
+  NodeBase* tail = tail_;
+  NodeBase* next = AcquireLoadPointer<NodeBase>(&tail->next);
+  if (tail == &stub_) {
+    if (!next)
+      return NULL;
+    tail_ = next;
+    tail = next;
+    next = AcquireLoadPointer<NodeBase>(&tail->next);
+  }
+
+  if (next) {
+    tail_ = next;
+    return static_cast<TaskNode*>(tail);
+  }
+
+  // |tail| is the last linked node. If it is not the head either then a
+  // producer has swapped the head but not linked its node yet; that producer
+  // will wake the pump once it is done.
+  NodeBase* head = AcquireLoadPointer<NodeBase>(&head_);
+  if (tail != head)
+    return NULL;
+
+  // Re-insert |stub_| so that |tail| can be handed out without leaving the
+  // queue without a node.
+  PushNode(&stub_);
+  next = AcquireLoadPointer<NodeBase>(&tail->next);
+  if (next) {
+    tail_ = next;
+    return static_cast<TaskNode*>(tail);
+  }
+  return NULL;
+}
+
+void IncomingTaskQueue::DrainInto(TaskQueue* work_queue) {
+  while (TaskNode* node = PopNode()) {
+    work_queue->push(node->pending_task);
+    delete node;
+  }
+}
+
+bool IncomingTaskQueue::BeginPost() {
+  subtle::Atomic32 state =
+      subtle::Barrier_AtomicIncrement(&posting_state_, kPosterIncrement);
+  if (state & kClosedBit) {
+    EndPost();
+    return false;
+  }
+  return true;
+}
+
+void IncomingTaskQueue::EndPost() {
+  subtle::Barrier_AtomicIncrement(&posting_state_, -kPosterIncrement);
+}
+
 }  // namespace internal
 }  // namespace base
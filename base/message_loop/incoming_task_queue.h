@@ -5,6 +5,7 @@
 #ifndef BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 #define BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/memory/ref_counted.h"
 #include "base/pending_task.h"
@@ -14,13 +15,17 @@
 namespace base {
 
 class MessageLoop;
-class WaitableEvent;
 
 namespace internal {
 
 // Implements a queue of tasks posted to the message loop running on the current
 // thread. This class takes care of synchronizing posting tasks from different
 // threads and together with MessageLoop ensures clean shutdown.
+//
+// Posting does not take a lock: the queue is an intrusive multi-producer,
+// single-consumer linked list (after Dmitry Vyukov's design) where producers
+// publish a task with a single atomic exchange of the list head and the
+// thread running the message loop drains the list in ReloadWorkQueue().
 class BASE_EXPORT IncomingTaskQueue
     : public RefCountedThreadSafe<IncomingTaskQueue> {
  public:
@@ -38,9 +43,8 @@ class BASE_EXPORT IncomingTaskQueue
                           TimeDelta delay,
                           bool nestable);
 
-  // Same as AddToIncomingQueue() except that it will avoid blocking if the lock
-  // is already held, and will in that case (when the lock is contended) fail to
-  // add the task, and will return false.
+  // Same as AddToIncomingQueue() for a non-delayed, nestable task. Posting
+  // never blocks, so this only fails once the message loop is gone.
   bool TryAddToIncomingQueue(const tracked_objects::Location& from_here,
                              const Closure& task);
 
@@ -48,52 +52,122 @@ class BASE_EXPORT IncomingTaskQueue
   // Provided for testing.
   bool IsHighResolutionTimerEnabledForTesting();
 
-  // Returns true if the message loop is "idle". Provided for testing.
+  // Returns true if the message loop is "idle". Must be called from the thread
+  // that is running the loop. Provided for testing.
   bool IsIdleForTesting();
 
-  // Takes the incoming queue lock, signals |caller_wait| and waits until
-  // |caller_signal| is signalled.
-  void LockWaitUnLockForTesting(WaitableEvent* caller_wait,
-                                WaitableEvent* caller_signal);
-
-  // Loads tasks from the |incoming_queue_| into |*work_queue|. Must be called
+  // Loads tasks from the incoming queue into |*work_queue|. Must be called
   // from the thread that is running the loop.
   void ReloadWorkQueue(TaskQueue* work_queue);
 
-  // Disconnects |this| from the parent message loop.
+  // Disconnects |this| from the parent message loop. Waits for posts that are
+  // already in flight on other threads to finish with |message_loop_|.
   void WillDestroyCurrentMessageLoop();
 
  private:
   friend class RefCountedThreadSafe<IncomingTaskQueue>;
+
+  // A link of the incoming queue. |next| holds a NodeBase*.
+  struct NodeBase {
+    NodeBase();
+
+    subtle::AtomicWord next;
+  };
+
+  // A queued task. Owned by the queue from the moment it is pushed until
+  // ReloadWorkQueue() moves the task into the work queue.
+  //
+  // Every post allocates a node and the loop thread frees it, so freed nodes
+  // go to a small per-thread free list and are handed out again by the next
+  // post from that thread.
+  struct TaskNode : public NodeBase {
+    TaskNode(const tracked_objects::Location& posted_from,
+             const Closure& task,
+             TimeTicks delayed_run_time,
+             bool nestable);
+
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+
+    PendingTask pending_task;
+  };
+
   virtual ~IncomingTaskQueue();
 
   // Calculates the time at which a PendingTask should run.
   TimeTicks CalculateDelayedRuntime(TimeDelta delay);
 
-  // Adds a task to |incoming_queue_|. The caller retains ownership of
-  // |pending_task|, but this function will reset the value of
-  // |pending_task->task|. This is needed to ensure that the posting call stack
-  // does not retain |pending_task->task| beyond this function call.
-  bool PostPendingTask(PendingTask* pending_task);
+  // Adds |node| to the incoming queue and wakes up the message loop if needed.
+  // Takes ownership of |node|, and destroys it if the message loop is gone.
+  bool PostTaskNode(TaskNode* node);
+
+  // Links |node| at the head of the incoming queue. Safe to call from any
+  // thread.
+  void PushNode(NodeBase* node);
+
+  // Unlinks the oldest task from the tail of the incoming queue and returns
+  // it, or returns NULL if the queue is empty or a producer is in the middle of
+  // a push. The caller owns the returned node. Must only be called by the
+  // consumer.
+  TaskNode* PopNode();
+
+  // Moves every task that can be popped into |*work_queue|.
+  void DrainInto(TaskQueue* work_queue);
+
+  // Registers a post that is about to touch |message_loop_|. Returns false if
+  // the message loop has already been disconnected.
+  bool BeginPost();
+  void EndPost();
 
 #if defined(OS_WIN)
+  // Returns true if a high-resolution timer lease may need to be taken or
+  // given up, which is when |high_resolution_timer_lock_| must be taken.
+  // Every post checks, so this only reads an atomic.
+  bool HighResolutionTimerLeaseMayChange(bool needs_high_res_timers) const;
+
+  // Updates |high_resolution_timer_expiration_| and its atomic copy. Must be
+  // called with |high_resolution_timer_lock_| held.
+  void SetHighResolutionTimerExpiration(TimeTicks expiration);
+
+  // Protects |high_resolution_timer_expiration_|, which may be updated by any
+  // posting thread.
+  base::Lock high_resolution_timer_lock_;
   TimeTicks high_resolution_timer_expiration_;
+
+  // A copy of |high_resolution_timer_expiration_| that is read without the
+  // lock, in milliseconds since |high_resolution_timer_epoch_| and capped at
+  // kint32max. Zero while no lease is held.
+  TimeTicks high_resolution_timer_epoch_;
+  subtle::Atomic32 high_resolution_timer_expiration_ms_;
 #endif
 
-  // The lock that protects access to |incoming_queue_|, |message_loop_| and
-  // |next_sequence_num_|.
-  base::Lock incoming_queue_lock_;
+  // The producer end of the incoming queue. Holds a NodeBase* and is only ever
+  // updated with an atomic exchange.
+  subtle::AtomicWord head_;
+
+  // The consumer end of the incoming queue. Only accessed by the thread that
+  // runs the message loop.
+  NodeBase* tail_;
+
+  // Placeholder node that keeps the queue non-empty so producers never have to
+  // touch |tail_|.
+  NodeBase stub_;
+
+  // Set by the consumer when it has found the incoming queue empty, and cleared
+  // by the first producer that pushes a task afterwards. That producer is the
+  // one responsible for waking up the pump.
+  subtle::Atomic32 pump_needs_wakeup_;
 
-  // An incoming queue of tasks that are acquired under a mutex for processing
-  // on this instance's thread. These tasks have not yet been been pushed to
-  // |message_loop_|.
-  TaskQueue incoming_queue_;
+  // Number of posts in flight (in units of kPosterIncrement), or'ed with
+  // kClosedBit once WillDestroyCurrentMessageLoop() has been called.
+  subtle::Atomic32 posting_state_;
 
-  // Points to the message loop that owns |this|.
+  // Points to the message loop that owns |this|. Only dereferenced between
+  // BeginPost() and EndPost(), or on the thread running the loop.
   MessageLoop* message_loop_;
 
   // The next sequence number to use for delayed tasks.
-  int next_sequence_num_;
+  subtle::Atomic32 next_sequence_num_;
 
   DISALLOW_COPY_AND_ASSIGN(IncomingTaskQueue);
 };
@@ -0,0 +1,124 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/bind.h"
+#include "base/callback_internal.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "base/threading/thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const int kNumProducers = 32;
+const int kNumTasksPerProducer = 2000;
+
+// Counts the tasks posted to the loop by the producer threads. Only used on
+// the thread running the message loop.
+class TaskCounter {
+ public:
+  explicit TaskCounter(int num_producers)
+      : num_producers_running_(num_producers),
+        tasks_run_(0) {
+  }
+
+  void CountTask() { ++tasks_run_; }
+
+  void ProducerDone() {
+    if (--num_producers_running_ == 0)
+      MessageLoop::current()->QuitWhenIdle();
+  }
+
+  int tasks_run() const { return tasks_run_; }
+
+ private:
+  int num_producers_running_;
+  int tasks_run_;
+};
+
+void PostTasksFromProducer(scoped_refptr<MessageLoopProxy> target,
+                           TaskCounter* counter,
+                           int num_tasks) {
+  for (int i = 0; i < num_tasks; ++i) {
+    target->PostTask(FROM_HERE, Bind(&TaskCounter::CountTask,
+                                     Unretained(counter)));
+  }
+  target->PostTask(FROM_HERE, Bind(&TaskCounter::ProducerDone,
+                                   Unretained(counter)));
+}
+
+void PostChainedTasks(int* remaining) {
+  if (--*remaining > 0) {
+    MessageLoop::current()->PostTask(FROM_HERE,
+                                     Bind(&PostChainedTasks, remaining));
+  } else {
+    MessageLoop::current()->QuitWhenIdle();
+  }
+}
+
+}  // namespace
+
+// Times many threads posting to one loop at once while it is draining the
+// incoming queue.
+TEST(MessageLoopPerfTest, PostTaskFromManyThreads) {
+  MessageLoop loop;
+  TaskCounter counter(kNumProducers);
+
+  ScopedVector<Thread> producers;
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers.push_back(new Thread("MessageLoopPerfTestProducer"));
+    ASSERT_TRUE(producers.back()->Start());
+  }
+
+  PerfTimeLogger timer("MessageLoop_PostTaskFromManyThreads");
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers[i]->message_loop()->PostTask(
+        FROM_HERE,
+        Bind(&PostTasksFromProducer, loop.message_loop_proxy(),
+             Unretained(&counter), kNumTasksPerProducer));
+  }
+  loop.Run();
+  timer.Done();
+
+  EXPECT_EQ(kNumProducers * kNumTasksPerProducer, counter.tasks_run());
+}
+
+// Logs how many BindStates a loop that keeps posting to itself allocates from
+// the heap per posted task while BindState free lists are enabled.
+TEST(MessageLoopPerfTest, BindStateAllocationsPerPostedTask) {
+  const int kNumTasks = 1000;
+  internal::BindStateBase::SetFreeListsEnabled(true);
+  int start_heap_allocations;
+  int start_free_list_allocations;
+  internal::BindStateBase::GetAllocationCountsForTesting(
+      &start_heap_allocations, &start_free_list_allocations);
+
+  MessageLoop loop;
+  int remaining = kNumTasks;
+  loop.PostTask(FROM_HERE, Bind(&PostChainedTasks, &remaining));
+  loop.Run();
+  EXPECT_EQ(0, remaining);
+
+  int heap_allocations;
+  int free_list_allocations;
+  internal::BindStateBase::GetAllocationCountsForTesting(
+      &heap_allocations, &free_list_allocations);
+  heap_allocations -= start_heap_allocations;
+  free_list_allocations -= start_free_list_allocations;
+  LogPerfResult("MessageLoop_BindStateHeapAllocationsPerTask",
+                static_cast<double>(heap_allocations) / kNumTasks,
+                "allocations");
+  LogPerfResult("MessageLoop_BindStateFreeListAllocationsPerTask",
+                static_cast<double>(free_list_allocations) / kNumTasks,
+                "allocations");
+
+  internal::BindStateBase::SetFreeListsEnabled(false);
+}
+
+}  // namespace base
@@ -9,6 +9,7 @@
 #include "base/compiler_specific.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/scoped_vector.h"
 #include "base/message_loop/message_loop.h"
 #include "base/message_loop/message_loop_proxy_impl.h"
 #include "base/pending_task.h"
@@ -81,6 +82,11 @@ class Foo : public RefCounted<Foo> {
   std::string result_;
 };
 
+void TryPostFromThread(MessageLoop* target, const Closure& task,
+                       bool* posted) {
+  *posted = target->TryPostTask(FROM_HERE, task);
+}
+
 void RunTest_PostTask(MessageLoop::Type message_loop_type) {
   MessageLoop loop(message_loop_type);
 
@@ -102,24 +108,19 @@ void RunTest_PostTask(MessageLoop::Type message_loop_type) {
   EXPECT_TRUE(MessageLoop::current()->TryPostTask(FROM_HERE, Bind(
       &Foo::Test2Mixed, foo.get(), a, &d)));
 
-  // TryPost with simulated contention. It must fail. We wait for a helper
-  // thread to lock the queue, we TryPost on this thread and finally we
-  // signal the helper to unlock and exit.
-  WaitableEvent wait(true, false);
-  WaitableEvent signal(true, false);
+  // TryPost from another thread. Posting never blocks, so it must succeed
+  // too.
   Thread thread("RunTest_PostTask_helper");
   thread.Start();
+  bool posted = false;
   thread.message_loop()->PostTask(
       FROM_HERE,
-      Bind(&MessageLoop::LockWaitUnLockForTesting,
-           base::Unretained(MessageLoop::current()),
-           &wait,
-           &signal));
-
-  wait.Wait();
-  EXPECT_FALSE(MessageLoop::current()->TryPostTask(FROM_HERE, Bind(
-      &Foo::Test2Mixed, foo.get(), a, &d)));
-  signal.Signal();
+      Bind(&TryPostFromThread,
+           Unretained(MessageLoop::current()),
+           Bind(&Foo::Test2Mixed, foo.get(), a, &d),
+           &posted));
+  thread.Stop();
+  EXPECT_TRUE(posted);
 
   // After all tests, post a message that will shut down the message loop
   MessageLoop::current()->PostTask(FROM_HERE, Bind(
@@ -128,8 +129,8 @@ void RunTest_PostTask(MessageLoop::Type message_loop_type) {
   // Now kick things off
   MessageLoop::current()->Run();
 
-  EXPECT_EQ(foo->test_count(), 105);
-  EXPECT_EQ(foo->result(), "abacad");
+  EXPECT_EQ(foo->test_count(), 106);
+  EXPECT_EQ(foo->result(), "abacadad");
 }
 
 void RunTest_PostTask_SEH(MessageLoop::Type message_loop_type) {
@@ -2083,6 +2084,81 @@ TEST(MessageLoopTest, ThreadMainTaskRunner) {
   EXPECT_EQ(foo->result(), "a");
 }
 
+namespace {
+
+// Records the tasks posted by the producers of the PostTaskFromManyThreads
+// test. Only used on the thread running the message loop.
+class ProducerTaskRecorder {
+ public:
+  explicit ProducerTaskRecorder(int num_producers)
+      : next_task_(num_producers, 0),
+        num_producers_running_(num_producers),
+        out_of_order_tasks_(0) {
+  }
+
+  void RecordTask(int producer, int task) {
+    if (next_task_[producer] != task)
+      ++out_of_order_tasks_;
+    next_task_[producer] = task + 1;
+  }
+
+  void ProducerDone() {
+    if (--num_producers_running_ == 0)
+      MessageLoop::current()->QuitWhenIdle();
+  }
+
+  int tasks_run(int producer) const { return next_task_[producer]; }
+  int out_of_order_tasks() const { return out_of_order_tasks_; }
+
+ private:
+  std::vector<int> next_task_;
+  int num_producers_running_;
+  int out_of_order_tasks_;
+};
+
+void PostTasksFromProducer(scoped_refptr<MessageLoopProxy> target,
+                           ProducerTaskRecorder* recorder,
+                           int producer,
+                           int num_tasks) {
+  for (int i = 0; i < num_tasks; ++i) {
+    target->PostTask(FROM_HERE, Bind(&ProducerTaskRecorder::RecordTask,
+                                     Unretained(recorder), producer, i));
+  }
+  target->PostTask(FROM_HERE, Bind(&ProducerTaskRecorder::ProducerDone,
+                                   Unretained(recorder)));
+}
+
+}  // namespace
+
+// Posts from several threads at once while the loop is draining the incoming
+// queue. Every task must run, and the tasks of each producer must run in the
+// order they were posted. See message_loop_perftest.cc for the timing.
+TEST(MessageLoopTest, PostTaskFromManyThreads) {
+  const int kNumProducers = 8;
+  const int kNumTasksPerProducer = 200;
+
+  MessageLoop loop;
+  ProducerTaskRecorder recorder(kNumProducers);
+
+  ScopedVector<Thread> producers;
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers.push_back(new Thread("MessageLoopTestProducer"));
+    ASSERT_TRUE(producers.back()->Start());
+  }
+
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers[i]->message_loop()->PostTask(
+        FROM_HERE,
+        Bind(&PostTasksFromProducer, loop.message_loop_proxy(),
+             Unretained(&recorder), i, kNumTasksPerProducer));
+  }
+  loop.Run();
+
+  for (int i = 0; i < kNumProducers; ++i)
+    EXPECT_EQ(kNumTasksPerProducer, recorder.tasks_run(i));
+  EXPECT_EQ(0, recorder.out_of_order_tasks());
+}
+
 TEST(MessageLoopTest, IsType) {
   MessageLoop loop(MessageLoop::TYPE_UI);
   EXPECT_TRUE(loop.IsType(MessageLoop::TYPE_UI));
@@ -89,8 +89,10 @@ void HistogramDeltaSerialization::RecordDelta(
   Pickle pickle;
   histogram.SerializeInfo(&pickle);
   snapshot.Serialize(&pickle);
-  serialized_deltas_->push_back(
-      std::string(static_cast<const char*>(pickle.data()), pickle.size()));
+  // Assign in place instead of copying a temporary string into the vector.
+  serialized_deltas_->push_back(std::string());
+  serialized_deltas_->back().assign(static_cast<const char*>(pickle.data()),
+                                    pickle.size());
 }
 
 void HistogramDeltaSerialization::InconsistencyDetected(
@@ -113,8 +113,7 @@ void HistogramSamples::IncreaseSum(int64 diff) {
 }
 
 void HistogramSamples::IncreaseRedundantCount(HistogramBase::Count diff) {
-  base::subtle::NoBarrier_Store(&redundant_count_,
-      base::subtle::NoBarrier_Load(&redundant_count_) + diff);
+  base::subtle::NoBarrier_AtomicIncrement(&redundant_count_, diff);
 }
 
 SampleCountIterator::~SampleCountIterator() {}
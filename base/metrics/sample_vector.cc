@@ -24,8 +24,10 @@ SampleVector::~SampleVector() {}
 
 void SampleVector::Accumulate(Sample value, Count count) {
   size_t bucket_index = GetBucketIndex(value);
-  subtle::NoBarrier_Store(&counts_[bucket_index],
-      subtle::NoBarrier_Load(&counts_[bucket_index]) + count);
+  // Histograms are recorded into from many threads without a lock; an atomic
+  // increment keeps concurrent samples that land in the same bucket from
+  // being lost.
+  subtle::NoBarrier_AtomicIncrement(&counts_[bucket_index], count);
   IncreaseSum(count * value);
   IncreaseRedundantCount(count);
 }
@@ -69,8 +71,14 @@ bool SampleVector::AddSubtractImpl(SampleCountIterator* iter,
       counts_[index] += (op ==  HistogramSamples::ADD) ? count : -count;
       iter->Next();
     } else if (min > bucket_ranges_->range(index)) {
-      // Sample is larger than current bucket range. Try next.
-      index++;
+      // Sample is larger than current bucket range. Deltas are usually
+      // sparse, so binary search for its bucket instead of stepping through
+      // the empty ones.
+      if (min >= bucket_ranges_->range(counts_.size()))
+        return false;
+      index = GetBucketIndex(min);
+      if (min != bucket_ranges_->range(index))
+        return false;
     } else {
       // Sample is smaller than current bucket range. We scan buckets from
       // smallest to largest, so the sample value must be invalid.
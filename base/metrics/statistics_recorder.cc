@@ -4,8 +4,11 @@
 
 #include "base/metrics/statistics_recorder.h"
 
+#include <algorithm>
+
 #include "base/at_exit.h"
 #include "base/debug/leak_annotations.h"
+#include "base/hash.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/histogram.h"
@@ -19,6 +22,11 @@ namespace {
 // Initialize histogram statistics gathering system.
 base::LazyInstance<base::StatisticsRecorder>::Leaky g_statistics_recorder_ =
     LAZY_INSTANCE_INITIALIZER;
+
+bool HistogramNameLessThan(const base::HistogramBase* a,
+                           const base::HistogramBase* b) {
+  return a->histogram_name() < b->histogram_name();
+}
 }  // namespace
 
 namespace base {
@@ -54,14 +62,16 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
   HistogramBase* histogram_to_delete = NULL;
   HistogramBase* histogram_to_return = NULL;
   {
-    base::AutoLock auto_lock(*lock_);
+    const string& name = histogram->histogram_name();
+    size_t shard = GetShardIndex(name);
+    base::AutoLock auto_lock(histogram_locks_[shard]);
     if (histograms_ == NULL) {
       histogram_to_return = histogram;
     } else {
-      const string& name = histogram->histogram_name();
-      HistogramMap::iterator it = histograms_->find(name);
-      if (histograms_->end() == it) {
-        (*histograms_)[name] = histogram;
+      HistogramMap* histograms = &histograms_[shard];
+      HistogramMap::iterator it = histograms->find(name);
+      if (histograms->end() == it) {
+        (*histograms)[name] = histogram;
         ANNOTATE_LEAKING_OBJECT_PTR(histogram);  // see crbug.com/79322
         histogram_to_return = histogram;
       } else if (histogram == it->second) {
@@ -166,16 +176,23 @@ void StatisticsRecorder::WriteGraph(const std::string& query,
 void StatisticsRecorder::GetHistograms(Histograms* output) {
   if (lock_ == NULL)
     return;
-  base::AutoLock auto_lock(*lock_);
-  if (histograms_ == NULL)
-    return;
 
-  for (HistogramMap::iterator it = histograms_->begin();
-       histograms_->end() != it;
-       ++it) {
-    DCHECK_EQ(it->first, it->second->histogram_name());
-    output->push_back(it->second);
+  size_t first_new_histogram = output->size();
+  for (size_t shard = 0; shard < kHistogramShardCount; ++shard) {
+    base::AutoLock auto_lock(histogram_locks_[shard]);
+    if (histograms_ == NULL)
+      return;
+
+    for (HistogramMap::iterator it = histograms_[shard].begin();
+         histograms_[shard].end() != it;
+         ++it) {
+      DCHECK_EQ(it->first, it->second->histogram_name());
+      output->push_back(it->second);
+    }
   }
+  // Keep returning the histograms in name order, as a single map would.
+  std::sort(output->begin() + first_new_histogram, output->end(),
+            &HistogramNameLessThan);
 }
 
 // static
@@ -204,12 +221,13 @@ void StatisticsRecorder::GetBucketRanges(
 HistogramBase* StatisticsRecorder::FindHistogram(const std::string& name) {
   if (lock_ == NULL)
     return NULL;
-  base::AutoLock auto_lock(*lock_);
+  size_t shard = GetShardIndex(name);
+  base::AutoLock auto_lock(histogram_locks_[shard]);
   if (histograms_ == NULL)
     return NULL;
 
-  HistogramMap::iterator it = histograms_->find(name);
-  if (histograms_->end() == it)
+  HistogramMap::iterator it = histograms_[shard].find(name);
+  if (histograms_[shard].end() == it)
     return NULL;
   return it->second;
 }
@@ -219,16 +237,27 @@ void StatisticsRecorder::GetSnapshot(const std::string& query,
                                      Histograms* snapshot) {
   if (lock_ == NULL)
     return;
-  base::AutoLock auto_lock(*lock_);
-  if (histograms_ == NULL)
-    return;
 
-  for (HistogramMap::iterator it = histograms_->begin();
-       histograms_->end() != it;
-       ++it) {
-    if (it->first.find(query) != std::string::npos)
-      snapshot->push_back(it->second);
+  size_t first_new_histogram = snapshot->size();
+  for (size_t shard = 0; shard < kHistogramShardCount; ++shard) {
+    base::AutoLock auto_lock(histogram_locks_[shard]);
+    if (histograms_ == NULL)
+      return;
+
+    for (HistogramMap::iterator it = histograms_[shard].begin();
+         histograms_[shard].end() != it;
+         ++it) {
+      if (it->first.find(query) != std::string::npos)
+        snapshot->push_back(it->second);
+    }
   }
+  std::sort(snapshot->begin() + first_new_histogram, snapshot->end(),
+            &HistogramNameLessThan);
+}
+
+// static
+size_t StatisticsRecorder::GetShardIndex(const std::string& name) {
+  return Hash(name) % kHistogramShardCount;
 }
 
 // This singleton instance should be started during the single threaded portion
@@ -243,11 +272,16 @@ StatisticsRecorder::StatisticsRecorder() {
     // during the termination phase. Since it's a static data member, we will
     // leak one per process, which would be similar to the instance allocated
     // during static initialization and released only on  process termination.
+    histogram_locks_ = new base::Lock[kHistogramShardCount];
     lock_ = new base::Lock;
   }
   base::AutoLock auto_lock(*lock_);
-  histograms_ = new HistogramMap;
+  for (size_t shard = 0; shard < kHistogramShardCount; ++shard)
+    histogram_locks_[shard].Acquire();
+  histograms_ = new HistogramMap[kHistogramShardCount];
   ranges_ = new RangesMap;
+  for (size_t shard = 0; shard < kHistogramShardCount; ++shard)
+    histogram_locks_[shard].Release();
 
   if (VLOG_IS_ON(1))
     AtExitManager::RegisterCallback(&DumpHistogramsToVlog, this);
@@ -267,16 +301,21 @@ StatisticsRecorder::~StatisticsRecorder() {
   DCHECK(histograms_ && ranges_ && lock_);
 
   // Clean up.
-  scoped_ptr<HistogramMap> histograms_deleter;
+  scoped_ptr<HistogramMap[]> histograms_deleter;
   scoped_ptr<RangesMap> ranges_deleter;
-  // We don't delete lock_ on purpose to avoid having to properly protect
-  // against it going away after we checked for NULL in the static methods.
+  // We don't delete lock_ and histogram_locks_ on purpose to avoid having to
+  // properly protect against them going away after we checked for NULL in the
+  // static methods.
   {
     base::AutoLock auto_lock(*lock_);
+    for (size_t shard = 0; shard < kHistogramShardCount; ++shard)
+      histogram_locks_[shard].Acquire();
     histograms_deleter.reset(histograms_);
     ranges_deleter.reset(ranges_);
     histograms_ = NULL;
     ranges_ = NULL;
+    for (size_t shard = 0; shard < kHistogramShardCount; ++shard)
+      histogram_locks_[shard].Release();
   }
   // We are going to leak the histograms and the ranges.
 }
@@ -288,5 +327,7 @@ StatisticsRecorder::HistogramMap* StatisticsRecorder::histograms_ = NULL;
 StatisticsRecorder::RangesMap* StatisticsRecorder::ranges_ = NULL;
 // static
 base::Lock* StatisticsRecorder::lock_ = NULL;
+// static
+base::Lock* StatisticsRecorder::histogram_locks_ = NULL;
 
 }  // namespace base
@@ -62,7 +62,9 @@ class BASE_EXPORT StatisticsRecorder {
   static void GetBucketRanges(std::vector<const BucketRanges*>* output);
 
   // Find a histogram by name. It matches the exact name. This method is thread
-  // safe.  It returns NULL if a matching histogram is not found.
+  // safe, and only contends with registrations and lookups of histograms that
+  // hash to the same shard.  It returns NULL if a matching histogram is not
+  // found.
   static HistogramBase* FindHistogram(const std::string& name);
 
   // GetSnapshot copies some of the pointers to registered histograms into the
@@ -72,8 +74,11 @@ class BASE_EXPORT StatisticsRecorder {
   static void GetSnapshot(const std::string& query, Histograms* snapshot);
 
  private:
-  // We keep all registered histograms in a map, from name to histogram.
+  // We keep all registered histograms in maps, from name to histogram. The
+  // histograms are spread over kHistogramShardCount maps by a hash of their
+  // name, each guarded by its own lock.
   typedef std::map<std::string, HistogramBase*> HistogramMap;
+  enum { kHistogramShardCount = 16 };
 
   // We keep all |bucket_ranges_| in a map, from checksum to a list of
   // |bucket_ranges_|.  Checksum is calculated from the |ranges_| in
@@ -96,12 +101,23 @@ class BASE_EXPORT StatisticsRecorder {
 
   static void DumpHistogramsToVlog(void* instance);
 
+  // Returns the index of the shard of |histograms_| that holds |name|.
+  static size_t GetShardIndex(const std::string& name);
+
+  // Array of kHistogramShardCount maps, or NULL while the StatisticsRecorder
+  // is not initialized. The pointer itself only changes while |lock_| and all
+  // of |histogram_locks_| are held, so holding any one of them is enough to
+  // read it.
   static HistogramMap* histograms_;
   static RangesMap* ranges_;
 
-  // Lock protects access to above maps.
+  // Lock protects access to |ranges_|.
   static base::Lock* lock_;
 
+  // Array of kHistogramShardCount locks. Each one protects the contents of the
+  // shard of |histograms_| with the same index.
+  static base::Lock* histogram_locks_;
+
   DISALLOW_COPY_AND_ASSIGN(StatisticsRecorder);
 };
 
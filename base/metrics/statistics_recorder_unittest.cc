@@ -6,11 +6,42 @@
 
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/histogram.h"
+#include "base/metrics/histogram_samples.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace base {
 
+namespace {
+
+// Looks up and records into a fixed set of histograms, so several instances
+// running at once contend on the same StatisticsRecorder shards and buckets.
+class HistogramHammer : public DelegateSimpleThread::Delegate {
+ public:
+  HistogramHammer(int histogram_count, int iterations)
+      : histogram_count_(histogram_count),
+        iterations_(iterations) {}
+
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < iterations_; ++i) {
+      HistogramBase* histogram = Histogram::FactoryGet(
+          StringPrintf("Hammer%d", i % histogram_count_), 1, 1000, 10,
+          HistogramBase::kNoFlags);
+      histogram->Add(1);
+    }
+  }
+
+ private:
+  const int histogram_count_;
+  const int iterations_;
+
+  DISALLOW_COPY_AND_ASSIGN(HistogramHammer);
+};
+
+}  // namespace
+
 class StatisticsRecorderTest : public testing::Test {
  protected:
   virtual void SetUp() {
@@ -167,6 +198,51 @@ TEST_F(StatisticsRecorderTest, GetSnapshot) {
   EXPECT_EQ(0u, snapshot.size());
 }
 
+TEST_F(StatisticsRecorderTest, GetHistogramsSortedByName) {
+  // Enough histograms to occupy every shard.
+  for (int i = 99; i >= 0; --i) {
+    Histogram::FactoryGet(StringPrintf("TestHistogram%02d", i), 1, 1000, 10,
+                          HistogramBase::kNoFlags);
+  }
+
+  StatisticsRecorder::Histograms histograms;
+  StatisticsRecorder::GetHistograms(&histograms);
+  ASSERT_EQ(100u, histograms.size());
+  for (size_t i = 0; i < histograms.size(); ++i) {
+    EXPECT_EQ(StringPrintf("TestHistogram%02d", static_cast<int>(i)),
+              histograms[i]->histogram_name());
+  }
+
+  StatisticsRecorder::Histograms snapshot;
+  StatisticsRecorder::GetSnapshot("TestHistogram", &snapshot);
+  EXPECT_TRUE(histograms == snapshot);
+}
+
+TEST_F(StatisticsRecorderTest, ConcurrentFactoryGetAndAdd) {
+  const int kThreadCount = 8;
+  const int kHistogramCount = 20;
+  const int kIterations = 1000;
+
+  HistogramHammer hammer(kHistogramCount, kIterations);
+  DelegateSimpleThreadPool pool("HistogramHammer", kThreadCount);
+  pool.AddWork(&hammer, kThreadCount);
+  pool.Start();
+  pool.JoinAll();
+
+  StatisticsRecorder::Histograms histograms;
+  StatisticsRecorder::GetHistograms(&histograms);
+  ASSERT_EQ(static_cast<size_t>(kHistogramCount), histograms.size());
+
+  // No registration may be duplicated and no sample may be lost.
+  int total_count = 0;
+  for (size_t i = 0; i < histograms.size(); ++i) {
+    scoped_ptr<HistogramSamples> samples = histograms[i]->SnapshotSamples();
+    EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
+    total_count += samples->TotalCount();
+  }
+  EXPECT_EQ(kThreadCount * kIterations, total_count);
+}
+
 TEST_F(StatisticsRecorderTest, RegisterHistogramWithFactoryGet) {
   StatisticsRecorder::Histograms registered_histograms;
 
@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/bind.h"
@@ -224,14 +226,26 @@ class ObserverListThreadSafe
 
   template <class Method, class Params>
   void Notify(const UnboundMethod<ObserverType, Method, Params>& method) {
-    base::AutoLock lock(list_lock_);
-    typename ObserversListMap::iterator it;
-    for (it = observer_lists_.begin(); it != observer_lists_.end(); ++it) {
-      ObserverListContext* context = (*it).second;
-      context->loop->PostTask(
+    // Snapshot the contexts under the lock and post outside of it, so that
+    // threads adding, removing or being notified don't wait on PostTask().
+    // NotifyWrapper() checks that the context is still current before using
+    // it, so a context removed in the meantime is dropped as before.
+    std::vector<NotifyTarget> targets;
+    {
+      base::AutoLock lock(list_lock_);
+      targets.reserve(observer_lists_.size());
+      typename ObserversListMap::iterator it;
+      for (it = observer_lists_.begin(); it != observer_lists_.end(); ++it) {
+        ObserverListContext* context = (*it).second;
+        targets.push_back(NotifyTarget(context->loop, context));
+      }
+    }
+    for (size_t i = 0; i < targets.size(); ++i) {
+      targets[i].first->PostTask(
           FROM_HERE,
           base::Bind(&ObserverListThreadSafe<ObserverType>::
-              template NotifyWrapper<Method, Params>, this, context, method));
+              template NotifyWrapper<Method, Params>,
+              this, targets[i].second, method));
     }
   }
 
@@ -285,6 +299,11 @@ class ObserverListThreadSafe
   typedef std::map<base::PlatformThreadId, ObserverListContext*>
       ObserversListMap;
 
+  // A context and the loop to post its notifications to, copied out of
+  // |observer_lists_| by Notify().
+  typedef std::pair<scoped_refptr<base::MessageLoopProxy>,
+                    ObserverListContext*> NotifyTarget;
+
   mutable base::Lock list_lock_;  // Protects the observer_lists_.
   ObserversListMap observer_lists_;
   const NotificationType type_;
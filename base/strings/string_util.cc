@@ -392,12 +392,7 @@ bool WideToLatin1(const std::wstring& wide, std::string* latin1) {
 
 template<class STR>
 static bool DoIsStringASCII(const STR& str) {
-  for (size_t i = 0; i < str.length(); i++) {
-    typename ToUnsigned<typename STR::value_type>::Unsigned c = str[i];
-    if (c > 0x7F)
-      return false;
-  }
-  return true;
+  return base::CountLeadingASCII(str.data(), str.length()) == str.length();
 }
 
 bool IsStringASCII(const std::wstring& str) {
@@ -420,6 +415,12 @@ bool IsStringUTF8(const std::string& str) {
   int32 char_index = 0;
 
   while (char_index < src_len) {
+    // ASCII is always valid; skip over runs of it without decoding.
+    char_index += static_cast<int32>(
+        base::CountLeadingASCII(src + char_index, src_len - char_index));
+    if (char_index == src_len)
+      break;
+
     int32 code_point;
     CBU8_NEXT(src, char_index, src_len, code_point);
     if (!base::IsValidCharacter(code_point))
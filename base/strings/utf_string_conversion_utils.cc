@@ -8,6 +8,80 @@
 
 namespace base {
 
+namespace {
+
+typedef uintptr_t MachineWord;
+const MachineWord kMachineWordAlignmentMask = sizeof(MachineWord) - 1;
+
+// Returns a machine word with the bits set that are clear in every ASCII
+// character of size |CHAR_SIZE| packed into the word.
+template<size_t CHAR_SIZE> struct NonASCIIMask;
+template<> struct NonASCIIMask<1> {
+  static inline MachineWord value() {
+    return static_cast<MachineWord>(0x8080808080808080ULL);
+  }
+};
+template<> struct NonASCIIMask<2> {
+  static inline MachineWord value() {
+    return static_cast<MachineWord>(0xFF80FF80FF80FF80ULL);
+  }
+};
+template<> struct NonASCIIMask<4> {
+  static inline MachineWord value() {
+    return static_cast<MachineWord>(0xFFFFFF80FFFFFF80ULL);
+  }
+};
+
+template<typename CHAR>
+inline bool IsASCII(CHAR c) {
+  // The cast makes negative values of signed character types non-ASCII.
+  return static_cast<uint32>(c) < 0x80;
+}
+
+template<typename CHAR>
+size_t DoCountLeadingASCII(const CHAR* src, size_t src_len) {
+  size_t i = 0;
+
+  // Step one character at a time until |src| + |i| is word aligned.
+  while (i < src_len &&
+         (reinterpret_cast<MachineWord>(src + i) & kMachineWordAlignmentMask)) {
+    if (!IsASCII(src[i]))
+      return i;
+    ++i;
+  }
+
+  // Test a whole machine word's worth of characters at once.
+  const size_t kCharsPerWord = sizeof(MachineWord) / sizeof(CHAR);
+  const MachineWord non_ascii_mask = NonASCIIMask<sizeof(CHAR)>::value();
+  while (i + kCharsPerWord <= src_len &&
+         !(*reinterpret_cast<const MachineWord*>(src + i) & non_ascii_mask))
+    i += kCharsPerWord;
+
+  // Find the exact position within the remaining tail or the first word that
+  // held a non-ASCII character.
+  while (i < src_len && IsASCII(src[i]))
+    ++i;
+  return i;
+}
+
+}  // namespace
+
+// CountLeadingASCII -----------------------------------------------------------
+
+size_t CountLeadingASCII(const char* src, size_t src_len) {
+  return DoCountLeadingASCII(src, src_len);
+}
+
+size_t CountLeadingASCII(const char16* src, size_t src_len) {
+  return DoCountLeadingASCII(src, src_len);
+}
+
+#if defined(WCHAR_T_IS_UTF32)
+size_t CountLeadingASCII(const wchar_t* src, size_t src_len) {
+  return DoCountLeadingASCII(src, src_len);
+}
+#endif  // defined(WCHAR_T_IS_UTF32)
+
 // ReadUnicodeCharacter --------------------------------------------------------
 
 bool ReadUnicodeCharacter(const char* src,
@@ -28,6 +28,17 @@ inline bool IsValidCharacter(uint32 code_point) {
       code_point <= 0x10FFFFu && (code_point & 0xFFFEu) != 0xFFFEu);
 }
 
+// CountLeadingASCII -----------------------------------------------------------
+
+// Returns the number of characters at the start of |src| that are ASCII
+// (below 0x80), examining up to |src_len| characters. The converters use this
+// to copy runs of ASCII in bulk rather than one code point at a time.
+BASE_EXPORT size_t CountLeadingASCII(const char* src, size_t src_len);
+BASE_EXPORT size_t CountLeadingASCII(const char16* src, size_t src_len);
+#if defined(WCHAR_T_IS_UTF32)
+BASE_EXPORT size_t CountLeadingASCII(const wchar_t* src, size_t src_len);
+#endif  // defined(WCHAR_T_IS_UTF32)
+
 // ReadUnicodeCharacter --------------------------------------------------------
 
 // Reads a UTF-8 stream, placing the next code point into the given output
@@ -6,6 +6,7 @@
 #include "base/logging.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversion_utils.h"
 #include "base/strings/utf_string_conversions.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -208,4 +209,55 @@ TEST(UTFStringConversionsTest, ConvertMultiString) {
   EXPECT_EQ(expected, converted);
 }
 
+// The ASCII fast paths scan a machine word at a time, so put a non-ASCII
+// character at every offset around the word boundaries and make sure it is
+// still found and converted.
+TEST(UTFStringConversionsTest, ConvertNonASCIIAtEveryOffset) {
+  for (size_t prefix_len = 0; prefix_len < 40; ++prefix_len) {
+    for (size_t suffix_len = 0; suffix_len < 20; suffix_len += 3) {
+      // "e" with acute accent, U+00E9.
+      std::string utf8 = std::string(prefix_len, 'a') + "\xc3\xa9" +
+                         std::string(suffix_len, 'b');
+      string16 utf16 = string16(prefix_len, 'a') + static_cast<char16>(0xE9) +
+                       string16(suffix_len, 'b');
+
+      EXPECT_EQ(utf16, UTF8ToUTF16(utf8));
+      EXPECT_EQ(utf8, UTF16ToUTF8(utf16));
+      EXPECT_TRUE(IsStringUTF8(utf8));
+      EXPECT_FALSE(IsStringASCII(utf8));
+      EXPECT_FALSE(IsStringASCII(utf16));
+      EXPECT_EQ(prefix_len, CountLeadingASCII(utf8.data(), utf8.length()));
+      EXPECT_EQ(prefix_len, CountLeadingASCII(utf16.data(), utf16.length()));
+
+      // A lone continuation byte is invalid wherever it appears.
+      std::string invalid = std::string(prefix_len, 'a') + "\x80" +
+                            std::string(suffix_len, 'b');
+      EXPECT_FALSE(IsStringUTF8(invalid));
+      string16 replaced;
+      EXPECT_FALSE(UTF8ToUTF16(invalid.data(), invalid.length(), &replaced));
+      EXPECT_EQ(string16(prefix_len, 'a') + static_cast<char16>(0xFFFD) +
+                    string16(suffix_len, 'b'),
+                replaced);
+    }
+  }
+}
+
+// Long mostly-ASCII text, the common case for URLs, IPC strings and JSON,
+// goes through many ASCII runs of different lengths and must round-trip.
+TEST(UTFStringConversionsTest, ConvertMostlyASCII) {
+  std::string utf8;
+  string16 expected_utf16;
+  for (int i = 0; i < 100; ++i) {
+    std::string ascii(i % 23, static_cast<char>('a' + i % 26));
+    utf8 += ascii + "\xc3\xa9";
+    expected_utf16 += ASCIIToUTF16(ascii) + static_cast<char16>(0xE9);
+  }
+
+  string16 utf16 = UTF8ToUTF16(utf8);
+  EXPECT_EQ(expected_utf16, utf16);
+  EXPECT_EQ(utf8, UTF16ToUTF8(utf16));
+  EXPECT_TRUE(IsStringUTF8(utf8));
+  EXPECT_FALSE(IsStringASCII(utf8));
+}
+
 }  // base
@@ -318,6 +318,8 @@ class SequencedWorkerPool::Inner {
     CLEANUP_DONE,
   };
 
+  typedef std::set<SequencedTask, SequencedTaskLessThan> PendingTaskSet;
+
   // Called from within the lock, this converts the given token name into a
   // token ID, creating a new one if necessary.
   int LockedGetNamedTokenID(const std::string& name);
@@ -362,6 +364,23 @@ class SequencedWorkerPool::Inner {
   // sequence token.
   bool IsSequenceTokenRunnable(int sequence_token_id) const;
 
+  // Adds |task| to |pending_tasks_| if it can be run as soon as its time
+  // comes, or to the waiting list of its sequence otherwise. Must be called
+  // from within the lock.
+  void LockedAddPendingTask(const SequencedTask& task);
+
+  // Removes the task at |task| from |pending_tasks_|. If |promote_next| is
+  // true, the next task of the same sequence (if any) becomes runnable; pass
+  // false when the removed task is about to run, since its sequence stays
+  // busy until DidRunWorkerTask(). Must be called from within the lock.
+  void LockedErasePendingTask(PendingTaskSet::iterator task,
+                              bool promote_next);
+
+  // Moves the earliest waiting task of |sequence_token_id| into
+  // |pending_tasks_|, and forgets the sequence if nothing is left in it. Must
+  // be called from within the lock.
+  void LockedPromoteNextSequencedTask(int sequence_token_id);
+
   // Checks if all threads are busy and the addition of one more could run an
   // additional task waiting in the queue. This must be called from within
   // the lock.
@@ -435,19 +454,40 @@ class SequencedWorkerPool::Inner {
   // or SKIP_ON_SHUTDOWN flag set.
   size_t blocking_shutdown_thread_count_;
 
-  // A set of all pending tasks in time-to-run order. These are tasks that are
-  // either waiting for a thread to run on, waiting for their time to run,
-  // or blocked on a previous task in their sequence. We have to iterate over
-  // the tasks by time-to-run order, so we use the set instead of the
-  // traditional priority_queue.
-  typedef std::set<SequencedTask, SequencedTaskLessThan> PendingTaskSet;
+  // A set of the pending tasks that could run right away, in time-to-run
+  // order. These are tasks that are either waiting for a thread to run on or
+  // waiting for their time to run. It holds every unsequenced task and, for
+  // every sequence that is not currently running, the earliest task of that
+  // sequence. Because nothing in here is blocked on its sequence, GetWork()
+  // only ever has to look at the first entry. We have to iterate over the
+  // tasks by time-to-run order, so we use the set instead of the traditional
+  // priority_queue.
   PendingTaskSet pending_tasks_;
 
+  // The pending tasks of one sequence that are not in |pending_tasks_|:
+  // those that are blocked on a previous task of the sequence, either a
+  // running one or the one at |head|.
+  struct SequenceQueue {
+    SequenceQueue() : has_pending_head(false) {}
+
+    // Whether |head| points to the earliest task of the sequence in
+    // |pending_tasks_|.
+    bool has_pending_head;
+    PendingTaskSet::iterator head;
+
+    // The remaining tasks of the sequence, in time-to-run order.
+    PendingTaskSet waiting;
+  };
+
+  // The sequences that have pending tasks, keyed by sequence token ID.
+  typedef std::map<int, SequenceQueue> SequenceQueueMap;
+  SequenceQueueMap sequence_queues_;
+
   // The next sequence number for a new sequenced task.
   int64 next_sequence_task_number_;
 
-  // Number of tasks in the pending_tasks_ list that are marked as blocking
-  // shutdown.
+  // Number of tasks in the pending_tasks_ list or in one of the
+  // |sequence_queues_| that are marked as blocking shutdown.
   size_t blocking_shutdown_pending_task_count_;
 
   // Lists all sequence tokens currently executing.
@@ -602,7 +642,7 @@ bool SequencedWorkerPool::Inner::PostTask(
     if (optional_token_name)
       sequenced.sequence_token_id = LockedGetNamedTokenID(*optional_token_name);
 
-    pending_tasks_.insert(sequenced);
+    LockedAddPendingTask(sequenced);
     if (shutdown_behavior == BLOCK_SHUTDOWN)
       blocking_shutdown_pending_task_count_++;
 
@@ -901,41 +941,23 @@ SequencedWorkerPool::Inner::GetWorkStatus SequencedWorkerPool::Inner::GetWork(
                            static_cast<int>(pending_tasks_.size()));
 #endif
 
-  // Find the next task with a sequence token that's not currently in use.
-  // If the token is in use, that means another thread is running something
-  // in that sequence, and we can't run it without going out-of-order.
-  //
-  // This algorithm is simple and fair, but inefficient in some cases. For
-  // example, say somebody schedules 1000 slow tasks with the same sequence
-  // number. We'll have to go through all those tasks each time we feel like
-  // there might be work to schedule. If this proves to be a problem, we
-  // should make this more efficient.
-  //
-  // One possible enhancement would be to keep a map from sequence ID to a
-  // list of pending but currently blocked SequencedTasks for that ID.
-  // When a worker finishes a task of one sequence token, it can pick up the
-  // next one from that token right away.
+  // Find the next task to run. Tasks whose sequence token is currently in use
+  // never make it into |pending_tasks_| (see LockedAddPendingTask()), so the
+  // first task in time-to-run order is always the one to look at. Running it
+  // out of order would need another thread to be running something in that
+  // sequence.
   //
   // This may lead to starvation if there are sufficient numbers of sequences
   // in use. To alleviate this, we could add an incrementing priority counter
-  // to each SequencedTask. Then maintain a priority_queue of all runnable
-  // tasks, sorted by priority counter. When a sequenced task is completed
-  // we would pop the head element off of that tasks pending list and add it
-  // to the priority queue. Then we would run the first item in the priority
-  // queue.
+  // to each SequencedTask, and order |pending_tasks_| by it.
 
   GetWorkStatus status = GET_WORK_NOT_FOUND;
-  int unrunnable_tasks = 0;
-  PendingTaskSet::iterator i = pending_tasks_.begin();
   // We assume that the loop below doesn't take too long and so we can just do
   // a single call to TimeTicks::Now().
   const TimeTicks current_time = TimeTicks::Now();
-  while (i != pending_tasks_.end()) {
-    if (!IsSequenceTokenRunnable(i->sequence_token_id)) {
-      unrunnable_tasks++;
-      ++i;
-      continue;
-    }
+  while (!pending_tasks_.empty()) {
+    PendingTaskSet::iterator i = pending_tasks_.begin();
+    DCHECK(IsSequenceTokenRunnable(i->sequence_token_id));
 
     if (shutdown_called_ && i->shutdown_behavior != BLOCK_SHUTDOWN) {
       // We're shutting down and the task we just found isn't blocking
@@ -944,7 +966,8 @@ SequencedWorkerPool::Inner::GetWorkStatus SequencedWorkerPool::Inner::GetWork(
       // Note that we do not want to delete unrunnable tasks. Deleting a task
       // can have side effects (like freeing some objects) and deleting a
       // task that's supposed to run after one that's currently running could
-      // cause an obscure crash.
+      // cause an obscure crash. Those tasks are still waiting in their
+      // sequence, and are only looked at once they become runnable.
       //
       // We really want to delete these tasks outside the lock in case the
       // closures are holding refs to objects that want to post work from
@@ -954,7 +977,7 @@ SequencedWorkerPool::Inner::GetWorkStatus SequencedWorkerPool::Inner::GetWork(
       // vector they passed to us once the lock is exited to make this
       // happen.
       delete_these_outside_lock->push_back(i->task);
-      pending_tasks_.erase(i++);
+      LockedErasePendingTask(i, true);
       continue;
     }
 
@@ -965,14 +988,14 @@ SequencedWorkerPool::Inner::GetWorkStatus SequencedWorkerPool::Inner::GetWork(
       if (cleanup_state_ == CLEANUP_RUNNING) {
         // Deferred tasks are deleted when cleaning up, see Inner::ThreadLoop.
         delete_these_outside_lock->push_back(i->task);
-        pending_tasks_.erase(i);
+        LockedErasePendingTask(i, true);
       }
       break;
     }
 
     // Found a runnable task.
     *task = *i;
-    pending_tasks_.erase(i);
+    LockedErasePendingTask(i, false);
     if (task->shutdown_behavior == BLOCK_SHUTDOWN) {
       blocking_shutdown_pending_task_count_--;
     }
@@ -981,13 +1004,6 @@ SequencedWorkerPool::Inner::GetWorkStatus SequencedWorkerPool::Inner::GetWork(
     break;
   }
 
-  // Track the number of tasks we had to skip over to see if we should be
-  // making this more efficient. If this number ever becomes large or is
-  // frequently "some", we should consider the optimization above.
-#if !defined(OS_NACL)
-  UMA_HISTOGRAM_COUNTS_100("SequencedWorkerPool.UnrunnableTaskCount",
-                           unrunnable_tasks);
-#endif
   return status;
 }
 
@@ -1030,8 +1046,10 @@ void SequencedWorkerPool::Inner::DidRunWorkerTask(const SequencedTask& task) {
     blocking_shutdown_thread_count_--;
   }
 
-  if (task.sequence_token_id)
+  if (task.sequence_token_id) {
     current_sequences_.erase(task.sequence_token_id);
+    LockedPromoteNextSequencedTask(task.sequence_token_id);
+  }
 }
 
 bool SequencedWorkerPool::Inner::IsSequenceTokenRunnable(
@@ -1042,6 +1060,71 @@ bool SequencedWorkerPool::Inner::IsSequenceTokenRunnable(
           current_sequences_.end();
 }
 
+void SequencedWorkerPool::Inner::LockedAddPendingTask(
+    const SequencedTask& task) {
+  lock_.AssertAcquired();
+  if (!task.sequence_token_id) {
+    pending_tasks_.insert(task);
+    return;
+  }
+
+  SequenceQueue& queue = sequence_queues_[task.sequence_token_id];
+  if (!IsSequenceTokenRunnable(task.sequence_token_id)) {
+    queue.waiting.insert(task);
+    return;
+  }
+
+  if (queue.has_pending_head) {
+    if (!SequencedTaskLessThan()(task, *queue.head)) {
+      queue.waiting.insert(task);
+      return;
+    }
+    // |task| goes before the current head of its sequence (e.g. the head is
+    // a delayed task), so they swap places.
+    queue.waiting.insert(*queue.head);
+    pending_tasks_.erase(queue.head);
+  }
+  queue.head = pending_tasks_.insert(task).first;
+  queue.has_pending_head = true;
+}
+
+void SequencedWorkerPool::Inner::LockedErasePendingTask(
+    PendingTaskSet::iterator task,
+    bool promote_next) {
+  lock_.AssertAcquired();
+  int sequence_token_id = task->sequence_token_id;
+  pending_tasks_.erase(task);
+  if (!sequence_token_id)
+    return;
+
+  SequenceQueueMap::iterator found = sequence_queues_.find(sequence_token_id);
+  DCHECK(found != sequence_queues_.end());
+  DCHECK(found->second.has_pending_head);
+  found->second.has_pending_head = false;
+  if (promote_next)
+    LockedPromoteNextSequencedTask(sequence_token_id);
+  else if (found->second.waiting.empty())
+    sequence_queues_.erase(found);
+}
+
+void SequencedWorkerPool::Inner::LockedPromoteNextSequencedTask(
+    int sequence_token_id) {
+  lock_.AssertAcquired();
+  SequenceQueueMap::iterator found = sequence_queues_.find(sequence_token_id);
+  if (found == sequence_queues_.end())
+    return;
+
+  SequenceQueue& queue = found->second;
+  DCHECK(!queue.has_pending_head);
+  if (queue.waiting.empty()) {
+    sequence_queues_.erase(found);
+    return;
+  }
+  queue.head = pending_tasks_.insert(*queue.waiting.begin()).first;
+  queue.has_pending_head = true;
+  queue.waiting.erase(queue.waiting.begin());
+}
+
 int SequencedWorkerPool::Inner::PrepareToStartAdditionalThreadIfHelpful() {
   lock_.AssertAcquired();
   // How thread creation works:
@@ -1078,14 +1161,12 @@ int SequencedWorkerPool::Inner::PrepareToStartAdditionalThreadIfHelpful() {
       cleanup_state_ == CLEANUP_DONE &&
       threads_.size() < max_threads_ &&
       waiting_thread_count_ == 0) {
-    // We could use an additional thread if there's work to be done.
-    for (PendingTaskSet::const_iterator i = pending_tasks_.begin();
-         i != pending_tasks_.end(); ++i) {
-      if (IsSequenceTokenRunnable(i->sequence_token_id)) {
-        // Found a runnable task, mark the thread as being started.
-        thread_being_created_ = true;
-        return static_cast<int>(threads_.size() + 1);
-      }
+    // We could use an additional thread if there's work to be done. Every
+    // task in |pending_tasks_| is runnable.
+    if (!pending_tasks_.empty()) {
+      // Found a runnable task, mark the thread as being started.
+      thread_being_created_ = true;
+      return static_cast<int>(threads_.size() + 1);
     }
   }
   return 0;
@@ -451,6 +451,42 @@ TEST_F(SequencedWorkerPoolTest, Sequence) {
   EXPECT_EQ(101, result[result.size() - 1]);
 }
 
+// Test that many interleaved sequences each run in order, and that
+// unsequenced tasks posted in between are not held up by them.
+TEST_F(SequencedWorkerPoolTest, InterleavedSequences) {
+  const int kNumSequences = 8;
+  const int kNumTasksPerSequence = 50;
+  std::vector<SequencedWorkerPool::SequenceToken> tokens;
+  for (int i = 0; i < kNumSequences; ++i)
+    tokens.push_back(pool()->GetSequenceToken());
+
+  for (int task = 0; task < kNumTasksPerSequence; ++task) {
+    for (int sequence = 0; sequence < kNumSequences; ++sequence) {
+      pool()->PostSequencedWorkerTask(
+          tokens[sequence], FROM_HERE,
+          base::Bind(&TestTracker::FastTask, tracker(),
+                     sequence * 1000 + task));
+    }
+    pool()->PostWorkerTask(FROM_HERE,
+                           base::Bind(&TestTracker::FastTask, tracker(), -1));
+  }
+
+  const size_t kNumTasks = (kNumSequences + 1) * kNumTasksPerSequence;
+  std::vector<int> result = tracker()->WaitUntilTasksComplete(kNumTasks);
+  ASSERT_EQ(kNumTasks, result.size());
+
+  std::vector<int> next_task(kNumSequences, 0);
+  for (size_t i = 0; i < result.size(); ++i) {
+    if (result[i] < 0)
+      continue;
+    int sequence = result[i] / 1000;
+    EXPECT_EQ(next_task[sequence], result[i] % 1000);
+    next_task[sequence] = result[i] % 1000 + 1;
+  }
+  for (int i = 0; i < kNumSequences; ++i)
+    EXPECT_EQ(kNumTasksPerSequence, next_task[i]);
+}
+
 // Tests that any tasks posted after Shutdown are ignored.
 // Disabled for flakiness.  See http://crbug.com/166451.
 TEST_F(SequencedWorkerPoolTest, DISABLED_IgnoresAfterShutdown) {
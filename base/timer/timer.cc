@@ -11,6 +11,7 @@
 #include "base/single_thread_task_runner.h"
 #include "base/thread_task_runner_handle.h"
 #include "base/threading/platform_thread.h"
+#include "base/time/tick_clock.h"
 
 namespace base {
 
@@ -64,7 +65,8 @@ Timer::Timer(bool retain_user_task, bool is_repeating)
       thread_id_(0),
       is_repeating_(is_repeating),
       retain_user_task_(retain_user_task),
-      is_running_(false) {
+      is_running_(false),
+      tick_clock_(NULL) {
 }
 
 Timer::Timer(const tracked_objects::Location& posted_from,
@@ -78,7 +80,8 @@ Timer::Timer(const tracked_objects::Location& posted_from,
       thread_id_(0),
       is_repeating_(is_repeating),
       retain_user_task_(true),
-      is_running_(false) {
+      is_running_(false),
+      tick_clock_(NULL) {
 }
 
 Timer::~Timer() {
@@ -108,11 +111,13 @@ void Timer::Reset() {
   }
 
   // Set the new desired_run_time_.
-  desired_run_time_ = TimeTicks::Now() + delay_;
+  desired_run_time_ = Now() + delay_;
 
-  // We can use the existing scheduled task if it arrives before the new
-  // desired_run_time_.
-  if (desired_run_time_ > scheduled_run_time_) {
+  // We can use the existing scheduled task if it arrives no later than the new
+  // desired_run_time_. With a coarse clock repeated resets often land on the
+  // same tick, and abandoning the task for those would leave a dead delayed
+  // task in the queue per reset.
+  if (desired_run_time_ >= scheduled_run_time_) {
     is_running_ = true;
     return;
   }
@@ -137,7 +142,7 @@ void Timer::PostNewScheduledTask(TimeDelta delay) {
   ThreadTaskRunnerHandle::Get()->PostDelayedTask(posted_from_,
       base::Bind(&BaseTimerTaskInternal::Run, base::Owned(scheduled_task_)),
       delay);
-  scheduled_run_time_ = desired_run_time_ = TimeTicks::Now() + delay;
+  scheduled_run_time_ = desired_run_time_ = Now() + delay;
   // Remember the thread ID that posts the first task -- this will be verified
   // later when the task is abandoned to detect misuse from multiple threads.
   if (!thread_id_)
@@ -153,6 +158,10 @@ void Timer::AbandonScheduledTask() {
   }
 }
 
+TimeTicks Timer::Now() const {
+  return tick_clock_ ? tick_clock_->NowTicks() : TimeTicks::Now();
+}
+
 void Timer::RunScheduledTask() {
   // Task may have been disabled.
   if (!is_running_)
@@ -162,7 +171,7 @@ void Timer::RunScheduledTask() {
   if (desired_run_time_ > scheduled_run_time_) {
     // TimeTicks::Now() can be expensive, so only call it if we know the user
     // has changed the desired_run_time_.
-    TimeTicks now = TimeTicks::Now();
+    TimeTicks now = Now();
     // Task runner may have called us late anyway, so only post a continuation
     // task if the desired_run_time_ is in the future.
     if (desired_run_time_ > now) {
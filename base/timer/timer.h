@@ -60,6 +60,7 @@
 namespace base {
 
 class BaseTimerTaskInternal;
+class TickClock;
 
 //-----------------------------------------------------------------------------
 // This class wraps MessageLoop::PostDelayedTask to manage delayed and repeating
@@ -108,6 +109,12 @@ class BASE_EXPORT Timer {
   const base::Closure& user_task() const { return user_task_; }
   const TimeTicks& desired_run_time() const { return desired_run_time_; }
 
+  // Makes the timer read the time from |tick_clock| instead of
+  // TimeTicks::Now(). |tick_clock| must outlive the timer.
+  void SetTickClockForTesting(TickClock* tick_clock) {
+    tick_clock_ = tick_clock;
+  }
+
  protected:
   // Used to initiate a new delayed task.  This has the side-effect of disabling
   // scheduled_task_ if it is non-null.
@@ -136,6 +143,9 @@ class BASE_EXPORT Timer {
     AbandonScheduledTask();
   }
 
+  // Returns the current time, from |tick_clock_| if there is one.
+  TimeTicks Now() const;
+
   // When non-NULL, the scheduled_task_ is waiting in the MessageLoop to call
   // RunScheduledTask() at scheduled_run_time_.
   BaseTimerTaskInternal* scheduled_task_;
@@ -172,6 +182,9 @@ class BASE_EXPORT Timer {
   // If true, user_task_ is scheduled to run sometime in the future.
   bool is_running_;
 
+  // If non-NULL, used instead of TimeTicks::Now(). Not owned.
+  TickClock* tick_clock_;
+
   DISALLOW_COPY_AND_ASSIGN(Timer);
 };
 
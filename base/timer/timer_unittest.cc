@@ -4,6 +4,9 @@
 
 #include "base/memory/scoped_ptr.h"
 #include "base/message_loop/message_loop.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "base/test/test_simple_task_runner.h"
+#include "base/thread_task_runner_handle.h"
 #include "base/timer/timer.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -486,4 +489,32 @@ TEST(TimerTest, ContinuationReset) {
   }
 }
 
+TEST(TimerTest, ResetReusesScheduledTask) {
+  scoped_refptr<base::TestSimpleTaskRunner> task_runner(
+      new base::TestSimpleTaskRunner());
+  base::ThreadTaskRunnerHandle handle(task_runner);
+  base::SimpleTestTickClock tick_clock;
+  tick_clock.Advance(TimeDelta::FromSeconds(1));
+  base::Timer timer(true, false);
+  timer.SetTickClockForTesting(&tick_clock);
+  timer.Start(FROM_HERE, TimeDelta::FromHours(1),
+              base::Bind(&SetCallbackHappened1));
+  const base::TimeTicks scheduled_run_time = timer.desired_run_time();
+
+  // The clock hasn't moved, so each reset asks for exactly the scheduled run
+  // time. The scheduled task can be reused for all of them.
+  for (int i = 0; i < 10; ++i) {
+    timer.Reset();
+    EXPECT_EQ(scheduled_run_time, timer.desired_run_time());
+  }
+  EXPECT_EQ(1u, task_runner->GetPendingTasks().size());
+
+  // A reset to a later time reuses it as well.
+  tick_clock.Advance(TimeDelta::FromMilliseconds(1));
+  timer.Reset();
+  EXPECT_LT(scheduled_run_time, timer.desired_run_time());
+  EXPECT_EQ(1u, task_runner->GetPendingTasks().size());
+  timer.Stop();
+}
+
 }  // namespace
@@ -7,6 +7,8 @@
 #include <limits.h>
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include "base/compiler_specific.h"
 #include "base/debug/leak_annotations.h"
 #include "base/logging.h"
@@ -236,11 +238,15 @@ base::LazyInstance<base::Lock>::Leaky
 // static
 ThreadData::Status ThreadData::status_ = ThreadData::UNINITIALIZED;
 
+// static
+int ThreadData::sampling_interval_ = 1;
+
 ThreadData::ThreadData(const std::string& suggested_name)
     : next_(NULL),
       next_retired_worker_(NULL),
       worker_thread_number_(0),
-      incarnation_count_for_pool_(-1) {
+      incarnation_count_for_pool_(-1),
+      births_until_next_tally_(0) {
   DCHECK_GE(suggested_name.size(), 0u);
   thread_name_ = suggested_name;
   PushToHeadOfList();  // Which sets real incarnation_count_for_pool_.
@@ -250,7 +256,8 @@ ThreadData::ThreadData(int thread_number)
     : next_(NULL),
       next_retired_worker_(NULL),
       worker_thread_number_(thread_number),
-      incarnation_count_for_pool_(-1)  {
+      incarnation_count_for_pool_(-1),
+      births_until_next_tally_(0) {
   CHECK_GT(thread_number, 0);
   base::StringAppendF(&thread_name_, "WorkerThread-%d", thread_number);
   PushToHeadOfList();  // Which sets real incarnation_count_for_pool_.
@@ -372,6 +379,19 @@ void ThreadData::Snapshot(bool reset_max, ProcessDataSnapshot* process_data) {
           TaskSnapshot(*it->first, DeathData(it->second), "Still_Alive"));
     }
   }
+
+  // Scale sampled tallies up to estimates of the true totals. Maxima and
+  // samples of individual runs need no adjustment.
+  int interval = sampling_interval_;
+  process_data->sampling_interval = interval;
+  if (interval <= 1)
+    return;
+  for (std::vector<TaskSnapshot>::iterator it = process_data->tasks.begin();
+       it != process_data->tasks.end(); ++it) {
+    it->death_data.count *= interval;
+    it->death_data.run_duration_sum *= interval;
+    it->death_data.queue_duration_sum *= interval;
+  }
 }
 
 Births* ThreadData::TallyABirth(const Location& location) {
@@ -446,9 +466,22 @@ Births* ThreadData::TallyABirthIfActive(const Location& location) {
   ThreadData* current_thread_data = Get();
   if (!current_thread_data)
     return NULL;
+  if (!current_thread_data->ShouldTallyNextBirth())
+    return NULL;
   return current_thread_data->TallyABirth(location);
 }
 
+bool ThreadData::ShouldTallyNextBirth() {
+  if (sampling_interval_ <= 1)
+    return true;
+  if (births_until_next_tally_ > 0) {
+    --births_until_next_tally_;
+    return false;
+  }
+  births_until_next_tally_ = sampling_interval_ - 1;
+  return true;
+}
+
 // static
 void ThreadData::TallyRunOnNamedThreadIfTracking(
     const base::TrackingInfo& completed_task,
@@ -718,6 +751,17 @@ ThreadData::Status ThreadData::status() {
   return status_;
 }
 
+// static
+void ThreadData::SetSamplingInterval(int interval) {
+  DCHECK_GE(interval, 1);
+  sampling_interval_ = std::max(interval, 1);
+}
+
+// static
+int ThreadData::sampling_interval() {
+  return sampling_interval_;
+}
+
 // static
 bool ThreadData::TrackingStatus() {
   return status_ > DEACTIVATED;
@@ -798,6 +842,7 @@ void ThreadData::ShutdownSingleThreadedCleanup(bool leak) {
   cleanup_count_ = 0;
   tls_index_.Set(NULL);
   status_ = DORMANT_DURING_TESTS;  // Almost UNINITIALIZED.
+  sampling_interval_ = 1;
 
   // To avoid any chance of racing in unit tests, which is the only place we
   // call this function, we may sometimes leak all the data structures we
@@ -860,10 +905,11 @@ ParentChildPairSnapshot::~ParentChildPairSnapshot() {
 
 ProcessDataSnapshot::ProcessDataSnapshot()
 #if !defined(OS_NACL)
-    : process_id(base::GetCurrentProcId()) {
+    : process_id(base::GetCurrentProcId()),
 #else
-    : process_id(0) {
+    : process_id(0),
 #endif
+      sampling_interval(1) {
 }
 
 ProcessDataSnapshot::~ProcessDataSnapshot() {
@@ -459,6 +459,15 @@ class BASE_EXPORT ThreadData {
   // on.  This is currently a compiled option, atop TrackingStatus().
   static bool TrackingParentChildStatus();
 
+  // Makes each thread tally only one in every |interval| births, along with
+  // the matching deaths, so that profiling is cheap enough to leave on. The
+  // counts and duration sums in snapshots are scaled back up by |interval|,
+  // making them estimates of the true totals. The default of 1 tallies every
+  // birth. This should be set before tracking is activated, since tallies made
+  // under an earlier interval are scaled by the current one.
+  static void SetSamplingInterval(int interval);
+  static int sampling_interval();
+
   // Special versions of Now() for getting times at start and end of a tracked
   // run.  They are super fast when tracking is disabled, and have some internal
   // side effects when we are tracking, so that we can deduce the amount of time
@@ -521,6 +530,10 @@ class BASE_EXPORT ThreadData {
   // In this thread's data, record a new birth.
   Births* TallyABirth(const Location& location);
 
+  // Returns true if the next birth on this thread should be tallied under the
+  // current sampling_interval().
+  bool ShouldTallyNextBirth();
+
   // Find a place to record a death on this thread.
   void TallyADeath(const Births& birth, int32 queue_duration, int32 duration);
 
@@ -618,6 +631,9 @@ class BASE_EXPORT ThreadData {
   // We set status_ to SHUTDOWN when we shut down the tracking service.
   static Status status_;
 
+  // One in every |sampling_interval_| births is tallied on each thread.
+  static int sampling_interval_;
+
   // Link to next instance (null terminated list). Used to globally track all
   // registered instances (corresponds to all registered threads where we keep
   // data).
@@ -685,6 +701,11 @@ class BASE_EXPORT ThreadData {
   // incarnations).
   int incarnation_count_for_pool_;
 
+  // The number of births on this thread still to go before the next one is
+  // tallied. Only used when sampling_interval_ is above 1, and only accessed
+  // on this thread, so counting needs no lock.
+  int births_until_next_tally_;
+
   DISALLOW_COPY_AND_ASSIGN(ThreadData);
 };
 
@@ -714,6 +735,10 @@ struct BASE_EXPORT ProcessDataSnapshot {
   std::vector<TaskSnapshot> tasks;
   std::vector<ParentChildPairSnapshot> descendants;
   int process_id;
+
+  // The ThreadData::sampling_interval() that the counts and sums in |tasks|
+  // were scaled by. A value above 1 means that they are estimates.
+  int sampling_interval;
 };
 
 }  // namespace tracked_objects
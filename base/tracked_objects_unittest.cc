@@ -519,6 +519,44 @@ TEST_F(TrackedObjectsTest, TwoLives) {
                           kMainThreadName, 2, 2, 4);
 }
 
+TEST_F(TrackedObjectsTest, SampledLives) {
+  if (!ThreadData::InitializeAndSetTrackingStatus(
+          ThreadData::PROFILING_CHILDREN_ACTIVE))
+    return;
+  ThreadData::SetSamplingInterval(3);
+
+  ThreadData::InitializeThreadContext(kMainThreadName);
+  const char kFunction[] = "SampledLives";
+  Location location(kFunction, kFile, kLineNumber, NULL);
+
+  const base::TimeTicks kTimePosted = base::TimeTicks() +
+      base::TimeDelta::FromMilliseconds(1);
+  const base::TimeTicks kDelayedStartTime = base::TimeTicks();
+  const TrackedTime kStartOfRun = TrackedTime() +
+      Duration::FromMilliseconds(5);
+  const TrackedTime kEndOfRun = TrackedTime() + Duration::FromMilliseconds(7);
+
+  // Only the first and fourth of these six tasks are tallied.
+  int tallied_births = 0;
+  for (int i = 0; i < 6; ++i) {
+    // TrackingInfo will call TallyABirth() during construction.
+    base::TrackingInfo pending_task(location, kDelayedStartTime);
+    pending_task.time_posted = kTimePosted;  // Overwrite implied Now().
+    if (pending_task.birth_tally)
+      ++tallied_births;
+    ThreadData::TallyRunOnNamedThreadIfTracking(pending_task,
+        kStartOfRun, kEndOfRun);
+  }
+  EXPECT_EQ(2, tallied_births);
+
+  // The snapshot estimates all six runs.
+  ProcessDataSnapshot process_data;
+  ThreadData::Snapshot(false, &process_data);
+  EXPECT_EQ(3, process_data.sampling_interval);
+  ExpectSimpleProcessData(process_data, kFunction, kMainThreadName,
+                          kMainThreadName, 6, 2, 4);
+}
+
 TEST_F(TrackedObjectsTest, DifferentLives) {
   if (!ThreadData::InitializeAndSetTrackingStatus(
           ThreadData::PROFILING_CHILDREN_ACTIVE))
@@ -395,6 +395,7 @@
           'target_name': 'chromium_builder_perf',
           'type': 'none',
           'dependencies': [
+            '../base/base.gyp:base_perftests',
             '../cc/cc_tests.gyp:cc_perftests',
             '../chrome/chrome.gyp:chrome',
             '../chrome/chrome.gyp:performance_browser_tests',
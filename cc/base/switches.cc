@@ -138,6 +138,12 @@ const char kEnableMapImage[] = "enable-map-image";
 // Overrides the kEnableMapImage flag.
 const char kDisableMapImage[] = "disable-map-image";
 
+// Rasterize tiles with Ganesh directly into their textures.
+const char kEnableGPURasterization[] = "enable-gpu-rasterization";
+
+// Disable GPU rasterization. Overrides the kEnableGPURasterization flag.
+const char kDisableGPURasterization[] = "disable-gpu-rasterization";
+
 // Prevents the layer tree unit tests from timing out.
 const char kCCLayerTreeTestNoTimeout[] = "cc-layer-tree-test-no-timeout";
 
@@ -198,5 +204,16 @@ bool IsMapImageEnabled() {
   return false;
 }
 
+bool IsGPURasterizationEnabled() {
+  const CommandLine& command_line = *CommandLine::ForCurrentProcess();
+
+  if (command_line.HasSwitch(cc::switches::kDisableGPURasterization))
+    return false;
+  else if (command_line.HasSwitch(cc::switches::kEnableGPURasterization))
+    return true;
+
+  return false;
+}
+
 }  // namespace switches
 }  // namespace cc
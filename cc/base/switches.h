@@ -41,6 +41,8 @@ CC_EXPORT extern const char kEnablePartialSwap[];
 CC_EXPORT extern const char kStrictLayerPropertyChangeChecking[];
 CC_EXPORT extern const char kEnableMapImage[];
 CC_EXPORT extern const char kDisableMapImage[];
+CC_EXPORT extern const char kEnableGPURasterization[];
+CC_EXPORT extern const char kDisableGPURasterization[];
 CC_EXPORT extern const char kDisable4444Textures[];
 CC_EXPORT extern const char kDisableCompositorTouchHitTesting[];
 
@@ -74,6 +76,7 @@ CC_EXPORT extern const char kCCRebaselinePixeltests[];
 CC_EXPORT bool IsLCDTextEnabled();
 CC_EXPORT bool IsImplSidePaintingEnabled();
 CC_EXPORT bool IsMapImageEnabled();
+CC_EXPORT bool IsGPURasterizationEnabled();
 
 }  // namespace switches
 }  // namespace cc
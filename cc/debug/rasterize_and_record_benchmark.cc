@@ -0,0 +1,115 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/debug/rasterize_and_record_benchmark.h"
+
+#include "base/basictypes.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "cc/base/region.h"
+#include "cc/layers/layer.h"
+#include "cc/layers/picture_layer.h"
+#include "cc/resources/picture.h"
+#include "cc/trees/layer_tree_host.h"
+#include "cc/trees/layer_tree_host_common.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "ui/gfx/rect.h"
+#include "ui/gfx/rect_conversions.h"
+
+namespace cc {
+
+namespace {
+
+const int kTileGridSize = 512;
+const int kTileGridBorder = 1;
+
+}  // namespace
+
+RasterizeAndRecordBenchmark::RasterizeAndRecordBenchmark(
+    scoped_ptr<base::Value> value,
+    const MicroBenchmark::DoneCallback& callback)
+    : MicroBenchmark(callback),
+      results_(new base::ListValue()) {
+  base::DictionaryValue* settings = NULL;
+  base::ListValue* scales = NULL;
+  if (value && value->GetAsDictionary(&settings))
+    settings->GetList("scales", &scales);
+
+  if (scales) {
+    for (size_t i = 0; i < scales->GetSize(); ++i) {
+      double scale;
+      if (scales->GetDouble(i, &scale) && scale > 0)
+        scales_.push_back(static_cast<float>(scale));
+    }
+  }
+  if (scales_.empty())
+    scales_.push_back(1.f);
+}
+
+RasterizeAndRecordBenchmark::~RasterizeAndRecordBenchmark() {}
+
+void RasterizeAndRecordBenchmark::DidUpdateLayers(LayerTreeHost* host) {
+  LayerTreeHostCommon::CallFunctionForSubtree(
+      host->root_layer(),
+      base::Bind(&RasterizeAndRecordBenchmark::Run, base::Unretained(this)));
+
+  NotifyDone(results_.PassAs<base::Value>());
+}
+
+void RasterizeAndRecordBenchmark::Run(Layer* layer) {
+  layer->RunMicroBenchmark(this);
+}
+
+void RasterizeAndRecordBenchmark::RunOnLayer(PictureLayer* layer) {
+  gfx::Rect visible_content_rect = layer->visible_content_rect();
+  if (visible_content_rect.IsEmpty())
+    return;
+
+  SkTileGridPicture::TileGridInfo tile_grid_info;
+  tile_grid_info.fTileInterval.set(kTileGridSize - 2 * kTileGridBorder,
+                                   kTileGridSize - 2 * kTileGridBorder);
+  tile_grid_info.fMargin.set(kTileGridBorder, kTileGridBorder);
+  tile_grid_info.fOffset.set(-kTileGridBorder, -kTileGridBorder);
+
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  scoped_refptr<Picture> picture = Picture::Create(visible_content_rect);
+  picture->Record(layer->client(), tile_grid_info);
+  base::TimeDelta record_time = base::TimeTicks::HighResNow() - start;
+
+  scoped_ptr<base::ListValue> raster_results(new base::ListValue());
+  for (size_t i = 0; i < scales_.size(); ++i) {
+    gfx::Rect raster_rect = gfx::ToEnclosingRect(
+        gfx::ScaleRect(visible_content_rect, scales_[i]));
+
+    SkBitmap bitmap;
+    bitmap.setConfig(SkBitmap::kARGB_8888_Config,
+                     raster_rect.width(),
+                     raster_rect.height());
+    if (!bitmap.allocPixels())
+      continue;
+    SkCanvas canvas(bitmap);
+    canvas.translate(-raster_rect.x(), -raster_rect.y());
+
+    start = base::TimeTicks::HighResNow();
+    picture->Raster(&canvas, NULL, Region(), scales_[i]);
+    base::TimeDelta raster_time = base::TimeTicks::HighResNow() - start;
+
+    scoped_ptr<base::DictionaryValue> raster_result(
+        new base::DictionaryValue());
+    raster_result->SetDouble("scale", scales_[i]);
+    raster_result->SetDouble("time_ms", raster_time.InMillisecondsF());
+    raster_results->Append(raster_result.release());
+  }
+
+  scoped_ptr<base::DictionaryValue> result(new base::DictionaryValue());
+  result->SetInteger("layer_id", layer->id());
+  result->SetInteger("width", visible_content_rect.width());
+  result->SetInteger("height", visible_content_rect.height());
+  result->SetDouble("record_time_ms", record_time.InMillisecondsF());
+  result->Set("raster", raster_results.release());
+  results_->Append(result.release());
+}
+
+}  // namespace cc
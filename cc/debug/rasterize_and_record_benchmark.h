@@ -0,0 +1,44 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_DEBUG_RASTERIZE_AND_RECORD_BENCHMARK_H_
+#define CC_DEBUG_RASTERIZE_AND_RECORD_BENCHMARK_H_
+
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "cc/debug/micro_benchmark_controller.h"
+
+namespace base {
+class ListValue;
+}
+
+namespace cc {
+
+class LayerTreeHost;
+class Layer;
+
+// Records the visible content of each picture layer and then rasterizes the
+// recording at each of the requested scales, reporting the times per layer.
+class RasterizeAndRecordBenchmark : public MicroBenchmark {
+ public:
+  explicit RasterizeAndRecordBenchmark(
+      scoped_ptr<base::Value> value,
+      const MicroBenchmark::DoneCallback& callback);
+  virtual ~RasterizeAndRecordBenchmark();
+
+  // Implements MicroBenchmark interface.
+  virtual void DidUpdateLayers(LayerTreeHost* host) OVERRIDE;
+  virtual void RunOnLayer(PictureLayer* layer) OVERRIDE;
+
+ private:
+  void Run(Layer* layer);
+
+  std::vector<float> scales_;
+  scoped_ptr<base::ListValue> results_;
+};
+
+}  // namespace cc
+
+#endif  // CC_DEBUG_RASTERIZE_AND_RECORD_BENCHMARK_H_
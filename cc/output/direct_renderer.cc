@@ -14,6 +14,7 @@
 #include "cc/base/math_util.h"
 #include "cc/output/copy_output_request.h"
 #include "cc/quads/draw_quad.h"
+#include "cc/quads/texture_draw_quad.h"
 #include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/transform.h"
 
@@ -215,6 +216,22 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
   frame.disable_picture_quad_image_filtering =
       disable_picture_quad_image_filtering;
 
+  if (Capabilities().using_overlays) {
+    ProcessOverlays(&frame, render_passes_in_draw_order->back());
+
+    // Damage under an overlay isn't drawn to the main plane, so once the
+    // overlay moves or goes away, the area it covered has to be redrawn.
+    gfx::RectF overlay_rect;
+    if (!frame.overlay_list.empty())
+      overlay_rect = frame.overlay_list.front().display_rect;
+    if (overlay_rect != last_overlay_rect_) {
+      frame.root_damage_rect.Union(last_overlay_rect_);
+      frame.root_damage_rect.Intersect(
+          gfx::Rect(client_->DeviceViewport().size()));
+    }
+    last_overlay_rect_ = overlay_rect;
+  }
+
   EnsureBackbuffer();
 
   // Only reshape when we know we are going to draw. Otherwise, the reshape
@@ -245,6 +262,69 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
   render_passes_in_draw_order->clear();
 }
 
+// Returns true if |quad| could be shown on an overlay plane as it is, without
+// any compositing: an opaque, axis-aligned, unclipped texture.
+static bool GetOverlayCandidate(const DrawQuad* quad,
+                                OverlayCandidate* candidate) {
+  if (quad->material != DrawQuad::TEXTURE_CONTENT)
+    return false;
+  const TextureDrawQuad* texture_quad = TextureDrawQuad::MaterialCast(quad);
+  if (!texture_quad->premultiplied_alpha || texture_quad->flipped ||
+      texture_quad->background_color != SK_ColorTRANSPARENT)
+    return false;
+  if (quad->ShouldDrawWithBlending() || quad->isClipped() ||
+      quad->visible_rect != quad->rect)
+    return false;
+  for (int i = 0; i < 4; ++i) {
+    if (texture_quad->vertex_opacity[i] != 1.f)
+      return false;
+  }
+  if (!quad->quadTransform().IsPositiveScaleOrTranslation())
+    return false;
+
+  candidate->display_rect =
+      MathUtil::MapClippedRect(quad->quadTransform(), gfx::RectF(quad->rect));
+  candidate->uv_rect = gfx::BoundingRect(texture_quad->uv_top_left,
+                                         texture_quad->uv_bottom_right);
+  candidate->resource_id = texture_quad->resource_id;
+  candidate->plane_z_order = 1;
+  return true;
+}
+
+void DirectRenderer::ProcessOverlays(DrawingFrame* frame,
+                                     RenderPass* root_render_pass) {
+  // Only the front-most candidate is tried, as a single plane above the main
+  // one. It must not be covered by anything in front of it.
+  QuadList& quad_list = root_render_pass->quad_list;
+  for (QuadList::iterator it = quad_list.begin(); it != quad_list.end();
+       ++it) {
+    OverlayCandidate candidate;
+    if (!GetOverlayCandidate(*it, &candidate))
+      continue;
+
+    for (QuadList::iterator above = quad_list.begin(); above != it; ++above) {
+      gfx::RectF above_rect = MathUtil::MapClippedRect(
+          (*above)->quadTransform(), gfx::RectF((*above)->visible_rect));
+      if (above_rect.Intersects(candidate.display_rect))
+        return;
+    }
+
+    OverlayCandidateList candidates;
+    candidates.push_back(candidate);
+    output_surface_->CheckOverlaySupport(&candidates);
+    if (!candidates.front().overlay_handled)
+      return;
+
+    // The plane covers the main plane, so damage under it doesn't need to be
+    // redrawn.
+    if (candidate.display_rect.Contains(frame->root_damage_rect))
+      frame->root_damage_rect = gfx::RectF();
+    frame->overlay_list.push_back(candidates.front());
+    quad_list.erase(it);
+    return;
+  }
+}
+
 gfx::RectF DirectRenderer::ComputeScissorRectForRenderPass(
     const DrawingFrame* frame) {
   gfx::RectF render_pass_scissor = frame->current_render_pass->output_rect;
@@ -9,6 +9,7 @@
 #include "base/callback.h"
 #include "base/containers/scoped_ptr_hash_map.h"
 #include "cc/base/cc_export.h"
+#include "cc/output/overlay_candidate.h"
 #include "cc/output/renderer.h"
 #include "cc/resources/resource_provider.h"
 #include "cc/resources/scoped_resource.h"
@@ -53,6 +54,10 @@ class CC_EXPORT DirectRenderer : public Renderer {
     ContextProvider* offscreen_context_provider;
 
     bool disable_picture_quad_image_filtering;
+
+    // Quads of the root render pass that are presented on overlay planes
+    // instead of being drawn.
+    OverlayCandidateList overlay_list;
   };
 
   void SetEnlargePassTextureAmountForTesting(gfx::Vector2d amount);
@@ -92,6 +97,10 @@ class CC_EXPORT DirectRenderer : public Renderer {
                       bool allow_partial_swap);
   bool UseRenderPass(DrawingFrame* frame, const RenderPass* render_pass);
 
+  // Moves quads of |root_render_pass| that the output surface can present
+  // on overlay planes into |frame|'s overlay list.
+  void ProcessOverlays(DrawingFrame* frame, RenderPass* root_render_pass);
+
   virtual void BindFramebufferToOutputSurface(DrawingFrame* frame) = 0;
   virtual bool BindFramebufferToTexture(DrawingFrame* frame,
                                         const ScopedResource* resource,
@@ -132,6 +141,9 @@ class CC_EXPORT DirectRenderer : public Renderer {
  private:
   gfx::Vector2d enlarge_pass_texture_amount_;
 
+  // The rect covered by the overlay plane in the last frame, if any.
+  gfx::RectF last_overlay_rect_;
+
   DISALLOW_COPY_AND_ASSIGN(DirectRenderer);
 };
 
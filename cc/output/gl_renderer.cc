@@ -190,6 +190,9 @@ bool GLRenderer::Initialize() {
 
   capabilities_.using_set_visibility = context_caps.set_visibility;
 
+  capabilities_.using_overlays =
+      output_surface_->capabilities().supports_overlays;
+
   DCHECK(!context_caps.iosurface || context_caps.texture_rectangle);
 
   capabilities_.using_egl_image = context_caps.egl_image_external;
@@ -356,7 +359,10 @@ void GLRenderer::DoNoOp() {
 
 void GLRenderer::DoDrawQuad(DrawingFrame* frame, const DrawQuad* quad) {
   DCHECK(quad->rect.Contains(quad->visible_rect));
-  if (quad->material != DrawQuad::TEXTURE_CONTENT) {
+  // Texture quads and tiles are batched; tiles are flushed by
+  // DrawContentQuad() if they can't join the batch.
+  if (quad->material != DrawQuad::TEXTURE_CONTENT &&
+      quad->material != DrawQuad::TILED_CONTENT) {
     FlushTextureQuadCache();
   }
 
@@ -1353,6 +1359,35 @@ void GLRenderer::DrawContentQuad(const DrawingFrame* frame,
   bool use_aa = settings_->allow_antialiasing && SetupQuadForAntialiasing(
       device_transform, quad, &local_quad, edge);
 
+  bool scaled = (tex_to_geom_scale_x != 1.f || tex_to_geom_scale_y != 1.f);
+  GLenum filter = (use_aa || scaled ||
+                   !quad->quadTransform().IsIdentityOrIntegerTranslation())
+                  ? GL_LINEAR
+                  : GL_NEAREST;
+
+  // Tiles without antialiasing are drawn in batches, each tile sampled from
+  // its own texture unit. Picture quads all share the on-demand raster
+  // resource, so they can't be batched.
+  if (!use_aa && quad->material == DrawQuad::TILED_CONTENT) {
+    // As below, move the fragment shader transform to the vertex shader.
+    // The batched vertex shader's texture coordinates span the whole of
+    // |tile_rect|, so its origin is folded into the translation as well.
+    float tex_scale_x = vertex_tex_scale_x * fragment_tex_scale_x;
+    float tex_scale_y = vertex_tex_scale_y * fragment_tex_scale_y;
+    Float4 tex_transform = { {
+      vertex_tex_translate_x * fragment_tex_scale_x + fragment_tex_translate_x +
+          tex_scale_x * tile_rect.x() / tile_rect.width(),
+      vertex_tex_translate_y * fragment_tex_scale_y + fragment_tex_translate_y +
+          tex_scale_y * tile_rect.y() / tile_rect.height(),
+      tex_scale_x,
+      tex_scale_y,
+    } };
+    EnqueueTileQuad(frame, quad, resource_id, filter, tex_coord_precision,
+                    tile_rect, tex_transform);
+    return;
+  }
+  FlushTextureQuadCache();
+
   TileProgramUniforms uniforms;
   if (use_aa) {
     if (quad->swizzle_contents) {
@@ -1382,11 +1417,6 @@ void GLRenderer::DrawContentQuad(const DrawingFrame* frame,
 
   SetUseProgram(uniforms.program);
   GLC(Context(), Context()->uniform1i(uniforms.sampler_location, 0));
-  bool scaled = (tex_to_geom_scale_x != 1.f || tex_to_geom_scale_y != 1.f);
-  GLenum filter = (use_aa || scaled ||
-                   !quad->quadTransform().IsIdentityOrIntegerTranslation())
-                  ? GL_LINEAR
-                  : GL_NEAREST;
   ResourceProvider::ScopedSamplerGL quad_resource_lock(
       resource_provider_, resource_id, GL_TEXTURE_2D, filter);
 
@@ -1731,6 +1761,24 @@ struct TexTransformTextureProgramBinding : TextureProgramBinding {
   int vertex_opacity_location;
 };
 
+struct TileBatchProgramBinding {
+  template <class Program>
+  void Set(Program* program, WebKit::WebGraphicsContext3D* context) {
+    DCHECK(program && (program->initialized() || context->isContextLost()));
+    program_id = program->program();
+    samplers_location = program->fragment_shader().samplers_location();
+    matrix_location = program->vertex_shader().matrix_location();
+    tex_transform_location = program->vertex_shader().tex_transform_location();
+    vertex_opacity_location =
+        program->vertex_shader().vertex_opacity_location();
+  }
+  int program_id;
+  int samplers_location;
+  int matrix_location;
+  int tex_transform_location;
+  int vertex_opacity_location;
+};
+
 void GLRenderer::FlushTextureQuadCache() {
   // Check to see if we have anything to draw.
   if (draw_cache_.program_id == 0)
@@ -1742,15 +1790,37 @@ void GLRenderer::FlushTextureQuadCache() {
   // Bind the program to the GL state.
   SetUseProgram(draw_cache_.program_id);
 
-  // Bind the correct texture sampler location.
-  GLC(Context(), Context()->uniform1i(draw_cache_.sampler_location, 0));
+  // Batched tiles are bound to one texture unit each; texture quads share
+  // the resource bound to unit 0.
+  scoped_ptr<ResourceProvider::ScopedReadLockGL> locked_quad;
+  ScopedPtrVector<ResourceProvider::ScopedSamplerGL> locked_tiles;
+  if (!draw_cache_.tile_resource_ids.empty()) {
+    DCHECK_EQ(draw_cache_.tile_resource_ids.size(),
+              draw_cache_.matrix_data.size());
+    int samplers[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    for (size_t i = 0; i < draw_cache_.tile_resource_ids.size(); ++i) {
+      locked_tiles.push_back(make_scoped_ptr(
+          new ResourceProvider::ScopedSamplerGL(
+              resource_provider_,
+              draw_cache_.tile_resource_ids[i],
+              GL_TEXTURE_2D,
+              GL_TEXTURE0 + i,
+              draw_cache_.tile_filters[i])));
+    }
+    GLC(Context(),
+        Context()->uniform1iv(
+            draw_cache_.samplers_location, arraysize(samplers), samplers));
+  } else {
+    // Bind the correct texture sampler location.
+    GLC(Context(), Context()->uniform1i(draw_cache_.sampler_location, 0));
 
-  // Assume the current active textures is 0.
-  ResourceProvider::ScopedReadLockGL locked_quad(resource_provider_,
-                                                 draw_cache_.resource_id);
-  DCHECK_EQ(GL_TEXTURE0, ResourceProvider::GetActiveTextureUnit(Context()));
-  GLC(Context(),
-      Context()->bindTexture(GL_TEXTURE_2D, locked_quad.texture_id()));
+    // Assume the current active textures is 0.
+    locked_quad.reset(new ResourceProvider::ScopedReadLockGL(
+        resource_provider_, draw_cache_.resource_id));
+    DCHECK_EQ(GL_TEXTURE0, ResourceProvider::GetActiveTextureUnit(Context()));
+    GLC(Context(),
+        Context()->bindTexture(GL_TEXTURE_2D, locked_quad->texture_id()));
+  }
 
   COMPILE_ASSERT(
       sizeof(Float4) == 4 * sizeof(float),  // NOLINT(runtime/sizeof)
@@ -1797,6 +1867,8 @@ void GLRenderer::FlushTextureQuadCache() {
   draw_cache_.uv_xform_data.resize(0);
   draw_cache_.vertex_opacity_data.resize(0);
   draw_cache_.matrix_data.resize(0);
+  draw_cache_.tile_resource_ids.resize(0);
+  draw_cache_.tile_filters.resize(0);
 }
 
 void GLRenderer::EnqueueTextureQuad(const DrawingFrame* frame,
@@ -1864,6 +1936,71 @@ void GLRenderer::EnqueueTextureQuad(const DrawingFrame* frame,
   draw_cache_.matrix_data.push_back(m);
 }
 
+void GLRenderer::EnqueueTileQuad(const DrawingFrame* frame,
+                                 const ContentDrawQuadBase* quad,
+                                 ResourceProvider::ResourceId resource_id,
+                                 unsigned filter,
+                                 TexCoordPrecision tex_coord_precision,
+                                 gfx::Rect tile_rect,
+                                 const Float4& tex_transform) {
+  TileBatchProgramBinding binding;
+  if (quad->ShouldDrawWithBlending()) {
+    if (quad->swizzle_contents) {
+      binding.Set(GetTileBatchProgramSwizzle(tex_coord_precision), Context());
+    } else {
+      binding.Set(GetTileBatchProgram(tex_coord_precision), Context());
+    }
+  } else {
+    if (quad->swizzle_contents) {
+      binding.Set(GetTileBatchProgramSwizzleOpaque(tex_coord_precision),
+                  Context());
+    } else {
+      binding.Set(GetTileBatchProgramOpaque(tex_coord_precision), Context());
+    }
+  }
+
+  // A resource is bound with a single filter, so a tile that is already in
+  // the batch starts a new one.
+  bool resource_in_batch =
+      std::find(draw_cache_.tile_resource_ids.begin(),
+                draw_cache_.tile_resource_ids.end(),
+                resource_id) != draw_cache_.tile_resource_ids.end();
+  if (draw_cache_.program_id != binding.program_id ||
+      draw_cache_.needs_blending != quad->ShouldDrawWithBlending() ||
+      draw_cache_.matrix_data.size() >= 8 ||
+      resource_in_batch) {
+    FlushTextureQuadCache();
+    draw_cache_.program_id = binding.program_id;
+    draw_cache_.resource_id = 0;
+    draw_cache_.needs_blending = quad->ShouldDrawWithBlending();
+    draw_cache_.background_color = SK_ColorTRANSPARENT;
+
+    draw_cache_.uv_xform_location = binding.tex_transform_location;
+    draw_cache_.background_color_location = -1;
+    draw_cache_.vertex_opacity_location = binding.vertex_opacity_location;
+    draw_cache_.matrix_location = binding.matrix_location;
+    draw_cache_.sampler_location = -1;
+    draw_cache_.samplers_location = binding.samplers_location;
+  }
+
+  draw_cache_.tile_resource_ids.push_back(resource_id);
+  draw_cache_.tile_filters.push_back(filter);
+  draw_cache_.uv_xform_data.push_back(tex_transform);
+
+  const float opacity = quad->opacity();
+  for (int i = 0; i < 4; ++i)
+    draw_cache_.vertex_opacity_data.push_back(opacity);
+
+  gfx::Transform quad_rect_matrix;
+  QuadRectTransform(
+      &quad_rect_matrix, quad->quadTransform(), gfx::RectF(tile_rect));
+  quad_rect_matrix = frame->projection_matrix * quad_rect_matrix;
+
+  Float16 m;
+  quad_rect_matrix.matrix().asColMajorf(m.data);
+  draw_cache_.matrix_data.push_back(m);
+}
+
 void GLRenderer::DrawIOSurfaceQuad(const DrawingFrame* frame,
                                    const IOSurfaceDrawQuad* quad) {
   SetBlendEnabled(quad->ShouldDrawWithBlending());
@@ -1916,6 +2053,21 @@ void GLRenderer::FinishDrawingFrame(DrawingFrame* frame) {
   current_framebuffer_lock_.reset();
   swap_buffer_rect_.Union(gfx::ToEnclosingRect(frame->root_damage_rect));
 
+  // Only the overlays of the last frame drawn go out with the next swap.
+  pending_overlay_resources_.clear();
+  if (!frame->overlay_list.empty()) {
+    for (OverlayCandidateList::iterator it = frame->overlay_list.begin();
+         it != frame->overlay_list.end();
+         ++it) {
+      scoped_ptr<ResourceProvider::ScopedReadLockGL> lock(
+          new ResourceProvider::ScopedReadLockGL(resource_provider_,
+                                                 it->resource_id));
+      it->texture_id = lock->texture_id();
+      pending_overlay_resources_.push_back(lock.Pass());
+    }
+    output_surface_->ScheduleOverlayPlanes(frame->overlay_list);
+  }
+
   GLC(context_, context_->disable(GL_BLEND));
   blend_shadow_ = false;
 }
@@ -2093,6 +2245,11 @@ void GLRenderer::SwapBuffers() {
 
   swap_buffer_rect_ = gfx::Rect();
 
+  // The overlays that were just swapped in replace the previous ones, which
+  // can now be released.
+  in_use_overlay_resources_.swap(pending_overlay_resources_);
+  pending_overlay_resources_.clear();
+
   // We don't have real fences, so we mark read fences as passed
   // assuming a double-buffered GPU pipeline. A texture can be
   // written to after one full frame has past since it was last read.
@@ -2106,6 +2263,7 @@ void GLRenderer::EnforceMemoryPolicy() {
   if (!visible_) {
     TRACE_EVENT0("cc", "GLRenderer::EnforceMemoryPolicy dropping resources");
     ReleaseRenderPassTextures();
+    DeleteFreeReadbackBuffers();
     DiscardBackbuffer();
     resource_provider_->ReleaseCachedData();
     GLC(context_, context_->flush());
@@ -2278,13 +2436,7 @@ void GLRenderer::DoGetFramebufferPixels(
               context_->checkFramebufferStatus(GL_FRAMEBUFFER));
   }
 
-  unsigned buffer = context_->createBuffer();
-  GLC(context_, context_->bindBuffer(GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM,
-                                     buffer));
-  GLC(context_, context_->bufferData(GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM,
-                                     4 * window_rect.size().GetArea(),
-                                     NULL,
-                                     GL_STREAM_READ));
+  unsigned buffer = AcquireReadbackBuffer(4 * window_rect.size().GetArea());
 
   WebKit::WebGLId query = 0;
   if (is_async) {
@@ -2387,7 +2539,7 @@ void GLRenderer::FinishedReadback(
     }
     GLC(context_, context_->bindBuffer(GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM,
                                        0));
-    GLC(context_, context_->deleteBuffer(source_buffer));
+    ReleaseReadbackBuffer(source_buffer, 4 * size.GetArea());
   }
 
   // TODO(danakj): This can go away when synchronous readback is no more and its
@@ -2398,6 +2550,43 @@ void GLRenderer::FinishedReadback(
   pending_async_read_pixels_.pop_back();
 }
 
+unsigned GLRenderer::AcquireReadbackBuffer(size_t size_bytes) {
+  for (size_t i = 0; i < free_readback_buffers_.size(); ++i) {
+    if (free_readback_buffers_[i].second != size_bytes)
+      continue;
+    unsigned buffer = free_readback_buffers_[i].first;
+    free_readback_buffers_.erase(free_readback_buffers_.begin() + i);
+    GLC(context_, context_->bindBuffer(GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM,
+                                       buffer));
+    return buffer;
+  }
+
+  unsigned buffer = context_->createBuffer();
+  GLC(context_, context_->bindBuffer(GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM,
+                                     buffer));
+  GLC(context_, context_->bufferData(GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM,
+                                     size_bytes,
+                                     NULL,
+                                     GL_STREAM_READ));
+  return buffer;
+}
+
+void GLRenderer::ReleaseReadbackBuffer(unsigned buffer, size_t size_bytes) {
+  // A couple of buffers is enough for readbacks that overlap by a frame.
+  const size_t kMaxFreeReadbackBuffers = 2;
+  if (free_readback_buffers_.size() >= kMaxFreeReadbackBuffers) {
+    GLC(context_, context_->deleteBuffer(free_readback_buffers_.front().first));
+    free_readback_buffers_.erase(free_readback_buffers_.begin());
+  }
+  free_readback_buffers_.push_back(std::make_pair(buffer, size_bytes));
+}
+
+void GLRenderer::DeleteFreeReadbackBuffers() {
+  for (size_t i = 0; i < free_readback_buffers_.size(); ++i)
+    GLC(context_, context_->deleteBuffer(free_readback_buffers_[i].first));
+  free_readback_buffers_.clear();
+}
+
 void GLRenderer::PassOnSkBitmap(
     scoped_ptr<SkBitmap> bitmap,
     scoped_ptr<SkAutoLockPixels> lock,
@@ -2778,6 +2967,64 @@ GLRenderer::GetTileProgramSwizzleOpaque(TexCoordPrecision precision) {
   return program.get();
 }
 
+const GLRenderer::TileBatchProgram*
+GLRenderer::GetTileBatchProgram(TexCoordPrecision precision) {
+  scoped_ptr<TileBatchProgram>& program =
+      (precision == TexCoordPrecisionHigh) ? tile_batch_program_highp_
+                                           : tile_batch_program_;
+  if (!program)
+    program = make_scoped_ptr(new TileBatchProgram(context_, precision));
+  if (!program->initialized()) {
+    TRACE_EVENT0("cc", "GLRenderer::tileBatchProgram::initialize");
+    program->Initialize(context_, is_using_bind_uniform_);
+  }
+  return program.get();
+}
+
+const GLRenderer::TileBatchProgramOpaque*
+GLRenderer::GetTileBatchProgramOpaque(TexCoordPrecision precision) {
+  scoped_ptr<TileBatchProgramOpaque>& program =
+      (precision == TexCoordPrecisionHigh) ? tile_batch_program_opaque_highp_
+                                           : tile_batch_program_opaque_;
+  if (!program)
+    program = make_scoped_ptr(new TileBatchProgramOpaque(context_, precision));
+  if (!program->initialized()) {
+    TRACE_EVENT0("cc", "GLRenderer::tileBatchProgramOpaque::initialize");
+    program->Initialize(context_, is_using_bind_uniform_);
+  }
+  return program.get();
+}
+
+const GLRenderer::TileBatchProgramSwizzle*
+GLRenderer::GetTileBatchProgramSwizzle(TexCoordPrecision precision) {
+  scoped_ptr<TileBatchProgramSwizzle>& program =
+      (precision == TexCoordPrecisionHigh) ? tile_batch_program_swizzle_highp_
+                                           : tile_batch_program_swizzle_;
+  if (!program)
+    program = make_scoped_ptr(new TileBatchProgramSwizzle(context_, precision));
+  if (!program->initialized()) {
+    TRACE_EVENT0("cc", "GLRenderer::tileBatchProgramSwizzle::initialize");
+    program->Initialize(context_, is_using_bind_uniform_);
+  }
+  return program.get();
+}
+
+const GLRenderer::TileBatchProgramSwizzleOpaque*
+GLRenderer::GetTileBatchProgramSwizzleOpaque(TexCoordPrecision precision) {
+  scoped_ptr<TileBatchProgramSwizzleOpaque>& program =
+      (precision == TexCoordPrecisionHigh)
+          ? tile_batch_program_swizzle_opaque_highp_
+          : tile_batch_program_swizzle_opaque_;
+  if (!program)
+    program = make_scoped_ptr(
+        new TileBatchProgramSwizzleOpaque(context_, precision));
+  if (!program->initialized()) {
+    TRACE_EVENT0("cc", "GLRenderer::tileBatchProgramSwizzleOpaque::initialize");
+    program->Initialize(context_, is_using_bind_uniform_);
+  }
+  return program.get();
+}
+
 const GLRenderer::TileProgramSwizzleAA* GLRenderer::GetTileProgramSwizzleAA(
     TexCoordPrecision precision) {
   scoped_ptr<TileProgramSwizzleAA>& program =
@@ -2952,6 +3199,23 @@ void GLRenderer::CleanupSharedObjects() {
   if (tile_program_swizzle_aa_highp_)
     tile_program_swizzle_aa_highp_->Cleanup(context_);
 
+  if (tile_batch_program_)
+    tile_batch_program_->Cleanup(context_);
+  if (tile_batch_program_opaque_)
+    tile_batch_program_opaque_->Cleanup(context_);
+  if (tile_batch_program_swizzle_)
+    tile_batch_program_swizzle_->Cleanup(context_);
+  if (tile_batch_program_swizzle_opaque_)
+    tile_batch_program_swizzle_opaque_->Cleanup(context_);
+  if (tile_batch_program_highp_)
+    tile_batch_program_highp_->Cleanup(context_);
+  if (tile_batch_program_opaque_highp_)
+    tile_batch_program_opaque_highp_->Cleanup(context_);
+  if (tile_batch_program_swizzle_highp_)
+    tile_batch_program_swizzle_highp_->Cleanup(context_);
+  if (tile_batch_program_swizzle_opaque_highp_)
+    tile_batch_program_swizzle_opaque_highp_->Cleanup(context_);
+
   if (render_pass_mask_program_)
     render_pass_mask_program_->Cleanup(context_);
   if (render_pass_program_)
@@ -3035,6 +3299,7 @@ void GLRenderer::CleanupSharedObjects() {
   if (on_demand_tile_raster_resource_id_)
     resource_provider_->DeleteResource(on_demand_tile_raster_resource_id_);
 
+  DeleteFreeReadbackBuffers();
   ReleaseRenderPassTextures();
 }
 
@@ -5,6 +5,9 @@
 #ifndef CC_OUTPUT_GL_RENDERER_H_
 #define CC_OUTPUT_GL_RENDERER_H_
 
+#include <utility>
+#include <vector>
+
 #include "base/cancelable_callback.h"
 #include "cc/base/cc_export.h"
 #include "cc/base/scoped_ptr_vector.h"
@@ -163,6 +166,13 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
                            const StreamVideoDrawQuad* quad);
   void EnqueueTextureQuad(const DrawingFrame* frame,
                           const TextureDrawQuad* quad);
+  void EnqueueTileQuad(const DrawingFrame* frame,
+                       const ContentDrawQuadBase* quad,
+                       ResourceProvider::ResourceId resource_id,
+                       unsigned filter,
+                       TexCoordPrecision tex_coord_precision,
+                       gfx::Rect tile_rect,
+                       const Float4& tex_transform);
   void FlushTextureQuadCache();
   void DrawIOSurfaceQuad(const DrawingFrame* frame,
                          const IOSurfaceDrawQuad* quad);
@@ -213,6 +223,12 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
       unsigned query,
       uint8_t* dest_pixels,
       gfx::Size size);
+  // Returns a pixel pack buffer with room for |size_bytes|, reusing one from
+  // an earlier readback of the same size when possible. The buffer is left
+  // bound to GL_PIXEL_PACK_TRANSFER_BUFFER_CHROMIUM.
+  unsigned AcquireReadbackBuffer(size_t size_bytes);
+  void ReleaseReadbackBuffer(unsigned buffer, size_t size_bytes);
+  void DeleteFreeReadbackBuffers();
   void PassOnSkBitmap(scoped_ptr<SkBitmap> bitmap,
                       scoped_ptr<SkAutoLockPixels> lock,
                       scoped_ptr<CopyOutputRequest> request,
@@ -249,6 +265,18 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
       TileProgramSwizzle;
   typedef ProgramBinding<VertexShaderTile, FragmentShaderRGBATexSwizzleOpaque>
       TileProgramSwizzleOpaque;
+  typedef ProgramBinding<VertexShaderTileBatch,
+                         FragmentShaderRGBATexBatchVaryingAlpha>
+      TileBatchProgram;
+  typedef ProgramBinding<VertexShaderTileBatch,
+                         FragmentShaderRGBATexBatchOpaque>
+      TileBatchProgramOpaque;
+  typedef ProgramBinding<VertexShaderTileBatch,
+                         FragmentShaderRGBATexBatchSwizzleVaryingAlpha>
+      TileBatchProgramSwizzle;
+  typedef ProgramBinding<VertexShaderTileBatch,
+                         FragmentShaderRGBATexBatchSwizzleOpaque>
+      TileBatchProgramSwizzleOpaque;
   typedef ProgramBinding<VertexShaderPosTex, FragmentShaderCheckerboard>
       TileCheckerboardProgram;
 
@@ -316,6 +344,13 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
       TexCoordPrecision precision);
   const TileProgramSwizzleAA* GetTileProgramSwizzleAA(
       TexCoordPrecision precision);
+  const TileBatchProgram* GetTileBatchProgram(TexCoordPrecision precision);
+  const TileBatchProgramOpaque* GetTileBatchProgramOpaque(
+      TexCoordPrecision precision);
+  const TileBatchProgramSwizzle* GetTileBatchProgramSwizzle(
+      TexCoordPrecision precision);
+  const TileBatchProgramSwizzleOpaque* GetTileBatchProgramSwizzleOpaque(
+      TexCoordPrecision precision);
   const TileCheckerboardProgram* GetTileCheckerboardProgram();
 
   const RenderPassProgram* GetRenderPassProgram(
@@ -372,6 +407,17 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   scoped_ptr<TileProgramSwizzleOpaque> tile_program_swizzle_opaque_highp_;
   scoped_ptr<TileProgramSwizzleAA> tile_program_swizzle_aa_highp_;
 
+  scoped_ptr<TileBatchProgram> tile_batch_program_;
+  scoped_ptr<TileBatchProgramOpaque> tile_batch_program_opaque_;
+  scoped_ptr<TileBatchProgramSwizzle> tile_batch_program_swizzle_;
+  scoped_ptr<TileBatchProgramSwizzleOpaque> tile_batch_program_swizzle_opaque_;
+
+  scoped_ptr<TileBatchProgram> tile_batch_program_highp_;
+  scoped_ptr<TileBatchProgramOpaque> tile_batch_program_opaque_highp_;
+  scoped_ptr<TileBatchProgramSwizzle> tile_batch_program_swizzle_highp_;
+  scoped_ptr<TileBatchProgramSwizzleOpaque>
+      tile_batch_program_swizzle_opaque_highp_;
+
   scoped_ptr<TextureProgram> texture_program_;
   scoped_ptr<NonPremultipliedTextureProgram> nonpremultiplied_texture_program_;
   scoped_ptr<TextureBackgroundProgram> texture_background_program_;
@@ -449,8 +495,20 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   struct PendingAsyncReadPixels;
   ScopedPtrVector<PendingAsyncReadPixels> pending_async_read_pixels_;
 
+  // Pixel pack buffers of finished readbacks, and the number of bytes each
+  // one holds. Repeated readbacks of the same size, as for tab capture, reuse
+  // these instead of allocating new shared memory each time.
+  std::vector<std::pair<unsigned, size_t> > free_readback_buffers_;
+
   scoped_ptr<ResourceProvider::ScopedWriteLockGL> current_framebuffer_lock_;
 
+  // Read locks on the resources of overlay planes: those scheduled for the
+  // next swap, and those on screen since the last one.
+  ScopedPtrVector<ResourceProvider::ScopedReadLockGL>
+      pending_overlay_resources_;
+  ScopedPtrVector<ResourceProvider::ScopedReadLockGL>
+      in_use_overlay_resources_;
+
   scoped_refptr<ResourceProvider::Fence> last_swap_fence_;
 
   SkBitmap on_demand_tile_raster_bitmap_;
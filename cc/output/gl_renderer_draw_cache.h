@@ -47,6 +47,13 @@ struct TexturedQuadDrawCache {
   std::vector<float> vertex_opacity_data;
   std::vector<Float16> matrix_data;
 
+  // Batched tiles are each sampled from their own texture unit, so unlike
+  // texture quads they don't need to share |resource_id|. These are empty
+  // when the cache holds texture quads.
+  int samplers_location;
+  std::vector<int> tile_resource_ids;
+  std::vector<unsigned> tile_filters;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(TexturedQuadDrawCache);
 };
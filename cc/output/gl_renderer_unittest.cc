@@ -5,9 +5,12 @@
 #include "cc/output/gl_renderer.h"
 
 #include <set>
+#include <vector>
 
 #include "cc/base/math_util.h"
 #include "cc/output/compositor_frame_metadata.h"
+#include "cc/quads/texture_draw_quad.h"
+#include "cc/quads/tile_draw_quad.h"
 #include "cc/resources/prioritized_resource_manager.h"
 #include "cc/resources/resource_provider.h"
 #include "cc/test/fake_impl_proxy.h"
@@ -82,6 +85,11 @@ class GLRendererShaderPixelTest : public GLRendererPixelTest {
     EXPECT_PROGRAM_VALID(renderer()->GetTileProgramSwizzle(precision));
     EXPECT_PROGRAM_VALID(renderer()->GetTileProgramSwizzleOpaque(precision));
     EXPECT_PROGRAM_VALID(renderer()->GetTileProgramSwizzleAA(precision));
+    EXPECT_PROGRAM_VALID(renderer()->GetTileBatchProgram(precision));
+    EXPECT_PROGRAM_VALID(renderer()->GetTileBatchProgramOpaque(precision));
+    EXPECT_PROGRAM_VALID(renderer()->GetTileBatchProgramSwizzle(precision));
+    EXPECT_PROGRAM_VALID(
+        renderer()->GetTileBatchProgramSwizzleOpaque(precision));
     EXPECT_PROGRAM_VALID(renderer()->GetRenderPassProgram(precision));
     EXPECT_PROGRAM_VALID(renderer()->GetRenderPassProgramAA(precision));
     EXPECT_PROGRAM_VALID(renderer()->GetRenderPassMaskProgram(precision));
@@ -968,6 +976,168 @@ TEST(GLRendererTest2, ActiveTextureState) {
   Mock::VerifyAndClearExpectations(context);
 }
 
+class TileBatchTrackingContext : public TestWebGraphicsContext3D {
+ public:
+  TileBatchTrackingContext() : active_texture_(GL_TEXTURE0) {}
+
+  MOCK_METHOD4(drawElements,
+               void(WGC3Denum mode,
+                    WGC3Dsizei count,
+                    WGC3Denum type,
+                    WGC3Dintptr offset));
+
+  virtual void activeTexture(WGC3Denum texture) {
+    active_texture_ = texture;
+  }
+
+  virtual void bindTexture(WGC3Denum target, WebGLId texture) {
+    if (target == GL_TEXTURE_2D && texture)
+      bound_texture_units_.push_back(active_texture_);
+    TestWebGraphicsContext3D::bindTexture(target, texture);
+  }
+
+  // The texture units 2D textures were bound on, in order.
+  std::vector<WGC3Denum>& bound_texture_units() {
+    return bound_texture_units_;
+  }
+
+ private:
+  WGC3Denum active_texture_;
+  std::vector<WGC3Denum> bound_texture_units_;
+};
+
+class GLRendererTileBatchTest : public testing::Test {
+ protected:
+  GLRendererTileBatchTest() {
+    scoped_ptr<TileBatchTrackingContext> context3d(
+        new TileBatchTrackingContext);
+    context3d_ = context3d.get();
+
+    output_surface_ = FakeOutputSurface::Create3d(
+        context3d.PassAs<TestWebGraphicsContext3D>()).Pass();
+    CHECK(output_surface_->BindToClient(&output_surface_client_));
+
+    resource_provider_ = ResourceProvider::Create(
+        output_surface_.get(), NULL, 0, false, 1).Pass();
+    settings_.allow_antialiasing = false;
+    renderer_ = make_scoped_ptr(new FakeRendererGL(&renderer_client_,
+                                                   &settings_,
+                                                   output_surface_.get(),
+                                                   resource_provider_.get()));
+
+    pass_ = TestRenderPass::Create();
+    pass_->SetNew(RenderPass::Id(1, 1),
+                  gfx::Rect(0, 0, 100, 100),
+                  gfx::Rect(0, 0, 100, 100),
+                  gfx::Transform());
+    scoped_ptr<SharedQuadState> shared_state = SharedQuadState::Create();
+    shared_state->SetAll(gfx::Transform(),
+                         gfx::Size(100, 100),
+                         gfx::Rect(0, 0, 100, 100),
+                         gfx::Rect(0, 0, 100, 100),
+                         false,
+                         1);
+    pass_->AppendSharedQuadState(shared_state.Pass());
+  }
+
+  virtual void SetUp() { EXPECT_TRUE(renderer_->Initialize()); }
+
+  ResourceProvider::ResourceId CreateTileResource() {
+    ResourceProvider::ResourceId resource_id =
+        resource_provider_->CreateResource(gfx::Size(10, 10),
+                                           GL_CLAMP_TO_EDGE,
+                                           ResourceProvider::TextureUsageAny,
+                                           RGBA_8888);
+    resource_provider_->AllocateForTesting(resource_id);
+    return resource_id;
+  }
+
+  // Adds an opaque, untransformed 10x10 tile at grid position |index|.
+  void AddTile(int index, ResourceProvider::ResourceId resource_id) {
+    gfx::Rect rect(10 * (index % 10), 10 * (index / 10), 10, 10);
+    scoped_ptr<TileDrawQuad> tile_quad = TileDrawQuad::Create();
+    tile_quad->SetNew(pass_->shared_quad_state_list.back(),
+                      rect,
+                      rect,
+                      resource_id,
+                      gfx::RectF(0, 0, 10, 10),
+                      gfx::Size(10, 10),
+                      false);
+    pass_->AppendQuad(tile_quad.PassAs<DrawQuad>());
+  }
+
+  void DrawQuads() {
+    context3d_->bound_texture_units().clear();
+    DirectRenderer::DrawingFrame drawing_frame;
+    renderer_->BeginDrawingFrame(&drawing_frame);
+    for (QuadList::BackToFrontIterator it = pass_->quad_list.BackToFrontBegin();
+         it != pass_->quad_list.BackToFrontEnd();
+         ++it) {
+      renderer_->DoDrawQuad(&drawing_frame, *it);
+    }
+    renderer_->FinishDrawingQuadList();
+  }
+
+  LayerTreeSettings settings_;
+  TileBatchTrackingContext* context3d_;
+  FakeOutputSurfaceClient output_surface_client_;
+  scoped_ptr<FakeOutputSurface> output_surface_;
+  FakeRendererClient renderer_client_;
+  scoped_ptr<ResourceProvider> resource_provider_;
+  scoped_ptr<FakeRendererGL> renderer_;
+  scoped_ptr<TestRenderPass> pass_;
+};
+
+TEST_F(GLRendererTileBatchTest, TilesShareDrawCallsUpToEightTextureUnits) {
+  // Ten tiles with their own resources fill one batch of eight, and the last
+  // two start a second one.
+  for (int i = 0; i < 10; ++i)
+    AddTile(i, CreateTileResource());
+
+  {
+    InSequence sequence;
+    EXPECT_CALL(*context3d_,
+                drawElements(GL_TRIANGLES, 6 * 8, GL_UNSIGNED_SHORT, 0));
+    EXPECT_CALL(*context3d_,
+                drawElements(GL_TRIANGLES, 6 * 2, GL_UNSIGNED_SHORT, 0));
+  }
+  DrawQuads();
+  Mock::VerifyAndClearExpectations(context3d_);
+
+  const std::vector<WGC3Denum>& units = context3d_->bound_texture_units();
+  ASSERT_EQ(10u, units.size());
+  for (size_t i = 0; i < 8; ++i)
+    EXPECT_EQ(static_cast<WGC3Denum>(GL_TEXTURE0 + i), units[i]);
+  EXPECT_EQ(static_cast<WGC3Denum>(GL_TEXTURE0), units[8]);
+  EXPECT_EQ(static_cast<WGC3Denum>(GL_TEXTURE1), units[9]);
+}
+
+TEST_F(GLRendererTileBatchTest, RepeatedResourceSplitsBatch) {
+  // A resource is bound with a single filter, so a tile that reuses one
+  // already in the batch starts the next batch.
+  ResourceProvider::ResourceId first = CreateTileResource();
+  ResourceProvider::ResourceId second = CreateTileResource();
+  AddTile(0, first);
+  AddTile(1, second);
+  AddTile(2, first);
+
+  {
+    InSequence sequence;
+    EXPECT_CALL(*context3d_,
+                drawElements(GL_TRIANGLES, 6 * 2, GL_UNSIGNED_SHORT, 0));
+    EXPECT_CALL(*context3d_,
+                drawElements(GL_TRIANGLES, 6 * 1, GL_UNSIGNED_SHORT, 0));
+  }
+  DrawQuads();
+  Mock::VerifyAndClearExpectations(context3d_);
+
+  const std::vector<WGC3Denum>& units = context3d_->bound_texture_units();
+  ASSERT_EQ(3u, units.size());
+  EXPECT_EQ(static_cast<WGC3Denum>(GL_TEXTURE0), units[0]);
+  EXPECT_EQ(static_cast<WGC3Denum>(GL_TEXTURE1), units[1]);
+  EXPECT_EQ(static_cast<WGC3Denum>(GL_TEXTURE0), units[2]);
+}
+
 class NoClearRootRenderPassMockContext : public TestWebGraphicsContext3D {
  public:
   MOCK_METHOD1(clear, void(WGC3Dbitfield mask));
@@ -1372,6 +1542,103 @@ TEST(GLRendererTest2, ScissorAndViewportWithinNonreshapableSurface) {
       renderer_client.render_passes_in_draw_order(), NULL, 1.f, true, false);
 }
 
+class OverlayOutputSurface : public FakeOutputSurface {
+ public:
+  explicit OverlayOutputSurface(scoped_ptr<TestWebGraphicsContext3D> context3d)
+      : FakeOutputSurface(TestContextProvider::Create(context3d.Pass()),
+                          false) {
+    capabilities_.supports_overlays = true;
+  }
+
+  virtual void CheckOverlaySupport(OverlayCandidateList* candidates) OVERRIDE {
+    for (OverlayCandidateList::iterator it = candidates->begin();
+         it != candidates->end();
+         ++it)
+      it->overlay_handled = true;
+  }
+  virtual void ScheduleOverlayPlanes(const OverlayCandidateList& overlays)
+      OVERRIDE {
+    scheduled_overlays_ = overlays;
+  }
+
+  const OverlayCandidateList& scheduled_overlays() const {
+    return scheduled_overlays_;
+  }
+
+ private:
+  OverlayCandidateList scheduled_overlays_;
+};
+
+TEST(GLRendererTest2, OpaqueTextureQuadOnTopIsPromotedToOverlay) {
+  FakeOutputSurfaceClient output_surface_client;
+  scoped_ptr<OverlayOutputSurface> output_surface(new OverlayOutputSurface(
+      TestWebGraphicsContext3D::Create()));
+  CHECK(output_surface->BindToClient(&output_surface_client));
+
+  scoped_ptr<ResourceProvider> resource_provider(
+      ResourceProvider::Create(output_surface.get(), NULL, 0, false, 1));
+
+  LayerTreeSettings settings;
+  FakeRendererClient renderer_client;
+  renderer_client.set_viewport(gfx::Rect(0, 0, 100, 100));
+  renderer_client.set_clip(gfx::Rect(0, 0, 100, 100));
+  FakeRendererGL renderer(&renderer_client,
+                          &settings,
+                          output_surface.get(),
+                          resource_provider.get());
+  EXPECT_TRUE(renderer.Initialize());
+  EXPECT_TRUE(renderer.Capabilities().using_overlays);
+
+  gfx::Rect viewport_rect(renderer_client.DeviceViewport());
+  gfx::Rect quad_rect(10, 10, 50, 50);
+  ResourceProvider::ResourceId resource_id = resource_provider->CreateResource(
+      quad_rect.size(),
+      GL_CLAMP_TO_EDGE,
+      ResourceProvider::TextureUsageAny,
+      RGBA_8888);
+  resource_provider->AllocateForTesting(resource_id);
+
+  ScopedPtrVector<RenderPass>& render_passes =
+      *renderer_client.render_passes_in_draw_order();
+  render_passes.clear();
+
+  RenderPass::Id root_pass_id(1, 0);
+  TestRenderPass* root_pass = AddRenderPass(
+      &render_passes, root_pass_id, viewport_rect, gfx::Transform());
+  scoped_ptr<SharedQuadState> shared_state = SharedQuadState::Create();
+  shared_state->SetAll(
+      gfx::Transform(), quad_rect.size(), quad_rect, quad_rect, false, 1);
+  const float vertex_opacity[] = { 1.f, 1.f, 1.f, 1.f };
+  scoped_ptr<TextureDrawQuad> texture_quad = TextureDrawQuad::Create();
+  texture_quad->SetNew(shared_state.get(),
+                       quad_rect,
+                       quad_rect,
+                       resource_id,
+                       true,
+                       gfx::PointF(0.f, 0.f),
+                       gfx::PointF(1.f, 1.f),
+                       SK_ColorTRANSPARENT,
+                       vertex_opacity,
+                       false);
+  root_pass->AppendSharedQuadState(shared_state.Pass());
+  root_pass->AppendQuad(texture_quad.PassAs<DrawQuad>());
+  AddQuad(root_pass, viewport_rect, SK_ColorGREEN);
+
+  renderer.DecideRenderPassAllocationsForFrame(
+      *renderer_client.render_passes_in_draw_order());
+  renderer.DrawFrame(
+      renderer_client.render_passes_in_draw_order(), NULL, 1.f, true, false);
+  renderer.SwapBuffers();
+
+  ASSERT_EQ(1u, output_surface->scheduled_overlays().size());
+  const OverlayCandidate& overlay = output_surface->scheduled_overlays()[0];
+  EXPECT_EQ(gfx::RectF(quad_rect).ToString(), overlay.display_rect.ToString());
+  EXPECT_EQ(gfx::RectF(0.f, 0.f, 1.f, 1.f).ToString(),
+            overlay.uv_rect.ToString());
+  EXPECT_EQ(resource_id, overlay.resource_id);
+  EXPECT_NE(0u, overlay.texture_id);
+}
+
 TEST_F(GLRendererShaderTest, DrawRenderPassQuadShaderPermutations) {
   gfx::Rect viewport_rect(renderer_client_.DeviceViewport());
   ScopedPtrVector<RenderPass>* render_passes =
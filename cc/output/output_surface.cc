@@ -267,6 +267,13 @@ bool OutputSurface::HasExternalStencilTest() const {
 
 bool OutputSurface::ForcedDrawToSoftwareDevice() const { return false; }
 
+void OutputSurface::CheckOverlaySupport(OverlayCandidateList* candidates) {}
+
+void OutputSurface::ScheduleOverlayPlanes(
+    const OverlayCandidateList& overlays) {
+  NOTREACHED();
+}
+
 bool OutputSurface::BindToClient(cc::OutputSurfaceClient* client) {
   DCHECK(client);
   client_ = client;
@@ -13,6 +13,7 @@
 #include "base/memory/weak_ptr.h"
 #include "cc/base/cc_export.h"
 #include "cc/output/context_provider.h"
+#include "cc/output/overlay_candidate.h"
 #include "cc/output/software_output_device.h"
 #include "cc/scheduler/frame_rate_controller.h"
 #include "cc/scheduler/rolling_time_delta_history.h"
@@ -63,7 +64,8 @@ class CC_EXPORT OutputSurface : public FrameRateControllerClient {
           deferred_gl_initialization(false),
           draw_and_swap_full_viewport_every_frame(false),
           adjust_deadline_for_parent(true),
-          uses_default_gl_framebuffer(true) {}
+          uses_default_gl_framebuffer(true),
+          supports_overlays(false) {}
     bool delegated_rendering;
     int max_frames_pending;
     bool deferred_gl_initialization;
@@ -74,6 +76,8 @@ class CC_EXPORT OutputSurface : public FrameRateControllerClient {
     // Whether this output surface renders to the default OpenGL zero
     // framebuffer or to an offscreen framebuffer.
     bool uses_default_gl_framebuffer;
+    // Whether CheckOverlaySupport() may accept overlay candidates.
+    bool supports_overlays;
   };
 
   const Capabilities& capabilities() const {
@@ -124,6 +128,16 @@ class CC_EXPORT OutputSurface : public FrameRateControllerClient {
   // itself).
   virtual void SwapBuffers(CompositorFrame* frame);
 
+  // Sets |overlay_handled| on each of the |candidates| that can be presented
+  // on a hardware overlay plane. The renderer doesn't composite handled
+  // candidates; it passes them to ScheduleOverlayPlanes() before swapping
+  // instead. Only called if capabilities().supports_overlays is set.
+  virtual void CheckOverlaySupport(OverlayCandidateList* candidates);
+
+  // Presents |overlays| along with the next SwapBuffers(). Their textures
+  // stay valid until the swap after that.
+  virtual void ScheduleOverlayPlanes(const OverlayCandidateList& overlays);
+
   // Notifies frame-rate smoothness preference. If true, all non-critical
   // processing should be stopped, or lowered in priority.
   virtual void UpdateSmoothnessTakesPriority(bool prefer_smoothness) {}
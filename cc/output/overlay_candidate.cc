@@ -0,0 +1,17 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/output/overlay_candidate.h"
+
+namespace cc {
+
+OverlayCandidate::OverlayCandidate()
+    : resource_id(0),
+      texture_id(0),
+      plane_z_order(0),
+      overlay_handled(false) {}
+
+OverlayCandidate::~OverlayCandidate() {}
+
+}  // namespace cc
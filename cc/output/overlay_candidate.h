@@ -0,0 +1,44 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_OUTPUT_OVERLAY_CANDIDATE_H_
+#define CC_OUTPUT_OVERLAY_CANDIDATE_H_
+
+#include <vector>
+
+#include "cc/base/cc_export.h"
+#include "ui/gfx/rect_f.h"
+
+namespace cc {
+
+// A quad that the renderer would like to present on a hardware overlay plane
+// rather than composite into the root render pass.
+class CC_EXPORT OverlayCandidate {
+ public:
+  OverlayCandidate();
+  ~OverlayCandidate();
+
+  // Where the overlay is displayed, in the root render pass's target space.
+  gfx::RectF display_rect;
+  // The part of the buffer that is displayed, in normalized texture
+  // coordinates.
+  gfx::RectF uv_rect;
+  // The resource holding the buffer, and its GL texture once the renderer
+  // has locked it for the frame.
+  unsigned resource_id;
+  unsigned texture_id;
+  // Stacking order relative to the main plane, which is plane 0. Positive
+  // values are above it.
+  int plane_z_order;
+
+  // Set by OutputSurface::CheckOverlaySupport() if the candidate can be
+  // presented as an overlay.
+  bool overlay_handled;
+};
+
+typedef std::vector<OverlayCandidate> OverlayCandidateList;
+
+}  // namespace cc
+
+#endif  // CC_OUTPUT_OVERLAY_CANDIDATE_H_
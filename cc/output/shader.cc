@@ -505,6 +505,56 @@ std::string VertexShaderTile::GetShaderString() const {
   );  // NOLINT(whitespace/parens)
 }
 
+VertexShaderTileBatch::VertexShaderTileBatch()
+    : matrix_location_(-1),
+      tex_transform_location_(-1),
+      vertex_opacity_location_(-1) {}
+
+void VertexShaderTileBatch::Init(WebGraphicsContext3D* context,
+                                 unsigned program,
+                                 bool using_bind_uniform,
+                                 int* base_uniform_index) {
+  static const char* uniforms[] = {
+    "matrix",
+    "texTransform",
+    "opacity",
+  };
+  int locations[arraysize(uniforms)];
+
+  GetProgramUniformLocations(context,
+                             program,
+                             arraysize(uniforms),
+                             uniforms,
+                             locations,
+                             using_bind_uniform,
+                             base_uniform_index);
+  matrix_location_ = locations[0];
+  tex_transform_location_ = locations[1];
+  vertex_opacity_location_ = locations[2];
+}
+
+std::string VertexShaderTileBatch::GetShaderString() const {
+  return VERTEX_SHADER(
+    attribute vec4 a_position;
+    attribute TexCoordPrecision vec2 a_texCoord;
+    attribute float a_index;
+    uniform mat4 matrix[8];
+    uniform TexCoordPrecision vec4 texTransform[8];
+    uniform float opacity[32];
+    varying TexCoordPrecision vec2 v_texCoord;
+    varying float v_alpha;
+    varying float v_quadIndex;
+    void main() {
+      int quad_index = int(a_index * 0.25);  // NOLINT
+      gl_Position = matrix[quad_index] * a_position;
+      TexCoordPrecision vec4 texTrans = texTransform[quad_index];
+      v_texCoord = a_texCoord * texTrans.zw + texTrans.xy;
+      v_alpha = opacity[int(a_index)]; // NOLINT
+      v_quadIndex = float(quad_index);
+    }
+  );  // NOLINT(whitespace/parens)
+}
+
 VertexShaderTileAA::VertexShaderTileAA()
     : matrix_location_(-1),
       viewport_location_(-1),
@@ -919,6 +969,107 @@ std::string FragmentShaderRGBATexSwizzleOpaque::GetShaderString(
   );  // NOLINT(whitespace/parens)
 }
 
+FragmentTexBatchBinding::FragmentTexBatchBinding()
+    : samplers_location_(-1) {}
+
+void FragmentTexBatchBinding::Init(WebGraphicsContext3D* context,
+                                   unsigned program,
+                                   bool using_bind_uniform,
+                                   int* base_uniform_index) {
+  static const char* uniforms[] = {
+    "s_textures",
+  };
+  int locations[arraysize(uniforms)];
+
+  GetProgramUniformLocations(context,
+                             program,
+                             arraysize(uniforms),
+                             uniforms,
+                             locations,
+                             using_bind_uniform,
+                             base_uniform_index);
+  samplers_location_ = locations[0];
+}
+
+// Samplers can only be indexed by constant index expressions in fragment
+// shaders, so the batch shaders loop over all the units instead of
+// indexing by |v_quadIndex|. |v_quadIndex| is the same for all fragments
+// of a tile.
+std::string FragmentShaderRGBATexBatchVaryingAlpha::GetShaderString(
+    TexCoordPrecision precision) const {
+  return FRAGMENT_SHADER(
+    precision mediump float;
+    varying TexCoordPrecision vec2 v_texCoord;
+    varying float v_alpha;
+    varying float v_quadIndex;
+    uniform sampler2D s_textures[8];
+    void main() {
+      vec4 texColor = vec4(0.0);
+      for (int i = 0; i < 8; ++i) {  // NOLINT
+        if (abs(v_quadIndex - float(i)) < 0.5)
+          texColor = texture2D(s_textures[i], v_texCoord);
+      }
+      gl_FragColor = texColor * v_alpha;
+    }
+  );  // NOLINT(whitespace/parens)
+}
+
+std::string FragmentShaderRGBATexBatchOpaque::GetShaderString(
+    TexCoordPrecision precision) const {
+  return FRAGMENT_SHADER(
+    precision mediump float;
+    varying TexCoordPrecision vec2 v_texCoord;
+    varying float v_quadIndex;
+    uniform sampler2D s_textures[8];
+    void main() {
+      vec4 texColor = vec4(0.0);
+      for (int i = 0; i < 8; ++i) {  // NOLINT
+        if (abs(v_quadIndex - float(i)) < 0.5)
+          texColor = texture2D(s_textures[i], v_texCoord);
+      }
+      gl_FragColor = vec4(texColor.rgb, 1.0);
+    }
+  );  // NOLINT(whitespace/parens)
+}
+
+std::string FragmentShaderRGBATexBatchSwizzleVaryingAlpha::GetShaderString(
+    TexCoordPrecision precision) const {
+  return FRAGMENT_SHADER(
+    precision mediump float;
+    varying TexCoordPrecision vec2 v_texCoord;
+    varying float v_alpha;
+    varying float v_quadIndex;
+    uniform sampler2D s_textures[8];
+    void main() {
+      vec4 texColor = vec4(0.0);
+      for (int i = 0; i < 8; ++i) {  // NOLINT
+        if (abs(v_quadIndex - float(i)) < 0.5)
+          texColor = texture2D(s_textures[i], v_texCoord);
+      }
+      gl_FragColor =
+          vec4(texColor.z, texColor.y, texColor.x, texColor.w) * v_alpha;
+    }
+  );  // NOLINT(whitespace/parens)
+}
+
+std::string FragmentShaderRGBATexBatchSwizzleOpaque::GetShaderString(
+    TexCoordPrecision precision) const {
+  return FRAGMENT_SHADER(
+    precision mediump float;
+    varying TexCoordPrecision vec2 v_texCoord;
+    varying float v_quadIndex;
+    uniform sampler2D s_textures[8];
+    void main() {
+      vec4 texColor = vec4(0.0);
+      for (int i = 0; i < 8; ++i) {  // NOLINT
+        if (abs(v_quadIndex - float(i)) < 0.5)
+          texColor = texture2D(s_textures[i], v_texCoord);
+      }
+      gl_FragColor = vec4(texColor.z, texColor.y, texColor.x, 1.0);
+    }
+  );  // NOLINT(whitespace/parens)
+}
+
 FragmentShaderRGBATexAlphaAA::FragmentShaderRGBATexAlphaAA()
     : sampler_location_(-1),
       alpha_location_(-1) {}
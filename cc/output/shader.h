@@ -256,6 +256,31 @@ class VertexShaderTileAA {
   DISALLOW_COPY_AND_ASSIGN(VertexShaderTileAA);
 };
 
+// Draws up to 8 tiles at once, each with its own transform, texture
+// transform and opacity. The quad index is passed on so that the fragment
+// shader can sample the tile's own texture unit.
+class VertexShaderTileBatch {
+ public:
+  VertexShaderTileBatch();
+
+  void Init(WebKit::WebGraphicsContext3D* context,
+            unsigned program,
+            bool using_bind_uniform,
+            int* base_uniform_index);
+  std::string GetShaderString() const;
+
+  int matrix_location() const { return matrix_location_; }
+  int tex_transform_location() const { return tex_transform_location_; }
+  int vertex_opacity_location() const { return vertex_opacity_location_; }
+
+ private:
+  int matrix_location_;
+  int tex_transform_location_;
+  int vertex_opacity_location_;
+
+  DISALLOW_COPY_AND_ASSIGN(VertexShaderTileBatch);
+};
+
 class VertexShaderVideoTransform {
  public:
   VertexShaderVideoTransform();
@@ -413,6 +438,48 @@ class FragmentShaderRGBATexSwizzleOpaque : public FragmentTexOpaqueBinding {
   std::string GetShaderString(TexCoordPrecision precision) const;
 };
 
+// Samples the texture unit of the batched tile being drawn. Texture unit i
+// is used for the i-th tile of the batch.
+class FragmentTexBatchBinding {
+ public:
+  FragmentTexBatchBinding();
+
+  void Init(WebKit::WebGraphicsContext3D* context,
+            unsigned program,
+            bool using_bind_uniform,
+            int* base_uniform_index);
+  int samplers_location() const { return samplers_location_; }
+
+ private:
+  int samplers_location_;
+
+  DISALLOW_COPY_AND_ASSIGN(FragmentTexBatchBinding);
+};
+
+class FragmentShaderRGBATexBatchVaryingAlpha : public FragmentTexBatchBinding {
+ public:
+  std::string GetShaderString(TexCoordPrecision precision) const;
+};
+
+class FragmentShaderRGBATexBatchOpaque : public FragmentTexBatchBinding {
+ public:
+  std::string GetShaderString(TexCoordPrecision precision) const;
+};
+
+// Swizzles the red and blue component of sampled texel with alpha.
+class FragmentShaderRGBATexBatchSwizzleVaryingAlpha
+    : public FragmentTexBatchBinding {
+ public:
+  std::string GetShaderString(TexCoordPrecision precision) const;
+};
+
+// Swizzles the red and blue component of sampled texel without alpha.
+class FragmentShaderRGBATexBatchSwizzleOpaque
+    : public FragmentTexBatchBinding {
+ public:
+  std::string GetShaderString(TexCoordPrecision precision) const;
+};
+
 // Fragment shader for external textures.
 class FragmentShaderOESImageExternal : public FragmentTexAlphaBinding {
  public:
@@ -21,7 +21,9 @@
 #include "cc/quads/texture_draw_quad.h"
 #include "cc/quads/tile_draw_quad.h"
 #include "skia/ext/opacity_draw_filter.h"
+#include "third_party/skia/include/core/SkBlitRow.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkDevice.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -49,6 +51,17 @@ bool IsScaleAndIntegerTranslate(const SkMatrix& matrix) {
          SkScalarNearlyZero(matrix[SkMatrix::kMPersp2] - 1.0f);
 }
 
+// Returns true and sets |irect| if every edge of |rect| is nearly an integer.
+bool IsIntegerRect(const SkRect& rect, SkIRect* irect) {
+  if (!IsScalarNearlyInteger(rect.fLeft) ||
+      !IsScalarNearlyInteger(rect.fTop) ||
+      !IsScalarNearlyInteger(rect.fRight) ||
+      !IsScalarNearlyInteger(rect.fBottom))
+    return false;
+  rect.round(irect);
+  return true;
+}
+
 }  // anonymous namespace
 
 scoped_ptr<SoftwareRenderer> SoftwareRenderer::Create(
@@ -406,14 +419,86 @@ void SoftwareRenderer::DrawTileQuad(const DrawingFrame* frame,
       QuadVertexRect(), quad->rect, quad->visible_rect);
 
   SkRect uv_rect = gfx::RectFToSkRect(visible_tex_coord_rect);
+  SkRect quad_rect = gfx::RectFToSkRect(visible_quad_vertex_rect);
+  if (BlitTileQuad(quad, *lock.sk_bitmap(), uv_rect, quad_rect))
+    return;
+
   current_paint_.setFilterBitmap(true);
   current_canvas_->drawBitmapRectToRect(
       *lock.sk_bitmap(),
       &uv_rect,
-      gfx::RectFToSkRect(visible_quad_vertex_rect),
+      quad_rect,
       &current_paint_);
 }
 
+bool SoftwareRenderer::BlitTileQuad(const TileDrawQuad* quad,
+                                    const SkBitmap& source,
+                                    const SkRect& uv_rect,
+                                    const SkRect& quad_rect) {
+  // Most tiles are drawn at an integer offset with one texel per pixel. Those
+  // are copied or blended a row at a time straight into the target bitmap,
+  // skipping SkCanvas's general bitmap drawing.
+  const SkMatrix& matrix = current_canvas_->getTotalMatrix();
+  if (matrix.getType() & ~SkMatrix::kTranslate_Mask)
+    return false;
+  if (!current_canvas_->isClipRect() || current_canvas_->getDrawFilter())
+    return false;
+
+  SkRect device_rect;
+  matrix.mapRect(&device_rect, quad_rect);
+  SkIRect dest_rect;
+  SkIRect src_rect;
+  if (!IsIntegerRect(device_rect, &dest_rect) ||
+      !IsIntegerRect(uv_rect, &src_rect) ||
+      dest_rect.width() != src_rect.width() ||
+      dest_rect.height() != src_rect.height())
+    return false;
+  if (!SkIRect::MakeWH(source.width(), source.height()).contains(src_rect))
+    return false;
+
+  const SkBitmap& target = current_canvas_->getDevice()->accessBitmap(true);
+  if (source.config() != SkBitmap::kARGB_8888_Config ||
+      target.config() != SkBitmap::kARGB_8888_Config)
+    return false;
+
+  SkIRect clipped_rect = dest_rect;
+  if (!clipped_rect.intersect(current_canvas_->getTotalClip().getBounds()) ||
+      !clipped_rect.intersect(SkIRect::MakeWH(target.width(), target.height())))
+    return true;
+
+  SkAutoLockPixels source_lock(source);
+  SkAutoLockPixels target_lock(target);
+  if (!source.getPixels() || !target.getPixels())
+    return false;
+
+  const int src_x = src_rect.fLeft + clipped_rect.fLeft - dest_rect.fLeft;
+  const int src_y = src_rect.fTop + clipped_rect.fTop - dest_rect.fTop;
+  const int width = clipped_rect.width();
+  if (!quad->ShouldDrawWithBlending()) {
+    for (int y = 0; y < clipped_rect.height(); ++y) {
+      memcpy(target.getAddr32(clipped_rect.fLeft, clipped_rect.fTop + y),
+             source.getAddr32(src_x, src_y + y),
+             width * sizeof(SkPMColor));
+    }
+    return true;
+  }
+
+  // SkBlitRow picks the SSE2 or NEON version of the row blend when the CPU
+  // has one.
+  U8CPU alpha = quad->opacity() * 255;
+  unsigned flags = SkBlitRow::kSrcPixelAlpha_Flag32;
+  if (alpha < 255)
+    flags |= SkBlitRow::kGlobalAlpha_Flag32;
+  SkBlitRow::Proc32 blit_row = SkBlitRow::Factory32(flags);
+  for (int y = 0; y < clipped_rect.height(); ++y) {
+    blit_row(target.getAddr32(clipped_rect.fLeft, clipped_rect.fTop + y),
+             source.getAddr32(src_x, src_y + y),
+             width,
+             alpha);
+  }
+  return true;
+}
+
 void SoftwareRenderer::DrawRenderPassQuad(const DrawingFrame* frame,
                                           const RenderPassDrawQuad* quad) {
   ScopedResource* content_texture =
@@ -94,6 +94,14 @@ class CC_EXPORT SoftwareRenderer : public DirectRenderer {
                        const TextureDrawQuad* quad);
   void DrawTileQuad(const DrawingFrame* frame,
                     const TileDrawQuad* quad);
+  // Draws |quad| by copying or blending rows of |source| directly into the
+  // current canvas's pixels, when its transform is an integer translation and
+  // it maps one texel to one pixel. Returns false if the quad has to be drawn
+  // through the canvas instead.
+  bool BlitTileQuad(const TileDrawQuad* quad,
+                    const SkBitmap& source,
+                    const SkRect& uv_rect,
+                    const SkRect& quad_rect);
   void DrawUnsupportedQuad(const DrawingFrame* frame,
                            const DrawQuad* quad);
 
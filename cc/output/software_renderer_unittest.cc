@@ -208,6 +208,113 @@ TEST_F(SoftwareRendererTest, TileQuad) {
             output.getColor(inner_size.width() - 1, inner_size.height() - 1));
 }
 
+TEST_F(SoftwareRendererTest, TileQuadWithOpacity) {
+  gfx::Size outer_size(100, 100);
+  gfx::Size inner_size(50, 50);
+  gfx::Rect outer_rect(outer_size);
+  gfx::Rect inner_rect(gfx::Point(10, 20), inner_size);
+  set_viewport(gfx::Rect(outer_size));
+  InitializeRenderer(make_scoped_ptr(new SoftwareOutputDevice));
+
+  ResourceProvider::ResourceId resource_yellow =
+      resource_provider()->CreateResource(outer_size,
+                                          GL_CLAMP_TO_EDGE,
+                                          ResourceProvider::TextureUsageAny,
+                                          RGBA_8888);
+  ResourceProvider::ResourceId resource_cyan =
+      resource_provider()->CreateResource(inner_size,
+                                          GL_CLAMP_TO_EDGE,
+                                          ResourceProvider::TextureUsageAny,
+                                          RGBA_8888);
+
+  SkBitmap yellow_tile;
+  yellow_tile.setConfig(
+      SkBitmap::kARGB_8888_Config, outer_size.width(), outer_size.height());
+  yellow_tile.allocPixels();
+  yellow_tile.eraseColor(SK_ColorYELLOW);
+
+  SkBitmap cyan_tile;
+  cyan_tile.setConfig(
+      SkBitmap::kARGB_8888_Config, inner_size.width(), inner_size.height());
+  cyan_tile.allocPixels();
+  cyan_tile.eraseColor(SK_ColorCYAN);
+
+  resource_provider()->SetPixels(
+      resource_yellow,
+      static_cast<uint8_t*>(yellow_tile.getPixels()),
+      gfx::Rect(outer_size),
+      gfx::Rect(outer_size),
+      gfx::Vector2d());
+  resource_provider()->SetPixels(resource_cyan,
+                                 static_cast<uint8_t*>(cyan_tile.getPixels()),
+                                 gfx::Rect(inner_size),
+                                 gfx::Rect(inner_size),
+                                 gfx::Vector2d());
+
+  gfx::Rect root_rect = DeviceViewport();
+
+  scoped_ptr<SharedQuadState> opaque_quad_state = SharedQuadState::Create();
+  opaque_quad_state->SetAll(
+      gfx::Transform(), outer_size, outer_rect, outer_rect, false, 1.0);
+  scoped_ptr<SharedQuadState> translucent_quad_state =
+      SharedQuadState::Create();
+  translucent_quad_state->SetAll(
+      gfx::Transform(), outer_size, outer_rect, outer_rect, false, 0.5);
+  RenderPass::Id root_render_pass_id = RenderPass::Id(1, 1);
+  scoped_ptr<TestRenderPass> root_render_pass = TestRenderPass::Create();
+  root_render_pass->SetNew(
+      root_render_pass_id, root_rect, root_rect, gfx::Transform());
+  scoped_ptr<TileDrawQuad> outer_quad = TileDrawQuad::Create();
+  outer_quad->SetNew(opaque_quad_state.get(),
+                     outer_rect,
+                     outer_rect,
+                     resource_yellow,
+                     gfx::RectF(outer_size),
+                     outer_size,
+                     false);
+  scoped_ptr<TileDrawQuad> inner_quad = TileDrawQuad::Create();
+  inner_quad->SetNew(translucent_quad_state.get(),
+                     inner_rect,
+                     inner_rect,
+                     resource_cyan,
+                     gfx::RectF(inner_size),
+                     inner_size,
+                     false);
+  root_render_pass->AppendQuad(inner_quad.PassAs<DrawQuad>());
+  root_render_pass->AppendQuad(outer_quad.PassAs<DrawQuad>());
+
+  RenderPassList list;
+  list.push_back(root_render_pass.PassAs<RenderPass>());
+
+  float device_scale_factor = 1.f;
+  renderer()->DrawFrame(&list, NULL, device_scale_factor, true, false);
+
+  SkBitmap output;
+  output.setConfig(SkBitmap::kARGB_8888_Config,
+                   DeviceViewport().width(),
+                   DeviceViewport().height());
+  output.allocPixels();
+  renderer()->GetFramebufferPixels(output.getPixels(), outer_rect);
+
+  EXPECT_EQ(SK_ColorYELLOW, output.getColor(0, 0));
+  EXPECT_EQ(SK_ColorYELLOW,
+            output.getColor(inner_rect.x() - 1, inner_rect.y() - 1));
+  EXPECT_EQ(SK_ColorYELLOW,
+            output.getColor(inner_rect.right(), inner_rect.bottom()));
+
+  // Half of the cyan tile blended over the yellow one.
+  SkColor corners[] = {
+    output.getColor(inner_rect.x(), inner_rect.y()),
+    output.getColor(inner_rect.right() - 1, inner_rect.bottom() - 1)
+  };
+  for (size_t i = 0; i < arraysize(corners); ++i) {
+    EXPECT_EQ(255u, SkColorGetA(corners[i]));
+    EXPECT_NEAR(128, static_cast<int>(SkColorGetR(corners[i])), 2);
+    EXPECT_EQ(255u, SkColorGetG(corners[i]));
+    EXPECT_NEAR(128, static_cast<int>(SkColorGetB(corners[i])), 2);
+  }
+}
+
 TEST_F(SoftwareRendererTest, TileQuadVisibleRect) {
   gfx::Size tile_size(100, 100);
   gfx::Rect tile_rect(tile_size);
@@ -0,0 +1,252 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/resources/gpu_raster_worker_pool.h"
+
+#include "base/debug/trace_event.h"
+#include "base/values.h"
+#include "cc/debug/traced_value.h"
+#include "cc/output/context_provider.h"
+#include "cc/resources/resource.h"
+#include "skia/ext/refptr.h"
+#include "third_party/WebKit/public/platform/WebGraphicsContext3D.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/gpu/GrContext.h"
+#include "third_party/skia/include/gpu/GrTexture.h"
+#include "third_party/skia/include/gpu/SkGpuDevice.h"
+
+namespace cc {
+
+namespace {
+
+class GpuAnalysisWorkerPoolTaskImpl : public internal::WorkerPoolTask {
+ public:
+  typedef base::Callback<void(bool was_canceled)> Reply;
+
+  GpuAnalysisWorkerPoolTaskImpl(internal::RasterWorkerPoolTask* task,
+                                const Reply& reply)
+      : task_(task),
+        reply_(reply) {
+  }
+
+  // Overridden from internal::WorkerPoolTask:
+  virtual void RunOnWorkerThread(unsigned thread_index) OVERRIDE {
+    TRACE_EVENT0("cc", "GpuAnalysisWorkerPoolTaskImpl::RunOnWorkerThread");
+    task_->RunAnalysisOnWorkerThread(thread_index);
+  }
+  virtual void CompleteOnOriginThread() OVERRIDE {
+    reply_.Run(!HasFinishedRunning());
+  }
+
+ private:
+  virtual ~GpuAnalysisWorkerPoolTaskImpl() {}
+
+  scoped_refptr<internal::RasterWorkerPoolTask> task_;
+  const Reply reply_;
+
+  DISALLOW_COPY_AND_ASSIGN(GpuAnalysisWorkerPoolTaskImpl);
+};
+
+}  // namespace
+
+GpuRasterWorkerPool::GpuRasterWorkerPool(
+    ResourceProvider* resource_provider,
+    ContextProvider* context_provider,
+    size_t num_threads)
+    : RasterWorkerPool(resource_provider, num_threads),
+      context_provider_(context_provider),
+      raster_tasks_pending_(false),
+      raster_tasks_required_for_activation_pending_(false) {
+  DCHECK(context_provider_.get());
+}
+
+GpuRasterWorkerPool::~GpuRasterWorkerPool() {
+  DCHECK_EQ(0u, analysis_tasks_.size());
+}
+
+void GpuRasterWorkerPool::ScheduleTasks(RasterTask::Queue* queue) {
+  TRACE_EVENT0("cc", "GpuRasterWorkerPool::ScheduleTasks");
+
+  RasterWorkerPool::SetRasterTasks(queue);
+
+  if (!raster_tasks_pending_)
+    TRACE_EVENT_ASYNC_BEGIN0("cc", "ScheduledTasks", this);
+
+  raster_tasks_pending_ = true;
+  raster_tasks_required_for_activation_pending_ = true;
+
+  unsigned priority = 0u;
+  TaskGraph graph;
+
+  scoped_refptr<internal::WorkerPoolTask>
+      new_raster_required_for_activation_finished_task(
+          CreateRasterRequiredForActivationFinishedTask());
+  internal::GraphNode* raster_required_for_activation_finished_node =
+      CreateGraphNodeForTask(
+          new_raster_required_for_activation_finished_task.get(),
+          priority++,
+          &graph);
+
+  scoped_refptr<internal::WorkerPoolTask> new_raster_finished_task(
+      CreateRasterFinishedTask());
+  internal::GraphNode* raster_finished_node =
+      CreateGraphNodeForTask(new_raster_finished_task.get(),
+                             priority++,
+                             &graph);
+
+  for (RasterTaskVector::const_iterator it = raster_tasks().begin();
+       it != raster_tasks().end(); ++it) {
+    internal::RasterWorkerPoolTask* task = it->get();
+    DCHECK(!task->HasCompleted());
+    DCHECK(!task->WasCanceled());
+
+    scoped_refptr<internal::WorkerPoolTask> analysis_task;
+    TaskMap::iterator analysis_it = analysis_tasks_.find(task);
+    if (analysis_it != analysis_tasks_.end()) {
+      analysis_task = analysis_it->second;
+    } else {
+      analysis_task = new GpuAnalysisWorkerPoolTaskImpl(
+          task,
+          base::Bind(&GpuRasterWorkerPool::OnRasterTaskCompleted,
+                     base::Unretained(this),
+                     make_scoped_refptr(task)));
+      analysis_tasks_[task] = analysis_task;
+    }
+
+    internal::GraphNode* analysis_node =
+        CreateGraphNodeForRasterTask(analysis_task.get(),
+                                     task->dependencies(),
+                                     priority++,
+                                     &graph);
+
+    if (IsRasterTaskRequiredForActivation(task)) {
+      raster_required_for_activation_finished_node->add_dependency();
+      analysis_node->add_dependent(
+          raster_required_for_activation_finished_node);
+    }
+
+    raster_finished_node->add_dependency();
+    analysis_node->add_dependent(raster_finished_node);
+  }
+
+  SetTaskGraph(&graph);
+
+  set_raster_finished_task(new_raster_finished_task);
+  set_raster_required_for_activation_finished_task(
+      new_raster_required_for_activation_finished_task);
+
+  TRACE_EVENT_ASYNC_STEP_INTO1(
+      "cc", "ScheduledTasks", this, "rasterizing",
+      "state", TracedValue::FromValue(StateAsValue().release()));
+}
+
+ResourceFormat GpuRasterWorkerPool::GetResourceFormat() const {
+  // Ganesh renders into kSkia8888_GrPixelConfig textures.
+  return RGBA_8888;
+}
+
+void GpuRasterWorkerPool::SetOffscreenContextProvider(
+    ContextProvider* offscreen_context_provider) {
+  offscreen_context_provider_ = offscreen_context_provider;
+}
+
+void GpuRasterWorkerPool::OnRasterTasksFinished() {
+  DCHECK(raster_tasks_pending_);
+  raster_tasks_pending_ = false;
+  TRACE_EVENT_ASYNC_END0("cc", "ScheduledTasks", this);
+  client()->DidFinishRunningTasks();
+}
+
+void GpuRasterWorkerPool::OnRasterTasksRequiredForActivationFinished() {
+  DCHECK(raster_tasks_required_for_activation_pending_);
+  raster_tasks_required_for_activation_pending_ = false;
+  TRACE_EVENT_ASYNC_STEP_INTO1(
+      "cc", "ScheduledTasks", this, "rasterizing",
+      "state", TracedValue::FromValue(StateAsValue().release()));
+  client()->DidFinishRunningTasksRequiredForActivation();
+}
+
+void GpuRasterWorkerPool::OnRasterTaskCompleted(
+    scoped_refptr<internal::RasterWorkerPoolTask> task,
+    bool was_canceled) {
+  TRACE_EVENT1("cc", "GpuRasterWorkerPool::OnRasterTaskCompleted",
+               "was_canceled", was_canceled);
+
+  DCHECK(analysis_tasks_.find(task.get()) != analysis_tasks_.end());
+
+  // A task which could not be rasterized is reported as canceled, so that
+  // its tile is scheduled again instead of showing an unrasterized texture.
+  bool did_run = !was_canceled && RasterTaskOnOriginThread(task.get());
+
+  task->DidRun(!did_run);
+  task->WillComplete();
+  task->CompleteOnOriginThread();
+  task->DidComplete();
+
+  analysis_tasks_.erase(task.get());
+}
+
+bool GpuRasterWorkerPool::RasterTaskOnOriginThread(
+    internal::RasterWorkerPoolTask* task) {
+  TRACE_EVENT0("cc", "GpuRasterWorkerPool::RasterTaskOnOriginThread");
+
+  // There is nothing to rasterize with until there is an offscreen context,
+  // or after it has been lost.
+  if (!offscreen_context_provider_.get())
+    return false;
+  GrContext* gr_context = offscreen_context_provider_->GrContext();
+  if (!gr_context)
+    return false;
+
+  ResourceProvider::ScopedWriteLockGL lock(resource_provider(),
+                                           task->resource()->id());
+
+  // Flush the compositor context so that the texture is available in the
+  // offscreen context. Do this after locking, which creates the texture.
+  resource_provider()->Flush();
+
+  // Make sure skia uses the offscreen context.
+  offscreen_context_provider_->Context3d()->makeContextCurrent();
+
+  // Wrap the texture in a Ganesh render target.
+  GrBackendTextureDesc desc;
+  desc.fFlags = kRenderTarget_GrBackendTextureFlag;
+  desc.fWidth = task->resource()->size().width();
+  desc.fHeight = task->resource()->size().height();
+  desc.fConfig = kSkia8888_GrPixelConfig;
+  desc.fOrigin = kTopLeft_GrSurfaceOrigin;
+  desc.fTextureHandle = lock.texture_id();
+  skia::RefPtr<GrTexture> texture =
+      skia::AdoptRef(gr_context->wrapBackendTexture(desc));
+  bool did_raster = false;
+  if (texture) {
+    SkGpuDevice device(gr_context, texture.get());
+    SkCanvas canvas(&device);
+    task->RunRasterOnOriginThread(&canvas);
+    did_raster = true;
+
+    // Flush skia context so that all the rendered stuff appears on the
+    // texture.
+    gr_context->flush();
+  }
+
+  // Flush the GL context so rendering results from this context are
+  // visible in the compositor's context.
+  offscreen_context_provider_->Context3d()->flush();
+
+  // Use the compositor's GL context again.
+  context_provider_->Context3d()->makeContextCurrent();
+  return did_raster;
+}
+
+scoped_ptr<base::Value> GpuRasterWorkerPool::StateAsValue() const {
+  scoped_ptr<base::DictionaryValue> state(new base::DictionaryValue);
+
+  state->SetBoolean("tasks_required_for_activation_pending",
+                    raster_tasks_required_for_activation_pending_);
+  state->Set("scheduled_state", ScheduledStateAsValue().release());
+  return state.PassAs<base::Value>();
+}
+
+}  // namespace cc
@@ -0,0 +1,65 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_RESOURCES_GPU_RASTER_WORKER_POOL_H_
+#define CC_RESOURCES_GPU_RASTER_WORKER_POOL_H_
+
+#include "cc/resources/raster_worker_pool.h"
+
+namespace cc {
+class ContextProvider;
+
+// A raster worker pool that rasterizes tiles with Ganesh directly into their
+// textures. Analysis runs on the worker threads but rasterization runs on
+// the origin thread, so there is no intermediate bitmap and no upload. Like
+// filters, Ganesh draws with the offscreen context, which shares resources
+// with the compositor's |context_provider|. Raster tasks are canceled while
+// there is no offscreen context.
+class CC_EXPORT GpuRasterWorkerPool : public RasterWorkerPool {
+ public:
+  virtual ~GpuRasterWorkerPool();
+
+  static scoped_ptr<RasterWorkerPool> Create(
+      ResourceProvider* resource_provider,
+      ContextProvider* context_provider,
+      size_t num_threads) {
+    return make_scoped_ptr<RasterWorkerPool>(
+        new GpuRasterWorkerPool(resource_provider,
+                                context_provider,
+                                num_threads));
+  }
+
+  // Overridden from RasterWorkerPool:
+  virtual void ScheduleTasks(RasterTask::Queue* queue) OVERRIDE;
+  virtual ResourceFormat GetResourceFormat() const OVERRIDE;
+  virtual void SetOffscreenContextProvider(
+      ContextProvider* offscreen_context_provider) OVERRIDE;
+  virtual void OnRasterTasksFinished() OVERRIDE;
+  virtual void OnRasterTasksRequiredForActivationFinished() OVERRIDE;
+
+ private:
+  GpuRasterWorkerPool(ResourceProvider* resource_provider,
+                      ContextProvider* context_provider,
+                      size_t num_threads);
+
+  void OnRasterTaskCompleted(
+      scoped_refptr<internal::RasterWorkerPoolTask> task, bool was_canceled);
+  // Returns false if |task| could not be rasterized.
+  bool RasterTaskOnOriginThread(internal::RasterWorkerPoolTask* task);
+
+  scoped_ptr<base::Value> StateAsValue() const;
+
+  scoped_refptr<ContextProvider> context_provider_;
+  scoped_refptr<ContextProvider> offscreen_context_provider_;
+  TaskMap analysis_tasks_;
+
+  bool raster_tasks_pending_;
+  bool raster_tasks_required_for_activation_pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(GpuRasterWorkerPool);
+};
+
+}  // namespace cc
+
+#endif  // CC_RESOURCES_GPU_RASTER_WORKER_POOL_H_
@@ -53,7 +53,9 @@ ManagedTileState::ManagedTileState()
       time_to_needed_in_seconds(std::numeric_limits<float>::infinity()),
       distance_to_visible_in_pixels(std::numeric_limits<float>::infinity()),
       visible_and_ready_to_draw(false),
-      scheduled_priority(0) {
+      scheduled_priority(0),
+      counts_as_memory_required(false),
+      counts_as_memory_nice_to_have(false) {
 }
 
 ManagedTileState::TileVersion::TileVersion()
@@ -134,6 +134,11 @@ class CC_EXPORT ManagedTileState {
 
   // Priority for this state from the last time we assigned memory.
   unsigned scheduled_priority;
+
+  // Whether the tile's memory is counted in the memory required and nice to
+  // have totals reported by TileManager.
+  bool counts_as_memory_required;
+  bool counts_as_memory_nice_to_have;
 };
 
 }  // namespace cc
@@ -11,6 +11,8 @@
 #include "cc/base/region.h"
 #include "cc/debug/rendering_stats_instrumentation.h"
 #include "cc/resources/picture_pile_impl.h"
+#include "skia/ext/analysis_canvas.h"
+#include "ui/gfx/skia_util.h"
 
 namespace {
 // Layout pixel buffer around the visible layer rect to record.  Any base
@@ -21,6 +23,30 @@ const int kPixelDistanceToRecord = 8000;
 
 namespace cc {
 
+namespace {
+
+// Plays |picture| back over |layer_rect| at scale 1 and returns true if it
+// paints a single color (possibly transparent) there. This is the same
+// analysis a raster task does before rasterizing a tile.
+bool IsSolidColorInRect(Picture* picture,
+                        gfx::Rect layer_rect,
+                        SkColor* color) {
+  SkBitmap empty_bitmap;
+  empty_bitmap.setConfig(SkBitmap::kNo_Config,
+                         layer_rect.width(),
+                         layer_rect.height());
+  skia::AnalysisDevice device(empty_bitmap);
+  skia::AnalysisCanvas canvas(&device);
+
+  canvas.translate(-layer_rect.x(), -layer_rect.y());
+  canvas.clipRect(gfx::RectToSkRect(layer_rect), SkRegion::kIntersect_Op);
+  picture->Raster(&canvas, &canvas, Region(), 1.f);
+
+  return canvas.GetColorIfSolid(color);
+}
+
+}  // namespace
+
 PicturePile::PicturePile() {
 }
 
@@ -106,6 +132,12 @@ bool PicturePile::Update(
     if (record_rect.Contains(tile)) {
       PictureInfo& info = picture_map_[key];
       info.picture = picture;
+      // Analyze the tile's bounds now so that the TileManager can create
+      // solid color tiles there without ever scheduling a raster task.
+      info.is_solid_color = IsSolidColorInRect(
+          picture.get(),
+          tiling_.TileBounds(key.first, key.second),
+          &info.solid_color);
     }
   }
 
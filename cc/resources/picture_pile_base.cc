@@ -209,7 +209,9 @@ scoped_ptr<base::Value> PicturePileBase::AsValue() const {
   return pictures.PassAs<base::Value>();
 }
 
-PicturePileBase::PictureInfo::PictureInfo() {}
+PicturePileBase::PictureInfo::PictureInfo()
+    : is_solid_color(false),
+      solid_color(SK_ColorTRANSPARENT) {}
 
 PicturePileBase::PictureInfo::~PictureInfo() {}
 
@@ -217,6 +219,7 @@ bool PicturePileBase::PictureInfo::Invalidate() {
   if (!picture.get())
     return false;
   picture = NULL;
+  is_solid_color = false;
   return true;
 }
 
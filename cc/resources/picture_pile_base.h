@@ -55,6 +55,10 @@ class CC_EXPORT PicturePileBase : public base::RefCounted<PicturePileBase> {
     PictureInfo CloneForThread(int thread_index) const;
 
     scoped_refptr<Picture> picture;
+    // Set when |picture| was analyzed at record time and found to paint a
+    // single color over this tile's bounds. Cleared on invalidation.
+    bool is_solid_color;
+    SkColor solid_color;
   };
 
   typedef std::pair<int, int> PictureMapKey;
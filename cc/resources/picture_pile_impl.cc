@@ -321,6 +321,36 @@ void PicturePileImpl::AnalyzeInRect(gfx::Rect content_rect,
   analysis->has_text = canvas.HasText();
 }
 
+bool PicturePileImpl::GetSolidColorFromRecording(gfx::Rect content_rect,
+                                                 float contents_scale,
+                                                 SkColor* color) const {
+  DCHECK(color);
+
+  gfx::Rect layer_rect = gfx::ScaleToEnclosingRect(
+      content_rect, 1.0f / contents_scale);
+
+  layer_rect.Intersect(gfx::Rect(tiling_.total_size()));
+  if (layer_rect.IsEmpty())
+    return false;
+
+  bool found_color = false;
+  for (TilingData::Iterator tile_iter(&tiling_, layer_rect);
+       tile_iter; ++tile_iter) {
+    PictureMap::const_iterator map_iter =
+        picture_map_.find(tile_iter.index());
+    if (map_iter == picture_map_.end())
+      return false;
+    const PictureInfo& info = map_iter->second;
+    if (!info.picture.get() || !info.is_solid_color)
+      return false;
+    if (found_color && info.solid_color != *color)
+      return false;
+    *color = info.solid_color;
+    found_color = true;
+  }
+  return found_color;
+}
+
 PicturePileImpl::Analysis::Analysis()
     : is_solid_color(false),
       has_text(false) {
@@ -75,6 +75,15 @@ class CC_EXPORT PicturePileImpl : public PicturePileBase {
                      float contents_scale,
                      Analysis* analysis);
 
+  // Returns true and sets |color| if the analysis done when the pictures
+  // were recorded shows |content_rect| to be a single color. Unlike
+  // AnalyzeInRect() this doesn't play anything back, so it is cheap enough
+  // to call on the compositor thread. A false result means the content
+  // still has to be analyzed or rasterized.
+  bool GetSolidColorFromRecording(gfx::Rect content_rect,
+                                  float contents_scale,
+                                  SkColor* color) const;
+
   class CC_EXPORT PixelRefIterator {
    public:
     PixelRefIterator(gfx::Rect content_rect,
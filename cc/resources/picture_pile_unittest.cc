@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "cc/resources/picture_pile.h"
+#include "cc/resources/picture_pile_impl.h"
 #include "cc/test/fake_content_layer_client.h"
 #include "cc/test/fake_rendering_stats_instrumentation.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -178,5 +179,83 @@ TEST(PicturePileTest, InvalidateOnTileBoundaryInflated) {
   }
 }
 
+TEST(PicturePileTest, SolidColorAnalyzedWhenRecorded) {
+  FakeContentLayerClient client;
+  FakeRenderingStatsInstrumentation stats_instrumentation;
+  scoped_refptr<TestPicturePile> pile = new TestPicturePile;
+  SkColor background_color = SK_ColorBLUE;
+
+  float min_scale = 0.125;
+  gfx::Size base_picture_size = pile->tiling().max_texture_size();
+
+  gfx::Size layer_size =
+      gfx::ToFlooredSize(gfx::ScaleSize(base_picture_size, 2.f));
+  pile->Resize(layer_size);
+  pile->SetTileGridSize(gfx::Size(1000, 1000));
+  pile->SetMinContentsScale(min_scale);
+  EXPECT_EQ(3, pile->tiling().num_tiles_x());
+  EXPECT_EQ(3, pile->tiling().num_tiles_y());
+
+  SkPaint red_paint;
+  red_paint.setColor(SK_ColorRED);
+  client.add_draw_rect(gfx::Rect(layer_size), red_paint);
+
+  pile->Update(&client,
+               background_color,
+               false,
+               gfx::Rect(layer_size),
+               gfx::Rect(layer_size),
+               &stats_instrumentation);
+
+  for (int i = 0; i < pile->tiling().num_tiles_x(); ++i) {
+    for (int j = 0; j < pile->tiling().num_tiles_y(); ++j) {
+      TestPicturePile::PictureInfo& picture_info =
+          pile->picture_map().find(
+              TestPicturePile::PictureMapKey(i, j))->second;
+      EXPECT_TRUE(picture_info.is_solid_color);
+      EXPECT_EQ(SK_ColorRED, picture_info.solid_color);
+    }
+  }
+
+  SkColor color = SK_ColorTRANSPARENT;
+  scoped_refptr<PicturePileImpl> pile_impl =
+      PicturePileImpl::CreateFromOther(pile.get());
+  EXPECT_TRUE(pile_impl->GetSolidColorFromRecording(
+      gfx::Rect(layer_size), 1.f, &color));
+  EXPECT_EQ(SK_ColorRED, color);
+
+  // Paint something else in the middle of the last tile.
+  gfx::Rect last_tile_bounds = pile->tiling().TileBounds(2, 2);
+  gfx::Rect blue_rect(last_tile_bounds.CenterPoint(), gfx::Size(10, 10));
+  SkPaint blue_paint;
+  blue_paint.setColor(SK_ColorBLUE);
+  client.add_draw_rect(blue_rect, blue_paint);
+
+  pile->Update(&client,
+               background_color,
+               false,
+               blue_rect,
+               gfx::Rect(layer_size),
+               &stats_instrumentation);
+
+  TestPicturePile::PictureInfo& last_picture_info =
+      pile->picture_map().find(TestPicturePile::PictureMapKey(2, 2))->second;
+  EXPECT_TRUE(!!last_picture_info.picture.get());
+  EXPECT_FALSE(last_picture_info.is_solid_color);
+
+  pile_impl = PicturePileImpl::CreateFromOther(pile.get());
+  EXPECT_FALSE(pile_impl->GetSolidColorFromRecording(
+      gfx::Rect(layer_size), 1.f, &color));
+  EXPECT_FALSE(pile_impl->GetSolidColorFromRecording(
+      gfx::ScaleToEnclosingRect(last_tile_bounds, 2.f), 2.f, &color));
+
+  color = SK_ColorTRANSPARENT;
+  EXPECT_TRUE(pile_impl->GetSolidColorFromRecording(
+      gfx::ScaleToEnclosingRect(pile->tiling().TileBounds(0, 0), 2.f),
+      2.f,
+      &color));
+  EXPECT_EQ(SK_ColorRED, color);
+}
+
 }  // namespace
 }  // namespace cc
@@ -221,6 +221,15 @@ ResourceFormat PixelBufferRasterWorkerPool::GetResourceFormat() const {
   return resource_provider()->memory_efficient_texture_format();
 }
 
+ResourceFormat
+    PixelBufferRasterWorkerPool::GetMemoryEfficientResourceFormat() const {
+  // Bitmap resources only support RGBA_8888.
+  if (resource_provider()->default_resource_type() !=
+      ResourceProvider::GLTexture)
+    return GetResourceFormat();
+  return RGBA_4444;
+}
+
 void PixelBufferRasterWorkerPool::CheckForCompletedTasks() {
   TRACE_EVENT0("cc", "PixelBufferRasterWorkerPool::CheckForCompletedTasks");
 
@@ -35,6 +35,7 @@ class CC_EXPORT PixelBufferRasterWorkerPool : public RasterWorkerPool {
   // Overridden from RasterWorkerPool:
   virtual void ScheduleTasks(RasterTask::Queue* queue) OVERRIDE;
   virtual ResourceFormat GetResourceFormat() const OVERRIDE;
+  virtual ResourceFormat GetMemoryEfficientResourceFormat() const OVERRIDE;
   virtual void OnRasterTasksFinished() OVERRIDE;
   virtual void OnRasterTasksRequiredForActivationFinished() OVERRIDE;
 
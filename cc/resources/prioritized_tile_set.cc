@@ -45,49 +45,99 @@ namespace {
 
 typedef std::vector<Tile*> TileVector;
 
-void SortBinTiles(ManagedTileBin bin, TileVector* tiles) {
+bool BinNeedsSorting(ManagedTileBin bin) {
   switch (bin) {
     case NOW_AND_READY_TO_DRAW_BIN:
     case NEVER_BIN:
-      break;
+      return false;
     case NOW_BIN:
     case SOON_BIN:
     case EVENTUALLY_AND_ACTIVE_BIN:
     case EVENTUALLY_BIN:
     case AT_LAST_AND_ACTIVE_BIN:
     case AT_LAST_BIN:
-      std::sort(tiles->begin(), tiles->end(), BinComparator());
-      break;
+      return true;
     default:
       NOTREACHED();
+      return false;
   }
 }
 
 }  // namespace
 
 PrioritizedTileSet::PrioritizedTileSet() {
-  for (int bin = 0; bin < NUM_BINS; ++bin)
-    bin_sorted_[bin] = true;
+  for (int bin = 0; bin < NUM_BINS; ++bin) {
+    sorted_count_[bin] = 0;
+    removed_count_[bin] = 0;
+  }
 }
 
 PrioritizedTileSet::~PrioritizedTileSet() {}
 
 void PrioritizedTileSet::InsertTile(Tile* tile, ManagedTileBin bin) {
+  Position position = { bin, tiles_[bin].size() };
+  positions_[tile] = position;
   tiles_[bin].push_back(tile);
-  bin_sorted_[bin] = false;
+}
+
+void PrioritizedTileSet::RemoveTile(Tile* tile) {
+  PositionMap::iterator it = positions_.find(tile);
+  if (it == positions_.end())
+    return;
+
+  ManagedTileBin bin = it->second.bin;
+  DCHECK(tiles_[bin][it->second.index] == tile);
+  tiles_[bin][it->second.index] = NULL;
+  ++removed_count_[bin];
+  positions_.erase(it);
 }
 
 void PrioritizedTileSet::Clear() {
   for (int bin = 0; bin < NUM_BINS; ++bin) {
     tiles_[bin].clear();
-    bin_sorted_[bin] = true;
+    sorted_count_[bin] = 0;
+    removed_count_[bin] = 0;
   }
+  positions_.clear();
 }
 
-void PrioritizedTileSet::SortBinIfNeeded(ManagedTileBin bin) {
-  if (!bin_sorted_[bin]) {
-    SortBinTiles(bin, &tiles_[bin]);
-    bin_sorted_[bin] = true;
+void PrioritizedTileSet::PrepareBin(ManagedTileBin bin, bool sort) {
+  TileVector& tiles = tiles_[bin];
+
+  // Tiles from |first_moved_index| on have a new index.
+  size_t first_moved_index = tiles.size();
+
+  if (removed_count_[bin]) {
+    TileVector::iterator sorted_end = tiles.begin() + sorted_count_[bin];
+    sorted_count_[bin] -=
+        std::count(tiles.begin(), sorted_end, static_cast<Tile*>(NULL));
+    first_moved_index =
+        std::find(tiles.begin(), tiles.end(), static_cast<Tile*>(NULL)) -
+        tiles.begin();
+    tiles.erase(
+        std::remove(tiles.begin(), tiles.end(), static_cast<Tile*>(NULL)),
+        tiles.end());
+    removed_count_[bin] = 0;
+  }
+
+  if (sort && sorted_count_[bin] < tiles.size()) {
+    if (BinNeedsSorting(bin)) {
+      TileVector::iterator sorted_end = tiles.begin() + sorted_count_[bin];
+      std::sort(sorted_end, tiles.end(), BinComparator());
+      // Only the sorted tiles that go after the first new one move.
+      TileVector::iterator first_moved = std::upper_bound(
+          tiles.begin(), sorted_end, *sorted_end, BinComparator());
+      first_moved_index = std::min<size_t>(first_moved_index,
+                                           first_moved - tiles.begin());
+      std::inplace_merge(tiles.begin(), sorted_end, tiles.end(),
+                         BinComparator());
+    }
+    sorted_count_[bin] = tiles.size();
+  }
+
+  for (size_t i = first_moved_index; i < tiles.size(); ++i) {
+    Position position = { bin, i };
+    positions_[tiles[i]] = position;
   }
 }
 
@@ -96,8 +146,7 @@ PrioritizedTileSet::Iterator::Iterator(
     : tile_set_(tile_set),
       current_bin_(NOW_AND_READY_TO_DRAW_BIN),
       use_priority_ordering_(use_priority_ordering) {
-  if (use_priority_ordering_)
-    tile_set_->SortBinIfNeeded(current_bin_);
+  tile_set_->PrepareBin(current_bin_, use_priority_ordering_);
   iterator_ = tile_set->tiles_[current_bin_].begin();
   if (iterator_ == tile_set_->tiles_[current_bin_].end())
     AdvanceList();
@@ -131,8 +180,7 @@ void PrioritizedTileSet::Iterator::AdvanceList() {
   while (current_bin_ != NEVER_BIN) {
     current_bin_ = static_cast<ManagedTileBin>(current_bin_ + 1);
 
-    if (use_priority_ordering_)
-      tile_set_->SortBinIfNeeded(current_bin_);
+    tile_set_->PrepareBin(current_bin_, use_priority_ordering_);
 
     iterator_ = tile_set_->tiles_[current_bin_].begin();
     if (iterator_ != tile_set_->tiles_[current_bin_].end())
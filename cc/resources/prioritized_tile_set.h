@@ -7,11 +7,25 @@
 
 #include <vector>
 
+#include "base/containers/hash_tables.h"
 #include "cc/base/cc_export.h"
 #include "cc/resources/managed_tile_state.h"
 
 namespace cc {
 class Tile;
+}
+
+#if defined(COMPILER_GCC)
+namespace BASE_HASH_NAMESPACE {
+template <> struct hash<cc::Tile*> {
+  size_t operator()(cc::Tile* ptr) const {
+    return hash<size_t>()(reinterpret_cast<size_t>(ptr));
+  }
+};
+}  // namespace BASE_HASH_NAMESPACE
+#endif  // COMPILER
+
+namespace cc {
 
 class CC_EXPORT PrioritizedTileSet {
  public:
@@ -19,6 +33,9 @@ class CC_EXPORT PrioritizedTileSet {
   ~PrioritizedTileSet();
 
   void InsertTile(Tile* tile, ManagedTileBin bin);
+  // Removes |tile| if it is in the set. Only a tile that was inserted into a
+  // single bin can be removed.
+  void RemoveTile(Tile* tile);
   void Clear();
 
   class CC_EXPORT Iterator {
@@ -48,10 +65,22 @@ class CC_EXPORT PrioritizedTileSet {
  private:
   friend class Iterator;
 
-  void SortBinIfNeeded(ManagedTileBin bin);
+  struct Position {
+    ManagedTileBin bin;
+    size_t index;
+  };
+  typedef base::hash_map<Tile*, Position> PositionMap;
+
+  // Drops the tiles removed from |bin| and, if |sort| is true, merges the
+  // tiles inserted since the bin was last sorted into the sorted ones.
+  void PrepareBin(ManagedTileBin bin, bool sort);
 
+  // Removed tiles leave a NULL behind until their bin is next iterated. The
+  // first |sorted_count_| tiles of a bin are sorted.
   std::vector<Tile*> tiles_[NUM_BINS];
-  bool bin_sorted_[NUM_BINS];
+  size_t sorted_count_[NUM_BINS];
+  size_t removed_count_[NUM_BINS];
+  PositionMap positions_;
 };
 
 }  // namespace cc
@@ -68,9 +68,13 @@ class PrioritizedTileSetTest : public testing::Test {
   }
 
   scoped_refptr<Tile> CreateTile() {
+    return CreateTileWithContentRect(gfx::Rect());
+  }
+
+  scoped_refptr<Tile> CreateTileWithContentRect(gfx::Rect content_rect) {
     return tile_manager_->CreateTile(picture_pile_.get(),
                                      settings_.default_tile_size,
-                                     gfx::Rect(),
+                                     content_rect,
                                      gfx::Rect(),
                                      1.0,
                                      0,
@@ -637,6 +641,57 @@ TEST_F(PrioritizedTileSetTest, ManyTilesForEachBinDisablePriority) {
   EXPECT_FALSE(it);
 }
 
+TEST_F(PrioritizedTileSetTest, RemoveAndInsertAfterSorting) {
+  // Ensure that removed tiles don't appear, and that tiles inserted after a
+  // bin was sorted are merged into it in BinComparator order.
+
+  std::vector<scoped_refptr<Tile> > tiles;
+  for (int i = 0; i < 10; ++i)
+    tiles.push_back(CreateTileWithContentRect(gfx::Rect(0, 10 * i, 10, 10)));
+
+  PrioritizedTileSet set;
+  for (int i = 0; i < 10; i += 2)
+    set.InsertTile(tiles[i], SOON_BIN);
+
+  // Sort the bin.
+  {
+    PrioritizedTileSet::Iterator it(&set, true);
+    EXPECT_TRUE(*it == tiles[0].get());
+  }
+
+  set.RemoveTile(tiles[4]);
+  // Removing a tile that isn't in the set does nothing.
+  set.RemoveTile(tiles[5]);
+  for (int i = 9; i > 0; i -= 2)
+    set.InsertTile(tiles[i], SOON_BIN);
+
+  int expected = 0;
+  for (PrioritizedTileSet::Iterator it(&set, true); it; ++it) {
+    if (expected == 4)
+      ++expected;
+    EXPECT_TRUE(*it == tiles[expected].get());
+    ++expected;
+  }
+  EXPECT_EQ(10, expected);
+
+  // Moving a tile to another bin takes it out of the first one.
+  set.RemoveTile(tiles[0]);
+  set.InsertTile(tiles[0], AT_LAST_BIN);
+
+  expected = 1;
+  PrioritizedTileSet::Iterator it(&set, true);
+  for (; it && *it != tiles[0].get(); ++it) {
+    if (expected == 4)
+      ++expected;
+    EXPECT_TRUE(*it == tiles[expected].get());
+    ++expected;
+  }
+  EXPECT_EQ(10, expected);
+  EXPECT_TRUE(it);
+  ++it;
+  EXPECT_FALSE(it);
+}
+
 TEST_F(PrioritizedTileSetTest, TilesForFirstAndLastBins) {
   // Make sure that if we have empty lists between two non-empty lists,
   // we just get two tiles from the iterator.
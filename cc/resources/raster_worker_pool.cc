@@ -147,6 +147,62 @@ class RasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
 
     SkBitmapDevice device(bitmap);
     SkCanvas canvas(&device);
+    Raster(picture_clone, &canvas);
+
+    ChangeBitmapConfigIfNeeded(bitmap, buffer);
+
+    return true;
+  }
+
+  // Overridden from internal::RasterWorkerPoolTask:
+  virtual bool RunOnWorkerThread(unsigned thread_index,
+                                 void* buffer,
+                                 gfx::Size size,
+                                 int stride)
+      OVERRIDE {
+    RunAnalysisOnThread(thread_index);
+    return RunRasterOnThread(thread_index, buffer, size, stride);
+  }
+  virtual void RunAnalysisOnWorkerThread(unsigned thread_index) OVERRIDE {
+    RunAnalysisOnThread(thread_index);
+  }
+  virtual bool RunRasterOnOriginThread(SkCanvas* canvas) OVERRIDE {
+    TRACE_EVENT2(
+        "cc", "RasterWorkerPoolTaskImpl::RunRasterOnOriginThread",
+        "data",
+        TracedValue::FromValue(DataAsValue().release()),
+        "raster_mode",
+        TracedValue::FromValue(RasterModeAsValue(raster_mode_).release()));
+
+    devtools_instrumentation::ScopedLayerTask raster_task(
+        devtools_instrumentation::kRasterTask, layer_id_);
+
+    DCHECK(picture_pile_.get());
+
+    if (analysis_.is_solid_color)
+      return false;
+
+    Raster(picture_pile_.get(), canvas);
+    return true;
+  }
+  virtual void CompleteOnOriginThread() OVERRIDE {
+    reply_.Run(analysis_, !HasFinishedRunning() || WasCanceled());
+  }
+
+ protected:
+  virtual ~RasterWorkerPoolTaskImpl() {}
+
+ private:
+  scoped_ptr<base::Value> DataAsValue() const {
+    scoped_ptr<base::DictionaryValue> res(new base::DictionaryValue());
+    res->Set("tile_id", TracedValue::CreateIDRef(tile_id_).release());
+    res->Set("resolution", TileResolutionAsValue(tile_resolution_).release());
+    res->SetInteger("source_frame_number", source_frame_number_);
+    res->SetInteger("layer_id", layer_id_);
+    return res.PassAs<base::Value>();
+  }
+
+  void Raster(PicturePileImpl* picture_pile, SkCanvas* canvas) {
     skia::RefPtr<SkDrawFilter> draw_filter;
     switch (raster_mode_) {
       case LOW_QUALITY_RASTER_MODE:
@@ -162,7 +218,7 @@ class RasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
         NOTREACHED();
     }
 
-    canvas.setDrawFilter(draw_filter.get());
+    canvas->setDrawFilter(draw_filter.get());
 
     base::TimeDelta prev_rasterize_time =
         rendering_stats_->impl_thread_rendering_stats().rasterize_time;
@@ -172,11 +228,11 @@ class RasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
     // introduce noise in the measurement (sometimes they get rasterized
     // before we draw and sometimes they aren't)
     if (tile_resolution_ == HIGH_RESOLUTION) {
-      picture_clone->RasterToBitmap(
-          &canvas, content_rect_, contents_scale_, rendering_stats_);
+      picture_pile->RasterToBitmap(
+          canvas, content_rect_, contents_scale_, rendering_stats_);
     } else {
-      picture_clone->RasterToBitmap(
-          &canvas, content_rect_, contents_scale_, NULL);
+      picture_pile->RasterToBitmap(
+          canvas, content_rect_, contents_scale_, NULL);
     }
 
     if (rendering_stats_->record_rendering_stats()) {
@@ -189,36 +245,6 @@ class RasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
           100000,
           100);
     }
-
-    ChangeBitmapConfigIfNeeded(bitmap, buffer);
-
-    return true;
-  }
-
-  // Overridden from internal::RasterWorkerPoolTask:
-  virtual bool RunOnWorkerThread(unsigned thread_index,
-                                 void* buffer,
-                                 gfx::Size size,
-                                 int stride)
-      OVERRIDE {
-    RunAnalysisOnThread(thread_index);
-    return RunRasterOnThread(thread_index, buffer, size, stride);
-  }
-  virtual void CompleteOnOriginThread() OVERRIDE {
-    reply_.Run(analysis_, !HasFinishedRunning() || WasCanceled());
-  }
-
- protected:
-  virtual ~RasterWorkerPoolTaskImpl() {}
-
- private:
-  scoped_ptr<base::Value> DataAsValue() const {
-    scoped_ptr<base::DictionaryValue> res(new base::DictionaryValue());
-    res->Set("tile_id", TracedValue::CreateIDRef(tile_id_).release());
-    res->Set("resolution", TileResolutionAsValue(tile_resolution_).release());
-    res->SetInteger("source_frame_number", source_frame_number_);
-    res->SetInteger("layer_id", layer_id_);
-    return res.PassAs<base::Value>();
   }
 
   void ChangeBitmapConfigIfNeeded(const SkBitmap& bitmap,
@@ -483,6 +509,14 @@ void RasterWorkerPool::Shutdown() {
   weak_ptr_factory_.InvalidateWeakPtrs();
 }
 
+ResourceFormat RasterWorkerPool::GetMemoryEfficientResourceFormat() const {
+  return GetResourceFormat();
+}
+
+void RasterWorkerPool::SetOffscreenContextProvider(
+    ContextProvider* offscreen_context_provider) {
+}
+
 void RasterWorkerPool::SetRasterTasks(RasterTask::Queue* queue) {
   raster_tasks_.swap(queue->tasks_);
   raster_tasks_required_for_activation_.swap(
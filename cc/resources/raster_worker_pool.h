@@ -17,11 +17,14 @@
 #include "cc/resources/worker_pool.h"
 #include "third_party/khronos/GLES2/gl2.h"
 
+class SkCanvas;
+
 namespace skia {
 class LazyPixelRef;
 }
 
 namespace cc {
+class ContextProvider;
 class PicturePileImpl;
 class PixelBufferRasterWorkerPool;
 class ResourceProvider;
@@ -42,6 +45,13 @@ class CC_EXPORT RasterWorkerPoolTask
                                  int stride) = 0;
   virtual void CompleteOnOriginThread() = 0;
 
+  // Used by pools that rasterize on the origin thread. Only the analysis
+  // runs on the worker thread; RunRasterOnOriginThread() is then called
+  // with a canvas that draws directly into the resource. Returns true if
+  // |canvas| was drawn to.
+  virtual void RunAnalysisOnWorkerThread(unsigned thread_index) = 0;
+  virtual bool RunRasterOnOriginThread(SkCanvas* canvas) = 0;
+
   void DidRun(bool was_canceled);
   bool HasFinishedRunning() const;
   bool WasCanceled() const;
@@ -189,6 +199,17 @@ class CC_EXPORT RasterWorkerPool : public WorkerPool {
   // Returns the format that needs to be used for raster task resources.
   virtual ResourceFormat GetResourceFormat() const = 0;
 
+  // Returns a format using less memory per pixel that raster task resources
+  // can use instead of GetResourceFormat(), at the cost of precision.
+  // Returns GetResourceFormat() if there is no such format.
+  virtual ResourceFormat GetMemoryEfficientResourceFormat() const;
+
+  // Sets the offscreen context that rasterization can use on the origin
+  // thread, or NULL if there is none. Only GPU rasterization needs it, so
+  // other pools ignore it.
+  virtual void SetOffscreenContextProvider(
+      ContextProvider* offscreen_context_provider);
+
   // TODO(vmpstr): Figure out an elegant way to not pass this many parameters.
   static RasterTask CreateRasterTask(
       const Resource* resource,
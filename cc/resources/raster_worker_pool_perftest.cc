@@ -5,7 +5,16 @@
 #include "cc/resources/raster_worker_pool.h"
 
 #include "base/time/time.h"
+#include "cc/base/scoped_ptr_vector.h"
+#include "cc/resources/gpu_raster_worker_pool.h"
+#include "cc/resources/image_raster_worker_pool.h"
+#include "cc/resources/resource_provider.h"
+#include "cc/resources/scoped_resource.h"
+#include "cc/test/fake_output_surface.h"
+#include "cc/test/fake_output_surface_client.h"
+#include "cc/test/fake_picture_pile_impl.h"
 #include "cc/test/lap_timer.h"
+#include "cc/test/test_context_provider.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
@@ -215,6 +224,144 @@ TEST_F(RasterWorkerPoolPerfTest, BuildTaskGraph) {
   RunBuildTaskGraphTest("1000_16", 1000, 16);
 }
 
+// Base class for the tests of raster worker pools that rasterize into
+// resources.
+class ResourceRasterWorkerPoolPerfTest : public testing::Test,
+                                         public RasterWorkerPoolClient {
+ public:
+  ResourceRasterWorkerPoolPerfTest()
+      : context_provider_(TestContextProvider::Create()),
+        rendering_stats_(RenderingStatsInstrumentation::Create()),
+        timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {
+    output_surface_ = FakeOutputSurface::Create3d(context_provider_).Pass();
+    CHECK(output_surface_->BindToClient(&output_surface_client_));
+
+    resource_provider_ = ResourceProvider::Create(
+        output_surface_.get(), NULL, 0, false, 1).Pass();
+  }
+
+  virtual scoped_ptr<RasterWorkerPool> CreateRasterWorkerPool() = 0;
+
+  // Overridden from testing::Test:
+  virtual void SetUp() OVERRIDE {
+    raster_worker_pool_ = CreateRasterWorkerPool();
+    raster_worker_pool_->SetClient(this);
+  }
+  virtual void TearDown() OVERRIDE {
+    raster_worker_pool_->Shutdown();
+    raster_worker_pool_->CheckForCompletedTasks();
+    raster_worker_pool_.reset();
+    resources_.clear();
+  }
+
+  // Overridden from RasterWorkerPoolClient:
+  virtual bool ShouldForceTasksRequiredForActivationToComplete() const
+      OVERRIDE {
+    return false;
+  }
+  virtual void DidFinishRunningTasks() OVERRIDE {}
+  virtual void DidFinishRunningTasksRequiredForActivation() OVERRIDE {}
+
+  void CreateTasks(unsigned num_raster_tasks) {
+    scoped_refptr<FakePicturePileImpl> pile =
+        FakePicturePileImpl::CreateFilledPile(gfx::Size(256, 256),
+                                              gfx::Size(256, 256));
+    for (unsigned i = 0; i < num_raster_tasks; ++i) {
+      scoped_ptr<ScopedResource> resource(
+          ScopedResource::create(resource_provider_.get()));
+      resource->Allocate(gfx::Size(256, 256),
+                         ResourceProvider::TextureUsageAny,
+                         raster_worker_pool_->GetResourceFormat());
+
+      RasterWorkerPool::Task::Set empty;
+      tasks_.push_back(
+          RasterWorkerPool::CreateRasterTask(
+              resource.get(),
+              pile.get(),
+              gfx::Rect(256, 256),
+              1.0,
+              HIGH_QUALITY_RASTER_MODE,
+              TileResolution(),
+              1,
+              NULL,
+              1,
+              rendering_stats_.get(),
+              base::Bind(
+                  &ResourceRasterWorkerPoolPerfTest::OnRasterTaskCompleted),
+              &empty));
+      resources_.push_back(resource.release());
+    }
+  }
+
+  void RunScheduleTasksTest(const std::string& measurement,
+                            const std::string& test_name,
+                            unsigned num_raster_tasks) {
+    CreateTasks(num_raster_tasks);
+
+    timer_.Reset();
+    do {
+      RasterWorkerPool::RasterTask::Queue queue;
+      for (std::vector<RasterWorkerPool::RasterTask>::iterator it =
+               tasks_.begin();
+           it != tasks_.end(); ++it)
+        queue.Append(*it, false);
+      raster_worker_pool_->ScheduleTasks(&queue);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    RasterWorkerPool::RasterTask::Queue empty;
+    raster_worker_pool_->ScheduleTasks(&empty);
+    tasks_.clear();
+
+    perf_test::PrintResult(measurement, "", test_name,
+                           timer_.LapsPerSecond(), "runs/s", true);
+  }
+
+ protected:
+  static void OnRasterTaskCompleted(const PicturePileImpl::Analysis& analysis,
+                                    bool was_canceled) {}
+
+  scoped_refptr<TestContextProvider> context_provider_;
+  FakeOutputSurfaceClient output_surface_client_;
+  scoped_ptr<FakeOutputSurface> output_surface_;
+  scoped_ptr<ResourceProvider> resource_provider_;
+  scoped_ptr<RenderingStatsInstrumentation> rendering_stats_;
+  scoped_ptr<RasterWorkerPool> raster_worker_pool_;
+  std::vector<RasterWorkerPool::RasterTask> tasks_;
+  ScopedPtrVector<ScopedResource> resources_;
+  LapTimer timer_;
+};
+
+class GpuRasterWorkerPoolPerfTest : public ResourceRasterWorkerPoolPerfTest {
+ protected:
+  virtual scoped_ptr<RasterWorkerPool> CreateRasterWorkerPool() OVERRIDE {
+    return GpuRasterWorkerPool::Create(
+        resource_provider_.get(), context_provider_.get(), 1);
+  }
+};
+
+TEST_F(GpuRasterWorkerPoolPerfTest, ScheduleTasks) {
+  RunScheduleTasksTest("gpu_schedule_tasks", "10", 10);
+  RunScheduleTasksTest("gpu_schedule_tasks", "100", 100);
+  RunScheduleTasksTest("gpu_schedule_tasks", "1000", 1000);
+}
+
+// Rasterizes straight into mapped images, with no upload afterwards.
+class ImageRasterWorkerPoolPerfTest : public ResourceRasterWorkerPoolPerfTest {
+ protected:
+  virtual scoped_ptr<RasterWorkerPool> CreateRasterWorkerPool() OVERRIDE {
+    return ImageRasterWorkerPool::Create(resource_provider_.get(), 1);
+  }
+};
+
+TEST_F(ImageRasterWorkerPoolPerfTest, ScheduleTasks) {
+  RunScheduleTasksTest("image_schedule_tasks", "10", 10);
+  RunScheduleTasksTest("image_schedule_tasks", "100", 100);
+  RunScheduleTasksTest("image_schedule_tasks", "1000", 1000);
+}
+
 }  // namespace
 
 }  // namespace cc
@@ -7,6 +7,7 @@
 #include <limits>
 #include <vector>
 
+#include "cc/resources/gpu_raster_worker_pool.h"
 #include "cc/resources/image_raster_worker_pool.h"
 #include "cc/resources/picture_pile.h"
 #include "cc/resources/picture_pile_impl.h"
@@ -15,6 +16,7 @@
 #include "cc/resources/scoped_resource.h"
 #include "cc/test/fake_output_surface.h"
 #include "cc/test/fake_output_surface_client.h"
+#include "cc/test/test_context_provider.h"
 #include "cc/test/test_web_graphics_context_3d.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -42,8 +44,15 @@ class TestRasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
     did_raster_ = true;
     return true;
   }
+  virtual void RunAnalysisOnWorkerThread(unsigned thread_index) OVERRIDE {}
+  virtual bool RunRasterOnOriginThread(SkCanvas* canvas) OVERRIDE {
+    did_raster_ = true;
+    return true;
+  }
   virtual void CompleteOnOriginThread() OVERRIDE {
-    reply_.Run(PicturePileImpl::Analysis(), !HasFinishedRunning(), did_raster_);
+    reply_.Run(PicturePileImpl::Analysis(),
+               !HasFinishedRunning() || WasCanceled(),
+               did_raster_);
   }
 
  protected:
@@ -56,6 +65,12 @@ class TestRasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
   DISALLOW_COPY_AND_ASSIGN(TestRasterWorkerPoolTaskImpl);
 };
 
+enum RasterWorkerPoolType {
+  RASTER_WORKER_POOL_TYPE_PIXEL_BUFFER,
+  RASTER_WORKER_POOL_TYPE_IMAGE,
+  RASTER_WORKER_POOL_TYPE_GPU
+};
+
 class RasterWorkerPoolTest : public testing::Test,
                              public RasterWorkerPoolClient  {
  public:
@@ -101,16 +116,23 @@ class RasterWorkerPoolTest : public testing::Test,
     return raster_worker_pool_.get();
   }
 
-  void RunTest(bool use_map_image) {
-    if (use_map_image) {
-      raster_worker_pool_ = ImageRasterWorkerPool::Create(
-          resource_provider(), 1);
-    } else {
-      raster_worker_pool_ =
-          PixelBufferRasterWorkerPool::Create(
-              resource_provider(),
-              1,
-              std::numeric_limits<size_t>::max());
+  void RunTest(RasterWorkerPoolType type) {
+    switch (type) {
+      case RASTER_WORKER_POOL_TYPE_PIXEL_BUFFER:
+        raster_worker_pool_ =
+            PixelBufferRasterWorkerPool::Create(
+                resource_provider(),
+                1,
+                std::numeric_limits<size_t>::max());
+        break;
+      case RASTER_WORKER_POOL_TYPE_IMAGE:
+        raster_worker_pool_ = ImageRasterWorkerPool::Create(
+            resource_provider(), 1);
+        break;
+      case RASTER_WORKER_POOL_TYPE_GPU:
+        raster_worker_pool_ = GpuRasterWorkerPool::Create(
+            resource_provider(), context_provider_.get(), 1);
+        break;
     }
 
     raster_worker_pool_->SetClient(this);
@@ -218,12 +240,17 @@ namespace {
 
 #define PIXEL_BUFFER_TEST_F(TEST_FIXTURE_NAME)                  \
   TEST_F(TEST_FIXTURE_NAME, RunPixelBuffer) {                   \
-    RunTest(false);                                             \
+    RunTest(RASTER_WORKER_POOL_TYPE_PIXEL_BUFFER);              \
   }
 
 #define IMAGE_TEST_F(TEST_FIXTURE_NAME)                         \
   TEST_F(TEST_FIXTURE_NAME, RunImage) {                         \
-    RunTest(true);                                              \
+    RunTest(RASTER_WORKER_POOL_TYPE_IMAGE);                     \
+  }
+
+#define GPU_TEST_F(TEST_FIXTURE_NAME)                           \
+  TEST_F(TEST_FIXTURE_NAME, RunGpu) {                           \
+    RunTest(RASTER_WORKER_POOL_TYPE_GPU);                       \
   }
 
 #define PIXEL_BUFFER_AND_IMAGE_TEST_F(TEST_FIXTURE_NAME)        \
@@ -287,6 +314,72 @@ class RasterWorkerPoolTestFailedMapResource : public RasterWorkerPoolTest {
 
 PIXEL_BUFFER_AND_IMAGE_TEST_F(RasterWorkerPoolTestFailedMapResource);
 
+class RasterWorkerPoolTestNoOffscreenContext : public RasterWorkerPoolTest {
+ public:
+  virtual void OnTaskCompleted(scoped_ptr<ScopedResource> resource,
+                               unsigned id,
+                               const PicturePileImpl::Analysis& analysis,
+                               bool was_canceled,
+                               bool did_raster) OVERRIDE {
+    EXPECT_TRUE(was_canceled);
+    EXPECT_FALSE(did_raster);
+    EndTest();
+  }
+
+  // Overridden from RasterWorkerPoolTest:
+  virtual void BeginTest() OVERRIDE {
+    AppendTask(0u);
+    ScheduleTasks();
+  }
+
+  virtual void AfterTest() OVERRIDE {
+    ASSERT_EQ(1u, tasks_.size());
+    tasks_.clear();
+  }
+};
+
+GPU_TEST_F(RasterWorkerPoolTestNoOffscreenContext);
+
+class RasterWorkerPoolTestNoGrContext : public RasterWorkerPoolTest {
+ public:
+  RasterWorkerPoolTestNoGrContext()
+      : offscreen_context_provider_(TestContextProvider::Create()) {}
+
+  virtual void OnTaskCompleted(scoped_ptr<ScopedResource> resource,
+                               unsigned id,
+                               const PicturePileImpl::Analysis& analysis,
+                               bool was_canceled,
+                               bool did_raster) OVERRIDE {
+    EXPECT_TRUE(was_canceled);
+    EXPECT_FALSE(did_raster);
+    on_task_completed_ids_.push_back(id);
+    if (on_task_completed_ids_.size() == 2)
+      EndTest();
+  }
+
+  // Overridden from RasterWorkerPoolTest:
+  virtual void BeginTest() OVERRIDE {
+    // The test context has no GrContext, so the tasks can't be rasterized
+    // and must complete as canceled.
+    ASSERT_TRUE(offscreen_context_provider_->BindToCurrentThread());
+    worker_pool()->SetOffscreenContextProvider(
+        offscreen_context_provider_.get());
+    AppendTask(0u);
+    AppendTask(1u);
+    ScheduleTasks();
+  }
+
+  virtual void AfterTest() OVERRIDE {
+    EXPECT_EQ(2u, on_task_completed_ids_.size());
+    tasks_.clear();
+  }
+
+  scoped_refptr<TestContextProvider> offscreen_context_provider_;
+  std::vector<unsigned> on_task_completed_ids_;
+};
+
+GPU_TEST_F(RasterWorkerPoolTestNoGrContext);
+
 }  // namespace
 
 }  // namespace cc
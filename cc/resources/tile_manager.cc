@@ -14,6 +14,7 @@
 #include "base/metrics/histogram.h"
 #include "cc/debug/devtools_instrumentation.h"
 #include "cc/debug/traced_value.h"
+#include "cc/resources/gpu_raster_worker_pool.h"
 #include "cc/resources/image_raster_worker_pool.h"
 #include "cc/resources/pixel_buffer_raster_worker_pool.h"
 #include "cc/resources/tile.h"
@@ -177,17 +178,27 @@ scoped_ptr<TileManager> TileManager::Create(
     size_t num_raster_threads,
     RenderingStatsInstrumentation* rendering_stats_instrumentation,
     bool use_map_image,
-    size_t max_transfer_buffer_usage_bytes) {
+    size_t max_transfer_buffer_usage_bytes,
+    ContextProvider* gpu_rasterization_context_provider) {
+  scoped_ptr<RasterWorkerPool> raster_worker_pool;
+  if (gpu_rasterization_context_provider) {
+    raster_worker_pool = GpuRasterWorkerPool::Create(
+        resource_provider,
+        gpu_rasterization_context_provider,
+        num_raster_threads);
+  } else if (use_map_image) {
+    raster_worker_pool = ImageRasterWorkerPool::Create(
+        resource_provider, num_raster_threads);
+  } else {
+    raster_worker_pool = PixelBufferRasterWorkerPool::Create(
+        resource_provider,
+        num_raster_threads,
+        max_transfer_buffer_usage_bytes);
+  }
   return make_scoped_ptr(
       new TileManager(client,
                       resource_provider,
-                      use_map_image ?
-                      ImageRasterWorkerPool::Create(
-                          resource_provider, num_raster_threads) :
-                      PixelBufferRasterWorkerPool::Create(
-                          resource_provider,
-                          num_raster_threads,
-                          max_transfer_buffer_usage_bytes),
+                      raster_worker_pool.Pass(),
                       num_raster_threads,
                       rendering_stats_instrumentation));
 }
@@ -209,6 +220,7 @@ TileManager::TileManager(
       bytes_releasable_(0),
       resources_releasable_(0),
       ever_exceeded_memory_budget_(false),
+      use_memory_efficient_resource_format_(false),
       rendering_stats_instrumentation_(rendering_stats_instrumentation),
       did_initialize_visible_tile_(false),
       did_check_for_completed_tasks_since_last_schedule_tasks_(true) {
@@ -236,12 +248,17 @@ TileManager::~TileManager() {
 }
 
 void TileManager::Release(Tile* tile) {
-  prioritized_tiles_dirty_ = true;
   released_tiles_.push_back(tile);
 }
 
 void TileManager::DidChangeTilePriority(Tile* tile) {
-  prioritized_tiles_dirty_ = true;
+  InvalidateTileBins(tile);
+}
+
+void TileManager::InvalidateTileBins(Tile* tile) {
+  // Rebuilding the whole prioritized tile set gets to every tile anyway.
+  if (!prioritized_tiles_dirty_)
+    tiles_with_stale_bins_.insert(tile);
 }
 
 bool TileManager::ShouldForceTasksRequiredForActivationToComplete() const {
@@ -255,6 +272,9 @@ void TileManager::CleanUpReleasedTiles() {
     Tile* tile = *it;
 
     FreeResourcesForTile(tile);
+    SetMemoryStatsForTile(tile, false, false);
+    prioritized_tiles_.RemoveTile(tile);
+    tiles_with_stale_bins_.erase(tile);
 
     DCHECK(tiles_.find(tile->id()) != tiles_.end());
     tiles_.erase(tile->id());
@@ -264,7 +284,7 @@ void TileManager::CleanUpReleasedTiles() {
     DCHECK_GT(layer_it->second, 0);
     if (--layer_it->second == 0) {
       used_layer_counts_.erase(layer_it);
-      image_decode_tasks_.erase(tile->layer_id());
+      ReleasePixelRefsForLayer(tile->layer_id());
     }
 
     delete tile;
@@ -274,14 +294,39 @@ void TileManager::CleanUpReleasedTiles() {
 }
 
 void TileManager::UpdatePrioritizedTileSetIfNeeded() {
-  if (!prioritized_tiles_dirty_)
+  CleanUpReleasedTiles();
+
+  if (prioritized_tiles_dirty_) {
+    prioritized_tiles_.Clear();
+    GetTilesWithAssignedBins(&prioritized_tiles_);
+    tiles_with_stale_bins_.clear();
+    prioritized_tiles_dirty_ = false;
     return;
+  }
 
-  CleanUpReleasedTiles();
+  if (tiles_with_stale_bins_.empty())
+    return;
+
+  TRACE_EVENT1("cc", "TileManager::UpdateStaleTileBins",
+               "count", tiles_with_stale_bins_.size());
+
+  // Only tiles whose bins may have changed move in the set. Their bins are
+  // sorted again when AssignGpuMemoryToTiles() gets to them.
+  TileHashSet tiles_with_stale_bins;
+  tiles_with_stale_bins.swap(tiles_with_stale_bins_);
+  for (TileHashSet::iterator it = tiles_with_stale_bins.begin();
+       it != tiles_with_stale_bins.end();
+       ++it) {
+    Tile* tile = *it;
+    prioritized_tiles_.RemoveTile(tile);
+    ManagedTileBin priority_bin = AssignBinToTile(tile);
+    if (priority_bin != NEVER_BIN)
+      prioritized_tiles_.InsertTile(tile, priority_bin);
+  }
 
-  prioritized_tiles_.Clear();
-  GetTilesWithAssignedBins(&prioritized_tiles_);
-  prioritized_tiles_dirty_ = false;
+  // Tiles that were just moved to NEVER_BIN freed their resources, which
+  // doesn't change their bins again.
+  tiles_with_stale_bins_.clear();
 }
 
 void TileManager::DidFinishRunningTasks() {
@@ -326,6 +371,7 @@ void TileManager::DidFinishRunningTasks() {
       if (!allow_rasterize_on_demand)
         return;
       tile_version.set_rasterize_on_demand();
+      InvalidateTileBins(tile);
     }
   }
 
@@ -351,119 +397,153 @@ void TileManager::GetTilesWithAssignedBins(PrioritizedTileSet* tiles) {
   memory_required_bytes_ = 0;
   memory_nice_to_have_bytes_ = 0;
 
-  const TileMemoryLimitPolicy memory_policy = global_state_.memory_limit_policy;
-  const TreePriority tree_priority = global_state_.tree_priority;
-
   // For each tree, bin into different categories of tiles.
   for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it) {
     Tile* tile = it->second;
     ManagedTileState& mts = tile->managed_state();
+    mts.counts_as_memory_required = false;
+    mts.counts_as_memory_nice_to_have = false;
 
-    const ManagedTileState::TileVersion& tile_version =
-        tile->GetTileVersionForDrawing();
-    bool tile_is_ready_to_draw = tile_version.IsReadyToDraw();
-    bool tile_is_active =
-        tile_is_ready_to_draw ||
-        !mts.tile_versions[mts.raster_mode].raster_task_.is_null();
-
-    // Get the active priority and bin.
-    TilePriority active_priority = tile->priority(ACTIVE_TREE);
-    ManagedTileBin active_bin = BinFromTilePriority(active_priority);
-
-    // Get the pending priority and bin.
-    TilePriority pending_priority = tile->priority(PENDING_TREE);
-    ManagedTileBin pending_bin = BinFromTilePriority(pending_priority);
-
-    // Adjust pending bin state for low res tiles. This prevents
-    // pending tree low-res tiles from being initialized before
-    // high-res tiles.
-    if (pending_priority.resolution == LOW_RESOLUTION)
-      pending_bin = std::max(pending_bin, EVENTUALLY_BIN);
-
-    // Compute combined bin.
-    ManagedTileBin combined_bin = std::min(active_bin, pending_bin);
-
-    // Adjust bin state based on if ready to draw.
-    active_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][active_bin];
-    pending_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][pending_bin];
-    combined_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][combined_bin];
-
-    // Adjust bin state based on if active.
-    active_bin = kBinIsActiveMap[tile_is_active][active_bin];
-    pending_bin = kBinIsActiveMap[tile_is_active][pending_bin];
-    combined_bin = kBinIsActiveMap[tile_is_active][combined_bin];
-
-    ManagedTileBin tree_bin[NUM_TREES];
-    tree_bin[ACTIVE_TREE] = kBinPolicyMap[memory_policy][active_bin];
-    tree_bin[PENDING_TREE] = kBinPolicyMap[memory_policy][pending_bin];
-
-    // The bin that the tile would have if the GPU memory manager had
-    // a maximally permissive policy, send to the GPU memory manager
-    // to determine policy.
-    ManagedTileBin gpu_memmgr_stats_bin = NEVER_BIN;
-    TilePriority tile_priority;
-
-    switch (tree_priority) {
-      case SAME_PRIORITY_FOR_BOTH_TREES:
-        mts.bin = kBinPolicyMap[memory_policy][combined_bin];
-        gpu_memmgr_stats_bin = combined_bin;
-        tile_priority = tile->combined_priority();
-        break;
-      case SMOOTHNESS_TAKES_PRIORITY:
-        mts.bin = tree_bin[ACTIVE_TREE];
-        gpu_memmgr_stats_bin = active_bin;
-        tile_priority = active_priority;
-        break;
-      case NEW_CONTENT_TAKES_PRIORITY:
-        mts.bin = tree_bin[PENDING_TREE];
-        gpu_memmgr_stats_bin = pending_bin;
-        tile_priority = pending_priority;
-        break;
-    }
+    // Insert the tile into a priority set.
+    ManagedTileBin priority_bin = AssignBinToTile(tile);
+    if (priority_bin != NEVER_BIN)
+      tiles->InsertTile(tile, priority_bin);
+  }
+}
 
-    if (!tile_is_ready_to_draw || tile_version.requires_resource()) {
-      if ((gpu_memmgr_stats_bin == NOW_BIN) ||
-          (gpu_memmgr_stats_bin == NOW_AND_READY_TO_DRAW_BIN))
-        memory_required_bytes_ += BytesConsumedIfAllocated(tile);
-      if (gpu_memmgr_stats_bin != NEVER_BIN)
-        memory_nice_to_have_bytes_ += BytesConsumedIfAllocated(tile);
-    }
+ManagedTileBin TileManager::AssignBinToTile(Tile* tile) {
+  const TileMemoryLimitPolicy memory_policy = global_state_.memory_limit_policy;
+  const TreePriority tree_priority = global_state_.tree_priority;
 
-    // Bump up the priority if we determined it's NEVER_BIN on one tree,
-    // but is still required on the other tree.
-    bool is_in_never_bin_on_both_trees =
-        tree_bin[ACTIVE_TREE] == NEVER_BIN &&
-        tree_bin[PENDING_TREE] == NEVER_BIN;
+  ManagedTileState& mts = tile->managed_state();
 
-    if (mts.bin == NEVER_BIN && !is_in_never_bin_on_both_trees)
-      mts.bin = tile_is_active ? AT_LAST_AND_ACTIVE_BIN : AT_LAST_BIN;
+  const ManagedTileState::TileVersion& tile_version =
+      tile->GetTileVersionForDrawing();
+  bool tile_is_ready_to_draw = tile_version.IsReadyToDraw();
+  bool tile_is_active =
+      tile_is_ready_to_draw ||
+      !mts.tile_versions[mts.raster_mode].raster_task_.is_null();
+
+  // Get the active priority and bin.
+  TilePriority active_priority = tile->priority(ACTIVE_TREE);
+  ManagedTileBin active_bin = BinFromTilePriority(active_priority);
+
+  // Get the pending priority and bin.
+  TilePriority pending_priority = tile->priority(PENDING_TREE);
+  ManagedTileBin pending_bin = BinFromTilePriority(pending_priority);
+
+  // Adjust pending bin state for low res tiles. This prevents
+  // pending tree low-res tiles from being initialized before
+  // high-res tiles.
+  if (pending_priority.resolution == LOW_RESOLUTION)
+    pending_bin = std::max(pending_bin, EVENTUALLY_BIN);
+
+  // Compute combined bin.
+  ManagedTileBin combined_bin = std::min(active_bin, pending_bin);
+
+  // Adjust bin state based on if ready to draw.
+  active_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][active_bin];
+  pending_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][pending_bin];
+  combined_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][combined_bin];
+
+  // Adjust bin state based on if active.
+  active_bin = kBinIsActiveMap[tile_is_active][active_bin];
+  pending_bin = kBinIsActiveMap[tile_is_active][pending_bin];
+  combined_bin = kBinIsActiveMap[tile_is_active][combined_bin];
+
+  ManagedTileBin tree_bin[NUM_TREES];
+  tree_bin[ACTIVE_TREE] = kBinPolicyMap[memory_policy][active_bin];
+  tree_bin[PENDING_TREE] = kBinPolicyMap[memory_policy][pending_bin];
+
+  // The bin that the tile would have if the GPU memory manager had
+  // a maximally permissive policy, send to the GPU memory manager
+  // to determine policy.
+  ManagedTileBin gpu_memmgr_stats_bin = NEVER_BIN;
+  TilePriority tile_priority;
+
+  switch (tree_priority) {
+    case SAME_PRIORITY_FOR_BOTH_TREES:
+      mts.bin = kBinPolicyMap[memory_policy][combined_bin];
+      gpu_memmgr_stats_bin = combined_bin;
+      tile_priority = tile->combined_priority();
+      break;
+    case SMOOTHNESS_TAKES_PRIORITY:
+      mts.bin = tree_bin[ACTIVE_TREE];
+      gpu_memmgr_stats_bin = active_bin;
+      tile_priority = active_priority;
+      break;
+    case NEW_CONTENT_TAKES_PRIORITY:
+      mts.bin = tree_bin[PENDING_TREE];
+      gpu_memmgr_stats_bin = pending_bin;
+      tile_priority = pending_priority;
+      break;
+  }
 
-    mts.resolution = tile_priority.resolution;
-    mts.time_to_needed_in_seconds = tile_priority.time_to_visible_in_seconds;
-    mts.distance_to_visible_in_pixels =
-        tile_priority.distance_to_visible_in_pixels;
-    mts.required_for_activation = tile_priority.required_for_activation;
+  bool counts_as_memory_required = false;
+  bool counts_as_memory_nice_to_have = false;
+  if (!tile_is_ready_to_draw || tile_version.requires_resource()) {
+    counts_as_memory_required =
+        (gpu_memmgr_stats_bin == NOW_BIN) ||
+        (gpu_memmgr_stats_bin == NOW_AND_READY_TO_DRAW_BIN);
+    counts_as_memory_nice_to_have = gpu_memmgr_stats_bin != NEVER_BIN;
+  }
+  SetMemoryStatsForTile(
+      tile, counts_as_memory_required, counts_as_memory_nice_to_have);
 
-    mts.visible_and_ready_to_draw =
-        tree_bin[ACTIVE_TREE] == NOW_AND_READY_TO_DRAW_BIN;
+  // Bump up the priority if we determined it's NEVER_BIN on one tree,
+  // but is still required on the other tree.
+  bool is_in_never_bin_on_both_trees =
+      tree_bin[ACTIVE_TREE] == NEVER_BIN &&
+      tree_bin[PENDING_TREE] == NEVER_BIN;
 
-    if (mts.bin == NEVER_BIN) {
-      FreeResourcesForTile(tile);
-      continue;
-    }
+  if (mts.bin == NEVER_BIN && !is_in_never_bin_on_both_trees)
+    mts.bin = tile_is_active ? AT_LAST_AND_ACTIVE_BIN : AT_LAST_BIN;
 
-    // Note that if the tile is visible_and_ready_to_draw, then we always want
-    // the priority to be NOW_AND_READY_TO_DRAW_BIN, even if HIGH_PRIORITY_BIN
-    // is something different. The reason for this is that if we're prioritizing
-    // the pending tree, we still want visible tiles to take the highest
-    // priority.
-    ManagedTileBin priority_bin = mts.visible_and_ready_to_draw
-                                  ? NOW_AND_READY_TO_DRAW_BIN
-                                  : mts.bin;
+  mts.resolution = tile_priority.resolution;
+  mts.time_to_needed_in_seconds = tile_priority.time_to_visible_in_seconds;
+  mts.distance_to_visible_in_pixels =
+      tile_priority.distance_to_visible_in_pixels;
+  mts.required_for_activation = tile_priority.required_for_activation;
 
-    // Insert the tile into a priority set.
-    tiles->InsertTile(tile, priority_bin);
+  mts.visible_and_ready_to_draw =
+      tree_bin[ACTIVE_TREE] == NOW_AND_READY_TO_DRAW_BIN;
+
+  if (mts.bin == NEVER_BIN) {
+    FreeResourcesForTile(tile);
+    return NEVER_BIN;
   }
+
+  // Note that if the tile is visible_and_ready_to_draw, then we always want
+  // the priority to be NOW_AND_READY_TO_DRAW_BIN, even if HIGH_PRIORITY_BIN
+  // is something different. The reason for this is that if we're prioritizing
+  // the pending tree, we still want visible tiles to take the highest
+  // priority.
+  ManagedTileBin priority_bin = mts.visible_and_ready_to_draw
+                                ? NOW_AND_READY_TO_DRAW_BIN
+                                : mts.bin;
+  return priority_bin;
+}
+
+void TileManager::SetMemoryStatsForTile(Tile* tile,
+                                        bool counts_as_memory_required,
+                                        bool counts_as_memory_nice_to_have) {
+  ManagedTileState& mts = tile->managed_state();
+  size_t tile_bytes = BytesConsumedIfAllocated(tile);
+  if (mts.counts_as_memory_required) {
+    DCHECK_GE(memory_required_bytes_, tile_bytes);
+    memory_required_bytes_ -= tile_bytes;
+  }
+  if (mts.counts_as_memory_nice_to_have) {
+    DCHECK_GE(memory_nice_to_have_bytes_, tile_bytes);
+    memory_nice_to_have_bytes_ -= tile_bytes;
+  }
+
+  mts.counts_as_memory_required = counts_as_memory_required;
+  mts.counts_as_memory_nice_to_have = counts_as_memory_nice_to_have;
+  if (counts_as_memory_required)
+    memory_required_bytes_ += tile_bytes;
+  if (counts_as_memory_nice_to_have)
+    memory_nice_to_have_bytes_ += tile_bytes;
 }
 
 void TileManager::ManageTiles(const GlobalStateThatImpactsTilePriority& state) {
@@ -590,6 +670,19 @@ RasterMode TileManager::DetermineRasterMode(const Tile* tile) const {
   return std::min(raster_mode, current_mode);
 }
 
+ResourceFormat TileManager::DetermineResourceFormat(const Tile* tile) const {
+  const ManagedTileState& mts = tile->managed_state();
+
+  // Tiles that are needed now always get full precision.
+  if (!use_memory_efficient_resource_format_ ||
+      mts.bin == NOW_AND_READY_TO_DRAW_BIN ||
+      mts.bin == NOW_BIN ||
+      tile->required_for_activation())
+    return raster_worker_pool_->GetResourceFormat();
+
+  return raster_worker_pool_->GetMemoryEfficientResourceFormat();
+}
+
 void TileManager::AssignGpuMemoryToTiles(
     PrioritizedTileSet* tiles,
     TileVector* tiles_that_need_to_be_rasterized) {
@@ -614,6 +707,16 @@ void TileManager::AssignGpuMemoryToTiles(
       std::max(static_cast<int64>(0), bytes_available);
   size_t resources_allocatable = std::max(0, resources_available);
 
+  // Start using the memory efficient format for tiles that aren't needed
+  // now once we've run out of memory, and stop once what we use fits in
+  // half of the budget again.
+  if (memory_stats_from_last_assign_.bytes_over > 0) {
+    use_memory_efficient_resource_format_ = true;
+  } else if (memory_stats_from_last_assign_.bytes_allocated * 2 <=
+             global_state_.memory_limit_in_bytes) {
+    use_memory_efficient_resource_format_ = false;
+  }
+
   size_t bytes_that_exceeded_memory_budget = 0;
   size_t bytes_left = bytes_allocatable;
   size_t resources_left = resources_allocatable;
@@ -628,7 +731,11 @@ void TileManager::AssignGpuMemoryToTiles(
 
     mts.scheduled_priority = schedule_priority++;
 
-    mts.raster_mode = DetermineRasterMode(tile);
+    RasterMode raster_mode = DetermineRasterMode(tile);
+    if (raster_mode != mts.raster_mode) {
+      mts.raster_mode = raster_mode;
+      InvalidateTileBins(tile);
+    }
 
     ManagedTileState::TileVersion& tile_version =
         mts.tile_versions[mts.raster_mode];
@@ -649,7 +756,7 @@ void TileManager::AssignGpuMemoryToTiles(
     // It costs to maintain a resource.
     for (int mode = 0; mode < NUM_RASTER_MODES; ++mode) {
       if (mts.tile_versions[mode].resource_) {
-        tile_bytes += BytesConsumedIfAllocated(tile);
+        tile_bytes += mts.tile_versions[mode].resource_->bytes();
         tile_resources++;
       }
     }
@@ -661,7 +768,8 @@ void TileManager::AssignGpuMemoryToTiles(
       // If we don't have the required version, and it's not in flight
       // then we'll have to pay to create a new task.
       if (!tile_version.resource_ && tile_version.raster_task_.is_null()) {
-        tile_bytes += BytesConsumedIfAllocated(tile);
+        tile_bytes += Resource::MemorySizeBytes(tile->size(),
+                                                DetermineResourceFormat(tile));
         tile_resources++;
       }
     }
@@ -726,14 +834,17 @@ void TileManager::AssignGpuMemoryToTiles(
 void TileManager::FreeResourceForTile(Tile* tile, RasterMode mode) {
   ManagedTileState& mts = tile->managed_state();
   if (mts.tile_versions[mode].resource_) {
+    size_t resource_bytes = mts.tile_versions[mode].resource_->bytes();
     resource_pool_->ReleaseResource(
         mts.tile_versions[mode].resource_.Pass());
 
-    DCHECK_GE(bytes_releasable_, BytesConsumedIfAllocated(tile));
+    DCHECK_GE(bytes_releasable_, resource_bytes);
     DCHECK_GE(resources_releasable_, 1u);
 
-    bytes_releasable_ -= BytesConsumedIfAllocated(tile);
+    bytes_releasable_ -= resource_bytes;
     --resources_releasable_;
+
+    InvalidateTileBins(tile);
   }
 }
 
@@ -781,8 +892,10 @@ void TileManager::ScheduleTasks(
     DCHECK(tile_version.requires_resource());
     DCHECK(!tile_version.resource_);
 
-    if (tile_version.raster_task_.is_null())
+    if (tile_version.raster_task_.is_null()) {
       tile_version.raster_task_ = CreateRasterTask(tile);
+      InvalidateTileBins(tile);
+    }
 
     tasks.Append(tile_version.raster_task_, tile->required_for_activation());
   }
@@ -807,7 +920,6 @@ RasterWorkerPool::Task TileManager::CreateImageDecodeTask(
       rendering_stats_instrumentation_,
       base::Bind(&TileManager::OnImageDecodeTaskCompleted,
                  base::Unretained(this),
-                 tile->layer_id(),
                  base::Unretained(pixel_ref)));
 }
 
@@ -817,12 +929,12 @@ RasterWorkerPool::RasterTask TileManager::CreateRasterTask(Tile* tile) {
   scoped_ptr<ResourcePool::Resource> resource =
       resource_pool_->AcquireResource(
           tile->tile_size_.size(),
-          raster_worker_pool_->GetResourceFormat());
+          DetermineResourceFormat(tile));
   const Resource* const_resource = resource.get();
 
   // Create and queue all image decode tasks that this tile depends on.
   RasterWorkerPool::Task::Set decode_tasks;
-  PixelRefTaskMap& existing_pixel_refs = image_decode_tasks_[tile->layer_id()];
+  PixelRefIdSet& layer_pixel_ref_ids = layer_pixel_ref_ids_[tile->layer_id()];
   for (PicturePileImpl::PixelRefIterator iter(tile->content_rect(),
                                               tile->contents_scale(),
                                               tile->picture_pile());
@@ -830,9 +942,13 @@ RasterWorkerPool::RasterTask TileManager::CreateRasterTask(Tile* tile) {
     skia::LazyPixelRef* pixel_ref = *iter;
     uint32_t id = pixel_ref->getGenerationID();
 
-    // Append existing image decode task if available.
-    PixelRefTaskMap::iterator decode_task_it = existing_pixel_refs.find(id);
-    if (decode_task_it != existing_pixel_refs.end()) {
+    if (layer_pixel_ref_ids.insert(id).second)
+      ++pixel_ref_layer_counts_[id];
+
+    // Append existing image decode task if available. It may have been
+    // created for a tile of another layer.
+    PixelRefTaskMap::iterator decode_task_it = image_decode_tasks_.find(id);
+    if (decode_task_it != image_decode_tasks_.end()) {
       decode_tasks.Insert(decode_task_it->second);
       continue;
     }
@@ -841,7 +957,7 @@ RasterWorkerPool::RasterTask TileManager::CreateRasterTask(Tile* tile) {
     RasterWorkerPool::Task decode_task = CreateImageDecodeTask(
         tile, pixel_ref);
     decode_tasks.Insert(decode_task);
-    existing_pixel_refs[id] = decode_task;
+    image_decode_tasks_[id] = decode_task;
   }
 
   return RasterWorkerPool::CreateRasterTask(
@@ -864,7 +980,6 @@ RasterWorkerPool::RasterTask TileManager::CreateRasterTask(Tile* tile) {
 }
 
 void TileManager::OnImageDecodeTaskCompleted(
-    int layer_id,
     skia::LazyPixelRef* pixel_ref,
     bool was_canceled) {
   // If the task was canceled, we need to clean it up
@@ -872,18 +987,32 @@ void TileManager::OnImageDecodeTaskCompleted(
   if (!was_canceled)
     return;
 
-  LayerPixelRefTaskMap::iterator layer_it =
-      image_decode_tasks_.find(layer_id);
+  PixelRefTaskMap::iterator task_it =
+      image_decode_tasks_.find(pixel_ref->getGenerationID());
 
-  if (layer_it == image_decode_tasks_.end())
+  if (task_it != image_decode_tasks_.end())
+    image_decode_tasks_.erase(task_it);
+}
+
+void TileManager::ReleasePixelRefsForLayer(int layer_id) {
+  LayerPixelRefIdMap::iterator layer_it = layer_pixel_ref_ids_.find(layer_id);
+  if (layer_it == layer_pixel_ref_ids_.end())
     return;
 
-  PixelRefTaskMap& pixel_ref_tasks = layer_it->second;
-  PixelRefTaskMap::iterator task_it =
-      pixel_ref_tasks.find(pixel_ref->getGenerationID());
+  const PixelRefIdSet& pixel_ref_ids = layer_it->second;
+  for (PixelRefIdSet::const_iterator it = pixel_ref_ids.begin();
+       it != pixel_ref_ids.end();
+       ++it) {
+    PixelRefCountMap::iterator count_it = pixel_ref_layer_counts_.find(*it);
+    DCHECK(count_it != pixel_ref_layer_counts_.end());
+    DCHECK_GT(count_it->second, 0);
+    if (--count_it->second == 0) {
+      pixel_ref_layer_counts_.erase(count_it);
+      image_decode_tasks_.erase(*it);
+    }
+  }
 
-  if (task_it != pixel_ref_tasks.end())
-    pixel_ref_tasks.erase(task_it);
+  layer_pixel_ref_ids_.erase(layer_it);
 }
 
 void TileManager::OnRasterTaskCompleted(
@@ -905,6 +1034,7 @@ void TileManager::OnRasterTaskCompleted(
       mts.tile_versions[raster_mode];
   DCHECK(!tile_version.raster_task_.is_null());
   tile_version.raster_task_.Reset();
+  InvalidateTileBins(tile);
 
   if (was_canceled) {
     ++update_visible_tiles_stats_.canceled_count;
@@ -922,7 +1052,7 @@ void TileManager::OnRasterTaskCompleted(
     tile_version.set_use_resource();
     tile_version.resource_ = resource.Pass();
 
-    bytes_releasable_ += BytesConsumedIfAllocated(tile);
+    bytes_releasable_ += tile_version.resource_->bytes();
     ++resources_releasable_;
   }
 
@@ -950,9 +1080,19 @@ scoped_refptr<Tile> TileManager::CreateTile(PicturePileImpl* picture_pile,
                                                          can_use_lcd_text));
   DCHECK(tiles_.find(tile->id()) == tiles_.end());
 
+  // A tile that the recording already shows to be a single color never needs
+  // a raster task or a resource.
+  SkColor solid_color;
+  if (picture_pile->GetSolidColorFromRecording(
+          content_rect, contents_scale, &solid_color)) {
+    ManagedTileState& mts = tile->managed_state();
+    for (int mode = 0; mode < NUM_RASTER_MODES; ++mode)
+      mts.tile_versions[mode].set_solid_color(solid_color);
+  }
+
   tiles_[tile->id()] = tile;
   used_layer_counts_[tile->layer_id()]++;
-  prioritized_tiles_dirty_ = true;
+  InvalidateTileBins(tile);
   return tile;
 }
 
@@ -23,6 +23,7 @@
 #include "cc/resources/tile.h"
 
 namespace cc {
+class ContextProvider;
 class ResourceProvider;
 
 class CC_EXPORT TileManagerClient {
@@ -49,13 +50,18 @@ scoped_ptr<base::Value> RasterTaskCompletionStatsAsValue(
 class CC_EXPORT TileManager : public RasterWorkerPoolClient,
                               public RefCountedManager<Tile> {
  public:
+  // Tiles are rasterized with Ganesh directly into their textures if
+  // |gpu_rasterization_context_provider|, the compositor's context, is not
+  // NULL. Ganesh then draws with the context given to
+  // SetOffscreenContextProvider().
   static scoped_ptr<TileManager> Create(
       TileManagerClient* client,
       ResourceProvider* resource_provider,
       size_t num_raster_threads,
       RenderingStatsInstrumentation* rendering_stats_instrumentation,
       bool use_map_image,
-      size_t max_transfer_buffer_usage_bytes);
+      size_t max_transfer_buffer_usage_bytes,
+      ContextProvider* gpu_rasterization_context_provider);
   virtual ~TileManager();
 
   void ManageTiles(const GlobalStateThatImpactsTilePriority& state);
@@ -96,10 +102,16 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
                                      gfx::Size(1, 1),
                                      resource_provider->best_texture_format()));
 
-      bytes_releasable_ += BytesConsumedIfAllocated(tiles[i]);
+      bytes_releasable_ += tile_version.resource_->bytes();
       ++resources_releasable_;
     }
   }
+  void SetOffscreenContextProvider(
+      ContextProvider* offscreen_context_provider) {
+    raster_worker_pool_->SetOffscreenContextProvider(
+        offscreen_context_provider);
+  }
+
   RasterWorkerPool* RasterWorkerPoolForTesting() {
     return raster_worker_pool_.get();
   }
@@ -138,11 +150,16 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
       TileVector* tiles_that_need_to_be_rasterized);
   void GetTilesWithAssignedBins(PrioritizedTileSet* tiles);
 
+  // Assigns bins and priority state to |tile| and updates the memory stats,
+  // returning the bin to insert the tile into a PrioritizedTileSet with, or
+  // NEVER_BIN if it shouldn't be inserted.
+  ManagedTileBin AssignBinToTile(Tile* tile);
+
  private:
   void OnImageDecodeTaskCompleted(
-      int layer_id,
       skia::LazyPixelRef* pixel_ref,
       bool was_canceled);
+  void ReleasePixelRefsForLayer(int layer_id);
   void OnRasterTaskCompleted(
       Tile::Id tile,
       scoped_ptr<ResourcePool::Resource> resource,
@@ -156,6 +173,7 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
   }
 
   RasterMode DetermineRasterMode(const Tile* tile) const;
+  ResourceFormat DetermineResourceFormat(const Tile* tile) const;
   void FreeResourceForTile(Tile* tile, RasterMode mode);
   void FreeResourcesForTile(Tile* tile);
   void FreeUnusedResourcesForTile(Tile* tile);
@@ -164,6 +182,11 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
   RasterWorkerPool::RasterTask CreateRasterTask(Tile* tile);
   scoped_ptr<base::Value> GetMemoryRequirementsAsValue() const;
   void UpdatePrioritizedTileSetIfNeeded();
+  // Called when what the bins of |tile| depend on may have changed.
+  void InvalidateTileBins(Tile* tile);
+  void SetMemoryStatsForTile(Tile* tile,
+                             bool counts_as_memory_required,
+                             bool counts_as_memory_nice_to_have);
 
   TileManagerClient* client_;
   scoped_ptr<ResourcePool> resource_pool_;
@@ -173,8 +196,12 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
   typedef base::hash_map<Tile::Id, Tile*> TileMap;
   TileMap tiles_;
 
+  // Unless the whole set is dirty, only the tiles in |tiles_with_stale_bins_|
+  // are binned again before the set is next used.
   PrioritizedTileSet prioritized_tiles_;
   bool prioritized_tiles_dirty_;
+  typedef base::hash_set<Tile*> TileHashSet;
+  TileHashSet tiles_with_stale_bins_;
 
   bool all_tiles_that_need_to_be_rasterized_have_memory_;
   bool all_tiles_required_for_activation_have_memory_;
@@ -188,14 +215,28 @@ class CC_EXPORT TileManager : public RasterWorkerPoolClient,
   bool ever_exceeded_memory_budget_;
   MemoryHistory::Entry memory_stats_from_last_assign_;
 
+  // Set while memory is tight. New resources for tiles that aren't needed
+  // now then use the raster worker pool's memory efficient format.
+  bool use_memory_efficient_resource_format_;
+
   RenderingStatsInstrumentation* rendering_stats_instrumentation_;
 
   bool did_initialize_visible_tile_;
   bool did_check_for_completed_tasks_since_last_schedule_tasks_;
 
+  // Image decode tasks are shared by all layers so that each pixel ref is
+  // decoded once, however many layers and tiles draw it. Each pixel ref
+  // counts the layers whose tiles used it, and its task is dropped once
+  // none of those layers has tiles left.
   typedef base::hash_map<uint32_t, RasterWorkerPool::Task> PixelRefTaskMap;
-  typedef base::hash_map<int, PixelRefTaskMap> LayerPixelRefTaskMap;
-  LayerPixelRefTaskMap image_decode_tasks_;
+  PixelRefTaskMap image_decode_tasks_;
+
+  typedef base::hash_set<uint32_t> PixelRefIdSet;
+  typedef base::hash_map<int, PixelRefIdSet> LayerPixelRefIdMap;
+  LayerPixelRefIdMap layer_pixel_ref_ids_;
+
+  typedef base::hash_map<uint32_t, int> PixelRefCountMap;
+  PixelRefCountMap pixel_ref_layer_counts_;
 
   typedef base::hash_map<int, int> LayerCountMap;
   LayerCountMap used_layer_counts_;
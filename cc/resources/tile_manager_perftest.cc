@@ -175,6 +175,9 @@ TEST_F(TileManagerPerfTest, ManageTiles) {
   RunManageTilesTest("100_0", 100, 0);
   RunManageTilesTest("1000_0", 1000, 0);
   RunManageTilesTest("10000_0", 10000, 0);
+  RunManageTilesTest("100_1", 100, 1);
+  RunManageTilesTest("1000_1", 1000, 1);
+  RunManageTilesTest("10000_1", 10000, 1);
   RunManageTilesTest("100_10", 100, 10);
   RunManageTilesTest("1000_10", 1000, 10);
   RunManageTilesTest("10000_10", 10000, 10);
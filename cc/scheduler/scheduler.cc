@@ -208,6 +208,16 @@ void Scheduler::BeginImplFrame(const BeginFrameArgs& args) {
   DCHECK(state_machine_.HasInitializedOutputSurface());
   last_begin_impl_frame_args_ = args;
   last_begin_impl_frame_args_.deadline -= client_->DrawDurationEstimate();
+
+  // If the main thread is behind but could commit and activate before this
+  // frame's deadline, skip one BeginMainFrame so that subsequent commits are
+  // drawn in the frame that requested them.
+  if (settings_.deadline_scheduling_enabled &&
+      state_machine_.MainThreadIsInHighLatencyMode() &&
+      CanCommitAndActivateBeforeDeadline()) {
+    state_machine_.SetSkipNextBeginMainFrameToReduceLatency();
+  }
+
   state_machine_.OnBeginImplFrame(last_begin_impl_frame_args_);
   ProcessScheduledActions();
 
@@ -247,6 +257,14 @@ void Scheduler::BeginImplFrame(const BeginFrameArgs& args) {
   }
 }
 
+bool Scheduler::CanCommitAndActivateBeforeDeadline() const {
+  base::TimeTicks estimated_activation_time =
+      last_begin_impl_frame_args_.frame_time +
+      client_->BeginMainFrameToCommitDurationEstimate() +
+      client_->CommitToActivateDurationEstimate();
+  return estimated_activation_time < last_begin_impl_frame_args_.deadline;
+}
+
 void Scheduler::PostBeginImplFrameDeadline(base::TimeTicks deadline) {
   begin_impl_frame_deadline_closure_.Cancel();
   begin_impl_frame_deadline_closure_.Reset(
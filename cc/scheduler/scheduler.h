@@ -127,6 +127,7 @@ class CC_EXPORT Scheduler {
             const SchedulerSettings& scheduler_settings);
 
   void PostBeginImplFrameDeadline(base::TimeTicks deadline);
+  bool CanCommitAndActivateBeforeDeadline() const;
   void SetupNextBeginImplFrameIfNeeded();
   void ActivatePendingTree();
   void DrawAndSwapIfPossible();
@@ -41,7 +41,9 @@ SchedulerStateMachine::SchedulerStateMachine(const SchedulerSettings& settings)
       active_tree_needs_first_draw_(false),
       draw_if_possible_failed_(false),
       did_create_and_initialize_first_output_surface_(false),
-      smoothness_takes_priority_(false) {}
+      smoothness_takes_priority_(false),
+      skip_next_begin_main_frame_to_reduce_latency_(false),
+      skip_begin_main_frame_to_reduce_latency_(false) {}
 
 const char* SchedulerStateMachine::OutputSurfaceStateToString(
     OutputSurfaceState state) {
@@ -259,6 +261,12 @@ scoped_ptr<base::Value> SchedulerStateMachine::AsValue() const  {
                           did_create_and_initialize_first_output_surface_);
   minor_state->SetBoolean("smoothness_takes_priority",
                           smoothness_takes_priority_);
+  minor_state->SetBoolean("main_thread_is_in_high_latency_mode",
+                          MainThreadIsInHighLatencyMode());
+  minor_state->SetBoolean("skip_begin_main_frame_to_reduce_latency",
+                          skip_begin_main_frame_to_reduce_latency_);
+  minor_state->SetBoolean("skip_next_begin_main_frame_to_reduce_latency",
+                          skip_next_begin_main_frame_to_reduce_latency_);
   state->Set("minor_state", minor_state.release());
 
   return state.PassAs<base::Value>();
@@ -481,6 +489,10 @@ bool SchedulerStateMachine::ShouldSendBeginMainFrame() const {
   if (HasSentBeginMainFrameThisFrame())
     return false;
 
+  // The main thread is catching up to low latency mode.
+  if (skip_begin_main_frame_to_reduce_latency_)
+    return false;
+
   // We shouldn't normally accept commits if there isn't an OutputSurface.
   if (!HasInitializedOutputSurface())
     return false;
@@ -870,6 +882,10 @@ void SchedulerStateMachine::OnBeginImplFrame(const BeginFrameArgs& args) {
   last_begin_impl_frame_args_ = args;
   DCHECK_EQ(begin_impl_frame_state_, BEGIN_IMPL_FRAME_STATE_IDLE) << *AsValue();
   begin_impl_frame_state_ = BEGIN_IMPL_FRAME_STATE_BEGIN_FRAME_STARTING;
+
+  skip_begin_main_frame_to_reduce_latency_ =
+      skip_next_begin_main_frame_to_reduce_latency_;
+  skip_next_begin_main_frame_to_reduce_latency_ = false;
 }
 
 void SchedulerStateMachine::OnBeginImplFrameDeadlinePending() {
@@ -920,9 +936,53 @@ bool SchedulerStateMachine::ShouldTriggerBeginImplFrameDeadlineEarly() const {
   if (smoothness_takes_priority_)
     return true;
 
+  // A main thread in high latency mode won't produce a tree for this frame,
+  // so waiting for it only delays the impl-thread draw.
+  if (MainThreadIsInHighLatencyMode())
+    return true;
+
   return false;
 }
 
+bool SchedulerStateMachine::MainThreadIsInHighLatencyMode() const {
+  // If a commit is pending before the previous commit has been drawn, we
+  // are definitely in high latency mode.
+  if (CommitPending() && (active_tree_needs_first_draw_ || has_pending_tree_))
+    return true;
+
+  // If we just sent a BeginMainFrame and haven't hit the deadline yet, the
+  // main thread is in low latency mode.
+  if (HasSentBeginMainFrameThisFrame() &&
+      (begin_impl_frame_state_ == BEGIN_IMPL_FRAME_STATE_BEGIN_FRAME_STARTING ||
+       begin_impl_frame_state_ == BEGIN_IMPL_FRAME_STATE_INSIDE_BEGIN_FRAME))
+    return false;
+
+  // Any other commit in progress is either from a previous frame or was
+  // started after this frame's deadline.
+  if (CommitPending())
+    return true;
+
+  // Likewise a pending tree is either from a previous frame or will only be
+  // drawn in the next one, as the active tree is being drawn in this one.
+  if (has_pending_tree_)
+    return true;
+
+  if (begin_impl_frame_state_ == BEGIN_IMPL_FRAME_STATE_INSIDE_DEADLINE) {
+    // A new active tree drawn or about to be drawn at this deadline may
+    // still have been requested by an earlier BeginImplFrame.
+    return (active_tree_needs_first_draw_ || HasSwappedThisFrame()) &&
+           !HasSentBeginMainFrameThisFrame();
+  }
+
+  // An active tree waiting for its first draw in any other state means the
+  // main thread is in high latency mode.
+  return active_tree_needs_first_draw_;
+}
+
+void SchedulerStateMachine::SetSkipNextBeginMainFrameToReduceLatency() {
+  skip_next_begin_main_frame_to_reduce_latency_ = true;
+}
+
 void SchedulerStateMachine::DidEnterPollForAnticipatedDrawTriggers() {
   current_frame_number_++;
   inside_poll_for_anticipated_draw_triggers_ = true;
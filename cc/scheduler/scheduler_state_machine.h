@@ -142,6 +142,17 @@ class CC_EXPORT SchedulerStateMachine {
   void OnBeginImplFrameDeadline();
   void OnBeginImplFrameIdle();
   bool ShouldTriggerBeginImplFrameDeadlineEarly() const;
+
+  // The main thread is in high latency mode if its commits are drawn a frame
+  // or more after the BeginImplFrame that requested them, rather than at
+  // that frame's deadline.
+  bool MainThreadIsInHighLatencyMode() const;
+
+  // Skips sending the BeginMainFrame during the next BeginImplFrame, so that
+  // a main thread in high latency mode can catch up and have its next commit
+  // drawn in the frame that requested it.
+  void SetSkipNextBeginMainFrameToReduceLatency();
+
   BeginImplFrameState begin_impl_frame_state() const {
     return begin_impl_frame_state_;
   }
@@ -290,6 +301,8 @@ class CC_EXPORT SchedulerStateMachine {
   bool draw_if_possible_failed_;
   bool did_create_and_initialize_first_output_surface_;
   bool smoothness_takes_priority_;
+  bool skip_next_begin_main_frame_to_reduce_latency_;
+  bool skip_begin_main_frame_to_reduce_latency_;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(SchedulerStateMachine);
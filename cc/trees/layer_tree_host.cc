@@ -57,7 +57,8 @@ RendererCapabilities::RendererCapabilities()
       avoid_pow2_textures(false),
       using_map_image(false),
       using_shared_memory_resources(false),
-      using_discard_framebuffer(false) {}
+      using_discard_framebuffer(false),
+      using_overlays(false) {}
 
 RendererCapabilities::~RendererCapabilities() {}
 
@@ -835,6 +836,11 @@ bool LayerTreeHost::UpdateLayers(Layer* root_layer,
         can_render_to_separate_surface,
         settings_.layer_transforms_should_scale_layer_contents,
         &update_list);
+    // What the last walk recorded about a subtree can't be trusted once
+    // layers have been added to or removed from the tree.
+    if (needs_full_tree_sync_)
+      draw_properties_cache_.Clear();
+    inputs.draw_properties_cache = &draw_properties_cache_;
     LayerTreeHostCommon::CalculateDrawProperties(&inputs);
 
     if (total_frames_used_for_lcd_text_metrics_ <=
@@ -89,6 +89,7 @@ struct CC_EXPORT RendererCapabilities {
   bool using_map_image;
   bool using_shared_memory_resources;
   bool using_discard_framebuffer;
+  bool using_overlays;
 };
 
 class CC_EXPORT UIResourceRequest {
@@ -138,8 +139,10 @@ class CC_EXPORT LayerTreeHost : NON_EXPORTED_BASE(public RateLimiterClient) {
   static bool AnyLayerTreeHostInstanceExists();
 
   void set_needs_filter_context() { needs_filter_context_ = true; }
+  // GPU rasterization draws tiles with the offscreen context.
   bool needs_offscreen_context() const {
-    return needs_filter_context_;
+    return needs_filter_context_ ||
+        (settings_.impl_side_painting && settings_.gpu_rasterization);
   }
 
   // LayerTreeHost interface to Proxy.
@@ -383,6 +386,7 @@ class CC_EXPORT LayerTreeHost : NON_EXPORTED_BASE(public RateLimiterClient) {
 
   bool animating_;
   bool needs_full_tree_sync_;
+  LayerTreeHostCommon::DrawPropertiesCache draw_properties_cache_;
   bool needs_filter_context_;
 
   base::CancelableClosure prepaint_callback_;
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 
+#include "base/containers/hash_tables.h"
 #include "base/debug/trace_event.h"
 #include "cc/base/math_util.h"
 #include "cc/layers/heads_up_display_layer_impl.h"
@@ -1102,6 +1103,7 @@ struct SubtreeGlobals {
   const LayerType* page_scale_application_layer;
   bool can_adjust_raster_scales;
   bool can_render_to_separate_surface;
+  LayerTreeHostCommon::DrawPropertiesCache::Data* draw_properties_cache;
 };
 
 template<typename LayerType>
@@ -1262,6 +1264,323 @@ static void SortLayerListContributions(
     (*unsorted)[i + start_index_for_all_contributions] = buffer[i];
 }
 
+// The state of a main thread layer tree walk that the draw properties of a
+// subtree depend on, beyond the layers in the subtree themselves. Records are
+// kept in visiting order, so the records of a layer's subtree are the
+// |subtree_size| records starting at the layer's own.
+struct LayerTreeHostCommon::DrawPropertiesCache::Data {
+  struct Record {
+    Layer* layer;
+    int layer_id;
+
+    // What the layer's walk read from its ancestors.
+    DataForRecursion<Layer> data_from_ancestor;
+    Layer* parent;
+    float parent_draw_opacity;
+    bool parent_draw_opacity_is_animating;
+    bool parent_screen_space_opacity_is_animating;
+    bool parent_draw_transform_is_animating;
+    bool parent_screen_space_transform_is_animating;
+    Layer* parent_render_target;
+    bool parent_render_target_is_clipped;
+    gfx::Rect parent_render_target_clip_rect;
+
+    // What the layer's walk did besides computing its draw properties.
+    bool visited;
+    bool added_to_layer_list;
+
+    size_t subtree_size;
+    bool subtree_is_reusable;
+
+    // What the subtree added to its target's accumulated drawable content
+    // rect.
+    gfx::Rect drawable_content_rect;
+  };
+
+  Data() : has_globals(false), can_reuse(false), num_reused_layers(0) {}
+
+  SubtreeGlobals<Layer> globals;
+  bool has_globals;
+  bool can_reuse;
+  size_t num_reused_layers;
+
+  // The records of the last walk, and those of the walk in progress.
+  std::vector<Record> records;
+  base::hash_map<int, size_t> record_indices;
+  std::vector<Record> next_records;
+  base::hash_map<int, size_t> next_record_indices;
+};
+
+LayerTreeHostCommon::DrawPropertiesCache::DrawPropertiesCache()
+    : data_(new Data) {}
+
+LayerTreeHostCommon::DrawPropertiesCache::~DrawPropertiesCache() {}
+
+void LayerTreeHostCommon::DrawPropertiesCache::Clear() {
+  data_.reset(new Data);
+}
+
+size_t LayerTreeHostCommon::DrawPropertiesCache::num_reused_layers() const {
+  return data_->num_reused_layers;
+}
+
+static bool SubtreeGlobalsAreEqual(const SubtreeGlobals<Layer>& a,
+                                   const SubtreeGlobals<Layer>& b) {
+  return a.layer_sorter == b.layer_sorter &&
+         a.max_texture_size == b.max_texture_size &&
+         a.device_scale_factor == b.device_scale_factor &&
+         a.page_scale_factor == b.page_scale_factor &&
+         a.page_scale_application_layer == b.page_scale_application_layer &&
+         a.can_adjust_raster_scales == b.can_adjust_raster_scales &&
+         a.can_render_to_separate_surface == b.can_render_to_separate_surface;
+}
+
+static bool DataForRecursionIsEqual(const DataForRecursion<Layer>& a,
+                                    const DataForRecursion<Layer>& b) {
+  return a.parent_matrix == b.parent_matrix &&
+         a.full_hierarchy_matrix == b.full_hierarchy_matrix &&
+         a.scroll_compensation_matrix == b.scroll_compensation_matrix &&
+         a.fixed_container == b.fixed_container &&
+         a.clip_rect_in_target_space == b.clip_rect_in_target_space &&
+         a.clip_rect_of_target_surface_in_target_space ==
+             b.clip_rect_of_target_surface_in_target_space &&
+         a.ancestor_clips_subtree == b.ancestor_clips_subtree &&
+         a.nearest_ancestor_surface_that_moves_pixels ==
+             b.nearest_ancestor_surface_that_moves_pixels &&
+         a.in_subtree_of_page_scale_application_layer ==
+             b.in_subtree_of_page_scale_application_layer &&
+         a.subtree_can_use_lcd_text == b.subtree_can_use_lcd_text &&
+         a.subtree_is_visible_from_ancestor ==
+             b.subtree_is_visible_from_ancestor;
+}
+
+static inline void BeginCachedWalk(
+    LayerTreeHostCommon::DrawPropertiesCache::Data* cache,
+    const SubtreeGlobals<Layer>& globals) {
+  cache->can_reuse =
+      cache->has_globals && SubtreeGlobalsAreEqual(cache->globals, globals);
+  cache->globals = globals;
+  cache->has_globals = true;
+  cache->num_reused_layers = 0;
+  cache->next_records.clear();
+  cache->next_record_indices.clear();
+}
+
+static inline void EndCachedWalk(
+    LayerTreeHostCommon::DrawPropertiesCache::Data* cache) {
+  cache->records.swap(cache->next_records);
+  cache->record_indices.swap(cache->next_record_indices);
+  cache->next_records.clear();
+  cache->next_record_indices.clear();
+}
+
+// Whether the draw properties of |layer| can only depend on its ancestors
+// through the parent state and DataForRecursion kept in its record, and it
+// does nothing but compute them, append itself to the layer list and add to
+// its target's drawable content rect.
+static bool LayerDrawPropertiesAreLocal(Layer* layer) {
+  if (!layer->layer_tree_host() || layer->render_surface())
+    return false;
+  if (layer->clip_parent() || layer->clip_children() ||
+      layer->scroll_parent() || layer->scroll_children())
+    return false;
+  if (layer->num_unclipped_descendants() ||
+      layer->draw_properties().has_child_with_a_scroll_parent)
+    return false;
+  if (layer->position_constraint().is_fixed_position())
+    return false;
+  if (layer->layer_animation_controller()->has_any_animation())
+    return false;
+  if (layer->HasCopyRequest() || layer->HasDelegatedContent())
+    return false;
+  if (layer->mask_layer() || layer->replica_layer() || layer->preserves_3d())
+    return false;
+  return true;
+}
+
+// On the main thread, layers that have changed since the last commit need to
+// push their properties, and ancestors know about it. When neither |layer|
+// nor any of its descendants has changed and the inputs to its subtree are
+// the same as in the last walk, this replays what that walk did for the
+// subtree instead of walking it again; the layers' draw properties are still
+// the ones it computed. Returns false if the subtree has to be walked.
+static inline bool ReuseCachedSubtree(
+    LayerImpl* layer,
+    const SubtreeGlobals<LayerImpl>& globals,
+    const DataForRecursion<LayerImpl>& data_from_ancestor,
+    LayerImplList* layer_list,
+    std::vector<AccumulatedSurfaceState<LayerImpl> >*
+        accumulated_surface_state) {
+  return false;
+}
+
+static bool ReuseCachedSubtree(
+    Layer* layer,
+    const SubtreeGlobals<Layer>& globals,
+    const DataForRecursion<Layer>& data_from_ancestor,
+    RenderSurfaceLayerList* layer_list,
+    std::vector<AccumulatedSurfaceState<Layer> >* accumulated_surface_state) {
+  typedef LayerTreeHostCommon::DrawPropertiesCache::Data Cache;
+  Cache* cache = globals.draw_properties_cache;
+  if (!cache || !cache->can_reuse)
+    return false;
+  if (layer->parent_should_know_need_push_properties())
+    return false;
+
+  base::hash_map<int, size_t>::const_iterator it =
+      cache->record_indices.find(layer->id());
+  if (it == cache->record_indices.end())
+    return false;
+  const Cache::Record& record = cache->records[it->second];
+  if (record.layer != layer || !record.subtree_is_reusable)
+    return false;
+
+  Layer* parent = layer->parent();
+  Layer* parent_render_target = parent->render_target();
+  if (record.parent != parent ||
+      record.parent_draw_opacity != parent->draw_opacity() ||
+      record.parent_draw_opacity_is_animating !=
+          parent->draw_opacity_is_animating() ||
+      record.parent_screen_space_opacity_is_animating !=
+          parent->screen_space_opacity_is_animating() ||
+      record.parent_draw_transform_is_animating !=
+          parent->draw_transform_is_animating() ||
+      record.parent_screen_space_transform_is_animating !=
+          parent->screen_space_transform_is_animating() ||
+      record.parent_render_target != parent_render_target ||
+      record.parent_render_target_is_clipped !=
+          parent_render_target->is_clipped() ||
+      record.parent_render_target_clip_rect !=
+          parent_render_target->clip_rect())
+    return false;
+  if (!DataForRecursionIsEqual(record.data_from_ancestor, data_from_ancestor))
+    return false;
+
+  for (size_t i = it->second; i < it->second + record.subtree_size; ++i) {
+    const Cache::Record& replayed = cache->records[i];
+    cache->next_record_indices[replayed.layer_id] = cache->next_records.size();
+    cache->next_records.push_back(replayed);
+    if (replayed.added_to_layer_list)
+      layer_list->push_back(replayed.layer);
+    if (replayed.visited)
+      SavePaintPropertiesLayer(replayed.layer);
+  }
+  accumulated_surface_state->back().drawable_content_rect.Union(
+      record.drawable_content_rect);
+  cache->num_reused_layers += record.subtree_size;
+  return true;
+}
+
+// Starts the record of a subtree that is about to be walked, returning its
+// index, and takes aside the target's accumulated drawable content rect so
+// that the subtree's contribution can be told apart.
+static inline size_t BeginCachedSubtree(
+    LayerImpl* layer,
+    const SubtreeGlobals<LayerImpl>& globals,
+    const DataForRecursion<LayerImpl>& data_from_ancestor,
+    std::vector<AccumulatedSurfaceState<LayerImpl> >*
+        accumulated_surface_state) {
+  return 0;
+}
+
+static size_t BeginCachedSubtree(
+    Layer* layer,
+    const SubtreeGlobals<Layer>& globals,
+    const DataForRecursion<Layer>& data_from_ancestor,
+    std::vector<AccumulatedSurfaceState<Layer> >* accumulated_surface_state) {
+  typedef LayerTreeHostCommon::DrawPropertiesCache::Data Cache;
+  Cache* cache = globals.draw_properties_cache;
+  if (!cache)
+    return 0;
+
+  Layer* parent = layer->parent();
+  Layer* parent_render_target = parent->render_target();
+  Cache::Record record;
+  record.layer = layer;
+  record.layer_id = layer->id();
+  record.data_from_ancestor = data_from_ancestor;
+  record.parent = parent;
+  record.parent_draw_opacity = parent->draw_opacity();
+  record.parent_draw_opacity_is_animating = parent->draw_opacity_is_animating();
+  record.parent_screen_space_opacity_is_animating =
+      parent->screen_space_opacity_is_animating();
+  record.parent_draw_transform_is_animating =
+      parent->draw_transform_is_animating();
+  record.parent_screen_space_transform_is_animating =
+      parent->screen_space_transform_is_animating();
+  record.parent_render_target = parent_render_target;
+  record.parent_render_target_is_clipped = parent_render_target->is_clipped();
+  record.parent_render_target_clip_rect = parent_render_target->clip_rect();
+  record.visited = false;
+  record.added_to_layer_list = false;
+  record.subtree_size = 0;
+  record.subtree_is_reusable = false;
+  // Hold the target's rect so far until EndCachedSubtree().
+  std::swap(record.drawable_content_rect,
+            accumulated_surface_state->back().drawable_content_rect);
+
+  size_t index = cache->next_records.size();
+  cache->next_record_indices[record.layer_id] = index;
+  cache->next_records.push_back(record);
+  return index;
+}
+
+// Notes on the record of |layer|, which is being walked, that it wasn't
+// skipped and whether it was appended to its target's layer list.
+static inline void NoteLayerVisitedForCache(
+    LayerImpl* layer,
+    const SubtreeGlobals<LayerImpl>& globals,
+    bool added_to_layer_list) {}
+
+static inline void NoteLayerVisitedForCache(Layer* layer,
+                                            const SubtreeGlobals<Layer>& globals,
+                                            bool added_to_layer_list) {
+  LayerTreeHostCommon::DrawPropertiesCache::Data* cache =
+      globals.draw_properties_cache;
+  if (!cache || IsRootLayer(layer))
+    return;
+  // Nothing has been recorded since the layer's own record.
+  DCHECK(cache->next_records.back().layer == layer);
+  cache->next_records.back().visited = true;
+  cache->next_records.back().added_to_layer_list = added_to_layer_list;
+}
+
+static inline void EndCachedSubtree(
+    LayerImpl* layer,
+    const SubtreeGlobals<LayerImpl>& globals,
+    size_t index,
+    std::vector<AccumulatedSurfaceState<LayerImpl> >*
+        accumulated_surface_state) {}
+
+static void EndCachedSubtree(
+    Layer* layer,
+    const SubtreeGlobals<Layer>& globals,
+    size_t index,
+    std::vector<AccumulatedSurfaceState<Layer> >* accumulated_surface_state) {
+  typedef LayerTreeHostCommon::DrawPropertiesCache::Data Cache;
+  Cache* cache = globals.draw_properties_cache;
+  if (!cache)
+    return;
+
+  Cache::Record& record = cache->next_records[index];
+  DCHECK(record.layer == layer);
+  record.subtree_size = cache->next_records.size() - index;
+
+  // A subtree can be reused if all of its layers can, which the records of
+  // the layer's children already know about their subtrees.
+  bool subtree_is_reusable = LayerDrawPropertiesAreLocal(layer);
+  for (size_t i = index + 1;
+       subtree_is_reusable && i < index + record.subtree_size;
+       i += cache->next_records[i].subtree_size)
+    subtree_is_reusable = cache->next_records[i].subtree_is_reusable;
+  record.subtree_is_reusable = subtree_is_reusable;
+
+  gfx::Rect& target_rect =
+      accumulated_surface_state->back().drawable_content_rect;
+  std::swap(record.drawable_content_rect, target_rect);
+  target_rect.Union(record.drawable_content_rect);
+}
+
 // Recursively walks the layer tree starting at the given node and computes all
 // the necessary transformations, clip rects, render surfaces, etc.
 template <typename LayerType>
@@ -1847,8 +2166,10 @@ static void CalculateDrawPropertiesInternal(
   // and should be included in the sorting process.
   size_t sorting_start_index = descendants.size();
 
-  if (!LayerShouldBeSkipped(layer, layer_is_visible))
+  bool layer_is_added = !LayerShouldBeSkipped(layer, layer_is_visible);
+  if (layer_is_added)
     descendants.push_back(layer);
+  NoteLayerVisitedForCache(layer, globals, layer_is_added);
 
   // Any layers that are appended after this point may need to be sorted if we
   // visit the children out of order.
@@ -1920,12 +2241,21 @@ static void CalculateDrawPropertiesInternal(
     child->draw_properties().index_of_first_render_surface_layer_list_addition =
         render_surface_layer_list->size();
 
-    CalculateDrawPropertiesInternal<LayerType>(child,
-                                               globals,
-                                               data_for_children,
-                                               render_surface_layer_list,
-                                               &descendants,
-                                               accumulated_surface_state);
+    if (!ReuseCachedSubtree(child,
+                            globals,
+                            data_for_children,
+                            &descendants,
+                            accumulated_surface_state)) {
+      size_t cache_index = BeginCachedSubtree(
+          child, globals, data_for_children, accumulated_surface_state);
+      CalculateDrawPropertiesInternal<LayerType>(child,
+                                                 globals,
+                                                 data_for_children,
+                                                 render_surface_layer_list,
+                                                 &descendants,
+                                                 accumulated_surface_state);
+      EndCachedSubtree(child, globals, cache_index, accumulated_surface_state);
+    }
     if (child->render_surface() &&
         !child->render_surface()->content_rect().IsEmpty()) {
       descendants.push_back(child);
@@ -2128,6 +2458,9 @@ void LayerTreeHostCommon::CalculateDrawProperties(
   globals.can_render_to_separate_surface =
       inputs->can_render_to_separate_surface;
   globals.can_adjust_raster_scales = inputs->can_adjust_raster_scales;
+  globals.draw_properties_cache =
+      inputs->draw_properties_cache ? inputs->draw_properties_cache->data()
+                                    : NULL;
 
   DataForRecursion<Layer> data_for_recursion;
   data_for_recursion.parent_matrix = scaled_device_transform;
@@ -2146,12 +2479,16 @@ void LayerTreeHostCommon::CalculateDrawProperties(
   PreCalculateMetaInformationRecursiveData recursive_data;
   PreCalculateMetaInformation(inputs->root_layer, &recursive_data);
   std::vector<AccumulatedSurfaceState<Layer> > accumulated_surface_state;
+  if (globals.draw_properties_cache)
+    BeginCachedWalk(globals.draw_properties_cache, globals);
   CalculateDrawPropertiesInternal<Layer>(inputs->root_layer,
                                          globals,
                                          data_for_recursion,
                                          inputs->render_surface_layer_list,
                                          &dummy_layer_list,
                                          &accumulated_surface_state);
+  if (globals.draw_properties_cache)
+    EndCachedWalk(globals.draw_properties_cache);
 
   // The dummy layer list should not have been used.
   DCHECK_EQ(0u, dummy_layer_list.size());
@@ -2186,6 +2523,9 @@ void LayerTreeHostCommon::CalculateDrawProperties(
   globals.can_render_to_separate_surface =
       inputs->can_render_to_separate_surface;
   globals.can_adjust_raster_scales = inputs->can_adjust_raster_scales;
+  // Impl side layers don't track what changed since the last walk.
+  DCHECK(!inputs->draw_properties_cache);
+  globals.draw_properties_cache = NULL;
 
   DataForRecursion<LayerImpl> data_for_recursion;
   data_for_recursion.parent_matrix = scaled_device_transform;
@@ -8,8 +8,10 @@
 #include <limits>
 #include <vector>
 
+#include "base/basictypes.h"
 #include "base/bind.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
 #include "cc/base/cc_export.h"
 #include "cc/base/scoped_ptr_vector.h"
 #include "cc/layers/layer_lists.h"
@@ -28,6 +30,33 @@ class CC_EXPORT LayerTreeHostCommon {
                                         gfx::Rect layer_bound_rect,
                                         const gfx::Transform& transform);
 
+  // Remembers how CalculateDrawProperties() walked a main thread layer tree,
+  // so that the next walk can keep the draw properties of subtrees that
+  // haven't changed instead of computing them again. A subtree is kept when
+  // none of its layers needs to push properties and what it gets from its
+  // ancestors is the same as before. Subtrees with render surfaces,
+  // animations, fixed-position layers or clip and scroll parents are always
+  // walked. A cache belongs to one tree and must be cleared whenever layers
+  // are added to or removed from it.
+  class CC_EXPORT DrawPropertiesCache {
+   public:
+    DrawPropertiesCache();
+    ~DrawPropertiesCache();
+
+    void Clear();
+
+    // The number of layers whose draw properties the last walk kept.
+    size_t num_reused_layers() const;
+
+    struct Data;
+    Data* data() { return data_.get(); }
+
+   private:
+    scoped_ptr<Data> data_;
+
+    DISALLOW_COPY_AND_ASSIGN(DrawPropertiesCache);
+  };
+
   template <typename LayerType, typename RenderSurfaceLayerListType>
   struct CalcDrawPropsInputs {
    public:
@@ -52,7 +81,8 @@ class CC_EXPORT LayerTreeHostCommon {
           can_use_lcd_text(can_use_lcd_text),
           can_render_to_separate_surface(can_render_to_separate_surface),
           can_adjust_raster_scales(can_adjust_raster_scales),
-          render_surface_layer_list(render_surface_layer_list) {}
+          render_surface_layer_list(render_surface_layer_list),
+          draw_properties_cache(NULL) {}
 
     LayerType* root_layer;
     gfx::Size device_viewport_size;
@@ -65,6 +95,8 @@ class CC_EXPORT LayerTreeHostCommon {
     bool can_render_to_separate_surface;
     bool can_adjust_raster_scales;
     RenderSurfaceLayerListType* render_surface_layer_list;
+    // Optional, and only supported for main thread layers.
+    DrawPropertiesCache* draw_properties_cache;
   };
 
   template <typename LayerType, typename RenderSurfaceLayerListType>
@@ -113,6 +113,79 @@ class CalcDrawPropsMainTest : public LayerTreeHostCommonPerfTest {
   }
 };
 
+// Measures the main thread walk with a DrawPropertiesCache, after a commit
+// has cleared every layer's need to push properties. Optionally one leaf
+// layer moves on every lap.
+class CalcDrawPropsMainCachedTest : public LayerTreeHostCommonPerfTest {
+ public:
+  CalcDrawPropsMainCachedTest() : move_leaf_layer_(false), measured_(false) {}
+
+  void RunCalcDrawProps(bool move_leaf_layer) {
+    move_leaf_layer_ = move_leaf_layer;
+    RunTest(false, false, false);
+  }
+
+  virtual void BeginTest() OVERRIDE {
+    PostSetNeedsCommitToMainThread();
+  }
+
+  virtual void DidCommit() OVERRIDE {
+    // Moving the leaf layer asks for more commits.
+    if (measured_)
+      return;
+    measured_ = true;
+
+    Layer* leaf = layer_tree_host()->root_layer();
+    while (!leaf->children().empty())
+      leaf = leaf->children().back().get();
+    gfx::PointF leaf_position = leaf->position();
+
+    LayerTreeHostCommon::DrawPropertiesCache cache;
+    timer_.Reset();
+
+    do {
+      if (move_leaf_layer_) {
+        leaf->SetPosition(leaf_position +
+                          gfx::Vector2dF(0.f, timer_.NumLaps() % 2));
+      }
+
+      bool can_render_to_separate_surface = true;
+      int max_texture_size = 8096;
+      RenderSurfaceLayerList update_list;
+      LayerTreeHostCommon::CalcDrawPropsMainInputs inputs(
+          layer_tree_host()->root_layer(),
+          layer_tree_host()->device_viewport_size(),
+          gfx::Transform(),
+          layer_tree_host()->device_scale_factor(),
+          layer_tree_host()->page_scale_factor(),
+          layer_tree_host()->page_scale_layer(),
+          max_texture_size,
+          layer_tree_host()->settings().can_use_lcd_text,
+          can_render_to_separate_surface,
+          layer_tree_host()
+              ->settings()
+              .layer_transforms_should_scale_layer_contents,
+          &update_list);
+      inputs.draw_properties_cache = &cache;
+      LayerTreeHostCommon::CalculateDrawProperties(&inputs);
+
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("calc_draw_props_reused_layers",
+                           "",
+                           test_name_,
+                           cache.num_reused_layers(),
+                           "count",
+                           true);
+    EndTest();
+  }
+
+ private:
+  bool move_leaf_layer_;
+  bool measured_;
+};
+
 class CalcDrawPropsImplTest : public LayerTreeHostCommonPerfTest {
  public:
   void RunCalcDrawProps() {
@@ -176,6 +249,30 @@ TEST_F(CalcDrawPropsMainTest, TouchRegionHeavy) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsMainCachedTest, TenTen) {
+  SetTestName("10_10_cached");
+  ReadTestFile("10_10_layer_tree");
+  RunCalcDrawProps(false);
+}
+
+TEST_F(CalcDrawPropsMainCachedTest, TenTenMovingLeaf) {
+  SetTestName("10_10_cached_moving_leaf");
+  ReadTestFile("10_10_layer_tree");
+  RunCalcDrawProps(true);
+}
+
+TEST_F(CalcDrawPropsMainCachedTest, HeavyPage) {
+  SetTestName("heavy_page_cached");
+  ReadTestFile("heavy_layer_tree");
+  RunCalcDrawProps(false);
+}
+
+TEST_F(CalcDrawPropsMainCachedTest, HeavyPageMovingLeaf) {
+  SetTestName("heavy_page_cached_moving_leaf");
+  ReadTestFile("heavy_layer_tree");
+  RunCalcDrawProps(true);
+}
+
 TEST_F(CalcDrawPropsImplTest, TenTen) {
   SetTestName("10_10");
   ReadTestFile("10_10_layer_tree");
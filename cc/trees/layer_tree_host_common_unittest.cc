@@ -26,6 +26,7 @@
 #include "cc/trees/layer_tree_impl.h"
 #include "cc/trees/proxy.h"
 #include "cc/trees/single_thread_proxy.h"
+#include "cc/trees/tree_synchronizer.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "ui/gfx/quad_f.h"
@@ -9745,5 +9746,118 @@ TEST_F(LayerTreeHostCommonTest, ScrollCompensationWithRounding) {
   }
 }
 
+// Returns the number of layers drawn into the root surface.
+static size_t CalculateDrawPropertiesWithCache(
+    Layer* root_layer,
+    LayerTreeHostCommon::DrawPropertiesCache* cache) {
+  RenderSurfaceLayerList render_surface_layer_list;
+  LayerTreeHostCommon::CalcDrawPropsMainInputsForTesting inputs(
+      root_layer, root_layer->bounds(), &render_surface_layer_list);
+  inputs.draw_properties_cache = cache;
+  LayerTreeHostCommon::CalculateDrawProperties(&inputs);
+  return root_layer->render_surface()->layer_list().size();
+}
+
+TEST_F(LayerTreeHostCommonTest, DrawPropertiesCacheReusesUnchangedSubtrees) {
+  scoped_refptr<Layer> root = Layer::Create();
+  scoped_refptr<LayerWithForcedDrawsContent> child1 =
+      make_scoped_refptr(new LayerWithForcedDrawsContent());
+  scoped_refptr<LayerWithForcedDrawsContent> grand_child1 =
+      make_scoped_refptr(new LayerWithForcedDrawsContent());
+  scoped_refptr<LayerWithForcedDrawsContent> child2 =
+      make_scoped_refptr(new LayerWithForcedDrawsContent());
+  scoped_refptr<LayerWithForcedDrawsContent> grand_child2 =
+      make_scoped_refptr(new LayerWithForcedDrawsContent());
+  root->AddChild(child1);
+  child1->AddChild(grand_child1);
+  root->AddChild(child2);
+  child2->AddChild(grand_child2);
+
+  scoped_ptr<FakeLayerTreeHost> host = FakeLayerTreeHost::Create();
+  host->SetRootLayer(root);
+
+  gfx::Transform identity_matrix;
+  SetLayerPropertiesForTesting(root.get(),
+                               identity_matrix,
+                               identity_matrix,
+                               gfx::PointF(),
+                               gfx::PointF(),
+                               gfx::Size(100, 100),
+                               false);
+  SetLayerPropertiesForTesting(child1.get(),
+                               identity_matrix,
+                               identity_matrix,
+                               gfx::PointF(),
+                               gfx::PointF(10.f, 10.f),
+                               gfx::Size(20, 20),
+                               false);
+  SetLayerPropertiesForTesting(grand_child1.get(),
+                               identity_matrix,
+                               identity_matrix,
+                               gfx::PointF(),
+                               gfx::PointF(1.f, 1.f),
+                               gfx::Size(5, 5),
+                               false);
+  SetLayerPropertiesForTesting(child2.get(),
+                               identity_matrix,
+                               identity_matrix,
+                               gfx::PointF(),
+                               gfx::PointF(50.f, 50.f),
+                               gfx::Size(20, 20),
+                               false);
+  SetLayerPropertiesForTesting(grand_child2.get(),
+                               identity_matrix,
+                               identity_matrix,
+                               gfx::PointF(),
+                               gfx::PointF(2.f, 2.f),
+                               gfx::Size(5, 5),
+                               false);
+
+  LayerTreeHostCommon::DrawPropertiesCache cache;
+  EXPECT_EQ(4u, CalculateDrawPropertiesWithCache(root.get(), &cache));
+  EXPECT_EQ(0u, cache.num_reused_layers());
+
+  // Nothing is reused while the layers still need to push their properties.
+  EXPECT_EQ(4u, CalculateDrawPropertiesWithCache(root.get(), &cache));
+  EXPECT_EQ(0u, cache.num_reused_layers());
+
+  FakeImplProxy proxy;
+  FakeLayerTreeHostImpl host_impl(&proxy);
+  scoped_ptr<LayerImpl> root_impl = TreeSynchronizer::SynchronizeTrees(
+      root.get(), scoped_ptr<LayerImpl>(), host_impl.active_tree());
+  TreeSynchronizer::PushProperties(root.get(), root_impl.get());
+  ASSERT_FALSE(root->descendant_needs_push_properties());
+
+  EXPECT_EQ(4u, CalculateDrawPropertiesWithCache(root.get(), &cache));
+  EXPECT_EQ(4u, cache.num_reused_layers());
+
+  gfx::Transform expected_grand_child1_transform;
+  expected_grand_child1_transform.Translate(11.0, 11.0);
+  gfx::Transform expected_grand_child2_transform;
+  expected_grand_child2_transform.Translate(52.0, 52.0);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected_grand_child1_transform,
+                                  grand_child1->draw_transform());
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected_grand_child2_transform,
+                                  grand_child2->draw_transform());
+
+  // Moving a child walks its subtree again, and only that one.
+  child1->SetPosition(gfx::PointF(20.f, 20.f));
+  EXPECT_EQ(4u, CalculateDrawPropertiesWithCache(root.get(), &cache));
+  EXPECT_EQ(2u, cache.num_reused_layers());
+
+  expected_grand_child1_transform.MakeIdentity();
+  expected_grand_child1_transform.Translate(21.0, 21.0);
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected_grand_child1_transform,
+                                  grand_child1->draw_transform());
+  EXPECT_TRANSFORMATION_MATRIX_EQ(expected_grand_child2_transform,
+                                  grand_child2->draw_transform());
+
+  // A different viewport changes every subtree's inputs.
+  TreeSynchronizer::PushProperties(root.get(), root_impl.get());
+  root->SetBounds(gfx::Size(200, 200));
+  EXPECT_EQ(4u, CalculateDrawPropertiesWithCache(root.get(), &cache));
+  EXPECT_EQ(0u, cache.num_reused_layers());
+}
+
 }  // namespace
 }  // namespace cc
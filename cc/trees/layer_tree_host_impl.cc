@@ -1650,13 +1650,17 @@ void LayerTreeHostImpl::CreateAndSetTileManager(
     bool using_map_image) {
   DCHECK(settings_.impl_side_painting);
   DCHECK(resource_provider);
+  ContextProvider* gpu_rasterization_context_provider =
+      settings_.gpu_rasterization ? context_provider : NULL;
   tile_manager_ =
       TileManager::Create(this,
                           resource_provider,
                           settings_.num_raster_threads,
                           rendering_stats_instrumentation_,
                           using_map_image,
-                          GetMaxTransferBufferUsageBytes(context_provider));
+                          GetMaxTransferBufferUsageBytes(context_provider),
+                          gpu_rasterization_context_provider);
+  tile_manager_->SetOffscreenContextProvider(offscreen_context_provider_.get());
 
   UpdateTileManagerMemoryPolicy(ActualManagedMemoryPolicy());
   need_to_update_visible_tiles_before_draw_ = false;
@@ -2563,17 +2567,15 @@ void LayerTreeHostImpl::SendReleaseResourcesRecursive(LayerImpl* current) {
 
 void LayerTreeHostImpl::SetOffscreenContextProvider(
     const scoped_refptr<ContextProvider>& offscreen_context_provider) {
-  if (!offscreen_context_provider.get()) {
-    offscreen_context_provider_ = NULL;
-    return;
-  }
-
-  if (!offscreen_context_provider->BindToCurrentThread()) {
+  if (offscreen_context_provider.get() &&
+      offscreen_context_provider->BindToCurrentThread())
+    offscreen_context_provider_ = offscreen_context_provider;
+  else
     offscreen_context_provider_ = NULL;
-    return;
-  }
 
-  offscreen_context_provider_ = offscreen_context_provider;
+  if (tile_manager_)
+    tile_manager_->SetOffscreenContextProvider(
+        offscreen_context_provider_.get());
 }
 
 std::string LayerTreeHostImpl::LayerTreeAsJson() const {
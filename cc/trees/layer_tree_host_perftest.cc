@@ -40,7 +40,9 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
         commit_timer_(0, base::TimeDelta(), 1),
         full_damage_each_frame_(false),
         animation_driven_drawing_(false),
-        measure_commit_cost_(false) {
+        measure_commit_cost_(false),
+        activated_tree_needs_draw_(false),
+        main_frame_to_draw_count_(0) {
     fake_content_layer_client_.set_paint_all_opaque(true);
   }
 
@@ -58,9 +60,20 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
       layer_tree_host()->SetNeedsAnimate();
   }
 
+  virtual void WillBeginMainFrame() OVERRIDE {
+    main_frame_begin_time_ = base::TimeTicks::HighResNow();
+  }
+
   virtual void BeginCommitOnThread(LayerTreeHostImpl* host_impl) OVERRIDE {
     if (measure_commit_cost_)
       commit_timer_.Start();
+    // The main thread is blocked for the commit, so its begin time is safe to
+    // read here.
+    committed_main_frame_begin_time_ = main_frame_begin_time_;
+  }
+
+  virtual void DidActivateTreeOnThread(LayerTreeHostImpl* host_impl) OVERRIDE {
+    activated_tree_needs_draw_ = true;
   }
 
   virtual void CommitCompleteOnThread(LayerTreeHostImpl* host_impl) OVERRIDE {
@@ -74,6 +87,12 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
       return;
     }
     draw_timer_.NextLap();
+    if (activated_tree_needs_draw_ && draw_timer_.IsWarmedUp()) {
+      main_frame_to_draw_time_ +=
+          base::TimeTicks::HighResNow() - committed_main_frame_begin_time_;
+      main_frame_to_draw_count_++;
+    }
+    activated_tree_needs_draw_ = false;
     if (draw_timer_.HasTimeLimitExpired()) {
       EndTest();
       return;
@@ -97,6 +116,15 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
                              commit_timer_.NumLaps(), "commit_count", true);
       perf_test::PrintResult("layer_tree_host_commit_time", "", test_name_,
                              1000 * commit_timer_.MsPerLap(), "us", true);
+      // How long main thread frames take to reach the screen, which the
+      // scheduler's deadlines are meant to keep within a single frame.
+      if (main_frame_to_draw_count_) {
+        perf_test::PrintResult(
+            "layer_tree_host_main_frame_to_draw_time", "", test_name_,
+            static_cast<size_t>(main_frame_to_draw_time_.InMicroseconds() /
+                                main_frame_to_draw_count_),
+            "us", true);
+      }
     }
   }
 
@@ -110,6 +138,12 @@ class LayerTreeHostPerfTest : public LayerTreeTest {
   bool animation_driven_drawing_;
 
   bool measure_commit_cost_;
+
+  base::TimeTicks main_frame_begin_time_;
+  base::TimeTicks committed_main_frame_begin_time_;
+  bool activated_tree_needs_draw_;
+  base::TimeDelta main_frame_to_draw_time_;
+  int main_frame_to_draw_count_;
 };
 
 
@@ -55,6 +55,7 @@ LayerTreeSettings::LayerTreeSettings()
       force_direct_layer_drawing(false),
       strict_layer_property_change_checking(false),
       use_map_image(false),
+      gpu_rasterization(false),
       ignore_root_layer_flings(false),
       use_rgba_4444_textures(false),
       always_overscroll(false),
@@ -65,6 +65,7 @@ class CC_EXPORT LayerTreeSettings {
   bool force_direct_layer_drawing;  // With Skia GPU backend.
   bool strict_layer_property_change_checking;
   bool use_map_image;
+  bool gpu_rasterization;
   bool ignore_root_layer_flings;
   bool use_rgba_4444_textures;
   bool always_overscroll;
@@ -239,19 +239,26 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
   in_zero_suggest_ = false;
   in_start_ = true;
   base::TimeTicks start_time = base::TimeTicks::Now();
-  for (ACProviders::iterator i(providers_.begin()); i != providers_.end();
-       ++i) {
+  // Tests may swap in their own providers after construction, so the
+  // histograms are looked up on first use.
+  if (provider_time_histograms_.size() != providers_.size()) {
+    provider_time_histograms_.clear();
+    for (ACProviders::const_iterator i(providers_.begin());
+         i != providers_.end(); ++i) {
+      provider_time_histograms_.push_back(base::Histogram::FactoryGet(
+          std::string("Omnibox.ProviderTime.") + (*i)->GetName(), 1, 5000, 20,
+          base::Histogram::kUmaTargetedHistogramFlag));
+    }
+  }
+  for (size_t i = 0; i < providers_.size(); ++i) {
     // TODO(mpearson): Remove timing code once bugs 178705 / 237703 / 168933
     // are resolved.
     base::TimeTicks provider_start_time = base::TimeTicks::Now();
-    (*i)->Start(input_, minimal_changes);
+    providers_[i]->Start(input_, minimal_changes);
     if (input.matches_requested() != AutocompleteInput::ALL_MATCHES)
-      DCHECK((*i)->done());
+      DCHECK(providers_[i]->done());
     base::TimeTicks provider_end_time = base::TimeTicks::Now();
-    std::string name = std::string("Omnibox.ProviderTime.") + (*i)->GetName();
-    base::HistogramBase* counter = base::Histogram::FactoryGet(
-        name, 1, 5000, 20, base::Histogram::kUmaTargetedHistogramFlag);
-    counter->Add(static_cast<int>(
+    provider_time_histograms_[i]->Add(static_cast<int>(
         (provider_end_time - provider_start_time).InMilliseconds()));
   }
   if (input.matches_requested() == AutocompleteInput::ALL_MATCHES &&
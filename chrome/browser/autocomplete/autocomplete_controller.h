@@ -5,6 +5,8 @@
 #ifndef CHROME_BROWSER_AUTOCOMPLETE_AUTOCOMPLETE_CONTROLLER_H_
 #define CHROME_BROWSER_AUTOCOMPLETE_AUTOCOMPLETE_CONTROLLER_H_
 
+#include <vector>
+
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
 #include "base/gtest_prod_util.h"
@@ -23,6 +25,10 @@ class Profile;
 class SearchProvider;
 class ZeroSuggestProvider;
 
+namespace base {
+class HistogramBase;
+}
+
 // The AutocompleteController is the center of the autocomplete system.  A
 // class creates an instance of the controller, which in turn creates a set of
 // AutocompleteProviders to serve it.  The owning class can ask the controller
@@ -191,6 +197,11 @@ class AutocompleteController : public AutocompleteProviderListener {
   // A list of all providers.
   ACProviders providers_;
 
+  // The "Omnibox.ProviderTime.<name>" histogram of each provider, parallel to
+  // |providers_|. They're looked up once rather than by name on every
+  // keystroke.
+  std::vector<base::HistogramBase*> provider_time_histograms_;
+
   HistoryURLProvider* history_url_provider_;
 
   KeywordProvider* keyword_provider_;
@@ -805,6 +805,15 @@ int ChromeBrowserMainParts::PreCreateThreadsImpl() {
                                                   parsed_command_line()));
   }
 
+  if (parsed_command_line().HasSwitch(switches::kProfilingSamplingInterval)) {
+    int interval = 1;
+    if (base::StringToInt(parsed_command_line().GetSwitchValueASCII(
+            switches::kProfilingSamplingInterval), &interval) &&
+        interval >= 1) {
+      tracked_objects::ThreadData::SetSamplingInterval(interval);
+    }
+  }
+
   if (parsed_command_line().HasSwitch(switches::kEnableProfiling)) {
     TRACE_EVENT0("startup",
         "ChromeBrowserMainParts::PreCreateThreadsImpl:InitProfiling");
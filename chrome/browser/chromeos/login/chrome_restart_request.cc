@@ -162,9 +162,11 @@ std::string DeriveCommandLine(const GURL& start_url,
       cc::switches::kCompositeToMailbox,
       cc::switches::kDisableCompositedAntialiasing,
       cc::switches::kDisableCompositorTouchHitTesting,
+      cc::switches::kDisableGPURasterization,
       cc::switches::kDisableImplSidePainting,
       cc::switches::kDisableMapImage,
       cc::switches::kDisableThreadedAnimation,
+      cc::switches::kEnableGPURasterization,
       cc::switches::kEnableImplSidePainting,
       cc::switches::kEnableMapImage,
       cc::switches::kEnablePartialSwap,
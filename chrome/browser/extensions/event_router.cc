@@ -596,9 +596,11 @@ void EventRouter::DispatchEventToProcess(const std::string& extension_id,
   ProcessMap* process_map = ExtensionSystem::Get(listener_profile)->
       extension_service()->process_map();
   // If the event is privileged, only send to extension processes. Otherwise,
-  // it's OK to send to normal renderers (e.g., for content scripts).
-  if (ExtensionAPI::GetSharedInstance()->IsPrivileged(event->event_name) &&
-      !process_map->Contains(extension->id(), process->GetID())) {
+  // it's OK to send to normal renderers (e.g., for content scripts). Most
+  // listeners live in their extension's process, so check that first and
+  // only look up the event's feature for the others.
+  if (!process_map->Contains(extension->id(), process->GetID()) &&
+      ExtensionAPI::GetSharedInstance()->IsPrivileged(event->event_name)) {
     return;
   }
 
@@ -194,6 +194,9 @@ void ExpireHistoryBackend::DeleteURLs(const std::vector<GURL>& urls) {
   if (!main_db_)
     return;
 
+  // GetBookmarkService() blocks until bookmarks are loaded; only do that once
+  // rather than for every URL.
+  BookmarkService* bookmark_service = GetBookmarkService();
   DeleteDependencies dependencies;
   for (std::vector<GURL>::const_iterator url = urls.begin(); url != urls.end();
        ++url) {
@@ -214,8 +217,6 @@ void ExpireHistoryBackend::DeleteURLs(const std::vector<GURL>& urls) {
     // URL, and not starting with visits in a given time range). We
     // therefore need to call the deletion and favicon update
     // functions manually.
-
-    BookmarkService* bookmark_service = GetBookmarkService();
     bool is_bookmarked =
         (bookmark_service && bookmark_service->IsBookmarked(*url));
 
@@ -390,14 +391,17 @@ void ExpireHistoryBackend::DeleteVisitRelatedInfo(
     // Delete the visit itself.
     main_db_->DeleteVisit(visits[i]);
 
-    // Add the URL row to the affected URL list.
-    std::map<URLID, URLRow>::const_iterator found =
-        dependencies->affected_urls.find(visits[i].url_id);
-    if (found == dependencies->affected_urls.end()) {
+    // Add the URL row to the affected URL list. Large deletions hit the same
+    // URLs many times, so look each one up in the map only once.
+    std::map<URLID, URLRow>::iterator found =
+        dependencies->affected_urls.lower_bound(visits[i].url_id);
+    if (found == dependencies->affected_urls.end() ||
+        found->first != visits[i].url_id) {
       URLRow row;
       if (!main_db_->GetURLRow(visits[i].url_id, &row))
         continue;
-      dependencies->affected_urls[visits[i].url_id] = row;
+      dependencies->affected_urls.insert(
+          found, std::make_pair(visits[i].url_id, row));
     }
   }
 }
@@ -500,12 +504,13 @@ void ExpireHistoryBackend::ExpireURLsForVisits(
     else
       url_row.set_last_visit(Time());
 
-    // Don't delete URLs with visits still in the DB, or bookmarked.
-    bool is_bookmarked =
+    // Don't delete URLs with visits still in the DB, or bookmarked. The
+    // bookmark check is only needed once there are no visits left.
+    bool keep_url = !url_row.last_visit().is_null() ||
         (bookmark_service && bookmark_service->IsBookmarked(url_row.url()));
-    if (!is_bookmarked && url_row.last_visit().is_null()) {
+    if (!keep_url) {
       // Not bookmarked and no more visits. Nuke the url.
-      DeleteOneURL(url_row, is_bookmarked, dependencies);
+      DeleteOneURL(url_row, false, dependencies);
     } else {
       // NOTE: The calls to std::max() below are a backstop, but they should
       // never actually be needed unless the database is corrupt (I think).
@@ -361,15 +361,20 @@ void HistoryBackend::UpdateWithPageEndTime(const void* host,
 }
 
 void HistoryBackend::UpdateVisitDuration(VisitID visit_id, const Time end_ts) {
-  if (!db_)
+  // Navigations without a tracked referring visit pass 0 here; there is no
+  // such row, so don't go to the database for it.
+  if (!db_ || !visit_id)
     return;
 
   // Get the starting visit_time for visit_id.
   VisitRow visit_row;
   if (db_->GetRowForVisit(visit_id, &visit_row)) {
     // We should never have a negative duration time even when time is skewed.
-    visit_row.visit_duration = end_ts > visit_row.visit_time ?
+    TimeDelta duration = end_ts > visit_row.visit_time ?
         end_ts - visit_row.visit_time : TimeDelta::FromMicroseconds(0);
+    if (duration == visit_row.visit_duration)
+      return;
+    visit_row.visit_duration = duration;
     db_->UpdateVisitRow(visit_row);
   }
 }
@@ -763,20 +768,31 @@ std::pair<URLID, VisitID> HistoryBackend::AddPageVisit(
   URLRow url_info(url);
   URLID url_id = db_->GetRowForURL(url, &url_info);
   if (url_id) {
-    // Update of an existing row.
+    // Update of an existing row. Reloads of a page that was already visible
+    // at this time or later leave the row as it is; skip the write for those.
+    bool row_changed = false;
     if (content::PageTransitionStripQualifier(transition) !=
-        content::PAGE_TRANSITION_RELOAD)
+        content::PAGE_TRANSITION_RELOAD) {
       url_info.set_visit_count(url_info.visit_count() + 1);
-    if (typed_increment)
+      row_changed = true;
+    }
+    if (typed_increment) {
       url_info.set_typed_count(url_info.typed_count() + typed_increment);
-    if (url_info.last_visit() < time)
+      row_changed = true;
+    }
+    if (url_info.last_visit() < time) {
       url_info.set_last_visit(time);
+      row_changed = true;
+    }
 
     // Only allow un-hiding of pages, never hiding.
-    if (!new_hidden)
+    if (!new_hidden && url_info.hidden()) {
       url_info.set_hidden(false);
+      row_changed = true;
+    }
 
-    db_->UpdateURLRow(url_id, url_info);
+    if (row_changed)
+      db_->UpdateURLRow(url_id, url_info);
   } else {
     // Addition of a new row.
     url_info.set_visit_count(1);
@@ -142,6 +142,10 @@ bool TopSitesImpl::SetPageThumbnail(const GURL& url,
   if (!HistoryService::CanAddURL(url))
     return false;  // It's not a real webpage.
 
+  // Encoding is expensive, so don't do it for a thumbnail we would throw away.
+  if (!add_temp_thumbnail && !ShouldReplaceThumbnail(url, score))
+    return false;  // The one we already have is better.
+
   scoped_refptr<base::RefCountedBytes> thumbnail_data;
   if (!EncodeBitmap(thumbnail, &thumbnail_data))
     return false;
@@ -445,16 +449,14 @@ bool TopSitesImpl::IsFull() {
 TopSitesImpl::~TopSitesImpl() {
 }
 
-bool TopSitesImpl::SetPageThumbnailNoDB(
-    const GURL& url,
-    const base::RefCountedMemory* thumbnail_data,
-    const ThumbnailScore& score) {
+bool TopSitesImpl::ShouldReplaceThumbnail(const GURL& url,
+                                          const ThumbnailScore& score) {
   // This should only be invoked when we know about the url.
   DCHECK(cache_->IsKnownURL(url));
 
   const MostVisitedURL& most_visited =
       cache_->top_sites()[cache_->GetURLIndex(url)];
-  Images* image = cache_->GetImage(url);
+  const Images* image = cache_->GetImage(url);
 
   // When comparing the thumbnail scores, we need to take into account the
   // redirect hops, which are not generated when the thumbnail is because the
@@ -463,11 +465,26 @@ bool TopSitesImpl::SetPageThumbnailNoDB(
   new_score_with_redirects.redirect_hops_from_dest =
       GetRedirectDistanceForURL(most_visited, url);
 
-  if (!ShouldReplaceThumbnailWith(image->thumbnail_score,
-                                  new_score_with_redirects) &&
-      image->thumbnail.get())
+  return !image->thumbnail.get() ||
+      ShouldReplaceThumbnailWith(image->thumbnail_score,
+                                 new_score_with_redirects);
+}
+
+bool TopSitesImpl::SetPageThumbnailNoDB(
+    const GURL& url,
+    const base::RefCountedMemory* thumbnail_data,
+    const ThumbnailScore& score) {
+  if (!ShouldReplaceThumbnail(url, score))
     return false;  // The one we already have is better.
 
+  const MostVisitedURL& most_visited =
+      cache_->top_sites()[cache_->GetURLIndex(url)];
+  Images* image = cache_->GetImage(url);
+
+  ThumbnailScore new_score_with_redirects(score);
+  new_score_with_redirects.redirect_hops_from_dest =
+      GetRedirectDistanceForURL(most_visited, url);
+
   image->thumbnail = const_cast<base::RefCountedMemory*>(thumbnail_data);
   image->thumbnail_score = new_score_with_redirects;
 
@@ -108,6 +108,10 @@ class TopSitesImpl : public TopSites {
                               const MostVisitedURLList& new_list,
                               TopSitesDelta* delta);
 
+  // Returns true if a thumbnail of the known |url| with |score| should replace
+  // the one we already have.
+  bool ShouldReplaceThumbnail(const GURL& url, const ThumbnailScore& score);
+
   // Sets the thumbnail without writing to the database. Useful when
   // reading last known top sites from the DB.
   // Returns true if the thumbnail was set, false if the existing one is better.
@@ -205,17 +205,16 @@ ScoredHistoryMatches URLIndexPrivateData::HistoryItemsForTerms(
   // in this early rough filter.
   bool was_trimmed = (pre_filter_item_count_ > kItemsToScoreLimit);
   if (was_trimmed) {
-    HistoryIDVector history_ids;
-    std::copy(history_id_set.begin(), history_id_set.end(),
-              std::back_inserter(history_ids));
-    // Trim down the set by sorting by typed-count, visit-count, and last
-    // visit.
+    HistoryIDVector history_ids(history_id_set.begin(), history_id_set.end());
+    // Trim down the set by typed-count, visit-count, and last visit. The
+    // survivors go back into a set, so only which ones make the cut matters,
+    // not their order.
     HistoryItemFactorGreater
         item_factor_functor(history_info_map_);
-    std::partial_sort(history_ids.begin(),
-                      history_ids.begin() + kItemsToScoreLimit,
-                      history_ids.end(),
-                      item_factor_functor);
+    std::nth_element(history_ids.begin(),
+                     history_ids.begin() + kItemsToScoreLimit,
+                     history_ids.end(),
+                     item_factor_functor);
     history_id_set.clear();
     std::copy(history_ids.begin(), history_ids.begin() + kItemsToScoreLimit,
               std::inserter(history_id_set, history_id_set.end()));
@@ -244,9 +243,10 @@ ScoredHistoryMatches URLIndexPrivateData::HistoryItemsForTerms(
     // but this is such a rare edge case that it's not worth the time.
     return scored_items;
   }
-  scored_items = std::for_each(history_id_set.begin(), history_id_set.end(),
+  scored_items.reserve(history_id_set.size());
+  std::for_each(history_id_set.begin(), history_id_set.end(),
       AddHistoryMatch(*this, languages, bookmark_service, lower_raw_string,
-                      lower_raw_terms, base::Time::Now())).ScoredMatches();
+                      lower_raw_terms, base::Time::Now(), &scored_items));
 
   // Select and sort only the top kMaxMatches results.
   if (scored_items.size() > AutocompleteProvider::kMaxMatches) {
@@ -1079,6 +1079,7 @@ bool URLIndexPrivateData::RestoreWordList(
   if (actual_item_count == 0 || actual_item_count != expected_item_count)
     return false;
   const RepeatedPtrField<std::string>& words(list_item.word());
+  word_list_.reserve(word_list_.size() + actual_item_count);
   for (RepeatedPtrField<std::string>::const_iterator iter = words.begin();
        iter != words.end(); ++iter)
     word_list_.push_back(UTF8ToUTF16(*iter));
@@ -1095,9 +1096,15 @@ bool URLIndexPrivateData::RestoreWordMap(
   if (actual_item_count == 0 || actual_item_count != expected_item_count)
     return false;
   const RepeatedPtrField<WordMapEntry>& entries(list_item.word_map_entry());
+  // The entries were saved in key order, so hint each insertion at the end of
+  // the map, here and in the restore functions below. This makes rebuilding a
+  // map or set linear rather than O(n log n) for a well-formed cache.
   for (RepeatedPtrField<WordMapEntry>::const_iterator iter = entries.begin();
-       iter != entries.end(); ++iter)
-    word_map_[UTF8ToUTF16(iter->word())] = iter->word_id();
+       iter != entries.end(); ++iter) {
+    word_map_.insert(word_map_.end(),
+                     std::make_pair(UTF8ToUTF16(iter->word()),
+                                    static_cast<WordID>(iter->word_id())));
+  }
   return true;
 }
 
@@ -1119,12 +1126,13 @@ bool URLIndexPrivateData::RestoreCharWordMap(
     if (actual_item_count == 0 || actual_item_count != expected_item_count)
       return false;
     char16 uni_char = static_cast<char16>(iter->char_16());
-    WordIDSet word_id_set;
+    WordIDSet& word_id_set(
+        char_word_map_.insert(char_word_map_.end(),
+                              std::make_pair(uni_char, WordIDSet()))->second);
     const RepeatedField<int32>& word_ids(iter->word_id());
     for (RepeatedField<int32>::const_iterator jiter = word_ids.begin();
          jiter != word_ids.end(); ++jiter)
-      word_id_set.insert(*jiter);
-    char_word_map_[uni_char] = word_id_set;
+      word_id_set.insert(word_id_set.end(), *jiter);
   }
   return true;
 }
@@ -1147,14 +1155,16 @@ bool URLIndexPrivateData::RestoreWordIDHistoryMap(
     if (actual_item_count == 0 || actual_item_count != expected_item_count)
       return false;
     WordID word_id = iter->word_id();
-    HistoryIDSet history_id_set;
+    HistoryIDSet& history_id_set(
+        word_id_history_map_.insert(
+            word_id_history_map_.end(),
+            std::make_pair(word_id, HistoryIDSet()))->second);
     const RepeatedField<int64>& history_ids(iter->history_id());
     for (RepeatedField<int64>::const_iterator jiter = history_ids.begin();
          jiter != history_ids.end(); ++jiter) {
-      history_id_set.insert(*jiter);
+      history_id_set.insert(history_id_set.end(), *jiter);
       AddToHistoryIDWordMap(*jiter, word_id);
     }
-    word_id_history_map_[word_id] = history_id_set;
   }
   return true;
 }
@@ -1182,10 +1192,15 @@ bool URLIndexPrivateData::RestoreHistoryInfoMap(
       string16 title(UTF8ToUTF16(iter->title()));
       url_row.set_title(title);
     }
-    history_info_map_[history_id].url_row = url_row;
+    HistoryInfoMapValue& value(
+        history_info_map_.insert(
+            history_info_map_.end(),
+            std::make_pair(history_id, HistoryInfoMapValue()))->second);
+    value.url_row = url_row;
 
     // Restore visits list.
-    VisitInfoVector visits;
+    VisitInfoVector& visits(value.visits);
+    visits.clear();
     visits.reserve(iter->visits_size());
     for (int i = 0; i < iter->visits_size(); ++i) {
       visits.push_back(std::make_pair(
@@ -1193,7 +1208,6 @@ bool URLIndexPrivateData::RestoreHistoryInfoMap(
           static_cast<content::PageTransition>(iter->visits(i).
                                                transition_type())));
     }
-    history_info_map_[history_id].visits = visits;
   }
   return true;
 }
@@ -1215,18 +1229,18 @@ bool URLIndexPrivateData::RestoreWordStartsMap(
     for (RepeatedPtrField<WordStartsMapEntry>::const_iterator iter =
          entries.begin(); iter != entries.end(); ++iter) {
       HistoryID history_id = iter->history_id();
-      RowWordStarts word_starts;
+      RowWordStarts& word_starts(
+          word_starts_map_.insert(
+              word_starts_map_.end(),
+              std::make_pair(history_id, RowWordStarts()))->second);
       // Restore the URL word starts.
       const RepeatedField<int32>& url_starts(iter->url_word_starts());
-      for (RepeatedField<int32>::const_iterator jiter = url_starts.begin();
-           jiter != url_starts.end(); ++jiter)
-        word_starts.url_word_starts_.push_back(*jiter);
+      word_starts.url_word_starts_.assign(url_starts.begin(),
+                                          url_starts.end());
       // Restore the page title word starts.
       const RepeatedField<int32>& title_starts(iter->title_word_starts());
-      for (RepeatedField<int32>::const_iterator jiter = title_starts.begin();
-           jiter != title_starts.end(); ++jiter)
-        word_starts.title_word_starts_.push_back(*jiter);
-      word_starts_map_[history_id] = word_starts;
+      word_starts.title_word_starts_.assign(title_starts.begin(),
+                                            title_starts.end());
     }
   } else {
     // Since the cache did not contain any word starts we must rebuild then from
@@ -1276,10 +1290,12 @@ URLIndexPrivateData::AddHistoryMatch::AddHistoryMatch(
     BookmarkService* bookmark_service,
     const string16& lower_string,
     const String16Vector& lower_terms,
-    const base::Time now)
+    const base::Time now,
+    ScoredHistoryMatches* scored_matches)
   : private_data_(private_data),
     languages_(languages),
     bookmark_service_(bookmark_service),
+    scored_matches_(scored_matches),
     lower_string_(lower_string),
     lower_terms_(lower_terms),
     now_(now) {}
@@ -1300,7 +1316,7 @@ void URLIndexPrivateData::AddHistoryMatch::operator()(
                              lower_terms_, starts_pos->second, now_,
                              bookmark_service_);
     if (match.raw_score > 0)
-      scored_matches_.push_back(match);
+      scored_matches_->push_back(match);
   }
 }
 
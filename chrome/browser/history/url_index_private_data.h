@@ -193,6 +193,9 @@ class URLIndexPrivateData
 
   // A helper class which performs the final filter on each candidate
   // history URL match, inserting accepted matches into |scored_matches_|.
+  // Matches with a positive score are appended to |scored_matches|, which
+  // the caller owns, so that copies of the functor (std::for_each() returns
+  // one) don't copy the matches collected so far.
   class AddHistoryMatch : public std::unary_function<HistoryID, void> {
    public:
     AddHistoryMatch(const URLIndexPrivateData& private_data,
@@ -200,18 +203,17 @@ class URLIndexPrivateData
                     BookmarkService* bookmark_service,
                     const string16& lower_string,
                     const String16Vector& lower_terms,
-                    const base::Time now);
+                    const base::Time now,
+                    ScoredHistoryMatches* scored_matches);
     ~AddHistoryMatch();
 
     void operator()(const HistoryID history_id);
 
-    ScoredHistoryMatches ScoredMatches() const { return scored_matches_; }
-
    private:
     const URLIndexPrivateData& private_data_;
     const std::string& languages_;
     BookmarkService* bookmark_service_;
-    ScoredHistoryMatches scored_matches_;
+    ScoredHistoryMatches* scored_matches_;
     const string16& lower_string_;
     const String16Vector& lower_terms_;
     const base::Time now_;
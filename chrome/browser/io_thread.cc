@@ -63,6 +63,7 @@
 #include "net/proxy/proxy_script_fetcher_impl.h"
 #include "net/proxy/proxy_service.h"
 #include "net/socket/tcp_client_socket.h"
+#include "net/socket/transport_client_socket_pool.h"
 #include "net/spdy/spdy_session.h"
 #include "net/ssl/default_server_bound_cert_store.h"
 #include "net/ssl/server_bound_cert_service.h"
@@ -110,6 +111,19 @@ const char kQuicFieldTrialHttpsEnabledGroupName[] = "HttpsEnabled";
 const char kSpdyFieldTrialName[] = "SPDY";
 const char kSpdyFieldTrialDisabledGroupName[] = "SpdyDisabled";
 
+const char kConnectionRacingFieldTrialName[] = "ConnectionRacing";
+const char kConnectionRacingFieldTrialEnabledGroupName[] = "Enabled";
+
+const char kHttpCacheTailingReadersFieldTrialName[] =
+    "HttpCacheTailingReaders";
+const char kHttpCacheTailingReadersFieldTrialEnabledGroupName[] = "Enabled";
+
+const char kHostCacheStalenessFieldTrialName[] = "HostCacheStaleness";
+const char kHostCacheStalenessFieldTrialEnabledGroupName[] = "Enabled";
+// How long the Enabled group keeps expired entries. This is long enough for
+// the entries saved at the end of one day's browsing to be used the next.
+const int kHostCacheStalenessFieldTrialMaxStalenessHours = 24;
+
 #if defined(OS_MACOSX) && !defined(OS_IOS)
 void ObserveKeychainEvents() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
@@ -376,7 +390,8 @@ IOThread::Globals::Globals()
       http_pipelining_enabled(false),
       testing_fixed_http_port(0),
       testing_fixed_https_port(0),
-      enable_user_alternate_protocol_ports(false) {
+      enable_user_alternate_protocol_ports(false),
+      enable_http_cache_tailing_readers(false) {
 }
 
 IOThread::Globals::~Globals() {}
@@ -524,6 +539,13 @@ void IOThread::InitAsync() {
     network_delegate->NeverThrottleRequests();
   globals_->system_network_delegate.reset(network_delegate);
   globals_->host_resolver = CreateGlobalHostResolver(net_log_);
+  net::HostCache* host_cache = globals_->host_resolver->GetHostCache();
+  if (host_cache) {
+    host_cache->set_max_staleness(GetHostCacheMaxStaleness(
+        command_line,
+        base::FieldTrialList::FindFullName(
+            kHostCacheStalenessFieldTrialName)));
+  }
   UpdateDnsClientEnabled();
   globals_->cert_verifier.reset(net::CertVerifier::CreateDefault());
   globals_->transport_security_state.reset(new net::TransportSecurityState());
@@ -584,6 +606,11 @@ void IOThread::InitAsync() {
           switches::kEnableUserAlternateProtocolPorts)) {
     globals_->enable_user_alternate_protocol_ports = true;
   }
+  globals_->enable_http_cache_tailing_readers =
+      ShouldEnableHttpCacheTailingReaders(
+          command_line,
+          base::FieldTrialList::FindFullName(
+              kHttpCacheTailingReadersFieldTrialName));
   InitializeNetworkOptions(command_line);
 
   net::HttpNetworkSession::Params session_params;
@@ -690,6 +717,11 @@ void IOThread::InitializeNetworkOptions(const CommandLine& command_line) {
     net::CookieMonster::EnableFileScheme();
   }
 
+  net::TransportConnectJob::set_connection_racing_enabled(
+      ShouldEnableConnectionRacing(
+          command_line,
+          base::FieldTrialList::FindFullName(kConnectionRacingFieldTrialName)));
+
   // Only handle use-spdy command line flags if "spdy.disabled" preference is
   // not disabled via policy.
   if (is_spdy_disabled_by_policy_) {
@@ -766,6 +798,9 @@ void IOThread::EnableSpdy(const std::string& mode) {
   static const char kDisablePing[] = "no-ping";
   static const char kExclude[] = "exclude";  // Hosts to exclude
   static const char kDisableCompression[] = "no-compress";
+  // Compress SPDY4 headers with an indexed header table. The server must
+  // do the same.
+  static const char kHeaderIndexing[] = "header-indexing";
   static const char kDisableAltProtocols[] = "no-alt-protocols";
   static const char kForceAltProtocols[] = "force-alt-protocols";
   static const char kSingleDomain[] = "single-domain";
@@ -801,6 +836,8 @@ void IOThread::EnableSpdy(const std::string& mode) {
       net::HttpStreamFactory::add_forced_spdy_exclusion(value);
     } else if (option == kDisableCompression) {
       globals_->enable_spdy_compression.set(false);
+    } else if (option == kHeaderIndexing) {
+      globals_->enable_spdy_header_indexing.set(true);
     } else if (option == kDisableAltProtocols) {
       net::HttpStreamFactory::set_use_alternate_protocols(false);
     } else if (option == kForceAltProtocols) {
@@ -924,6 +961,8 @@ void IOThread::InitializeNetworkSessionParams(
       &params->enable_spdy_ip_pooling);
   globals_->enable_spdy_compression.CopyToIfSet(
       &params->enable_spdy_compression);
+  globals_->enable_spdy_header_indexing.CopyToIfSet(
+      &params->enable_spdy_header_indexing);
   globals_->enable_spdy_ping_based_connection_checking.CopyToIfSet(
       &params->enable_spdy_ping_based_connection_checking);
   globals_->spdy_default_protocol.CopyToIfSet(
@@ -1038,3 +1077,50 @@ bool IOThread::ShouldEnableQuicHttps(const CommandLine& command_line) {
   // field trial group.
   return quic_trial_group == kQuicFieldTrialHttpsEnabledGroupName;
 }
+
+// static
+bool IOThread::ShouldEnableConnectionRacing(
+    const CommandLine& command_line,
+    const std::string& racing_trial_group) {
+  if (command_line.HasSwitch(switches::kDisableTcpConnectionRacing))
+    return false;
+
+  if (command_line.HasSwitch(switches::kEnableTcpConnectionRacing))
+    return true;
+
+  return racing_trial_group == kConnectionRacingFieldTrialEnabledGroupName;
+}
+
+// static
+bool IOThread::ShouldEnableHttpCacheTailingReaders(
+    const CommandLine& command_line,
+    const std::string& tailing_trial_group) {
+  if (command_line.HasSwitch(switches::kDisableHttpCacheTailingReaders))
+    return false;
+
+  if (command_line.HasSwitch(switches::kEnableHttpCacheTailingReaders))
+    return true;
+
+  return tailing_trial_group ==
+      kHttpCacheTailingReadersFieldTrialEnabledGroupName;
+}
+
+// static
+base::TimeDelta IOThread::GetHostCacheMaxStaleness(
+    const CommandLine& command_line,
+    const std::string& staleness_trial_group) {
+  if (command_line.HasSwitch(switches::kHostCacheMaxStaleness)) {
+    std::string s =
+        command_line.GetSwitchValueASCII(switches::kHostCacheMaxStaleness);
+    int seconds;
+    if (base::StringToInt(s, &seconds) && seconds >= 0)
+      return base::TimeDelta::FromSeconds(seconds);
+    LOG(ERROR) << "Invalid switch for host cache max staleness: " << s;
+  }
+
+  if (staleness_trial_group == kHostCacheStalenessFieldTrialEnabledGroupName) {
+    return base::TimeDelta::FromHours(
+        kHostCacheStalenessFieldTrialMaxStalenessHours);
+  }
+  return base::TimeDelta();
+}
@@ -14,6 +14,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/prefs/pref_member.h"
+#include "base/time/time.h"
 #include "chrome/browser/net/ssl_config_service_manager.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/browser_thread_delegate.h"
@@ -67,6 +68,10 @@ namespace policy {
 class PolicyService;
 }  // namespace policy
 
+namespace test {
+class IOThreadPeer;
+}  // namespace test
+
 // Contains state associated with, initialized and cleaned up on, and
 // primarily used on, the IO thread.
 //
@@ -160,6 +165,7 @@ class IOThread : public content::BrowserThreadDelegate {
     Optional<bool> force_spdy_single_domain;
     Optional<bool> enable_spdy_ip_pooling;
     Optional<bool> enable_spdy_compression;
+    Optional<bool> enable_spdy_header_indexing;
     Optional<bool> enable_spdy_ping_based_connection_checking;
     Optional<net::NextProto> spdy_default_protocol;
     Optional<string> trusted_spdy_proxy;
@@ -167,6 +173,9 @@ class IOThread : public content::BrowserThreadDelegate {
     Optional<bool> enable_quic_https;
     Optional<net::HostPortPair> origin_to_force_quic_on;
     bool enable_user_alternate_protocol_ports;
+    // Whether the profiles' main HTTP caches let transactions read a
+    // response while it is being written.
+    bool enable_http_cache_tailing_readers;
     // NetErrorTabHelper uses |dns_probe_service| to send DNS probes when a
     // main frame load fails with a DNS error in order to provide more useful
     // information to the renderer so it can show a more specific error page.
@@ -212,6 +221,8 @@ class IOThread : public content::BrowserThreadDelegate {
   // InitSystemRequestContext().
   friend class SystemURLRequestContextGetter;
 
+  friend class test::IOThreadPeer;
+
   // BrowserThreadDelegate implementation, runs on the IO thread.
   // This handles initialization and destruction of state that must
   // live on the IO thread.
@@ -266,6 +277,28 @@ class IOThread : public content::BrowserThreadDelegate {
   // of a field trial or a command line flag.
   bool ShouldEnableQuicHttps(const CommandLine& command_line);
 
+  // Returns true if TCP connection racing should be enabled, either as a
+  // result of a field trial or a command line flag. |racing_trial_group| is
+  // the ConnectionRacing field trial group.
+  static bool ShouldEnableConnectionRacing(
+      const CommandLine& command_line,
+      const std::string& racing_trial_group);
+
+  // Returns true if the HTTP caches should have tailing readers enabled,
+  // either as a result of a field trial or a command line flag.
+  // |tailing_trial_group| is the HttpCacheTailingReaders field trial group.
+  static bool ShouldEnableHttpCacheTailingReaders(
+      const CommandLine& command_line,
+      const std::string& tailing_trial_group);
+
+  // Returns how long the global host cache keeps entries after they expire,
+  // so that they can be served while they are refreshed. Set by a command
+  // line flag, or else by the HostCacheStaleness field trial group
+  // |staleness_trial_group|.
+  static base::TimeDelta GetHostCacheMaxStaleness(
+      const CommandLine& command_line,
+      const std::string& staleness_trial_group);
+
   // The NetLog is owned by the browser process, to allow logging from other
   // threads during shutdown, but is used most frequently on the IOThread.
   ChromeNetLog* net_log_;
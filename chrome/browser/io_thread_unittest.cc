@@ -0,0 +1,125 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/command_line.h"
+#include "base/time/time.h"
+#include "chrome/browser/io_thread.h"
+#include "chrome/common/chrome_switches.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace test {
+
+class IOThreadPeer {
+ public:
+  static bool ShouldEnableConnectionRacing(
+      const CommandLine& command_line,
+      const std::string& racing_trial_group) {
+    return IOThread::ShouldEnableConnectionRacing(command_line,
+                                                  racing_trial_group);
+  }
+
+  static bool ShouldEnableHttpCacheTailingReaders(
+      const CommandLine& command_line,
+      const std::string& tailing_trial_group) {
+    return IOThread::ShouldEnableHttpCacheTailingReaders(command_line,
+                                                         tailing_trial_group);
+  }
+
+  static base::TimeDelta GetHostCacheMaxStaleness(
+      const CommandLine& command_line,
+      const std::string& staleness_trial_group) {
+    return IOThread::GetHostCacheMaxStaleness(command_line,
+                                              staleness_trial_group);
+  }
+};
+
+class IOThreadTest : public testing::Test {
+ public:
+  IOThreadTest() : command_line_(CommandLine::NO_PROGRAM) {}
+
+ protected:
+  CommandLine command_line_;
+};
+
+TEST_F(IOThreadTest, ConnectionRacingDisabledByDefault) {
+  EXPECT_FALSE(IOThreadPeer::ShouldEnableConnectionRacing(command_line_, ""));
+  EXPECT_FALSE(
+      IOThreadPeer::ShouldEnableConnectionRacing(command_line_, "Control"));
+}
+
+TEST_F(IOThreadTest, ConnectionRacingFromFieldTrial) {
+  EXPECT_TRUE(
+      IOThreadPeer::ShouldEnableConnectionRacing(command_line_, "Enabled"));
+}
+
+TEST_F(IOThreadTest, ConnectionRacingFromCommandLine) {
+  command_line_.AppendSwitch(switches::kEnableTcpConnectionRacing);
+  EXPECT_TRUE(IOThreadPeer::ShouldEnableConnectionRacing(command_line_, ""));
+}
+
+TEST_F(IOThreadTest, ConnectionRacingDisabledByCommandLine) {
+  command_line_.AppendSwitch(switches::kEnableTcpConnectionRacing);
+  command_line_.AppendSwitch(switches::kDisableTcpConnectionRacing);
+  EXPECT_FALSE(
+      IOThreadPeer::ShouldEnableConnectionRacing(command_line_, "Enabled"));
+}
+
+TEST_F(IOThreadTest, HttpCacheTailingReadersDisabledByDefault) {
+  EXPECT_FALSE(
+      IOThreadPeer::ShouldEnableHttpCacheTailingReaders(command_line_, ""));
+  EXPECT_FALSE(IOThreadPeer::ShouldEnableHttpCacheTailingReaders(
+      command_line_, "Control"));
+}
+
+TEST_F(IOThreadTest, HttpCacheTailingReadersFromFieldTrial) {
+  EXPECT_TRUE(IOThreadPeer::ShouldEnableHttpCacheTailingReaders(
+      command_line_, "Enabled"));
+}
+
+TEST_F(IOThreadTest, HttpCacheTailingReadersFromCommandLine) {
+  command_line_.AppendSwitch(switches::kEnableHttpCacheTailingReaders);
+  EXPECT_TRUE(
+      IOThreadPeer::ShouldEnableHttpCacheTailingReaders(command_line_, ""));
+}
+
+TEST_F(IOThreadTest, HttpCacheTailingReadersDisabledByCommandLine) {
+  command_line_.AppendSwitch(switches::kEnableHttpCacheTailingReaders);
+  command_line_.AppendSwitch(switches::kDisableHttpCacheTailingReaders);
+  EXPECT_FALSE(IOThreadPeer::ShouldEnableHttpCacheTailingReaders(
+      command_line_, "Enabled"));
+}
+
+TEST_F(IOThreadTest, HostCacheStalenessDisabledByDefault) {
+  EXPECT_EQ(base::TimeDelta(),
+            IOThreadPeer::GetHostCacheMaxStaleness(command_line_, ""));
+  EXPECT_EQ(base::TimeDelta(),
+            IOThreadPeer::GetHostCacheMaxStaleness(command_line_, "Control"));
+}
+
+TEST_F(IOThreadTest, HostCacheStalenessFromFieldTrial) {
+  EXPECT_EQ(base::TimeDelta::FromHours(24),
+            IOThreadPeer::GetHostCacheMaxStaleness(command_line_, "Enabled"));
+}
+
+TEST_F(IOThreadTest, HostCacheStalenessFromCommandLine) {
+  command_line_.AppendSwitchASCII(switches::kHostCacheMaxStaleness, "600");
+  EXPECT_EQ(base::TimeDelta::FromSeconds(600),
+            IOThreadPeer::GetHostCacheMaxStaleness(command_line_, ""));
+}
+
+TEST_F(IOThreadTest, HostCacheStalenessCommandLineOverridesFieldTrial) {
+  command_line_.AppendSwitchASCII(switches::kHostCacheMaxStaleness, "0");
+  EXPECT_EQ(base::TimeDelta(),
+            IOThreadPeer::GetHostCacheMaxStaleness(command_line_, "Enabled"));
+}
+
+TEST_F(IOThreadTest, HostCacheStalenessIgnoresInvalidCommandLine) {
+  command_line_.AppendSwitchASCII(switches::kHostCacheMaxStaleness, "-5");
+  EXPECT_EQ(base::TimeDelta(),
+            IOThreadPeer::GetHostCacheMaxStaleness(command_line_, ""));
+  EXPECT_EQ(base::TimeDelta::FromHours(24),
+            IOThreadPeer::GetHostCacheMaxStaleness(command_line_, "Enabled"));
+}
+
+}  // namespace test
@@ -249,6 +249,20 @@ HttpServerPropertiesManager::GetPipelineCapabilityMap() const {
   return http_server_properties_impl_->GetPipelineCapabilityMap();
 }
 
+void HttpServerPropertiesManager::RecordConnectionsInUse(
+    const net::HostPortPair& server,
+    int num_connections) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  http_server_properties_impl_->RecordConnectionsInUse(server,
+                                                       num_connections);
+}
+
+int HttpServerPropertiesManager::GetMaxConnectionsInUse(
+    const net::HostPortPair& server) const {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  return http_server_properties_impl_->GetMaxConnectionsInUse(server);
+}
+
 //
 // Update the HttpServerPropertiesImpl's cache with data from preferences.
 //
@@ -152,6 +152,13 @@ class HttpServerPropertiesManager
 
   virtual net::PipelineCapabilityMap GetPipelineCapabilityMap() const OVERRIDE;
 
+  // Connection usage is only kept for the session, and isn't persisted.
+  virtual void RecordConnectionsInUse(const net::HostPortPair& server,
+                                      int num_connections) OVERRIDE;
+
+  virtual int GetMaxConnectionsInUse(
+      const net::HostPortPair& server) const OVERRIDE;
+
  protected:
   // --------------------
   // SPDY related methods
@@ -194,9 +194,11 @@ class Predictor {
 
   void DiscardInitialNavigationHistory();
 
+  // Takes ownership of |referral_list| and |host_cache_list|.
   void FinalizeInitializationOnIOThread(
       const std::vector<GURL>& urls_to_prefetch,
       base::ListValue* referral_list,
+      base::ListValue* host_cache_list,
       IOThread* io_thread,
       bool predictor_enabled);
 
@@ -220,6 +222,7 @@ class Predictor {
   void SaveDnsPrefetchStateForNextStartupAndTrim(
       base::ListValue* startup_list,
       base::ListValue* referral_list,
+      base::ListValue* host_cache_list,
       base::WaitableEvent* completion);
 
   // May be called from either the IO or UI thread and will PostTask
@@ -295,6 +298,7 @@ class Predictor {
   FRIEND_TEST_ALL_PREFIXES(PredictorTest, PriorityQueuePushPopTest);
   FRIEND_TEST_ALL_PREFIXES(PredictorTest, PriorityQueueReorderTest);
   FRIEND_TEST_ALL_PREFIXES(PredictorTest, ReferrerSerializationTrimTest);
+  FRIEND_TEST_ALL_PREFIXES(PredictorTest, SaveOnlyLearnedHostsFromHostCache);
   friend class WaitForResolutionHelper;  // For testing.
 
   class LookupRequest;
@@ -458,6 +462,13 @@ class Predictor {
   // continue with them shortly (i.e., it yeilds and continues).
   void IncrementalTrimReferrers(bool trim_all_now);
 
+  // Adds to |hostnames| the hosts this predictor saves for the next startup:
+  // those of the URLs in |startup_list|, as built by
+  // GetInitialDnsResolutionList(), and of the referrers and their
+  // subresources.
+  void GetHostnamesToSave(const base::ListValue& startup_list,
+                          std::set<std::string>* hostnames) const;
+
   // ------------- End IO thread methods.
 
   scoped_ptr<InitialObserver> initial_observer_;
@@ -11,6 +11,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/message_loop/message_loop.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/synchronization/waitable_event.h"
 #include "base/timer/timer.h"
 #include "base/values.h"
 #include "chrome/browser/net/predictor.h"
@@ -18,7 +19,10 @@
 #include "chrome/common/net/predictor_common.h"
 #include "content/public/test/test_browser_thread.h"
 #include "net/base/address_list.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 #include "net/base/winsock_init.h"
+#include "net/dns/host_cache.h"
 #include "net/dns/mock_host_resolver.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -679,4 +683,60 @@ TEST_F(PredictorTest, DiscardPredictorResults) {
   predictor.Shutdown();
 }
 
+// Make sure that only the host cache entries for hosts the predictor learned
+// about are saved. The host cache is shared with off the record profiles,
+// whose hosts must not be written to disk.
+TEST_F(PredictorTest, SaveOnlyLearnedHostsFromHostCache) {
+  Predictor predictor(true);
+  predictor.SetHostResolver(host_resolver_.get());
+  scoped_ptr<ListValue> referral_list(NewEmptySerializationList());
+  AddToSerializedList(GURL("http://www.google.com:91"),
+                      GURL("http://icons.google.com:90"),
+                      16.0 * Predictor::kDiscardableExpectedValue,
+                      referral_list.get());
+  predictor.DeserializeReferrers(*referral_list.get());
+
+  net::IPAddressNumber address;
+  ASSERT_TRUE(net::ParseIPLiteralToNumber("127.0.0.1", &address));
+  net::AddressList addrlist = net::AddressList::CreateFromIPAddress(address,
+                                                                    80);
+  const TimeDelta kTTL = TimeDelta::FromMinutes(10);
+  const base::TimeTicks now = base::TimeTicks::Now();
+  net::HostCache* host_cache = host_resolver_->GetHostCache();
+  const char* const kHosts[] = {
+    "www.google.com", "icons.google.com", "incognito.example.com",
+  };
+  for (size_t i = 0; i < arraysize(kHosts); ++i) {
+    host_cache->Set(
+        net::HostCache::Key(kHosts[i], net::ADDRESS_FAMILY_UNSPECIFIED, 0),
+        net::HostCache::Entry(net::OK, addrlist), now, kTTL);
+  }
+
+  ListValue startup_list;
+  ListValue saved_referral_list;
+  ListValue host_cache_list;
+  base::WaitableEvent completion(false, false);
+  predictor.SaveDnsPrefetchStateForNextStartupAndTrim(
+      &startup_list, &saved_referral_list, &host_cache_list, &completion);
+  EXPECT_TRUE(completion.IsSignaled());
+
+  net::HostCache restored_cache(10);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(host_cache_list));
+  EXPECT_EQ(2U, restored_cache.size());
+  EXPECT_TRUE(restored_cache.Lookup(
+      net::HostCache::Key("www.google.com", net::ADDRESS_FAMILY_UNSPECIFIED,
+                          0),
+      now));
+  EXPECT_TRUE(restored_cache.Lookup(
+      net::HostCache::Key("icons.google.com", net::ADDRESS_FAMILY_UNSPECIFIED,
+                          0),
+      now));
+  EXPECT_FALSE(restored_cache.Lookup(
+      net::HostCache::Key("incognito.example.com",
+                          net::ADDRESS_FAMILY_UNSPECIFIED, 0),
+      now));
+
+  predictor.Shutdown();
+}
+
 }  // namespace chrome_browser_net
@@ -211,6 +211,8 @@ void OffTheRecordProfileIOData::InitializeInternal(
   PopulateNetworkSessionParams(profile_params, &network_session_params);
   net::HttpCache* cache = new net::HttpCache(
       network_session_params, main_backend);
+  cache->set_tailing_readers_enabled(
+      io_thread_globals->enable_http_cache_tailing_readers);
 
   main_http_factory_.reset(cache);
   main_context->set_http_transaction_factory(cache);
@@ -438,6 +438,8 @@ void ProfileImplIOData::InitializeInternal(
   net::HttpCache* main_cache = new net::HttpCache(
       network_session_params, main_backend);
   main_cache->InitializeInfiniteCache(lazy_params_->infinite_cache_path);
+  main_cache->set_tailing_readers_enabled(
+      io_thread_globals->enable_http_cache_tailing_readers);
 
 #if defined(OS_ANDROID) || defined(OS_IOS)
   DataReductionProxySettings::InitDataReductionProxySession(
@@ -30,8 +30,8 @@ typedef struct {
 } FileHeader;
 
 // For |std::upper_bound()| to find a prefix w/in a vector of pairs.
-bool PrefixLess(const std::pair<SBPrefix,size_t>& a,
-                const std::pair<SBPrefix,size_t>& b) {
+bool PrefixLess(const std::pair<SBPrefix,uint32>& a,
+                const std::pair<SBPrefix,uint32>& b) {
   return a.first < b.first;
 }
 
@@ -51,7 +51,8 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes) {
     // Lead with the first prefix.
     SBPrefix prev_prefix = sorted_prefixes[0];
     size_t run_length = 0;
-    index_.push_back(std::make_pair(prev_prefix, deltas_.size()));
+    index_.push_back(std::make_pair(prev_prefix,
+                                    static_cast<uint32>(deltas_.size())));
 
     for (size_t i = 1; i < sorted_prefixes.size(); ++i) {
       // Skip duplicates.
@@ -67,7 +68,8 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes) {
       // New index ref if the delta doesn't fit, or if too many
       // consecutive deltas have been encoded.
       if (delta != static_cast<unsigned>(delta16) || run_length >= kMaxRun) {
-        index_.push_back(std::make_pair(sorted_prefixes[i], deltas_.size()));
+        index_.push_back(std::make_pair(sorted_prefixes[i],
+                                        static_cast<uint32>(deltas_.size())));
         run_length = 0;
       } else {
         // Continue the run of deltas.
@@ -91,7 +93,7 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes) {
   }
 }
 
-PrefixSet::PrefixSet(std::vector<std::pair<SBPrefix,size_t> > *index,
+PrefixSet::PrefixSet(std::vector<std::pair<SBPrefix,uint32> > *index,
                      std::vector<uint16> *deltas) {
   DCHECK(index && deltas);
   index_.swap(*index);
@@ -105,9 +107,9 @@ bool PrefixSet::Exists(SBPrefix prefix) const {
     return false;
 
   // Find the first position after |prefix| in |index_|.
-  std::vector<std::pair<SBPrefix,size_t> >::const_iterator
+  std::vector<std::pair<SBPrefix,uint32> >::const_iterator
       iter = std::upper_bound(index_.begin(), index_.end(),
-                              std::pair<SBPrefix,size_t>(prefix, 0),
+                              std::pair<SBPrefix,uint32>(prefix, 0),
                               PrefixLess);
 
   // |prefix| comes before anything that's in the set.
@@ -172,7 +174,7 @@ PrefixSet* PrefixSet::LoadFile(const base::FilePath& filter_name) {
   if (header.magic != kMagic || header.version != kVersion)
     return NULL;
 
-  std::vector<std::pair<SBPrefix,size_t> > index;
+  std::vector<std::pair<SBPrefix,uint32> > index;
   const size_t index_bytes = sizeof(index[0]) * header.index_size;
 
   std::vector<uint16> deltas;
@@ -83,14 +83,16 @@ class PrefixSet {
 
   // Helper for |LoadFile()|.  Steals the contents of |index| and
   // |deltas| using |swap()|.
-  PrefixSet(std::vector<std::pair<SBPrefix,size_t> > *index,
+  PrefixSet(std::vector<std::pair<SBPrefix,uint32> > *index,
             std::vector<uint16> *deltas);
 
   // Top-level index of prefix to offset in |deltas_|.  Each pair
   // indicates a base prefix and where the deltas from that prefix
   // begin in |deltas_|.  The deltas for a pair end at the next pair's
-  // index into |deltas_|.
-  std::vector<std::pair<SBPrefix,size_t> > index_;
+  // index into |deltas_|.  The offset is 32 bits (the file header can't
+  // count more deltas than that anyway) so that each pair is 8 bytes on
+  // every platform, both in memory and in the file.
+  std::vector<std::pair<SBPrefix,uint32> > index_;
 
   // Deltas which are added to the prefix in |index_| to generate
   // prefixes.  Deltas are only valid between consecutive items from
@@ -4,6 +4,8 @@
 
 #include "chrome/browser/safe_browsing/safe_browsing_store_file.h"
 
+#include <algorithm>
+
 #include "base/md5.h"
 #include "base/metrics/histogram.h"
 
@@ -81,22 +83,37 @@ bool WriteItem(const T& item, FILE* fp, base::MD5Context* context) {
   return true;
 }
 
+// The number of items of type |T| that fit in the 4k buffer which
+// ReadToContainer() and WriteContainer() use to batch stdio and
+// checksum calls.
+template <class T>
+struct ItemBatch {
+  enum { kSize = sizeof(T) < 4096 ? 4096 / sizeof(T) : 1 };
+};
+
 // Read |count| items into |values| from |fp|, and fold them into the
 // checksum in |context|.  Returns true on success.
 template <typename CT>
 bool ReadToContainer(CT* values, size_t count, FILE* fp,
                      base::MD5Context* context) {
-  if (!count)
-    return true;
-
-  for (size_t i = 0; i < count; ++i) {
-    typename CT::value_type value;
-    if (!ReadItem(&value, fp, context))
+  typedef typename CT::value_type T;
+  T batch[ItemBatch<T>::kSize];
+  while (count) {
+    const size_t batch_count =
+        std::min(count, static_cast<size_t>(ItemBatch<T>::kSize));
+    if (fread(batch, sizeof(T), batch_count, fp) != batch_count)
       return false;
+    if (context) {
+      base::MD5Update(context,
+                      base::StringPiece(reinterpret_cast<char*>(batch),
+                                        sizeof(T) * batch_count));
+    }
 
     // push_back() is more obvious, but coded this way std::set can
     // also be read.
-    values->insert(values->end(), value);
+    for (size_t i = 0; i < batch_count; ++i)
+      values->insert(values->end(), batch[i]);
+    count -= batch_count;
   }
 
   return true;
@@ -107,13 +124,23 @@ bool ReadToContainer(CT* values, size_t count, FILE* fp,
 template <typename CT>
 bool WriteContainer(const CT& values, FILE* fp,
                     base::MD5Context* context) {
-  if (values.empty())
-    return true;
-
-  for (typename CT::const_iterator iter = values.begin();
-       iter != values.end(); ++iter) {
-    if (!WriteItem(*iter, fp, context))
+  typedef typename CT::value_type T;
+  T batch[ItemBatch<T>::kSize];
+  typename CT::const_iterator iter = values.begin();
+  while (iter != values.end()) {
+    size_t batch_count = 0;
+    for (; iter != values.end() &&
+               batch_count < static_cast<size_t>(ItemBatch<T>::kSize);
+         ++iter) {
+      batch[batch_count++] = *iter;
+    }
+    if (fwrite(batch, sizeof(T), batch_count, fp) != batch_count)
       return false;
+    if (context) {
+      base::MD5Update(context,
+                      base::StringPiece(reinterpret_cast<const char*>(batch),
+                                        sizeof(T) * batch_count));
+    }
   }
   return true;
 }
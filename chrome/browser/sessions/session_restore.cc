@@ -77,11 +77,18 @@ std::set<SessionRestoreImpl*>* active_session_restorers = NULL;
 // Initial delay (see class decription for details).
 static const int kInitialDelayTimerMS = 100;
 
+// Maximum number of background tabs the force load timer will have loading at
+// once (see class description for details).
+static const size_t kMaxParallelTabLoads = 3;
+
 // TabLoader is responsible for loading tabs after session restore creates
 // tabs. New tabs are loaded after the current tab finishes loading, or a delay
 // is reached (initially kInitialDelayTimerMS). If the delay is reached before
 // a tab finishes loading a new tab is loaded and the time of the delay
-// doubled.
+// doubled. The delay only starts more loads while fewer than
+// kMaxParallelTabLoads tabs are loading; beyond that the next tab waits for
+// one of them to finish, so restoring a large session doesn't have every
+// renderer competing for memory and CPU at once.
 //
 // TabLoader keeps a reference to itself when it's loading. When it has finished
 // loading, it drops the reference. If another profile is restored while the
@@ -426,6 +433,9 @@ void TabLoader::RemoveTab(NavigationController* tab) {
 
 void TabLoader::ForceLoadTimerFired() {
   force_load_delay_ *= 2;
+  // HandleTabClosedOrLoaded() loads the next tab once one of these is done.
+  if (tabs_loading_.size() >= kMaxParallelTabLoads)
+    return;
   LoadNextTab();
 }
 
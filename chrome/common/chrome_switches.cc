@@ -354,6 +354,11 @@ const char kDisableExtensionsResourceWhitelist[] =
 // Disables Google Now integration.
 const char kDisableGoogleNowIntegration[] = "disable-google-now-integration";
 
+// Disables reading cached responses while they are being written. Takes
+// precedence over the enable flag and the field trial.
+const char kDisableHttpCacheTailingReaders[] =
+    "disable-http-cache-tailing-readers";
+
 // Disable Instant extended API.
 const char kDisableInstantExtendedAPI[]     = "disable-instant-extended-api";
 
@@ -490,6 +495,10 @@ const char kDisableSyncThemes[]             = "disable-sync-themes";
 // Disables syncing browser typed urls.
 const char kDisableSyncTypedUrls[]          = "disable-sync-typed-urls";
 
+// Disables racing TCP connection attempts to a host's addresses. Takes
+// precedence over the enable flag and the field trial.
+const char kDisableTcpConnectionRacing[]    = "disable-tcp-connection-racing";
+
 // Allows disabling of translate from the command line to assist with automated
 // browser testing (e.g. Selenium/WebDriver). Normal browser users should
 // disable translate with the preference.
@@ -637,6 +646,11 @@ const char kEnableGoogleNowIntegration[]    = "enable-google-now-integration";
 // Enable HTTP/2 draft 04. This is a temporary testing flag.
 const char kEnableHttp2Draft04[]            = "enable-http2-draft-04";
 
+// Lets requests for a response that is being written to the HTTP cache read
+// it as it arrives, instead of waiting for the whole response.
+const char kEnableHttpCacheTailingReaders[] =
+    "enable-http-cache-tailing-readers";
+
 // Enables the inline sign in flow on Chrome desktop.
 const char kEnableInlineSignin[]            = "enable-inline-signin";
 
@@ -780,6 +794,10 @@ const char kEnableSyncArticles[] = "enable-sync-articles";
 // Enables context menu for selecting groups of tabs.
 const char kEnableTabGroupsContextMenu[]    = "enable-tab-groups-context-menu";
 
+// Races staggered TCP connection attempts to each of a host's addresses,
+// instead of falling back from IPv6 to IPv4 after a fixed timeout.
+const char kEnableTcpConnectionRacing[]     = "enable-tcp-connection-racing";
+
 // Enables fanciful thumbnail processing. Used with NTP for
 // instant-extended-api, where thumbnails are generally smaller.
 const char kEnableThumbnailRetargeting[]   = "enable-thumbnail-retargeting";
@@ -915,6 +933,11 @@ const char kHistoryEnableGroupByDomain[]    = "enable-grouped-history";
 // http://google.com.
 const char kHomePage[]                      = "homepage";
 
+// How many seconds the host cache keeps entries after they expire, so that
+// they can be used while they are refreshed. Zero disables serving stale
+// entries. Overrides the HostCacheStaleness field trial.
+const char kHostCacheMaxStaleness[]         = "host-cache-max-staleness";
+
 // Comma-separated list of rules that control how hostnames are mapped.
 //
 // For example:
@@ -1203,6 +1226,11 @@ const char kProfilingOutputFile[]           = "profiling-output-file";
 // specified.
 const char kProfilingFlush[]                = "profiling-flush";
 
+// Makes task-level profiling (see kEnableProfiling) tally only one in every N
+// tasks on each thread, for all processes. The totals shown in about:profiler
+// are then estimates scaled up by N.
+const char kProfilingSamplingInterval[]     = "profiling-sampling-interval";
+
 // Specifies a custom URL for fetching NTP promo data.
 const char kPromoServerURL[]                = "promo-server-url";
 
@@ -108,6 +108,7 @@ extern const char kDisableExtensionsHttpThrottling[];
 extern const char kDisableExtensionsResourceWhitelist[];
 extern const char kDisableExtensions[];
 extern const char kDisableGoogleNowIntegration[];
+extern const char kDisableHttpCacheTailingReaders[];
 extern const char kDisableImprovedDownloadProtection[];
 extern const char kDisableInstantExtendedAPI[];
 extern const char kDisableIPv6[];
@@ -149,6 +150,7 @@ extern const char kDisableSyncSyncedNotifications[];
 extern const char kDisableSyncTabs[];
 extern const char kDisableSyncThemes[];
 extern const char kDisableSyncTypedUrls[];
+extern const char kDisableTcpConnectionRacing[];
 extern const char kDisableTranslate[];
 extern const char kDisableTLSChannelID[];
 extern const char kDisableUserMediaSecurity[];
@@ -184,6 +186,7 @@ extern const char kEnableFastUnload[];
 extern const char kEnableFileCookies[];
 extern const char kEnableGoogleNowIntegration[];
 extern const char kEnableHttp2Draft04[];
+extern const char kEnableHttpCacheTailingReaders[];
 extern const char kEnableInlineSignin[];
 extern const char kEnableInstantExtendedAPI[];
 extern const char kEnableIPPooling[];
@@ -222,6 +225,7 @@ extern const char kEnableSuggestionsTabPage[];
 extern const char kEnableSyncArticles[];
 extern const char kEnableSyncSyncedNotifications[];
 extern const char kEnableTabGroupsContextMenu[];
+extern const char kEnableTcpConnectionRacing[];
 extern const char kEnableThumbnailRetargeting[];
 extern const char kEnableTranslateNewUX[];
 extern const char kEnableUnrestrictedSSL3Fallback[];
@@ -256,6 +260,7 @@ extern const char kHistoryDisableFullHistorySync[];
 extern const char kHistoryEnableGroupByDomain[];
 extern const char kHistoryWebHistoryUrl[];
 extern const char kHomePage[];
+extern const char kHostCacheMaxStaleness[];
 extern const char kHostRules[];
 extern const char kHostResolverParallelism[];
 extern const char kHostResolverRetryAttempts[];
@@ -324,6 +329,7 @@ extern const char kProfilingAtStart[];
 extern const char kProfilingFile[];
 extern const char kProfilingFlush[];
 extern const char kProfilingOutputFile[];
+extern const char kProfilingSamplingInterval[];
 extern const char kPromoServerURL[];
 extern const char kPromptForExternalExtensions[];
 extern const char kProxyAutoDetect[];
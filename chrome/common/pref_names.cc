@@ -479,6 +479,10 @@ const char kDnsHostReferralList[] = "HostReferralList";
 const char kDnsPrefetchingHostReferralList[] =
     "dns_prefetching.host_referral_list";
 
+// The successful entries of the host cache, saved on shutdown so that the
+// first navigations after a restart need not wait for DNS.
+const char kDnsPrefetchingHostCacheList[] = "dns_prefetching.host_cache_list";
+
 // Disables the SPDY protocol.
 const char kDisableSpdy[] = "spdy.disabled";
 
@@ -270,6 +270,10 @@ void UserScriptSlave::InjectScripts(WebFrame* frame,
 
   ExecutingScriptsMap extensions_executing_scripts;
 
+  // The top frame's URL is the same for every script; convert it once.
+  GURL top_url;
+  bool have_top_url = false;
+
   for (size_t i = 0; i < scripts_.size(); ++i) {
     std::vector<WebScriptSource> sources;
     UserScript* script = scripts_[i];
@@ -277,6 +281,14 @@ void UserScriptSlave::InjectScripts(WebFrame* frame,
     if (frame->parent() && !script->match_all_frames())
       continue;  // Only match subframes if the script declared it wanted to.
 
+    // This runs once for each run location of every frame. Past
+    // DOCUMENT_START, where the css counts below are gathered, a script for
+    // another run location has nothing to do here, so skip its permission
+    // and pattern checks.
+    if (location != UserScript::DOCUMENT_START &&
+        script->run_location() != location)
+      continue;
+
     const Extension* extension = extensions_->GetByID(script->extension_id());
 
     // Since extension info is sent separately from user script info, they can
@@ -288,9 +300,13 @@ void UserScriptSlave::InjectScripts(WebFrame* frame,
     const int kNoTabId = -1;
     // We don't have a process id in this context.
     const int kNoProcessId = -1;
+    if (!have_top_url) {
+      top_url = frame->top()->document().url();
+      have_top_url = true;
+    }
     if (!PermissionsData::CanExecuteScriptOnPage(extension,
                                                  data_source_url,
-                                                 frame->top()->document().url(),
+                                                 top_url,
                                                  kNoTabId,
                                                  script,
                                                  kNoProcessId,
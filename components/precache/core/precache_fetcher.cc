@@ -26,6 +26,9 @@ namespace precache {
 
 namespace {
 
+// The maximum number of resources that are fetched at the same time.
+const size_t kMaxParallelResourceFetches = 4;
+
 GURL GetConfigURL() {
   const CommandLine& command_line = *CommandLine::ForCurrentProcess();
   if (command_line.HasSwitch(switches::kPrecacheConfigSettingsURL)) {
@@ -108,6 +111,8 @@ class PrecacheFetcher::Fetcher : public net::URLFetcherDelegate {
   virtual ~Fetcher() {}
   virtual void OnURLFetchComplete(const URLFetcher* source) OVERRIDE;
 
+  const URLFetcher* url_fetcher() const { return url_fetcher_.get(); }
+
  private:
   const base::Callback<void(const URLFetcher&)> callback_;
   scoped_ptr<URLFetcher> url_fetcher_;
@@ -160,29 +165,33 @@ void PrecacheFetcher::Start() {
                                         base::Unretained(this))));
 }
 
-void PrecacheFetcher::StartNextFetch() {
-  if (!resource_urls_to_fetch_.empty()) {
-    // Fetch the next resource URL.
-    fetcher_.reset(
+void PrecacheFetcher::StartNextFetches() {
+  // Fetch the next resource URLs.
+  while (!resource_urls_to_fetch_.empty() &&
+         resource_fetchers_.size() < kMaxParallelResourceFetches) {
+    resource_fetchers_.push_back(
         new Fetcher(request_context_, resource_urls_to_fetch_.front(),
                     base::Bind(&PrecacheFetcher::OnResourceFetchComplete,
                                base::Unretained(this))));
 
     resource_urls_to_fetch_.pop_front();
-    return;
   }
 
-  if (!manifest_urls_to_fetch_.empty()) {
-    // Fetch the next manifest URL.
+  // Fetch the next manifest URL once all of the current manifest's resources
+  // have been started.
+  if (!fetcher_ && resource_urls_to_fetch_.empty() &&
+      !manifest_urls_to_fetch_.empty()) {
     fetcher_.reset(
         new Fetcher(request_context_, manifest_urls_to_fetch_.front(),
                     base::Bind(&PrecacheFetcher::OnManifestFetchComplete,
                                base::Unretained(this))));
 
     manifest_urls_to_fetch_.pop_front();
-    return;
   }
 
+  if (fetcher_ || !resource_fetchers_.empty())
+    return;
+
   // There are no more URLs to fetch, so end the precache cycle.
   precache_delegate_->OnDone();
   // OnDone may have deleted this PrecacheFetcher, so don't do anything after it
@@ -215,7 +224,9 @@ void PrecacheFetcher::OnConfigFetchComplete(const URLFetcher& source) {
     }
   }
 
-  StartNextFetch();
+  // |source| is owned by |fetcher_|, so it can't be used after this.
+  fetcher_.reset();
+  StartNextFetches();
 }
 
 void PrecacheFetcher::OnManifestFetchComplete(const URLFetcher& source) {
@@ -229,13 +240,22 @@ void PrecacheFetcher::OnManifestFetchComplete(const URLFetcher& source) {
     }
   }
 
-  StartNextFetch();
+  // |source| is owned by |fetcher_|, so it can't be used after this.
+  fetcher_.reset();
+  StartNextFetches();
 }
 
 void PrecacheFetcher::OnResourceFetchComplete(const URLFetcher& source) {
   // The resource has already been put in the cache during the fetch process, so
   // nothing more needs to be done for the resource.
-  StartNextFetch();
+  for (ScopedVector<Fetcher>::iterator it = resource_fetchers_.begin();
+       it != resource_fetchers_.end(); ++it) {
+    if ((*it)->url_fetcher() == &source) {
+      resource_fetchers_.erase(it);
+      break;
+    }
+  }
+  StartNextFetches();
 }
 
 }  // namespace precache
@@ -10,6 +10,7 @@
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "url/gurl.h"
 
 namespace net {
@@ -76,19 +77,23 @@ class PrecacheFetcher {
 
   virtual ~PrecacheFetcher();
 
-  // Starts fetching resources to precache. URLs are fetched sequentially. Can
-  // be called from any thread. Start should only be called once on a
+  // Starts fetching resources to precache. Manifests are fetched sequentially,
+  // and a few resources are fetched in parallel. Can be called from any
+  // thread. Start should only be called once on a
   // PrecacheFetcher instance.
   void Start();
 
  private:
   class Fetcher;
 
-  // Fetches the next resource or manifest URL, if any remain. Fetching is done
-  // sequentially and depth-first: all resources are fetched for a manifest
-  // before the next manifest is fetched. This is done to limit the length of
-  // the |resource_urls_to_fetch_| list, reducing the memory usage.
-  void StartNextFetch();
+  // Fetches the next resource and manifest URLs, if any remain. Fetching is
+  // done depth-first: all resources of a manifest are started before the next
+  // manifest is fetched. This is done to limit the length of the
+  // |resource_urls_to_fetch_| list, reducing the memory usage. Up to
+  // kMaxParallelResourceFetches resources are fetched at once, and the next
+  // manifest is fetched while the last of them finish. Calls OnDone() on the
+  // delegate when nothing is left to fetch.
+  void StartNextFetches();
 
   // Called when the precache configuration settings have been fetched.
   // Determines the list of manifest URLs to fetch according to the URLs that
@@ -115,8 +120,12 @@ class PrecacheFetcher {
   // Non-owning pointer. Should not be NULL.
   PrecacheDelegate* precache_delegate_;
 
+  // The fetcher of the configuration settings or the current manifest.
   scoped_ptr<Fetcher> fetcher_;
 
+  // The fetchers of the resources currently being fetched.
+  ScopedVector<Fetcher> resource_fetchers_;
+
   std::list<GURL> manifest_urls_to_fetch_;
   std::list<GURL> resource_urls_to_fetch_;
 
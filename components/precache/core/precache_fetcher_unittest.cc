@@ -232,6 +232,67 @@ TEST_F(PrecacheFetcherTest, Cancel) {
   EXPECT_FALSE(precache_delegate_.was_on_done_called());
 }
 
+// Tests that every resource is fetched once when manifests list more
+// resources than are fetched in parallel.
+TEST_F(PrecacheFetcherTest, ManyResources) {
+  CommandLine::ForCurrentProcess()->AppendSwitchASCII(
+      switches::kPrecacheConfigSettingsURL, kConfigURL);
+  CommandLine::ForCurrentProcess()->AppendSwitchASCII(
+      switches::kPrecacheManifestURLPrefix, kManfiestURLPrefix);
+
+  const char* kFirstResourceURLs[] = {
+    "http://resource1.com/", "http://resource2.com/", "http://resource3.com/",
+    "http://resource4.com/", "http://resource5.com/", "http://resource6.com/",
+  };
+  const char kSecondManifestURL[] =
+      "http://manifest-url-prefix.com/http%253A%252F%252Fsecond.com%252F";
+  const char kSecondResourceURL[] = "http://resource7.com/";
+
+  std::list<GURL> starting_urls;
+  starting_urls.push_back(GURL("http://good-manifest.com"));
+  starting_urls.push_back(GURL("http://second.com"));
+
+  PrecacheConfigurationSettings config;
+  config.add_whitelisted_starting_url("http://good-manifest.com");
+  config.add_whitelisted_starting_url("http://second.com");
+  config.set_maximum_rank_starting_url(2);
+
+  PrecacheManifest first_manifest;
+  for (size_t i = 0; i < arraysize(kFirstResourceURLs); ++i) {
+    first_manifest.add_resource()->set_url(kFirstResourceURLs[i]);
+    factory_.SetFakeResponse(GURL(kFirstResourceURLs[i]), "good",
+                             net::HTTP_OK);
+  }
+  PrecacheManifest second_manifest;
+  second_manifest.add_resource()->set_url(kSecondResourceURL);
+
+  factory_.SetFakeResponse(GURL(kConfigURL),
+                           config.SerializeAsString(),
+                           net::HTTP_OK);
+  factory_.SetFakeResponse(GURL(kGoodManifestURL),
+                           first_manifest.SerializeAsString(), net::HTTP_OK);
+  factory_.SetFakeResponse(GURL(kSecondManifestURL),
+                           second_manifest.SerializeAsString(), net::HTTP_OK);
+  factory_.SetFakeResponse(GURL(kSecondResourceURL), "good", net::HTTP_OK);
+
+  PrecacheFetcher precache_fetcher(starting_urls, request_context_.get(),
+                                   &precache_delegate_);
+  precache_fetcher.Start();
+
+  base::MessageLoop::current()->RunUntilIdle();
+
+  std::multiset<GURL> expected_requested_urls;
+  expected_requested_urls.insert(GURL(kConfigURL));
+  expected_requested_urls.insert(GURL(kGoodManifestURL));
+  for (size_t i = 0; i < arraysize(kFirstResourceURLs); ++i)
+    expected_requested_urls.insert(GURL(kFirstResourceURLs[i]));
+  expected_requested_urls.insert(GURL(kSecondManifestURL));
+  expected_requested_urls.insert(GURL(kSecondResourceURL));
+  EXPECT_EQ(expected_requested_urls, url_callback_.requested_urls());
+
+  EXPECT_TRUE(precache_delegate_.was_on_done_called());
+}
+
 #if defined(PRECACHE_CONFIG_SETTINGS_URL)
 
 // If the default precache configuration settings URL is defined, then test that
@@ -57,6 +57,10 @@ const char* kWellKnownCodesOnWrongConfiguration[] = {
   "es", "pt", "ja", "ru", "de", "zh-CN", "zh-TW", "ar", "id", "fr", "it", "th"
 };
 
+// CLD's result stops improving long before the end of a long article, so only
+// this many characters of the page contents are classified.
+const size_t kMaxTextLengthForDetection = 16384;
+
 // Applies a series of language code modification in proper order.
 void ApplyLanguageCodeCorrection(std::string* code) {
   // Correct well-known format errors.
@@ -202,7 +206,18 @@ std::string DeterminePageLanguage(const std::string& code,
                                   bool* is_cld_reliable_p) {
   base::TimeTicks begin_time = base::TimeTicks::Now();
   bool is_cld_reliable;
-  std::string cld_language = DetermineTextLanguage(contents, &is_cld_reliable);
+  std::string cld_language;
+  if (contents.size() > kMaxTextLengthForDetection) {
+    // Cut at the last whitespace so that no word is clipped.
+    size_t length = contents.find_last_of(kWhitespaceUTF16,
+                                          kMaxTextLengthForDetection);
+    if (length == base::string16::npos)
+      length = kMaxTextLengthForDetection;
+    cld_language = DetermineTextLanguage(contents.substr(0, length),
+                                         &is_cld_reliable);
+  } else {
+    cld_language = DetermineTextLanguage(contents, &is_cld_reliable);
+  }
   translate::ReportLanguageDetectionTime(begin_time, base::TimeTicks::Now());
 
   if (cld_language_p != NULL)
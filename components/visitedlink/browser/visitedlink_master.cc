@@ -771,11 +771,19 @@ void VisitedLinkMaster::ResizeTable(int32 new_size) {
     return;
 
   // Now we have two tables, our local copy which is the old one, and the new
-  // one loaded into this object where we need to copy the data.
+  // one loaded into this object where we need to copy the data. The old
+  // fingerprints are all distinct and the new table is bigger than the item
+  // count, so each one just goes in the first empty slot of its probe
+  // sequence; there is no need for AddFingerprint's duplicate check.
   for (int32 i = 0; i < old_table_length; i++) {
     Fingerprint cur = old_hash_table[i];
-    if (cur)
-      AddFingerprint(cur, false);
+    if (!cur)
+      continue;
+    Hash cur_hash = HashFingerprint(cur);
+    while (hash_table_[cur_hash] != null_fingerprint_)
+      cur_hash = IncrementHash(cur_hash);
+    hash_table_[cur_hash] = cur;
+    used_items_++;
   }
 
   // On error unmapping, just forget about it since we can't do anything
@@ -40,13 +40,20 @@ bool VisitedLinkCommon::IsVisited(const GURL& url) const {
 }
 
 bool VisitedLinkCommon::IsVisited(Fingerprint fingerprint) const {
+  if (!hash_table_ || table_length_ == 0)
+    return false;
+
   // Go through the table until we find the item or an empty spot (meaning it
   // wasn't found). This loop will terminate as long as the table isn't full,
-  // which should be enforced by AddFingerprint.
-  Hash first_hash = HashFingerprint(fingerprint);
+  // which should be enforced by AddFingerprint. The table can't change under
+  // us, so probe it directly rather than through FingerprintAt(), which
+  // re-checks |hash_table_| on every step.
+  const Fingerprint* table = hash_table_;
+  const Hash table_length = table_length_;
+  const Hash first_hash = HashFingerprint(fingerprint, table_length);
   Hash cur_hash = first_hash;
   while (true) {
-    Fingerprint cur_fingerprint = FingerprintAt(cur_hash);
+    Fingerprint cur_fingerprint = table[cur_hash];
     if (cur_fingerprint == null_fingerprint_)
       return false;  // End of probe sequence found.
     if (cur_fingerprint == fingerprint)
@@ -55,7 +62,7 @@ bool VisitedLinkCommon::IsVisited(Fingerprint fingerprint) const {
     // This spot was taken, but not by the item we're looking for, search in
     // the next position.
     cur_hash++;
-    if (cur_hash == table_length_)
+    if (cur_hash == table_length)
       cur_hash = 0;
     if (cur_hash == first_hash) {
       // Wrapped around and didn't find an empty space, this means we're in an
@@ -22,6 +22,7 @@
 #include "base/system_monitor/system_monitor.h"
 #include "base/thread_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
 #include "base/timer/hi_res_timer_manager.h"
 #include "content/browser/browser_thread_impl.h"
 #include "content/browser/device_orientation/device_inertial_sensor_service.h"
@@ -245,6 +246,23 @@ static void SetUpGLibLogHandler() {
 }
 #endif
 
+// Runs |task| and records how long it took in the times histogram |name|, so
+// that the cost of each startup stage shows up in UMA.
+int RunTimedStartupTask(const char* name, const StartupTask& task) {
+  base::TimeTicks start = base::TimeTicks::Now();
+  int result = task.Run();
+  // The name differs per stage, so the UMA macros, which cache the histogram
+  // for a single name, can't be used here.
+  base::HistogramBase* histogram = base::Histogram::FactoryTimeGet(
+      name,
+      base::TimeDelta::FromMilliseconds(1),
+      base::TimeDelta::FromSeconds(10),
+      50,
+      base::HistogramBase::kUmaTargetedHistogramFlag);
+  histogram->AddTime(base::TimeTicks::Now() - start);
+  return result;
+}
+
 }  // namespace
 
 // The currently-running BrowserMainLoop.  There can be one or zero.
@@ -568,20 +586,27 @@ void BrowserMainLoop::CreateStartupTasks() {
         base::Callback<void(int)>(),
         base::MessageLoop::current()->message_loop_proxy()));
 #endif
-    StartupTask pre_create_threads =
-        base::Bind(&BrowserMainLoop::PreCreateThreads, base::Unretained(this));
+    StartupTask pre_create_threads = base::Bind(
+        &RunTimedStartupTask, "Startup.BrowserMainLoop.PreCreateThreads",
+        base::Bind(&BrowserMainLoop::PreCreateThreads,
+                   base::Unretained(this)));
     startup_task_runner_->AddTask(pre_create_threads);
 
-    StartupTask create_threads =
-        base::Bind(&BrowserMainLoop::CreateThreads, base::Unretained(this));
+    StartupTask create_threads = base::Bind(
+        &RunTimedStartupTask, "Startup.BrowserMainLoop.CreateThreads",
+        base::Bind(&BrowserMainLoop::CreateThreads, base::Unretained(this)));
     startup_task_runner_->AddTask(create_threads);
 
     StartupTask browser_thread_started = base::Bind(
-        &BrowserMainLoop::BrowserThreadsStarted, base::Unretained(this));
+        &RunTimedStartupTask, "Startup.BrowserMainLoop.BrowserThreadsStarted",
+        base::Bind(&BrowserMainLoop::BrowserThreadsStarted,
+                   base::Unretained(this)));
     startup_task_runner_->AddTask(browser_thread_started);
 
     StartupTask pre_main_message_loop_run = base::Bind(
-        &BrowserMainLoop::PreMainMessageLoopRun, base::Unretained(this));
+        &RunTimedStartupTask, "Startup.BrowserMainLoop.PreMainMessageLoopRun",
+        base::Bind(&BrowserMainLoop::PreMainMessageLoopRun,
+                   base::Unretained(this)));
     startup_task_runner_->AddTask(pre_main_message_loop_run);
 
 #if defined(OS_ANDROID)
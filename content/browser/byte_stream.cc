@@ -222,7 +222,11 @@ bool ByteStreamWriterImpl::Write(
     return false;
   }
 
-  input_contents_.push_back(std::make_pair(buffer, byte_count));
+  // Swap |buffer| into place rather than copying it, which would take and
+  // then drop a reference on every write.
+  input_contents_.push_back(
+      std::make_pair(scoped_refptr<net::IOBuffer>(), byte_count));
+  input_contents_.back().first.swap(buffer);
   input_contents_size_ += byte_count;
 
   // Arbitrarily, we buffer to a third of the total size before sending.
@@ -393,9 +397,15 @@ void ByteStreamReaderImpl::TransferDataInternal(
   bool was_empty = available_contents_.empty();
 
   if (transfer_buffer) {
-    available_contents_.insert(available_contents_.end(),
-                               transfer_buffer->begin(),
-                               transfer_buffer->end());
+    // The consumer usually keeps up, so take the whole transfer without
+    // touching the buffers' reference counts when there's nothing queued.
+    if (was_empty) {
+      available_contents_.swap(*transfer_buffer);
+    } else {
+      available_contents_.insert(available_contents_.end(),
+                                 transfer_buffer->begin(),
+                                 transfer_buffer->end());
+    }
   }
 
   if (source_complete) {
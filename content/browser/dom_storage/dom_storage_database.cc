@@ -62,10 +62,10 @@ void DOMStorageDatabase::ReadAllValues(DOMStorageValuesMap* result) {
   DCHECK(statement.is_valid());
 
   while (statement.Step()) {
-    base::string16 key = statement.ColumnString16(0);
     base::string16 value;
     statement.ColumnBlobAsString16(1, &value);
-    (*result)[key] = base::NullableString16(value, false);
+    result->insert(std::make_pair(statement.ColumnString16(0),
+                                  base::NullableString16(value, false)));
   }
   known_to_be_empty_ = result->empty();
 }
@@ -95,8 +95,8 @@ bool DOMStorageDatabase::CommitChanges(bool clear_all_first,
   DOMStorageValuesMap::const_iterator it = changes.begin();
   for(; it != changes.end(); ++it) {
     sql::Statement statement;
-    base::string16 key = it->first;
-    base::NullableString16 value = it->second;
+    const base::string16& key = it->first;
+    const base::NullableString16& value = it->second;
     if (value.is_null()) {
       statement.Assign(db_->GetCachedStatement(SQL_FROM_HERE,
          "DELETE FROM ItemTable WHERE key=?"));
@@ -5,6 +5,7 @@
 #include "content/browser/download/download_file_impl.h"
 
 #include <string>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/file_util.h"
@@ -26,6 +27,11 @@ namespace content {
 const int kUpdatePeriodMs = 500;
 const int kMaxTimeBlockingFileThreadMs = 1000;
 
+// Buffers read from the stream are gathered into writes of up to this many
+// bytes. Network reads are often only a few kilobytes each, and writing and
+// hashing each one separately costs a file write per read.
+const size_t kMaxCoalescedWriteSize = 256 * 1024;
+
 int DownloadFile::number_active_objects_ = 0;
 
 DownloadFileImpl::DownloadFileImpl(
@@ -216,6 +222,12 @@ void DownloadFileImpl::StreamActive() {
   base::TimeDelta delta(
       base::TimeDelta::FromMilliseconds(kMaxTimeBlockingFileThreadMs));
 
+  // Small buffers are copied into |pending_data_| and written together once
+  // it fills up, the stream runs dry, or this task yields. Its capacity is
+  // kept between calls, so gathering never reallocates.
+  if (pending_data_.capacity() < kMaxCoalescedWriteSize)
+    pending_data_.reserve(kMaxCoalescedWriteSize);
+
   // Take care of any file local activity required.
   do {
     state = stream_reader_->Read(&incoming_data, &incoming_data_size);
@@ -226,16 +238,28 @@ void DownloadFileImpl::StreamActive() {
       case ByteStreamReader::STREAM_HAS_DATA:
         {
           ++num_buffers;
-          base::TimeTicks write_start(base::TimeTicks::Now());
-          reason = AppendDataToFile(
-              incoming_data.get()->data(), incoming_data_size);
-          disk_writes_time_ += (base::TimeTicks::Now() - write_start);
           bytes_seen_ += incoming_data_size;
           total_incoming_data_size += incoming_data_size;
+          const char* data = incoming_data.get()->data();
+          if (pending_data_.size() + incoming_data_size <=
+              kMaxCoalescedWriteSize) {
+            pending_data_.insert(
+                pending_data_.end(), data, data + incoming_data_size);
+            break;
+          }
+          reason = WritePendingData();
+          if (reason != DOWNLOAD_INTERRUPT_REASON_NONE)
+            break;
+          base::TimeTicks write_start(base::TimeTicks::Now());
+          reason = AppendDataToFile(data, incoming_data_size);
+          disk_writes_time_ += (base::TimeTicks::Now() - write_start);
         }
         break;
       case ByteStreamReader::STREAM_COMPLETE:
         {
+          reason = WritePendingData();
+          if (reason != DOWNLOAD_INTERRUPT_REASON_NONE)
+            break;
           reason = static_cast<DownloadInterruptReason>(
               stream_reader_->GetStatus());
           SendUpdate();
@@ -257,6 +281,10 @@ void DownloadFileImpl::StreamActive() {
            reason == DOWNLOAD_INTERRUPT_REASON_NONE &&
            now - start <= delta);
 
+  if (reason == DOWNLOAD_INTERRUPT_REASON_NONE)
+    reason = WritePendingData();
+  pending_data_.clear();
+
   // If we're stopping to yield the thread, post a task so we come back.
   if (state == ByteStreamReader::STREAM_HAS_DATA &&
       now - start > delta) {
@@ -305,6 +333,17 @@ void DownloadFileImpl::StreamActive() {
   }
 }
 
+DownloadInterruptReason DownloadFileImpl::WritePendingData() {
+  if (pending_data_.empty())
+    return DOWNLOAD_INTERRUPT_REASON_NONE;
+  base::TimeTicks write_start(base::TimeTicks::Now());
+  DownloadInterruptReason reason =
+      AppendDataToFile(&pending_data_[0], pending_data_.size());
+  disk_writes_time_ += (base::TimeTicks::Now() - write_start);
+  pending_data_.clear();
+  return reason;
+}
+
 void DownloadFileImpl::SendUpdate() {
   BrowserThread::PostTask(
       BrowserThread::UI, FROM_HERE,
@@ -580,6 +580,24 @@ TEST_F(DownloadFileTest, StreamNonEmptyError) {
   DestroyDownloadFile(0);
 }
 
+// Small buffers are gathered into larger writes. Check that a buffer too
+// large to gather, arriving between small ones, still lands on disk in order.
+TEST_F(DownloadFileTest, StreamMixedBufferSizes) {
+  ASSERT_TRUE(CreateDownloadFile(0, true));
+
+  const std::string large_data(300 * 1024, 'x');
+  const char* chunks1[] = { kTestData1, large_data.c_str(), kTestData2 };
+  AppendDataToFile(chunks1, 3);
+
+  // Gathered data is written before the stream goes quiet, so the next
+  // buffers are appended after it.
+  const char* chunks2[] = { kTestData3, kTestData1 };
+  AppendDataToFile(chunks2, 2);
+
+  FinishStream(DOWNLOAD_INTERRUPT_REASON_NONE, true);
+  DestroyDownloadFile(0);
+}
+
 // Send some data, wait 3/4s of a second, run the message loop, and
 // confirm the values the observer received are correct.
 TEST_F(DownloadFileTest, ConfirmUpdate) {
@@ -4,6 +4,9 @@
 
 #include "content/browser/gpu/shader_disk_cache.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "base/threading/thread_checker.h"
 #include "content/browser/gpu/gpu_process_host.h"
 #include "content/public/browser/browser_thread.h"
@@ -93,12 +96,26 @@ class ShaderDiskReadHelper
   int ReadComplete(int rv);
   int IterationComplete(int rv);
 
+  struct LoadedEntry {
+    base::Time last_used;
+    std::string key;
+    std::string data;
+  };
+
+  static bool LessRecentlyUsed(const LoadedEntry& a, const LoadedEntry& b) {
+    return a.last_used < b.last_used;
+  }
+
   base::WeakPtr<ShaderDiskCache> cache_;
   OpType op_type_;
   void* iter_;
   scoped_refptr<net::IOBufferWithSize> buf_;
   int host_id_;
   disk_cache::Entry* entry_;
+  // Shaders read so far. They are sent to the GPU process once the iteration
+  // is finished, least recently used first, so that the in-memory cache keeps
+  // the most recently used ones if they don't all fit.
+  std::vector<LoadedEntry> loaded_entries_;
 
   DISALLOW_COPY_AND_ASSIGN(ShaderDiskReadHelper);
 };
@@ -322,10 +339,11 @@ int ShaderDiskReadHelper::ReadComplete(int rv) {
   DCHECK(CalledOnValidThread());
   // Called through OnOpComplete, so we know |cache_| is valid.
   if (rv && rv == buf_->size()) {
-    GpuProcessHost* host = GpuProcessHost::FromID(host_id_);
-    if (host)
-      host->LoadedShader(entry_->GetKey(), std::string(buf_->data(),
-                                                       buf_->size()));
+    LoadedEntry loaded;
+    loaded.last_used = entry_->GetLastUsed();
+    loaded.key = entry_->GetKey();
+    loaded.data.assign(buf_->data(), buf_->size());
+    loaded_entries_.push_back(loaded);
   }
 
   buf_ = NULL;
@@ -341,6 +359,15 @@ int ShaderDiskReadHelper::IterationComplete(int rv) {
   // Called through OnOpComplete, so we know |cache_| is valid.
   cache_->backend()->EndEnumeration(&iter_);
   iter_ = NULL;
+
+  std::stable_sort(loaded_entries_.begin(), loaded_entries_.end(),
+                   &ShaderDiskReadHelper::LessRecentlyUsed);
+  GpuProcessHost* host = GpuProcessHost::FromID(host_id_);
+  if (host) {
+    for (size_t i = 0; i < loaded_entries_.size(); ++i)
+      host->LoadedShader(loaded_entries_[i].key, loaded_entries_[i].data);
+  }
+  loaded_entries_.clear();
   op_type_ = TERMINATE;
   return net::OK;
 }
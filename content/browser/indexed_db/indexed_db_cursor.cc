@@ -123,10 +123,9 @@ void IndexedDBCursor::CursorPrefetchIterationOperation(
         found_values.push_back(std::string());
         break;
       case indexed_db::CURSOR_KEY_AND_VALUE: {
-        std::string value;
-        value.swap(*cursor_->Value());
-        size_estimate += value.size();
-        found_values.push_back(value);
+        found_values.push_back(std::string());
+        found_values.back().swap(*cursor_->Value());
+        size_estimate += found_values.back().size();
         break;
       }
       default:
@@ -145,7 +144,7 @@ void IndexedDBCursor::CursorPrefetchIterationOperation(
   }
 
   callbacks->OnSuccessWithPrefetch(
-      found_keys, found_primary_keys, found_values);
+      found_keys, found_primary_keys, &found_values);
 }
 
 void IndexedDBCursor::PrefetchReset(int used_prefetches, int) {
@@ -18,6 +18,15 @@
 
 namespace content {
 
+namespace {
+
+// ProcessTaskQueue yields after running tasks for this long, so that one
+// transaction with a deep queue doesn't monopolize the IndexedDB thread that
+// every other transaction in the profile shares.
+const int kMaxProcessTaskQueueTimeMs = 50;
+
+}  // namespace
+
 IndexedDBTransaction::TaskQueue::TaskQueue() {}
 IndexedDBTransaction::TaskQueue::~TaskQueue() { clear(); }
 
@@ -282,6 +291,8 @@ void IndexedDBTransaction::ProcessTaskQueue() {
   // the loop termination conditions can be checked.
   scoped_refptr<IndexedDBTransaction> protect(this);
 
+  const base::TimeTicks deadline = base::TimeTicks::Now() +
+      base::TimeDelta::FromMilliseconds(kMaxProcessTaskQueueTimeMs);
   TaskQueue* task_queue =
       pending_preemptive_events_ ? &preemptive_task_queue_ : &task_queue_;
   while (!task_queue->empty() && state_ != FINISHED) {
@@ -296,6 +307,19 @@ void IndexedDBTransaction::ProcessTaskQueue() {
     // Event itself may change which queue should be processed next.
     task_queue =
         pending_preemptive_events_ ? &preemptive_task_queue_ : &task_queue_;
+
+    // Out of time: let other work on this thread run, then pick up where we
+    // left off. A task may already have reposted us via EnsureTasksRunning().
+    if (!task_queue->empty() && state_ != FINISHED &&
+        base::TimeTicks::Now() >= deadline) {
+      if (!should_process_queue_) {
+        should_process_queue_ = true;
+        base::MessageLoop::current()->PostTask(
+            FROM_HERE,
+            base::Bind(&IndexedDBTransaction::ProcessTaskQueue, this));
+      }
+      return;
+    }
   }
 
   // If there are no pending tasks, we haven't already committed/aborted,
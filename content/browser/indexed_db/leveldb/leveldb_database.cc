@@ -7,6 +7,7 @@
 #include <cerrno>
 
 #include "base/basictypes.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/histogram.h"
@@ -21,6 +22,7 @@
 #include "third_party/leveldatabase/env_chromium.h"
 #include "third_party/leveldatabase/env_idb.h"
 #include "third_party/leveldatabase/src/helpers/memenv/memenv.h"
+#include "third_party/leveldatabase/src/include/leveldb/cache.h"
 #include "third_party/leveldatabase/src/include/leveldb/comparator.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
 #include "third_party/leveldatabase/src/include/leveldb/env.h"
@@ -44,6 +46,24 @@ static const bool kSyncWrites = true;
 static const bool kSyncWrites = false;
 #endif
 
+// Every origin has its own database, so rather than let LevelDB give each of
+// them its own 8MB block cache, they share one of the same size.
+static const size_t kBlockCacheSize = 8 * 1024 * 1024;
+
+namespace {
+class SharedBlockCache {
+ public:
+  SharedBlockCache() : cache_(leveldb::NewLRUCache(kBlockCacheSize)) {}
+  leveldb::Cache* get() { return cache_.get(); }
+
+ private:
+  scoped_ptr<leveldb::Cache> cache_;
+};
+}  // namespace
+
+static base::LazyInstance<SharedBlockCache>::Leaky g_block_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
 static leveldb::Slice MakeSlice(const StringPiece& s) {
   return leveldb::Slice(s.begin(), s.size());
 }
@@ -102,6 +122,7 @@ static leveldb::Status OpenDB(leveldb::Comparator* comparator,
   // https://code.google.com/p/chromium/issues/detail?id=227313#c11
   options.max_open_files = 80;
   options.env = env;
+  options.block_cache = g_block_cache.Get().get();
 
   // ChromiumEnv assumes UTF8, converts back to FilePath before using.
   return leveldb::DB::Open(options, path.AsUTF8Unsafe(), db);
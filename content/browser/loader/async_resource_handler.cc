@@ -39,6 +39,9 @@ namespace {
 static int kBufferSize = 1024 * 512;
 static int kMinAllocationSize = 1024 * 4;
 static int kMaxAllocationSize = 1024 * 32;
+// Used instead of kBufferSize for responses which are known to be bigger
+// than it, so that more data can be in flight while the renderer catches up.
+static int kLargeBufferSize = 1024 * 1024 * 2;
 
 void GetNumericArg(const std::string& name, int* result) {
   const std::string& value =
@@ -54,6 +57,7 @@ void InitializeResourceBufferConstants() {
   did_init = true;
 
   GetNumericArg("resource-buffer-size", &kBufferSize);
+  GetNumericArg("resource-buffer-large-size", &kLargeBufferSize);
   GetNumericArg("resource-buffer-min-allocation-size", &kMinAllocationSize);
   GetNumericArg("resource-buffer-max-allocation-size", &kMaxAllocationSize);
 }
@@ -102,6 +106,8 @@ bool AsyncResourceHandler::OnMessageReceived(const IPC::Message& message,
   IPC_BEGIN_MESSAGE_MAP_EX(AsyncResourceHandler, message, *message_was_ok)
     IPC_MESSAGE_HANDLER(ResourceHostMsg_FollowRedirect, OnFollowRedirect)
     IPC_MESSAGE_HANDLER(ResourceHostMsg_DataReceived_ACK, OnDataReceivedACK)
+    IPC_MESSAGE_HANDLER(ResourceHostMsg_DataReceivedBatch_ACK,
+                        OnDataReceivedBatchACK)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP_EX()
   return handled;
@@ -123,13 +129,22 @@ void AsyncResourceHandler::OnFollowRedirect(
 }
 
 void AsyncResourceHandler::OnDataReceivedACK(int request_id) {
-  if (pending_data_count_) {
-    --pending_data_count_;
+  OnDataReceivedBatchACK(request_id, 1);
+}
+
+void AsyncResourceHandler::OnDataReceivedBatchACK(int request_id,
+                                                  int num_data_messages) {
+  // Unexpected ACKs are ignored, as the renderer may be misbehaving.
+  int num_acked = std::min(std::max(num_data_messages, 0),
+                           pending_data_count_);
+  if (!num_acked)
+    return;
 
+  pending_data_count_ -= num_acked;
+  for (int i = 0; i < num_acked; ++i)
     buffer_->RecycleLeastRecentlyAllocated();
-    if (buffer_->CanAllocate())
-      ResumeIfDeferred();
-  }
+  if (buffer_->CanAllocate())
+    ResumeIfDeferred();
 }
 
 bool AsyncResourceHandler::OnUploadProgress(int request_id,
@@ -368,8 +383,12 @@ bool AsyncResourceHandler::EnsureResourceBufferIsInitialized() {
     }
   }
 
+  int buffer_size = kBufferSize;
+  if (request()->GetExpectedContentSize() > kBufferSize)
+    buffer_size = std::max(kBufferSize, kLargeBufferSize);
+
   buffer_ = new ResourceBuffer();
-  return buffer_->Initialize(kBufferSize,
+  return buffer_->Initialize(buffer_size,
                              kMinAllocationSize,
                              kMaxAllocationSize);
 }
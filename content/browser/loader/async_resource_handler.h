@@ -68,6 +68,7 @@ class AsyncResourceHandler : public ResourceHandler,
                         bool has_new_first_party_for_cookies,
                         const GURL& new_first_party_for_cookies);
   void OnDataReceivedACK(int request_id);
+  void OnDataReceivedBatchACK(int request_id, int num_data_messages);
 
   bool EnsureResourceBufferIsInitialized();
   void ResumeIfDeferred();
@@ -2122,6 +2122,53 @@ TEST_F(ResourceDispatcherHostTest, DelayedDataReceivedACKs) {
   }
 }
 
+// Tests that a single batched ACK for all outstanding DataReceived messages
+// lets a request which is held up by the renderer make progress.
+TEST_F(ResourceDispatcherHostTest, DelayedDataReceivedBatchACKs) {
+  EXPECT_EQ(0, host_.pending_requests());
+
+  HandleScheme("big-job");
+  MakeTestRequest(0, 1, GURL("big-job:0123456789,1000000"));
+
+  ResourceIPCAccumulator::ClassifiedMessages msgs;
+  accum_.GetClassifiedMessages(&msgs);
+
+  EXPECT_EQ(ResourceMsg_ReceivedResponse::ID, msgs[0][0].type());
+  EXPECT_EQ(ResourceMsg_SetDataBuffer::ID, msgs[0][1].type());
+  for (size_t i = 2; i < msgs[0].size(); ++i)
+    EXPECT_EQ(ResourceMsg_DataReceived::ID, msgs[0][i].type());
+
+  msgs[0].erase(msgs[0].begin());
+  msgs[0].erase(msgs[0].begin());
+
+  // ACK each round of DataReceived messages at once until we find a
+  // RequestComplete message.
+  bool complete = false;
+  while (!complete) {
+    int num_data_messages = 0;
+    for (size_t i = 0; i < msgs[0].size(); ++i) {
+      if (msgs[0][i].type() == ResourceMsg_RequestComplete::ID) {
+        complete = true;
+        break;
+      }
+      EXPECT_EQ(ResourceMsg_DataReceived::ID, msgs[0][i].type());
+      ++num_data_messages;
+    }
+
+    if (!complete) {
+      ASSERT_GT(num_data_messages, 0);
+      ResourceHostMsg_DataReceivedBatch_ACK msg(1, num_data_messages);
+      bool msg_was_ok;
+      host_.OnMessageReceived(msg, filter_.get(), &msg_was_ok);
+    }
+
+    base::MessageLoop::current()->RunUntilIdle();
+
+    msgs.clear();
+    accum_.GetClassifiedMessages(&msgs);
+  }
+}
+
 // Flakyness of this test might indicate memory corruption issues with
 // for example the ResourceBuffer of AsyncResourceHandler.
 TEST_F(ResourceDispatcherHostTest, DataReceivedUnexpectedACKs) {
@@ -21,6 +21,7 @@
 namespace content {
 
 static const size_t kMaxNumDelayableRequestsPerClient = 10;
+static const size_t kMaxNumDelayableRequestsPerHost = 6;
 
 // A thin wrapper around net::PriorityQueue that deals with
 // ScheduledResourceRequests instead of PriorityQueue::Pointers.
@@ -50,6 +51,16 @@ class ResourceScheduler::RequestQueue {
     return queue_.FirstMax().value();
   }
 
+  // Returns the request queued after |request| in priority order, or NULL if
+  // |request| is the last one.
+  ScheduledResourceRequest* GetNextTowardsLastMin(
+      ScheduledResourceRequest* request) const {
+    PointerMap::const_iterator it = pointers_.find(request);
+    DCHECK(it != pointers_.end());
+    NetQueue::Pointer next = queue_.GetNextTowardsLastMin(it->second);
+    return next.is_null() ? NULL : next.value();
+  }
+
   // Returns true if |request| is queued.
   bool IsQueued(ScheduledResourceRequest* request) const {
     return ContainsKey(pointers_, request);
@@ -171,7 +182,7 @@ scoped_ptr<ResourceThrottle> ResourceScheduler::ScheduleRequest(
   }
 
   Client* client = it->second;
-  if (ShouldStartRequest(request.get(), client)) {
+  if (ShouldStartRequest(request.get(), client) == START_REQUEST) {
     StartRequest(request.get(), client);
   } else {
     client->pending_requests.Insert(request.get(), url_request->priority());
@@ -299,32 +310,53 @@ void ResourceScheduler::ReprioritizeRequest(ScheduledResourceRequest* request,
 }
 
 void ResourceScheduler::LoadAnyStartablePendingRequests(Client* client) {
-  while (!client->pending_requests.IsEmpty()) {
-    ScheduledResourceRequest* request = client->pending_requests.FirstMax();
-    if (ShouldStartRequest(request, client)) {
+  // Requests that are only held back by their host's limit are skipped, so
+  // that they don't block lower priority requests to other hosts.
+  if (client->pending_requests.IsEmpty())
+    return;
+  ScheduledResourceRequest* request = client->pending_requests.FirstMax();
+  while (request) {
+    ShouldStartReqResult query_result = ShouldStartRequest(request, client);
+    if (query_result == START_REQUEST) {
       client->pending_requests.Erase(request);
       StartRequest(request, client);
+      // StartRequest() may have run code that modified the queue, so start
+      // over from the highest priority request.
+      request = client->pending_requests.IsEmpty() ?
+          NULL : client->pending_requests.FirstMax();
+    } else if (query_result == DO_NOT_START_REQUEST_AND_KEEP_SEARCHING) {
+      request = client->pending_requests.GetNextTowardsLastMin(request);
     } else {
+      DCHECK_EQ(DO_NOT_START_REQUEST_AND_STOP_SEARCHING, query_result);
       break;
     }
   }
 }
 
-size_t ResourceScheduler::GetNumDelayableRequestsInFlight(
-    Client* client) const {
-  size_t count = 0;
+void ResourceScheduler::GetNumDelayableRequestsInFlight(
+    Client* client,
+    const net::HostPortPair& active_request_host,
+    size_t* total_delayable,
+    size_t* total_for_active_host) const {
+  size_t total_delayable_count = 0;
+  size_t same_host_count = 0;
   for (RequestSet::iterator it = client->in_flight_requests.begin();
        it != client->in_flight_requests.end(); ++it) {
-    if ((*it)->url_request()->priority() < net::LOW) {
-      const net::HttpServerProperties& http_server_properties =
-          *(*it)->url_request()->context()->http_server_properties();
-      if (!http_server_properties.SupportsSpdy(
-          net::HostPortPair::FromURL((*it)->url_request()->url()))) {
-        ++count;
-      }
-    }
+    const net::URLRequest& url_request = *(*it)->url_request();
+    if (url_request.priority() >= net::LOW)
+      continue;
+    net::HostPortPair host_port_pair =
+        net::HostPortPair::FromURL(url_request.url());
+    const net::HttpServerProperties& http_server_properties =
+        *url_request.context()->http_server_properties();
+    if (http_server_properties.SupportsSpdy(host_port_pair))
+      continue;
+    ++total_delayable_count;
+    if (host_port_pair.Equals(active_request_host))
+      ++same_host_count;
   }
-  return count;
+  *total_delayable = total_delayable_count;
+  *total_for_active_host = same_host_count;
 }
 
 // ShouldStartRequest is the main scheduling algorithm.
@@ -344,15 +376,20 @@ size_t ResourceScheduler::GetNumDelayableRequestsInFlight(
 //     requests.
 //   * Once the renderer has a <body>, start loading delayable requests.
 //   * Never exceed 10 delayable requests in flight per client.
+//   * Never exceed 6 delayable requests in flight for a single host, so
+//     that delayable requests can't occupy every connection the socket pool
+//     allows to that host and hold back higher priority requests that are
+//     discovered later.
 //   * Prior to <body>, allow one delayable request to load at a time.
-bool ResourceScheduler::ShouldStartRequest(ScheduledResourceRequest* request,
-                                           Client* client) const {
+ResourceScheduler::ShouldStartReqResult ResourceScheduler::ShouldStartRequest(
+    ScheduledResourceRequest* request,
+    Client* client) const {
   const net::URLRequest& url_request = *request->url_request();
 
   // TODO(simonjam): This may end up causing disk contention. We should
   // experiment with throttling if that happens.
   if (!url_request.url().SchemeIsHTTPOrHTTPS()) {
-    return true;
+    return START_REQUEST;
   }
 
   const net::HttpServerProperties& http_server_properties =
@@ -361,29 +398,40 @@ bool ResourceScheduler::ShouldStartRequest(ScheduledResourceRequest* request,
   // TODO(willchan): We should really improve this algorithm as described in
   // crbug.com/164101. Also, theoretically we should not count a SPDY request
   // against the delayable requests limit.
+  net::HostPortPair host_port_pair =
+      net::HostPortPair::FromURL(url_request.url());
   bool origin_supports_spdy = http_server_properties.SupportsSpdy(
-      net::HostPortPair::FromURL(url_request.url()));
+      host_port_pair);
 
   if (url_request.priority() >= net::LOW ||
       !ResourceRequestInfo::ForRequest(&url_request)->IsAsync() ||
       origin_supports_spdy) {
-    return true;
+    return START_REQUEST;
   }
 
-  size_t num_delayable_requests_in_flight =
-      GetNumDelayableRequestsInFlight(client);
+  size_t num_delayable_requests_in_flight = 0;
+  size_t num_requests_in_flight_for_host = 0;
+  GetNumDelayableRequestsInFlight(client, host_port_pair,
+                                  &num_delayable_requests_in_flight,
+                                  &num_requests_in_flight_for_host);
   if (num_delayable_requests_in_flight >= kMaxNumDelayableRequestsPerClient) {
-    return false;
+    return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+  }
+
+  if (num_requests_in_flight_for_host >= kMaxNumDelayableRequestsPerHost) {
+    // There may be other requests for other hosts we'd allow, so keep
+    // checking.
+    return DO_NOT_START_REQUEST_AND_KEEP_SEARCHING;
   }
 
   bool have_immediate_requests_in_flight =
       client->in_flight_requests.size() > num_delayable_requests_in_flight;
   if (have_immediate_requests_in_flight && !client->has_body &&
       num_delayable_requests_in_flight != 0) {
-    return false;
+    return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
   }
 
-  return true;
+  return START_REQUEST;
 }
 
 ResourceScheduler::ClientId ResourceScheduler::MakeClientId(
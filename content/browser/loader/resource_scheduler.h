@@ -17,6 +17,7 @@
 #include "net/base/request_priority.h"
 
 namespace net {
+class HostPortPair;
 class URLRequest;
 }
 
@@ -86,6 +87,12 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   typedef std::map<ClientId, Client*> ClientMap;
   typedef std::set<ScheduledResourceRequest*> RequestSet;
 
+  enum ShouldStartReqResult {
+    DO_NOT_START_REQUEST_AND_STOP_SEARCHING,
+    DO_NOT_START_REQUEST_AND_KEEP_SEARCHING,
+    START_REQUEST
+  };
+
   // Called when a ScheduledResourceRequest is destroyed.
   void RemoveRequest(ScheduledResourceRequest* request);
 
@@ -105,14 +112,20 @@ class CONTENT_EXPORT ResourceScheduler : public base::NonThreadSafe {
   // results of ShouldStartRequest().
   void LoadAnyStartablePendingRequests(Client* client);
 
-  // Returns the number of requests with priority < LOW that are currently in
-  // flight.
-  size_t GetNumDelayableRequestsInFlight(Client* client) const;
-
-  // Returns true if the request should start. This is the core scheduling
-  // algorithm.
-  bool ShouldStartRequest(ScheduledResourceRequest* request,
-                          Client* client) const;
+  // Sets |total_delayable| to the number of requests with priority < LOW that
+  // are currently in flight, and |total_for_active_host| to how many of those
+  // are to |active_request_host|. Requests to SPDY-capable hosts don't count.
+  void GetNumDelayableRequestsInFlight(
+      Client* client,
+      const net::HostPortPair& active_request_host,
+      size_t* total_delayable,
+      size_t* total_for_active_host) const;
+
+  // Returns whether the request should start, and if not, whether lower
+  // priority pending requests may still be able to. This is the core
+  // scheduling algorithm.
+  ShouldStartReqResult ShouldStartRequest(ScheduledResourceRequest* request,
+                                          Client* client) const;
 
   // Returns the client ID for the given |child_id| and |route_id| combo.
   ClientId MakeClientId(int child_id, int route_id);
@@ -320,7 +320,7 @@ TEST_F(ResourceSchedulerTest, LimitedNumberOfDelayableRequestsInFlight) {
   const int kMaxNumDelayableRequestsPerClient = 10;  // Should match the .cc.
   ScopedVector<TestRequest> lows;
   for (int i = 0; i < kMaxNumDelayableRequestsPerClient; ++i) {
-    string url = "http://host/low" + base::IntToString(i);
+    string url = "http://host" + base::IntToString(i) + "/low";
     lows.push_back(NewRequest(url.c_str(), net::LOWEST));
     EXPECT_TRUE(lows[i]->started());
   }
@@ -333,6 +333,38 @@ TEST_F(ResourceSchedulerTest, LimitedNumberOfDelayableRequestsInFlight) {
   EXPECT_TRUE(last->started());
 }
 
+TEST_F(ResourceSchedulerTest, LimitedNumberOfDelayableRequestsPerHost) {
+  // We only load low priority resources if there's a body.
+  scheduler_.OnWillInsertBody(kChildId, kRouteId);
+
+  const int kMaxNumDelayableRequestsPerHost = 6;  // Should match the .cc.
+  ScopedVector<TestRequest> lows_same_host;
+  for (int i = 0; i < kMaxNumDelayableRequestsPerHost; ++i) {
+    string url = "http://host/low" + base::IntToString(i);
+    lows_same_host.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows_same_host[i]->started());
+  }
+
+  scoped_ptr<TestRequest> second_last_same_host(NewRequest("http://host/last",
+                                                           net::LOWEST));
+  scoped_ptr<TestRequest> last_same_host(NewRequest("http://host/s_last",
+                                                    net::LOWEST));
+  EXPECT_FALSE(second_last_same_host->started());
+  EXPECT_FALSE(last_same_host->started());
+
+  // A request to another host isn't held back by the queued ones.
+  scoped_ptr<TestRequest> other_host(NewRequest("http://otherhost/low",
+                                                net::LOWEST));
+  EXPECT_TRUE(other_host->started());
+
+  lows_same_host.erase(lows_same_host.begin());
+  EXPECT_TRUE(second_last_same_host->started());
+  EXPECT_FALSE(last_same_host->started());
+
+  lows_same_host.erase(lows_same_host.begin());
+  EXPECT_TRUE(last_same_host->started());
+}
+
 TEST_F(ResourceSchedulerTest, RaisePriorityAndStart) {
   // Dummies to enforce scheduling.
   scoped_ptr<TestRequest> high(NewRequest("http://host/high", net::HIGHEST));
@@ -362,7 +394,7 @@ TEST_F(ResourceSchedulerTest, RaisePriorityInQueue) {
   const int kMaxNumDelayableRequestsPerClient = 10;  // Should match the .cc.
   ScopedVector<TestRequest> lows;
   for (int i = 0; i < kMaxNumDelayableRequestsPerClient - 1; ++i) {
-    string url = "http://host/low" + base::IntToString(i);
+    string url = "http://host" + base::IntToString(i) + "/low";
     lows.push_back(NewRequest(url.c_str(), net::LOWEST));
   }
 
@@ -391,7 +423,7 @@ TEST_F(ResourceSchedulerTest, LowerPriority) {
   const int kNumFillerRequests = kMaxNumDelayableRequestsPerClient - 2;
   ScopedVector<TestRequest> lows;
   for (int i = 0; i < kNumFillerRequests; ++i) {
-    string url = "http://host/low" + base::IntToString(i);
+    string url = "http://host" + base::IntToString(i) + "/low";
     lows.push_back(NewRequest(url.c_str(), net::LOWEST));
   }
 
@@ -413,7 +445,7 @@ TEST_F(ResourceSchedulerTest, ReprioritizedRequestGoesToBackOfQueue) {
   const int kMaxNumDelayableRequestsPerClient = 10;  // Should match the .cc.
   ScopedVector<TestRequest> lows;
   for (int i = 0; i < kMaxNumDelayableRequestsPerClient; ++i) {
-    string url = "http://host/low" + base::IntToString(i);
+    string url = "http://host" + base::IntToString(i) + "/low";
     lows.push_back(NewRequest(url.c_str(), net::LOWEST));
   }
 
@@ -213,6 +213,12 @@ class SQLitePersistentCookieStore::Backend
   sql::MetaTable meta_table_;
 
   typedef std::list<PendingOperation*> PendingOperationsList;
+
+  // Drops the operations in |ops| which a later one makes redundant: an add
+  // followed by a delete of the same cookie cancel out, and an access time
+  // update is folded into a pending add or replaces an earlier update.
+  static void CoalesceOperations(PendingOperationsList* ops);
+
   PendingOperationsList pending_;
   PendingOperationsList::size_type num_pending_;
   // True if the persistent store should skip delete on exit rules.
@@ -905,6 +911,69 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
   }
 }
 
+// static
+void SQLitePersistentCookieStore::Backend::CoalesceOperations(
+    PendingOperationsList* ops) {
+  // Cookies are identified in the DB by their creation time. These track,
+  // for each cookie, its pending add and its last pending access time update
+  // since the last delete.
+  typedef std::map<int64, PendingOperationsList::iterator> OperationMap;
+  OperationMap adds;
+  OperationMap updates;
+
+  for (PendingOperationsList::iterator it = ops->begin(); it != ops->end();) {
+    PendingOperation* po = *it;
+    const int64 creation_utc = po->cc().CreationDate().ToInternalValue();
+    OperationMap::iterator add = adds.find(creation_utc);
+    OperationMap::iterator update = updates.find(creation_utc);
+
+    switch (po->op()) {
+      case PendingOperation::COOKIE_ADD:
+        adds[creation_utc] = it;
+        break;
+
+      case PendingOperation::COOKIE_UPDATEACCESS:
+        if (add != adds.end()) {
+          // Add the cookie with its new access time instead.
+          delete *add->second;
+          *add->second =
+              new PendingOperation(PendingOperation::COOKIE_ADD, po->cc());
+          delete po;
+          it = ops->erase(it);
+          continue;
+        }
+        if (update != updates.end()) {
+          delete *update->second;
+          ops->erase(update->second);
+        }
+        updates[creation_utc] = it;
+        break;
+
+      case PendingOperation::COOKIE_DELETE:
+        if (update != updates.end()) {
+          delete *update->second;
+          ops->erase(update->second);
+          updates.erase(update);
+        }
+        if (add != adds.end()) {
+          // The cookie never needs to reach the DB.
+          delete *add->second;
+          ops->erase(add->second);
+          adds.erase(add);
+          delete po;
+          it = ops->erase(it);
+          continue;
+        }
+        break;
+
+      default:
+        NOTREACHED();
+        break;
+    }
+    ++it;
+  }
+}
+
 void SQLitePersistentCookieStore::Backend::Commit() {
   DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
 
@@ -919,6 +988,10 @@ void SQLitePersistentCookieStore::Backend::Commit() {
   if (!db_.get() || ops.empty())
     return;
 
+  CoalesceOperations(&ops);
+  if (ops.empty())
+    return;
+
   sql::Statement add_smt(db_->GetCachedStatement(SQL_FROM_HERE,
       "INSERT INTO cookies (creation_utc, host_key, name, value, path, "
       "expires_utc, secure, httponly, last_access_utc, has_expires, "
@@ -211,6 +211,46 @@ TEST_F(SQLitePersistentCookieStoreTest, TestPersistance) {
   ASSERT_EQ(0U, cookies.size());
 }
 
+// Test that operations batched together are coalesced correctly.
+TEST_F(SQLitePersistentCookieStoreTest, TestCoalescedOperations) {
+  InitializeStore(false);
+  base::Time t = base::Time::Now();
+  base::Time accessed = t + base::TimeDelta::FromMinutes(10);
+
+  // A cookie which is added and then updated in the same batch.
+  AddCookie("A", "B", "foo.bar", "/", t);
+  store_->UpdateCookieAccessTime(
+      net::CanonicalCookie(GURL(), "A", "B", "foo.bar", "/", t, t, accessed,
+                           false, false, net::COOKIE_PRIORITY_DEFAULT));
+  // A cookie which is added, updated and deleted in the same batch.
+  base::Time t2 = t + base::TimeDelta::FromMicroseconds(1);
+  net::CanonicalCookie deleted(GURL(), "C", "D", "foo.bar", "/", t2, t2, t2,
+                               false, false, net::COOKIE_PRIORITY_DEFAULT);
+  store_->AddCookie(deleted);
+  store_->UpdateCookieAccessTime(deleted);
+  store_->DeleteCookie(deleted);
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ("A", cookies[0]->Name());
+  EXPECT_EQ(accessed, cookies[0]->LastAccessDate());
+
+  // Updates of a cookie already in the DB keep the last access time.
+  store_->UpdateCookieAccessTime(*cookies[0]);
+  store_->UpdateCookieAccessTime(
+      net::CanonicalCookie(GURL(), "A", "B", "foo.bar", "/", t, t, t,
+                           false, false, net::COOKIE_PRIORITY_DEFAULT));
+  DestroyStore();
+  STLDeleteElements(&cookies);
+
+  CreateAndLoad(false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ(t, cookies[0]->LastAccessDate());
+  STLDeleteElements(&cookies);
+}
+
 // Test that priority load of cookies for a specfic domain key could be
 // completed before the entire store is loaded
 TEST_F(SQLitePersistentCookieStoreTest, TestLoadCookiesForKey) {
@@ -18,7 +18,8 @@ ProfilerMessageFilter::ProfilerMessageFilter(int process_type)
 void ProfilerMessageFilter::OnChannelConnected(int32 peer_pid) {
   tracked_objects::ThreadData::Status status =
       tracked_objects::ThreadData::status();
-  Send(new ChildProcessMsg_SetProfilerStatus(status));
+  Send(new ChildProcessMsg_SetProfilerStatus(
+      status, tracked_objects::ThreadData::sampling_interval()));
 }
 
 bool ProfilerMessageFilter::OnMessageReceived(const IPC::Message& message,
@@ -406,8 +406,13 @@ bool ImmediateInputRouter::OfferToRenderer(const WebInputEvent& input_event,
                                            const ui::LatencyInfo& latency_info,
                                            bool is_keyboard_shortcut) {
   input_event_start_time_ = TimeTicks::Now();
-  if (Send(new InputMsg_HandleInputEvent(
-          routing_id(), &input_event, latency_info, is_keyboard_shortcut))) {
+  IPC::Message* message = new InputMsg_HandleInputEvent(
+      routing_id(), &input_event, latency_info, is_keyboard_shortcut);
+  // Input latency is what the user notices first, so let the event overtake
+  // messages still queued for the renderer's other routes. It stays behind
+  // the edit commands, resizes and focus changes already sent to this one.
+  message->set_priority(IPC::Message::PRIORITY_HIGH);
+  if (Send(message)) {
     client_->IncrementInFlightEventCount();
     return true;
   }
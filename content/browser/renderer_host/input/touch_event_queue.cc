@@ -6,6 +6,7 @@
 
 #include "base/auto_reset.h"
 #include "base/debug/trace_event.h"
+#include "base/metrics/histogram.h"
 #include "base/stl_util.h"
 
 namespace content {
@@ -220,6 +221,9 @@ void TouchEventQueue::PopTouchEventToClient(
   if (acked_event->ignore_ack())
     return;
 
+  HISTOGRAM_COUNTS_100("Renderer.TouchEventsCoalescedPerAck",
+                       acked_event->size());
+
   // Note that acking the touch-event may result in multiple gestures being sent
   // to the renderer, or touch-events being queued.
   base::AutoReset<CoalescedWebTouchEvent*>
@@ -249,9 +253,10 @@ bool TouchEventQueue::ShouldForwardToRenderer(
     if (point.state == WebKit::WebTouchPoint::StateStationary)
       continue;
 
-    if (touch_ack_states_.count(point.id) > 0) {
-      if (touch_ack_states_.find(point.id)->second !=
-          INPUT_EVENT_ACK_STATE_NO_CONSUMER_EXISTS)
+    TouchPointAckStates::const_iterator ack_state =
+        touch_ack_states_.find(point.id);
+    if (ack_state != touch_ack_states_.end()) {
+      if (ack_state->second != INPUT_EVENT_ACK_STATE_NO_CONSUMER_EXISTS)
         return true;
     } else {
       // If the ACK status of a point is unknown, then the event should be
@@ -1015,10 +1015,12 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     cc::switches::kCompositeToMailbox,
     cc::switches::kDisableCompositedAntialiasing,
     cc::switches::kDisableCompositorTouchHitTesting,
+    cc::switches::kDisableGPURasterization,
     cc::switches::kDisableImplSidePainting,
     cc::switches::kDisableLCDText,
     cc::switches::kDisableMapImage,
     cc::switches::kDisableThreadedAnimation,
+    cc::switches::kEnableGPURasterization,
     cc::switches::kEnableImplSidePainting,
     cc::switches::kEnableLCDText,
     cc::switches::kEnableMapImage,
@@ -1318,7 +1320,8 @@ void RenderProcessHostImpl::OnChannelConnected(int32 peer_pid) {
 
   tracked_objects::ThreadData::Status status =
       tracked_objects::ThreadData::status();
-  Send(new ChildProcessMsg_SetProfilerStatus(status));
+  Send(new ChildProcessMsg_SetProfilerStatus(
+      status, tracked_objects::ThreadData::sampling_interval()));
 
   Send(new ViewMsg_SetRendererProcessID(GetID()));
 }
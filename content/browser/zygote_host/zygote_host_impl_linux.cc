@@ -265,6 +265,8 @@ pid_t ZygoteHostImpl::ForkRequest(
   pickle.WriteInt(mapping.size());
 
   std::vector<int> fds;
+  // The ScopedFDs below point into |fds|, so it must never reallocate.
+  fds.reserve(mapping.size());
   // Scoped pointers cannot be stored in containers, so we have to use a
   // linked_ptr.
   std::vector<linked_ptr<file_util::ScopedFD> > autodelete_fds;
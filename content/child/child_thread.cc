@@ -419,7 +419,9 @@ void ChildThread::OnSetIPCLoggingEnabled(bool enable) {
 }
 #endif  //  IPC_MESSAGE_LOG_ENABLED
 
-void ChildThread::OnSetProfilerStatus(ThreadData::Status status) {
+void ChildThread::OnSetProfilerStatus(ThreadData::Status status,
+                                      int sampling_interval) {
+  ThreadData::SetSamplingInterval(sampling_interval);
   ThreadData::InitializeAndSetTrackingStatus(status);
 }
 
@@ -449,8 +449,37 @@ void ResourceDispatcher::OnReceivedData(int request_id,
                         base::TimeTicks::Now() - time_start);
   }
 
-  // Acknowledge the reception of this data.
-  message_sender()->Send(new ResourceHostMsg_DataReceived_ACK(request_id));
+  // Acknowledge the reception of this data.  The peer may have cancelled the
+  // request, in which case there is nothing to batch the ACK with.
+  request_info = GetPendingRequestInfo(request_id);
+  if (!request_info) {
+    message_sender()->Send(new ResourceHostMsg_DataReceived_ACK(request_id));
+    return;
+  }
+
+  // Data messages which are already queued are dispatched before the posted
+  // task runs, so a burst of them is acknowledged with a single message.
+  if (request_info->num_unacked_data_messages++ == 0) {
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE,
+        base::Bind(&ResourceDispatcher::SendDataReceivedACKs,
+                   weak_factory_.GetWeakPtr(),
+                   request_id));
+  }
+}
+
+void ResourceDispatcher::SendDataReceivedACKs(int request_id) {
+  PendingRequestInfo* request_info = GetPendingRequestInfo(request_id);
+  if (!request_info || !request_info->num_unacked_data_messages)
+    return;
+
+  if (request_info->num_unacked_data_messages == 1) {
+    message_sender()->Send(new ResourceHostMsg_DataReceived_ACK(request_id));
+  } else {
+    message_sender()->Send(new ResourceHostMsg_DataReceivedBatch_ACK(
+        request_id, request_info->num_unacked_data_messages));
+  }
+  request_info->num_unacked_data_messages = 0;
 }
 
 void ResourceDispatcher::OnDownloadedData(int request_id,
@@ -621,7 +650,8 @@ ResourceDispatcher::PendingRequestInfo::PendingRequestInfo()
     : peer(NULL),
       resource_type(ResourceType::SUB_RESOURCE),
       is_deferred(false),
-      buffer_size(0) {
+      buffer_size(0),
+      num_unacked_data_messages(0) {
 }
 
 ResourceDispatcher::PendingRequestInfo::PendingRequestInfo(
@@ -637,7 +667,9 @@ ResourceDispatcher::PendingRequestInfo::PendingRequestInfo(
       url(request_url),
       frame_origin(frame_origin),
       response_url(request_url),
-      request_start(base::TimeTicks::Now()) {
+      request_start(base::TimeTicks::Now()),
+      buffer_size(0),
+      num_unacked_data_messages(0) {
 }
 
 ResourceDispatcher::PendingRequestInfo::~PendingRequestInfo() {}
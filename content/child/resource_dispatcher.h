@@ -113,6 +113,8 @@ class CONTENT_EXPORT ResourceDispatcher : public IPC::Listener {
     base::TimeTicks completion_time;
     linked_ptr<base::SharedMemory> buffer;
     int buffer_size;
+    // Number of DataReceived messages handled but not yet acknowledged.
+    int num_unacked_data_messages;
   };
   typedef base::hash_map<int, PendingRequestInfo> PendingRequestList;
 
@@ -155,6 +157,10 @@ class CONTENT_EXPORT ResourceDispatcher : public IPC::Listener {
       const std::string& security_info,
       const base::TimeTicks& completion_time);
 
+  // Acknowledges all the DataReceived messages for the given request which
+  // have been handled since the last call.
+  void SendDataReceivedACKs(int request_id);
+
   // Dispatch the message to one of the message response handlers.
   void DispatchMessage(const IPC::Message& message);
 
@@ -141,6 +141,10 @@ class ResourceDispatcherTest : public testing::Test, public IPC::Sender {
 
       message_queue_.erase(message_queue_.begin());
 
+      // The ack is sent once the data messages which arrived together have
+      // been handled.
+      base::MessageLoop::current()->RunUntilIdle();
+
       // read the ack message.
       Tuple1<int> request_ack;
       ASSERT_TRUE(ResourceHostMsg_DataReceived_ACK::Read(
@@ -192,6 +196,7 @@ scoped_ptr<ResourceDispatcher> ResourceDispatcherTest::dispatcher_;
 
 // Does a simple request and tests that the correct data is received.
 TEST_F(ResourceDispatcherTest, RoundTrip) {
+  base::MessageLoop message_loop;
   TestRequestCallback callback;
   ResourceLoaderBridge* bridge = CreateBridge();
 
@@ -53,6 +53,7 @@ IPC_STRUCT_TRAITS_BEGIN(tracked_objects::ProcessDataSnapshot)
   IPC_STRUCT_TRAITS_MEMBER(tasks)
   IPC_STRUCT_TRAITS_MEMBER(descendants)
   IPC_STRUCT_TRAITS_MEMBER(process_id)
+  IPC_STRUCT_TRAITS_MEMBER(sampling_interval)
 IPC_STRUCT_TRAITS_END()
 
 IPC_ENUM_TRAITS(gfx::GpuMemoryBufferType)
@@ -79,9 +80,11 @@ IPC_MESSAGE_CONTROL1(ChildProcessMsg_SetIPCLoggingEnabled,
                      bool /* on or off */)
 #endif
 
-// Tell the child process to enable or disable the profiler status.
-IPC_MESSAGE_CONTROL1(ChildProcessMsg_SetProfilerStatus,
-                     tracked_objects::ThreadData::Status /* profiler status */)
+// Tell the child process to enable or disable the profiler status, and how
+// many tasks to skip between tallied ones.
+IPC_MESSAGE_CONTROL2(ChildProcessMsg_SetProfilerStatus,
+                     tracked_objects::ThreadData::Status /* profiler status */,
+                     int /* sampling interval */)
 
 // Send to all the child processes to send back profiler data (ThreadData in
 // tracked_objects).
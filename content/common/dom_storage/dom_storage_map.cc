@@ -68,8 +68,10 @@ base::NullableString16 DOMStorageMap::GetItem(const base::string16& key) const {
 bool DOMStorageMap::SetItem(
     const base::string16& key, const base::string16& value,
     base::NullableString16* old_value) {
-  DOMStorageValuesMap::const_iterator found = values_.find(key);
-  if (found == values_.end())
+  // Look the key up once; the iterator doubles as the insertion hint.
+  DOMStorageValuesMap::iterator found = values_.lower_bound(key);
+  bool exists = found != values_.end() && found->first == key;
+  if (!exists)
     *old_value = base::NullableString16();
   else
     *old_value = found->second;
@@ -84,7 +86,12 @@ bool DOMStorageMap::SetItem(
   if (new_item_size > old_item_size && new_bytes_used > quota_)
     return false;
 
-  values_[key] = base::NullableString16(value, false);
+  if (exists) {
+    found->second = base::NullableString16(value, false);
+  } else {
+    values_.insert(found,
+                   std::make_pair(key, base::NullableString16(value, false)));
+  }
   ResetKeyIterator();
   bytes_used_ = new_bytes_used;
   return true;
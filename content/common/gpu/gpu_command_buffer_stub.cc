@@ -8,6 +8,7 @@
 #include "base/debug/trace_event.h"
 #include "base/hash.h"
 #include "base/memory/shared_memory.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
 #include "content/common/gpu/gpu_channel.h"
@@ -27,6 +28,7 @@
 #include "gpu/command_buffer/service/gl_context_virtual.h"
 #include "gpu/command_buffer/service/gl_state_restorer_impl.h"
 #include "gpu/command_buffer/service/gpu_control_service.h"
+#include "gpu/command_buffer/service/gpu_switches.h"
 #include "gpu/command_buffer/service/image_manager.h"
 #include "gpu/command_buffer/service/logger.h"
 #include "gpu/command_buffer/service/memory_tracking.h"
@@ -129,6 +131,8 @@ GpuCommandBufferStub::GpuCommandBufferStub(
       software_(software),
       last_flush_count_(0),
       last_memory_allocation_valid_(false),
+      last_frontbuffer_suggestion_valid_(false),
+      last_frontbuffer_suggestion_(false),
       watchdog_(watchdog),
       sync_point_wait_count_(0),
       delayed_work_scheduled_(false),
@@ -423,6 +427,16 @@ void GpuCommandBufferStub::OnInitialize(
   if (preemption_flag_.get())
     scheduler_->SetPreemptByFlag(preemption_flag_);
 
+  // With a time slice, a busy context returns to GpuChannel::HandleMessage
+  // with commands left, which reposts itself so that other channels' messages
+  // are handled in between.
+  int time_slice_ms = 0;
+  if (base::StringToInt(CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+          switches::kGpuSchedulerTimeSliceMs),
+      &time_slice_ms) && time_slice_ms > 0) {
+    scheduler_->SetTimeSlice(base::TimeDelta::FromMilliseconds(time_slice_ms));
+  }
+
   decoder_->set_engine(scheduler_.get());
 
   if (!handle_.is_null()) {
@@ -945,10 +959,20 @@ void GpuCommandBufferStub::SetMemoryAllocation(
 
 void GpuCommandBufferStub::SuggestHaveFrontBuffer(
     bool suggest_have_frontbuffer) {
+  // The memory manager repeats its suggestion every time it recomputes
+  // allocations, so don't switch contexts unless the suggestion changed.
+  if (last_frontbuffer_suggestion_valid_ &&
+      last_frontbuffer_suggestion_ == suggest_have_frontbuffer) {
+    return;
+  }
+
   // This can be called outside of OnMessageReceived, so the context needs
   // to be made current before calling methods on the surface.
-  if (surface_.get() && MakeCurrent())
+  if (surface_.get() && MakeCurrent()) {
     surface_->SetFrontbufferAllocation(suggest_have_frontbuffer);
+    last_frontbuffer_suggestion_valid_ = true;
+    last_frontbuffer_suggestion_ = suggest_have_frontbuffer;
+  }
 }
 
 bool GpuCommandBufferStub::CheckContextLost() {
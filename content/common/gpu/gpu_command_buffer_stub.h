@@ -240,6 +240,10 @@ class GpuCommandBufferStub
   // elide redundant work).
   bool last_memory_allocation_valid_;
   gpu::MemoryAllocation last_memory_allocation_;
+  // The last front buffer suggestion passed on to |surface_| (used to avoid
+  // making the context current when the suggestion hasn't changed).
+  bool last_frontbuffer_suggestion_valid_;
+  bool last_frontbuffer_suggestion_;
 
   GpuWatchdog* watchdog_;
 
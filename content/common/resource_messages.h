@@ -300,6 +300,12 @@ IPC_SYNC_MESSAGE_ROUTED2_1(ResourceHostMsg_SyncLoad,
 IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataReceived_ACK,
                      int /* request_id */)
 
+// Sent when the renderer process is done processing several DataReceived
+// messages, so that a burst of data needs only one acknowledgement.
+IPC_MESSAGE_CONTROL2(ResourceHostMsg_DataReceivedBatch_ACK,
+                     int /* request_id */,
+                     int /* num_data_messages */)
+
 // Sent when the renderer has processed a DataDownloaded message.
 IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataDownloaded_ACK,
                      int /* request_id */)
@@ -277,6 +277,7 @@ scoped_ptr<RenderWidgetCompositor> RenderWidgetCompositor::Create(
       cmd->HasSwitch(cc::switches::kStrictLayerPropertyChangeChecking);
 
   settings.use_map_image = cc::switches::IsMapImageEnabled();
+  settings.gpu_rasterization = cc::switches::IsGPURasterizationEnabled();
 
 #if defined(OS_ANDROID)
   // TODO(danakj): Move these to the android code.
@@ -146,8 +146,12 @@ void PaintAggregator::InvalidateRect(const gfx::Rect& rect) {
     }
   }
 
-  if (update_.paint_rects.size() > kMaxPaintRects)
-    CombinePaintRects();
+  if (update_.paint_rects.size() > kMaxPaintRects) {
+    if (update_.scroll_rect.IsEmpty())
+      CombineCheapestPaintRects();
+    else
+      CombinePaintRects();
+  }
 
   // Track how large the paint_rects vector grows during an invalidation
   // sequence.  Note: A subsequent invalidation may end up being combined
@@ -260,10 +264,9 @@ void PaintAggregator::CombinePaintRects() {
   // and one outside the scroll_rect.  If there is no scroll_rect, then just
   // use the smallest bounding box for all paint rects.
   //
-  // NOTE: This is a fairly simple algorithm.  We could get fancier by only
-  // combining two rects to get us under the kMaxPaintRects limit, but if we
-  // reach this method then it means we're hitting a rare case, so there's no
-  // need to over-optimize it.
+  // NOTE: This is a fairly simple algorithm.  When there is no scroll_rect,
+  // InvalidateRect() uses CombineCheapestPaintRects() to get back under the
+  // kMaxPaintRects limit instead.
   //
   if (update_.scroll_rect.IsEmpty()) {
     gfx::Rect bounds = update_.GetPaintBounds();
@@ -285,4 +288,34 @@ void PaintAggregator::CombinePaintRects() {
   }
 }
 
+void PaintAggregator::CombineCheapestPaintRects() {
+  // Combine the two paint rects whose bounding box adds the least area that
+  // didn't need painting.  Combining everything into a single bounding box
+  // can repaint far more than was invalidated when the rects are spread out.
+  DCHECK(update_.scroll_rect.IsEmpty());
+  DCHECK_GT(update_.paint_rects.size(), 1U);
+  size_t best_i = 0;
+  size_t best_j = 1;
+  int best_cost = 0;
+  for (size_t i = 0; i < update_.paint_rects.size(); ++i) {
+    for (size_t j = i + 1; j < update_.paint_rects.size(); ++j) {
+      const gfx::Rect& a = update_.paint_rects[i];
+      const gfx::Rect& b = update_.paint_rects[j];
+      int cost = gfx::UnionRects(a, b).size().GetArea() -
+          a.size().GetArea() - b.size().GetArea();
+      if ((i == 0 && j == 1) || cost < best_cost) {
+        best_i = i;
+        best_j = j;
+        best_cost = cost;
+      }
+    }
+  }
+  gfx::Rect combined_rect = gfx::UnionRects(update_.paint_rects[best_i],
+                                            update_.paint_rects[best_j]);
+  update_.paint_rects.erase(update_.paint_rects.begin() + best_j);
+  update_.paint_rects.erase(update_.paint_rects.begin() + best_i);
+  // Re-invalidate in case the union intersects other paint rects.
+  InvalidateRect(combined_rect);
+}
+
 }  // namespace content
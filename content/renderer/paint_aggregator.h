@@ -61,6 +61,7 @@ class CONTENT_EXPORT PaintAggregator {
   bool ShouldInvalidateScrollRect(const gfx::Rect& rect) const;
   void InvalidateScrollRect();
   void CombinePaintRects();
+  void CombineCheapestPaintRects();
 
   PendingUpdate update_;
 };
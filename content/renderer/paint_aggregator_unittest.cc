@@ -73,6 +73,26 @@ TEST(PaintAggregator, DisjointInvalidationsCombined) {
   EXPECT_EQ(expected_bounds, update.paint_rects[0]);
 }
 
+TEST(PaintAggregator, TooManyInvalidationsCombineCheapestPair) {
+  PaintAggregator greg;
+
+  // Six disjoint rects, one more than the aggregator keeps. Only the two
+  // closest ones should be combined, rather than all of them.
+  for (int i = 0; i < 5; ++i)
+    greg.InvalidateRect(gfx::Rect(i * 100, 0, 10, 10));
+  greg.InvalidateRect(gfx::Rect(415, 0, 10, 10));
+
+  EXPECT_TRUE(greg.HasPendingUpdate());
+  PaintAggregator::PendingUpdate update;
+  greg.PopPendingUpdate(&update);
+
+  EXPECT_TRUE(update.scroll_rect.IsEmpty());
+  ASSERT_EQ(5U, update.paint_rects.size());
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(gfx::Rect(i * 100, 0, 10, 10), update.paint_rects[i]);
+  EXPECT_EQ(gfx::Rect(400, 0, 25, 10), update.paint_rects[4]);
+}
+
 TEST(PaintAggregator, SingleScroll) {
   PaintAggregator greg;
 
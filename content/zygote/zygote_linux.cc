@@ -450,10 +450,11 @@ base::ProcessId Zygote::ReadArgsAndFork(const Pickle& pickle,
     return -1;
 
   for (int i = 0; i < argc; ++i) {
-    std::string arg;
+    // Read each argument in place rather than copying it into |args|.
+    args.push_back(std::string());
+    std::string& arg = args.back();
     if (!pickle.ReadString(&iter, &arg))
       return -1;
-    args.push_back(arg);
     if (arg.compare(0, channel_id_prefix.length(), channel_id_prefix) == 0)
       channel_id = arg;
   }
@@ -463,6 +464,7 @@ base::ProcessId Zygote::ReadArgsAndFork(const Pickle& pickle,
   if (numfds != static_cast<int>(fds.size()))
     return -1;
 
+  mapping.reserve(numfds + 1);
   for (int i = 0; i < numfds; ++i) {
     base::GlobalDescriptors::Key key;
     if (!pickle.ReadUInt32(&iter, &key))
@@ -1074,19 +1074,23 @@ class AssignmentProblem {
             sums[program_info][model_info] += score;
           }
         }
+      }
 
-        for (ScoreSet::iterator assignee_iterator = sums.begin();
-             assignee_iterator != sums.end();
-             ++assignee_iterator) {
-          LabelInfo* program_info = assignee_iterator->first;
-          for (LabelToScore::iterator p = assignee_iterator->second.begin();
-               p != assignee_iterator->second.end();
-               ++p) {
-            LabelInfo* model_info = p->first;
-            int score = p->second;
-            int* slot = &maxima[program_info][model_info];
-            *slot = std::max(*slot, score);
-          }
+      // No score added to |sums| is negative, so the sums never shrink as
+      // program samples are added and their final values are their maxima.
+      // Folding them into |maxima| once per model sample gives the same result
+      // as folding after every program sample.
+      for (ScoreSet::iterator assignee_iterator = sums.begin();
+           assignee_iterator != sums.end();
+           ++assignee_iterator) {
+        LabelInfo* program_info = assignee_iterator->first;
+        for (LabelToScore::iterator p = assignee_iterator->second.begin();
+             p != assignee_iterator->second.end();
+             ++p) {
+          LabelInfo* model_info = p->first;
+          int score = p->second;
+          int* slot = &maxima[program_info][model_info];
+          *slot = std::max(*slot, score);
         }
       }
     }
@@ -13,9 +13,25 @@ extern "C" {
 #endif
 
 #include "base/basictypes.h"
+#include "base/lazy_instance.h"
 
 namespace courgette {
 
+#ifndef COURGETTE_USE_CRC_LIB
+namespace {
+
+// CrcGenerateTable() rebuilds the LZMA SDK's CRC lookup tables and probes
+// the CPU to pick an implementation, so it only needs to happen once.
+class CrcTables {
+ public:
+  CrcTables() { CrcGenerateTable(); }
+};
+
+base::LazyInstance<CrcTables>::Leaky g_crc_tables = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+#endif
+
 uint32 CalculateCrc(const uint8* buffer, size_t size) {
   uint32 crc;
 
@@ -24,7 +40,7 @@ uint32 CalculateCrc(const uint8* buffer, size_t size) {
   crc = crc32(0, buffer, size);
 #else
   // Calculate Crc by calling CRC method in LZMA SDK
-  CrcGenerateTable();
+  g_crc_tables.Get();
   crc = CrcCalc(buffer, size);
 #endif
 
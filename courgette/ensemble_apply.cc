@@ -335,31 +335,39 @@ Status ApplyEnsemblePatch(SourceStream* base,
   if (status != C_OK)
     return status;
 
-  SinkStreamSet predicted_parameters;
-  status = patch_process.PredictTransformParameters(&predicted_parameters);
-  if (status != C_OK)
-    return status;
-
-  SourceStreamSet corrected_parameters;
-  status = patch_process.SubpatchTransformParameters(&predicted_parameters,
-                                                     parameter_correction,
-                                                     &corrected_parameters);
-  if (status != C_OK)
-    return status;
-
-  SinkStreamSet transformed_elements;
-  status = patch_process.TransformUp(&corrected_parameters,
-                                     &transformed_elements);
-  if (status != C_OK)
-    return status;
-
+  // The predicted and uncorrected streams below are only inputs to the next
+  // subpatch step; the corrected streams live in storage owned by
+  // |patch_process|. Scope them so that they are freed as soon as they have
+  // been used, rather than staying alive alongside the final output.
   SourceStreamSet corrected_transformed_elements;
-  status = patch_process.SubpatchTransformedElements(
-          &transformed_elements,
-          transformed_elements_correction,
-          &corrected_transformed_elements);
-  if (status != C_OK)
-    return status;
+  {
+    SinkStreamSet transformed_elements;
+    {
+      SinkStreamSet predicted_parameters;
+      status = patch_process.PredictTransformParameters(&predicted_parameters);
+      if (status != C_OK)
+        return status;
+
+      SourceStreamSet corrected_parameters;
+      status = patch_process.SubpatchTransformParameters(&predicted_parameters,
+                                                         parameter_correction,
+                                                         &corrected_parameters);
+      if (status != C_OK)
+        return status;
+
+      status = patch_process.TransformUp(&corrected_parameters,
+                                         &transformed_elements);
+      if (status != C_OK)
+        return status;
+    }
+
+    status = patch_process.SubpatchTransformedElements(
+            &transformed_elements,
+            transformed_elements_correction,
+            &corrected_transformed_elements);
+    if (status != C_OK)
+      return status;
+  }
 
   SinkStream original_ensemble_and_corrected_base_elements;
   status = patch_process.TransformDown(
@@ -386,10 +386,8 @@ BSDiffStatus CreateBinaryPatch(SourceStream* old_stream,
         }
       }
       int gap = (scan - lenb) - (lastscan + lenf);
-      for (int i = 0;  i < gap;  i++) {
-        if (!extra_bytes->Write(&newbuf[lastscan + lenf + i], 1))
-          return MEM_ERROR;
-      }
+      if (gap > 0 && !extra_bytes->Write(&newbuf[lastscan + lenf], gap))
+        return MEM_ERROR;
 
       diff_bytes_length += lenf;
       extra_bytes_length += gap;
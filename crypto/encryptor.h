@@ -17,6 +17,10 @@
 #include "crypto/scoped_nss_types.h"
 #endif
 
+#if defined(USE_OPENSSL)
+struct aes_key_st;
+#endif
+
 namespace crypto {
 
 class SymmetricKey;
@@ -121,6 +125,9 @@ class CRYPTO_EXPORT Encryptor {
                 const base::StringPiece& input,
                 std::string* output);
   std::string iv_;
+  // The expanded AES key for CTR mode, computed once in Init() rather than
+  // for every Encrypt() or Decrypt() call.
+  scoped_ptr<aes_key_st> aes_key_;
 #elif defined(USE_NSS) || defined(OS_WIN) || defined(OS_MACOSX)
   bool Crypt(PK11Context* context,
              const base::StringPiece& input,
@@ -5,6 +5,7 @@
 #include "crypto/encryptor.h"
 
 #include <openssl/aes.h>
+#include <openssl/crypto.h>
 #include <openssl/evp.h>
 
 #include "base/logging.h"
@@ -50,6 +51,8 @@ Encryptor::Encryptor()
 }
 
 Encryptor::~Encryptor() {
+  if (aes_key_.get())
+    OPENSSL_cleanse(aes_key_.get(), sizeof(AES_KEY));
 }
 
 bool Encryptor::Init(SymmetricKey* key,
@@ -65,6 +68,16 @@ bool Encryptor::Init(SymmetricKey* key,
   if (GetCipherForKey(key) == NULL)
     return false;
 
+  if (mode == CTR) {
+    if (!aes_key_.get())
+      aes_key_.reset(new AES_KEY);
+    if (AES_set_encrypt_key(
+            reinterpret_cast<const uint8*>(key->key().data()),
+            key->key().size() * 8, aes_key_.get()) != 0) {
+      return false;
+    }
+  }
+
   key_ = key;
   mode_ = mode;
   iv.CopyToString(&iv_);
@@ -144,11 +157,7 @@ bool Encryptor::CryptCTR(bool do_encrypt,
     return false;
   }
 
-  AES_KEY aes_key;
-  if (AES_set_encrypt_key(reinterpret_cast<const uint8*>(key_->key().data()),
-                          key_->key().size() * 8, &aes_key) != 0) {
-    return false;
-  }
+  DCHECK(aes_key_.get());  // Set up by Init() in CTR mode.
 
   const size_t out_size = input.size();
   CHECK_GT(out_size, 0u);
@@ -164,7 +173,8 @@ bool Encryptor::CryptCTR(bool do_encrypt,
   counter_->Write(ivec);
 
   AES_ctr128_encrypt(reinterpret_cast<const uint8*>(input.data()), out_ptr,
-                     input.size(), &aes_key, ivec, ecount_buf, &block_offset);
+                     input.size(), aes_key_.get(), ivec, ecount_buf,
+                     &block_offset);
 
   // AES_ctr128_encrypt() updates |ivec|. Update the |counter_| here.
   SetCounter(base::StringPiece(reinterpret_cast<const char*>(ivec),
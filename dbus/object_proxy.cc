@@ -462,25 +462,31 @@ DBusHandlerResult ObjectProxy::HandleMessage(
   if (dbus_message_get_type(raw_message) != DBUS_MESSAGE_TYPE_SIGNAL)
     return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
 
-  // raw_message will be unrefed on exit of the function. Increment the
-  // reference so we can use it in Signal.
-  dbus_message_ref(raw_message);
-  scoped_ptr<Signal> signal(
-      Signal::FromRawMessage(raw_message));
-
   // Verify the signal comes from the object we're proxying for, this is
   // our last chance to return DBUS_HANDLER_RESULT_NOT_YET_HANDLED and
-  // allow other object proxies to handle instead.
-  const ObjectPath path = signal->GetPath();
-  if (path != object_path_) {
-    if (path.value() == kDBusSystemObjectPath &&
-        signal->GetMember() == kNameOwnerChangedMember) {
+  // allow other object proxies to handle instead. Every object proxy sees
+  // every signal on the bus, so do this on the raw message before wrapping
+  // it in a Signal.
+  const char* raw_path = dbus_message_get_path(raw_message);
+  const base::StringPiece path(raw_path ? raw_path : "");
+  if (path != object_path_.value()) {
+    const char* raw_member = dbus_message_get_member(raw_message);
+    if (path == kDBusSystemObjectPath && raw_member &&
+        base::StringPiece(raw_member) == kNameOwnerChangedMember) {
       // Handle NameOwnerChanged separately
-      return HandleNameOwnerChanged(signal.Pass());
+      dbus_message_ref(raw_message);
+      return HandleNameOwnerChanged(
+          make_scoped_ptr(Signal::FromRawMessage(raw_message)));
     }
     return DBUS_HANDLER_RESULT_NOT_YET_HANDLED;
   }
 
+  // raw_message will be unrefed on exit of the function. Increment the
+  // reference so we can use it in Signal.
+  dbus_message_ref(raw_message);
+  scoped_ptr<Signal> signal(
+      Signal::FromRawMessage(raw_message));
+
   const std::string interface = signal->GetInterface();
   const std::string member = signal->GetMember();
 
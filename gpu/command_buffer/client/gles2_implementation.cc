@@ -2350,8 +2350,10 @@ void GLES2Implementation::ActiveTexture(GLenum texture) {
     return;
   }
 
-  active_texture_unit_ = texture_index;
-  helper_->ActiveTexture(texture);
+  if (active_texture_unit_ != texture_index) {
+    active_texture_unit_ = texture_index;
+    helper_->ActiveTexture(texture);
+  }
   CheckGLError();
 }
 
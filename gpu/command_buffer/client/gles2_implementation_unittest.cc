@@ -2627,6 +2627,25 @@ TEST_F(GLES2ImplementationTest, CapabilitiesAreCached) {
   }
 }
 
+TEST_F(GLES2ImplementationTest, ActiveTextureIsCached) {
+  struct Cmds {
+    cmds::ActiveTexture active_texture_cmd;
+  };
+  Cmds expected;
+  expected.active_texture_cmd.Init(GL_TEXTURE1);
+
+  // Texture unit 0 is active to begin with.
+  gl_->ActiveTexture(GL_TEXTURE0);
+  EXPECT_TRUE(NoCommandsWritten());
+
+  const void* commands = GetPut();
+  gl_->ActiveTexture(GL_TEXTURE1);
+  EXPECT_EQ(0, memcmp(&expected, commands, sizeof(expected)));
+  ClearCommands();
+  gl_->ActiveTexture(GL_TEXTURE1);
+  EXPECT_TRUE(NoCommandsWritten());
+}
+
 TEST_F(GLES2ImplementationTest, BindVertexArrayOES) {
   GLuint id = 0;
   gl_->GenVertexArraysOES(1, &id);
@@ -101,6 +101,13 @@ void GpuScheduler::PutChanged() {
 
     if (unscheduled_count_ > 0)
       break;
+
+    if (time_slice_ > base::TimeDelta() &&
+        base::TimeTicks::HighResNow() - begin_time >= time_slice_) {
+      TRACE_EVENT_INSTANT0("gpu", "GpuScheduler::TimeSliceExpired",
+                           TRACE_EVENT_SCOPE_THREAD);
+      break;
+    }
   }
 
   if (decoder_) {
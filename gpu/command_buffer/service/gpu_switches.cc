@@ -57,6 +57,10 @@ const char kGpuDriverBugWorkarounds[] = "gpu-driver-bug-workarounds";
 // Sets the maximum size of the in-memory gpu program cache, in kb
 const char kGpuProgramCacheSizeKb[]         = "gpu-program-cache-size-kb";
 
+// Sets how long, in ms, one command buffer may run before yielding to the
+// others on the GPU thread. By default it runs until its commands are done.
+const char kGpuSchedulerTimeSliceMs[]       = "gpu-scheduler-time-slice-ms";
+
 // Disables the GPU shader on disk cache.
 const char kDisableGpuShaderDiskCache[]     = "disable-gpu-shader-disk-cache";
 
@@ -80,6 +84,7 @@ const char* kGpuSwitches[] = {
   kForceSynchronousGLReadPixels,
   kGpuDriverBugWorkarounds,
   kGpuProgramCacheSizeKb,
+  kGpuSchedulerTimeSliceMs,
   kDisableGpuShaderDiskCache,
   kEnableShareGroupAsyncTextureUpload,
 };
@@ -223,16 +223,7 @@ void MemoryProgramCache::SaveLinkedProgram(
   UMA_HISTOGRAM_COUNTS("GPU.ProgramCache.MemorySizeBeforeKb",
                        curr_size_bytes_ / 1024);
 
-  // Evict any cached program with the same key in favor of the least recently
-  // accessed.
-  ProgramMRUCache::iterator existing = store_.Peek(sha_string);
-  if(existing != store_.end())
-    store_.Erase(existing);
-
-  while (curr_size_bytes_ + length > max_size_bytes_) {
-    DCHECK(!store_.empty());
-    store_.Erase(store_.rbegin());
-  }
+  MakeRoomForProgram(sha_string, length);
 
   if (!shader_callback.is_null() &&
       !CommandLine::ForCurrentProcess()->HasSwitch(
@@ -305,6 +296,14 @@ void MemoryProgramCache::LoadProgram(const std::string& program) {
                          &fragment_varyings);
     }
 
+    // Programs are sent from the disk cache least recently used first, so
+    // making room evicts the ones the disk cache would have dropped first.
+    if (proto->program().empty() ||
+        proto->program().length() > max_size_bytes_) {
+      return;
+    }
+    MakeRoomForProgram(proto->sha(), proto->program().length());
+
     scoped_ptr<char[]> binary(new char[proto->program().length()]);
     memcpy(binary.get(), proto->program().c_str(), proto->program().length());
 
@@ -330,6 +329,20 @@ void MemoryProgramCache::LoadProgram(const std::string& program) {
   }
 }
 
+void MemoryProgramCache::MakeRoomForProgram(const std::string& sha_string,
+                                            size_t length) {
+  // Evict any cached program with the same key in favor of the least recently
+  // accessed.
+  ProgramMRUCache::iterator existing = store_.Peek(sha_string);
+  if(existing != store_.end())
+    store_.Erase(existing);
+
+  while (curr_size_bytes_ + length > max_size_bytes_) {
+    DCHECK(!store_.empty());
+    store_.Erase(store_.rbegin());
+  }
+}
+
 MemoryProgramCache::ProgramCacheValue::ProgramCacheValue(
     GLsizei length,
     GLenum format,
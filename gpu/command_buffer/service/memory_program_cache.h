@@ -48,6 +48,10 @@ class GPU_EXPORT MemoryProgramCache : public ProgramCache {
  private:
   virtual void ClearBackend() OVERRIDE;
 
+  // Evicts the program cached under |sha_string|, if any, and then the least
+  // recently used programs until |length| more bytes fit in the cache.
+  void MakeRoomForProgram(const std::string& sha_string, size_t length);
+
   class ProgramCacheValue : public base::RefCounted<ProgramCacheValue> {
    public:
     ProgramCacheValue(GLsizei length,
@@ -8,6 +8,7 @@
 #include "base/bind.h"
 #include "base/logging.h"
 #include "base/memory/shared_memory.h"
+#include "base/message_loop/message_loop_proxy.h"
 #include "base/synchronization/lock.h"
 #include "base/time/time.h"
 #include "gpu/command_buffer/common/gles2_cmd_format.h"
@@ -24,8 +25,13 @@ namespace {
 class AsyncPixelTransferCompletionObserverImpl
     : public AsyncPixelTransferCompletionObserver {
  public:
-  AsyncPixelTransferCompletionObserverImpl(uint32 submit_count)
+  AsyncPixelTransferCompletionObserverImpl(
+      uint32 submit_count,
+      const scoped_refptr<base::MessageLoopProxy>& completion_loop,
+      const base::Closure& completion_task)
       : submit_count_(submit_count),
+        completion_loop_(completion_loop),
+        completion_task_(completion_task),
         cancelled_(false) {}
 
   void Cancel() {
@@ -46,6 +52,11 @@ class AsyncPixelTransferCompletionObserverImpl
       // submit_count was written to sync->process_count.
       base::subtle::MemoryBarrier();
       sync->process_count = submit_count_;
+
+      // Let the query run its callbacks as soon as possible instead of
+      // waiting for the decoder to poll the pending transfer queries.
+      if (completion_loop_.get())
+        completion_loop_->PostTask(FROM_HERE, completion_task_);
     }
   }
 
@@ -53,6 +64,8 @@ class AsyncPixelTransferCompletionObserverImpl
   virtual ~AsyncPixelTransferCompletionObserverImpl() {}
 
   uint32 submit_count_;
+  scoped_refptr<base::MessageLoopProxy> completion_loop_;
+  base::Closure completion_task_;
 
   base::Lock lock_;
   bool cancelled_;
@@ -75,6 +88,8 @@ class AsyncPixelTransfersCompletedQuery
  protected:
   virtual ~AsyncPixelTransfersCompletedQuery();
 
+  void ProcessCompletedTransfers();
+
   scoped_refptr<AsyncPixelTransferCompletionObserverImpl> observer_;
 };
 
@@ -99,7 +114,11 @@ bool AsyncPixelTransfersCompletedQuery::End(uint32 submit_count) {
   mem_params.shm_data_offset = shm_offset();
   mem_params.shm_data_size = sizeof(QuerySync);
 
-  observer_ = new AsyncPixelTransferCompletionObserverImpl(submit_count);
+  observer_ = new AsyncPixelTransferCompletionObserverImpl(
+      submit_count,
+      base::MessageLoopProxy::current(),
+      base::Bind(&AsyncPixelTransfersCompletedQuery::ProcessCompletedTransfers,
+                 AsWeakPtr()));
 
   // Ask AsyncPixelTransferDelegate to run completion callback after all
   // previous async transfers are done. No guarantee that callback is run
@@ -126,6 +145,10 @@ bool AsyncPixelTransfersCompletedQuery::Process() {
   return true;
 }
 
+void AsyncPixelTransfersCompletedQuery::ProcessCompletedTransfers() {
+  manager()->ProcessPendingTransferQueries();
+}
+
 void AsyncPixelTransfersCompletedQuery::Destroy(bool /* have_context */) {
   if (!IsDeleted()) {
     MarkAsDeleted();
@@ -11,14 +11,12 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/un.h>
-#include <unistd.h>
-
-#if defined(OS_OPENBSD)
 #include <sys/uio.h>
-#endif
+#include <unistd.h>
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/file_util.h"
@@ -368,6 +366,19 @@ void Channel::ChannelImpl::CloseFileDescriptors(Message* msg) {
 #endif
 }
 
+namespace {
+
+// The most bytes of queued messages that ProcessOutgoingMessages() gathers
+// into a single write. This is about what a socket buffer holds anyway.
+const size_t kMaxCoalescedWriteSize = 64 * 1024;
+
+// The most messages that ProcessOutgoingMessages() gathers into a single
+// write, each taking one iovec. This is well under IOV_MAX, which sendmsg()
+// and writev() enforce, and small enough for the iovecs to live on the stack.
+const size_t kMaxIOVecs = 64;
+
+}  // namespace
+
 bool Channel::ChannelImpl::ProcessOutgoingMessages() {
   DCHECK(!waiting_connect_);  // Why are we trying to send messages if there's
                               // no connection?
@@ -382,15 +393,36 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
   while (!output_queue_.empty()) {
     Message* msg = output_queue_.front();
 
-    size_t amt_to_write = msg->size() - message_send_bytes_written_;
+    // Send the rest of |msg|. Unless it has descriptors to go with its first
+    // chunk, gather the messages queued behind it into the same write, so
+    // that a burst of small messages costs one syscall rather than one per
+    // message. A message with descriptors always starts a write of its own.
+    struct iovec iovs[kMaxIOVecs];
+    iovs[0].iov_base = const_cast<char*>(
+        static_cast<const char*>(msg->data()) + message_send_bytes_written_);
+    iovs[0].iov_len = msg->size() - message_send_bytes_written_;
+    size_t num_iovs = 1;
+    size_t amt_to_write = iovs[0].iov_len;
     DCHECK_NE(0U, amt_to_write);
-    const char* out_bytes = reinterpret_cast<const char*>(msg->data()) +
-        message_send_bytes_written_;
+
+    if (message_send_bytes_written_ != 0 ||
+        msg->file_descriptor_set()->empty()) {
+      while (num_iovs < output_queue_.size() && num_iovs < kMaxIOVecs &&
+             amt_to_write < kMaxCoalescedWriteSize) {
+        const Message* next = output_queue_[num_iovs];
+        if (!next->file_descriptor_set()->empty())
+          break;
+        iovs[num_iovs].iov_base =
+            const_cast<char*>(static_cast<const char*>(next->data()));
+        iovs[num_iovs].iov_len = next->size();
+        amt_to_write += next->size();
+        ++num_iovs;
+      }
+    }
 
     struct msghdr msgh = {0};
-    struct iovec iov = {const_cast<char*>(out_bytes), amt_to_write};
-    msgh.msg_iov = &iov;
-    msgh.msg_iovlen = 1;
+    msgh.msg_iov = iovs;
+    msgh.msg_iovlen = num_iovs;
     char buf[CMSG_SPACE(
         sizeof(int) * FileDescriptorSet::kMaxDescriptorsPerMessage)];
 
@@ -435,9 +467,11 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         // fd_pipe_ which makes Seccomp sandbox operation more efficient.
         struct iovec fd_pipe_iov = { const_cast<char *>(""), 1 };
         msgh.msg_iov = &fd_pipe_iov;
+        msgh.msg_iovlen = 1;
         fd_written = fd_pipe_;
         bytes_written = HANDLE_EINTR(sendmsg(fd_pipe_, &msgh, MSG_DONTWAIT));
-        msgh.msg_iov = &iov;
+        msgh.msg_iov = iovs;
+        msgh.msg_iovlen = num_iovs;
         msgh.msg_controllen = 0;
         if (bytes_written > 0) {
           CloseFileDescriptors(msg);
@@ -453,7 +487,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         DCHECK_EQ(msg->file_descriptor_set()->size(), 1U);
       }
       if (!msgh.msg_controllen) {
-        bytes_written = HANDLE_EINTR(write(pipe_, out_bytes, amt_to_write));
+        bytes_written = HANDLE_EINTR(writev(pipe_, iovs, num_iovs));
       } else
 #endif  // IPC_USES_READWRITE
       {
@@ -482,12 +516,28 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
       return false;
     }
 
-    if (static_cast<size_t>(bytes_written) != amt_to_write) {
-      if (bytes_written > 0) {
-        // If write() fails with EAGAIN then bytes_written will be -1.
-        message_send_bytes_written_ += bytes_written;
+    // Retire only the messages whose every byte went out. The front message
+    // keeps any partial progress in |message_send_bytes_written_| so the next
+    // write resumes where this one stopped. If write() fails with EAGAIN then
+    // bytes_written will be -1 and nothing is retired.
+    size_t bytes_left = bytes_written > 0 ? bytes_written : 0;
+    for (size_t i = 0; i < num_iovs && bytes_left > 0; ++i) {
+      if (bytes_left < iovs[i].iov_len) {
+        message_send_bytes_written_ += bytes_left;
+        break;
       }
+      bytes_left -= iovs[i].iov_len;
+      message_send_bytes_written_ = 0;
 
+      // Message sent OK!
+      DVLOG(2) << "sent message @" << output_queue_.front() << " on channel @"
+               << this << " with type " << output_queue_.front()->type()
+               << " on fd " << pipe_;
+      delete output_queue_.front();
+      output_queue_.pop_front();
+    }
+
+    if (static_cast<size_t>(bytes_written) != amt_to_write) {
       // Tell libevent to call us back once things are unblocked.
       is_blocked_on_write_ = true;
       base::MessageLoopForIO::current()->WatchFileDescriptor(
@@ -497,14 +547,6 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
           &write_watcher_,
           this);
       return true;
-    } else {
-      message_send_bytes_written_ = 0;
-
-      // Message sent OK!
-      DVLOG(2) << "sent message @" << msg << " on channel @" << this
-               << " with type " << msg->type() << " on fd " << pipe_;
-      delete output_queue_.front();
-      output_queue_.pop();
     }
   }
   return true;
@@ -520,7 +562,19 @@ bool Channel::ChannelImpl::Send(Message* message) {
 #endif  // IPC_MESSAGE_LOG_ENABLED
 
   message->TraceMessageBegin();
-  output_queue_.push(message);
+  if (message->priority() == Message::PRIORITY_HIGH) {
+    // Queue it right after the last message it must not overtake. The one
+    // being written always stays at the front.
+    std::deque<Message*>::iterator it = output_queue_.end();
+    std::deque<Message*>::iterator first = output_queue_.begin();
+    if (first != output_queue_.end() && message_send_bytes_written_ != 0)
+      ++first;
+    while (it != first && message->CanOvertake(**(it - 1)))
+      --it;
+    output_queue_.insert(it, message);
+  } else {
+    output_queue_.push_back(message);
+  }
   if (!is_blocked_on_write_ && !waiting_connect_) {
     return ProcessOutgoingMessages();
   }
@@ -590,7 +644,7 @@ void Channel::ChannelImpl::ResetToAcceptingConnectionState() {
 
   while (!output_queue_.empty()) {
     Message* m = output_queue_.front();
-    output_queue_.pop();
+    output_queue_.pop_front();
     delete m;
   }
 
@@ -760,7 +814,7 @@ void Channel::ChannelImpl::QueueHelloMessage() {
     DCHECK_EQ(msg->file_descriptor_set()->size(), 1U);
   }
 #endif  // IPC_USES_READWRITE
-  output_queue_.push(msg.release());
+  output_queue_.push_back(msg.release());
 }
 
 Channel::ChannelImpl::ReadState Channel::ChannelImpl::ReadData(
@@ -945,7 +999,7 @@ void Channel::ChannelImpl::QueueCloseFDMessage(int fd, int hops) {
         NOTREACHED() << "Unable to pickle close fd.";
       }
       // Send(msg.release());
-      output_queue_.push(msg.release());
+      output_queue_.push_back(msg.release());
       break;
     }
 
@@ -9,7 +9,7 @@
 
 #include <sys/socket.h>  // for CMSG macros
 
-#include <queue>
+#include <deque>
 #include <set>
 #include <string>
 #include <vector>
@@ -156,8 +156,10 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   // the pipe.  On POSIX it's used as a key in a local map of file descriptors.
   std::string pipe_name_;
 
-  // Messages to be sent are queued here.
-  std::queue<Message*> output_queue_;
+  // Messages to be sent are queued here. This is a deque rather than a queue
+  // so that ProcessOutgoingMessages() can look past the front message when
+  // coalescing writes.
+  std::deque<Message*> output_queue_;
 
   // We assume a worst case: kReadBufferSize bytes of messages, where each
   // message has no payload and a full complement of descriptors.
@@ -8,8 +8,12 @@
 #include "base/location.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/sparse_histogram.h"
 #include "base/single_thread_task_runner.h"
+#include "base/stl_util.h"
 #include "base/thread_task_runner_handle.h"
+#include "base/time/time.h"
 #include "ipc/ipc_channel_proxy.h"
 #include "ipc/ipc_listener.h"
 #include "ipc/ipc_logging.h"
@@ -18,6 +22,15 @@
 
 namespace IPC {
 
+namespace {
+
+// Listener-side handlers which take at least this long to dispatch a message
+// get their message class recorded, so that the costly message types can be
+// found without logging every message.
+const int kSlowDispatchThresholdMs = 16;
+
+}  // namespace
+
 //------------------------------------------------------------------------------
 
 ChannelProxy::MessageFilter::MessageFilter() {}
@@ -46,11 +59,13 @@ ChannelProxy::Context::Context(Listener* listener,
       listener_(listener),
       ipc_task_runner_(ipc_task_runner),
       channel_connected_called_(false),
+      dispatch_task_pending_(false),
       peer_pid_(base::kNullProcessId) {
   DCHECK(ipc_task_runner_.get());
 }
 
 ChannelProxy::Context::~Context() {
+  STLDeleteElements(&pending_messages_);
 }
 
 void ChannelProxy::Context::ClearIPCTaskRunner() {
@@ -97,8 +112,21 @@ bool ChannelProxy::Context::OnMessageReceivedNoFilter(const Message& message) {
   // this thread is active.  That should be a reasonable assumption, but it
   // feels risky.  We may want to invent some more indirect way of referring to
   // a MessageLoop if this becomes a problem.
-  listener_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&Context::OnDispatchMessage, this, message));
+  base::AutoLock auto_lock(pending_messages_lock_);
+  if (message.priority() == Message::PRIORITY_HIGH) {
+    // Dispatch it ahead of the waiting messages it may overtake.
+    std::deque<Message*>::iterator it = pending_messages_.end();
+    while (it != pending_messages_.begin() && message.CanOvertake(**(it - 1)))
+      --it;
+    pending_messages_.insert(it, new Message(message));
+  } else {
+    pending_messages_.push_back(new Message(message));
+  }
+  if (!dispatch_task_pending_) {
+    dispatch_task_pending_ = true;
+    listener_task_runner_->PostTask(
+        FROM_HERE, base::Bind(&Context::OnDispatchPendingMessages, this));
+  }
   return true;
 }
 
@@ -257,7 +285,15 @@ void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
     logger->OnPreDispatchMessage(message);
 #endif
 
+  base::TimeTicks dispatch_start = base::TimeTicks::Now();
   listener_->OnMessageReceived(message);
+  base::TimeDelta dispatch_time = base::TimeTicks::Now() - dispatch_start;
+  if (dispatch_time >=
+      base::TimeDelta::FromMilliseconds(kSlowDispatchThresholdMs)) {
+    UMA_HISTOGRAM_SPARSE_SLOWLY("IPC.SlowDispatchMessageClass",
+                                IPC_MESSAGE_ID_CLASS(message.type()));
+    UMA_HISTOGRAM_TIMES("IPC.SlowDispatchTime", dispatch_time);
+  }
 
 #ifdef IPC_MESSAGE_LOG_ENABLED
   if (logger->Enabled())
@@ -265,6 +301,45 @@ void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
 #endif
 }
 
+// Called on the listener's thread
+void ChannelProxy::Context::OnDispatchPendingMessages() {
+  {
+    base::AutoLock auto_lock(pending_messages_lock_);
+    dispatch_task_pending_ = false;
+  }
+  DispatchPendingMessages();
+}
+
+// Called on the listener's thread
+void ChannelProxy::Context::DispatchPendingMessages() {
+  // Only dispatch what has been received so far, so that a steady stream of
+  // messages can't starve the rest of the listener's tasks. Anything that
+  // arrives meanwhile is picked up by the task posted below.
+  size_t count;
+  {
+    base::AutoLock auto_lock(pending_messages_lock_);
+    count = pending_messages_.size();
+  }
+  for (; count > 0; --count) {
+    scoped_ptr<Message> message;
+    {
+      base::AutoLock auto_lock(pending_messages_lock_);
+      if (pending_messages_.empty())
+        return;
+      message.reset(pending_messages_.front());
+      pending_messages_.pop_front();
+      // The listener may run a nested message loop while handling |message|,
+      // so keep a task posted for the messages behind it.
+      if (!pending_messages_.empty() && !dispatch_task_pending_) {
+        dispatch_task_pending_ = true;
+        listener_task_runner_->PostTask(
+            FROM_HERE, base::Bind(&Context::OnDispatchPendingMessages, this));
+      }
+    }
+    OnDispatchMessage(*message);
+  }
+}
+
 // Called on the listener's thread
 void ChannelProxy::Context::OnDispatchConnected() {
   if (channel_connected_called_)
@@ -277,6 +352,9 @@ void ChannelProxy::Context::OnDispatchConnected() {
 
 // Called on the listener's thread
 void ChannelProxy::Context::OnDispatchError() {
+  // A drain task posted for a message queued before the error may come after
+  // this one, so dispatch everything that was received first.
+  DispatchPendingMessages();
   if (listener_)
     listener_->OnChannelError();
 }
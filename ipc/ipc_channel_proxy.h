@@ -5,6 +5,7 @@
 #ifndef IPC_IPC_CHANNEL_PROXY_H_
 #define IPC_IPC_CHANNEL_PROXY_H_
 
+#include <deque>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
@@ -219,6 +220,12 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
     void AddFilter(MessageFilter* filter);
     void OnDispatchConnected();
     void OnDispatchError();
+    void OnDispatchPendingMessages();
+
+    // Dispatches the messages in pending_messages_, making sure that another
+    // drain task is posted while any remain so that nested message loops still
+    // see them.
+    void DispatchPendingMessages();
 
     scoped_refptr<base::SingleThreadTaskRunner> listener_task_runner_;
     Listener* listener_;
@@ -236,6 +243,16 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
     // Lock for pending_filters_.
     base::Lock pending_filters_lock_;
 
+    // Messages received on the IPC thread that haven't been dispatched on the
+    // listener thread yet. A burst of messages is handed over with a single
+    // task: the IPC thread only posts OnDispatchPendingMessages if one isn't
+    // already pending. PRIORITY_HIGH messages are moved ahead of the ones
+    // they may overtake, see Message::CanOvertake().
+    std::deque<Message*> pending_messages_;
+    bool dispatch_task_pending_;
+    // Lock for pending_messages_ and dispatch_task_pending_.
+    base::Lock pending_messages_lock_;
+
     // Cached copy of the peer process ID. Set on IPC but read on both IPC and
     // listener threads.
     base::ProcessId peer_pid_;
@@ -9,9 +9,11 @@
 #endif
 
 #include <string>
+#include <vector>
 
 #include "base/message_loop/message_loop.h"
 #include "base/pickle.h"
+#include "base/synchronization/waitable_event.h"
 #include "base/threading/thread.h"
 #include "ipc/ipc_message.h"
 #include "ipc/ipc_test_base.h"
@@ -249,6 +251,247 @@ TEST_F(IPCChannelTest, MAYBE_SendMessageInChannelConnected) {
   DestroyChannel();
 }
 
+// More than IOV_MAX, so a burst can't go out in a single write.
+const int kBurstMessageCount = 3000;
+
+// Every so often a burst message is large enough to overflow the socket
+// buffer, which splits it across writes.
+const int kBurstLargeMessageInterval = 500;
+const size_t kBurstLargeMessageSize = 256 * 1024;
+
+std::string BurstPayload(int index) {
+  size_t size = index % kBurstLargeMessageInterval == 1 ?
+      kBurstLargeMessageSize : 16;
+  return std::string(size, static_cast<char>('a' + index % 26));
+}
+
+// Checks that a burst of messages arrives complete and in order, and replies
+// with the number received once the last one is in.
+class BurstChannelListener : public IPC::Listener {
+ public:
+  BurstChannelListener() : sender_(NULL), next_index_(0) {}
+  virtual ~BurstChannelListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+    int index;
+    std::string payload;
+    EXPECT_TRUE(iter.ReadInt(&index));
+    EXPECT_TRUE(iter.ReadString(&payload));
+    EXPECT_EQ(next_index_, index);
+    EXPECT_EQ(BurstPayload(next_index_), payload);
+    next_index_++;
+
+    if (next_index_ == kBurstMessageCount) {
+      IPC::Message* reply =
+          new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+      reply->WriteInt(next_index_);
+      sender_->Send(reply);
+      base::MessageLoop::current()->Quit();
+    }
+    return true;
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    base::MessageLoop::current()->Quit();
+  }
+
+  void Init(IPC::Sender* s) {
+    sender_ = s;
+  }
+
+ private:
+  IPC::Sender* sender_;
+  int next_index_;
+};
+
+// Replies are ints holding the number of burst messages the peer received.
+class BurstReplyListener : public IPC::Listener {
+ public:
+  BurstReplyListener() : received_(-1) {}
+  virtual ~BurstReplyListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+    EXPECT_TRUE(iter.ReadInt(&received_));
+    base::MessageLoop::current()->Quit();
+    return true;
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    base::MessageLoop::current()->Quit();
+  }
+
+  int received() const { return received_; }
+
+ private:
+  int received_;
+};
+
+// Sends many messages without waiting in between, so that the channel has to
+// write several queued messages at once and resume after short writes.
+TEST_F(IPCChannelTest, BurstTest) {
+  Init("BurstClient");
+
+  BurstReplyListener listener;
+  CreateChannel(&listener);
+  ASSERT_TRUE(ConnectChannel());
+  ASSERT_TRUE(StartClient());
+
+  for (int i = 0; i < kBurstMessageCount; ++i) {
+    IPC::Message* message =
+        new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+    message->WriteInt(i);
+    message->WriteString(BurstPayload(i));
+    sender()->Send(message);
+  }
+
+  base::MessageLoop::current()->Run();
+  EXPECT_EQ(kBurstMessageCount, listener.received());
+
+  channel()->Close();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyChannel();
+}
+
+// The client sends this many normal priority messages, then one high priority
+// message, then a last normal priority message. Each holds its index. The high
+// priority message and the one at kPrioritySameRouteMessageIndex go to
+// kPriorityHighRoute, all the others to kPriorityNormalRoute.
+const int kPriorityNormalMessageCount = 10;
+const int kPrioritySameRouteMessageIndex = 5;
+const int kPriorityHighMessageIndex = kPriorityNormalMessageCount;
+const int kPriorityLastMessageIndex = kPriorityNormalMessageCount + 1;
+const int32 kPriorityNormalRoute = 1;
+const int32 kPriorityHighRoute = 2;
+
+// Signals |event| once the last message has reached the IPC thread, by which
+// time all the others are waiting to be dispatched to the listener.
+class PriorityMessageFilter : public IPC::ChannelProxy::MessageFilter {
+ public:
+  explicit PriorityMessageFilter(base::WaitableEvent* event) : event_(event) {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+    int index;
+    EXPECT_TRUE(iter.ReadInt(&index));
+    if (index == kPriorityLastMessageIndex)
+      event_->Signal();
+    return false;
+  }
+
+ private:
+  virtual ~PriorityMessageFilter() {}
+
+  base::WaitableEvent* event_;
+};
+
+// Records the order in which messages are dispatched, and quits once all of
+// them are in.
+class PriorityListener : public IPC::Listener {
+ public:
+  PriorityListener() {}
+  virtual ~PriorityListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+    int index;
+    EXPECT_TRUE(iter.ReadInt(&index));
+    indices_.push_back(index);
+    if (index == kPriorityLastMessageIndex)
+      base::MessageLoop::current()->Quit();
+    return true;
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    base::MessageLoop::current()->Quit();
+  }
+
+  const std::vector<int>& indices() const { return indices_; }
+
+ private:
+  std::vector<int> indices_;
+};
+
+// A high priority message that arrives while normal ones are still waiting
+// for the listener thread is dispatched ahead of those for other routes, but
+// not ahead of those for its own route.
+TEST_F(IPCChannelTest, ChannelProxyDispatchesHighPriorityFirst) {
+  Init("PriorityClient");
+
+  base::Thread thread("ChannelProxyPriorityTestServer");
+  base::Thread::Options options;
+  options.message_loop_type = base::MessageLoop::TYPE_IO;
+  thread.StartWithOptions(options);
+
+  PriorityListener listener;
+  CreateChannelProxy(&listener, thread.message_loop_proxy().get());
+  base::WaitableEvent all_received(false, false);
+  channel_proxy()->AddFilter(new PriorityMessageFilter(&all_received));
+
+  ASSERT_TRUE(StartClient());
+
+  // Keep the listener thread busy until every message is queued for it.
+  all_received.Wait();
+  base::MessageLoop::current()->Run();
+
+  std::vector<int> expected;
+  for (int i = 0; i <= kPrioritySameRouteMessageIndex; ++i)
+    expected.push_back(i);
+  expected.push_back(kPriorityHighMessageIndex);
+  for (int i = kPrioritySameRouteMessageIndex + 1;
+       i < kPriorityNormalMessageCount; ++i) {
+    expected.push_back(i);
+  }
+  expected.push_back(kPriorityLastMessageIndex);
+  EXPECT_EQ(expected, listener.indices());
+
+  DestroyChannelProxy();
+  EXPECT_TRUE(WaitForClientShutdown());
+  thread.Stop();
+}
+
+MULTIPROCESS_IPC_TEST_CLIENT_MAIN(PriorityClient) {
+  base::MessageLoopForIO main_message_loop;
+  BurstReplyListener listener;
+
+  IPC::Channel channel(IPCTestBase::GetChannelName("PriorityClient"),
+                       IPC::Channel::MODE_CLIENT,
+                       &listener);
+  CHECK(channel.Connect());
+
+  for (int i = 0; i <= kPriorityLastMessageIndex; ++i) {
+    bool same_route = i == kPrioritySameRouteMessageIndex ||
+                      i == kPriorityHighMessageIndex;
+    IPC::Message* message = new IPC::Message(
+        same_route ? kPriorityHighRoute : kPriorityNormalRoute, 2,
+        IPC::Message::PRIORITY_NORMAL);
+    if (i == kPriorityHighMessageIndex)
+      message->set_priority(IPC::Message::PRIORITY_HIGH);
+    message->WriteInt(i);
+    channel.Send(message);
+  }
+
+  // Wait for the server to close the channel.
+  base::MessageLoop::current()->Run();
+  return 0;
+}
+
+MULTIPROCESS_IPC_TEST_CLIENT_MAIN(BurstClient) {
+  base::MessageLoopForIO main_message_loop;
+  BurstChannelListener listener;
+
+  IPC::Channel channel(IPCTestBase::GetChannelName("BurstClient"),
+                       IPC::Channel::MODE_CLIENT,
+                       &listener);
+  CHECK(channel.Connect());
+  listener.Init(&channel);
+
+  base::MessageLoop::current()->Run();
+  return 0;
+}
+
 MULTIPROCESS_IPC_TEST_CLIENT_MAIN(GenericClient) {
   base::MessageLoopForIO main_message_loop;
   GenericChannelListener listener;
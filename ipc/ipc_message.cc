@@ -99,6 +99,18 @@ void Message::SetHeaderValues(int32 routing, uint32 type, uint32 flags) {
   header()->flags = flags;
 }
 
+bool Message::CanOvertake(const Message& queued) const {
+  if (priority() != PRIORITY_HIGH || queued.priority() == PRIORITY_HIGH)
+    return false;
+  if (routing_id() == MSG_ROUTING_NONE || routing_id() == MSG_ROUTING_CONTROL)
+    return false;
+  if (queued.routing_id() == MSG_ROUTING_NONE ||
+      queued.routing_id() == MSG_ROUTING_CONTROL) {
+    return false;
+  }
+  return routing_id() != queued.routing_id();
+}
+
 #ifdef IPC_MESSAGE_LOG_ENABLED
 void Message::set_sent_time(int64 time) {
   DCHECK((header()->flags & HAS_SENT_TIME_BIT) == 0);
@@ -73,6 +73,19 @@ class IPC_EXPORT Message : public Pickle {
     return static_cast<PriorityValue>(header()->flags & PRIORITY_MASK);
   }
 
+  // PRIORITY_HIGH messages overtake queued messages of lower priority, both
+  // when a POSIX channel writes them out and when a ChannelProxy dispatches
+  // them on the listener thread. See CanOvertake() for which ones.
+  void set_priority(PriorityValue priority) {
+    header()->flags = (header()->flags & ~PRIORITY_MASK) | priority;
+  }
+
+  // Returns true if this message may be delivered ahead of |queued|, which
+  // was sent before it. Only a PRIORITY_HIGH routed message may, and only
+  // ahead of a lower priority message for a different route, so that each
+  // route, and the control and unrouted messages, stay in FIFO order.
+  bool CanOvertake(const Message& queued) const;
+
   // True if this is a synchronous message.
   void set_sync() {
     header()->flags |= SYNC_BIT;
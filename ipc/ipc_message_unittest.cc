@@ -13,6 +13,40 @@
 
 namespace {
 
+TEST(IPCMessageTest, SetPriority) {
+  IPC::Message msg(1, 2, IPC::Message::PRIORITY_NORMAL);
+  msg.set_sync();
+  EXPECT_EQ(IPC::Message::PRIORITY_NORMAL, msg.priority());
+
+  msg.set_priority(IPC::Message::PRIORITY_HIGH);
+  EXPECT_EQ(IPC::Message::PRIORITY_HIGH, msg.priority());
+  EXPECT_TRUE(msg.is_sync());
+
+  msg.set_priority(IPC::Message::PRIORITY_LOW);
+  EXPECT_EQ(IPC::Message::PRIORITY_LOW, msg.priority());
+  EXPECT_TRUE(msg.is_sync());
+}
+
+TEST(IPCMessageTest, CanOvertake) {
+  IPC::Message high(1, 2, IPC::Message::PRIORITY_HIGH);
+  IPC::Message other_route(3, 2, IPC::Message::PRIORITY_NORMAL);
+  IPC::Message same_route(1, 2, IPC::Message::PRIORITY_NORMAL);
+  IPC::Message control(MSG_ROUTING_CONTROL, 2, IPC::Message::PRIORITY_NORMAL);
+  IPC::Message unrouted(MSG_ROUTING_NONE, 2, IPC::Message::PRIORITY_LOW);
+  IPC::Message other_high(3, 2, IPC::Message::PRIORITY_HIGH);
+
+  EXPECT_TRUE(high.CanOvertake(other_route));
+  EXPECT_FALSE(high.CanOvertake(same_route));
+  EXPECT_FALSE(high.CanOvertake(control));
+  EXPECT_FALSE(high.CanOvertake(unrouted));
+  EXPECT_FALSE(high.CanOvertake(other_high));
+  EXPECT_FALSE(other_route.CanOvertake(same_route));
+
+  IPC::Message high_control(MSG_ROUTING_CONTROL, 2,
+                            IPC::Message::PRIORITY_HIGH);
+  EXPECT_FALSE(high_control.CanOvertake(other_route));
+}
+
 TEST(IPCMessageTest, ListValue) {
   base::ListValue input;
   input.Set(0, new base::FundamentalValue(42.42));
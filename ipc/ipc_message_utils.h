@@ -5,6 +5,8 @@
 #ifndef IPC_IPC_MESSAGE_UTILS_H_
 #define IPC_IPC_MESSAGE_UTILS_H_
 
+#include <string.h>
+
 #include <algorithm>
 #include <map>
 #include <set>
@@ -302,8 +304,24 @@ struct IPC_EXPORT ParamTraits<std::vector<bool> > {
   static void Log(const param_type& p, std::string* l);
 };
 
-template <class P>
-struct ParamTraits<std::vector<P> > {
+// Element types whose ParamTraits write exactly their in-memory bytes, and
+// for which any byte pattern is a valid value. Vectors of these are copied
+// into and out of messages in one go instead of element by element, which
+// produces the same bytes since every element is 4 or 8 bytes long. Don't add
+// types that need validating on read (bool, enums, gfx::Rect) or that pickle
+// differently on each side (long).
+template <class P> struct IsBulkSerializable { enum { value = false }; };
+template <> struct IsBulkSerializable<int> { enum { value = true }; };
+template <> struct IsBulkSerializable<unsigned int> { enum { value = true }; };
+template <> struct IsBulkSerializable<long long> { enum { value = true }; };
+template <> struct IsBulkSerializable<unsigned long long> {
+  enum { value = true };
+};
+template <> struct IsBulkSerializable<float> { enum { value = true }; };
+template <> struct IsBulkSerializable<double> { enum { value = true }; };
+
+template <class P, bool bulk = IsBulkSerializable<P>::value>
+struct VectorParamTraits {
   typedef std::vector<P> param_type;
   static void Write(Message* m, const param_type& p) {
     WriteParam(m, static_cast<int>(p.size()));
@@ -326,6 +344,47 @@ struct ParamTraits<std::vector<P> > {
     }
     return true;
   }
+};
+
+template <class P>
+struct VectorParamTraits<P, true> {
+  typedef std::vector<P> param_type;
+  static void Write(Message* m, const param_type& p) {
+    WriteParam(m, static_cast<int>(p.size()));
+    if (!p.empty()) {
+      m->WriteBytes(&p.front(), static_cast<int>(p.size() * sizeof(P)));
+    }
+  }
+  static bool Read(const Message* m, PickleIterator* iter,
+                   param_type* r) {
+    int size;
+    // ReadLength() checks for < 0 itself.
+    if (!m->ReadLength(iter, &size))
+      return false;
+    if (INT_MAX / sizeof(P) <= static_cast<size_t>(size))
+      return false;
+    const char* data;
+    // ReadBytes() checks that the whole array is in the message, so the
+    // resize below can't be driven by a bogus length.
+    if (!m->ReadBytes(iter, &data, static_cast<int>(size * sizeof(P))))
+      return false;
+    r->resize(size);
+    if (size)
+      memcpy(&r->front(), data, size * sizeof(P));
+    return true;
+  }
+};
+
+template <class P>
+struct ParamTraits<std::vector<P> > {
+  typedef std::vector<P> param_type;
+  static void Write(Message* m, const param_type& p) {
+    VectorParamTraits<P>::Write(m, p);
+  }
+  static bool Read(const Message* m, PickleIterator* iter,
+                   param_type* r) {
+    return VectorParamTraits<P>::Read(m, iter, r);
+  }
   static void Log(const param_type& p, std::string* l) {
     for (size_t i = 0; i < p.size(); ++i) {
       if (i != 0)
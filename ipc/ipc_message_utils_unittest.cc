@@ -70,5 +70,60 @@ TEST(IPCMessageUtilsTest, ParameterValidation) {
   ASSERT_FALSE(ParamTraits<base::FilePath>::Read(&message, &iter, &bad_path));
 }
 
+// Tests that vectors copied in bulk keep the element by element wire format.
+TEST(IPCMessageUtilsTest, BulkVectors) {
+  std::vector<int> ints;
+  for (int i = -5; i < 100; ++i)
+    ints.push_back(i * 3);
+  std::vector<double> doubles(3, 0.25);
+  doubles.push_back(-1e300);
+
+  IPC::Message message;
+  ParamTraits<std::vector<int> >::Write(&message, ints);
+  ParamTraits<std::vector<double> >::Write(&message, doubles);
+  ParamTraits<std::vector<int> >::Write(&message, std::vector<int>());
+
+  // The same values written the old way.
+  IPC::Message expected;
+  expected.WriteInt(static_cast<int>(ints.size()));
+  for (size_t i = 0; i < ints.size(); ++i)
+    ParamTraits<int>::Write(&expected, ints[i]);
+  expected.WriteInt(static_cast<int>(doubles.size()));
+  for (size_t i = 0; i < doubles.size(); ++i)
+    ParamTraits<double>::Write(&expected, doubles[i]);
+  expected.WriteInt(0);
+  ASSERT_EQ(expected.payload_size(), message.payload_size());
+  EXPECT_EQ(0, memcmp(expected.payload(), message.payload(),
+                      message.payload_size()));
+
+  PickleIterator iter(message);
+  std::vector<int> read_ints;
+  std::vector<double> read_doubles;
+  std::vector<int> read_empty(1, 7);
+  ASSERT_TRUE(ParamTraits<std::vector<int> >::Read(&message, &iter,
+                                                   &read_ints));
+  ASSERT_TRUE(ParamTraits<std::vector<double> >::Read(&message, &iter,
+                                                      &read_doubles));
+  ASSERT_TRUE(ParamTraits<std::vector<int> >::Read(&message, &iter,
+                                                   &read_empty));
+  EXPECT_EQ(ints, read_ints);
+  EXPECT_EQ(doubles, read_doubles);
+  EXPECT_TRUE(read_empty.empty());
+}
+
+// Tests that a bulk vector claiming more elements than the message holds is
+// rejected.
+TEST(IPCMessageUtilsTest, BulkVectorTooShort) {
+  IPC::Message message;
+  message.WriteInt(10);
+  for (int i = 0; i < 9; ++i)
+    message.WriteInt(i);
+
+  PickleIterator iter(message);
+  std::vector<int> output;
+  EXPECT_FALSE(ParamTraits<std::vector<int> >::Read(&message, &iter,
+                                                    &output));
+}
+
 }  // namespace
 }  // namespace IPC
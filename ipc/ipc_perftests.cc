@@ -21,6 +21,7 @@
 #include "ipc/ipc_message_utils.h"
 #include "ipc/ipc_sender.h"
 #include "ipc/ipc_test_base.h"
+#include "testing/perf/perf_test.h"
 
 namespace {
 
@@ -276,4 +277,150 @@ MULTIPROCESS_IPC_TEST_CLIENT_MAIN(PerformanceClient) {
   return 0;
 }
 
+// The server side of the burst test. It tells the client how many messages of
+// which size to send back to back, and reports how many messages per second
+// make it through the ChannelProxy to the listener thread.
+class BurstReceiverListener : public IPC::Listener {
+ public:
+  BurstReceiverListener()
+      : msg_count_(0),
+        msg_size_(0),
+        count_down_(0) {
+  }
+
+  virtual ~BurstReceiverListener() {}
+
+  // Call this before running the message loop.
+  void SetTestParams(int msg_count, size_t msg_size) {
+    DCHECK_EQ(0, count_down_);
+    msg_count_ = msg_count;
+    msg_size_ = msg_size;
+    count_down_ = msg_count_;
+  }
+
+  void StartBurst(IPC::Sender* sender) {
+    IPC::Message* msg = new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+    msg->WriteInt(msg_count_);
+    msg->WriteUInt64(msg_size_);
+    start_time_ = base::TimeTicks::HighResNow();
+    sender->Send(msg);
+  }
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    CHECK(count_down_ > 0);
+    count_down_--;
+    if (count_down_ == 0) {
+      double elapsed_seconds =
+          (base::TimeTicks::HighResNow() - start_time_).InSecondsF();
+      std::string trace_name = base::StringPrintf(
+          "%dx_%u", msg_count_, static_cast<unsigned>(msg_size_));
+      perf_test::PrintResult("ipc_channel_proxy_burst", "", trace_name,
+                             msg_count_ / elapsed_seconds, "messages/s",
+                             true);
+      base::MessageLoop::current()->QuitWhenIdle();
+    }
+    return true;
+  }
+
+ private:
+  int msg_count_;
+  size_t msg_size_;
+  int count_down_;
+  base::TimeTicks start_time_;
+};
+
+// The client side of the burst test: sends each requested burst without
+// waiting for replies, and exits when asked for an empty burst.
+class BurstSenderListener : public IPC::Listener {
+ public:
+  BurstSenderListener() : channel_(NULL) {}
+  virtual ~BurstSenderListener() {}
+
+  void Init(IPC::Channel* channel) {
+    DCHECK(!channel_);
+    channel_ = channel;
+  }
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    CHECK(channel_);
+
+    PickleIterator iter(message);
+    int msg_count;
+    EXPECT_TRUE(iter.ReadInt(&msg_count));
+    uint64 msg_size;
+    EXPECT_TRUE(iter.ReadUInt64(&msg_size));
+
+    if (msg_count == 0) {
+      base::MessageLoop::current()->QuitWhenIdle();
+      return true;
+    }
+
+    std::string payload(static_cast<size_t>(msg_size), 'a');
+    for (int i = 0; i < msg_count; ++i) {
+      IPC::Message* msg =
+          new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+      msg->WriteString(payload);
+      channel_->Send(msg);
+    }
+    return true;
+  }
+
+ private:
+  IPC::Channel* channel_;
+};
+
+// Unlike the ping-pong test above, this goes through a ChannelProxy, so it
+// measures the IO thread to listener thread hand-off for bursts of messages.
+TEST_F(IPCChannelPerfTest, ChannelProxyBurst) {
+  Init("BurstClient");
+
+  base::Thread thread("ChannelProxyBurstServer");
+  base::Thread::Options options;
+  options.message_loop_type = base::MessageLoop::TYPE_IO;
+  thread.StartWithOptions(options);
+
+  BurstReceiverListener listener;
+  CreateChannelProxy(&listener, thread.message_loop_proxy().get());
+  ASSERT_TRUE(StartClient());
+
+  const size_t kMsgSizeBase = 12;
+  const int kMsgSizeMaxExp = 3;
+  int msg_count = 100000;
+  size_t msg_size = kMsgSizeBase;
+  for (int i = 1; i <= kMsgSizeMaxExp; i++) {
+    listener.SetTestParams(msg_count, msg_size);
+    listener.StartBurst(sender());
+
+    // Run message loop.
+    base::MessageLoop::current()->Run();
+
+    msg_size *= kMsgSizeBase;
+  }
+
+  // An empty burst tells the client to quit.
+  IPC::Message* message = new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+  message->WriteInt(0);
+  message->WriteUInt64(0);
+  sender()->Send(message);
+
+  EXPECT_TRUE(WaitForClientShutdown());
+
+  // Destroy the channel proxy before shutting down the thread.
+  DestroyChannelProxy();
+  thread.Stop();
+}
+
+MULTIPROCESS_IPC_TEST_CLIENT_MAIN(BurstClient) {
+  base::MessageLoopForIO main_message_loop;
+  BurstSenderListener listener;
+  IPC::Channel channel(IPCTestBase::GetChannelName("BurstClient"),
+                       IPC::Channel::MODE_CLIENT,
+                       &listener);
+  listener.Init(&channel);
+  CHECK(channel.Connect());
+
+  base::MessageLoop::current()->Run();
+  return 0;
+}
+
 }  // namespace
@@ -200,18 +200,17 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
        it != transform_inputs_.end(); ++it) {
     InputCallback* input = *it;
 
-    float volume = input->ProvideInput(
-        mixer_input_audio_bus_.get(), buffer_delay);
-
-    // Optimize the most common single input, full volume case.
+    // The first input renders straight into |temp_dest|, which saves a copy in
+    // the most common single input, full volume case.
     if (it == transform_inputs_.begin()) {
+      float volume = input->ProvideInput(temp_dest, buffer_delay);
       if (volume == 1.0f) {
-        mixer_input_audio_bus_->CopyTo(temp_dest);
+        continue;
       } else if (volume > 0) {
-        for (int i = 0; i < mixer_input_audio_bus_->channels(); ++i) {
+        for (int i = 0; i < temp_dest->channels(); ++i) {
           vector_math::FMUL(
-              mixer_input_audio_bus_->channel(i), volume,
-              mixer_input_audio_bus_->frames(), temp_dest->channel(i));
+              temp_dest->channel(i), volume, temp_dest->frames(),
+              temp_dest->channel(i));
         }
       } else {
         // Zero |temp_dest| otherwise, so we're mixing into a clean buffer.
@@ -221,6 +220,9 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
       continue;
     }
 
+    float volume = input->ProvideInput(
+        mixer_input_audio_bus_.get(), buffer_delay);
+
     // Volume adjust and mix each mixer input into |temp_dest| after rendering.
     if (volume > 0) {
       for (int i = 0; i < mixer_input_audio_bus_->channels(); ++i) {
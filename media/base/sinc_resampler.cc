@@ -78,6 +78,7 @@
 
 #include "media/base/sinc_resampler.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -146,6 +147,10 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
       // Create input buffers with a 16-byte alignment for SSE optimizations.
       kernel_storage_(static_cast<float*>(
           base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 16))),
+      kernel_scale_factor_(0),
+      previous_kernel_storage_(static_cast<float*>(
+          base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 16))),
+      previous_kernel_scale_factor_(0),
       kernel_pre_sinc_storage_(static_cast<float*>(
           base::AlignedAlloc(sizeof(float) * kKernelStorageSize, 16))),
       kernel_window_storage_(static_cast<float*>(
@@ -162,6 +167,8 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
 
   memset(kernel_storage_.get(), 0,
          sizeof(*kernel_storage_.get()) * kKernelStorageSize);
+  memset(previous_kernel_storage_.get(), 0,
+         sizeof(*previous_kernel_storage_.get()) * kKernelStorageSize);
   memset(kernel_pre_sinc_storage_.get(), 0,
          sizeof(*kernel_pre_sinc_storage_.get()) * kKernelStorageSize);
   memset(kernel_window_storage_.get(), 0,
@@ -201,6 +208,7 @@ void SincResampler::InitializeKernel() {
   // Generates a set of windowed sinc() kernels.
   // We generate a range of sub-sample offsets from 0.0 to 1.0.
   const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
+  kernel_scale_factor_ = sinc_scale_factor;
   for (int offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
     const float subsample_offset =
         static_cast<float>(offset_idx) / kKernelOffsetCount;
@@ -236,9 +244,22 @@ void SincResampler::SetRatio(double io_sample_rate_ratio) {
 
   io_sample_rate_ratio_ = io_sample_rate_ratio;
 
+  // The kernels only depend on |sinc_scale_factor|, which is the same for all
+  // ratios <= 1.0, so they often don't need to change at all.
+  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
+  if (sinc_scale_factor == kernel_scale_factor_)
+    return;
+
+  // Switching back to the previous ratio, e.g. when compensating for clock
+  // drift, only needs the previous kernels swapped back in.
+  kernel_storage_.swap(previous_kernel_storage_);
+  std::swap(kernel_scale_factor_, previous_kernel_scale_factor_);
+  if (sinc_scale_factor == kernel_scale_factor_)
+    return;
+  kernel_scale_factor_ = sinc_scale_factor;
+
   // Optimize reinitialization by reusing values which are independent of
   // |sinc_scale_factor|.  Provides a 3x speedup.
-  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
   for (int offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
     for (int i = 0; i < kKernelSize; ++i) {
       const int idx = i + offset_idx * kKernelSize;
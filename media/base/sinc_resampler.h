@@ -122,6 +122,12 @@ class MEDIA_EXPORT SincResampler {
   // The kernel offsets are sub-sample shifts of a windowed sinc shifted from
   // 0.0 to 1.0 sample.
   scoped_ptr<float[], base::ScopedPtrAlignedFree> kernel_storage_;
+  // The |sinc_scale_factor| |kernel_storage_| was computed for.
+  double kernel_scale_factor_;
+  // The kernels replaced by the last SetRatio() which changed them, kept so
+  // that switching back to the previous ratio doesn't recompute them.
+  scoped_ptr<float[], base::ScopedPtrAlignedFree> previous_kernel_storage_;
+  double previous_kernel_scale_factor_;
   scoped_ptr<float[], base::ScopedPtrAlignedFree> kernel_pre_sinc_storage_;
   scoped_ptr<float[], base::ScopedPtrAlignedFree> kernel_window_storage_;
 
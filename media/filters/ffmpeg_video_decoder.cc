@@ -7,12 +7,14 @@
 #include <algorithm>
 #include <string>
 
+#include "base/atomicops.h"
 #include "base/bind.h"
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/location.h"
 #include "base/message_loop/message_loop_proxy.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
 #include "media/base/bind_to_loop.h"
 #include "media/base/decoder_buffer.h"
 #include "media/base/limits.h"
@@ -26,8 +28,8 @@
 
 namespace media {
 
-// Always try to use three threads for video decoding.  There is little reason
-// not to since current day CPUs tend to be multi-core and we measured
+// Always try to use at least two threads for video decoding.  There is little
+// reason not to since current day CPUs tend to be multi-core and we measured
 // performance benefits on older machines such as P4s with hyperthreading.
 //
 // Handling decoding on separate threads also frees up the pipeline thread to
@@ -38,11 +40,25 @@ namespace media {
 static const int kDecodeThreads = 2;
 static const int kMaxDecodeThreads = 16;
 
+// Upper bound on the default number of threads. Frame threading delays output
+// by a frame per thread, so more threads than this cost latency and memory for
+// little gain.
+static const int kMaxDefaultDecodeThreads = 8;
+
+// The number of FFmpegVideoDecoders with an open codec in this process. They
+// split the cores between them when picking their default thread count.
+static base::subtle::Atomic32 g_num_open_decoders = 0;
+
 // Returns the number of threads given the FFmpeg CodecID. Also inspects the
 // command line for a valid --video-threads flag.
 static int GetThreadCount(AVCodecID codec_id) {
   // Refer to http://crbug.com/93932 for tsan suppressions on decoding.
-  int decode_threads = kDecodeThreads;
+  const int num_decoders =
+      std::max(1, base::subtle::NoBarrier_Load(&g_num_open_decoders));
+  int decode_threads = std::max(
+      kDecodeThreads,
+      std::min(kMaxDefaultDecodeThreads,
+               base::SysInfo::NumberOfProcessors() / num_decoders));
 
   const CommandLine* cmd_line = CommandLine::ForCurrentProcess();
   std::string threads(cmd_line->GetSwitchValueASCII(switches::kVideoThreads));
@@ -354,6 +370,8 @@ bool FFmpegVideoDecoder::FFmpegDecode(
 }
 
 void FFmpegVideoDecoder::ReleaseFFmpegResources() {
+  if (codec_context_.get())
+    base::subtle::NoBarrier_AtomicIncrement(&g_num_open_decoders, -1);
   codec_context_.reset();
   av_frame_.reset();
 }
@@ -364,6 +382,7 @@ bool FFmpegVideoDecoder::ConfigureDecoder() {
 
   // Initialize AVCodecContext structure.
   codec_context_.reset(avcodec_alloc_context3(NULL));
+  base::subtle::NoBarrier_AtomicIncrement(&g_num_open_decoders, 1);
   VideoDecoderConfigToAVCodecContext(config_, codec_context_.get());
 
   // Enable motion vector search (potentially slow), strong deblocking filter
@@ -205,6 +205,7 @@ void GpuVideoDecoder::DestroyVDA() {
     vda_.release()->Destroy();
 
   DestroyPictureBuffers(&assigned_picture_buffers_);
+  DestroyPictureBuffers(&free_picture_buffers_);
   // Not destroying PictureBuffers in |dismissed_picture_buffers_| yet, since
   // their textures may still be in use by the user of this GpuVideoDecoder.
 }
@@ -347,16 +348,43 @@ void GpuVideoDecoder::ProvidePictureBuffers(uint32 count,
 
   std::vector<uint32> texture_ids;
   std::vector<gpu::Mailbox> texture_mailboxes;
+  if (texture_target != decoder_texture_target_)
+    DestroyPictureBuffers(&free_picture_buffers_);
   decoder_texture_target_ = texture_target;
-  // Discards the sync point returned here since PictureReady will imply that
-  // the produce has already happened, and the texture is ready for use.
-  if (!factories_->CreateTextures(count,
-                                  size,
-                                  &texture_ids,
-                                  &texture_mailboxes,
-                                  decoder_texture_target_)) {
-    NotifyError(VideoDecodeAccelerator::PLATFORM_FAILURE);
-    return;
+
+  // Reuse the textures of dismissed buffers which have the requested size.
+  // The rest won't be asked for again, so delete them.
+  for (PictureBufferMap::iterator it = free_picture_buffers_.begin();
+       it != free_picture_buffers_.end(); ++it) {
+    if (texture_ids.size() < count && it->second.size() == size) {
+      texture_ids.push_back(it->second.texture_id());
+      texture_mailboxes.push_back(it->second.texture_mailbox());
+    } else {
+      factories_->DeleteTexture(it->second.texture_id());
+    }
+  }
+  free_picture_buffers_.clear();
+
+  if (texture_ids.size() < count) {
+    std::vector<uint32> new_texture_ids;
+    std::vector<gpu::Mailbox> new_texture_mailboxes;
+    // Discards the sync point returned here since PictureReady will imply
+    // that the produce has already happened, and the texture is ready for use.
+    if (!factories_->CreateTextures(count - texture_ids.size(),
+                                    size,
+                                    &new_texture_ids,
+                                    &new_texture_mailboxes,
+                                    decoder_texture_target_)) {
+      for (size_t i = 0; i < texture_ids.size(); ++i)
+        factories_->DeleteTexture(texture_ids[i]);
+      NotifyError(VideoDecodeAccelerator::PLATFORM_FAILURE);
+      return;
+    }
+    texture_ids.insert(texture_ids.end(),
+                       new_texture_ids.begin(), new_texture_ids.end());
+    texture_mailboxes.insert(texture_mailboxes.end(),
+                             new_texture_mailboxes.begin(),
+                             new_texture_mailboxes.end());
   }
   DCHECK_EQ(count, texture_ids.size());
   DCHECK_EQ(count, texture_mailboxes.size());
@@ -395,8 +423,10 @@ void GpuVideoDecoder::DismissPictureBuffer(int32 id) {
       picture_buffers_at_display_.find(id);
 
   if (at_display_it == picture_buffers_at_display_.end()) {
-    // We can delete the texture immediately as it's not being displayed.
-    factories_->DeleteTexture(buffer_to_dismiss.texture_id());
+    // The texture isn't being displayed, so it can be reused right away.
+    bool inserted = free_picture_buffers_.insert(std::make_pair(
+        id, buffer_to_dismiss)).second;
+    DCHECK(inserted);
     CHECK_GT(available_pictures_, 0);
     --available_pictures_;
   } else {
@@ -493,10 +523,12 @@ void GpuVideoDecoder::ReusePictureBuffer(int64 picture_buffer_id,
       assigned_picture_buffers_.find(picture_buffer_id);
 
   if (it == assigned_picture_buffers_.end()) {
-    // This picture was dismissed while in display, so we postponed deletion.
+    // This picture was dismissed while in display, so we postponed freeing
+    // it.
     it = dismissed_picture_buffers_.find(picture_buffer_id);
     DCHECK(it != dismissed_picture_buffers_.end());
-    factories_->DeleteTexture(it->second.texture_id());
+    factories_->WaitSyncPoint(sync_point);
+    free_picture_buffers_.insert(*it);
     dismissed_picture_buffers_.erase(it);
     return;
   }
@@ -567,6 +599,7 @@ GpuVideoDecoder::~GpuVideoDecoder() {
 
   DestroyPictureBuffers(&assigned_picture_buffers_);
   DestroyPictureBuffers(&dismissed_picture_buffers_);
+  DestroyPictureBuffers(&free_picture_buffers_);
 }
 
 void GpuVideoDecoder::NotifyFlushDone() {
@@ -155,6 +155,11 @@ class MEDIA_EXPORT GpuVideoDecoder
   std::map<int32, BufferPair> bitstream_buffers_in_decoder_;
   PictureBufferMap assigned_picture_buffers_;
   PictureBufferMap dismissed_picture_buffers_;
+  // PictureBuffers dismissed by the VDA whose textures are no longer in use.
+  // They are kept until the next ProvidePictureBuffers() so that their
+  // textures can be handed back to the VDA if it asks for the same size again,
+  // e.g. when it reallocates its buffers for a new stream configuration.
+  PictureBufferMap free_picture_buffers_;
   // PictureBuffers given to us by VDA via PictureReady, which we sent forward
   // as VideoFrames to be rendered via decode_cb_, and which will be returned
   // to us via ReusePictureBuffer.
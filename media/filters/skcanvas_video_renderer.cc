@@ -4,7 +4,15 @@
 
 #include "media/filters/skcanvas_video_renderer.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "base/atomic_ref_count.h"
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/sys_info.h"
+#include "base/threading/worker_pool.h"
 #include "media/base/video_frame.h"
 #include "media/base/yuv_convert.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -12,6 +20,12 @@
 
 namespace media {
 
+// Frames at least this tall are converted to RGB in horizontal slices on
+// several threads, since converting a HD frame takes a large part of a frame
+// interval on a single core.
+static const int kMinSlicedConvertHeight = 720;
+static const int kMaxConvertSlices = 4;
+
 static bool IsEitherYV12OrYV16(media::VideoFrame::Format format) {
   return format == media::VideoFrame::YV12 || format == media::VideoFrame::YV16;
 }
@@ -176,6 +190,95 @@ static void FastPaint(
   bitmap.unlockPixels();
 }
 
+// The arguments to ConvertYUVToRGB32() for one slice of a frame.
+struct ConvertSlice {
+  const uint8* y_plane;
+  const uint8* u_plane;
+  const uint8* v_plane;
+  uint8* rgb_frame;
+  int width;
+  int height;
+  int y_stride;
+  int uv_stride;
+  int rgb_stride;
+  media::YUVType yuv_type;
+};
+
+static void ConvertSliceAndSignal(const ConvertSlice& slice,
+                                  base::AtomicRefCount* slices_left,
+                                  base::WaitableEvent* done) {
+  media::ConvertYUVToRGB32(slice.y_plane, slice.u_plane, slice.v_plane,
+                           slice.rgb_frame, slice.width, slice.height,
+                           slice.y_stride, slice.uv_stride, slice.rgb_stride,
+                           slice.yuv_type);
+  if (!base::AtomicRefCountDec(slices_left))
+    done->Signal();
+}
+
+// Same as media::ConvertYUVToRGB32(), but large frames are split into slices
+// which are converted on the worker pool while the last one is converted on
+// the calling thread.
+static void ConvertYUVToRGB32InSlices(const uint8* y_plane,
+                                      const uint8* u_plane,
+                                      const uint8* v_plane,
+                                      uint8* rgb_frame,
+                                      int width,
+                                      int height,
+                                      int y_stride,
+                                      int uv_stride,
+                                      int rgb_stride,
+                                      media::YUVType yuv_type) {
+  int num_slices = 1;
+  if (height >= kMinSlicedConvertHeight) {
+    num_slices = std::min(base::SysInfo::NumberOfProcessors(),
+                          kMaxConvertSlices);
+  }
+  if (num_slices <= 1) {
+    media::ConvertYUVToRGB32(y_plane, u_plane, v_plane, rgb_frame, width,
+                             height, y_stride, uv_stride, rgb_stride,
+                             yuv_type);
+    return;
+  }
+
+  // Slices start on even rows so that each starts on a chroma row of YV12.
+  const int uv_shift = (yuv_type == media::YV12) ? 1 : 0;
+  const int slice_height = ((height + num_slices - 1) / num_slices + 1) & ~1;
+  std::vector<ConvertSlice> slices;
+  for (int row = 0; row < height; row += slice_height) {
+    ConvertSlice slice;
+    slice.y_plane = y_plane + row * y_stride;
+    slice.u_plane = u_plane + (row >> uv_shift) * uv_stride;
+    slice.v_plane = v_plane + (row >> uv_shift) * uv_stride;
+    slice.rgb_frame = rgb_frame + row * rgb_stride;
+    slice.width = width;
+    slice.height = std::min(slice_height, height - row);
+    slice.y_stride = y_stride;
+    slice.uv_stride = uv_stride;
+    slice.rgb_stride = rgb_stride;
+    slice.yuv_type = yuv_type;
+    slices.push_back(slice);
+  }
+
+  // The pool tasks only touch |slices_left| and |done| before this function
+  // returns, as it waits for all of them.
+  base::AtomicRefCount slices_left = static_cast<int>(slices.size()) - 1;
+  base::WaitableEvent done(false, false);
+  for (size_t i = 0; i + 1 < slices.size(); ++i) {
+    base::WorkerPool::PostTask(
+        FROM_HERE,
+        base::Bind(&ConvertSliceAndSignal, slices[i],
+                   base::Unretained(&slices_left), base::Unretained(&done)),
+        false);
+  }
+  const ConvertSlice& last = slices.back();
+  media::ConvertYUVToRGB32(last.y_plane, last.u_plane, last.v_plane,
+                           last.rgb_frame, last.width, last.height,
+                           last.y_stride, last.uv_stride, last.rgb_stride,
+                           last.yuv_type);
+  if (slices.size() > 1)
+    done.Wait();
+}
+
 // Converts a VideoFrame containing YUV data to a SkBitmap containing RGB data.
 //
 // |bitmap| will be (re)allocated to match the dimensions of |video_frame|.
@@ -219,7 +322,7 @@ static void ConvertVideoFrameToBitmap(
   }
   switch (video_frame->format()) {
     case media::VideoFrame::YV12:
-      media::ConvertYUVToRGB32(
+      ConvertYUVToRGB32InSlices(
           video_frame->data(media::VideoFrame::kYPlane) + y_offset,
           video_frame->data(media::VideoFrame::kUPlane) + uv_offset,
           video_frame->data(media::VideoFrame::kVPlane) + uv_offset,
@@ -233,7 +336,7 @@ static void ConvertVideoFrameToBitmap(
       break;
 
     case media::VideoFrame::YV16:
-      media::ConvertYUVToRGB32(
+      ConvertYUVToRGB32InSlices(
           video_frame->data(media::VideoFrame::kYPlane) + y_offset,
           video_frame->data(media::VideoFrame::kUPlane) + uv_offset,
           video_frame->data(media::VideoFrame::kVPlane) + uv_offset,
@@ -281,11 +281,18 @@ static bool IsRangeListSorted(
   return true;
 }
 
-// Comparison function for two Buffers based on timestamp.
-static bool BufferComparator(
-    const scoped_refptr<media::StreamParserBuffer>& first,
-    const scoped_refptr<media::StreamParserBuffer>& second) {
-  return first->GetDecodeTimestamp() < second->GetDecodeTimestamp();
+// Comparison functions between a Buffer and a timestamp, for searching
+// |buffers_| without creating a dummy buffer for the timestamp.
+static bool BufferBeforeTimestamp(
+    const scoped_refptr<media::StreamParserBuffer>& buffer,
+    base::TimeDelta timestamp) {
+  return buffer->GetDecodeTimestamp() < timestamp;
+}
+
+static bool TimestampBeforeBuffer(
+    base::TimeDelta timestamp,
+    const scoped_refptr<media::StreamParserBuffer>& buffer) {
+  return timestamp < buffer->GetDecodeTimestamp();
 }
 
 // Returns an estimate of how far from the beginning or end of a range a buffer
@@ -1572,18 +1579,12 @@ SourceBufferRange* SourceBufferRange::SplitRange(
 
 SourceBufferRange::BufferQueue::iterator SourceBufferRange::GetBufferItrAt(
     base::TimeDelta timestamp, bool skip_given_timestamp) {
-  // Need to make a dummy buffer with timestamp |timestamp| in order to search
-  // the |buffers_| container.
-  scoped_refptr<StreamParserBuffer> dummy_buffer =
-      StreamParserBuffer::CopyFrom(NULL, 0, false);
-  dummy_buffer->SetDecodeTimestamp(timestamp);
-
   if (skip_given_timestamp) {
     return std::upper_bound(
-        buffers_.begin(), buffers_.end(), dummy_buffer, BufferComparator);
+        buffers_.begin(), buffers_.end(), timestamp, TimestampBeforeBuffer);
   }
   return std::lower_bound(
-      buffers_.begin(), buffers_.end(), dummy_buffer, BufferComparator);
+      buffers_.begin(), buffers_.end(), timestamp, BufferBeforeTimestamp);
 }
 
 SourceBufferRange::KeyframeMap::iterator
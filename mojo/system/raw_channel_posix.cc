@@ -6,6 +6,7 @@
 
 #include <errno.h>
 #include <string.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -22,6 +23,7 @@
 #include "base/message_loop/message_loop.h"
 #include "base/posix/eintr_wrapper.h"
 #include "base/synchronization/lock.h"
+#include "mojo/system/limits.h"
 #include "mojo/system/message_in_transit.h"
 #include "mojo/system/platform_channel_handle.h"
 
@@ -30,6 +32,10 @@ namespace system {
 
 const size_t kReadSize = 4096;
 
+// The most queued messages written by a single |writev()|. (This is well below
+// |IOV_MAX| on all POSIX systems we care about.)
+const size_t kMaxWriteIOVecs = 64;
+
 class RawChannelPosix : public RawChannel,
                         public base::MessageLoopForIO::Watcher {
  public:
@@ -55,11 +61,13 @@ class RawChannelPosix : public RawChannel,
   // thread WITHOUT |write_lock_| held.
   void CallOnFatalError(Delegate::FatalError fatal_error);
 
-  // Writes the message at the front of |write_message_queue_|, starting at
-  // |write_message_offset_|. It removes and destroys if the write completes and
-  // otherwise updates |write_message_offset_|. Returns true on success. Must be
-  // called under |write_lock_|.
-  bool WriteFrontMessageNoLock();
+  // Writes the messages at the front of |write_message_queue_| (up to
+  // |kMaxWriteIOVecs| of them, with a single |writev()|), starting at
+  // |write_message_offset_| in the first one. It removes and destroys the ones
+  // whose write completes and updates |write_message_offset_| for the first
+  // one that doesn't. Returns true on success. Must be called under
+  // |write_lock_|.
+  bool WriteFrontMessagesNoLock();
 
   // Cancels all pending writes and destroys the contents of
   // |write_message_queue_|. Should only be called if |is_dead_| is false; sets
@@ -172,7 +180,7 @@ bool RawChannelPosix::WriteMessage(MessageInTransit* message) {
 
   write_message_queue_.push_front(message);
   DCHECK_EQ(write_message_offset_, 0u);
-  bool result = WriteFrontMessageNoLock();
+  bool result = WriteFrontMessagesNoLock();
   DCHECK(result || write_message_queue_.empty());
 
   if (!result) {
@@ -206,16 +214,33 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
   // Currently, we copy data to ensure that this is zero at the beginning.
   size_t read_buffer_start = 0;
   for (;;) {
+    // If we already have the header of a message that's larger than
+    // |kReadSize|, read the rest of it in one go, rather than in |kReadSize|
+    // pieces that repeatedly grow the buffer. Sizes beyond the maximum are
+    // left to the normal path, so that a bogus header can't make us allocate
+    // a huge buffer up front.
+    size_t bytes_to_read = kReadSize;
+    if (read_buffer_num_valid_bytes_ >= sizeof(MessageInTransit)) {
+      const MessageInTransit* message =
+          reinterpret_cast<const MessageInTransit*>(
+              &read_buffer_[read_buffer_start]);
+      if (message->data_size() <= kMaxMessageNumBytes &&
+          message->size_with_header_and_padding() >
+              read_buffer_num_valid_bytes_ + kReadSize) {
+        bytes_to_read = message->size_with_header_and_padding() -
+            read_buffer_num_valid_bytes_;
+      }
+    }
+
     if (read_buffer_.size() - (read_buffer_start + read_buffer_num_valid_bytes_)
-            < kReadSize) {
+            < bytes_to_read) {
       // Use power-of-2 buffer sizes.
       // TODO(vtl): Make sure the buffer doesn't get too large (and enforce the
       // maximum message size to whatever extent necessary).
-      // TODO(vtl): We may often be able to peek at the header and get the real
-      // required extra space (which may be much bigger than |kReadSize|).
       size_t new_size = std::max(read_buffer_.size(), kReadSize);
       while (new_size <
-                 read_buffer_start + read_buffer_num_valid_bytes_ + kReadSize)
+                 read_buffer_start + read_buffer_num_valid_bytes_ +
+                     bytes_to_read)
         new_size *= 2;
 
       // TODO(vtl): It's suboptimal to zero out the fresh memory.
@@ -225,7 +250,7 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
     ssize_t bytes_read = HANDLE_EINTR(
         read(fd_,
              &read_buffer_[read_buffer_start + read_buffer_num_valid_bytes_],
-             kReadSize));
+             bytes_to_read));
     if (bytes_read < 0) {
       if (errno != EAGAIN && errno != EWOULDBLOCK) {
         PLOG(ERROR) << "read";
@@ -277,8 +302,8 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
     if (did_dispatch_message)
       break;
 
-    // If we didn't max out |kReadSize|, stop reading for now.
-    if (static_cast<size_t>(bytes_read) < kReadSize)
+    // If we didn't max out |bytes_to_read|, stop reading for now.
+    if (static_cast<size_t>(bytes_read) < bytes_to_read)
       break;
 
     // Else try to read some more....
@@ -302,7 +327,7 @@ void RawChannelPosix::OnFileCanWriteWithoutBlocking(int fd) {
     DCHECK(!is_dead_);
     DCHECK(!write_message_queue_.empty());
 
-    bool result = WriteFrontMessageNoLock();
+    bool result = WriteFrontMessagesNoLock();
     DCHECK(result || write_message_queue_.empty());
 
     if (!result)
@@ -330,23 +355,34 @@ void RawChannelPosix::CallOnFatalError(Delegate::FatalError fatal_error) {
   delegate()->OnFatalError(fatal_error);
 }
 
-bool RawChannelPosix::WriteFrontMessageNoLock() {
+bool RawChannelPosix::WriteFrontMessagesNoLock() {
   write_lock_.AssertAcquired();
 
   DCHECK(!is_dead_);
   DCHECK(!write_message_queue_.empty());
 
-  MessageInTransit* message = write_message_queue_.front();
-  DCHECK_LT(write_message_offset_, message->size_with_header_and_padding());
-  size_t bytes_to_write =
-      message->size_with_header_and_padding() - write_message_offset_;
+  // Gather as many queued messages as we can into a single |writev()|; the
+  // first one may already have been partially written.
+  struct iovec iov[kMaxWriteIOVecs];
+  size_t num_iovs = 0;
+  size_t bytes_to_write = 0;
+  for (std::deque<MessageInTransit*>::const_iterator it =
+           write_message_queue_.begin();
+       it != write_message_queue_.end() && num_iovs < kMaxWriteIOVecs;
+       ++it) {
+    size_t offset = num_iovs == 0 ? write_message_offset_ : 0;
+    DCHECK_LT(offset, (*it)->size_with_header_and_padding());
+    iov[num_iovs].iov_base = reinterpret_cast<char*>(*it) + offset;
+    iov[num_iovs].iov_len = (*it)->size_with_header_and_padding() - offset;
+    bytes_to_write += iov[num_iovs].iov_len;
+    num_iovs++;
+  }
+
   ssize_t bytes_written = HANDLE_EINTR(
-      write(fd_,
-            reinterpret_cast<char*>(message) + write_message_offset_,
-            bytes_to_write));
+      writev(fd_, iov, static_cast<int>(num_iovs)));
   if (bytes_written < 0) {
     if (errno != EAGAIN && errno != EWOULDBLOCK) {
-      PLOG(ERROR) << "write of size " << bytes_to_write;
+      PLOG(ERROR) << "writev of size " << bytes_to_write;
       CancelPendingWritesNoLock();
       return false;
     }
@@ -356,16 +392,22 @@ bool RawChannelPosix::WriteFrontMessageNoLock() {
     bytes_written = 0;
   }
 
+  // Destroy the messages that were completely written, and note how far we
+  // got into the next one.
   DCHECK_GE(bytes_written, 0);
-  if (static_cast<size_t>(bytes_written) < bytes_to_write) {
-    // Partial (or no) write.
-    write_message_offset_ += static_cast<size_t>(bytes_written);
-  } else {
+  size_t bytes_left = static_cast<size_t>(bytes_written);
+  for (size_t i = 0; i < num_iovs; i++) {
+    if (bytes_left < iov[i].iov_len) {
+      // Partial (or no) write.
+      write_message_offset_ += bytes_left;
+      break;
+    }
+
     // Complete write.
-    DCHECK_EQ(static_cast<size_t>(bytes_written), bytes_to_write);
+    bytes_left -= iov[i].iov_len;
+    write_message_queue_.front()->Destroy();
     write_message_queue_.pop_front();
     write_message_offset_ = 0;
-    message->Destroy();
   }
 
   return true;
@@ -4,10 +4,13 @@
 
 #include "net/base/net_log.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/platform_thread.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "net/base/net_errors.h"
@@ -192,10 +195,17 @@ NetLog* NetLog::ThreadSafeObserver::net_log() const {
 NetLog::NetLog()
     : last_id_(0),
       base_log_level_(LOG_NONE),
-      effective_log_level_(LOG_NONE) {
+      effective_log_level_(LOG_NONE),
+      published_observers_(
+          reinterpret_cast<base::subtle::AtomicWord>(new ObserverEntryList())),
+      dispatch_epoch_(0) {
+  active_dispatches_[0] = 0;
+  active_dispatches_[1] = 0;
 }
 
 NetLog::~NetLog() {
+  delete reinterpret_cast<ObserverEntryList*>(
+      base::subtle::NoBarrier_Load(&published_observers_));
 }
 
 void NetLog::AddGlobalEntry(EventType type) {
@@ -237,10 +247,12 @@ void NetLog::AddThreadSafeObserver(
   base::AutoLock lock(lock_);
 
   DCHECK(!observer->net_log_);
-  observers_.AddObserver(observer);
+  ObserverEntry entry = { observer, log_level };
+  observers_.push_back(entry);
   observer->net_log_ = this;
   observer->log_level_ = log_level;
   UpdateLogLevel();
+  PublishObservers();
 }
 
 void NetLog::SetObserverLogLevel(
@@ -248,21 +260,36 @@ void NetLog::SetObserverLogLevel(
     LogLevel log_level) {
   base::AutoLock lock(lock_);
 
-  DCHECK(observers_.HasObserver(observer));
   DCHECK_EQ(this, observer->net_log_);
-  observer->log_level_ = log_level;
-  UpdateLogLevel();
+  for (ObserverEntryList::iterator it = observers_.begin();
+       it != observers_.end(); ++it) {
+    if (it->observer == observer) {
+      it->log_level = log_level;
+      observer->log_level_ = log_level;
+      UpdateLogLevel();
+      PublishObservers();
+      return;
+    }
+  }
+  NOTREACHED();
 }
 
 void NetLog::RemoveThreadSafeObserver(
     net::NetLog::ThreadSafeObserver* observer) {
   base::AutoLock lock(lock_);
 
-  DCHECK(observers_.HasObserver(observer));
   DCHECK_EQ(this, observer->net_log_);
-  observers_.RemoveObserver(observer);
-  observer->net_log_ = NULL;
-  UpdateLogLevel();
+  for (ObserverEntryList::iterator it = observers_.begin();
+       it != observers_.end(); ++it) {
+    if (it->observer == observer) {
+      observers_.erase(it);
+      observer->net_log_ = NULL;
+      UpdateLogLevel();
+      PublishObservers();
+      return;
+    }
+  }
+  NOTREACHED();
 }
 
 void NetLog::UpdateLogLevel() {
@@ -271,16 +298,44 @@ void NetLog::UpdateLogLevel() {
   // Look through all the observers and find the finest granularity
   // log level (higher values of the enum imply *lower* log levels).
   LogLevel new_effective_log_level = base_log_level_;
-  ObserverListBase<ThreadSafeObserver>::Iterator it(observers_);
-  ThreadSafeObserver* observer;
-  while ((observer = it.GetNext()) != NULL) {
+  for (ObserverEntryList::const_iterator it = observers_.begin();
+       it != observers_.end(); ++it) {
     new_effective_log_level =
-        std::min(new_effective_log_level, observer->log_level());
+        std::min(new_effective_log_level, it->log_level);
   }
   base::subtle::NoBarrier_Store(&effective_log_level_,
                                 new_effective_log_level);
 }
 
+void NetLog::PublishObservers() {
+  lock_.AssertAcquired();
+
+  ObserverEntryList* old_observers = reinterpret_cast<ObserverEntryList*>(
+      base::subtle::NoBarrier_Load(&published_observers_));
+  base::subtle::Release_Store(
+      &published_observers_,
+      reinterpret_cast<base::subtle::AtomicWord>(
+          new ObserverEntryList(observers_)));
+
+  // An AddEntry() call may have read the old list as long as it started
+  // before the store above.  Such a call is counted in one of the two slots,
+  // depending on when it read the epoch, so flip the epoch twice, each time
+  // waiting for the slot that is no longer current to drain.  Calls that start
+  // after a flip use the other slot, so this can't be starved by a steady
+  // stream of new entries.
+  for (int i = 0; i < 2; ++i) {
+    base::subtle::Atomic32 epoch =
+        base::subtle::NoBarrier_Load(&dispatch_epoch_);
+    base::subtle::MemoryBarrier();
+    base::subtle::NoBarrier_Store(&dispatch_epoch_, epoch ^ 1);
+    base::subtle::MemoryBarrier();
+    while (base::subtle::Acquire_Load(&active_dispatches_[epoch]) != 0)
+      base::PlatformThread::YieldCurrentThread();
+  }
+
+  delete old_observers;
+}
+
 // static
 std::string NetLog::TickCountToString(const base::TimeTicks& time) {
   int64 delta_time = (time - base::TimeTicks()).InMilliseconds();
@@ -383,15 +438,30 @@ void NetLog::AddEntry(EventType type,
                       const Source& source,
                       EventPhase phase,
                       const NetLog::ParametersCallback* parameters_callback) {
-  LogLevel log_level = GetLogLevel();
-  if (log_level == LOG_NONE)
+  if (GetLogLevel() == LOG_NONE)
     return;
-  Entry entry(type, source, phase, base::TimeTicks::Now(),
-              parameters_callback, log_level);
+  const base::TimeTicks time = base::TimeTicks::Now();
+
+  // Register the call in the current epoch's slot before reading the observer
+  // list, so PublishObservers() won't delete the list while it's in use.
+  const base::subtle::Atomic32 epoch =
+      base::subtle::Acquire_Load(&dispatch_epoch_);
+  base::subtle::Barrier_AtomicIncrement(&active_dispatches_[epoch], 1);
+  const ObserverEntryList* observers =
+      reinterpret_cast<const ObserverEntryList*>(
+          base::subtle::Acquire_Load(&published_observers_));
+
+  // Notify all of the log observers, each at its own log level.
+  for (ObserverEntryList::const_iterator it = observers->begin();
+       it != observers->end(); ++it) {
+    if (it->log_level == LOG_NONE)
+      continue;
+    Entry entry(type, source, phase, time, parameters_callback,
+                it->log_level);
+    it->observer->OnAddEntry(entry);
+  }
 
-  // Notify all of the log observers.
-  base::AutoLock lock(lock_);
-  FOR_EACH_OBSERVER(ThreadSafeObserver, observers_, OnAddEntry(entry));
+  base::subtle::Barrier_AtomicIncrement(&active_dispatches_[epoch], -1);
 }
 
 void BoundNetLog::AddEntry(NetLog::EventType type,
@@ -6,6 +6,7 @@
 #define NET_BASE_NET_LOG_H_
 
 #include <string>
+#include <vector>
 
 #include "base/atomicops.h"
 #include "base/basictypes.h"
@@ -133,6 +134,11 @@ class NET_EXPORT NetLog {
     EventType type() const { return type_; }
     Source source() const { return source_; }
     EventPhase phase() const { return phase_; }
+    base::TimeTicks time() const { return time_; }
+
+    // The log level of the observer the entry is being passed to.  This is
+    // also the level the parameters callback is run with.
+    LogLevel log_level() const { return log_level_; }
 
     // Serializes the specified event to a Value.  The Value also includes the
     // current time.  Caller takes ownership of returned Value.  Takes in a time
@@ -150,7 +156,7 @@ class NET_EXPORT NetLog {
     const base::TimeTicks time_;
     const ParametersCallback* parameters_callback_;
 
-    // Log level when the event occurred.
+    // Log level of the observer receiving the entry.
     const LogLevel log_level_;
 
     // It is not safe to copy this class, since |parameters_callback_| may
@@ -182,9 +188,9 @@ class NET_EXPORT NetLog {
     // otherwise.
     NetLog* net_log() const;
 
-    // This method will be called on the thread that the event occurs on.  It
-    // is the responsibility of the observer to handle it in a thread safe
-    // manner.
+    // This method will be called on the thread that the event occurs on, and
+    // may be running on several threads at once.  It is the responsibility of
+    // the observer to handle it in a thread safe manner.
     //
     // It is illegal for an Observer to call any NetLog or
     // NetLog::Observer functions in response to a call to OnAddEntry.
@@ -227,6 +233,10 @@ class NET_EXPORT NetLog {
   // Observers that need to see the full granularity of events can specify
   // LOG_ALL_BUT_BYTES. However, doing so will have performance consequences.
   //
+  // Each observer is passed entries at its own log level, so a LOG_BASIC
+  // observer doesn't pay for parameters another observer asked for.  An
+  // observer at LOG_NONE is passed no entries.
+  //
   // NetLog implementations must call NetLog::OnAddObserver to update the
   // observer's internal state.
   void AddThreadSafeObserver(ThreadSafeObserver* observer, LogLevel log_level);
@@ -239,6 +249,8 @@ class NET_EXPORT NetLog {
   // Removes an observer.  NetLog implementations must call
   // NetLog::OnAddObserver to update the observer's internal state.
   //
+  // Once this returns, |observer| will not be called again on any thread.
+  //
   // For thread safety reasons, it is recommended that this not be called in
   // an object's destructor.
   void RemoveThreadSafeObserver(ThreadSafeObserver* observer);
@@ -307,11 +319,23 @@ class NET_EXPORT NetLog {
                 EventPhase phase,
                 const NetLog::ParametersCallback* parameters_callback);
 
+  struct ObserverEntry {
+    ThreadSafeObserver* observer;
+    LogLevel log_level;
+  };
+  typedef std::vector<ObserverEntry> ObserverEntryList;
+
   // Called whenever an observer is added or removed, or has its log level
   // changed.  Must have acquired |lock_| prior to calling.
   void UpdateLogLevel();
 
-  // |lock_| protects access to |observers_|.
+  // Publishes a copy of |observers_| for AddEntry() to dispatch to, and waits
+  // until no AddEntry() call can still be using the previous copy before
+  // deleting it.  Must have acquired |lock_| prior to calling.
+  void PublishObservers();
+
+  // |lock_| serializes changes to the set of observers.  It is not taken when
+  // adding entries.
   base::Lock lock_;
 
   // Last assigned source ID.  Incremented to get the next one.
@@ -325,7 +349,19 @@ class NET_EXPORT NetLog {
   base::subtle::Atomic32 effective_log_level_;
 
   // |lock_| must be acquired whenever reading or writing to this.
-  ObserverList<ThreadSafeObserver, true> observers_;
+  ObserverEntryList observers_;
+
+  // An immutable copy of |observers_|, read by AddEntry() without a lock.
+  // Points to an ObserverEntryList, which is only replaced while holding
+  // |lock_|.
+  base::subtle::AtomicWord published_observers_;
+
+  // AddEntry() calls in progress, counted in the slot selected by
+  // |dispatch_epoch_| when each call started.  PublishObservers() flips the
+  // epoch and waits for each slot in turn to drain before deleting a
+  // replaced list.
+  base::subtle::Atomic32 dispatch_epoch_;
+  base::subtle::Atomic32 active_dispatches_[2];
 
   DISALLOW_COPY_AND_ASSIGN(NetLog);
 };
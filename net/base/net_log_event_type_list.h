@@ -70,6 +70,10 @@ EVENT_TYPE(HOST_RESOLVER_IMPL_IPV6_SUPPORTED)
 // This event is logged when a request is handled by a cache entry.
 EVENT_TYPE(HOST_RESOLVER_IMPL_CACHE_HIT)
 
+// This event is logged when a request is handled by an expired cache entry,
+// which is then refreshed in the background.
+EVENT_TYPE(HOST_RESOLVER_IMPL_STALE_CACHE_HIT)
+
 // This event is logged when a request is handled by a HOSTS entry.
 EVENT_TYPE(HOST_RESOLVER_IMPL_HOSTS_HIT)
 
@@ -785,6 +789,18 @@ EVENT_TYPE(HTTP_CACHE_WRITE_INFO)
 EVENT_TYPE(HTTP_CACHE_READ_DATA)
 EVENT_TYPE(HTTP_CACHE_WRITE_DATA)
 
+// Measures the time while an entry which was used stale, as allowed by
+// "Cache-Control: stale-while-revalidate", is revalidated in the background.
+// The BEGIN phase contains the following parameters:
+//   {
+//     "url": <The URL being revalidated>,
+//   }
+// If the revalidation fails, the END phase contains the following parameters:
+//   {
+//     "net_error": <The net error code>,
+//   }
+EVENT_TYPE(HTTP_CACHE_ASYNC_REVALIDATION)
+
 // ------------------------------------------------------------------------
 // Disk Cache / Memory Cache
 // ------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 #include <stdio.h>
 
 #include "base/memory/scoped_handle.h"
+#include "base/synchronization/lock.h"
 #include "net/base/net_log.h"
 
 namespace base {
@@ -46,6 +47,10 @@ class NET_EXPORT NetLogLogger : public NetLog::ThreadSafeObserver {
  private:
   ScopedStdioHandle file_;
 
+  // Serializes writes to |file_|, as OnAddEntry() is called on many threads
+  // at once.  Protects |added_events_|.
+  base::Lock lock_;
+
   // True if OnAddEntry() has been called at least once.
   bool added_events_;
 
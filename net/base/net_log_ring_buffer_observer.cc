@@ -0,0 +1,63 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/net_log_ring_buffer_observer.h"
+
+#include "base/logging.h"
+
+namespace net {
+
+NetLogRingBufferObserver::Record::Record()
+    : type(NetLog::TYPE_CANCELLED),
+      phase(NetLog::PHASE_NONE) {
+}
+
+NetLogRingBufferObserver::NetLogRingBufferObserver(size_t capacity)
+    : records_(capacity),
+      next_(0),
+      total_count_(0) {
+  DCHECK_GT(capacity, 0u);
+}
+
+NetLogRingBufferObserver::~NetLogRingBufferObserver() {
+}
+
+void NetLogRingBufferObserver::StartObserving(NetLog* net_log,
+                                              NetLog::LogLevel log_level) {
+  net_log->AddThreadSafeObserver(this, log_level);
+}
+
+void NetLogRingBufferObserver::StopObserving() {
+  net_log()->RemoveThreadSafeObserver(this);
+}
+
+void NetLogRingBufferObserver::GetRecords(RecordList* records) const {
+  base::AutoLock lock(lock_);
+  records->clear();
+  if (total_count_ < records_.size()) {
+    records->assign(records_.begin(), records_.begin() + next_);
+    return;
+  }
+  records->reserve(records_.size());
+  records->assign(records_.begin() + next_, records_.end());
+  records->insert(records->end(), records_.begin(), records_.begin() + next_);
+}
+
+uint64 NetLogRingBufferObserver::total_count() const {
+  base::AutoLock lock(lock_);
+  return total_count_;
+}
+
+void NetLogRingBufferObserver::OnAddEntry(const NetLog::Entry& entry) {
+  base::AutoLock lock(lock_);
+  Record& record = records_[next_];
+  record.time = entry.time();
+  record.type = entry.type();
+  record.source = entry.source();
+  record.phase = entry.phase();
+  next_ = (next_ + 1) % records_.size();
+  ++total_count_;
+}
+
+}  // namespace net
@@ -0,0 +1,70 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_BASE_NET_LOG_RING_BUFFER_OBSERVER_H_
+#define NET_BASE_NET_LOG_RING_BUFFER_OBSERVER_H_
+
+#include <vector>
+
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "net/base/net_log.h"
+
+namespace net {
+
+// NetLogRingBufferObserver keeps the most recent events of a NetLog in a
+// fixed-size buffer, so it can be left running all the time.  Only the type,
+// source, phase and time of each event are kept.  Parameters are never built,
+// so no base::Value is created for the events it records.
+class NET_EXPORT NetLogRingBufferObserver : public NetLog::ThreadSafeObserver {
+ public:
+  struct NET_EXPORT Record {
+    Record();
+
+    base::TimeTicks time;
+    NetLog::EventType type;
+    NetLog::Source source;
+    NetLog::EventPhase phase;
+  };
+
+  typedef std::vector<Record> RecordList;
+
+  // Keeps at most |capacity| records.  |capacity| must be greater than 0.
+  explicit NetLogRingBufferObserver(size_t capacity);
+  virtual ~NetLogRingBufferObserver();
+
+  // Starts observing |net_log| at |log_level|.  Must not already be watching a
+  // NetLog.
+  void StartObserving(NetLog* net_log, NetLog::LogLevel log_level);
+
+  // Stops observing net_log().  Must already be watching.
+  void StopObserving();
+
+  // Sets |records| to the buffered events, oldest first.
+  void GetRecords(RecordList* records) const;
+
+  // Returns the number of events seen, including those no longer buffered.
+  uint64 total_count() const;
+
+  // net::NetLog::ThreadSafeObserver implementation:
+  virtual void OnAddEntry(const NetLog::Entry& entry) OVERRIDE;
+
+ private:
+  // |lock_| protects all the fields below.
+  mutable base::Lock lock_;
+
+  RecordList records_;
+
+  // Where the next record goes.  Once the buffer has filled, this is also the
+  // oldest record.
+  size_t next_;
+
+  uint64 total_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(NetLogRingBufferObserver);
+};
+
+}  // namespace net
+
+#endif  // NET_BASE_NET_LOG_RING_BUFFER_OBSERVER_H_
@@ -0,0 +1,57 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/net_log_ring_buffer_observer.h"
+
+#include "base/bind.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+base::Value* FailingParametersCallback(NetLog::LogLevel /* log_level */) {
+  ADD_FAILURE() << "Parameters should not be built.";
+  return NULL;
+}
+
+TEST(NetLogRingBufferObserverTest, KeepsMostRecentRecords) {
+  NetLog net_log;
+  NetLogRingBufferObserver observer(3);
+  observer.StartObserving(&net_log, NetLog::LOG_ALL);
+
+  NetLogRingBufferObserver::RecordList records;
+  observer.GetRecords(&records);
+  EXPECT_TRUE(records.empty());
+
+  BoundNetLog bound = BoundNetLog::Make(&net_log, NetLog::SOURCE_URL_REQUEST);
+  bound.BeginEvent(NetLog::TYPE_REQUEST_ALIVE);
+  observer.GetRecords(&records);
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ(NetLog::TYPE_REQUEST_ALIVE, records[0].type);
+  EXPECT_EQ(NetLog::PHASE_BEGIN, records[0].phase);
+  EXPECT_EQ(bound.source().id, records[0].source.id);
+
+  bound.AddEvent(NetLog::TYPE_CANCELLED,
+                 base::Bind(&FailingParametersCallback));
+  bound.AddEvent(NetLog::TYPE_SOCKET_ALIVE);
+  bound.EndEvent(NetLog::TYPE_REQUEST_ALIVE);
+  EXPECT_EQ(4u, observer.total_count());
+
+  // The first event has been overwritten.
+  observer.GetRecords(&records);
+  ASSERT_EQ(3u, records.size());
+  EXPECT_EQ(NetLog::TYPE_CANCELLED, records[0].type);
+  EXPECT_EQ(NetLog::TYPE_SOCKET_ALIVE, records[1].type);
+  EXPECT_EQ(NetLog::TYPE_REQUEST_ALIVE, records[2].type);
+  EXPECT_EQ(NetLog::PHASE_END, records[2].phase);
+  EXPECT_LE(records[0].time, records[2].time);
+
+  observer.StopObserving();
+}
+
+}  // namespace
+
+}  // namespace net
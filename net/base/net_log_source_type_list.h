@@ -28,3 +28,4 @@ SOURCE_TYPE(DOWNLOAD)
 SOURCE_TYPE(FILESTREAM)
 SOURCE_TYPE(DNS_PROBER)
 SOURCE_TYPE(PROXY_CLIENT_SOCKET)
+SOURCE_TYPE(ASYNC_REVALIDATION)
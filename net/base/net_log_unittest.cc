@@ -5,6 +5,7 @@
 #include "net/base/net_log_unittest.h"
 
 #include "base/bind.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/simple_thread.h"
 #include "base/values.h"
@@ -321,6 +322,59 @@ TEST(NetLogTest, NetLogTwoObservers) {
   EXPECT_EQ(1, observer[1].count());
 }
 
+// An observer that records the log level its entries' parameters are built at.
+class LogLevelObserver : public NetLog::ThreadSafeObserver {
+ public:
+  LogLevelObserver() : count_(0), last_log_level_(-1) {}
+
+  virtual void OnAddEntry(const NetLog::Entry& entry) OVERRIDE {
+    ++count_;
+    scoped_ptr<base::Value> params(entry.ParametersToValue());
+    base::DictionaryValue* dict = NULL;
+    ASSERT_TRUE(params && params->GetAsDictionary(&dict));
+    ASSERT_TRUE(dict->GetInteger("log_level", &last_log_level_));
+    EXPECT_EQ(entry.log_level(), last_log_level_);
+  }
+
+  int count() const { return count_; }
+  int last_log_level() const { return last_log_level_; }
+
+ private:
+  int count_;
+  int last_log_level_;
+};
+
+// Check that each observer gets parameters built at its own log level, and
+// that observers at LOG_NONE get no entries at all.
+TEST(NetLogTest, NetLogPerObserverLogLevels) {
+  NetLog net_log;
+  LogLevelObserver observer[3];
+
+  net_log.AddThreadSafeObserver(&observer[0], NetLog::LOG_ALL);
+  net_log.AddThreadSafeObserver(&observer[1], NetLog::LOG_BASIC);
+  net_log.AddThreadSafeObserver(&observer[2], NetLog::LOG_NONE);
+  EXPECT_EQ(NetLog::LOG_ALL, net_log.GetLogLevel());
+
+  net_log.AddGlobalEntry(NetLog::TYPE_SOCKET_ALIVE,
+                         base::Bind(NetLogLevelCallback));
+  EXPECT_EQ(1, observer[0].count());
+  EXPECT_EQ(NetLog::LOG_ALL, observer[0].last_log_level());
+  EXPECT_EQ(1, observer[1].count());
+  EXPECT_EQ(NetLog::LOG_BASIC, observer[1].last_log_level());
+  EXPECT_EQ(0, observer[2].count());
+
+  net_log.SetObserverLogLevel(&observer[2], NetLog::LOG_ALL_BUT_BYTES);
+  net_log.AddGlobalEntry(NetLog::TYPE_SOCKET_ALIVE,
+                         base::Bind(NetLogLevelCallback));
+  EXPECT_EQ(2, observer[0].count());
+  EXPECT_EQ(2, observer[1].count());
+  EXPECT_EQ(1, observer[2].count());
+  EXPECT_EQ(NetLog::LOG_ALL_BUT_BYTES, observer[2].last_log_level());
+
+  for (size_t i = 0; i < arraysize(observer); ++i)
+    net_log.RemoveThreadSafeObserver(&observer[i]);
+}
+
 // Makes sure that adding and removing observers simultaneously on different
 // threads works.
 TEST(NetLogTest, NetLogAddRemoveObserverThreads) {
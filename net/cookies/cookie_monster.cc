@@ -247,6 +247,31 @@ CookieMonster::CookieItVector::iterator PartitionCookieByPriority(
   return std::partition(it_begin, it_end, CookiePriorityEqualsTo(priority));
 }
 
+// Predicate to support PartitionCookieByAccessDate().
+struct CookieAccessedBefore
+    : std::unary_function<const CookieMonster::CookieMap::iterator, bool> {
+  CookieAccessedBefore(const Time& access_date)
+    : access_date_(access_date) {}
+
+  bool operator()(const CookieMonster::CookieMap::iterator it) const {
+    return it->second->LastAccessDate() < access_date_;
+  }
+
+  const Time access_date_;
+};
+
+// For a CookieItVector iterator range [|it_begin|, |it_end|),
+// moves all cookies last accessed before |access_date| to the beginning of the
+// list, without sorting them.
+// Returns: An iterator in [it_begin, it_end) to the first element accessed on
+// or after |access_date|, or |it_end| if there is none.
+CookieMonster::CookieItVector::iterator PartitionCookieByAccessDate(
+    CookieMonster::CookieItVector::iterator it_begin,
+    CookieMonster::CookieItVector::iterator it_end,
+    const Time& access_date) {
+  return std::partition(it_begin, it_end, CookieAccessedBefore(access_date));
+}
+
 bool LowerBoundAccessDateComparator(
   const CookieMonster::CookieMap::iterator it, const Time& access_date) {
   return it->second->LastAccessDate() < access_date;
@@ -2005,16 +2030,28 @@ int CookieMonster::GarbageCollect(const Time& current,
       VLOG(kVlogGarbageCollection) << "Deep Garbage Collect everything.";
       size_t purge_goal = cookie_its.size() - (kMaxCookies - kPurgeCookies);
       DCHECK(purge_goal > kPurgeCookies);
-      // Sorts up to *and including* |cookie_its[purge_goal]|, so
-      // |earliest_access_time| will be properly assigned even if
-      // |global_purge_it| == |cookie_its.begin() + purge_goal|.
-      SortLeastRecentlyAccessed(cookie_its.begin(), cookie_its.end(),
-                                purge_goal);
-      // Find boundary to cookies older than safe_date.
-      CookieItVector::iterator global_purge_it =
-          LowerBoundAccessDate(cookie_its.begin(),
-                               cookie_its.begin() + purge_goal,
-                               safe_date);
+      // Only cookies older than |safe_date| may be deleted, so there is no
+      // need to sort the whole store, which can be very large when most of it
+      // is recent. Move the old cookies to the front instead, and only order
+      // them if there are more than |purge_goal|.
+      CookieItVector::iterator old_end = PartitionCookieByAccessDate(
+          cookie_its.begin(), cookie_its.end(), safe_date);
+      CookieItVector::iterator global_purge_it;
+      if (static_cast<size_t>(old_end - cookie_its.begin()) > purge_goal) {
+        // Puts the |purge_goal| least recently accessed cookies before
+        // |global_purge_it|, which becomes the oldest cookie left.
+        global_purge_it = cookie_its.begin() + purge_goal;
+        std::nth_element(cookie_its.begin(), global_purge_it, old_end,
+                         LRACookieSorter);
+      } else {
+        // All the old cookies go. Move the oldest of the ones left to
+        // |global_purge_it|; there is one, since there are more than
+        // |purge_goal| cookies.
+        global_purge_it = old_end;
+        std::iter_swap(global_purge_it,
+                       std::min_element(old_end, cookie_its.end(),
+                                        LRACookieSorter));
+      }
       // Only delete the old cookies.
       num_deleted += GarbageCollectDeleteRange(
           current,
@@ -21,6 +21,9 @@ namespace net {
 namespace {
 
 const int kNumCookies = 20000;
+// The size of the stores in the large store tests, as seen on long-lived
+// profiles.
+const int kNumLargeStoreCookies = 100000;
 const char kCookieLine[] = "A  = \"b=;\\\"\"  ;secure;;;";
 const char kGoogleURL[] = "http://www.google.izzle";
 
@@ -312,6 +315,44 @@ TEST_F(CookieMonsterTest, TestImport) {
   EXPECT_EQ("domain_1.com", cm->GetKey("www.Domain_1.com"));
 }
 
+// Queries one domain of a store holding kNumLargeStoreCookies cookies spread
+// over 2000 domains, which should take about as long as it does in a small
+// store.
+TEST_F(CookieMonsterTest, TestGetCookiesLargeStore) {
+  scoped_refptr<MockPersistentCookieStore> store(new MockPersistentCookieStore);
+  std::vector<CanonicalCookie*> initial_cookies;
+  GetCookiesCallback getCookiesCallback;
+
+  const int kNumDomains = 2000;
+  const int kCookiesPerDomain = kNumLargeStoreCookies / kNumDomains;
+  int64 time_tick(base::Time::Now().ToInternalValue());
+
+  for (int domain_num = 0; domain_num < kNumDomains; domain_num++) {
+    std::string domain_name(base::StringPrintf(".domain_%d.com", domain_num));
+    std::string gurl("www" + domain_name);
+    for (int cookie_num = 0; cookie_num < kCookiesPerDomain; cookie_num++) {
+      std::string cookie_line(base::StringPrintf("Cookie_%d=1; Path=/",
+                                                 cookie_num));
+      AddCookieToList(gurl, cookie_line,
+                      base::Time::FromInternalValue(time_tick++),
+                      &initial_cookies);
+    }
+  }
+
+  store->SetLoadExpectation(true, initial_cookies);
+
+  scoped_refptr<CookieMonster> cm(new CookieMonster(store.get(), NULL));
+
+  GURL probe_gurl("http://www.domain_1000.com/");
+  std::string cookie_line = getCookiesCallback.GetCookies(cm.get(), probe_gurl);
+  EXPECT_EQ(kCookiesPerDomain, CountInString(cookie_line, '='));
+
+  base::PerfTimeLogger timer("Cookie_monster_query_large_store");
+  for (int i = 0; i < kNumCookies; i++)
+    getCookiesCallback.GetCookies(cm.get(), probe_gurl);
+  timer.Done();
+}
+
 TEST_F(CookieMonsterTest, TestGetKey) {
   scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
   base::PerfTimeLogger timer("Cookie_monster_get_key");
@@ -356,6 +397,12 @@ TEST_F(CookieMonsterTest, TestGCTimes) {
       // shouldn't do).
       CookieMonster::kMaxCookies * 2,
       CookieMonster::kMaxCookies * 3 / 4,
+    }, {
+      // A large store of mostly recent cookies; gc can only ever remove the
+      // few old ones.
+      "large_mostly_recent",
+      kNumLargeStoreCookies,
+      CookieMonster::kMaxCookies / 2,
     }, {
       "less_than_gc_thresh",
       // Few enough cookies that gc shouldn't happen at all.
@@ -2,13 +2,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/bind.h"
 #include "base/bind_helpers.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
 #include "base/hash.h"
 #include "base/strings/string_util.h"
+#include "base/test/perf_log.h"
 #include "base/test/perf_time_logger.h"
 #include "base/test/test_file_util.h"
 #include "base/threading/thread.h"
@@ -22,6 +27,7 @@
 #include "net/disk_cache/disk_cache.h"
 #include "net/disk_cache/disk_cache_test_base.h"
 #include "net/disk_cache/disk_cache_test_util.h"
+#include "net/disk_cache/simple/simple_backend_impl.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
 
@@ -38,9 +44,9 @@ typedef std::vector<TestEntry> TestEntries;
 const int kMaxSize = 16 * 1024 - 1;
 
 // Creates num_entries on the cache, and writes 200 bytes of metadata and up
-// to kMaxSize of data to each entry.
+// to kMaxSize of data to each entry. Returns false if any operation fails.
 bool TimeWrite(int num_entries, disk_cache::Backend* cache,
-              TestEntries* entries) {
+               TestEntries* entries, const std::string& name) {
   const int kSize1 = 200;
   scoped_refptr<net::IOBuffer> buffer1(new net::IOBuffer(kSize1));
   scoped_refptr<net::IOBuffer> buffer2(new net::IOBuffer(kMaxSize));
@@ -49,13 +55,14 @@ bool TimeWrite(int num_entries, disk_cache::Backend* cache,
   CacheTestFillBuffer(buffer2->data(), kMaxSize, false);
 
   int expected = 0;
+  bool failed = false;
 
   MessageLoopHelper helper;
   CallbackTest callback(&helper, true);
 
-  base::PerfTimeLogger timer("Write disk cache entries");
+  base::PerfTimeLogger timer((name + " write entries").c_str());
 
-  for (int i = 0; i < num_entries; i++) {
+  for (int i = 0; i < num_entries && !failed; i++) {
     TestEntry entry;
     entry.key = GenerateKey(true);
     entry.data_len = rand() % kMaxSize;
@@ -64,15 +71,17 @@ bool TimeWrite(int num_entries, disk_cache::Backend* cache,
     disk_cache::Entry* cache_entry;
     net::TestCompletionCallback cb;
     int rv = cache->CreateEntry(entry.key, &cache_entry, cb.callback());
-    if (net::OK != cb.GetResult(rv))
+    if (net::OK != cb.GetResult(rv)) {
+      failed = true;
       break;
+    }
     int ret = cache_entry->WriteData(
         0, 0, buffer1.get(), kSize1,
         base::Bind(&CallbackTest::Run, base::Unretained(&callback)), false);
     if (net::ERR_IO_PENDING == ret)
       expected++;
     else if (kSize1 != ret)
-      break;
+      failed = true;
 
     ret = cache_entry->WriteData(
         1, 0, buffer2.get(), entry.data_len,
@@ -80,19 +89,20 @@ bool TimeWrite(int num_entries, disk_cache::Backend* cache,
     if (net::ERR_IO_PENDING == ret)
       expected++;
     else if (entry.data_len != ret)
-      break;
+      failed = true;
     cache_entry->Close();
   }
 
   helper.WaitUntilCacheIoFinished(expected);
   timer.Done();
 
-  return (expected == helper.callbacks_called());
+  return !failed && expected == helper.callbacks_called();
 }
 
-// Reads the data and metadata from each entry listed on |entries|.
+// Reads the data and metadata from each entry listed on |entries|. Returns
+// false if any operation fails.
 bool TimeRead(int num_entries, disk_cache::Backend* cache,
-             const TestEntries& entries, bool cold) {
+              const TestEntries& entries, bool cold, const std::string& name) {
   const int kSize1 = 200;
   scoped_refptr<net::IOBuffer> buffer1(new net::IOBuffer(kSize1));
   scoped_refptr<net::IOBuffer> buffer2(new net::IOBuffer(kMaxSize));
@@ -101,27 +111,29 @@ bool TimeRead(int num_entries, disk_cache::Backend* cache,
   CacheTestFillBuffer(buffer2->data(), kMaxSize, false);
 
   int expected = 0;
+  bool failed = false;
 
   MessageLoopHelper helper;
   CallbackTest callback(&helper, true);
 
-  const char* message = cold ? "Read disk cache entries (cold)" :
-                        "Read disk cache entries (warm)";
-  base::PerfTimeLogger timer(message);
+  const char* suffix = cold ? " read entries (cold)" : " read entries (warm)";
+  base::PerfTimeLogger timer((name + suffix).c_str());
 
-  for (int i = 0; i < num_entries; i++) {
+  for (int i = 0; i < num_entries && !failed; i++) {
     disk_cache::Entry* cache_entry;
     net::TestCompletionCallback cb;
     int rv = cache->OpenEntry(entries[i].key, &cache_entry, cb.callback());
-    if (net::OK != cb.GetResult(rv))
+    if (net::OK != cb.GetResult(rv)) {
+      failed = true;
       break;
+    }
     int ret = cache_entry->ReadData(
         0, 0, buffer1.get(), kSize1,
         base::Bind(&CallbackTest::Run, base::Unretained(&callback)));
     if (net::ERR_IO_PENDING == ret)
       expected++;
     else if (kSize1 != ret)
-      break;
+      failed = true;
 
     ret = cache_entry->ReadData(
         1, 0, buffer2.get(), entries[i].data_len,
@@ -129,14 +141,14 @@ bool TimeRead(int num_entries, disk_cache::Backend* cache,
     if (net::ERR_IO_PENDING == ret)
       expected++;
     else if (entries[i].data_len != ret)
-      break;
+      failed = true;
     cache_entry->Close();
   }
 
   helper.WaitUntilCacheIoFinished(expected);
   timer.Done();
 
-  return (expected == helper.callbacks_called());
+  return !failed && expected == helper.callbacks_called();
 }
 
 int BlockSize() {
@@ -144,68 +156,217 @@ int BlockSize() {
   return (rand() & 0x3) + 1;
 }
 
-}  // namespace
-
-TEST_F(DiskCacheTest, Hash) {
-  int seed = static_cast<int>(Time::Now().ToInternalValue());
-  srand(seed);
-
-  base::PerfTimeLogger timer("Hash disk cache keys");
-  for (int i = 0; i < 300000; i++) {
-    std::string key = GenerateKey(true);
-    base::Hash(key);
-  }
-  timer.Done();
-}
-
-TEST_F(DiskCacheTest, CacheBackendPerformance) {
+// Writes, then reads back cold and warm, the same set of entries on a backend
+// of |backend_type|, and logs the timings under |name|.
+void CacheBackendPerformance(net::BackendType backend_type,
+                             const base::FilePath& cache_path,
+                             const std::string& name) {
   base::Thread cache_thread("CacheThread");
   ASSERT_TRUE(cache_thread.StartWithOptions(
                   base::Thread::Options(base::MessageLoop::TYPE_IO, 0)));
 
-  ASSERT_TRUE(CleanupCacheDir());
   net::TestCompletionCallback cb;
   scoped_ptr<disk_cache::Backend> cache;
   int rv = disk_cache::CreateCacheBackend(
-      net::DISK_CACHE, net::CACHE_BACKEND_BLOCKFILE, cache_path_, 0, false,
+      net::DISK_CACHE, backend_type, cache_path, 0, false,
       cache_thread.message_loop_proxy().get(), NULL, &cache, cb.callback());
 
   ASSERT_EQ(net::OK, cb.GetResult(rv));
 
-  int seed = static_cast<int>(Time::Now().ToInternalValue());
-  srand(seed);
-
   TestEntries entries;
   int num_entries = 1000;
 
-  EXPECT_TRUE(TimeWrite(num_entries, cache.get(), &entries));
+  EXPECT_TRUE(TimeWrite(num_entries, cache.get(), &entries, name));
 
   base::MessageLoop::current()->RunUntilIdle();
   cache.reset();
+  // The simple backend finishes its file operations on the worker pool.
+  disk_cache::SimpleBackendImpl::FlushWorkerPoolForTesting();
+  base::MessageLoop::current()->RunUntilIdle();
 
-  ASSERT_TRUE(file_util::EvictFileFromSystemCache(
-              cache_path_.AppendASCII("index")));
-  ASSERT_TRUE(file_util::EvictFileFromSystemCache(
-              cache_path_.AppendASCII("data_0")));
-  ASSERT_TRUE(file_util::EvictFileFromSystemCache(
-              cache_path_.AppendASCII("data_1")));
-  ASSERT_TRUE(file_util::EvictFileFromSystemCache(
-              cache_path_.AppendASCII("data_2")));
-  ASSERT_TRUE(file_util::EvictFileFromSystemCache(
-              cache_path_.AppendASCII("data_3")));
+  // The blockfile backend keeps everything in a handful of files, the simple
+  // backend in a few files per entry; evicting all of them covers both.
+  base::FileEnumerator enumerator(cache_path, false,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath file_path = enumerator.Next(); !file_path.empty();
+       file_path = enumerator.Next()) {
+    ASSERT_TRUE(file_util::EvictFileFromSystemCache(file_path));
+  }
 
   rv = disk_cache::CreateCacheBackend(
-      net::DISK_CACHE, net::CACHE_BACKEND_BLOCKFILE, cache_path_, 0, false,
+      net::DISK_CACHE, backend_type, cache_path, 0, false,
       cache_thread.message_loop_proxy().get(), NULL, &cache, cb.callback());
   ASSERT_EQ(net::OK, cb.GetResult(rv));
 
-  EXPECT_TRUE(TimeRead(num_entries, cache.get(), entries, true));
+  EXPECT_TRUE(TimeRead(num_entries, cache.get(), entries, true, name));
 
-  EXPECT_TRUE(TimeRead(num_entries, cache.get(), entries, false));
+  EXPECT_TRUE(TimeRead(num_entries, cache.get(), entries, false, name));
 
   base::MessageLoop::current()->RunUntilIdle();
 }
 
+// One operation of a replayed cache workload.
+enum TraceOpType {
+  TRACE_CREATE,  // Create the entry and write |size| bytes of data to it.
+  TRACE_READ,    // Open the entry and read its |size| bytes of data.
+  TRACE_DOOM     // Doom the entry.
+};
+
+struct TraceOp {
+  TraceOpType type;
+  std::string key;
+  int size;
+};
+typedef std::vector<TraceOp> Trace;
+
+// Builds a workload of |num_ops| operations which, like a caching proxy,
+// mostly reads back entries it wrote earlier and dooms some of them.
+void GenerateTrace(int num_ops, Trace* trace) {
+  std::vector<TraceOp> live_entries;
+  for (int i = 0; i < num_ops; i++) {
+    TraceOp op;
+    int choice = rand() % 10;
+    if (live_entries.empty() || choice < 3) {
+      op.type = TRACE_CREATE;
+      op.key = GenerateKey(true);
+      op.size = rand() % kMaxSize;
+      live_entries.push_back(op);
+    } else if (choice < 9) {
+      op = live_entries[rand() % live_entries.size()];
+      op.type = TRACE_READ;
+    } else {
+      size_t victim = rand() % live_entries.size();
+      op = live_entries[victim];
+      op.type = TRACE_DOOM;
+      live_entries[victim] = live_entries.back();
+      live_entries.pop_back();
+    }
+    trace->push_back(op);
+  }
+}
+
+// Replays |trace| on |cache| one operation at a time, and logs the total time
+// along with the median and 99th percentile latency of a single operation.
+bool ReplayTrace(const Trace& trace, disk_cache::Backend* cache,
+                 const std::string& name) {
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(kMaxSize));
+  CacheTestFillBuffer(buffer->data(), kMaxSize, false);
+
+  std::vector<base::TimeDelta> latencies;
+  latencies.reserve(trace.size());
+
+  base::PerfTimeLogger timer((name + " trace replay").c_str());
+  for (size_t i = 0; i < trace.size(); i++) {
+    const TraceOp& op = trace[i];
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    net::TestCompletionCallback cb;
+    if (op.type == TRACE_DOOM) {
+      if (net::OK != cb.GetResult(cache->DoomEntry(op.key, cb.callback())))
+        return false;
+    } else {
+      disk_cache::Entry* cache_entry;
+      int rv = op.type == TRACE_CREATE ?
+          cache->CreateEntry(op.key, &cache_entry, cb.callback()) :
+          cache->OpenEntry(op.key, &cache_entry, cb.callback());
+      if (net::OK != cb.GetResult(rv))
+        return false;
+      net::TestCompletionCallback io_cb;
+      rv = op.type == TRACE_CREATE ?
+          cache_entry->WriteData(1, 0, buffer.get(), op.size,
+                                 io_cb.callback(), false) :
+          cache_entry->ReadData(1, 0, buffer.get(), op.size,
+                                io_cb.callback());
+      rv = io_cb.GetResult(rv);
+      cache_entry->Close();
+      if (op.size != rv)
+        return false;
+    }
+    latencies.push_back(base::TimeTicks::HighResNow() - start);
+  }
+  timer.Done();
+
+  std::sort(latencies.begin(), latencies.end());
+  base::LogPerfResult((name + " median operation").c_str(),
+                      latencies[latencies.size() / 2].InMillisecondsF(), "ms");
+  base::LogPerfResult((name + " 99th percentile operation").c_str(),
+                      latencies[latencies.size() * 99 / 100].InMillisecondsF(),
+                      "ms");
+  return true;
+}
+
+// Replays |trace| on a fresh cache of |cache_type| and |backend_type|.
+void CacheBackendTraceReplay(net::CacheType cache_type,
+                             net::BackendType backend_type,
+                             const base::FilePath& cache_path,
+                             const Trace& trace,
+                             const std::string& name) {
+  base::Thread cache_thread("CacheThread");
+  ASSERT_TRUE(cache_thread.StartWithOptions(
+                  base::Thread::Options(base::MessageLoop::TYPE_IO, 0)));
+
+  net::TestCompletionCallback cb;
+  scoped_ptr<disk_cache::Backend> cache;
+  int rv = disk_cache::CreateCacheBackend(
+      cache_type, backend_type, cache_path, 0, false,
+      cache_thread.message_loop_proxy().get(), NULL, &cache, cb.callback());
+  ASSERT_EQ(net::OK, cb.GetResult(rv));
+
+  EXPECT_TRUE(ReplayTrace(trace, cache.get(), name));
+
+  base::MessageLoop::current()->RunUntilIdle();
+  cache.reset();
+  disk_cache::SimpleBackendImpl::FlushWorkerPoolForTesting();
+  base::MessageLoop::current()->RunUntilIdle();
+}
+
+}  // namespace
+
+TEST_F(DiskCacheTest, Hash) {
+  int seed = static_cast<int>(Time::Now().ToInternalValue());
+  srand(seed);
+
+  base::PerfTimeLogger timer("Hash disk cache keys");
+  for (int i = 0; i < 300000; i++) {
+    std::string key = GenerateKey(true);
+    base::Hash(key);
+  }
+  timer.Done();
+}
+
+// Runs the same sequential workload against the blockfile and the simple
+// backend, so that their numbers can be compared side by side.
+TEST_F(DiskCacheTest, CacheBackendPerformance) {
+  // Both backends get the same keys and entry sizes.
+  const unsigned int seed = static_cast<unsigned int>(
+      Time::Now().ToInternalValue());
+
+  srand(seed);
+  ASSERT_TRUE(CleanupCacheDir());
+  CacheBackendPerformance(net::CACHE_BACKEND_BLOCKFILE, cache_path_,
+                          "Blockfile cache");
+  srand(seed);
+  ASSERT_TRUE(CleanupCacheDir());
+  CacheBackendPerformance(net::CACHE_BACKEND_SIMPLE, cache_path_,
+                          "Simple cache");
+}
+
+// Runs the same mixed workload against each backend, so that they can be
+// compared on more than sequential writes and reads.
+TEST_F(DiskCacheTest, TraceReplayPerformance) {
+  srand(1);
+  Trace trace;
+  GenerateTrace(5000, &trace);
+
+  ASSERT_TRUE(CleanupCacheDir());
+  CacheBackendTraceReplay(net::DISK_CACHE, net::CACHE_BACKEND_BLOCKFILE,
+                          cache_path_, trace, "Blockfile cache");
+  ASSERT_TRUE(CleanupCacheDir());
+  CacheBackendTraceReplay(net::DISK_CACHE, net::CACHE_BACKEND_SIMPLE,
+                          cache_path_, trace, "Simple cache");
+  CacheBackendTraceReplay(net::MEMORY_CACHE, net::CACHE_BACKEND_DEFAULT,
+                          base::FilePath(), trace, "Memory cache");
+}
+
 // Creating and deleting "entries" on a block-file is something quite frequent
 // (after all, almost everything is stored on block files). The operation is
 // almost free when the file is empty, but can be expensive if the file gets
@@ -4,11 +4,14 @@
 
 #include "net/disk_cache/file.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/lazy_instance.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/run_loop.h"
+#include "base/sys_info.h"
 #include "base/task_runner_util.h"
 #include "base/threading/sequenced_worker_pool.h"
 #include "net/base/net_errors.h"
@@ -16,12 +19,21 @@
 
 namespace {
 
-// The maximum number of threads for this pool.
-const int kMaxThreads = 5;
+// Bounds for the number of threads in this pool. Entry data is read and
+// written here, off the cache thread, so on machines with several cores and
+// fast disks the pool grows with the core count to keep the disk busy.
+const int kMinThreads = 5;
+const int kMaxThreads = 16;
+
+int GetNumberOfThreads() {
+  return std::min(kMaxThreads,
+                  std::max(kMinThreads, base::SysInfo::NumberOfProcessors()));
+}
 
 class FileWorkerPool : public base::SequencedWorkerPool {
  public:
-  FileWorkerPool() : base::SequencedWorkerPool(kMaxThreads, "CachePool") {}
+  FileWorkerPool()
+      : base::SequencedWorkerPool(GetNumberOfThreads(), "CachePool") {}
 
  protected:
   virtual ~FileWorkerPool() {}
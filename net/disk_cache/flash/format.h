@@ -11,6 +11,11 @@ namespace disk_cache {
 const int32 kFlashPageSize = 8 * 1024;
 const int32 kFlashBlockSize = 512 * kFlashPageSize;
 
+// Data written to a segment is buffered and handed to storage in whole pages,
+// at most this many bytes at a time, so that small entries do not turn into
+// small random writes on the device.
+const int32 kFlashWriteBatchSize = 16 * kFlashPageSize;
+
 // Segment constants.
 const int32 kFlashSegmentSize = 4 * 1024 * 1024;
 const int32 kFlashSmallEntrySize = 4 * 1024;
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <cstring>
 
 #include "base/logging.h"
 #include "net/disk_cache/flash/format.h"
@@ -19,7 +20,12 @@ Segment::Segment(int32 index, bool read_only, Storage* storage)
       storage_(storage),
       offset_(index * kFlashSegmentSize),
       summary_offset_(offset_ + kFlashSegmentSize - kFlashSummarySize),
-      write_offset_(offset_) {
+      write_offset_(offset_),
+      write_buffer_offset_(offset_) {
+  COMPILE_ASSERT(kFlashSegmentSize % kFlashPageSize == 0,
+                 invalid_segment_size);
+  COMPILE_ASSERT(kFlashWriteBatchSize % kFlashPageSize == 0,
+                 invalid_write_batch_size);
   DCHECK(storage);
   DCHECK(storage->size() % kFlashSegmentSize == 0);
 }
@@ -77,10 +83,12 @@ bool Segment::Init() {
 bool Segment::WriteData(const void* buffer, int32 size) {
   DCHECK(init_ && !read_only_);
   DCHECK(write_offset_ + size <= summary_offset_);
-  if (!storage_->Write(buffer, size, write_offset_))
-    return false;
+  const char* data = static_cast<const char*>(buffer);
+  write_buffer_.insert(write_buffer_.end(), data, data + size);
   write_offset_ += size;
-  return true;
+  if (write_buffer_.size() < static_cast<size_t>(kFlashWriteBatchSize))
+    return true;
+  return FlushWriteBuffer(false);
 }
 
 void Segment::StoreOffset(int32 offset) {
@@ -92,7 +100,28 @@ void Segment::StoreOffset(int32 offset) {
 bool Segment::ReadData(void* buffer, int32 size, int32 offset) const {
   DCHECK(init_);
   DCHECK(offset >= offset_ && offset + size <= offset_ + kFlashSegmentSize);
-  return storage_->Read(buffer, size, offset);
+
+  if (write_buffer_.empty())
+    return storage_->Read(buffer, size, offset);
+
+  // Read the part that already reached storage, then copy the rest from the
+  // write buffer.
+  char* out = static_cast<char*>(buffer);
+  int32 stored_size = std::min(size, write_buffer_offset_ - offset);
+  if (stored_size > 0 && !storage_->Read(out, stored_size, offset))
+    return false;
+  stored_size = std::max(0, stored_size);
+
+  int32 buffer_start = offset + stored_size - write_buffer_offset_;
+  int32 buffered_size = std::min(
+      size - stored_size,
+      std::max(0, static_cast<int32>(write_buffer_.size()) - buffer_start));
+  if (buffered_size > 0)
+    memcpy(out + stored_size, &write_buffer_[buffer_start], buffered_size);
+
+  // Anything past the written data comes from storage, as it did before.
+  int32 done = stored_size + buffered_size;
+  return done == size || storage_->Read(out + done, size - done, offset + done);
 }
 
 bool Segment::Close() {
@@ -101,6 +130,8 @@ bool Segment::Close() {
     return true;
 
   DCHECK(offsets_.size() <= kFlashMaxEntryCount);
+  if (!FlushWriteBuffer(true))
+    return false;
 
   int32 summary[kFlashMaxEntryCount + 1];
   memset(summary, 0, kFlashSummarySize);
@@ -119,4 +150,19 @@ bool Segment::CanHold(int32 size) const {
       write_offset_ + size <= summary_offset_;
 }
 
+bool Segment::FlushWriteBuffer(bool all) {
+  int32 flush_size = write_buffer_.size();
+  if (!all)
+    flush_size -= flush_size % kFlashPageSize;
+  if (flush_size == 0)
+    return true;
+
+  if (!storage_->Write(&write_buffer_[0], flush_size, write_buffer_offset_))
+    return false;
+  write_buffer_.erase(write_buffer_.begin(),
+                      write_buffer_.begin() + flush_size);
+  write_buffer_offset_ += flush_size;
+  return true;
+}
+
 }  // namespace disk_cache
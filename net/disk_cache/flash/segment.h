@@ -55,6 +55,10 @@ class Storage;
 //
 // ReadData can be called over the range that was previously written with
 // WriteData.  Reading from area that was not written will fail.
+//
+// Writes are buffered in memory and reach the storage in whole flash pages,
+// |kFlashWriteBatchSize| bytes at a time; Close() flushes the remainder.  Data
+// still in the buffer is served from it by ReadData.
 
 class NET_EXPORT_PRIVATE Segment {
  public:
@@ -100,6 +104,10 @@ class NET_EXPORT_PRIVATE Segment {
   bool CanHold(int32 size) const;
 
  private:
+  // Writes the buffered data to storage.  Unless |all| is true, only whole
+  // pages are written and the partial page at the end stays buffered.
+  bool FlushWriteBuffer(bool all);
+
   int32 index_;
   int32 num_users_;
   bool read_only_;  // Indicates whether the segment can be written to.
@@ -110,6 +118,11 @@ class NET_EXPORT_PRIVATE Segment {
   int32 write_offset_;  // Current write offset.
   std::vector<int32> offsets_;
 
+  // Data written but not yet handed to |storage_|; it belongs at
+  // |write_buffer_offset_|, which is always page aligned.
+  std::vector<char> write_buffer_;
+  int32 write_buffer_offset_;
+
   DISALLOW_COPY_AND_ASSIGN(Segment);
 };
 
@@ -150,3 +150,46 @@ TEST_F(FlashCacheTest, SegmentFillWithLargeEntries) {
   EXPECT_LT(segment->GetOffsets().size(), disk_cache::kFlashMaxEntryCount);
   EXPECT_TRUE(segment->Close());
 }
+
+// Small writes are held back until a whole batch of pages is ready, but must
+// be readable from the segment in the meantime.
+TEST_F(FlashCacheTest, SegmentBatchesSmallWrites) {
+  disk_cache::Storage storage(path_, kStorageSize);
+  ASSERT_TRUE(storage.Init());
+
+  int32 index = 0;
+  scoped_ptr<disk_cache::Segment> segment(
+      new disk_cache::Segment(index, false, &storage));
+  EXPECT_TRUE(segment->Init());
+
+  SmallEntry entry1;
+  int32 offset1 = segment->write_offset();
+  EXPECT_TRUE(segment->WriteData(entry1.data, entry1.size));
+  segment->StoreOffset(offset1);
+
+  // The entry has not reached the storage yet.
+  SmallEntry from_storage;
+  EXPECT_TRUE(storage.Read(from_storage.data, from_storage.size, offset1));
+  EXPECT_FALSE(entry1 == from_storage);
+
+  SmallEntry entry2;
+  EXPECT_TRUE(segment->ReadData(entry2.data, entry2.size, offset1));
+  EXPECT_EQ(entry1, entry2);
+
+  // Filling a batch flushes the whole pages in it, including the first entry.
+  int32 num_bytes_written = entry1.size;
+  while (num_bytes_written < disk_cache::kFlashWriteBatchSize) {
+    int32 offset = segment->write_offset();
+    EXPECT_TRUE(segment->WriteData(entry2.data, entry2.size));
+    segment->StoreOffset(offset);
+    num_bytes_written += entry2.size;
+  }
+  EXPECT_TRUE(storage.Read(from_storage.data, from_storage.size, offset1));
+  EXPECT_EQ(entry1, from_storage);
+
+  // The last, partial page is written on Close().
+  int32 last_offset = segment->write_offset() - entry2.size;
+  EXPECT_TRUE(segment->Close());
+  EXPECT_TRUE(storage.Read(from_storage.data, from_storage.size, last_offset));
+  EXPECT_EQ(entry2, from_storage);
+}
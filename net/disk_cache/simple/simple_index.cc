@@ -5,6 +5,7 @@
 #include "net/disk_cache/simple/simple_index.h"
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <string>
 #include <utility>
@@ -48,29 +49,23 @@ const uint32 kEvictionMarginDivisor = 20;
 
 const uint32 kBytesInKb = 1024;
 
-// Utility class used for timestamp comparisons in entry metadata while sorting.
-class CompareHashesForTimestamp {
-  typedef disk_cache::SimpleIndex SimpleIndex;
-  typedef disk_cache::SimpleIndex::EntrySet EntrySet;
- public:
-  explicit CompareHashesForTimestamp(const EntrySet& set);
+// A full index write replaces the journal once the journal holds more than
+// max(kMinJournalRecordsBeforeFullWrite, entries / kJournalRecordsDivisor)
+// records.
+const size_t kMinJournalRecordsBeforeFullWrite = 1024;
+const size_t kJournalRecordsDivisor = 4;
 
-  bool operator()(uint64 hash1, uint64 hash2);
- private:
-  const EntrySet& entry_set_;
-};
+// The smallest table SimpleIndexEntrySet allocates, in slots.
+const size_t kMinimumEntrySetSlots = 16;
 
-CompareHashesForTimestamp::CompareHashesForTimestamp(const EntrySet& set)
-  : entry_set_(set) {
+// SimpleIndexEntrySet grows once more than 3/4 of its slots are in use.
+bool ExceedsMaxLoad(size_t entries, size_t slots) {
+  return entries * 4 > slots * 3;
 }
 
-bool CompareHashesForTimestamp::operator()(uint64 hash1, uint64 hash2) {
-  EntrySet::const_iterator it1 = entry_set_.find(hash1);
-  DCHECK(it1 != entry_set_.end());
-  EntrySet::const_iterator it2 = entry_set_.find(hash2);
-  DCHECK(it2 != entry_set_.end());
-  return it1->second.GetLastUsedTime() < it2->second.GetLastUsedTime();
-}
+// An eviction candidate, ordered so that a heap built with std::greater has
+// the least recently used entry on top.
+typedef std::pair<base::Time, uint64> EvictionCandidate;
 
 }  // namespace
 
@@ -135,6 +130,136 @@ bool EntryMetadata::Deserialize(PickleIterator* it) {
   return true;
 }
 
+SimpleIndexEntrySet::SimpleIndexEntrySet()
+    : size_(0) {
+}
+
+SimpleIndexEntrySet::~SimpleIndexEntrySet() {
+}
+
+SimpleIndexEntrySet::iterator SimpleIndexEntrySet::find(uint64 entry_hash) {
+  return iterator(this, FindSlot(entry_hash));
+}
+
+SimpleIndexEntrySet::const_iterator SimpleIndexEntrySet::find(
+    uint64 entry_hash) const {
+  return const_iterator(this, FindSlot(entry_hash));
+}
+
+size_t SimpleIndexEntrySet::count(uint64 entry_hash) const {
+  return FindSlot(entry_hash) == slots_.size() ? 0 : 1;
+}
+
+std::pair<SimpleIndexEntrySet::iterator, bool> SimpleIndexEntrySet::insert(
+    const value_type& value) {
+  size_t slot = FindSlot(value.first);
+  if (slot != slots_.size())
+    return std::make_pair(iterator(this, slot), false);
+
+  if (slots_.empty() || ExceedsMaxLoad(size_ + 1, slots_.size()))
+    Rehash(std::max(kMinimumEntrySetSlots, slots_.size() * 2));
+
+  const size_t mask = slots_.size() - 1;
+  for (slot = IdealSlot(value.first); occupied_[slot]; slot = (slot + 1) & mask)
+    continue;
+  slots_[slot] = value;
+  occupied_[slot] = true;
+  ++size_;
+  return std::make_pair(iterator(this, slot), true);
+}
+
+void SimpleIndexEntrySet::erase(iterator it) {
+  DCHECK_EQ(this, it.table());
+  size_t hole = it.slot();
+  DCHECK(occupied_[hole]);
+  occupied_[hole] = false;
+  --size_;
+
+  // Shift back every following entry of the probe run that would no longer
+  // be reachable from its ideal slot across the hole.
+  const size_t mask = slots_.size() - 1;
+  for (size_t slot = (hole + 1) & mask; occupied_[slot];
+       slot = (slot + 1) & mask) {
+    const size_t ideal = IdealSlot(slots_[slot].first);
+    // The entry may stay if its ideal slot lies cyclically in (hole, slot].
+    const bool stays = hole <= slot ? (hole < ideal && ideal <= slot)
+                                    : (hole < ideal || ideal <= slot);
+    if (stays)
+      continue;
+    slots_[hole] = slots_[slot];
+    occupied_[hole] = true;
+    occupied_[slot] = false;
+    hole = slot;
+  }
+}
+
+size_t SimpleIndexEntrySet::erase(uint64 entry_hash) {
+  iterator it = find(entry_hash);
+  if (it == end())
+    return 0;
+  erase(it);
+  return 1;
+}
+
+void SimpleIndexEntrySet::clear() {
+  std::fill(occupied_.begin(), occupied_.end(), false);
+  size_ = 0;
+}
+
+void SimpleIndexEntrySet::swap(SimpleIndexEntrySet& other) {
+  slots_.swap(other.slots_);
+  occupied_.swap(other.occupied_);
+  std::swap(size_, other.size_);
+}
+
+void SimpleIndexEntrySet::reserve(size_t count) {
+  size_t slot_count = std::max(kMinimumEntrySetSlots, slots_.size());
+  while (ExceedsMaxLoad(count, slot_count))
+    slot_count *= 2;
+  if (slot_count != slots_.size())
+    Rehash(slot_count);
+}
+
+size_t SimpleIndexEntrySet::IdealSlot(uint64 entry_hash) const {
+  // Fold in the high bits so that small test hashes and real SHA-1 prefixes
+  // both spread across the table.
+  return static_cast<size_t>(entry_hash ^ (entry_hash >> 32)) &
+      (slots_.size() - 1);
+}
+
+size_t SimpleIndexEntrySet::FindSlot(uint64 entry_hash) const {
+  if (slots_.empty())
+    return 0;
+  const size_t mask = slots_.size() - 1;
+  for (size_t slot = IdealSlot(entry_hash); occupied_[slot];
+       slot = (slot + 1) & mask) {
+    if (slots_[slot].first == entry_hash)
+      return slot;
+  }
+  return slots_.size();
+}
+
+void SimpleIndexEntrySet::Rehash(size_t slot_count) {
+  DCHECK_EQ(0u, slot_count & (slot_count - 1));
+  DCHECK(!ExceedsMaxLoad(size_, slot_count));
+
+  std::vector<value_type> old_slots(slot_count);
+  std::vector<bool> old_occupied(slot_count, false);
+  old_slots.swap(slots_);
+  old_occupied.swap(occupied_);
+
+  const size_t mask = slot_count - 1;
+  for (size_t i = 0; i < old_slots.size(); ++i) {
+    if (!old_occupied[i])
+      continue;
+    size_t slot = IdealSlot(old_slots[i].first);
+    while (occupied_[slot])
+      slot = (slot + 1) & mask;
+    slots_[slot] = old_slots[i];
+    occupied_[slot] = true;
+  }
+}
+
 SimpleIndex::SimpleIndex(base::SingleThreadTaskRunner* io_thread,
                          SimpleIndexDelegate* delegate,
                          net::CacheType cache_type,
@@ -147,6 +272,8 @@ SimpleIndex::SimpleIndex(base::SingleThreadTaskRunner* io_thread,
       low_watermark_(0),
       eviction_in_progress_(false),
       initialized_(false),
+      journal_records_(0),
+      full_write_required_(true),
       index_file_(index_file.Pass()),
       io_thread_(io_thread),
       // Creating the callback once so it is reused every time
@@ -266,6 +393,7 @@ void SimpleIndex::Insert(uint64 entry_hash) {
       entry_hash, EntryMetadata(base::Time::Now(), 0), &entries_set_);
   if (!initialized_)
     removed_entries_.erase(entry_hash);
+  MarkChanged(entry_hash);
   PostponeWritingToDisk();
 }
 
@@ -279,6 +407,7 @@ void SimpleIndex::Remove(uint64 entry_hash) {
 
   if (!initialized_)
     removed_entries_.insert(entry_hash);
+  MarkChanged(entry_hash);
   PostponeWritingToDisk();
 }
 
@@ -297,6 +426,7 @@ bool SimpleIndex::UseIfExists(uint64 entry_hash) {
     // If not initialized, always return true, forcing it to go to the disk.
     return !initialized_;
   it->second.SetLastUsedTime(base::Time::Now());
+  MarkChanged(entry_hash);
   PostponeWritingToDisk();
   return true;
 }
@@ -314,29 +444,32 @@ void SimpleIndex::StartEvictionIfNeeded() {
   SIMPLE_CACHE_UMA(MEMORY_KB,
                    "Eviction.MaxCacheSizeOnStart2", cache_type_,
                    max_size_ / kBytesInKb);
-  std::vector<uint64> entry_hashes;
-  entry_hashes.reserve(entries_set_.size());
+  // Only the oldest entries are needed, usually a small fraction of the
+  // index, so heapify the candidates in linear time and pop them oldest
+  // first rather than sorting the whole index.
+  std::vector<EvictionCandidate> candidates;
+  candidates.reserve(entries_set_.size());
   for (EntrySet::const_iterator it = entries_set_.begin(),
        end = entries_set_.end(); it != end; ++it) {
-    entry_hashes.push_back(it->first);
+    candidates.push_back(
+        EvictionCandidate(it->second.GetLastUsedTime(), it->first));
   }
-  std::sort(entry_hashes.begin(), entry_hashes.end(),
-            CompareHashesForTimestamp(entries_set_));
+  std::greater<EvictionCandidate> older_on_top;
+  std::make_heap(candidates.begin(), candidates.end(), older_on_top);
 
   // Remove as many entries from the index to get below |low_watermark_|.
-  std::vector<uint64>::iterator it = entry_hashes.begin();
+  std::vector<uint64> entry_hashes;
   uint64 evicted_so_far_size = 0;
   while (evicted_so_far_size < cache_size_ - low_watermark_) {
-    DCHECK(it != entry_hashes.end());
-    EntrySet::iterator found_meta = entries_set_.find(*it);
+    DCHECK(!candidates.empty());
+    std::pop_heap(candidates.begin(), candidates.end(), older_on_top);
+    const uint64 entry_hash = candidates.back().second;
+    candidates.pop_back();
+    EntrySet::const_iterator found_meta = entries_set_.find(entry_hash);
     DCHECK(found_meta != entries_set_.end());
-    uint64 to_evict_size = found_meta->second.GetEntrySize();
-    evicted_so_far_size += to_evict_size;
-    ++it;
+    evicted_so_far_size += found_meta->second.GetEntrySize();
+    entry_hashes.push_back(entry_hash);
   }
-
-  // Take out the rest of hashes from the eviction list.
-  entry_hashes.erase(it, entry_hashes.end());
   SIMPLE_CACHE_UMA(COUNTS,
                    "Eviction.EntryCount", cache_type_, entry_hashes.size());
   SIMPLE_CACHE_UMA(TIMES,
@@ -357,6 +490,7 @@ bool SimpleIndex::UpdateEntrySize(uint64 entry_hash, int entry_size) {
     return false;
 
   UpdateEntryIteratorSize(&it, entry_size);
+  MarkChanged(entry_hash);
   PostponeWritingToDisk();
   StartEvictionIfNeeded();
   return true;
@@ -395,6 +529,12 @@ void SimpleIndex::PostponeWritingToDisk() {
       FROM_HERE, base::TimeDelta::FromMilliseconds(delay), write_to_disk_cb_);
 }
 
+void SimpleIndex::MarkChanged(uint64 entry_hash) {
+  // Until the first full write everything is written anyway.
+  if (!full_write_required_)
+    changed_entries_.insert(entry_hash);
+}
+
 void SimpleIndex::UpdateEntryIteratorSize(EntrySet::iterator* it,
                                           int entry_size) {
   // Update the total cache size with the new entry size.
@@ -437,6 +577,8 @@ void SimpleIndex::MergeInitializingSet(
   entries_set_.swap(*index_file_entries);
   cache_size_ = merged_cache_size;
   initialized_ = true;
+  full_write_required_ = true;
+  changed_entries_.clear();
 
   // The actual IO is asynchronous, so calling WriteToDisk() shouldn't slow the
   // merge down much.
@@ -491,6 +633,24 @@ void SimpleIndex::WriteToDisk() {
   }
   last_write_to_disk_ = start;
 
+  const size_t max_journal_records =
+      std::max(kMinJournalRecordsBeforeFullWrite,
+               entries_set_.size() / kJournalRecordsDivisor);
+  if (!full_write_required_ &&
+      journal_records_ + changed_entries_.size() <= max_journal_records) {
+    // Append even if nothing changed: the journal block also records the
+    // cache directory mtime, which keeps the index fresh after a crash.
+    HashList changed_hashes(changed_entries_.begin(), changed_entries_.end());
+    changed_entries_.clear();
+    journal_records_ += changed_hashes.size();
+    index_file_->AppendToJournal(entries_set_, changed_hashes,
+                                 start, app_on_background_);
+    return;
+  }
+
+  full_write_required_ = false;
+  journal_records_ = 0;
+  changed_entries_.clear();
   index_file_->WriteToDisk(entries_set_, cache_size_,
                            start, app_on_background_);
 }
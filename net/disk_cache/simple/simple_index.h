@@ -6,6 +6,7 @@
 #define NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_H_
 
 #include <list>
+#include <utility>
 #include <vector>
 
 #include "base/basictypes.h"
@@ -71,6 +72,109 @@ class NET_EXPORT_PRIVATE EntryMetadata {
 };
 COMPILE_ASSERT(sizeof(EntryMetadata) == 8, metadata_size);
 
+// A map from entry hash to EntryMetadata, stored as an open-addressing table
+// in a single array so that the index costs 16 bytes per slot and no heap
+// allocation per entry. Entry hashes are already uniformly distributed, so
+// they pick their slot directly; collisions probe linearly, and removal
+// shifts the following entries back instead of leaving tombstones.
+//
+// The interface is the subset of base::hash_map that the index needs.
+// Inserting and erasing invalidate all iterators.
+class NET_EXPORT_PRIVATE SimpleIndexEntrySet {
+ public:
+  typedef std::pair<uint64, EntryMetadata> value_type;
+
+  template <typename TableType, typename ValueType>
+  class IteratorImpl {
+   public:
+    IteratorImpl() : table_(NULL), slot_(0) {}
+    IteratorImpl(TableType* table, size_t slot)
+        : table_(table),
+          slot_(slot) {
+      SkipEmptySlots();
+    }
+    // Allows conversion from iterator to const_iterator.
+    template <typename OtherTableType, typename OtherValueType>
+    IteratorImpl(const IteratorImpl<OtherTableType, OtherValueType>& other)
+        : table_(other.table()),
+          slot_(other.slot()) {
+    }
+
+    ValueType& operator*() const { return table_->slots_[slot_]; }
+    ValueType* operator->() const { return &table_->slots_[slot_]; }
+
+    IteratorImpl& operator++() {
+      ++slot_;
+      SkipEmptySlots();
+      return *this;
+    }
+
+    bool operator==(const IteratorImpl& other) const {
+      return slot_ == other.slot_ && table_ == other.table_;
+    }
+    bool operator!=(const IteratorImpl& other) const {
+      return !(*this == other);
+    }
+
+    TableType* table() const { return table_; }
+    size_t slot() const { return slot_; }
+
+   private:
+    void SkipEmptySlots() {
+      while (slot_ < table_->slots_.size() && !table_->occupied_[slot_])
+        ++slot_;
+    }
+
+    TableType* table_;
+    size_t slot_;
+  };
+
+  typedef IteratorImpl<SimpleIndexEntrySet, value_type> iterator;
+  typedef IteratorImpl<const SimpleIndexEntrySet, const value_type>
+      const_iterator;
+
+  SimpleIndexEntrySet();
+  ~SimpleIndexEntrySet();
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, slots_.size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, slots_.size()); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  iterator find(uint64 entry_hash);
+  const_iterator find(uint64 entry_hash) const;
+  size_t count(uint64 entry_hash) const;
+
+  // Like std::map::insert, does nothing if |value.first| is already present.
+  std::pair<iterator, bool> insert(const value_type& value);
+
+  void erase(iterator it);
+  size_t erase(uint64 entry_hash);
+
+  void clear();
+  void swap(SimpleIndexEntrySet& other);
+
+  // Makes room for |count| entries without growing the table again.
+  void reserve(size_t count);
+
+ private:
+  size_t IdealSlot(uint64 entry_hash) const;
+
+  // Returns the slot holding |entry_hash|, or slots_.size() if there is none.
+  size_t FindSlot(uint64 entry_hash) const;
+
+  // Rehashes every entry into a table of |slot_count| slots, which must be a
+  // power of two.
+  void Rehash(size_t slot_count);
+
+  std::vector<value_type> slots_;
+  std::vector<bool> occupied_;
+  size_t size_;
+};
+
 // This class is not Thread-safe.
 class NET_EXPORT_PRIVATE SimpleIndex
     : public base::SupportsWeakPtr<SimpleIndex> {
@@ -106,7 +210,7 @@ class NET_EXPORT_PRIVATE SimpleIndex
   // entry.
   bool UpdateEntrySize(uint64 entry_hash, int entry_size);
 
-  typedef base::hash_map<uint64, EntryMetadata> EntrySet;
+  typedef SimpleIndexEntrySet EntrySet;
 
   static void InsertInEntrySet(uint64 entry_hash,
                                const EntryMetadata& entry_metadata,
@@ -137,12 +241,16 @@ class NET_EXPORT_PRIVATE SimpleIndex
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteQueued);
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteExecuted);
   FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWritePostponed);
+  FRIEND_TEST_ALL_PREFIXES(SimpleIndexTest, DiskWriteAppendsToJournal);
 
   void StartEvictionIfNeeded();
   void EvictionDone(int result);
 
   void PostponeWritingToDisk();
 
+  // Records that |entry_hash| needs to go into the next journal append.
+  void MarkChanged(uint64 entry_hash);
+
   void UpdateEntryIteratorSize(EntrySet::iterator* it, int entry_size);
 
   // Must run on IO Thread.
@@ -172,6 +280,19 @@ class NET_EXPORT_PRIVATE SimpleIndex
   base::hash_set<uint64> removed_entries_;
   bool initialized_;
 
+  // Entries inserted, removed or updated since the index was last written,
+  // which the next journal append has to record.
+  base::hash_set<uint64> changed_entries_;
+
+  // Number of entry records appended to the journal since the last full write.
+  // Once this grows past a fraction of the index, the next write is a full one
+  // so that loading does not have to replay an ever longer journal.
+  size_t journal_records_;
+
+  // True until the first full write after initialization; the entries merged
+  // while initializing are not in the journal.
+  bool full_write_required_;
+
   scoped_ptr<SimpleIndexFile> index_file_;
 
   scoped_refptr<base::SingleThreadTaskRunner> io_thread_;
@@ -143,6 +143,8 @@ const char SimpleIndexFile::kIndexFileName[] = "the-real-index";
 const char SimpleIndexFile::kIndexDirectory[] = "index-dir";
 // static
 const char SimpleIndexFile::kTempIndexFileName[] = "temp-index";
+// static
+const char SimpleIndexFile::kJournalFileName[] = "the-real-index-journal";
 
 SimpleIndexFile::IndexMetadata::IndexMetadata()
     : magic_number_(kSimpleIndexMagicNumber),
@@ -187,6 +189,7 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
                                       const base::FilePath& cache_directory,
                                       const base::FilePath& index_filename,
                                       const base::FilePath& temp_index_filename,
+                                      const base::FilePath& journal_filename,
                                       scoped_ptr<Pickle> pickle,
                                       const base::TimeTicks& start_time,
                                       bool app_on_background) {
@@ -213,6 +216,11 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
     }
   }
 
+  // The journal holds changes relative to the index being replaced. Drop it
+  // first: a crash after this point leaves the old index without its journal,
+  // which is detected as stale, rather than a journal over the wrong index.
+  base::DeleteFile(journal_filename, /* recursive = */ false);
+
   // Atomically rename the temporary index file to become the real one.
   bool result = base::ReplaceFile(temp_index_filename, index_filename, NULL);
   DCHECK(result);
@@ -228,6 +236,41 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
   }
 }
 
+// static
+void SimpleIndexFile::SyncAppendToJournal(
+    net::CacheType cache_type,
+    const base::FilePath& cache_directory,
+    const base::FilePath& journal_filename,
+    scoped_ptr<Pickle> pickle,
+    const base::TimeTicks& start_time) {
+  base::Time cache_dir_mtime;
+  if (!simple_util::GetMTime(cache_directory, &cache_dir_mtime)) {
+    LOG(ERROR) << "Could obtain information about cache age";
+    return;
+  }
+  SerializeFinalData(cache_dir_mtime, pickle.get());
+
+  const char* data = static_cast<const char*>(pickle->data());
+  const int size = implicit_cast<int>(pickle->size());
+  int bytes_written;
+  if (base::PathExists(journal_filename))
+    bytes_written = file_util::AppendToFile(journal_filename, data, size);
+  else
+    bytes_written = file_util::WriteFile(journal_filename, data, size);
+  if (bytes_written != size) {
+    // Blocks after a torn one are never replayed, so there is no point in
+    // keeping the journal. Without it the index will be found stale on the
+    // next load and rebuilt.
+    LOG(ERROR) << "Failed to append to the index journal";
+    base::DeleteFile(journal_filename, /* recursive = */ false);
+    return;
+  }
+
+  SIMPLE_CACHE_UMA(TIMES,
+                   "IndexJournalAppendTime", cache_type,
+                   (base::TimeTicks::Now() - start_time));
+}
+
 bool SimpleIndexFile::IndexMetadata::CheckIndexMetadata() {
   return number_of_entries_ <= kMaxEntiresInIndex &&
       magic_number_ == kSimpleIndexMagicNumber &&
@@ -246,7 +289,9 @@ SimpleIndexFile::SimpleIndexFile(
       index_file_(cache_directory_.AppendASCII(kIndexDirectory)
                       .AppendASCII(kIndexFileName)),
       temp_index_file_(cache_directory_.AppendASCII(kIndexDirectory)
-                           .AppendASCII(kTempIndexFileName)) {
+                           .AppendASCII(kTempIndexFileName)),
+      journal_file_(cache_directory_.AppendASCII(kIndexDirectory)
+                        .AppendASCII(kJournalFileName)) {
 }
 
 SimpleIndexFile::~SimpleIndexFile() {}
@@ -257,7 +302,7 @@ void SimpleIndexFile::LoadIndexEntries(base::Time cache_last_modified,
   base::Closure task = base::Bind(&SimpleIndexFile::SyncLoadIndexEntries,
                                   cache_type_,
                                   cache_last_modified, cache_directory_,
-                                  index_file_, out_result);
+                                  index_file_, journal_file_, out_result);
   worker_pool_->PostTaskAndReply(FROM_HERE, task, callback);
 }
 
@@ -273,21 +318,40 @@ void SimpleIndexFile::WriteToDisk(const SimpleIndex::EntrySet& entry_set,
       cache_directory_,
       index_file_,
       temp_index_file_,
+      journal_file_,
       base::Passed(&pickle),
       base::TimeTicks::Now(),
       app_on_background));
 }
 
+void SimpleIndexFile::AppendToJournal(
+    const SimpleIndex::EntrySet& entry_set,
+    const SimpleIndex::HashList& changed_hashes,
+    const base::TimeTicks& start,
+    bool app_on_background) {
+  scoped_ptr<Pickle> pickle = SerializeJournal(entry_set, changed_hashes);
+  cache_thread_->PostTask(FROM_HERE, base::Bind(
+      &SimpleIndexFile::SyncAppendToJournal,
+      cache_type_,
+      cache_directory_,
+      journal_file_,
+      base::Passed(&pickle),
+      base::TimeTicks::Now()));
+}
+
 // static
 void SimpleIndexFile::SyncLoadIndexEntries(
     net::CacheType cache_type,
     base::Time cache_last_modified,
     const base::FilePath& cache_directory,
     const base::FilePath& index_file_path,
+    const base::FilePath& journal_file_path,
     SimpleIndexLoadResult* out_result) {
   // Load the index and find its age.
   base::Time last_cache_seen_by_index;
   SyncLoadFromDisk(index_file_path, &last_cache_seen_by_index, out_result);
+  if (out_result->did_load)
+    SyncLoadJournal(journal_file_path, &last_cache_seen_by_index, out_result);
 
   // Consider the index loaded if it is fresh.
   const bool index_file_existed = base::PathExists(index_file_path);
@@ -311,6 +375,7 @@ void SimpleIndexFile::SyncLoadIndexEntries(
   }
 
   // Reconstruct the index by scanning the disk for entries.
+  base::DeleteFile(journal_file_path, /* recursive = */ false);
   const base::TimeTicks start = base::TimeTicks::Now();
   SyncRestoreFromDisk(cache_directory, index_file_path, out_result);
   SIMPLE_CACHE_UMA(MEDIUM_TIMES, "IndexRestoreTime", cache_type,
@@ -402,10 +467,7 @@ void SimpleIndexFile::Deserialize(const char* data, int data_len,
     return;
   }
 
-#if !defined(OS_WIN)
-  // TODO(gavinp): Consider using std::unordered_map.
-  entries->resize(index_metadata.GetNumberOfEntries() + kExtraSizeForMerge);
-#endif
+  entries->reserve(index_metadata.GetNumberOfEntries() + kExtraSizeForMerge);
   while (entries->size() < index_metadata.GetNumberOfEntries()) {
     uint64 hash_key;
     EntryMetadata entry_metadata;
@@ -429,6 +491,122 @@ void SimpleIndexFile::Deserialize(const char* data, int data_len,
   out_result->did_load = true;
 }
 
+// static
+scoped_ptr<Pickle> SimpleIndexFile::SerializeJournal(
+    const SimpleIndex::EntrySet& entries,
+    const SimpleIndex::HashList& changed_hashes) {
+  scoped_ptr<Pickle> pickle(new Pickle(sizeof(SimpleIndexFile::PickleHeader)));
+
+  pickle->WriteUInt64(kSimpleIndexJournalMagicNumber);
+  pickle->WriteUInt32(kSimpleVersion);
+  pickle->WriteUInt64(changed_hashes.size());
+  for (SimpleIndex::HashList::const_iterator it = changed_hashes.begin();
+       it != changed_hashes.end(); ++it) {
+    SimpleIndex::EntrySet::const_iterator entry = entries.find(*it);
+    const bool present = entry != entries.end();
+    pickle->WriteUInt64(*it);
+    pickle->WriteBool(present);
+    if (present)
+      entry->second.Serialize(pickle.get());
+  }
+  return pickle.Pass();
+}
+
+// static
+int SimpleIndexFile::DeserializeJournal(const char* data, int data_len,
+                                        base::Time* out_cache_last_modified,
+                                        SimpleIndex::EntrySet* entries) {
+  DCHECK(data);
+  DCHECK(out_cache_last_modified);
+
+  int blocks_applied = 0;
+  const char* const data_end = data + data_len;
+  while (data < data_end) {
+    const char* block_end = Pickle::FindNext(
+        sizeof(SimpleIndexFile::PickleHeader), data, data_end);
+    if (!block_end) {
+      LOG(WARNING) << "Truncated block in Simple Index journal.";
+      break;
+    }
+
+    Pickle pickle(data, block_end - data);
+    data = block_end;
+    SimpleIndexFile::PickleHeader* header_p =
+        pickle.headerT<SimpleIndexFile::PickleHeader>();
+    if (header_p->crc != CalculatePickleCRC(pickle)) {
+      LOG(WARNING) << "Invalid CRC in Simple Index journal.";
+      break;
+    }
+
+    // The CRC matched, so anything unexpected past this point means the
+    // writer disagrees about the format; stop rather than guess.
+    PickleIterator pickle_it(pickle);
+    uint64 magic_number;
+    uint32 version;
+    uint64 record_count;
+    if (!pickle_it.ReadUInt64(&magic_number) ||
+        magic_number != kSimpleIndexJournalMagicNumber ||
+        !pickle_it.ReadUInt32(&version) || version != kSimpleVersion ||
+        !pickle_it.ReadUInt64(&record_count)) {
+      LOG(WARNING) << "Invalid header in Simple Index journal.";
+      break;
+    }
+
+    bool block_is_valid = true;
+    for (uint64 i = 0; i < record_count; ++i) {
+      uint64 hash_key;
+      bool present;
+      if (!pickle_it.ReadUInt64(&hash_key) || !pickle_it.ReadBool(&present)) {
+        block_is_valid = false;
+        break;
+      }
+      if (!present) {
+        entries->erase(hash_key);
+        continue;
+      }
+      EntryMetadata entry_metadata;
+      if (!entry_metadata.Deserialize(&pickle_it)) {
+        block_is_valid = false;
+        break;
+      }
+      std::pair<SimpleIndex::EntrySet::iterator, bool> insert_result =
+          entries->insert(
+              SimpleIndex::EntrySet::value_type(hash_key, entry_metadata));
+      insert_result.first->second = entry_metadata;
+    }
+
+    int64 cache_last_modified;
+    if (!block_is_valid || !pickle_it.ReadInt64(&cache_last_modified)) {
+      LOG(WARNING) << "Invalid record in Simple Index journal.";
+      break;
+    }
+    *out_cache_last_modified =
+        base::Time::FromInternalValue(cache_last_modified);
+    ++blocks_applied;
+  }
+  return blocks_applied;
+}
+
+// static
+void SimpleIndexFile::SyncLoadJournal(
+    const base::FilePath& journal_filename,
+    base::Time* out_last_cache_seen_by_index,
+    SimpleIndexLoadResult* out_result) {
+  if (!base::PathExists(journal_filename))
+    return;
+
+  base::MemoryMappedFile journal_file_map;
+  if (!journal_file_map.Initialize(journal_filename)) {
+    LOG(WARNING) << "Could not map Simple Index journal.";
+    return;
+  }
+
+  DeserializeJournal(reinterpret_cast<const char*>(journal_file_map.data()),
+                     journal_file_map.length(),
+                     out_last_cache_seen_by_index,
+                     &out_result->entries);
+}
+
 // static
 void SimpleIndexFile::SyncRestoreFromDisk(
     const base::FilePath& cache_directory,
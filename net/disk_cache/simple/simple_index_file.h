@@ -28,6 +28,7 @@ class TaskRunner;
 namespace disk_cache {
 
 const uint64 kSimpleIndexMagicNumber = GG_UINT64_C(0x656e74657220796f);
+const uint64 kSimpleIndexJournalMagicNumber = GG_UINT64_C(0x6a6f75726e616c21);
 
 struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
   SimpleIndexLoadResult();
@@ -46,6 +47,16 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
 // see SimpleIndexFile::Serialize() and SeeSimpleIndexFile::LoadFromDisk()
 // methods.
 //
+// Between full writes, changes are appended to a journal file next to the
+// index, so that a flush costs O(changes) rather than O(entries). The journal
+// is a sequence of pickles, each holding the changed entries (an entry hash
+// followed by its metadata, or by nothing if it was removed) and the cache
+// directory mtime at the time of the append, protected by a CRC. On load the
+// journal is replayed on top of the index up to the first damaged block, and
+// the mtime of the last good block decides whether the result is fresh. A
+// full write deletes the journal before the new index is renamed into place,
+// so a journal is never replayed over an index it was not written against.
+//
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
 // or in worker threads. Synchronization between methods is the
@@ -91,6 +102,13 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                            const base::TimeTicks& start,
                            bool app_on_background);
 
+  // Appends the current state of the entries in |changed_hashes| to the
+  // journal. Hashes not present in |entry_set| are recorded as removed.
+  virtual void AppendToJournal(const SimpleIndex::EntrySet& entry_set,
+                               const SimpleIndex::HashList& changed_hashes,
+                               const base::TimeTicks& start,
+                               bool app_on_background);
+
  private:
   friend class WrappedSimpleIndexFile;
 
@@ -106,6 +124,7 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                                    base::Time cache_last_modified,
                                    const base::FilePath& cache_directory,
                                    const base::FilePath& index_file_path,
+                                   const base::FilePath& journal_file_path,
                                    SimpleIndexLoadResult* out_result);
 
   // Load the index file from disk returning an EntrySet.
@@ -133,6 +152,25 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                           base::Time* out_cache_last_modified,
                           SimpleIndexLoadResult* out_result);
 
+  // Returns a newly allocated Pickle holding a journal block for the entries
+  // in |changed_hashes|. Like Serialize(), the result must be finished with
+  // SerializeFinalData() before it is written.
+  static scoped_ptr<Pickle> SerializeJournal(
+      const SimpleIndex::EntrySet& entries,
+      const SimpleIndex::HashList& changed_hashes);
+
+  // Replays the journal blocks in |data| onto |entries|, stopping at the first
+  // block that is truncated or fails its CRC. Sets |out_cache_last_modified|
+  // from the last block applied and returns the number of blocks applied.
+  static int DeserializeJournal(const char* data, int data_len,
+                                base::Time* out_cache_last_modified,
+                                SimpleIndex::EntrySet* entries);
+
+  // Replays the journal file, if any, onto a freshly loaded index.
+  static void SyncLoadJournal(const base::FilePath& journal_filename,
+                              base::Time* out_last_cache_seen_by_index,
+                              SimpleIndexLoadResult* out_result);
+
   // Implemented either in simple_index_file_posix.cc or
   // simple_index_file_win.cc. base::FileEnumerator turned out to be very
   // expensive in terms of memory usage therefore it's used only on non-POSIX
@@ -142,15 +180,23 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
       const base::FilePath& cache_path,
       const EntryFileCallback& entry_file_callback);
 
-  // Writes the index file to disk atomically.
+  // Writes the index file to disk atomically, discarding the journal.
   static void SyncWriteToDisk(net::CacheType cache_type,
                               const base::FilePath& cache_directory,
                               const base::FilePath& index_filename,
                               const base::FilePath& temp_index_filename,
+                              const base::FilePath& journal_filename,
                               scoped_ptr<Pickle> pickle,
                               const base::TimeTicks& start_time,
                               bool app_on_background);
 
+  // Appends one journal block to the journal file.
+  static void SyncAppendToJournal(net::CacheType cache_type,
+                                  const base::FilePath& cache_directory,
+                                  const base::FilePath& journal_filename,
+                                  scoped_ptr<Pickle> pickle,
+                                  const base::TimeTicks& start_time);
+
   // Scan the index directory for entries, returning an EntrySet of all entries
   // found.
   static void SyncRestoreFromDisk(const base::FilePath& cache_directory,
@@ -174,10 +220,12 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
   const base::FilePath cache_directory_;
   const base::FilePath index_file_;
   const base::FilePath temp_index_file_;
+  const base::FilePath journal_file_;
 
   static const char kIndexDirectory[];
   static const char kIndexFileName[];
   static const char kTempIndexFileName[];
+  static const char kJournalFileName[];
 
   DISALLOW_COPY_AND_ASSIGN(SimpleIndexFile);
 };
@@ -69,9 +69,11 @@ TEST(IndexMetadataTest, Serialize) {
 class WrappedSimpleIndexFile : public SimpleIndexFile {
  public:
   using SimpleIndexFile::Deserialize;
+  using SimpleIndexFile::DeserializeJournal;
   using SimpleIndexFile::LegacyIsIndexFileStale;
   using SimpleIndexFile::Serialize;
   using SimpleIndexFile::SerializeFinalData;
+  using SimpleIndexFile::SerializeJournal;
 
   explicit WrappedSimpleIndexFile(const base::FilePath& index_file_directory)
       : SimpleIndexFile(base::MessageLoopProxy::current().get(),
@@ -155,6 +157,52 @@ TEST_F(SimpleIndexFileTest, Serialize) {
   }
 }
 
+TEST_F(SimpleIndexFileTest, ReplayJournal) {
+  SimpleIndex::EntrySet entries;
+  SimpleIndex::InsertInEntrySet(11, EntryMetadata(Time(), 11), &entries);
+  SimpleIndex::InsertInEntrySet(22, EntryMetadata(Time(), 22), &entries);
+  SimpleIndex::EntrySet loaded_entries = entries;
+
+  // First block: 11 is removed and 22 grows.
+  entries.erase(11);
+  entries.find(22)->second.SetEntrySize(2222);
+  SimpleIndex::HashList changed;
+  changed.push_back(11);
+  changed.push_back(22);
+  scoped_ptr<Pickle> first = WrappedSimpleIndexFile::SerializeJournal(
+      entries, changed);
+  const base::Time first_mtime = Time::Now();
+  EXPECT_TRUE(WrappedSimpleIndexFile::SerializeFinalData(first_mtime,
+                                                         first.get()));
+
+  // Second block: 33 is added.
+  SimpleIndex::InsertInEntrySet(33, EntryMetadata(Time(), 33), &entries);
+  changed.clear();
+  changed.push_back(33);
+  scoped_ptr<Pickle> second = WrappedSimpleIndexFile::SerializeJournal(
+      entries, changed);
+  const base::Time second_mtime = first_mtime + base::TimeDelta::FromSeconds(1);
+  EXPECT_TRUE(WrappedSimpleIndexFile::SerializeFinalData(second_mtime,
+                                                         second.get()));
+
+  std::string journal(static_cast<const char*>(first->data()), first->size());
+  journal.append(static_cast<const char*>(second->data()), second->size());
+  // A torn third block must be ignored.
+  journal.append(static_cast<const char*>(second->data()),
+                 second->size() / 2);
+
+  base::Time last_mtime;
+  EXPECT_EQ(2, WrappedSimpleIndexFile::DeserializeJournal(
+      journal.data(), journal.size(), &last_mtime, &loaded_entries));
+  EXPECT_EQ(second_mtime, last_mtime);
+  EXPECT_EQ(2u, loaded_entries.size());
+  EXPECT_EQ(0u, loaded_entries.count(11));
+  ASSERT_EQ(1u, loaded_entries.count(22));
+  EXPECT_EQ(2222, loaded_entries.find(22)->second.GetEntrySize());
+  ASSERT_EQ(1u, loaded_entries.count(33));
+  EXPECT_EQ(33, loaded_entries.find(33)->second.GetEntrySize());
+}
+
 TEST_F(SimpleIndexFileTest, LegacyIsIndexFileStale) {
   base::ScopedTempDir cache_dir;
   ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
 
 #include "base/files/scoped_temp_dir.h"
 #include "base/hash.h"
@@ -55,7 +56,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
       : SimpleIndexFile(NULL, NULL, net::DISK_CACHE, base::FilePath()),
         load_result_(NULL),
         load_index_entries_calls_(0),
-        disk_writes_(0) {}
+        disk_writes_(0),
+        journal_appends_(0) {}
 
   virtual void LoadIndexEntries(
       base::Time cache_last_modified,
@@ -74,6 +76,14 @@ class MockSimpleIndexFile : public SimpleIndexFile,
     disk_write_entry_set_ = entry_set;
   }
 
+  virtual void AppendToJournal(const SimpleIndex::EntrySet& entry_set,
+                               const SimpleIndex::HashList& changed_hashes,
+                               const base::TimeTicks& start,
+                               bool app_on_background) OVERRIDE {
+    journal_appends_++;
+    journal_changed_hashes_ = changed_hashes;
+  }
+
   void GetAndResetDiskWriteEntrySet(SimpleIndex::EntrySet* entry_set) {
     entry_set->swap(disk_write_entry_set_);
   }
@@ -82,6 +92,10 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   SimpleIndexLoadResult* load_result() const { return load_result_; }
   int load_index_entries_calls() const { return load_index_entries_calls_; }
   int disk_writes() const { return disk_writes_; }
+  int journal_appends() const { return journal_appends_; }
+  const SimpleIndex::HashList& journal_changed_hashes() const {
+    return journal_changed_hashes_;
+  }
 
  private:
   base::Closure load_callback_;
@@ -89,6 +103,8 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   int load_index_entries_calls_;
   int disk_writes_;
   SimpleIndex::EntrySet disk_write_entry_set_;
+  int journal_appends_;
+  SimpleIndex::HashList journal_changed_hashes_;
 };
 
 class SimpleIndexTest  : public testing::Test, public SimpleIndexDelegate {
@@ -197,6 +213,43 @@ TEST_F(EntryMetadataTest, Serialize) {
   CheckEntryMetadataValues(new_entry_metadata);
 }
 
+// Inserts and erases enough colliding and non-colliding hashes to exercise
+// growth and the backward shift on erase, checking against a std::map.
+TEST(SimpleIndexEntrySetTest, MatchesStdMap) {
+  SimpleIndexEntrySet entry_set;
+  std::map<uint64, int> expected;
+  uint64 state = 1;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    // Small keys collide heavily in the low bits; large ones do not.
+    const uint64 hash = (i % 3 == 0) ? (state >> 52) : state;
+    if ((state >> 20) % 3 == 0) {
+      EXPECT_EQ(expected.erase(hash), entry_set.erase(hash));
+    } else {
+      const int size = static_cast<int>(state >> 40);
+      const bool inserted = entry_set.insert(SimpleIndexEntrySet::value_type(
+          hash, EntryMetadata(base::Time(), size))).second;
+      EXPECT_EQ(expected.insert(std::make_pair(hash, size)).second, inserted);
+    }
+  }
+
+  ASSERT_EQ(expected.size(), entry_set.size());
+  for (std::map<uint64, int>::const_iterator it = expected.begin();
+       it != expected.end(); ++it) {
+    SimpleIndexEntrySet::const_iterator found = entry_set.find(it->first);
+    ASSERT_TRUE(found != entry_set.end());
+    EXPECT_EQ(it->second, found->second.GetEntrySize());
+  }
+
+  size_t iterated = 0;
+  for (SimpleIndexEntrySet::const_iterator it = entry_set.begin();
+       it != entry_set.end(); ++it) {
+    EXPECT_EQ(1u, expected.count(it->first));
+    ++iterated;
+  }
+  EXPECT_EQ(expected.size(), iterated);
+}
+
 TEST_F(SimpleIndexTest, IndexSizeCorrectOnMerge) {
   typedef disk_cache::SimpleIndex::EntrySet EntrySet;
   index()->SetMaxSize(100);
@@ -605,6 +658,43 @@ TEST_F(SimpleIndexTest, DiskWriteExecuted) {
   EXPECT_EQ(20, entry1.GetEntrySize());
 }
 
+// After the first full write, later writes only append the entries that
+// changed to the journal.
+TEST_F(SimpleIndexTest, DiskWriteAppendsToJournal) {
+  index()->SetMaxSize(1000);
+  ReturnIndexFile();
+
+  const uint64 kHash1 = hashes_.at<1>();
+  const uint64 kHash2 = hashes_.at<2>();
+  const uint64 kHash3 = hashes_.at<3>();
+  index()->Insert(kHash1);
+  index()->Insert(kHash2);
+  index()->WriteToDisk();
+  EXPECT_EQ(1, index_file_->disk_writes());
+  EXPECT_EQ(0, index_file_->journal_appends());
+
+  index()->UpdateEntrySize(kHash1, 20);
+  index()->Remove(kHash2);
+  index()->Insert(kHash3);
+  index()->WriteToDisk();
+  EXPECT_EQ(1, index_file_->disk_writes());
+  EXPECT_EQ(1, index_file_->journal_appends());
+
+  SimpleIndex::HashList changed = index_file_->journal_changed_hashes();
+  std::sort(changed.begin(), changed.end());
+  SimpleIndex::HashList expected;
+  expected.push_back(kHash1);
+  expected.push_back(kHash2);
+  expected.push_back(kHash3);
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(expected, changed);
+
+  // Nothing changed, but the append still happens to refresh the mtime.
+  index()->WriteToDisk();
+  EXPECT_EQ(2, index_file_->journal_appends());
+  EXPECT_TRUE(index_file_->journal_changed_hashes().empty());
+}
+
 TEST_F(SimpleIndexTest, DiskWritePostponed) {
   index()->SetMaxSize(1000);
   ReturnIndexFile();
@@ -259,6 +259,12 @@ class SimpleSynchronousEntry {
                        bool* out_has_crc32,
                        uint32* out_crc32,
                        int* out_data_size) const;
+
+  // Reads |size| bytes at |offset| in the file at |file_index| into |data|,
+  // from |file_0_prefetch_| when it holds them. Returns the number of bytes
+  // read, or -1 on error.
+  int ReadFromFile(int file_index, int offset, char* data, int size) const;
+
   void Doom() const;
 
   // Opens the sparse data file and scans it if it exists.
@@ -316,6 +322,10 @@ class SimpleSynchronousEntry {
   bool have_open_files_;
   bool initialized_;
 
+  // While a small entry is being opened, the whole of its file 0, so that the
+  // header, key, EOF record and stream 0 all come from a single read.
+  std::string file_0_prefetch_;
+
   base::PlatformFile files_[kSimpleEntryFileCount];
 
   // True if the corresponding stream is empty and therefore no on-disk file
@@ -8,10 +8,25 @@
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 
 namespace net {
 
+namespace {
+
+// Keys of the dictionaries written by GetAsListValue.
+const char kHostnameKey[] = "hostname";
+const char kAddressFamilyKey[] = "address_family";
+const char kFlagsKey[] = "flags";
+const char kExpirationKey[] = "expiration";
+const char kTTLKey[] = "ttl";
+const char kAddressesKey[] = "addresses";
+const char kCanonicalNameKey[] = "canonical_name";
+
+}  // namespace
+
 //-----------------------------------------------------------------------------
 
 HostCache::Entry::Entry(int error, const AddressList& addrlist,
@@ -46,7 +61,35 @@ const HostCache::Entry* HostCache::Lookup(const Key& key,
   if (caching_is_disabled())
     return NULL;
 
-  return entries_.Get(key, now);
+  if (max_staleness_ == base::TimeDelta())
+    return entries_.Get(key, now);
+
+  bool is_stale = false;
+  const Entry* entry = LookupStale(key, now, &is_stale);
+  return is_stale ? NULL : entry;
+}
+
+const HostCache::Entry* HostCache::LookupStale(const Key& key,
+                                               base::TimeTicks now,
+                                               bool* is_stale) {
+  DCHECK(CalledOnValidThread());
+  *is_stale = false;
+  if (caching_is_disabled())
+    return NULL;
+
+  base::TimeTicks expiration;
+  const Entry* entry = entries_.GetIncludingExpired(key, &expiration);
+  if (!entry)
+    return NULL;
+  if (now < expiration)
+    return entry;
+  if (now - expiration > max_staleness_) {
+    // Let the cache remove the entry.
+    return entries_.Get(key, now);
+  }
+
+  *is_stale = true;
+  return entry;
 }
 
 void HostCache::Set(const Key& key,
@@ -65,6 +108,103 @@ void HostCache::clear() {
   entries_.Clear();
 }
 
+void HostCache::GetAsListValue(const std::set<std::string>* hostnames,
+                               base::ListValue* entry_list) const {
+  DCHECK(CalledOnValidThread());
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::Time wall_now = base::Time::Now();
+
+  for (EntryMap::Iterator it(entries_); it.HasNext(); it.Advance()) {
+    const Key& key = it.key();
+    const Entry& entry = it.value();
+    // Failures are cached only briefly, and aren't worth keeping.
+    if (entry.error != OK)
+      continue;
+    if (hostnames && hostnames->find(key.hostname) == hostnames->end())
+      continue;
+
+    base::DictionaryValue* entry_dict = new base::DictionaryValue();
+    entry_dict->SetString(kHostnameKey, key.hostname);
+    entry_dict->SetInteger(kAddressFamilyKey, key.address_family);
+    entry_dict->SetInteger(kFlagsKey, key.host_resolver_flags);
+    entry_dict->SetDouble(kExpirationKey,
+                          (wall_now + (it.expiration() - now)).ToDoubleT());
+    if (entry.has_ttl())
+      entry_dict->SetInteger(kTTLKey, entry.ttl.InSeconds());
+
+    base::ListValue* addresses = new base::ListValue();
+    for (size_t i = 0; i < entry.addrlist.size(); ++i)
+      addresses->AppendString(entry.addrlist[i].ToStringWithoutPort());
+    entry_dict->Set(kAddressesKey, addresses);
+    entry_dict->SetString(kCanonicalNameKey, entry.addrlist.canonical_name());
+
+    entry_list->Append(entry_dict);
+  }
+}
+
+bool HostCache::RestoreFromListValue(const base::ListValue& entry_list) {
+  DCHECK(CalledOnValidThread());
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::Time wall_now = base::Time::Now();
+
+  bool success = true;
+  for (size_t i = 0; i < entry_list.GetSize(); ++i) {
+    const base::DictionaryValue* entry_dict = NULL;
+    std::string hostname;
+    int address_family = 0;
+    int flags = 0;
+    double expiration = 0;
+    const base::ListValue* addresses = NULL;
+    if (!entry_list.GetDictionary(i, &entry_dict) ||
+        !entry_dict->GetString(kHostnameKey, &hostname) ||
+        !entry_dict->GetInteger(kAddressFamilyKey, &address_family) ||
+        !entry_dict->GetInteger(kFlagsKey, &flags) ||
+        !entry_dict->GetDouble(kExpirationKey, &expiration) ||
+        !entry_dict->GetList(kAddressesKey, &addresses) ||
+        address_family < ADDRESS_FAMILY_UNSPECIFIED ||
+        address_family > ADDRESS_FAMILY_IPV6) {
+      success = false;
+      continue;
+    }
+
+    AddressList addrlist;
+    for (size_t j = 0; j < addresses->GetSize(); ++j) {
+      std::string address_string;
+      IPAddressNumber address;
+      if (!addresses->GetString(j, &address_string) ||
+          !ParseIPLiteralToNumber(address_string, &address)) {
+        success = false;
+        addrlist.clear();
+        break;
+      }
+      addrlist.push_back(IPEndPoint(address, 0));
+    }
+    if (addrlist.empty())
+      continue;
+    std::string canonical_name;
+    if (entry_dict->GetString(kCanonicalNameKey, &canonical_name))
+      addrlist.set_canonical_name(canonical_name);
+
+    Key key(hostname, static_cast<AddressFamily>(address_family), flags);
+    base::TimeTicks existing_expiration;
+    if (entries_.GetIncludingExpired(key, &existing_expiration))
+      continue;
+
+    base::TimeDelta ttl = base::Time::FromDoubleT(expiration) - wall_now;
+    if (ttl <= base::TimeDelta() && -ttl > max_staleness_)
+      continue;
+
+    int entry_ttl = 0;
+    if (entry_dict->GetInteger(kTTLKey, &entry_ttl) && entry_ttl >= 0) {
+      Set(key, Entry(OK, addrlist, base::TimeDelta::FromSeconds(entry_ttl)),
+          now, ttl);
+    } else {
+      Set(key, Entry(OK, addrlist), now, ttl);
+    }
+  }
+  return success;
+}
+
 size_t HostCache::size() const {
   DCHECK(CalledOnValidThread());
   return entries_.size();
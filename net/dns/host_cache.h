@@ -6,6 +6,7 @@
 #define NET_DNS_HOST_CACHE_H_
 
 #include <functional>
+#include <set>
 #include <string>
 
 #include "base/gtest_prod_util.h"
@@ -17,6 +18,10 @@
 #include "net/base/expiring_cache.h"
 #include "net/base/net_export.h"
 
+namespace base {
+class ListValue;
+}
+
 namespace net {
 
 // Cache used by HostResolver to map hostnames to their resolved result.
@@ -82,6 +87,12 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // |now|. If there is no such entry, returns NULL.
   const Entry* Lookup(const Key& key, base::TimeTicks now);
 
+  // Like Lookup, but also returns an entry which expired no more than
+  // max_staleness() before |now|, in which case |*is_stale| is set to true.
+  const Entry* LookupStale(const Key& key,
+                           base::TimeTicks now,
+                           bool* is_stale);
+
   // Overwrites or creates an entry for |key|.
   // |entry| is the value to set, |now| is the current time
   // |ttl| is the "time to live".
@@ -93,6 +104,26 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // Empties the cache
   void clear();
 
+  // Appends the successful entries to |entry_list|, in a form which can be
+  // saved to disk and given to RestoreFromListValue, possibly by a later
+  // instance of the browser. Expirations are stored as wall clock times. If
+  // |hostnames| is non-NULL, only the entries for those hostnames are added.
+  void GetAsListValue(const std::set<std::string>* hostnames,
+                      base::ListValue* entry_list) const;
+
+  // Adds the entries in |entry_list|, as written by GetAsListValue, which
+  // are not already in the cache. Entries which have expired are kept as
+  // stale entries if max_staleness() allows it. Returns false if any of the
+  // entries could not be parsed.
+  bool RestoreFromListValue(const base::ListValue& entry_list);
+
+  // Controls how long entries are kept after they expire, so that
+  // LookupStale can return them. Zero, the default, removes them.
+  void set_max_staleness(base::TimeDelta max_staleness) {
+    max_staleness_ = max_staleness;
+  }
+  base::TimeDelta max_staleness() const { return max_staleness_; }
+
   // Returns the number of entries in the cache.
   size_t size() const;
 
@@ -116,6 +147,8 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // a resolved result entry.
   EntryMap entries_;
 
+  base::TimeDelta max_staleness_;
+
   DISALLOW_COPY_AND_ASSIGN(HostCache);
 };
 
@@ -8,7 +8,9 @@
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace net {
@@ -296,6 +298,126 @@ TEST(HostCacheTest, Clear) {
   EXPECT_EQ(0u, cache.size());
 }
 
+// Tests that expired entries are kept for max_staleness(), during which only
+// LookupStale returns them.
+TEST(HostCacheTest, Stale) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  HostCache cache(kMaxCacheEntries);
+  cache.set_max_staleness(base::TimeDelta::FromSeconds(30));
+
+  // Start at t=0.
+  base::TimeTicks now;
+
+  HostCache::Key key1 = Key("foobar.com");
+  HostCache::Entry entry = HostCache::Entry(OK, AddressList());
+
+  bool is_stale = true;
+  cache.Set(key1, entry, now, kTTL);
+  EXPECT_TRUE(cache.Lookup(key1, now));
+  EXPECT_TRUE(cache.LookupStale(key1, now, &is_stale));
+  EXPECT_FALSE(is_stale);
+
+  // Advance to t=10; the entry is now stale.
+  now += base::TimeDelta::FromSeconds(10);
+  EXPECT_FALSE(cache.Lookup(key1, now));
+  EXPECT_TRUE(cache.LookupStale(key1, now, &is_stale));
+  EXPECT_TRUE(is_stale);
+  EXPECT_EQ(1U, cache.size());
+
+  // Advance to t=40; the entry is still kept.
+  now += base::TimeDelta::FromSeconds(30);
+  EXPECT_TRUE(cache.LookupStale(key1, now, &is_stale));
+  EXPECT_TRUE(is_stale);
+
+  // Advance to t=41; the entry is too old to use.
+  now += base::TimeDelta::FromSeconds(1);
+  EXPECT_FALSE(cache.LookupStale(key1, now, &is_stale));
+  EXPECT_FALSE(is_stale);
+  EXPECT_EQ(0U, cache.size());
+}
+
+// Tests that successful entries survive a round trip through a ListValue, and
+// that restoring doesn't replace entries which are already cached.
+TEST(HostCacheTest, PersistEntries) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(600);
+
+  IPAddressNumber address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("192.168.1.1", &address));
+  AddressList addrlist = AddressList::CreateFromIPAddress(address, 80);
+  addrlist.set_canonical_name("canonical.foobar.com");
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  HostCache cache(kMaxCacheEntries);
+  cache.Set(Key("foobar.com"), HostCache::Entry(OK, addrlist, kTTL), now,
+            kTTL);
+  cache.Set(Key("failed.com"), HostCache::Entry(ERR_NAME_NOT_RESOLVED,
+                                                AddressList()),
+            now, kTTL);
+
+  base::ListValue entry_list;
+  cache.GetAsListValue(NULL, &entry_list);
+  // Failures are not saved.
+  EXPECT_EQ(1U, entry_list.GetSize());
+
+  HostCache restored_cache(kMaxCacheEntries);
+  restored_cache.Set(Key("other.com"), HostCache::Entry(OK, AddressList()),
+                     now, kTTL);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(entry_list));
+  EXPECT_EQ(2U, restored_cache.size());
+
+  const HostCache::Entry* entry =
+      restored_cache.Lookup(Key("foobar.com"), base::TimeTicks::Now());
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(OK, entry->error);
+  EXPECT_EQ(kTTL, entry->ttl);
+  ASSERT_EQ(1U, entry->addrlist.size());
+  EXPECT_EQ(address, entry->addrlist[0].address());
+  EXPECT_EQ("canonical.foobar.com", entry->addrlist.canonical_name());
+
+  // The entry should expire about when the original one does.
+  EXPECT_FALSE(restored_cache.Lookup(
+      Key("foobar.com"), now + kTTL + base::TimeDelta::FromMinutes(1)));
+
+  // Malformed entries are skipped.
+  base::ListValue bad_list;
+  bad_list.AppendString("foobar.com");
+  HostCache bad_cache(kMaxCacheEntries);
+  EXPECT_FALSE(bad_cache.RestoreFromListValue(bad_list));
+  EXPECT_EQ(0U, bad_cache.size());
+}
+
+// Tests that only the entries for the given hostnames are saved when a filter
+// is passed.
+TEST(HostCacheTest, PersistSelectedEntries) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(600);
+
+  IPAddressNumber address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("192.168.1.1", &address));
+  AddressList addrlist = AddressList::CreateFromIPAddress(address, 80);
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  HostCache cache(kMaxCacheEntries);
+  cache.Set(Key("foobar.com"), HostCache::Entry(OK, addrlist), now, kTTL);
+  cache.Set(Key("foobar2.com"), HostCache::Entry(OK, addrlist), now, kTTL);
+  cache.Set(Key("foobar3.com"), HostCache::Entry(OK, addrlist), now, kTTL);
+
+  std::set<std::string> hostnames;
+  hostnames.insert("foobar.com");
+  hostnames.insert("foobar3.com");
+  hostnames.insert("notcached.com");
+  base::ListValue entry_list;
+  cache.GetAsListValue(&hostnames, &entry_list);
+  EXPECT_EQ(2U, entry_list.GetSize());
+
+  HostCache restored_cache(kMaxCacheEntries);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(entry_list));
+  EXPECT_EQ(2U, restored_cache.size());
+  EXPECT_TRUE(restored_cache.Lookup(Key("foobar.com"), now));
+  EXPECT_FALSE(restored_cache.Lookup(Key("foobar2.com"), now));
+  EXPECT_TRUE(restored_cache.Lookup(Key("foobar3.com"), now));
+}
+
 // Tests the less than and equal operators for HostCache::Key work.
 TEST(HostCacheTest, KeyComparators) {
   struct {
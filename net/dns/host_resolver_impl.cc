@@ -1203,6 +1203,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
       : resolver_(resolver),
         key_(key),
         priority_tracker_(priority),
+        is_stale_refresh_(false),
         had_non_speculative_request_(false),
         had_dns_config_(false),
         num_occupied_job_slots_(0),
@@ -1299,8 +1300,15 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
     UpdatePriority();
   }
 
+  // Makes this Job update the cache with a successful result even if it has
+  // no Requests, to refresh a stale cache entry which has already been served.
+  void set_is_stale_refresh() {
+    is_stale_refresh_ = true;
+  }
+
   // Marks |req| as cancelled. If it was the last active Request, also finishes
-  // this Job, marking it as cancelled, and deletes it.
+  // this Job, marking it as cancelled, and deletes it, unless it is refreshing
+  // a stale cache entry.
   void CancelRequest(Request* req) {
     DCHECK_EQ(key_.hostname, req->info().hostname());
     DCHECK(!req->was_canceled());
@@ -1316,7 +1324,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
                                  req->request_net_log().source(),
                                  priority()));
 
-    if (num_active_requests() > 0) {
+    if (num_active_requests() > 0 || is_stale_refresh_) {
       UpdatePriority();
     } else {
       // If we were called from a Request's callback within CompleteRequests,
@@ -1358,7 +1366,11 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // Attempts to serve the job from HOSTS. Returns true if succeeded and
   // this Job was destroyed.
   bool ServeFromHosts() {
-    DCHECK_GT(num_active_requests(), 0u);
+    if (num_active_requests() == 0) {
+      // A stale refresh has no Request to take the port from; let it run.
+      DCHECK(is_stale_refresh_);
+      return false;
+    }
     AddressList addr_list;
     if (resolver_->ServeFromHosts(key(),
                                   requests_.front()->info(),
@@ -1665,7 +1677,18 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
       handle_.Reset();
     }
 
+    bool did_complete = (entry.error != ERR_NETWORK_CHANGED) &&
+                        (entry.error != ERR_HOST_RESOLVER_QUEUE_TOO_LARGE);
+
     if (num_active_requests() == 0) {
+      // A failed refresh leaves the stale entry in place, which is better
+      // than nothing on an unreliable network.
+      if (is_stale_refresh_ && did_complete && entry.error == OK) {
+        net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
+                                          entry.error);
+        resolver_->CacheResult(key_, entry, ttl);
+        return;
+      }
       net_log_.AddEvent(NetLog::TYPE_CANCELLED);
       net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HOST_RESOLVER_IMPL_JOB,
                                         OK);
@@ -1684,8 +1707,6 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
                             resolver_->received_dns_config_);
     }
 
-    bool did_complete = (entry.error != ERR_NETWORK_CHANGED) &&
-                        (entry.error != ERR_HOST_RESOLVER_QUEUE_TOO_LARGE);
     if (did_complete)
       resolver_->CacheResult(key_, entry, ttl);
 
@@ -1745,6 +1766,9 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // Tracks the highest priority across |requests_|.
   PriorityTracker priority_tracker_;
 
+  // True if this Job was started to refresh a stale cache entry.
+  bool is_stale_refresh_;
+
   bool had_non_speculative_request_;
 
   // Distinguishes measurements taken while DnsClient was fully configured.
@@ -1889,6 +1913,15 @@ int HostResolverImpl::Resolve(const RequestInfo& info,
     return rv;
   }
 
+  if (ServeStaleFromCache(key, info, addresses)) {
+    request_net_log.AddEvent(NetLog::TYPE_HOST_RESOLVER_IMPL_STALE_CACHE_HIT);
+    LogFinishRequest(source_net_log, request_net_log, info, OK);
+    RecordTotalTime(HaveDnsConfig(), info.is_speculative(), base::TimeDelta());
+    if (jobs_.find(key) == jobs_.end())
+      StartStaleRefreshJob(key, request_net_log);
+    return OK;
+  }
+
   // Next we need to attach our request to a "job". This job is responsible for
   // calling "getaddrinfo(hostname)" on a worker thread.
 
@@ -2070,6 +2103,46 @@ bool HostResolverImpl::ServeFromCache(const Key& key,
   return true;
 }
 
+bool HostResolverImpl::ServeStaleFromCache(const Key& key,
+                                           const RequestInfo& info,
+                                           AddressList* addresses) {
+  DCHECK(addresses);
+  if (!info.allow_cached_response() || !cache_.get())
+    return false;
+
+  bool is_stale = false;
+  const HostCache::Entry* cache_entry = cache_->LookupStale(
+      key, base::TimeTicks::Now(), &is_stale);
+  // Fresh entries were already tried by ServeFromCache. Only addresses are
+  // worth serving stale; a stale failure is simply retried.
+  if (!cache_entry || !is_stale || cache_entry->error != OK)
+    return false;
+
+  *addresses = EnsurePortOnAddressList(cache_entry->addrlist, info.port());
+  return true;
+}
+
+void HostResolverImpl::StartStaleRefreshJob(
+    const Key& key,
+    const BoundNetLog& request_net_log) {
+  DCHECK(jobs_.find(key) == jobs_.end());
+  // The entry has already been served, so the refresh waits for idle slots.
+  Job* job = new Job(weak_ptr_factory_.GetWeakPtr(), key, MINIMUM_PRIORITY,
+                     request_net_log);
+  job->set_is_stale_refresh();
+  job->Schedule(false);
+
+  // Check for queue overflow.
+  if (dispatcher_.num_queued_jobs() > max_queued_jobs_) {
+    Job* evicted = static_cast<Job*>(dispatcher_.EvictOldestLowest());
+    DCHECK(evicted);
+    evicted->OnEvicted();  // Deletes |evicted|.
+    if (evicted == job)
+      return;
+  }
+  jobs_.insert(std::make_pair(key, job));
+}
+
 bool HostResolverImpl::ServeFromHosts(const Key& key,
                                       const RequestInfo& info,
                                       AddressList* addresses) {
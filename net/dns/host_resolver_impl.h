@@ -185,6 +185,17 @@ class NET_EXPORT HostResolverImpl
                       int* net_error,
                       AddressList* addresses);
 
+  // If the cache holds addresses for |key| which have expired, but recently
+  // enough to be kept (see HostCache::set_max_staleness()), returns true and
+  // fills |addresses|. Otherwise returns false.
+  bool ServeStaleFromCache(const Key& key,
+                           const RequestInfo& info,
+                           AddressList* addresses);
+
+  // Starts a Job with no Requests to replace the stale cache entry for |key|.
+  void StartStaleRefreshJob(const Key& key,
+                            const BoundNetLog& request_net_log);
+
   // If we have a DnsClient with a valid DnsConfig, and |key| is found in the
   // HOSTS file, returns true and fills |addresses|. Otherwise returns false.
   bool ServeFromHosts(const Key& key,
@@ -1217,6 +1217,52 @@ TEST_F(HostResolverImplTest, ResolveFromCache) {
   EXPECT_TRUE(requests_[2]->HasOneAddress("192.168.1.42", 80));
 }
 
+// Test that an expired entry is served at once when the cache keeps stale
+// entries, and that it is refreshed in the background.
+TEST_F(HostResolverImplTest, ServeStaleWhileRefreshing) {
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(1u);
+
+  HostCache* cache = resolver_->GetHostCache();
+  cache->set_max_staleness(base::TimeDelta::FromHours(1));
+
+  Request* req = CreateRequest("just.testing", 80);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  EXPECT_EQ(OK, req->WaitForResult());
+
+  // Expire the cached entry, and change the answer.
+  ASSERT_EQ(1u, cache->size());
+  HostCache::EntryMap::Iterator it(cache->entries());
+  const HostCache::Key key = it.key();
+  const HostCache::Entry entry = it.value();
+  cache->Set(key, entry, base::TimeTicks::Now(),
+             base::TimeDelta::FromSeconds(-1));
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.43");
+
+  // The stale entry is served synchronously, but not from the fresh cache.
+  req = CreateRequest("just.testing", 81);
+  EXPECT_EQ(ERR_DNS_CACHE_MISS, req->ResolveFromCache());
+  req = CreateRequest("just.testing", 81);
+  EXPECT_EQ(OK, req->Resolve());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.42", 81));
+
+  // A refresh was started; a request which bypasses the cache joins it.
+  EXPECT_TRUE(proc_->WaitFor(1u));
+  HostResolver::RequestInfo info(HostPortPair("just.testing", 82));
+  info.set_allow_cached_response(false);
+  req = CreateRequest(info, DEFAULT_PRIORITY);
+  EXPECT_EQ(ERR_IO_PENDING, req->Resolve());
+  proc_->SignalMultiple(1u);
+  EXPECT_EQ(OK, req->WaitForResult());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 82));
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+
+  // The refreshed entry is now fresh.
+  req = CreateRequest("just.testing", 83);
+  EXPECT_EQ(OK, req->ResolveFromCache());
+  EXPECT_TRUE(req->HasOneAddress("192.168.1.43", 83));
+}
+
 // Test the retry attempts simulating host resolver proc that takes too long.
 TEST_F(HostResolverImplTest, MultipleAttempts) {
   // Total number of attempts would be 3 and we want the 3rd attempt to resolve
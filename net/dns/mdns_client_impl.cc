@@ -25,6 +25,9 @@ namespace net {
 
 namespace {
 const unsigned MDnsTransactionTimeoutSeconds = 3;
+// Identical queries are sent at most once per this interval, as suggested by
+// RFC 6762 Section 5.2.
+const unsigned MDnsMinQueryIntervalSeconds = 1;
 }
 
 MDnsConnection::SocketHandler::SocketHandler(
@@ -212,10 +215,33 @@ bool MDnsClientImpl::Core::SendQuery(uint16 rrtype, std::string name) {
   if (!DNSDomainFromDot(name, &name_dns))
     return false;
 
+  base::Time now = base::Time::Now();
+  base::TimeDelta min_interval =
+      base::TimeDelta::FromSeconds(MDnsMinQueryIntervalSeconds);
+  ListenerKey key(name, rrtype);
+  std::map<ListenerKey, base::Time>::iterator found =
+      query_send_times_.find(key);
+  if (found != query_send_times_.end() && now >= found->second &&
+      now - found->second < min_interval) {
+    return true;
+  }
+
   DnsQuery query(0, name_dns, rrtype);
   query.set_flags(0);  // Remove the RD flag from the query. It is unneeded.
 
-  return connection_->Send(query.io_buffer(), query.io_buffer()->size());
+  if (!connection_->Send(query.io_buffer(), query.io_buffer()->size()))
+    return false;
+
+  // Forget queries which can no longer suppress anything.
+  for (std::map<ListenerKey, base::Time>::iterator i =
+           query_send_times_.begin(); i != query_send_times_.end(); ) {
+    if (now < i->second || now - i->second >= min_interval)
+      query_send_times_.erase(i++);
+    else
+      ++i;
+  }
+  query_send_times_[key] = now;
+  return true;
 }
 
 void MDnsClientImpl::Core::HandlePacket(DnsResponse* response,
@@ -249,6 +275,8 @@ void MDnsClientImpl::Core::HandlePacket(DnsResponse* response,
 
       if (offset == parser.GetOffset()) {
         LOG(WARNING) << "Abandoned parsing the rest of the packet.";
+        // Cleanup time may have changed.
+        ScheduleCleanup(cache_.next_expiration());
         return;  // The parser did not advance, abort reading the packet.
       } else {
         continue;  // We may be able to extract other records from the packet.
@@ -264,9 +292,6 @@ void MDnsClientImpl::Core::HandlePacket(DnsResponse* response,
     MDnsCache::Key update_key = MDnsCache::Key::CreateFor(record.get());
     MDnsCache::UpdateType update = cache_.UpdateDnsRecord(record.Pass());
 
-    // Cleanup time may have changed.
-    ScheduleCleanup(cache_.next_expiration());
-
     if (update != MDnsCache::NoChange) {
       MDnsListener::UpdateType update_external;
 
@@ -289,6 +314,9 @@ void MDnsClientImpl::Core::HandlePacket(DnsResponse* response,
     }
   }
 
+  // Cleanup time may have changed.
+  ScheduleCleanup(cache_.next_expiration());
+
   for (std::map<MDnsCache::Key, MDnsListener::UpdateType>::iterator i =
            update_keys.begin(); i != update_keys.end(); i++) {
     const RecordParsed* record = cache_.LookupKey(i->first);
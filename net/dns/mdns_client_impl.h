@@ -111,6 +111,8 @@ class NET_EXPORT_PRIVATE MDnsClientImpl : public MDnsClient {
     bool Init(MDnsConnection::SocketFactory* socket_factory);
 
     // Send a query with a specific rrtype and name. Returns true on success.
+    // A query identical to one sent less than a second ago isn't sent again,
+    // as the answers to the earlier one reach every listener.
     bool SendQuery(uint16 rrtype, std::string name);
 
     // Add/remove a listener to the list of listeners.
@@ -158,6 +160,9 @@ class NET_EXPORT_PRIVATE MDnsClientImpl : public MDnsClient {
     base::CancelableCallback<void()> cleanup_callback_;
     base::Time scheduled_cleanup_;
 
+    // When each recent query was sent.
+    std::map<ListenerKey, base::Time> query_send_times_;
+
     scoped_ptr<MDnsConnection> connection_;
 
     DISALLOW_COPY_AND_ASSIGN(Core);
@@ -597,6 +597,41 @@ TEST_F(MDnsTest, TransactionWithEmptyCache) {
                                          "hello._privet._tcp.local"));
 }
 
+TEST_F(MDnsTest, IdenticalTransactionsShareQuery) {
+  // The query goes out once (on each of the two sockets).
+  ExpectPacket(kQueryPacketPrivet, sizeof(kQueryPacketPrivet));
+
+  scoped_ptr<MDnsTransaction> transaction_privet =
+      test_client_->CreateTransaction(
+          dns_protocol::kTypePTR, "_privet._tcp.local",
+          MDnsTransaction::QUERY_NETWORK |
+          MDnsTransaction::QUERY_CACHE |
+          MDnsTransaction::SINGLE_RESULT,
+          base::Bind(&MDnsTest::MockableRecordCallback,
+                     base::Unretained(this)));
+
+  scoped_ptr<MDnsTransaction> transaction_privet2 =
+      test_client_->CreateTransaction(
+          dns_protocol::kTypePTR, "_privet._tcp.local",
+          MDnsTransaction::QUERY_NETWORK |
+          MDnsTransaction::QUERY_CACHE |
+          MDnsTransaction::SINGLE_RESULT,
+          base::Bind(&MDnsTest::MockableRecordCallback2,
+                     base::Unretained(this)));
+
+  ASSERT_TRUE(transaction_privet->Start());
+  ASSERT_TRUE(transaction_privet2->Start());
+
+  // Both transactions get the answer to the one query.
+  EXPECT_CALL(*this, MockableRecordCallback(MDnsTransaction::RESULT_RECORD, _))
+      .Times(Exactly(1));
+  EXPECT_CALL(*this, MockableRecordCallback2(MDnsTransaction::RESULT_RECORD,
+                                             _))
+      .Times(Exactly(1));
+
+  SimulatePacketReceive(kSamplePacket1, sizeof(kSamplePacket1));
+}
+
 TEST_F(MDnsTest, TransactionCacheOnlyNoResult) {
   scoped_ptr<MDnsTransaction> transaction_privet =
       test_client_->CreateTransaction(
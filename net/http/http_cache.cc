@@ -93,7 +93,8 @@ HttpCache::ActiveEntry::ActiveEntry(disk_cache::Entry* entry)
     : disk_entry(entry),
       writer(NULL),
       will_process_pending_queue(false),
-      doomed(false) {
+      doomed(false),
+      writer_incomplete(false) {
 }
 
 HttpCache::ActiveEntry::~ActiveEntry() {
@@ -267,12 +268,107 @@ void HttpCache::MetadataWriter::OnIOComplete(int result) {
 
 //-----------------------------------------------------------------------------
 
+// This class revalidates a cache entry in the background, by running a
+// transaction that forces validation and reading the response to the end so
+// that any new body is written to the cache.
+class HttpCache::AsyncValidation {
+ public:
+  AsyncValidation(const HttpRequestInfo& original_request, HttpCache* cache)
+      : request_(original_request), cache_(cache) {}
+  ~AsyncValidation() {}
+
+  void Start(const BoundNetLog& net_log);
+
+ private:
+  void OnStarted(int result);
+  void DoRead();
+  void OnRead(int result);
+
+  // Logs the result and asks the HttpCache to delete this object.
+  void Terminate(int result);
+
+  HttpRequestInfo request_;
+  scoped_refptr<IOBuffer> buf_;
+  scoped_ptr<HttpTransaction> transaction_;
+  BoundNetLog net_log_;
+
+  // The HttpCache object owns this object. This object is always deleted
+  // before the pointer to the cache becomes invalid.
+  HttpCache* cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncValidation);
+};
+
+void HttpCache::AsyncValidation::Start(const BoundNetLog& net_log) {
+  net_log_ = net_log;
+  request_.load_flags |= LOAD_VALIDATE_CACHE;
+  request_.upload_data_stream = NULL;
+  net_log_.BeginEvent(
+      NetLog::TYPE_HTTP_CACHE_ASYNC_REVALIDATION,
+      NetLog::StringCallback("url", &request_.url.spec()));
+
+  int rv = cache_->CreateTransaction(IDLE, &transaction_, NULL);
+  if (rv != OK) {
+    Terminate(rv);
+    return;
+  }
+  rv = transaction_->Start(
+      &request_,
+      base::Bind(&AsyncValidation::OnStarted, base::Unretained(this)),
+      net_log_);
+  if (rv != ERR_IO_PENDING)
+    OnStarted(rv);
+}
+
+void HttpCache::AsyncValidation::OnStarted(int result) {
+  if (result != OK) {
+    Terminate(result);
+    return;
+  }
+  DoRead();
+}
+
+void HttpCache::AsyncValidation::DoRead() {
+  const int kBufSize = 32 * 1024;
+  if (!buf_.get())
+    buf_ = new IOBuffer(kBufSize);
+
+  int rv = 0;
+  do {
+    rv = transaction_->Read(
+        buf_.get(),
+        kBufSize,
+        base::Bind(&AsyncValidation::OnRead, base::Unretained(this)));
+  } while (rv > 0);
+
+  if (rv != ERR_IO_PENDING)
+    Terminate(rv);
+}
+
+void HttpCache::AsyncValidation::OnRead(int result) {
+  if (result > 0)
+    DoRead();
+  else
+    Terminate(result);
+}
+
+void HttpCache::AsyncValidation::Terminate(int result) {
+  DCHECK_NE(ERR_IO_PENDING, result);
+  net_log_.EndEventWithNetErrorCode(NetLog::TYPE_HTTP_CACHE_ASYNC_REVALIDATION,
+                                    result);
+  cache_->DeleteAsyncValidation(cache_->GenerateCacheKey(&request_));
+  // |this| is deleted.
+}
+
+//-----------------------------------------------------------------------------
+
 HttpCache::HttpCache(const net::HttpNetworkSession::Params& params,
                      BackendFactory* backend_factory)
     : net_log_(params.net_log),
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      tailing_readers_enabled_(false),
       network_layer_(new HttpNetworkLayer(new HttpNetworkSession(params))) {
 }
 
@@ -283,6 +379,7 @@ HttpCache::HttpCache(HttpNetworkSession* session,
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      tailing_readers_enabled_(false),
       network_layer_(new HttpNetworkLayer(session)) {
 }
 
@@ -293,10 +390,15 @@ HttpCache::HttpCache(HttpTransactionFactory* network_layer,
       backend_factory_(backend_factory),
       building_backend_(false),
       mode_(NORMAL),
+      tailing_readers_enabled_(false),
       network_layer_(network_layer) {
 }
 
 HttpCache::~HttpCache() {
+  // Delete the background revalidations while the cache is still intact, so
+  // that their transactions can detach from their entries.
+  STLDeleteValues(&async_validations_);
+
   // If we have any active entries remaining, then we need to deactivate them.
   // We may have some pending calls to OnProcessPendingQueue, but since those
   // won't run (due to our destruction), we can simply ignore the corresponding
@@ -306,6 +408,8 @@ HttpCache::~HttpCache() {
     entry->will_process_pending_queue = false;
     entry->pending_queue.clear();
     entry->readers.clear();
+    entry->tailing_readers.clear();
+    entry->tail_waiters.clear();
     entry->writer = NULL;
     DeactivateEntry(entry);
   }
@@ -783,6 +887,13 @@ int HttpCache::AddTransactionToEntry(ActiveEntry* entry, Transaction* trans) {
   //
   // NOTE: If the transaction can only write, then the entry should not be in
   // use (since any existing entry should have already been doomed).
+  //
+  // The exception to waiting for the writer is a transaction that can use the
+  // response the writer is storing: it reads the body as it is written.
+  if (entry->writer && trans->TailWriter(entry->writer)) {
+    entry->tailing_readers.push_back(trans);
+    return OK;
+  }
 
   if (entry->writer || entry->will_process_pending_queue) {
     entry->pending_queue.push_back(trans);
@@ -793,6 +904,7 @@ int HttpCache::AddTransactionToEntry(ActiveEntry* entry, Transaction* trans) {
     // transaction needs exclusive access to the entry
     if (entry->readers.empty()) {
       entry->writer = trans;
+      entry->writer_incomplete = false;
     } else {
       entry->pending_queue.push_back(trans);
       return ERR_IO_PENDING;
@@ -813,6 +925,10 @@ int HttpCache::AddTransactionToEntry(ActiveEntry* entry, Transaction* trans) {
 
 void HttpCache::DoneWithEntry(ActiveEntry* entry, Transaction* trans,
                               bool cancel) {
+  // A tailing reader can leave without affecting the writer.
+  if (RemoveTailingReader(entry, trans))
+    return;
+
   // If we already posted a task to move on to the next transaction and this was
   // the writer, there is nothing to cancel.
   if (entry->will_process_pending_queue && entry->readers.empty())
@@ -843,6 +959,13 @@ void HttpCache::DoneWritingToEntry(ActiveEntry* entry, bool success) {
 
   entry->writer = NULL;
 
+  // Tailing readers become regular readers of whatever was stored.
+  if (!success)
+    entry->writer_incomplete = true;
+  entry->readers.splice(entry->readers.end(), entry->tailing_readers);
+  NotifyTailWaiters(entry,
+                    entry->writer_incomplete ? ERR_CACHE_READ_FAILURE : OK);
+
   if (success) {
     ProcessPendingQueue(entry);
   } else {
@@ -853,7 +976,13 @@ void HttpCache::DoneWritingToEntry(ActiveEntry* entry, bool success) {
     pending_queue.swap(entry->pending_queue);
 
     entry->disk_entry->Doom();
-    DestroyEntry(entry);
+    if (entry->readers.empty()) {
+      DestroyEntry(entry);
+    } else if (!entry->doomed) {
+      // The former tailing readers still use the entry, so keep it around
+      // until they are done, but don't let anyone else find it.
+      DoomActiveEntry(entry->disk_entry->GetKey());
+    }
 
     // We need to do something about these pending entries, which now need to
     // be added to a new entry.
@@ -890,6 +1019,60 @@ void HttpCache::ConvertWriterToReader(ActiveEntry* entry) {
   ProcessPendingQueue(entry);
 }
 
+void HttpCache::StartTailingReaders(ActiveEntry* entry) {
+  DCHECK(entry->writer);
+
+  TransactionList::iterator it = entry->pending_queue.begin();
+  while (it != entry->pending_queue.end()) {
+    Transaction* trans = *it;
+    if (!trans->TailWriter(entry->writer)) {
+      ++it;
+      continue;
+    }
+    it = entry->pending_queue.erase(it);
+    entry->tailing_readers.push_back(trans);
+
+    // As with OnProcessPendingQueue, we don't want to call back into |trans|
+    // while the writer is in the middle of its own work.
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind(trans->io_callback(), OK));
+  }
+}
+
+int HttpCache::WaitForTailData(ActiveEntry* entry, Transaction* trans) {
+  if (!entry->writer)
+    return entry->writer_incomplete ? ERR_CACHE_READ_FAILURE : OK;
+
+  DCHECK(std::find(entry->tailing_readers.begin(),
+                   entry->tailing_readers.end(),
+                   trans) != entry->tailing_readers.end());
+  entry->tail_waiters.push_back(trans);
+  return ERR_IO_PENDING;
+}
+
+void HttpCache::NotifyTailWaiters(ActiveEntry* entry, int result) {
+  TransactionList tail_waiters;
+  tail_waiters.swap(entry->tail_waiters);
+
+  for (TransactionList::iterator it = tail_waiters.begin();
+       it != tail_waiters.end(); ++it) {
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind((*it)->io_callback(), result));
+  }
+}
+
+bool HttpCache::RemoveTailingReader(ActiveEntry* entry, Transaction* trans) {
+  TransactionList::iterator it = std::find(entry->tailing_readers.begin(),
+                                           entry->tailing_readers.end(),
+                                           trans);
+  if (it == entry->tailing_readers.end())
+    return false;
+
+  entry->tailing_readers.erase(it);
+  entry->tail_waiters.remove(trans);
+  return true;
+}
+
 LoadState HttpCache::GetLoadStateForPendingTransaction(
       const Transaction* trans) {
   ActiveEntriesMap::const_iterator i = active_entries_.find(trans->key());
@@ -941,10 +1124,23 @@ bool HttpCache::RemovePendingTransactionFromEntry(ActiveEntry* entry,
 
   TransactionList::iterator j =
       find(pending_queue.begin(), pending_queue.end(), trans);
-  if (j == pending_queue.end())
+  if (j != pending_queue.end()) {
+    pending_queue.erase(j);
+    return true;
+  }
+
+  // |trans| may have been let in by StartTailingReaders before it got to run,
+  // and the writer may even be gone by now.
+  if (RemoveTailingReader(entry, trans))
+    return true;
+
+  TransactionList::iterator k =
+      find(entry->readers.begin(), entry->readers.end(), trans);
+  if (k == entry->readers.end())
     return false;
 
-  pending_queue.erase(j);
+  entry->readers.erase(k);
+  ProcessPendingQueue(entry);
   return true;
 }
 
@@ -981,6 +1177,29 @@ void HttpCache::ProcessPendingQueue(ActiveEntry* entry) {
       base::Bind(&HttpCache::OnProcessPendingQueue, AsWeakPtr(), entry));
 }
 
+void HttpCache::PerformAsyncValidation(const HttpRequestInfo& original_request,
+                                       const BoundNetLog& net_log) {
+  DCHECK_EQ("GET", original_request.method);
+  std::string key = GenerateCacheKey(&original_request);
+  if (async_validations_.find(key) != async_validations_.end())
+    return;  // There is already a revalidation in progress for this entry.
+
+  async_validations_[key] = new AsyncValidation(original_request, this);
+
+  // The transaction serving the stale entry is still using it, so start the
+  // revalidation once it has moved on.
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE,
+      base::Bind(&HttpCache::OnStartAsyncValidation, AsWeakPtr(), key));
+}
+
+void HttpCache::DeleteAsyncValidation(const std::string& key) {
+  AsyncValidationMap::iterator it = async_validations_.find(key);
+  DCHECK(it != async_validations_.end());
+  delete it->second;
+  async_validations_.erase(it);
+}
+
 void HttpCache::OnProcessPendingQueue(ActiveEntry* entry) {
   entry->will_process_pending_queue = false;
   DCHECK(!entry->writer);
@@ -1005,6 +1224,14 @@ void HttpCache::OnProcessPendingQueue(ActiveEntry* entry) {
   }
 }
 
+void HttpCache::OnStartAsyncValidation(const std::string& key) {
+  AsyncValidationMap::iterator it = async_validations_.find(key);
+  if (it == async_validations_.end())
+    return;
+  it->second->Start(
+      BoundNetLog::Make(net_log_, NetLog::SOURCE_ASYNC_REVALIDATION));
+}
+
 void HttpCache::OnIOComplete(int result, PendingOp* pending_op) {
   WorkItemOperation op = pending_op->writer->operation();
 
@@ -43,6 +43,7 @@ class Entry;
 
 namespace net {
 
+class BoundNetLog;
 class CertVerifier;
 class HostResolver;
 class HttpAuthHandlerFactory;
@@ -174,6 +175,14 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   void set_mode(Mode value) { mode_ = value; }
   Mode mode() { return mode_; }
 
+  // Get/Set whether transactions waiting for the writer of an entry may read
+  // the response body while it is being written, instead of waiting for the
+  // writer to finish.
+  void set_tailing_readers_enabled(bool value) {
+    tailing_readers_enabled_ = value;
+  }
+  bool tailing_readers_enabled() const { return tailing_readers_enabled_; }
+
   // Close currently active sockets so that fresh page loads will not use any
   // recycled connections.  For sockets currently in use, they may not close
   // immediately, but they will not be reusable. This is for debugging.
@@ -211,6 +220,7 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
  private:
   // Types --------------------------------------------------------------------
 
+  class AsyncValidation;
   class MetadataWriter;
   class Transaction;
   class WorkItem;
@@ -228,14 +238,21 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
     Transaction*       writer;
     TransactionList    readers;
     TransactionList    pending_queue;
+    // Readers of the body that |writer| is still writing, and the subset of
+    // them waiting for more data to be written.
+    TransactionList    tailing_readers;
+    TransactionList    tail_waiters;
     bool               will_process_pending_queue;
     bool               doomed;
+    // The last writer left without storing the whole body.
+    bool               writer_incomplete;
   };
 
   typedef base::hash_map<std::string, ActiveEntry*> ActiveEntriesMap;
   typedef base::hash_map<std::string, PendingOp*> PendingOpsMap;
   typedef std::set<ActiveEntry*> ActiveEntriesSet;
   typedef base::hash_map<std::string, int> PlaybackCacheMap;
+  typedef base::hash_map<std::string, AsyncValidation*> AsyncValidationMap;
 
   // Methods ------------------------------------------------------------------
 
@@ -332,6 +349,26 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   // transactions can start reading from this entry.
   void ConvertWriterToReader(ActiveEntry* entry);
 
+  // Called when the writer of |entry| starts storing a response body. The
+  // pending transactions that can use that response become tailing readers,
+  // reading the body while it is written instead of waiting for the writer.
+  void StartTailingReaders(ActiveEntry* entry);
+
+  // Called by the tailing reader |trans| once it has read all the data written
+  // to |entry| so far. Returns ERR_IO_PENDING if |trans| has to wait for more
+  // data, in which case it will be notified via its IO callback. Otherwise the
+  // writer is gone, and the return value is OK if the body is complete or
+  // ERR_CACHE_READ_FAILURE if it will never be.
+  int WaitForTailData(ActiveEntry* entry, Transaction* trans);
+
+  // Wakes up the tailing readers of |entry| waiting for data, passing them
+  // |result|.
+  void NotifyTailWaiters(ActiveEntry* entry, int result);
+
+  // Removes |trans| from the tailing readers of |entry|. Returns false if it
+  // wasn't one of them.
+  bool RemoveTailingReader(ActiveEntry* entry, Transaction* trans);
+
   // Returns the LoadState of the provided pending transaction.
   LoadState GetLoadStateForPendingTransaction(const Transaction* trans);
 
@@ -350,8 +387,19 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   // Resumes processing the pending list of |entry|.
   void ProcessPendingQueue(ActiveEntry* entry);
 
+  // Revalidates the entry for |original_request| in the background, unless
+  // that is already under way. Used when a stale entry is served under
+  // "Cache-Control: stale-while-revalidate".
+  void PerformAsyncValidation(const HttpRequestInfo& original_request,
+                              const BoundNetLog& net_log);
+
+  // Deletes the AsyncValidation for |key|, once it has finished.
+  void DeleteAsyncValidation(const std::string& key);
+
   // Events (called via PostTask) ---------------------------------------------
 
+  void OnStartAsyncValidation(const std::string& key);
+
   void OnProcessPendingQueue(ActiveEntry* entry);
 
   // Callbacks ----------------------------------------------------------------
@@ -382,6 +430,8 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
 
   Mode mode_;
 
+  bool tailing_readers_enabled_;
+
   const scoped_ptr<HttpTransactionFactory> network_layer_;
   scoped_ptr<disk_cache::Backend> disk_cache_;
 
@@ -396,6 +446,9 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
 
   scoped_ptr<PlaybackCacheMap> playback_cache_map_;
 
+  // The background revalidations in progress, indexed by cache key.
+  AsyncValidationMap async_validations_;
+
   DISALLOW_COPY_AND_ASSIGN(HttpCache);
 };
 
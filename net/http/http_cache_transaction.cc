@@ -205,6 +205,8 @@ HttpCache::Transaction::Transaction(
       done_reading_(false),
       vary_mismatch_(false),
       couldnt_conditionalize_request_(false),
+      streaming_body_(false),
+      tailing_(false),
       io_buf_len_(0),
       read_offset_(0),
       effective_load_flags_(0),
@@ -274,6 +276,9 @@ bool HttpCache::Transaction::AddTruncatedFlag() {
   if (done_reading_)
     return true;
 
+  // Transactions tailing this one must not take what we have as the whole body.
+  entry_->writer_incomplete = true;
+
   truncated_ = true;
   target_state_ = STATE_NONE;
   next_state_ = STATE_CACHE_WRITE_TRUNCATED_RESPONSE;
@@ -281,6 +286,39 @@ bool HttpCache::Transaction::AddTruncatedFlag() {
   return true;
 }
 
+bool HttpCache::Transaction::TailWriter(const Transaction* writer) {
+  DCHECK(cache_pending_);
+  if (!writer->streaming_body_)
+    return false;
+
+  if (cache_->mode() != net::HttpCache::NORMAL)
+    return false;
+
+  if (mode_ != READ && mode_ != READ_WRITE)
+    return false;
+
+  if (partial_.get() || request_->method != "GET" ||
+      (effective_load_flags_ & LOAD_VALIDATE_CACHE)) {
+    return false;
+  }
+
+  const HttpResponseInfo& response = writer->response_;
+  if (response.vary_data.is_valid() &&
+      !response.vary_data.MatchesRequest(*request_, *response.headers.get())) {
+    return false;
+  }
+
+  if (!(effective_load_flags_ & LOAD_PREFERRING_CACHE) &&
+      response.headers->RequiresValidation(
+          response.request_time, response.response_time, Time::Now())) {
+    return false;
+  }
+
+  mode_ = READ;
+  tailing_ = true;
+  return true;
+}
+
 LoadState HttpCache::Transaction::GetWriterLoadState() const {
   if (network_trans_.get())
     return network_trans_->GetLoadState();
@@ -760,6 +798,13 @@ int HttpCache::Transaction::DoLoop(int result) {
       case STATE_CACHE_READ_DATA_COMPLETE:
         rv = DoCacheReadDataComplete(rv);
         break;
+      case STATE_CACHE_WAIT_FOR_DATA:
+        DCHECK_EQ(OK, rv);
+        rv = DoCacheWaitForData();
+        break;
+      case STATE_CACHE_WAIT_FOR_DATA_COMPLETE:
+        rv = DoCacheWaitForDataComplete(rv);
+        break;
       case STATE_CACHE_WRITE_DATA:
         rv = DoCacheWriteData(rv);
         break;
@@ -1567,6 +1612,9 @@ int HttpCache::Transaction::DoCacheReadDataComplete(int result) {
 
   if (result > 0) {
     read_offset_ += result;
+  } else if (result == 0 && tailing_) {
+    // The writer may not be done yet.
+    next_state_ = STATE_CACHE_WAIT_FOR_DATA;
   } else if (result == 0) {  // End of file.
     RecordHistograms();
     cache_->DoneReadingFromEntry(entry_, this);
@@ -1577,6 +1625,41 @@ int HttpCache::Transaction::DoCacheReadDataComplete(int result) {
   return result;
 }
 
+int HttpCache::Transaction::DoCacheWaitForData() {
+  next_state_ = STATE_CACHE_WAIT_FOR_DATA_COMPLETE;
+
+  // The writer may have appended more data since our last read.
+  if (entry_->disk_entry->GetDataSize(kResponseContentIndex) > read_offset_)
+    return OK;
+
+  return cache_->WaitForTailData(entry_, this);
+}
+
+int HttpCache::Transaction::DoCacheWaitForDataComplete(int result) {
+  if (!cache_.get())
+    return ERR_UNEXPECTED;
+
+  if (result != OK)
+    return result;
+
+  if (entry_->disk_entry->GetDataSize(kResponseContentIndex) > read_offset_) {
+    next_state_ = STATE_CACHE_READ_DATA;
+    return OK;
+  }
+
+  if (entry_->writer) {
+    next_state_ = STATE_CACHE_WAIT_FOR_DATA;
+    return OK;
+  }
+
+  // The writer is done, and so are we.
+  tailing_ = false;
+  RecordHistograms();
+  cache_->DoneReadingFromEntry(entry_, this);
+  entry_ = NULL;
+  return 0;
+}
+
 int HttpCache::Transaction::DoCacheWriteData(int num_bytes) {
   next_state_ = STATE_CACHE_WRITE_DATA_COMPLETE;
   write_len_ = num_bytes;
@@ -1615,6 +1698,18 @@ int HttpCache::Transaction::DoCacheWriteDataComplete(int result) {
       done_reading_ = true;
   }
 
+  if (entry_ && result > 0) {
+    if (streaming_body_) {
+      cache_->NotifyTailWaiters(entry_, OK);
+    } else if (cache_->tailing_readers_enabled() && !partial_.get() &&
+               !truncated_ && response_.headers->response_code() == 200) {
+      // The body is now being stored as it arrives, so others waiting for
+      // this response can read it along.
+      streaming_body_ = true;
+      cache_->StartTailingReaders(entry_);
+    }
+  }
+
   if (partial_.get()) {
     // This may be the last request.
     if (!(result == 0 && !truncated_ &&
@@ -1809,6 +1904,13 @@ int HttpCache::Transaction::BeginCacheValidation() {
     skip_validation = false;
   }
 
+  if (!skip_validation && !truncated_ && !partial_.get() &&
+      CanUseWhileRevalidating()) {
+    // Serve the stale entry right away, and refresh it in the background.
+    cache_->PerformAsyncValidation(*request_, net_log_);
+    skip_validation = true;
+  }
+
   if (skip_validation) {
     UpdateTransactionPattern(PATTERN_ENTRY_USED);
     RecordOfflineStatus(effective_load_flags_, OFFLINE_STATUS_FRESH_CACHE);
@@ -1980,6 +2082,23 @@ bool HttpCache::Transaction::RequiresValidation() {
   return false;
 }
 
+bool HttpCache::Transaction::CanUseWhileRevalidating() {
+  if (cache_->mode() != net::HttpCache::NORMAL)
+    return false;
+
+  if (vary_mismatch_)
+    return false;
+
+  if (effective_load_flags_ & LOAD_VALIDATE_CACHE)
+    return false;
+
+  if (request_->method != "GET")
+    return false;
+
+  return response_.headers->IsUsableWhileRevalidating(
+      response_.request_time, response_.response_time, Time::Now());
+}
+
 bool HttpCache::Transaction::ConditionalizeRequest() {
   DCHECK(response_.headers.get());
 
@@ -93,6 +93,12 @@ class HttpCache::Transaction : public HttpTransaction {
   // deleting the active entry.
   bool AddTruncatedFlag();
 
+  // Returns true if this transaction, which is waiting for |writer| to be done
+  // with the cache entry, can use the response that |writer| is storing and
+  // read its body as it is being written. In that case the transaction becomes
+  // a reader of the entry.
+  bool TailWriter(const Transaction* writer);
+
   HttpCache::ActiveEntry* entry() { return entry_; }
 
   // Returns the LoadState of the writer transaction of a given ActiveEntry. In
@@ -181,6 +187,8 @@ class HttpCache::Transaction : public HttpTransaction {
     STATE_CACHE_QUERY_DATA_COMPLETE,
     STATE_CACHE_READ_DATA,
     STATE_CACHE_READ_DATA_COMPLETE,
+    STATE_CACHE_WAIT_FOR_DATA,
+    STATE_CACHE_WAIT_FOR_DATA_COMPLETE,
     STATE_CACHE_WRITE_DATA,
     STATE_CACHE_WRITE_DATA_COMPLETE
   };
@@ -252,6 +260,8 @@ class HttpCache::Transaction : public HttpTransaction {
   int DoCacheQueryDataComplete(int result);
   int DoCacheReadData();
   int DoCacheReadDataComplete(int result);
+  int DoCacheWaitForData();
+  int DoCacheWaitForDataComplete(int result);
   int DoCacheWriteData(int num_bytes);
   int DoCacheWriteDataComplete(int result);
 
@@ -297,6 +307,10 @@ class HttpCache::Transaction : public HttpTransaction {
   // Called to determine if we need to validate the cache entry before using it.
   bool RequiresValidation();
 
+  // Called when the cache entry requires validation, to determine if it may be
+  // used anyway while it is revalidated in the background.
+  bool CanUseWhileRevalidating();
+
   // Called to make the request conditional (to ask the server if the cached
   // copy is valid).  Returns true if able to make the request conditional.
   bool ConditionalizeRequest();
@@ -411,6 +425,8 @@ class HttpCache::Transaction : public HttpTransaction {
   bool done_reading_;
   bool vary_mismatch_;  // The request doesn't match the stored vary data.
   bool couldnt_conditionalize_request_;
+  bool streaming_body_;  // Others may read the body while we write it.
+  bool tailing_;  // We read a body that may still be being written.
   scoped_refptr<IOBuffer> read_buf_;
   int io_buf_len_;
   int read_offset_;
@@ -1239,6 +1239,43 @@ TEST(HttpCache, SimpleGET_LoadValidateCache_Implicit) {
   EXPECT_EQ(1, cache.disk_cache()->create_count());
 }
 
+// Tests that a stale entry within its stale-while-revalidate window is used
+// without waiting for validation, and revalidated in the background.
+TEST(HttpCache, SimpleGET_StaleWhileRevalidate) {
+  MockHttpCache cache;
+
+  MockTransaction transaction(kSimpleGET_Transaction);
+  transaction.response_headers =
+      "Etag: \"foopy\"\n"
+      "Cache-Control: max-age=0, stale-while-revalidate=86400\n";
+  AddMockTransaction(&transaction);
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+
+  // Read the stale entry from the cache.
+  net::HttpResponseInfo response_info;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response_info);
+  EXPECT_TRUE(response_info.was_cached);
+  EXPECT_FALSE(response_info.network_accessed);
+
+  // The revalidation goes to the network once the entry is free.
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  // An explicit validation still waits for the network.
+  transaction.load_flags |= net::LOAD_VALIDATE_CACHE;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response_info);
+  EXPECT_TRUE(response_info.network_accessed);
+  EXPECT_EQ(3, cache.network_layer()->transaction_count());
+
+  RemoveMockTransaction(&transaction);
+}
+
 static void PreserveRequestHeaders_Handler(
     const net::HttpRequestInfo* request,
     std::string* response_status,
@@ -1351,6 +1388,133 @@ TEST(HttpCache, SimpleGET_ManyReaders) {
   }
 }
 
+// Tests that transactions waiting for the writer of an entry read the body as
+// it is written, when tailing readers are enabled.
+TEST(HttpCache, SimpleGET_TailingReaders) {
+  MockHttpCache cache;
+  cache.http_cache()->set_tailing_readers_enabled(true);
+
+  MockHttpRequest request(kSimpleGET_Transaction);
+
+  std::vector<Context*> context_list;
+  const int kNumTransactions = 3;
+
+  for (int i = 0; i < kNumTransactions; ++i) {
+    context_list.push_back(new Context());
+    Context* c = context_list[i];
+
+    c->result = cache.http_cache()->CreateTransaction(
+        net::DEFAULT_PRIORITY, &c->trans, NULL);
+    EXPECT_EQ(net::OK, c->result);
+
+    c->result = c->trans->Start(
+        &request, c->callback.callback(), net::BoundNetLog());
+  }
+
+  // The first request is the writer, and the others are pending.
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  Context* writer = context_list[0];
+  EXPECT_EQ(net::OK, writer->callback.GetResult(writer->result));
+
+  // Once the writer stores part of the body, the others can start reading.
+  const std::string expected(kSimpleGET_Transaction.data);
+  const int kFirstChunk = 5;
+  scoped_refptr<net::IOBuffer> buf(new net::IOBuffer(kFirstChunk));
+  int rv = writer->trans->Read(buf.get(), kFirstChunk,
+                               writer->callback.callback());
+  EXPECT_EQ(kFirstChunk, writer->callback.GetResult(rv));
+
+  std::vector<scoped_refptr<net::IOBuffer> > buffers;
+  const int kBufferSize = 256;
+  for (int i = 1; i < kNumTransactions; ++i) {
+    Context* c = context_list[i];
+    EXPECT_EQ(net::OK, c->callback.GetResult(c->result));
+
+    buffers.push_back(new net::IOBuffer(kBufferSize));
+    rv = c->trans->Read(buffers.back().get(), kBufferSize,
+                        c->callback.callback());
+    ASSERT_EQ(kFirstChunk, c->callback.GetResult(rv));
+    EXPECT_EQ(expected.substr(0, kFirstChunk),
+              std::string(buffers.back()->data(), kFirstChunk));
+
+    // There is nothing more to read until the writer makes progress.
+    c->result = c->trans->Read(buffers.back().get(), kBufferSize,
+                               c->callback.callback());
+    EXPECT_EQ(net::ERR_IO_PENDING, c->result);
+  }
+
+  std::string content;
+  EXPECT_EQ(net::OK, ReadTransaction(writer->trans.get(), &content));
+  EXPECT_EQ(expected.substr(kFirstChunk), content);
+
+  for (int i = 1; i < kNumTransactions; ++i) {
+    Context* c = context_list[i];
+    const int remaining = static_cast<int>(expected.size()) - kFirstChunk;
+    ASSERT_EQ(remaining, c->callback.GetResult(c->result));
+    EXPECT_EQ(expected.substr(kFirstChunk),
+              std::string(buffers[i - 1]->data(), remaining));
+
+    rv = c->trans->Read(buffers[i - 1].get(), kBufferSize,
+                        c->callback.callback());
+    EXPECT_EQ(0, c->callback.GetResult(rv));
+  }
+
+  // Nobody had to go back to the network or reopen the entry.
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(0, cache.disk_cache()->open_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  for (int i = 0; i < kNumTransactions; ++i) {
+    Context* c = context_list[i];
+    delete c;
+  }
+}
+
+// Tests that a tailing reader fails if the writer goes away before storing the
+// whole body, as what it has read so far is not the whole response.
+TEST(HttpCache, SimpleGET_TailingReaderWriterCancelled) {
+  MockHttpCache cache;
+  cache.http_cache()->set_tailing_readers_enabled(true);
+
+  MockHttpRequest request(kSimpleGET_Transaction);
+
+  Context writer;
+  Context reader;
+  writer.result = cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &writer.trans, NULL);
+  EXPECT_EQ(net::OK, writer.result);
+  reader.result = cache.http_cache()->CreateTransaction(
+      net::DEFAULT_PRIORITY, &reader.trans, NULL);
+  EXPECT_EQ(net::OK, reader.result);
+
+  writer.result = writer.trans->Start(
+      &request, writer.callback.callback(), net::BoundNetLog());
+  reader.result = reader.trans->Start(
+      &request, reader.callback.callback(), net::BoundNetLog());
+  EXPECT_EQ(net::OK, writer.callback.GetResult(writer.result));
+
+  const int kFirstChunk = 5;
+  scoped_refptr<net::IOBuffer> buf(new net::IOBuffer(kFirstChunk));
+  int rv = writer.trans->Read(buf.get(), kFirstChunk,
+                              writer.callback.callback());
+  EXPECT_EQ(kFirstChunk, writer.callback.GetResult(rv));
+
+  EXPECT_EQ(net::OK, reader.callback.GetResult(reader.result));
+  scoped_refptr<net::IOBuffer> reader_buf(new net::IOBuffer(256));
+  rv = reader.trans->Read(reader_buf.get(), 256, reader.callback.callback());
+  EXPECT_EQ(kFirstChunk, reader.callback.GetResult(rv));
+  reader.result = reader.trans->Read(reader_buf.get(), 256,
+                                     reader.callback.callback());
+  EXPECT_EQ(net::ERR_IO_PENDING, reader.result);
+
+  writer.trans.reset();
+  EXPECT_EQ(net::ERR_CACHE_READ_FAILURE, reader.callback.WaitForResult());
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+}
+
 // This is a test for http://code.google.com/p/chromium/issues/detail?id=4769.
 // If cancelling a request is racing with another request for the same resource
 // finishing, we have to make sure that we remove both transactions from the
@@ -72,6 +72,7 @@ HttpNetworkSession::Params::Params()
       force_spdy_single_domain(false),
       enable_spdy_ip_pooling(true),
       enable_spdy_compression(true),
+      enable_spdy_header_indexing(false),
       enable_spdy_ping_based_connection_checking(true),
       spdy_default_protocol(kProtoUnknown),
       spdy_stream_initial_recv_window_size(0),
@@ -118,6 +119,7 @@ HttpNetworkSession::HttpNetworkSession(const Params& params)
                          params.force_spdy_single_domain,
                          params.enable_spdy_ip_pooling,
                          params.enable_spdy_compression,
+                         params.enable_spdy_header_indexing,
                          params.enable_spdy_ping_based_connection_checking,
                          params.spdy_default_protocol,
                          params.spdy_stream_initial_recv_window_size,
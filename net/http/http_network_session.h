@@ -78,6 +78,7 @@ class NET_EXPORT HttpNetworkSession
     bool force_spdy_single_domain;
     bool enable_spdy_ip_pooling;
     bool enable_spdy_compression;
+    bool enable_spdy_header_indexing;
     bool enable_spdy_ping_based_connection_checking;
     NextProto spdy_default_protocol;
     size_t spdy_stream_initial_recv_window_size;
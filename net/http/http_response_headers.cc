@@ -889,6 +889,26 @@ bool HttpResponseHeaders::IsRedirectResponseCode(int response_code) {
           response_code == 307);
 }
 
+bool HttpResponseHeaders::IsUsableWhileRevalidating(
+    const Time& request_time,
+    const Time& response_time,
+    const Time& current_time) const {
+  TimeDelta stale_while_revalidate;
+  if (!GetStaleWhileRevalidateValue(&stale_while_revalidate))
+    return false;
+
+  // These forbid using the response without validating it first.
+  if (HasHeaderValue("cache-control", "no-cache") ||
+      HasHeaderValue("cache-control", "no-store") ||
+      HasHeaderValue("cache-control", "must-revalidate") ||
+      HasHeaderValue("pragma", "no-cache") ||
+      HasHeaderValue("vary", "*"))
+    return false;
+
+  return GetFreshnessLifetime(response_time) + stale_while_revalidate >
+      GetCurrentAge(request_time, response_time, current_time);
+}
+
 // From RFC 2616 section 13.2.4:
 //
 // The calculation to determine if a response has expired is quite simple:
@@ -1054,21 +1074,21 @@ TimeDelta HttpResponseHeaders::GetCurrentAge(const Time& request_time,
   return current_age;
 }
 
-bool HttpResponseHeaders::GetMaxAgeValue(TimeDelta* result) const {
+bool HttpResponseHeaders::GetCacheControlDirective(const char* directive,
+                                                   TimeDelta* result) const {
   std::string name = "cache-control";
   std::string value;
 
-  const char kMaxAgePrefix[] = "max-age=";
-  const size_t kMaxAgePrefixLen = arraysize(kMaxAgePrefix) - 1;
+  const size_t directive_len = strlen(directive);
 
   void* iter = NULL;
   while (EnumerateHeader(&iter, name, &value)) {
-    if (value.size() > kMaxAgePrefixLen) {
+    if (value.size() > directive_len) {
       if (LowerCaseEqualsASCII(value.begin(),
-                               value.begin() + kMaxAgePrefixLen,
-                               kMaxAgePrefix)) {
+                               value.begin() + directive_len,
+                               directive)) {
         int64 seconds;
-        base::StringToInt64(StringPiece(value.begin() + kMaxAgePrefixLen,
+        base::StringToInt64(StringPiece(value.begin() + directive_len,
                                         value.end()),
                             &seconds);
         *result = TimeDelta::FromSeconds(seconds);
@@ -1080,6 +1100,15 @@ bool HttpResponseHeaders::GetMaxAgeValue(TimeDelta* result) const {
   return false;
 }
 
+bool HttpResponseHeaders::GetMaxAgeValue(TimeDelta* result) const {
+  return GetCacheControlDirective("max-age=", result);
+}
+
+bool HttpResponseHeaders::GetStaleWhileRevalidateValue(
+    TimeDelta* result) const {
+  return GetCacheControlDirective("stale-while-revalidate=", result);
+}
+
 bool HttpResponseHeaders::GetAgeValue(TimeDelta* result) const {
   std::string value;
   if (!EnumerateHeader(NULL, "Age", &value))
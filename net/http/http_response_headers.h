@@ -202,6 +202,15 @@ class NET_EXPORT HttpResponseHeaders
   // RequiresValidation for a description of the response_time parameter.
   base::TimeDelta GetFreshnessLifetime(const base::Time& response_time) const;
 
+  // Returns true if the response requires validation but may still be used
+  // while it is revalidated in the background, because it carries a
+  // "Cache-Control: stale-while-revalidate" directive (RFC 5861) covering its
+  // current age.  See RequiresValidation for a description of this method's
+  // parameters.
+  bool IsUsableWhileRevalidating(const base::Time& request_time,
+                                 const base::Time& response_time,
+                                 const base::Time& current_time) const;
+
   // Returns the age of the response.  See section 13.2.3 of RFC 2616.
   // See RequiresValidation for a description of this method's parameters.
   base::TimeDelta GetCurrentAge(const base::Time& request_time,
@@ -212,6 +221,7 @@ class NET_EXPORT HttpResponseHeaders
   // value is not present, then false is returned.  Otherwise, true is returned
   // and the out param is assigned to the corresponding value.
   bool GetMaxAgeValue(base::TimeDelta* value) const;
+  bool GetStaleWhileRevalidateValue(base::TimeDelta* value) const;
   bool GetAgeValue(base::TimeDelta* value) const;
   bool GetDateValue(base::Time* value) const;
   bool GetLastModifiedValue(base::Time* value) const;
@@ -312,6 +322,12 @@ class NET_EXPORT HttpResponseHeaders
                        std::string::const_iterator line_end,
                        bool has_headers);
 
+  // Looks for a "Cache-Control: <directive>=<seconds>" header and stores the
+  // number of seconds in |result|.  |directive| must be lower case and
+  // include the '='.
+  bool GetCacheControlDirective(const char* directive,
+                                base::TimeDelta* result) const;
+
   // Find the header in our list (case-insensitive) starting with parsed_ at
   // index |from|.  Returns string::npos if not found.
   size_t FindHeader(size_t from, const base::StringPiece& name) const;
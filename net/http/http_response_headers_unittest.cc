@@ -872,6 +872,73 @@ TEST(HttpResponseHeadersTest, RequiresValidation) {
   }
 }
 
+TEST(HttpResponseHeadersTest, IsUsableWhileRevalidating) {
+  const struct {
+    const char* headers;
+    bool usable_while_revalidating;
+  } tests[] = {
+    // no stale-while-revalidate
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=0\n"
+      "\n",
+      false
+    },
+    // stale, but within the stale-while-revalidate window
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=0, stale-while-revalidate=600\n"
+      "\n",
+      true
+    },
+    // the window includes the freshness lifetime
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=200\n"
+      "cache-control: stale-while-revalidate=200\n"
+      "\n",
+      true
+    },
+    // past the stale-while-revalidate window
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=0, stale-while-revalidate=60\n"
+      "\n",
+      false
+    },
+    // must-revalidate forbids using stale responses
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=0, stale-while-revalidate=600, "
+      "must-revalidate\n"
+      "\n",
+      false
+    },
+    // as does no-cache
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: no-cache, stale-while-revalidate=600\n"
+      "\n",
+      false
+    },
+  };
+  base::Time request_time, response_time, current_time;
+  base::Time::FromString("Wed, 28 Nov 2007 00:40:09 GMT", &request_time);
+  base::Time::FromString("Wed, 28 Nov 2007 00:40:12 GMT", &response_time);
+  base::Time::FromString("Wed, 28 Nov 2007 00:45:20 GMT", &current_time);
+
+  for (size_t i = 0; i < ARRAYSIZE_UNSAFE(tests); ++i) {
+    std::string headers(tests[i].headers);
+    HeadersToRaw(&headers);
+    scoped_refptr<net::HttpResponseHeaders> parsed(
+        new net::HttpResponseHeaders(headers));
+
+    EXPECT_EQ(tests[i].usable_while_revalidating,
+              parsed->IsUsableWhileRevalidating(request_time, response_time,
+                                                current_time)) << i;
+  }
+}
+
 TEST(HttpResponseHeadersTest, Update) {
   const struct {
     const char* orig_headers;
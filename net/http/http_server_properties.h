@@ -73,6 +73,7 @@ extern const char kAlternateProtocolHeader[];
 // * SPDY support (based on NPN results)
 // * Alternate-Protocol support
 // * Spdy Settings (like CWND ID field)
+// * The number of connections used at once
 class NET_EXPORT HttpServerProperties {
  public:
   HttpServerProperties() {}
@@ -143,6 +144,15 @@ class NET_EXPORT HttpServerProperties {
 
   virtual PipelineCapabilityMap GetPipelineCapabilityMap() const = 0;
 
+  // Records that |num_connections| connections to |server| were in use at the
+  // same time.
+  virtual void RecordConnectionsInUse(const HostPortPair& server,
+                                      int num_connections) = 0;
+
+  // Returns the largest number of connections to |server| recorded as in use
+  // at the same time, or 0 if there is no record for |server|.
+  virtual int GetMaxConnectionsInUse(const HostPortPair& server) const = 0;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(HttpServerProperties);
 };
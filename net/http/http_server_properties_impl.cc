@@ -20,6 +20,7 @@ static const int kDefaultNumHostsToRemember = 200;
 HttpServerPropertiesImpl::HttpServerPropertiesImpl()
     : pipeline_capability_map_(
         new CachedPipelineCapabilityMap(kDefaultNumHostsToRemember)),
+      max_connections_in_use_map_(kDefaultNumHostsToRemember),
       weak_ptr_factory_(this) {
 }
 
@@ -123,6 +124,7 @@ void HttpServerPropertiesImpl::Clear() {
   alternate_protocol_map_.clear();
   spdy_settings_map_.clear();
   pipeline_capability_map_->Clear();
+  max_connections_in_use_map_.Clear();
 }
 
 bool HttpServerPropertiesImpl::SupportsSpdy(
@@ -300,4 +302,26 @@ HttpServerPropertiesImpl::GetPipelineCapabilityMap() const {
   return result;
 }
 
+void HttpServerPropertiesImpl::RecordConnectionsInUse(
+    const HostPortPair& server,
+    int num_connections) {
+  DCHECK(CalledOnValidThread());
+  ConnectionsInUseMap::iterator it = max_connections_in_use_map_.Get(server);
+  if (it == max_connections_in_use_map_.end()) {
+    max_connections_in_use_map_.Put(server, num_connections);
+  } else if (it->second < num_connections) {
+    it->second = num_connections;
+  }
+}
+
+int HttpServerPropertiesImpl::GetMaxConnectionsInUse(
+    const HostPortPair& server) const {
+  DCHECK(CalledOnValidThread());
+  ConnectionsInUseMap::const_iterator it =
+      max_connections_in_use_map_.Peek(server);
+  if (it == max_connections_in_use_map_.end())
+    return 0;
+  return it->second;
+}
+
 }  // namespace net
@@ -411,6 +411,26 @@ TEST_F(SpdySettingsServerPropertiesTest, Clear) {
   EXPECT_EQ(0U, impl_.GetSpdySettings(spdy_server_docs).size());
 }
 
+typedef HttpServerPropertiesImplTest ConnectionsInUseServerPropertiesTest;
+
+TEST_F(ConnectionsInUseServerPropertiesTest, KeepsMaximum) {
+  HostPortPair server("www.google.com", 443);
+  EXPECT_EQ(0, impl_.GetMaxConnectionsInUse(server));
+
+  impl_.RecordConnectionsInUse(server, 3);
+  EXPECT_EQ(3, impl_.GetMaxConnectionsInUse(server));
+  impl_.RecordConnectionsInUse(server, 1);
+  EXPECT_EQ(3, impl_.GetMaxConnectionsInUse(server));
+  impl_.RecordConnectionsInUse(server, 6);
+  EXPECT_EQ(6, impl_.GetMaxConnectionsInUse(server));
+
+  HostPortPair other_server("docs.google.com", 443);
+  EXPECT_EQ(0, impl_.GetMaxConnectionsInUse(other_server));
+
+  impl_.Clear();
+  EXPECT_EQ(0, impl_.GetMaxConnectionsInUse(server));
+}
+
 }  // namespace
 
 }  // namespace net
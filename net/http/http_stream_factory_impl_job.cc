@@ -149,6 +149,12 @@ int HttpStreamFactoryImpl::Job::Preconnect(int num_streams) {
     num_streams_ = 1;
   } else {
     num_streams_ = num_streams;
+    // Warm up as many connections as the server has needed at once before.
+    if (http_server_properties) {
+      num_streams_ = std::max(
+          num_streams_,
+          http_server_properties->GetMaxConnectionsInUse(origin_server));
+    }
   }
   return StartInternal();
 }
@@ -1025,6 +1031,13 @@ int HttpStreamFactoryImpl::Job::DoInitConnectionComplete(int result) {
       return result;
   }
 
+  // Learn how many connections to the server this load needs, so that later
+  // preconnects can set them up in advance.
+  if (!using_spdy_ && session_->http_server_properties()) {
+    session_->http_server_properties()->RecordConnectionsInUse(
+        origin_, connection_->ActiveSocketCountInGroup());
+  }
+
   next_state_ = STATE_CREATE_STREAM;
   return OK;
 }
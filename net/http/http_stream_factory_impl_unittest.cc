@@ -376,6 +376,11 @@ class CapturePreconnectsSocketPool : public ParentPool {
     ADD_FAILURE();
     return 0;
   }
+  virtual int ActiveSocketCountInGroup(
+      const std::string& group_name) const OVERRIDE {
+    ADD_FAILURE();
+    return 0;
+  }
   virtual LoadState GetLoadState(
       const std::string& group_name,
       const ClientSocketHandle* handle) const OVERRIDE {
@@ -591,6 +596,37 @@ TEST_P(HttpStreamFactoryTest, PreconnectUnsafePort) {
   EXPECT_EQ(-1, transport_conn_pool->last_num_streams());
 }
 
+// Verify that preconnects open as many connections as the server was recorded
+// to need at once, if that is more than requested.
+TEST_P(HttpStreamFactoryTest, PreconnectLearnedConnectionCount) {
+  SpdySessionDependencies session_deps(
+      GetParam(), ProxyService::CreateDirect());
+  scoped_refptr<HttpNetworkSession> session(
+      SpdySessionDependencies::SpdyCreateSession(&session_deps));
+  HttpNetworkSessionPeer peer(session);
+  CapturePreconnectsTransportSocketPool* transport_conn_pool =
+      new CapturePreconnectsTransportSocketPool(
+          session_deps.host_resolver.get(),
+          session_deps.cert_verifier.get());
+  MockClientSocketPoolManager* mock_pool_manager =
+      new MockClientSocketPoolManager;
+  mock_pool_manager->SetTransportSocketPool(transport_conn_pool);
+  peer.SetClientSocketPoolManager(mock_pool_manager);
+
+  session->http_server_properties()->RecordConnectionsInUse(
+      HostPortPair("www.google.com", 80), 4);
+
+  PreconnectHelperForURL(1, GURL("http://www.google.com"), session.get());
+  EXPECT_EQ(4, transport_conn_pool->last_num_streams());
+
+  PreconnectHelperForURL(6, GURL("http://www.google.com"), session.get());
+  EXPECT_EQ(6, transport_conn_pool->last_num_streams());
+
+  // Nothing is known about other servers.
+  PreconnectHelperForURL(1, GURL("http://www.example.org"), session.get());
+  EXPECT_EQ(1, transport_conn_pool->last_num_streams());
+}
+
 TEST_P(HttpStreamFactoryTest, JobNotifiesProxy) {
   const char* kProxyString = "PROXY bad:99; PROXY maybe:80; DIRECT";
   SpdySessionDependencies session_deps(
@@ -809,6 +845,10 @@ TEST_P(HttpStreamFactoryTest, RequestHttpStream) {
   EXPECT_EQ(0, GetSocketPoolGroupCount(session->GetSSLSocketPool(
       HttpNetworkSession::WEBSOCKET_SOCKET_POOL)));
   EXPECT_TRUE(waiter.used_proxy_info().is_direct());
+
+  // The connection in use is remembered for later preconnects.
+  EXPECT_EQ(1, session->http_server_properties()->GetMaxConnectionsInUse(
+      HostPortPair("www.google.com", 80)));
 }
 
 TEST_P(HttpStreamFactoryTest, RequestHttpStreamOverSSL) {
@@ -573,7 +573,7 @@ int HttpStreamParser::DoReadHeadersComplete(int result) {
   DCHECK_LE(read_buf_->offset(), read_buf_->capacity());
   DCHECK_GE(result,  0);
 
-  int end_of_header_offset = ParseResponseHeaders();
+  int end_of_header_offset = ParseResponseHeaders(result);
 
   // Note: -1 is special, it indicates we haven't found the end of headers.
   // Anything less than -1 is a net::Error, so we bail out.
@@ -754,20 +754,28 @@ int HttpStreamParser::DoReadBodyComplete(int result) {
   return result;
 }
 
-int HttpStreamParser::ParseResponseHeaders() {
+int HttpStreamParser::ParseResponseHeaders(int new_bytes) {
   int end_offset = -1;
   DCHECK_EQ(0, read_buf_unused_offset_);
 
   // Look for the start of the status line, if it hasn't been found yet.
+  int search_start = -1;
   if (response_header_start_offset_ < 0) {
     response_header_start_offset_ = HttpUtil::LocateStartOfStatusLine(
         read_buf_->StartOfBuffer(), read_buf_->offset());
+    search_start = response_header_start_offset_;
+  } else {
+    // Everything before the new bytes was already searched without finding
+    // the end of the headers, so only rescan the last couple of those bytes,
+    // which may hold the start of a "\n\r\n" terminator.
+    search_start = std::max(response_header_start_offset_,
+                            read_buf_->offset() - new_bytes - 2);
   }
 
   if (response_header_start_offset_ >= 0) {
     end_offset = HttpUtil::LocateEndOfHeaders(read_buf_->StartOfBuffer(),
                                               read_buf_->offset(),
-                                              response_header_start_offset_);
+                                              search_start);
   } else if (read_buf_->offset() >= 8) {
     // Enough data to decide that this is an HTTP/0.9 response.
     // 8 bytes = (4 bytes of junk) + "http".length()
@@ -156,7 +156,9 @@ class NET_EXPORT_PRIVATE HttpStreamParser {
   // found, parse them with DoParseResponseHeaders().  Return the offset for
   // the end of the headers, or -1 if the complete headers were not found, or
   // with a net::Error if we encountered an error during parsing.
-  int ParseResponseHeaders();
+  // |new_bytes| is the number of bytes at the end of |read_buf_| that were
+  // read since the last call.
+  int ParseResponseHeaders(int new_bytes);
 
   // Parse the headers into response_.  Returns OK on success or a net::Error on
   // failure.
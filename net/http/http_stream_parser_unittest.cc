@@ -422,4 +422,55 @@ TEST(HttpStreamParser, TruncatedHeaders) {
   }
 }
 
+// Headers whose terminator is split over several reads should still be found
+// now that each read only rescans the end of the previous data.
+TEST(HttpStreamParser, HeaderTerminatorSplitAcrossReads) {
+  MockWrite writes[] = {
+    MockWrite(SYNCHRONOUS, 0, "GET / HTTP/1.1\r\n\r\n"),
+  };
+
+  MockRead reads[] = {
+    MockRead(SYNCHRONOUS, 1, "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n"),
+    MockRead(SYNCHRONOUS, 2, "\r"),
+    MockRead(SYNCHRONOUS, 3, "\n"),
+  };
+
+  DeterministicSocketData data(reads, arraysize(reads),
+                               writes, arraysize(writes));
+  data.set_connect_data(MockConnect(SYNCHRONOUS, OK));
+  data.SetStop(4);
+
+  scoped_ptr<DeterministicMockTCPClientSocket> transport(
+      new DeterministicMockTCPClientSocket(NULL, &data));
+  data.set_delegate(transport->AsWeakPtr());
+
+  TestCompletionCallback callback;
+  int rv = transport->Connect(callback.callback());
+  rv = callback.GetResult(rv);
+  ASSERT_EQ(OK, rv);
+
+  scoped_ptr<ClientSocketHandle> socket_handle(new ClientSocketHandle);
+  socket_handle->SetSocket(transport.PassAs<StreamSocket>());
+
+  HttpRequestInfo request_info;
+  request_info.method = "GET";
+  request_info.url = GURL("http://localhost");
+  request_info.load_flags = LOAD_NORMAL;
+
+  scoped_refptr<GrowableIOBuffer> read_buffer(new GrowableIOBuffer);
+  HttpStreamParser parser(
+      socket_handle.get(), &request_info, read_buffer.get(), BoundNetLog());
+
+  HttpRequestHeaders request_headers;
+  HttpResponseInfo response_info;
+  rv = parser.SendRequest("GET / HTTP/1.1\r\n", request_headers,
+                          &response_info, callback.callback());
+  ASSERT_EQ(OK, rv);
+
+  rv = parser.ReadResponseHeaders(callback.callback());
+  EXPECT_EQ(OK, rv);
+  ASSERT_TRUE(response_info.headers.get());
+  EXPECT_EQ(200, response_info.headers->response_code());
+}
+
 }  // namespace net
@@ -433,8 +433,11 @@ int MultiThreadedProxyResolver::GetProxyForURL(
   pending_jobs_.push_back(job);
 
   // If we haven't already reached the thread limit, provision a new thread to
-  // drain the requests more quickly.
-  if (executors_.size() < max_num_threads_) {
+  // drain the requests more quickly. Each new thread has to load the PAC
+  // script, so don't provision one if the threads already loading it will be
+  // enough to take every pending request.
+  if (executors_.size() < max_num_threads_ &&
+      pending_jobs_.size() > CountInitializingExecutors()) {
     executor = AddNewExecutor();
     executor->StartJob(
         new SetPacScriptJob(current_script_data_, CompletionCallback()));
@@ -555,6 +558,18 @@ MultiThreadedProxyResolver::FindIdleExecutor() {
   return NULL;
 }
 
+size_t MultiThreadedProxyResolver::CountInitializingExecutors() const {
+  DCHECK(CalledOnValidThread());
+  size_t count = 0;
+  for (ExecutorList::const_iterator it = executors_.begin();
+       it != executors_.end(); ++it) {
+    const Job* job = (*it)->outstanding_job();
+    if (job && job->type() == Job::TYPE_SET_PAC_SCRIPT)
+      ++count;
+  }
+  return count;
+}
+
 MultiThreadedProxyResolver::Executor*
 MultiThreadedProxyResolver::AddNewExecutor() {
   DCHECK(CalledOnValidThread());
@@ -125,6 +125,10 @@ class NET_EXPORT_PRIVATE MultiThreadedProxyResolver
   // requests. If all threads are occupied, returns NULL.
   Executor* FindIdleExecutor();
 
+  // Returns the number of worker threads which are still loading the PAC
+  // script, and so will soon be able to take a pending request.
+  size_t CountInitializingExecutors() const;
+
   // Creates a new worker thread, and appends it to |executors_|.
   Executor* AddNewExecutor();
 
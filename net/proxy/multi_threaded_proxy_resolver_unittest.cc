@@ -781,6 +781,64 @@ TEST(MultiThreadedProxyResolverTest, OneThreadBlocked) {
   EXPECT_EQ(3, factory->resolvers()[1]->request_count());
 }
 
+// Tests that a queued request doesn't provision another thread when a thread
+// which is still loading the PAC script can take it.
+TEST(MultiThreadedProxyResolverTest, NoExtraThreadWhileInitializing) {
+  const size_t kNumThreads = 3u;
+  BlockableProxyResolverFactory* factory = new BlockableProxyResolverFactory;
+  MultiThreadedProxyResolver resolver(factory, kNumThreads);
+
+  int rv;
+
+  TestCompletionCallback set_script_callback;
+  rv = resolver.SetPacScript(
+      ProxyResolverScriptData::FromUTF8("pac script bytes"),
+      set_script_callback.callback());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, set_script_callback.WaitForResult());
+  ASSERT_EQ(1u, factory->resolvers().size());
+
+  const int kNumRequests = 3;
+  TestCompletionCallback callback[kNumRequests];
+  ProxyInfo results[kNumRequests];
+  ProxyResolver::RequestHandle request[kNumRequests];
+
+  // Block the first thread with request 0.
+  factory->resolvers()[0]->Block();
+  rv = resolver.GetProxyForURL(
+      GURL("http://request0"), &results[0], callback[0].callback(), &request[0],
+      BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  factory->resolvers()[0]->WaitUntilBlocked();
+
+  // Request 1 is queued, and provisions a second thread.
+  rv = resolver.GetProxyForURL(
+      GURL("http://request1"), &results[1], callback[1].callback(), &request[1],
+      BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  ASSERT_EQ(2u, factory->resolvers().size());
+
+  // Cancelling request 1 leaves the second thread without a request, so it
+  // can take request 2 once it has loaded the script.
+  resolver.CancelRequest(request[1]);
+  rv = resolver.GetProxyForURL(
+      GURL("http://request2"), &results[2], callback[2].callback(), &request[2],
+      BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(2u, factory->resolvers().size());
+
+  EXPECT_EQ(0, callback[2].WaitForResult());
+  EXPECT_EQ("PROXY request2:80", results[2].ToPacString());
+
+  factory->resolvers()[0]->Unblock();
+  EXPECT_EQ(0, callback[0].WaitForResult());
+  EXPECT_FALSE(callback[1].have_result());
+
+  EXPECT_EQ(2u, factory->resolvers().size());
+  EXPECT_EQ(1, factory->resolvers()[0]->request_count());
+  EXPECT_EQ(1, factory->resolvers()[1]->request_count());
+}
+
 }  // namespace
 
 }  // namespace net
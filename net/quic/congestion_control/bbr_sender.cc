@@ -0,0 +1,394 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/congestion_control/bbr_sender.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace net {
+
+namespace {
+// 2/ln(2), the smallest gain that lets the sending rate double every round
+// trip during STARTUP.
+const float kHighGain = 2.885f;
+const float kDrainGain = 1.0f / kHighGain;
+// The pacing gains that PROBE_BW cycles through, one per min RTT: probe for
+// more bandwidth, drain the queue the probe built, then cruise.
+const float kPacingGainCycle[] = { 1.25f, 0.75f, 1, 1, 1, 1, 1, 1 };
+const int kGainCycleLength = arraysize(kPacingGainCycle);
+// Leaves room in PROBE_BW for delayed and aggregated acks.
+const float kCongestionWindowGain = 2.0f;
+// The number of round trips the max bandwidth filter covers.
+const int64 kBandwidthWindowSize = kGainCycleLength + 2;
+const int kMinRttExpirySeconds = 10;
+const int kProbeRttTimeMs = 200;
+// STARTUP ends once the bandwidth estimate has failed to grow by 25% for three
+// round trips.
+const float kStartupGrowthTarget = 1.25f;
+const int kRoundTripsWithoutGrowthBeforeExitingStartup = 3;
+const QuicByteCount kInitialCongestionWindowPackets = 10;
+const QuicByteCount kMinCongestionWindowPackets = 4;
+const int kInitialRttMs = 60;  // At a typical RTT 60 ms.
+const float kAlpha = 0.125f;
+const float kOneMinusAlpha = (1 - kAlpha);
+const float kBeta = 0.25f;
+const float kOneMinusBeta = (1 - kBeta);
+}  // namespace
+
+BbrSender::SendState::SendState(QuicTime sent_time,
+                                QuicByteCount bytes,
+                                QuicByteCount total_delivered,
+                                QuicTime last_delivered_time)
+    : sent_time(sent_time),
+      bytes(bytes),
+      total_delivered(total_delivered),
+      last_delivered_time(last_delivered_time) {
+}
+
+BbrSender::BbrSender(const QuicClock* clock)
+    : clock_(clock),
+      mode_(STARTUP),
+      max_segment_size_(kDefaultMaxPacketSize),
+      paced_sender_(QuicBandwidth::Zero(), max_segment_size_),
+      pacing_rate_(QuicBandwidth::FromBytesAndTimeDelta(
+          kInitialCongestionWindowPackets * kDefaultMaxPacketSize,
+          QuicTime::Delta::FromMilliseconds(kInitialRttMs)).Scale(kHighGain)),
+      bytes_in_flight_(0),
+      total_delivered_(0),
+      last_delivered_time_(QuicTime::Zero()),
+      round_trip_count_(0),
+      last_sent_sequence_number_(0),
+      current_round_trip_end_(0),
+      min_rtt_(QuicTime::Delta::Zero()),
+      min_rtt_timestamp_(QuicTime::Zero()),
+      smoothed_rtt_(QuicTime::Delta::Zero()),
+      mean_deviation_(QuicTime::Delta::Zero()),
+      pacing_gain_(kHighGain),
+      congestion_window_gain_(kHighGain),
+      bandwidth_at_last_round_(QuicBandwidth::Zero()),
+      rounds_without_bandwidth_gain_(0),
+      is_at_full_bandwidth_(false),
+      cycle_current_offset_(0),
+      last_cycle_start_(QuicTime::Zero()),
+      loss_in_cycle_phase_(false),
+      exit_probe_rtt_at_(QuicTime::Zero()),
+      probe_rtt_round_passed_(false) {
+  paced_sender_.UpdateBandwidthEstimate(clock_->Now(), pacing_rate_);
+}
+
+BbrSender::~BbrSender() {
+}
+
+void BbrSender::SetFromConfig(const QuicConfig& config, bool is_server) {
+  max_segment_size_ = config.server_max_packet_size();
+  paced_sender_.set_max_segment_size(max_segment_size_);
+}
+
+void BbrSender::OnIncomingQuicCongestionFeedbackFrame(
+    const QuicCongestionFeedbackFrame& /*feedback*/,
+    QuicTime /*feedback_receive_time*/,
+    const SentPacketsMap& /*sent_packets*/) {
+  // The model is driven by acks alone; the TCP feedback adds nothing to it.
+}
+
+void BbrSender::OnIncomingAck(QuicPacketSequenceNumber acked_sequence_number,
+                              QuicByteCount /*acked_bytes*/,
+                              QuicTime::Delta rtt) {
+  SendStateMap::iterator it = sent_packets_.find(acked_sequence_number);
+  if (it == sent_packets_.end()) {
+    // Sent before this sender took over the connection, or not tracked.
+    return;
+  }
+  const QuicTime now = clock_->Now();
+  const SendState& state = it->second;
+  DCHECK_GE(bytes_in_flight_, state.bytes);
+  bytes_in_flight_ -= state.bytes;
+  total_delivered_ += state.bytes;
+  last_delivered_time_ = now;
+
+  // The delivery rate over the time it took this packet to be acked.
+  QuicTime::Delta interval = now.Subtract(state.last_delivered_time);
+  if (!interval.IsZero()) {
+    UpdateMaxBandwidth(QuicBandwidth::FromBytesAndTimeDelta(
+        total_delivered_ - state.total_delivered, interval));
+  }
+  sent_packets_.erase(it);
+
+  bool is_round_start = false;
+  if (acked_sequence_number > current_round_trip_end_) {
+    ++round_trip_count_;
+    current_round_trip_end_ = last_sent_sequence_number_;
+    is_round_start = true;
+  }
+
+  bool min_rtt_expired = false;
+  if (!rtt.IsInfinite() && !rtt.IsZero()) {
+    min_rtt_expired = UpdateMinRtt(now, rtt);
+  }
+
+  if (mode_ == STARTUP && is_round_start) {
+    CheckIfFullBandwidthReached();
+    if (is_at_full_bandwidth_) {
+      DLOG(INFO) << "BBR; leaving startup at "
+                 << BandwidthEstimate().ToKBytesPerSecond() << " KB/s";
+      mode_ = DRAIN;
+      pacing_gain_ = kDrainGain;
+      congestion_window_gain_ = kHighGain;
+    }
+  }
+  if (mode_ == DRAIN && bytes_in_flight_ <= GetTargetCongestionWindow(1)) {
+    EnterProbeBandwidthMode(now);
+  }
+  if (mode_ == PROBE_BW) {
+    UpdateGainCyclePhase(now);
+  }
+  MaybeEnterOrExitProbeRtt(now, is_round_start, min_rtt_expired);
+  UpdatePacingRate(now);
+}
+
+void BbrSender::OnIncomingLoss(QuicTime /*ack_receive_time*/) {
+  // Loss is not a congestion signal for the model, but it does end a probe
+  // for more bandwidth early.
+  loss_in_cycle_phase_ = true;
+}
+
+bool BbrSender::OnPacketSent(
+    QuicTime sent_time,
+    QuicPacketSequenceNumber sequence_number,
+    QuicByteCount bytes,
+    TransmissionType /*transmission_type*/,
+    HasRetransmittableData has_retransmittable_data) {
+  // Only data packets count against the congestion window.
+  if (has_retransmittable_data != HAS_RETRANSMITTABLE_DATA) {
+    return false;
+  }
+  if (bytes_in_flight_ == 0) {
+    // Don't count the time the connection was idle against the delivery rate.
+    last_delivered_time_ = sent_time;
+  }
+  sent_packets_.insert(std::make_pair(
+      sequence_number,
+      SendState(sent_time, bytes, total_delivered_, last_delivered_time_)));
+  bytes_in_flight_ += bytes;
+  last_sent_sequence_number_ =
+      std::max(last_sent_sequence_number_, sequence_number);
+  paced_sender_.OnPacketSent(sent_time, bytes);
+  return true;
+}
+
+void BbrSender::OnPacketAbandoned(QuicPacketSequenceNumber sequence_number,
+                                  QuicByteCount /*abandoned_bytes*/) {
+  SendStateMap::iterator it = sent_packets_.find(sequence_number);
+  if (it == sent_packets_.end()) {
+    return;
+  }
+  DCHECK_GE(bytes_in_flight_, it->second.bytes);
+  bytes_in_flight_ -= it->second.bytes;
+  sent_packets_.erase(it);
+}
+
+QuicTime::Delta BbrSender::TimeUntilSend(
+    QuicTime now,
+    TransmissionType /*transmission_type*/,
+    HasRetransmittableData has_retransmittable_data,
+    IsHandshake handshake) {
+  if (has_retransmittable_data == NO_RETRANSMITTABLE_DATA ||
+      handshake == IS_HANDSHAKE) {
+    // ACKs and handshake packets are neither paced nor windowed.
+    return QuicTime::Delta::Zero();
+  }
+  if (bytes_in_flight_ >= GetCongestionWindow()) {
+    return QuicTime::Delta::Infinite();
+  }
+  return paced_sender_.TimeUntilSend(now, QuicTime::Delta::Zero());
+}
+
+QuicBandwidth BbrSender::BandwidthEstimate() {
+  if (max_bandwidth_.empty()) {
+    return QuicBandwidth::Zero();
+  }
+  return max_bandwidth_.front().second;
+}
+
+QuicTime::Delta BbrSender::SmoothedRtt() {
+  if (smoothed_rtt_.IsZero()) {
+    return QuicTime::Delta::FromMilliseconds(kInitialRttMs);
+  }
+  return smoothed_rtt_;
+}
+
+QuicTime::Delta BbrSender::RetransmissionDelay() {
+  return QuicTime::Delta::FromMicroseconds(
+      smoothed_rtt_.ToMicroseconds() + 4 * mean_deviation_.ToMicroseconds());
+}
+
+QuicByteCount BbrSender::GetCongestionWindow() {
+  if (mode_ == PROBE_RTT) {
+    return GetMinimumCongestionWindow();
+  }
+  QuicByteCount congestion_window =
+      GetTargetCongestionWindow(congestion_window_gain_);
+  if (mode_ == STARTUP) {
+    // Early samples underestimate the bandwidth; never shrink below the
+    // initial window while ramping up.
+    congestion_window = std::max(
+        congestion_window, kInitialCongestionWindowPackets * max_segment_size_);
+  }
+  return congestion_window;
+}
+
+void BbrSender::SetCongestionWindow(QuicByteCount /*window*/) {
+  // The window follows from the bandwidth and RTT estimates.
+}
+
+void BbrSender::UpdateMaxBandwidth(QuicBandwidth sample) {
+  while (!max_bandwidth_.empty() && max_bandwidth_.back().second <= sample) {
+    max_bandwidth_.pop_back();
+  }
+  max_bandwidth_.push_back(std::make_pair(round_trip_count_, sample));
+  while (max_bandwidth_.front().first + kBandwidthWindowSize <=
+         round_trip_count_) {
+    max_bandwidth_.pop_front();
+  }
+}
+
+bool BbrSender::UpdateMinRtt(QuicTime now, QuicTime::Delta rtt) {
+  bool min_rtt_expired = !min_rtt_.IsZero() &&
+      now > min_rtt_timestamp_.Add(
+          QuicTime::Delta::FromSeconds(kMinRttExpirySeconds));
+  if (min_rtt_.IsZero() || rtt <= min_rtt_ || min_rtt_expired) {
+    min_rtt_ = rtt;
+    min_rtt_timestamp_ = now;
+  }
+
+  // First time call.
+  if (smoothed_rtt_.IsZero()) {
+    smoothed_rtt_ = rtt;
+    mean_deviation_ = QuicTime::Delta::FromMicroseconds(
+        rtt.ToMicroseconds() / 2);
+  } else {
+    mean_deviation_ = QuicTime::Delta::FromMicroseconds(
+        kOneMinusBeta * mean_deviation_.ToMicroseconds() +
+        kBeta * abs(smoothed_rtt_.ToMicroseconds() - rtt.ToMicroseconds()));
+    smoothed_rtt_ = QuicTime::Delta::FromMicroseconds(
+        kOneMinusAlpha * smoothed_rtt_.ToMicroseconds() +
+        kAlpha * rtt.ToMicroseconds());
+  }
+  return min_rtt_expired;
+}
+
+void BbrSender::CheckIfFullBandwidthReached() {
+  QuicBandwidth target = bandwidth_at_last_round_.Scale(kStartupGrowthTarget);
+  QuicBandwidth bandwidth = BandwidthEstimate();
+  if (bandwidth >= target) {
+    bandwidth_at_last_round_ = bandwidth;
+    rounds_without_bandwidth_gain_ = 0;
+    return;
+  }
+  if (++rounds_without_bandwidth_gain_ >=
+      kRoundTripsWithoutGrowthBeforeExitingStartup) {
+    is_at_full_bandwidth_ = true;
+  }
+}
+
+void BbrSender::UpdateGainCyclePhase(QuicTime now) {
+  bool should_advance = now.Subtract(last_cycle_start_) > min_rtt_;
+  // Keep probing until the extra data is actually in flight, unless it has
+  // already caused losses.
+  if (pacing_gain_ > 1 && !loss_in_cycle_phase_ &&
+      bytes_in_flight_ < GetTargetCongestionWindow(pacing_gain_)) {
+    should_advance = false;
+  }
+  // Stop draining as soon as the queue is gone.
+  if (pacing_gain_ < 1 && bytes_in_flight_ <= GetTargetCongestionWindow(1)) {
+    should_advance = true;
+  }
+  if (should_advance) {
+    cycle_current_offset_ = (cycle_current_offset_ + 1) % kGainCycleLength;
+    last_cycle_start_ = now;
+    pacing_gain_ = kPacingGainCycle[cycle_current_offset_];
+    loss_in_cycle_phase_ = false;
+  }
+}
+
+void BbrSender::MaybeEnterOrExitProbeRtt(QuicTime now,
+                                         bool is_round_start,
+                                         bool min_rtt_expired) {
+  if (min_rtt_expired && mode_ != PROBE_RTT) {
+    DLOG(INFO) << "BBR; min RTT expired, entering PROBE_RTT";
+    mode_ = PROBE_RTT;
+    pacing_gain_ = 1;
+    exit_probe_rtt_at_ = QuicTime::Zero();
+  }
+  if (mode_ != PROBE_RTT) {
+    return;
+  }
+
+  if (!exit_probe_rtt_at_.IsInitialized()) {
+    // Wait for the data in flight to come down before timing the probe.
+    if (bytes_in_flight_ <= GetMinimumCongestionWindow()) {
+      exit_probe_rtt_at_ =
+          now.Add(QuicTime::Delta::FromMilliseconds(kProbeRttTimeMs));
+      probe_rtt_round_passed_ = false;
+    }
+    return;
+  }
+  if (is_round_start) {
+    probe_rtt_round_passed_ = true;
+  }
+  if (now >= exit_probe_rtt_at_ && probe_rtt_round_passed_) {
+    min_rtt_timestamp_ = now;
+    if (is_at_full_bandwidth_) {
+      EnterProbeBandwidthMode(now);
+    } else {
+      mode_ = STARTUP;
+      pacing_gain_ = kHighGain;
+      congestion_window_gain_ = kHighGain;
+    }
+  }
+}
+
+void BbrSender::EnterProbeBandwidthMode(QuicTime now) {
+  mode_ = PROBE_BW;
+  congestion_window_gain_ = kCongestionWindowGain;
+  // Start in a cruising phase; the probe comes around once the cycle wraps.
+  cycle_current_offset_ = 2;
+  last_cycle_start_ = now;
+  pacing_gain_ = kPacingGainCycle[cycle_current_offset_];
+  loss_in_cycle_phase_ = false;
+}
+
+void BbrSender::UpdatePacingRate(QuicTime now) {
+  QuicBandwidth bandwidth = BandwidthEstimate();
+  if (bandwidth.IsZero()) {
+    return;
+  }
+  QuicBandwidth pacing_rate = bandwidth.Scale(pacing_gain_);
+  if (!is_at_full_bandwidth_ && pacing_rate < pacing_rate_) {
+    // Don't slow down on the small samples of the first round trips.
+    return;
+  }
+  pacing_rate_ = pacing_rate;
+  paced_sender_.UpdateBandwidthEstimate(now, pacing_rate_);
+}
+
+QuicByteCount BbrSender::GetTargetCongestionWindow(float gain) const {
+  if (max_bandwidth_.empty() || min_rtt_.IsZero()) {
+    return kInitialCongestionWindowPackets * max_segment_size_;
+  }
+  QuicByteCount bandwidth_delay_product =
+      max_bandwidth_.front().second.ToBytesPerPeriod(min_rtt_);
+  return std::max(static_cast<QuicByteCount>(gain * bandwidth_delay_product),
+                  GetMinimumCongestionWindow());
+}
+
+QuicByteCount BbrSender::GetMinimumCongestionWindow() const {
+  return kMinCongestionWindowPackets * max_segment_size_;
+}
+
+}  // namespace net
@@ -0,0 +1,160 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Model based send side congestion algorithm.  Instead of reacting to loss it
+// estimates the bottleneck bandwidth (the maximum delivery rate seen over the
+// last few round trips) and the minimum RTT, paces at a gain of the bandwidth
+// estimate and caps the data in flight at a gain of their product.  It uses
+// the TCP congestion feedback, so only the sender needs to support it.
+
+#ifndef NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
+#define NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
+
+#include <deque>
+#include <map>
+#include <utility>
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "net/base/net_export.h"
+#include "net/quic/congestion_control/paced_sender.h"
+#include "net/quic/congestion_control/send_algorithm_interface.h"
+#include "net/quic/quic_bandwidth.h"
+#include "net/quic/quic_clock.h"
+#include "net/quic/quic_protocol.h"
+#include "net/quic/quic_time.h"
+
+namespace net {
+
+class NET_EXPORT_PRIVATE BbrSender : public SendAlgorithmInterface {
+ public:
+  enum Mode {
+    // Exponential growth until the bandwidth estimate stops growing.
+    STARTUP,
+    // Drains the queue built during STARTUP.
+    DRAIN,
+    // Cruises at the estimated bandwidth, periodically probing for more.
+    PROBE_BW,
+    // Briefly shrinks the window to refresh an expired min RTT.
+    PROBE_RTT,
+  };
+
+  explicit BbrSender(const QuicClock* clock);
+  virtual ~BbrSender();
+
+  virtual void SetFromConfig(const QuicConfig& config, bool is_server) OVERRIDE;
+
+  // Start implementation of SendAlgorithmInterface.
+  virtual void OnIncomingQuicCongestionFeedbackFrame(
+      const QuicCongestionFeedbackFrame& feedback,
+      QuicTime feedback_receive_time,
+      const SentPacketsMap& sent_packets) OVERRIDE;
+  virtual void OnIncomingAck(QuicPacketSequenceNumber acked_sequence_number,
+                             QuicByteCount acked_bytes,
+                             QuicTime::Delta rtt) OVERRIDE;
+  virtual void OnIncomingLoss(QuicTime ack_receive_time) OVERRIDE;
+  virtual bool OnPacketSent(
+      QuicTime sent_time,
+      QuicPacketSequenceNumber sequence_number,
+      QuicByteCount bytes,
+      TransmissionType transmission_type,
+      HasRetransmittableData has_retransmittable_data) OVERRIDE;
+  virtual void OnPacketAbandoned(QuicPacketSequenceNumber sequence_number,
+                                 QuicByteCount abandoned_bytes) OVERRIDE;
+  virtual QuicTime::Delta TimeUntilSend(
+      QuicTime now,
+      TransmissionType transmission_type,
+      HasRetransmittableData has_retransmittable_data,
+      IsHandshake handshake) OVERRIDE;
+  virtual QuicBandwidth BandwidthEstimate() OVERRIDE;
+  virtual QuicTime::Delta SmoothedRtt() OVERRIDE;
+  virtual QuicTime::Delta RetransmissionDelay() OVERRIDE;
+  virtual QuicByteCount GetCongestionWindow() OVERRIDE;
+  virtual void SetCongestionWindow(QuicByteCount window) OVERRIDE;
+  // End implementation of SendAlgorithmInterface.
+
+  Mode mode() const { return mode_; }
+  QuicTime::Delta min_rtt() const { return min_rtt_; }
+
+ private:
+  // What the sender knew about delivery when a packet was sent, used to
+  // compute a delivery rate sample once the packet is acked.
+  struct SendState {
+    SendState(QuicTime sent_time,
+              QuicByteCount bytes,
+              QuicByteCount total_delivered,
+              QuicTime last_delivered_time);
+
+    QuicTime sent_time;
+    QuicByteCount bytes;
+    QuicByteCount total_delivered;
+    QuicTime last_delivered_time;
+  };
+  typedef std::map<QuicPacketSequenceNumber, SendState> SendStateMap;
+  // Pairs of (round trip, bandwidth sample) with decreasing bandwidths, so the
+  // front is the maximum over the window.
+  typedef std::deque<std::pair<int64, QuicBandwidth> > BandwidthFilter;
+
+  void UpdateMaxBandwidth(QuicBandwidth sample);
+  // Returns true if the min RTT was older than its expiry time.
+  bool UpdateMinRtt(QuicTime now, QuicTime::Delta rtt);
+  void CheckIfFullBandwidthReached();
+  void UpdateGainCyclePhase(QuicTime now);
+  void MaybeEnterOrExitProbeRtt(QuicTime now,
+                                bool is_round_start,
+                                bool min_rtt_expired);
+  void EnterProbeBandwidthMode(QuicTime now);
+  void UpdatePacingRate(QuicTime now);
+
+  // Returns |gain| times the estimated bandwidth-delay product, or the initial
+  // window if there is no estimate yet.
+  QuicByteCount GetTargetCongestionWindow(float gain) const;
+  QuicByteCount GetMinimumCongestionWindow() const;
+
+  const QuicClock* clock_;
+  Mode mode_;
+  QuicByteCount max_segment_size_;
+  PacedSender paced_sender_;
+  QuicBandwidth pacing_rate_;
+
+  SendStateMap sent_packets_;
+  QuicByteCount bytes_in_flight_;
+  QuicByteCount total_delivered_;
+  QuicTime last_delivered_time_;
+
+  // A round trip ends when a packet sent after the start of the round is
+  // acked.
+  int64 round_trip_count_;
+  QuicPacketSequenceNumber last_sent_sequence_number_;
+  QuicPacketSequenceNumber current_round_trip_end_;
+
+  BandwidthFilter max_bandwidth_;
+  QuicTime::Delta min_rtt_;
+  QuicTime min_rtt_timestamp_;
+  QuicTime::Delta smoothed_rtt_;
+  QuicTime::Delta mean_deviation_;
+
+  float pacing_gain_;
+  float congestion_window_gain_;
+
+  // Used in STARTUP to detect when the bandwidth estimate has plateaued.
+  QuicBandwidth bandwidth_at_last_round_;
+  int rounds_without_bandwidth_gain_;
+  bool is_at_full_bandwidth_;
+
+  // Used in PROBE_BW.
+  int cycle_current_offset_;
+  QuicTime last_cycle_start_;
+  bool loss_in_cycle_phase_;
+
+  // Used in PROBE_RTT.  Zero until the data in flight has come down.
+  QuicTime exit_probe_rtt_at_;
+  bool probe_rtt_round_passed_;
+
+  DISALLOW_COPY_AND_ASSIGN(BbrSender);
+};
+
+}  // namespace net
+
+#endif  // NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
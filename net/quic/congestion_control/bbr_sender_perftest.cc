@@ -0,0 +1,82 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+
+#include "base/test/perf_log.h"
+#include "net/quic/congestion_control/bbr_sender.h"
+#include "net/quic/congestion_control/tcp_cubic_sender.h"
+#include "net/quic/test_tools/mock_clock.h"
+#include "net/quic/test_tools/send_algorithm_simulator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+namespace {
+
+const QuicTcpCongestionWindow kMaxTcpCongestionWindow = 200;
+
+struct LinkParameters {
+  const char* name;
+  int64 bandwidth_kbytes_per_second;
+  int64 one_way_delay_ms;
+  // As a multiple of the bandwidth-delay product.
+  float buffer_size_in_bdp;
+  float loss_rate;
+};
+
+const LinkParameters kLinks[] = {
+  { "wired", 1250, 10, 1, 0 },
+  { "deep_buffer", 1250, 10, 8, 0 },
+  { "cellular", 250, 50, 4, 0.01f },
+  { "lossy_cellular", 125, 75, 4, 0.05f },
+};
+
+// Transfers 5MB over |link| with |sender| and logs the goodput, the average
+// RTT and the loss rate that it reached.
+void SimulateTransfer(const LinkParameters& link,
+                      const std::string& sender_name,
+                      MockClock* clock,
+                      SendAlgorithmInterface* sender) {
+  QuicBandwidth bandwidth =
+      QuicBandwidth::FromKBytesPerSecond(link.bandwidth_kbytes_per_second);
+  QuicTime::Delta one_way_delay =
+      QuicTime::Delta::FromMilliseconds(link.one_way_delay_ms);
+  QuicByteCount buffer_size = link.buffer_size_in_bdp *
+      bandwidth.ToBytesPerPeriod(one_way_delay.Add(one_way_delay));
+  SendAlgorithmSimulator simulator(clock, sender, bandwidth, one_way_delay,
+                                   buffer_size, link.loss_rate);
+  simulator.TransferBytes(5 * 1000 * 1000);
+
+  std::string test_name = std::string(link.name) + "_" + sender_name;
+  base::LogPerfResult((test_name + "_goodput").c_str(),
+                      simulator.Goodput().ToKBytesPerSecond(), "KB/s");
+  base::LogPerfResult((test_name + "_average_rtt").c_str(),
+                      simulator.AverageRtt().ToMilliseconds(), "ms");
+  base::LogPerfResult((test_name + "_packets_lost").c_str(),
+                      simulator.packets_lost() * 100.0 /
+                          std::max<size_t>(simulator.packets_sent(), 1),
+                      "%");
+  EXPECT_LT(0, simulator.Goodput().ToKBytesPerSecond());
+}
+
+// Compares BBR with Cubic on a set of simulated links.
+TEST(BbrSenderPerfTest, CompareWithCubic) {
+  for (size_t i = 0; i < arraysize(kLinks); ++i) {
+    MockClock bbr_clock;
+    bbr_clock.AdvanceTime(QuicTime::Delta::FromMilliseconds(1));
+    BbrSender bbr(&bbr_clock);
+    SimulateTransfer(kLinks[i], "bbr", &bbr_clock, &bbr);
+
+    MockClock cubic_clock;
+    cubic_clock.AdvanceTime(QuicTime::Delta::FromMilliseconds(1));
+    TcpCubicSender cubic(&cubic_clock, false, kMaxTcpCongestionWindow);
+    SimulateTransfer(kLinks[i], "cubic", &cubic_clock, &cubic);
+  }
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
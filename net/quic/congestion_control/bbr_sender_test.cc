@@ -0,0 +1,116 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/congestion_control/bbr_sender.h"
+
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "net/quic/test_tools/mock_clock.h"
+#include "net/quic/test_tools/send_algorithm_simulator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+class BbrSenderTest : public ::testing::Test {
+ protected:
+  BbrSenderTest()
+      : bandwidth_(QuicBandwidth::FromKBytesPerSecond(1000)),
+        one_way_delay_(QuicTime::Delta::FromMilliseconds(20)),
+        sender_(new BbrSender(&clock_)) {
+    // Make sure clock does not start at 0.
+    clock_.AdvanceTime(QuicTime::Delta::FromMilliseconds(1));
+  }
+
+  // A buffer of |bdp_multiple| times the bandwidth-delay product of the link.
+  QuicByteCount BufferSize(float bdp_multiple) {
+    return bdp_multiple * bandwidth_.ToBytesPerPeriod(
+        one_way_delay_.Add(one_way_delay_));
+  }
+
+  const QuicBandwidth bandwidth_;
+  const QuicTime::Delta one_way_delay_;
+  MockClock clock_;
+  scoped_ptr<BbrSender> sender_;
+};
+
+TEST_F(BbrSenderTest, InitialWindowIsPaced) {
+  QuicPacketSequenceNumber sequence_number = 1;
+  while (sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                HAS_RETRANSMITTABLE_DATA,
+                                NOT_HANDSHAKE).IsZero()) {
+    sender_->OnPacketSent(clock_.Now(), sequence_number++,
+                          kDefaultMaxPacketSize, NOT_RETRANSMISSION,
+                          HAS_RETRANSMITTABLE_DATA);
+  }
+  // Only a short burst goes out before the pacer kicks in.
+  EXPECT_GT(sequence_number, 2u);
+  EXPECT_LT(sequence_number, 10u);
+  QuicTime::Delta delay = sender_->TimeUntilSend(
+      clock_.Now(), NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA,
+      NOT_HANDSHAKE);
+  EXPECT_FALSE(delay.IsInfinite());
+
+  // Acks and handshake packets are never held back.
+  EXPECT_TRUE(sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                     NO_RETRANSMITTABLE_DATA,
+                                     NOT_HANDSHAKE).IsZero());
+  EXPECT_TRUE(sender_->TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                     HAS_RETRANSMITTABLE_DATA,
+                                     IS_HANDSHAKE).IsZero());
+}
+
+TEST_F(BbrSenderTest, IgnoresAcksForUnknownPackets) {
+  sender_->OnPacketSent(clock_.Now(), 2, kDefaultMaxPacketSize,
+                        NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA);
+  clock_.AdvanceTime(QuicTime::Delta::FromMilliseconds(40));
+  // Packet 1 was sent by the algorithm this one replaced.
+  sender_->OnIncomingAck(1, kDefaultMaxPacketSize,
+                         QuicTime::Delta::FromMilliseconds(40));
+  EXPECT_TRUE(sender_->BandwidthEstimate().IsZero());
+  sender_->OnIncomingAck(2, kDefaultMaxPacketSize,
+                         QuicTime::Delta::FromMilliseconds(40));
+  EXPECT_FALSE(sender_->BandwidthEstimate().IsZero());
+  EXPECT_EQ(40, sender_->min_rtt().ToMilliseconds());
+}
+
+TEST_F(BbrSenderTest, ConvergesToLinkBandwidth) {
+  SendAlgorithmSimulator simulator(&clock_, sender_.get(), bandwidth_,
+                                   one_way_delay_, BufferSize(2), 0);
+  simulator.TransferBytes(10 * 1000 * 1000);
+
+  EXPECT_EQ(BbrSender::PROBE_BW, sender_->mode());
+  EXPECT_NEAR(bandwidth_.ToKBytesPerSecond(),
+              sender_->BandwidthEstimate().ToKBytesPerSecond(),
+              bandwidth_.ToKBytesPerSecond() / 10);
+  EXPECT_LT(bandwidth_.ToKBytesPerSecond() * 8 / 10,
+            simulator.Goodput().ToKBytesPerSecond());
+  // The queue is kept short, so the RTT stays close to the propagation delay.
+  EXPECT_NEAR(40, sender_->min_rtt().ToMilliseconds(), 5);
+  EXPECT_LT(simulator.AverageRtt().ToMilliseconds(), 80);
+}
+
+TEST_F(BbrSenderTest, KeepsRateUnderRandomLoss) {
+  SendAlgorithmSimulator simulator(&clock_, sender_.get(), bandwidth_,
+                                   one_way_delay_, BufferSize(2), 0.02f);
+  simulator.TransferBytes(10 * 1000 * 1000);
+
+  EXPECT_LT(0u, simulator.packets_lost());
+  EXPECT_LT(bandwidth_.ToKBytesPerSecond() * 7 / 10,
+            simulator.Goodput().ToKBytesPerSecond());
+}
+
+TEST_F(BbrSenderTest, RefreshesMinRtt) {
+  SendAlgorithmSimulator simulator(&clock_, sender_.get(), bandwidth_,
+                                   one_way_delay_, BufferSize(2), 0);
+  // Long enough for the min RTT to expire at least once.
+  simulator.TransferBytes(25 * 1000 * 1000);
+
+  EXPECT_NE(BbrSender::STARTUP, sender_->mode());
+  EXPECT_NEAR(40, sender_->min_rtt().ToMilliseconds(), 5);
+  EXPECT_LT(bandwidth_.ToKBytesPerSecond() * 8 / 10,
+            simulator.Goodput().ToKBytesPerSecond());
+}
+
+}  // namespace test
+}  // namespace net
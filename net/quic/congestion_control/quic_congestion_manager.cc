@@ -8,8 +8,10 @@
 #include <map>
 
 #include "base/stl_util.h"
+#include "net/quic/congestion_control/bbr_sender.h"
 #include "net/quic/congestion_control/receive_algorithm_interface.h"
 #include "net/quic/congestion_control/send_algorithm_interface.h"
+#include "net/quic/crypto/crypto_protocol.h"
 
 namespace {
 static const int kBitrateSmoothingPeriodMs = 1000;
@@ -40,6 +42,8 @@ QuicCongestionManager::QuicCongestionManager(
     : clock_(clock),
       receive_algorithm_(ReceiveAlgorithmInterface::Create(clock, type)),
       send_algorithm_(SendAlgorithmInterface::Create(clock, type)),
+      congestion_type_(type),
+      using_bbr_sender_(false),
       largest_missing_(0),
       current_rtt_(QuicTime::Delta::Infinite()) {
 }
@@ -58,6 +62,14 @@ void QuicCongestionManager::SetFromConfig(const QuicConfig& config,
     current_rtt_ =
         QuicTime::Delta::FromMicroseconds(config.initial_round_trip_time_us());
   }
+  // The BBR sender works from the TCP feedback, so it can replace the TCP
+  // sender without the receiver knowing.  Packets sent before the switch are
+  // not known to it and are ignored when acked.
+  if (config.congestion_control() == kTBBR && congestion_type_ == kTCP &&
+      !using_bbr_sender_) {
+    send_algorithm_.reset(new BbrSender(clock_));
+    using_bbr_sender_ = true;
+  }
   send_algorithm_->SetFromConfig(config, is_server);
 }
 
@@ -118,6 +118,9 @@ class NET_EXPORT_PRIVATE QuicCongestionManager {
   const QuicClock* clock_;
   scoped_ptr<ReceiveAlgorithmInterface> receive_algorithm_;
   scoped_ptr<SendAlgorithmInterface> send_algorithm_;
+  const CongestionFeedbackType congestion_type_;
+  // True once the config has switched |send_algorithm_| to a BbrSender.
+  bool using_bbr_sender_;
   SendAlgorithmInterface::SentPacketsMap packet_history_map_;
   PendingPacketsMap pending_packets_;
   QuicPacketSequenceNumber largest_missing_;
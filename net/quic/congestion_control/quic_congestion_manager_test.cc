@@ -6,6 +6,9 @@
 #include "base/memory/scoped_ptr.h"
 #include "net/quic/congestion_control/inter_arrival_sender.h"
 #include "net/quic/congestion_control/quic_congestion_manager.h"
+#include "net/quic/congestion_control/tcp_cubic_sender.h"
+#include "net/quic/crypto/crypto_protocol.h"
+#include "net/quic/quic_config.h"
 #include "net/quic/quic_protocol.h"
 #include "net/quic/test_tools/mock_clock.h"
 #include "net/quic/test_tools/quic_test_utils.h"
@@ -243,5 +246,18 @@ TEST_F(QuicCongestionManagerTest, RttZeroDelta) {
   EXPECT_EQ(manager_->rtt(), expected_rtt);
 }
 
+TEST_F(QuicCongestionManagerTest, BbrSenderFromConfig) {
+  SetUpCongestionType(kTCP);
+  QuicConfig config;
+  config.SetDefaults();
+  manager_->SetFromConfig(config, true);
+  EXPECT_EQ(10 * kDefaultTCPMSS, manager_->GetCongestionWindow());
+
+  config.set_congestion_control(QuicTagVector(1, kTBBR), kTBBR);
+  manager_->SetFromConfig(config, true);
+  // The BBR sender starts with ten packets of the configured size.
+  EXPECT_EQ(10 * kDefaultMaxPacketSize, manager_->GetCongestionWindow());
+}
+
 }  // namespace test
 }  // namespace net
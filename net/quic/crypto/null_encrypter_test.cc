@@ -52,6 +52,22 @@ TEST_P(NullEncrypterTest, Encrypt) {
   }
 }
 
+TEST_P(NullEncrypterTest, EncryptPacketToBuffer) {
+  NullEncrypter encrypter(GetParam());
+  scoped_ptr<QuicData> encrypted(
+      encrypter.EncryptPacket(0, "hello world!", "goodbye!"));
+  ASSERT_TRUE(encrypted.get());
+
+  const size_t len = encrypter.GetCiphertextSize(8);
+  ASSERT_EQ(encrypted->length(), len);
+  scoped_ptr<char[]> buffer(new char[len]);
+  ASSERT_TRUE(encrypter.EncryptPacketToBuffer(0, "hello world!", "goodbye!",
+                                              buffer.get()));
+  test::CompareCharArraysWithHexError(
+      "encrypted data", buffer.get(), len, encrypted->data(),
+      encrypted->length());
+}
+
 TEST_P(NullEncrypterTest, GetMaxPlaintextSize) {
   NullEncrypter encrypter(GetParam());
   if (GetParam()) {
@@ -30,6 +30,7 @@ class QuicDecrypter;
 class QuicEncrypter;
 class QuicRandom;
 class QuicServerConfigProtobuf;
+class ShardedStrikeRegister;
 class StrikeRegister;
 
 struct ClientHelloInfo;
@@ -172,6 +173,12 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   // means that the quiescent startup period must be longer.
   void set_strike_register_window_secs(uint32 window_secs);
 
+  // set_strike_register_num_shards sets the number of independently locked
+  // shards that the strike register's entries are split across. Servers which
+  // process client hellos on several threads should use about one shard per
+  // thread.
+  void set_strike_register_num_shards(uint32 num_shards);
+
   // set_source_address_token_future_secs sets the number of seconds into the
   // future that source-address tokens will be accepted from. Since
   // source-address tokens are authenticated, this should only happen if
@@ -322,10 +329,12 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   // active config will be promoted to primary.
   mutable QuicWallTime next_config_promotion_time_;
 
+  // strike_register_lock_ only guards the creation of |strike_register_|,
+  // which does its own locking.
   mutable base::Lock strike_register_lock_;
   // strike_register_ contains a data structure that keeps track of previously
   // observed client nonces in order to prevent replay attacks.
-  mutable scoped_ptr<StrikeRegister> strike_register_;
+  mutable scoped_ptr<ShardedStrikeRegister> strike_register_;
 
   // source_address_token_boxer_ is used to protect the source-address tokens
   // that are given to clients.
@@ -359,6 +368,7 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   bool strike_register_no_startup_period_;
   uint32 strike_register_max_entries_;
   uint32 strike_register_window_secs_;
+  uint32 strike_register_num_shards_;
   uint32 source_address_token_future_secs_;
   uint32 source_address_token_lifetime_secs_;
   uint32 server_nonce_strike_register_max_entries_;
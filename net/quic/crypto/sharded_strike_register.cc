@@ -0,0 +1,183 @@
+// Copyright (c) 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/crypto/sharded_strike_register.h"
+
+#include <algorithm>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/rand_util.h"
+#include "base/synchronization/lock.h"
+
+namespace net {
+
+namespace {
+
+// Each of the two generations of a bloom filter has this many bits per entry
+// in its shard. With kNumBloomHashes hashes that is a false positive rate of
+// about 0.2% for a full generation.
+const uint32 kBloomBitsPerEntry = 16;
+const unsigned kNumBloomHashes = 4;
+
+const uint64 kFNVOffsetBasis = GG_UINT64_C(14695981039346656037);
+const uint64 kFNVPrime = GG_UINT64_C(1099511628211);
+
+}  // namespace
+
+// BloomFilter is a pair of bloom filters over the nonces most recently
+// inserted into a shard. New nonces go into the current generation; when that
+// holds as many nonces as the shard, the older generation is cleared and
+// becomes the current one. Only the shard's lock holder modifies it, but it is
+// read without a lock, so all accesses to the bits are atomic.
+class ShardedStrikeRegister::BloomFilter {
+ public:
+  BloomFilter()
+      : capacity_(0),
+        num_bits_(0),
+        current_(0),
+        insertions_(0) {
+  }
+
+  void Init(uint32 capacity) {
+    capacity_ = capacity;
+    const uint32 num_words = std::max<uint32>(
+        1, (capacity * kBloomBitsPerEntry + 31) / 32);
+    num_bits_ = num_words * 32;
+    for (int i = 0; i < 2; ++i) {
+      generations_[i].reset(new base::subtle::Atomic32[num_words]);
+      Clear(i);
+    }
+  }
+
+  // MightContain returns false if the nonce with hashes |h1| and |h2| was
+  // definitely not added to either generation. It doesn't need the lock.
+  bool MightContain(uint64 h1, uint64 h2) const {
+    for (int i = 0; i < 2; ++i) {
+      bool all_set = true;
+      for (unsigned j = 0; j < kNumBloomHashes && all_set; ++j) {
+        const uint32 bit = (h1 + j * h2) % num_bits_;
+        all_set = (base::subtle::NoBarrier_Load(&generations_[i][bit / 32]) &
+                   (1u << (bit % 32))) != 0;
+      }
+      if (all_set) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Add records the nonce with hashes |h1| and |h2|. The caller must hold the
+  // shard's lock.
+  void Add(uint64 h1, uint64 h2) {
+    if (insertions_ >= capacity_) {
+      current_ ^= 1;
+      Clear(current_);
+      insertions_ = 0;
+    }
+    base::subtle::Atomic32* bits = generations_[current_].get();
+    for (unsigned j = 0; j < kNumBloomHashes; ++j) {
+      const uint32 bit = (h1 + j * h2) % num_bits_;
+      const base::subtle::Atomic32 word =
+          base::subtle::NoBarrier_Load(&bits[bit / 32]);
+      base::subtle::NoBarrier_Store(&bits[bit / 32],
+                                    word | (1u << (bit % 32)));
+    }
+    insertions_++;
+  }
+
+ private:
+  void Clear(int generation) {
+    for (uint32 i = 0; i < num_bits_ / 32; ++i) {
+      base::subtle::NoBarrier_Store(&generations_[generation][i], 0);
+    }
+  }
+
+  uint32 capacity_;
+  uint32 num_bits_;
+  int current_;
+  uint32 insertions_;
+  scoped_ptr<base::subtle::Atomic32[]> generations_[2];
+
+  DISALLOW_COPY_AND_ASSIGN(BloomFilter);
+};
+
+struct ShardedStrikeRegister::Shard {
+  base::Lock lock;
+  scoped_ptr<StrikeRegister> strike_register;
+  BloomFilter bloom_filter;
+};
+
+ShardedStrikeRegister::ShardedStrikeRegister(
+    unsigned num_shards,
+    unsigned max_entries,
+    uint32 current_time,
+    uint32 window_secs,
+    const uint8 orbit[8],
+    StrikeRegister::StartupType startup)
+    : num_shards_(std::max(1u, num_shards)),
+      window_secs_(window_secs),
+      hash_key_(base::RandUint64()) {
+  memcpy(orbit_, orbit, sizeof(orbit_));
+  const unsigned max_entries_per_shard =
+      std::max(2u, max_entries / num_shards_);
+  for (unsigned i = 0; i < num_shards_; ++i) {
+    Shard* shard = new Shard;
+    shard->strike_register.reset(new StrikeRegister(
+        max_entries_per_shard, current_time, window_secs, orbit, startup));
+    shard->bloom_filter.Init(max_entries_per_shard);
+    shards_.push_back(shard);
+  }
+}
+
+ShardedStrikeRegister::~ShardedStrikeRegister() {
+}
+
+bool ShardedStrikeRegister::Insert(const uint8 nonce[32],
+                                   const uint32 current_time) {
+  // The orbit and time window checks are repeated by StrikeRegister, but
+  // doing them first saves taking a lock for nonces that can never be valid.
+  if (memcmp(nonce + sizeof(current_time), orbit_, sizeof(orbit_))) {
+    return false;
+  }
+  const uint64 nonce_time = static_cast<uint64>(nonce[0]) << 24 |
+                            static_cast<uint64>(nonce[1]) << 16 |
+                            static_cast<uint64>(nonce[2]) << 8 |
+                            static_cast<uint64>(nonce[3]);
+  if (nonce_time + window_secs_ < current_time ||
+      nonce_time > static_cast<uint64>(current_time) + window_secs_) {
+    return false;
+  }
+
+  Shard* shard = shards_[Hash(nonce, 0) % num_shards_];
+  const uint64 h1 = Hash(nonce, 1);
+  const uint64 h2 = Hash(nonce, 2);
+  if (shard->bloom_filter.MightContain(h1, h2)) {
+    return false;
+  }
+
+  base::AutoLock locked(shard->lock);
+  if (!shard->strike_register->Insert(nonce, current_time)) {
+    return false;
+  }
+  shard->bloom_filter.Add(h1, h2);
+  return true;
+}
+
+const uint8* ShardedStrikeRegister::orbit() const {
+  return orbit_;
+}
+
+uint64 ShardedStrikeRegister::Hash(const uint8 nonce[32], unsigned n) const {
+  // FNV-1a, keyed by starting from a secret offset.
+  uint64 hash = kFNVOffsetBasis ^ hash_key_ ^ (n * kFNVPrime);
+  for (unsigned i = 0; i < 32; ++i) {
+    hash ^= nonce[i];
+    hash *= kFNVPrime;
+  }
+  return hash;
+}
+
+}  // namespace net
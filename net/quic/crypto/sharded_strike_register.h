@@ -0,0 +1,75 @@
+// Copyright (c) 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_QUIC_CRYPTO_SHARDED_STRIKE_REGISTER_H_
+#define NET_QUIC_CRYPTO_SHARDED_STRIKE_REGISTER_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
+#include "net/base/net_export.h"
+#include "net/quic/crypto/strike_register.h"
+
+namespace net {
+
+// A ShardedStrikeRegister is a thread-safe set of observed nonces, built from
+// several StrikeRegisters which each have their own lock. A nonce is assigned
+// to a shard by a keyed hash of its random bytes, so concurrent client hellos
+// rarely contend on the same lock.
+//
+// Some nonces are rejected without taking any lock:
+//   1) nonces for the wrong orbit, or outside of the time window, since those
+//      checks don't depend on the contents of the set.
+//   2) nonces that hit the shard's bloom filter of recently inserted nonces.
+//      A bloom filter has false positives, but never false negatives, and it
+//      is always safe to reject a nonce, so a replayed client hello is turned
+//      away cheaply. A falsely rejected client simply falls back to a server
+//      nonce.
+// Everything else takes the shard lock and is inserted into that shard's
+// StrikeRegister, which remains authoritative.
+class NET_EXPORT_PRIVATE ShardedStrikeRegister {
+ public:
+  // Constructs |num_shards| StrikeRegisters which, between them, hold at most
+  // |max_entries| nonces. The remaining arguments are as for StrikeRegister.
+  // Each shard holds at least two entries.
+  ShardedStrikeRegister(unsigned num_shards,
+                        unsigned max_entries,
+                        uint32 current_time,
+                        uint32 window_secs,
+                        const uint8 orbit[8],
+                        StrikeRegister::StartupType startup);
+
+  ~ShardedStrikeRegister();
+
+  // |Insert| has the same semantics as StrikeRegister::Insert but may be
+  // called concurrently from any thread.
+  bool Insert(const uint8 nonce[32], const uint32 current_time);
+
+  // orbit returns a pointer to the 8-byte orbit value for this
+  // strike-register.
+  const uint8* orbit() const;
+
+  unsigned num_shards() const { return num_shards_; }
+
+ private:
+  class BloomFilter;
+  struct Shard;
+
+  // Hash returns a keyed hash of |nonce|, with a different key for each
+  // value of |n|.
+  uint64 Hash(const uint8 nonce[32], unsigned n) const;
+
+  const unsigned num_shards_;
+  const uint32 window_secs_;
+  uint8 orbit_[8];
+  // hash_key_ is random so that clients can't choose nonces which all land in
+  // one shard or collide in the bloom filters.
+  const uint64 hash_key_;
+  ScopedVector<Shard> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedStrikeRegister);
+};
+
+}  // namespace net
+
+#endif  // NET_QUIC_CRYPTO_SHARDED_STRIKE_REGISTER_H_
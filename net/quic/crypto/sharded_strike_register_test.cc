@@ -0,0 +1,154 @@
+// Copyright (c) 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/crypto/sharded_strike_register.h"
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+using net::ShardedStrikeRegister;
+using net::StrikeRegister;
+
+const uint8 kOrbit[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+// Sets the time and orbit of |nonce|, and its random bytes from |id|.
+void SetNonce(uint8 nonce[32], unsigned time, const uint8 orbit[8],
+              uint32 id) {
+  nonce[0] = time >> 24;
+  nonce[1] = time >> 16;
+  nonce[2] = time >> 8;
+  nonce[3] = time;
+  memcpy(nonce + 4, orbit, 8);
+  memset(nonce + 12, 0, 20);
+  memcpy(nonce + 12, &id, sizeof(id));
+}
+
+TEST(ShardedStrikeRegisterTest, RejectDuplicate) {
+  ShardedStrikeRegister set(4 /* shards */, 100 /* max size */,
+                            1000 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+  EXPECT_EQ(4u, set.num_shards());
+  EXPECT_EQ(0, memcmp(kOrbit, set.orbit(), sizeof(kOrbit)));
+
+  uint8 nonce[32];
+  for (uint32 i = 0; i < 20; i++) {
+    SetNonce(nonce, 1101, kOrbit, i);
+    EXPECT_TRUE(set.Insert(nonce, 1100));
+    EXPECT_FALSE(set.Insert(nonce, 1100));
+  }
+}
+
+TEST(ShardedStrikeRegisterTest, RejectWithoutLookup) {
+  ShardedStrikeRegister set(4 /* shards */, 100 /* max size */,
+                            1000 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::DENY_REQUESTS_AT_STARTUP);
+  uint8 nonce[32];
+  static const uint8 kBadOrbit[8] = { 0, 0, 0, 0, 1, 1, 1, 1 };
+  SetNonce(nonce, 1101, kBadOrbit, 0);
+  EXPECT_FALSE(set.Insert(nonce, 1100));
+  // Outside the window, in either direction.
+  SetNonce(nonce, 1201, kOrbit, 0);
+  EXPECT_FALSE(set.Insert(nonce, 1100));
+  SetNonce(nonce, 999, kOrbit, 0);
+  EXPECT_FALSE(set.Insert(nonce, 1100));
+  // Before the startup horizon.
+  SetNonce(nonce, 1050, kOrbit, 0);
+  EXPECT_FALSE(set.Insert(nonce, 1100));
+}
+
+TEST(ShardedStrikeRegisterTest, NoStartupMode) {
+  ShardedStrikeRegister set(2 /* shards */, 10 /* max size */,
+                            0 /* current time */, 100 /* window secs */,
+                            kOrbit, StrikeRegister::NO_STARTUP_PERIOD_NEEDED);
+  uint8 nonce[32];
+  SetNonce(nonce, 0, kOrbit, 0);
+  EXPECT_TRUE(set.Insert(nonce, 0));
+  EXPECT_FALSE(set.Insert(nonce, 0));
+}
+
+TEST(ShardedStrikeRegisterTest, InsertMany) {
+  // Far more nonces than fit, so shards evict and the bloom filters rotate.
+  // A nonce is never accepted twice, and most fresh ones are accepted.
+  ShardedStrikeRegister set(8 /* shards */, 4096 /* max size */,
+                            1000 /* current time */, 500 /* window secs */,
+                            kOrbit, StrikeRegister::NO_STARTUP_PERIOD_NEEDED);
+  uint8 nonce[32];
+  unsigned accepted = 0;
+  for (uint32 i = 0; i < 100000; i++) {
+    SetNonce(nonce, 1101 + i / 500, kOrbit, i);
+    if (set.Insert(nonce, 1100)) {
+      accepted++;
+      EXPECT_FALSE(set.Insert(nonce, 1100));
+    }
+  }
+  EXPECT_LT(90000u, accepted);
+}
+
+// Inserts the same |num_nonces| nonces as every other InsertThread, and counts
+// the ones that it was first to insert.
+class InsertThread : public base::SimpleThread {
+ public:
+  InsertThread(const std::string& name,
+               ShardedStrikeRegister* set,
+               uint32 num_nonces)
+      : SimpleThread(name),
+        set_(set),
+        num_nonces_(num_nonces),
+        accepted_(0) {
+  }
+
+  virtual void Run() OVERRIDE {
+    uint8 nonce[32];
+    for (uint32 i = 0; i < num_nonces_; i++) {
+      SetNonce(nonce, 1101, kOrbit, i);
+      if (set_->Insert(nonce, 1100)) {
+        accepted_++;
+      }
+    }
+  }
+
+  uint32 accepted() const { return accepted_; }
+
+ private:
+  ShardedStrikeRegister* set_;
+  const uint32 num_nonces_;
+  uint32 accepted_;
+
+  DISALLOW_COPY_AND_ASSIGN(InsertThread);
+};
+
+TEST(ShardedStrikeRegisterTest, ConcurrentInsert) {
+  const uint32 kNumNonces = 2000;
+  const int kNumThreads = 4;
+  ShardedStrikeRegister set(kNumThreads, 2 * kNumNonces,
+                            1000 /* current time */, 500 /* window secs */,
+                            kOrbit, StrikeRegister::NO_STARTUP_PERIOD_NEEDED);
+
+  ScopedVector<InsertThread> threads;
+  for (int i = 0; i < kNumThreads; i++) {
+    threads.push_back(new InsertThread("insert_" + base::IntToString(i), &set,
+                                       kNumNonces));
+  }
+  for (int i = 0; i < kNumThreads; i++)
+    threads[i]->Start();
+  uint32 accepted = 0;
+  for (int i = 0; i < kNumThreads; i++) {
+    threads[i]->Join();
+    accepted += threads[i]->accepted();
+  }
+
+  // Each nonce is accepted by at most one thread. The set has room for all
+  // of them, so only bloom filter false positives are rejected.
+  EXPECT_GE(kNumNonces, accepted);
+  EXPECT_LT(kNumNonces * 95 / 100, accepted);
+}
+
+}  // namespace
@@ -439,6 +439,16 @@ bool QuicConnection::OnPacketHeader(const QuicPacketHeader& header) {
     return false;
   }
 
+  if (!received_packet_manager_.HasRoomForPacket(
+          header.packet_sequence_number)) {
+    DLOG(INFO) << ENDPOINT << "Packet " << header.packet_sequence_number
+               << " leaves too many packets outstanding.  Closing.";
+    SendConnectionCloseWithDetails(
+        QUIC_TOO_MANY_OUTSTANDING_RECEIVED_PACKETS,
+        "Too many outstanding received packets");
+    return false;
+  }
+
   if (version_negotiation_state_ != NEGOTIATED_VERSION) {
     if (is_server_) {
       if (!header.public_header.version_flag) {
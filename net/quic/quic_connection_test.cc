@@ -938,6 +938,20 @@ TEST_P(QuicConnectionTest, RejectPacketTooFarOut) {
   ProcessDataPacket(6000, 0, !kEntropyFlag);
 }
 
+TEST_P(QuicConnectionTest, RejectTooManyOutstandingPackets) {
+  EXPECT_CALL(visitor_, OnSuccessfulVersionNegotiation(_));
+
+  // Each packet skips as far ahead as RejectPacketTooFarOut allows, and the
+  // peer never gives up on the packets it skipped.
+  ProcessPacket(5000);
+  ProcessPacket(10000);
+  ProcessPacket(15000);
+  EXPECT_CALL(visitor_,
+              OnConnectionClosed(QUIC_TOO_MANY_OUTSTANDING_RECEIVED_PACKETS,
+                                 false));
+  ProcessDataPacket(20000, 0, !kEntropyFlag);
+}
+
 // TODO(rtenneti): Delete this when QUIC_VERSION_11 is deprecated.
 TEST_P(QuicConnectionTest, TruncatedAck11) {
   if (QuicVersionMax() > QUIC_VERSION_11) {
@@ -370,6 +370,8 @@ enum QuicErrorCode {
   QUIC_PUBLIC_RESET = 19,
   // Invalid protocol version.
   QUIC_INVALID_VERSION = 20,
+  // The peer left too many of its packets neither received nor abandoned.
+  QUIC_TOO_MANY_OUTSTANDING_RECEIVED_PACKETS = 54,
   // Stream reset before headers decompressed.
   QUIC_STREAM_RST_BEFORE_HEADERS_DECOMPRESSED = 21,
   // The Header ID for a stream was too far from the previous.
@@ -438,7 +440,7 @@ enum QuicErrorCode {
   QUIC_CRYPTO_SYMMETRIC_KEY_SETUP_FAILED = 53,
 
   // No error. Used as bound while iterating.
-  QUIC_LAST_ERROR = 54,
+  QUIC_LAST_ERROR = 55,
 };
 
 struct NET_EXPORT_PRIVATE QuicPacketPublicHeader {
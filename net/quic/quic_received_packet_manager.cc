@@ -13,8 +13,19 @@ using std::min;
 
 namespace net {
 
+namespace {
+
+// The most sequence numbers below the largest received one that may be
+// waiting for packets the peer has not abandoned. Twice the largest gap
+// QuicConnection accepts between two packets.
+const size_t kMaxUnreceivedPackets = 10000;
+
+}  // namespace
+
 QuicReceivedPacketManager::QuicReceivedPacketManager()
-    : packets_entropy_hash_(0),
+    : first_sequence_number_(0),
+      num_received_entries_(0),
+      packets_entropy_hash_(0),
       largest_sequence_number_(0),
       peer_largest_observed_packet_(0),
       least_packet_awaited_by_peer_(1),
@@ -54,6 +65,19 @@ bool QuicReceivedPacketManager::IsAwaitingPacket(
   return ::net::IsAwaitingPacket(received_info_, sequence_number);
 }
 
+bool QuicReceivedPacketManager::HasRoomForPacket(
+    QuicPacketSequenceNumber sequence_number) const {
+  if (packets_entropy_.empty() || sequence_number < largest_sequence_number_)
+    return true;
+  const QuicPacketSequenceNumber first =
+      min(first_sequence_number_, sequence_number);
+  const QuicPacketSequenceNumber last =
+      max(first_sequence_number_ + packets_entropy_.size() - 1,
+          sequence_number);
+  return last - first + 1 <=
+      num_received_entries_ + 1 + kMaxUnreceivedPackets;
+}
+
 void QuicReceivedPacketManager::UpdateReceivedPacketInfo(
     ReceivedPacketInfo* received_info, QuicTime approximate_now) {
   *received_info = received_info_;
@@ -79,7 +103,22 @@ void QuicReceivedPacketManager::RecordPacketEntropyHash(
                << largest_sequence_number_;
     return;
   }
-  packets_entropy_.insert(make_pair(sequence_number, entropy_hash));
+  if (packets_entropy_.empty())
+    first_sequence_number_ = sequence_number;
+  // Packets can arrive out of order, so extend the window at either end.
+  if (sequence_number < first_sequence_number_) {
+    packets_entropy_.insert(packets_entropy_.begin(),
+                            first_sequence_number_ - sequence_number,
+                            make_pair(0, false));
+    first_sequence_number_ = sequence_number;
+  }
+  const size_t index = sequence_number - first_sequence_number_;
+  if (index >= packets_entropy_.size())
+    packets_entropy_.resize(index + 1, make_pair(0, false));
+  if (!packets_entropy_[index].second) {
+    packets_entropy_[index] = make_pair(entropy_hash, true);
+    ++num_received_entries_;
+  }
   packets_entropy_hash_ ^= entropy_hash;
   DVLOG(2) << "setting cumulative received entropy hash to: "
            << static_cast<int>(packets_entropy_hash_)
@@ -95,23 +134,28 @@ QuicPacketEntropyHash QuicReceivedPacketManager::EntropyHash(
     return packets_entropy_hash_;
   }
 
-  ReceivedEntropyMap::const_iterator it =
-      packets_entropy_.upper_bound(sequence_number);
-  // When this map is empty we should only query entropy for
-  // received_info_.largest_observed, since no other entropy can be correctly
-  // calculated, because we're not storing the entropy for any prior packets.
+  // Entropy of the packets after |sequence_number| is taken out of the
+  // cumulative hash.
+  QuicPacketEntropyHash hash = packets_entropy_hash_;
+  bool found = false;
+  size_t index = sequence_number < first_sequence_number_ ?
+      0 : sequence_number - first_sequence_number_ + 1;
+  for (; index < packets_entropy_.size(); ++index) {
+    if (!packets_entropy_[index].second)
+      continue;
+    hash ^= packets_entropy_[index].first;
+    found = true;
+  }
+  // When there are no entries after |sequence_number|, we should only query
+  // entropy for received_info_.largest_observed, since no other entropy can be
+  // correctly calculated, because we're not storing the entropy for any prior
+  // packets.
   // TODO(rtenneti): add support for LOG_IF_EVERY_N_SEC to chromium.
-  // LOG_IF_EVERY_N_SEC(DFATAL, it == packets_entropy_.end(), 10)
-  LOG_IF(DFATAL, it == packets_entropy_.end())
+  // LOG_IF_EVERY_N_SEC(DFATAL, !found, 10)
+  LOG_IF(DFATAL, !found)
       << "EntropyHash may be unknown. largest_received: "
       << received_info_.largest_observed
       << " sequence_number: " << sequence_number;
-
-  // TODO(satyamshekhar): Make this O(1).
-  QuicPacketEntropyHash hash = packets_entropy_hash_;
-  for (; it != packets_entropy_.end(); ++it) {
-    hash ^= it->second;
-  }
   return hash;
 }
 
@@ -127,17 +171,21 @@ void QuicReceivedPacketManager::RecalculateEntropyHash(
   }
   largest_sequence_number_ = peer_least_unacked;
   packets_entropy_hash_ = entropy_hash;
-  ReceivedEntropyMap::iterator it =
-      packets_entropy_.lower_bound(peer_least_unacked);
-  // TODO(satyamshekhar): Make this O(1).
-  for (; it != packets_entropy_.end(); ++it) {
-    packets_entropy_hash_ ^= it->second;
+  size_t index = peer_least_unacked < first_sequence_number_ ?
+      0 : peer_least_unacked - first_sequence_number_;
+  for (; index < packets_entropy_.size(); ++index) {
+    if (packets_entropy_[index].second)
+      packets_entropy_hash_ ^= packets_entropy_[index].first;
   }
   // Discard entropies before least unacked.
-  packets_entropy_.erase(
-      packets_entropy_.begin(),
-      packets_entropy_.lower_bound(
-          min(peer_least_unacked, received_info_.largest_observed)));
+  const QuicPacketSequenceNumber discard_before =
+      min(peer_least_unacked, received_info_.largest_observed);
+  while (!packets_entropy_.empty() && first_sequence_number_ < discard_before) {
+    if (packets_entropy_.front().second)
+      --num_received_entries_;
+    packets_entropy_.pop_front();
+    ++first_sequence_number_;
+  }
 }
 
 void QuicReceivedPacketManager::UpdatePacketInformationReceivedByPeer(
@@ -8,6 +8,9 @@
 #ifndef NET_QUIC_QUIC_RECEIVED_PACKET_MANAGER_H_
 #define NET_QUIC_QUIC_RECEIVED_PACKET_MANAGER_H_
 
+#include <deque>
+#include <utility>
+
 #include "net/quic/quic_framer.h"
 #include "net/quic/quic_protocol.h"
 
@@ -33,6 +36,14 @@ class NET_EXPORT_PRIVATE QuicReceivedPacketManager :
   // Checks if we're still waiting for the packet with |sequence_number|.
   bool IsAwaitingPacket(QuicPacketSequenceNumber sequence_number);
 
+  // Returns false if recording |sequence_number| would leave more than
+  // kMaxUnreceivedPackets sequence numbers that have not been received still
+  // tracked for entropy. Lost packets are retransmitted under new numbers, so
+  // those only go away once the peer moves its least unacked packet past
+  // them. A peer that skips sequence numbers without doing so would otherwise
+  // grow the entropy window without bound.
+  bool HasRoomForPacket(QuicPacketSequenceNumber sequence_number) const;
+
   // Update the |received_info| for an outgoing ack.
   void UpdateReceivedPacketInfo(ReceivedPacketInfo* received_info,
                                 QuicTime approximate_now);
@@ -68,8 +79,11 @@ class NET_EXPORT_PRIVATE QuicReceivedPacketManager :
  private:
   friend class test::QuicReceivedPacketManagerPeer;
 
-  typedef std::map<QuicPacketSequenceNumber,
-                   QuicPacketEntropyHash> ReceivedEntropyMap;
+  // Entropy of received packets, indexed by the offset of their sequence
+  // number from |first_sequence_number_|.  The bool is false for sequence
+  // numbers that have not been received.
+  typedef std::deque<std::pair<QuicPacketEntropyHash, bool> >
+      ReceivedEntropyMap;
 
   // Record the received entropy hash against |sequence_number|.
   void RecordPacketEntropyHash(QuicPacketSequenceNumber sequence_number,
@@ -87,14 +101,19 @@ class NET_EXPORT_PRIVATE QuicReceivedPacketManager :
   // |least_unacked| unacked, false otherwise.
   bool DontWaitForPacketsBefore(QuicPacketSequenceNumber least_unacked);
 
-  // TODO(satyamshekhar): Can be optimized using an interval set like data
-  // structure.
-  // Map of received sequence numbers to their corresponding entropy.
-  // Every received packet has an entry, and packets without the entropy bit set
-  // have an entropy value of 0.
+  // Received sequence numbers and their corresponding entropy, in a deque
+  // indexed by sequence number so that lookups and trimming of old packets
+  // don't walk a tree.  Every received packet has an entry, and packets
+  // without the entropy bit set have an entropy value of 0.
   // TODO(ianswett): When the entropy flag is off, the entropy should not be 0.
   ReceivedEntropyMap packets_entropy_;
 
+  // The sequence number of the first entry in |packets_entropy_|.
+  QuicPacketSequenceNumber first_sequence_number_;
+
+  // The number of entries in |packets_entropy_| that have been received.
+  size_t num_received_entries_;
+
   // Cumulative hash of entropy of all received packets.
   QuicPacketEntropyHash packets_entropy_hash_;
 
@@ -58,6 +58,18 @@ TEST_F(QuicReceivedPacketManagerTest, ReceivedPacketEntropyHash) {
   }
 }
 
+TEST_F(QuicReceivedPacketManagerTest, EntropyHashOutOfOrderBeforeFirst) {
+  // The first packet to arrive is not the lowest one.
+  RecordPacketEntropyHash(5, 3);
+  RecordPacketEntropyHash(2, 33);
+  RecordPacketEntropyHash(3, 1);
+
+  EXPECT_EQ(33, received_manager_.EntropyHash(2));
+  EXPECT_EQ(33 ^ 1, received_manager_.EntropyHash(3));
+  EXPECT_EQ(33 ^ 1, received_manager_.EntropyHash(4));
+  EXPECT_EQ(33 ^ 1 ^ 3, received_manager_.EntropyHash(5));
+}
+
 TEST_F(QuicReceivedPacketManagerTest, EntropyHashBelowLeastObserved) {
   EXPECT_EQ(0, received_manager_.EntropyHash(0));
   RecordPacketEntropyHash(4, 5);
@@ -114,6 +126,28 @@ TEST_F(QuicReceivedPacketManagerTest, DontWaitForPacketsBefore) {
   EXPECT_TRUE(received_manager_.IsAwaitingPacket(6u));
 }
 
+TEST_F(QuicReceivedPacketManagerTest, HasRoomForPacket) {
+  // Matches kMaxUnreceivedPackets in quic_received_packet_manager.cc.
+  const QuicPacketSequenceNumber kMaxUnreceived = 10000;
+  EXPECT_TRUE(received_manager_.HasRoomForPacket(3 * kMaxUnreceived));
+
+  // Nothing below the first received packet is tracked.
+  RecordPacketEntropyHash(kMaxUnreceived, 1);
+  EXPECT_TRUE(received_manager_.HasRoomForPacket(2 * kMaxUnreceived + 1));
+  EXPECT_FALSE(received_manager_.HasRoomForPacket(2 * kMaxUnreceived + 2));
+
+  // Received packets don't count against the limit.
+  RecordPacketEntropyHash(kMaxUnreceived + 1, 2);
+  EXPECT_TRUE(received_manager_.HasRoomForPacket(2 * kMaxUnreceived + 2));
+  RecordPacketEntropyHash(2 * kMaxUnreceived, 3);
+
+  // Once the peer stops waiting for the missing packets they no longer count.
+  QuicReceivedPacketManagerPeer::RecalculateEntropyHash(
+      &received_manager_, 2 * kMaxUnreceived, 3);
+  EXPECT_TRUE(received_manager_.HasRoomForPacket(3 * kMaxUnreceived + 1));
+  EXPECT_FALSE(received_manager_.HasRoomForPacket(3 * kMaxUnreceived + 2));
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace net
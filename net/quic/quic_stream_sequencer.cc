@@ -114,7 +114,14 @@ bool QuicStreamSequencer::OnStreamFrame(const QuicStreamFrame& frame) {
     }
   }
   DVLOG(1) << "Buffering packet at offset " << byte_offset;
-  frames_.insert(make_pair(byte_offset, string(data, data_len)));
+  // Frames usually arrive in order, so hint that this one goes at the end, and
+  // copy the data straight into the map's string. Data already buffered at
+  // this offset is kept, as insert() would with a filled-in string.
+  size_t old_num_frames = frames_.size();
+  FrameMap::iterator it =
+      frames_.insert(frames_.end(), make_pair(byte_offset, string()));
+  if (frames_.size() != old_num_frames)
+    it->second.assign(data, data_len);
   return true;
 }
 
@@ -133,6 +140,22 @@ void QuicStreamSequencer::CloseStreamAtOffset(QuicStreamOffset offset) {
   MaybeCloseStream();
 }
 
+QuicStreamSequencer::FrameMap::iterator QuicStreamSequencer::TrimFrame(
+    FrameMap::iterator it, size_t num_bytes) {
+  DCHECK_LT(num_bytes, it->second.size());
+  QuicStreamOffset new_offset = it->first + num_bytes;
+  string data;
+  data.swap(it->second);
+  data.erase(0, num_bytes);
+  frames_.erase(it);
+  std::pair<FrameMap::iterator, bool> inserted =
+      frames_.insert(make_pair(new_offset, string()));
+  // Keep a frame already buffered at |new_offset|, as insert() would.
+  if (inserted.second)
+    inserted.first->second.swap(data);
+  return inserted.first;
+}
+
 bool QuicStreamSequencer::MaybeCloseStream() {
   if (IsHalfClosed()) {
     DVLOG(1) << "Passing up termination, as we've processed "
@@ -198,9 +221,7 @@ int QuicStreamSequencer::Readv(const struct iovec* iov, size_t iov_len) {
   }
   // We've finished copying.  If we have a partial frame, update it.
   if (frame_offset != 0) {
-    frames_.insert(make_pair(it->first + frame_offset,
-                             it->second.substr(frame_offset)));
-    frames_.erase(frames_.begin());
+    TrimFrame(it, frame_offset);
     num_bytes_consumed_ += frame_offset;
   }
   return num_bytes_consumed_ - initial_bytes_consumed;
@@ -230,8 +251,7 @@ void QuicStreamSequencer::MarkConsumed(size_t num_bytes_consumed) {
     // Partially consume this frame.
     size_t delta = end_offset - it->first;
     num_bytes_consumed_ += delta;
-    frames_.insert(make_pair(end_offset, it->second.substr(delta)));
-    frames_.erase(it);
+    TrimFrame(it, delta);
     break;
   }
 }
@@ -273,9 +293,7 @@ void QuicStreamSequencer::FlushBufferedFrames() {
       frames_.erase(it);
       it = frames_.find(num_bytes_consumed_);
     } else {
-      string new_data = it->second.substr(bytes_consumed);
-      frames_.erase(it);
-      frames_.insert(make_pair(num_bytes_consumed_, new_data));
+      TrimFrame(it, bytes_consumed);
       return;
     }
   }
@@ -86,6 +86,11 @@ class NET_EXPORT_PRIVATE QuicStreamSequencer {
 
   bool MaybeCloseStream();
 
+  // Drops the first |num_bytes| of the buffered frame at |it| and re-files the
+  // rest under its new offset, reusing the frame's string rather than copying
+  // the data.  Returns the new frame's iterator.
+  FrameMap::iterator TrimFrame(FrameMap::iterator it, size_t num_bytes);
+
   ReliableQuicStream* stream_;  // The stream which owns this sequencer.
   QuicStreamOffset num_bytes_consumed_;  // The last data consumed by the stream
   FrameMap frames_;  // sequence number -> frame
@@ -211,6 +211,19 @@ TEST_F(QuicStreamSequencerTest, PartialFrameConsumed) {
   EXPECT_EQ("c", sequencer_->frames()->find(2)->second);
 }
 
+TEST_F(QuicStreamSequencerTest, PartialFrameKeepsBufferedOverlap) {
+  EXPECT_TRUE(sequencer_->OnFrame(2, "cdef"));
+  EXPECT_EQ(1u, sequencer_->frames()->size());
+
+  // The leftover "c" lands on the offset of the buffered frame, which must
+  // keep its longer data.
+  EXPECT_CALL(stream_, ProcessData(StrEq("abc"), 3)).WillOnce(Return(2));
+  EXPECT_TRUE(sequencer_->OnFrame(0, "abc"));
+  EXPECT_EQ(1u, sequencer_->frames()->size());
+  EXPECT_EQ(2u, sequencer_->num_bytes_consumed());
+  EXPECT_EQ("cdef", sequencer_->frames()->find(2)->second);
+}
+
 TEST_F(QuicStreamSequencerTest, NextxFrameNotConsumed) {
   EXPECT_CALL(stream_, ProcessData(StrEq("abc"), 3)).WillOnce(Return(0));
 
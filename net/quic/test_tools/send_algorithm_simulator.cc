@@ -0,0 +1,209 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/test_tools/send_algorithm_simulator.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/time/time.h"
+
+namespace net {
+namespace test {
+
+namespace {
+
+// Number of later packets that must be acked before a packet is lost.
+const QuicPacketSequenceNumber kNackThreshold = 3;
+// Floor for the retransmission timeout used on tail losses.
+const int64 kMinRetransmissionTimeMs = 200;
+
+}  // namespace
+
+SendAlgorithmSimulator::SentPacket::SentPacket(
+    QuicPacketSequenceNumber sequence_number,
+    QuicByteCount bytes,
+    QuicTime send_time)
+    : sequence_number(sequence_number),
+      bytes(bytes),
+      send_time(send_time),
+      ack_time(QuicTime::Zero()),
+      lost(false) {
+}
+
+SendAlgorithmSimulator::SendAlgorithmSimulator(
+    MockClock* clock,
+    SendAlgorithmInterface* send_algorithm,
+    QuicBandwidth bandwidth,
+    QuicTime::Delta one_way_delay,
+    QuicByteCount buffer_size,
+    float loss_rate)
+    : clock_(clock),
+      send_algorithm_(send_algorithm),
+      bandwidth_(bandwidth),
+      one_way_delay_(one_way_delay),
+      buffer_size_(buffer_size),
+      loss_rate_(loss_rate),
+      random_state_(1),
+      last_sequence_number_(0),
+      bytes_to_send_(0),
+      link_free_time_(clock->Now()),
+      bytes_acked_(0),
+      packets_sent_(0),
+      packets_lost_(0),
+      rtt_sum_us_(0),
+      rtt_samples_(0),
+      max_rtt_(QuicTime::Delta::Zero()),
+      transfer_bytes_(0),
+      transfer_time_(QuicTime::Delta::Zero()) {
+  DCHECK(!bandwidth_.IsZero());
+}
+
+SendAlgorithmSimulator::~SendAlgorithmSimulator() {
+}
+
+void SendAlgorithmSimulator::TransferBytes(QuicByteCount num_bytes) {
+  const QuicTime start = clock_->Now();
+  bytes_to_send_ += num_bytes;
+  transfer_bytes_ = num_bytes;
+
+  while (bytes_to_send_ > 0 || !in_flight_.empty()) {
+    QuicTime::Delta send_delay = QuicTime::Delta::Infinite();
+    if (bytes_to_send_ > 0) {
+      send_delay = send_algorithm_->TimeUntilSend(
+          clock_->Now(), NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA,
+          NOT_HANDSHAKE);
+    }
+    // Acks arrive in the order the packets were sent.
+    SentPacketList::iterator next_ack = in_flight_.begin();
+    while (next_ack != in_flight_.end() && next_ack->lost) {
+      ++next_ack;
+    }
+
+    if (next_ack == in_flight_.end()) {
+      if (!send_delay.IsInfinite()) {
+        AdvanceTo(clock_->Now().Add(send_delay));
+        SendPacket();
+        continue;
+      }
+      if (in_flight_.empty()) {
+        LOG(DFATAL) << "Send algorithm is blocked with nothing in flight.";
+        return;
+      }
+      // Everything in flight was lost and nothing will be acked; fire the
+      // retransmission timer.
+      AdvanceTo(clock_->Now().Add(std::max(
+          send_algorithm_->RetransmissionDelay(),
+          QuicTime::Delta::FromMilliseconds(kMinRetransmissionTimeMs))));
+      DetectLosses(in_flight_.end(), last_sequence_number_, 0);
+      send_algorithm_->OnIncomingLoss(clock_->Now());
+      continue;
+    }
+
+    if (send_delay.IsInfinite() ||
+        next_ack->ack_time <= clock_->Now().Add(send_delay)) {
+      AdvanceTo(next_ack->ack_time);
+      AckPacket(next_ack);
+    } else {
+      AdvanceTo(clock_->Now().Add(send_delay));
+      SendPacket();
+    }
+  }
+  transfer_time_ = clock_->Now().Subtract(start);
+}
+
+QuicTime::Delta SendAlgorithmSimulator::AverageRtt() const {
+  if (rtt_samples_ == 0) {
+    return QuicTime::Delta::Zero();
+  }
+  return QuicTime::Delta::FromMicroseconds(rtt_sum_us_ / rtt_samples_);
+}
+
+QuicBandwidth SendAlgorithmSimulator::Goodput() const {
+  if (transfer_time_.IsZero()) {
+    return QuicBandwidth::Zero();
+  }
+  return QuicBandwidth::FromBytesAndTimeDelta(transfer_bytes_, transfer_time_);
+}
+
+void SendAlgorithmSimulator::SendPacket() {
+  const QuicTime now = clock_->Now();
+  QuicByteCount bytes = std::min(kDefaultMaxPacketSize, bytes_to_send_);
+  bytes_to_send_ -= bytes;
+  SentPacket packet(++last_sequence_number_, bytes, now);
+  send_algorithm_->OnPacketSent(now, packet.sequence_number, bytes,
+                                NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA);
+  ++packets_sent_;
+
+  QuicByteCount queued_bytes = 0;
+  if (link_free_time_ > now) {
+    queued_bytes = bandwidth_.ToBytesPerPeriod(link_free_time_.Subtract(now));
+  }
+  if (queued_bytes + bytes > buffer_size_ || IsRandomlyLost()) {
+    packet.lost = true;
+  } else {
+    QuicTime::Delta transfer_time = QuicTime::Delta::FromMicroseconds(
+        bytes * base::Time::kMicrosecondsPerSecond /
+        bandwidth_.ToBytesPerSecond());
+    link_free_time_ = std::max(now, link_free_time_).Add(transfer_time);
+    packet.ack_time =
+        link_free_time_.Add(one_way_delay_).Add(one_way_delay_);
+  }
+  in_flight_.push_back(packet);
+}
+
+void SendAlgorithmSimulator::AckPacket(SentPacketList::iterator packet) {
+  const QuicTime now = clock_->Now();
+  QuicTime::Delta rtt = now.Subtract(packet->send_time);
+  rtt_sum_us_ += rtt.ToMicroseconds();
+  ++rtt_samples_;
+  max_rtt_ = std::max(max_rtt_, rtt);
+  bytes_acked_ += packet->bytes;
+
+  QuicPacketSequenceNumber acked_sequence_number = packet->sequence_number;
+  send_algorithm_->OnIncomingAck(acked_sequence_number, packet->bytes, rtt);
+  SentPacketList::iterator end = in_flight_.erase(packet);
+  if (DetectLosses(end, acked_sequence_number, kNackThreshold)) {
+    send_algorithm_->OnIncomingLoss(now);
+  }
+}
+
+bool SendAlgorithmSimulator::DetectLosses(
+    SentPacketList::iterator end,
+    QuicPacketSequenceNumber largest_acked,
+    QuicPacketSequenceNumber nack_threshold) {
+  bool losses_detected = false;
+  SentPacketList::iterator it = in_flight_.begin();
+  while (it != end) {
+    if (!it->lost || it->sequence_number + nack_threshold > largest_acked) {
+      ++it;
+      continue;
+    }
+    // The lost data goes back into the send queue as new packets.
+    send_algorithm_->OnPacketAbandoned(it->sequence_number, it->bytes);
+    bytes_to_send_ += it->bytes;
+    ++packets_lost_;
+    losses_detected = true;
+    it = in_flight_.erase(it);
+  }
+  return losses_detected;
+}
+
+void SendAlgorithmSimulator::AdvanceTo(QuicTime time) {
+  DCHECK(time >= clock_->Now());
+  clock_->AdvanceTime(time.Subtract(clock_->Now()));
+}
+
+bool SendAlgorithmSimulator::IsRandomlyLost() {
+  if (loss_rate_ <= 0) {
+    return false;
+  }
+  // A fixed seed linear congruential generator keeps runs reproducible.
+  random_state_ = random_state_ * GG_UINT64_C(6364136223846793005) +
+      GG_UINT64_C(1442695040888963407);
+  return (random_state_ >> 33) < loss_rate_ * (GG_UINT64_C(1) << 31);
+}
+
+}  // namespace test
+}  // namespace net
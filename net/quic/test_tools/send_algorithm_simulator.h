@@ -0,0 +1,108 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Runs a SendAlgorithmInterface against a simulated link, driven by a
+// MockClock.  The link is a drop tail bottleneck queue of |buffer_size| bytes
+// drained at |bandwidth|, plus a fixed |one_way_delay| in each direction and
+// independent random loss.  Every packet is acked on its own, and a packet is
+// declared lost once three later packets have been acked.
+
+#ifndef NET_QUIC_TEST_TOOLS_SEND_ALGORITHM_SIMULATOR_H_
+#define NET_QUIC_TEST_TOOLS_SEND_ALGORITHM_SIMULATOR_H_
+
+#include <list>
+
+#include "base/basictypes.h"
+#include "net/quic/congestion_control/send_algorithm_interface.h"
+#include "net/quic/quic_bandwidth.h"
+#include "net/quic/quic_protocol.h"
+#include "net/quic/quic_time.h"
+#include "net/quic/test_tools/mock_clock.h"
+
+namespace net {
+namespace test {
+
+class SendAlgorithmSimulator {
+ public:
+  // Does not take ownership of |clock| or |send_algorithm|.  |loss_rate| is
+  // the probability that a packet which fit in the queue is lost anyway.
+  SendAlgorithmSimulator(MockClock* clock,
+                         SendAlgorithmInterface* send_algorithm,
+                         QuicBandwidth bandwidth,
+                         QuicTime::Delta one_way_delay,
+                         QuicByteCount buffer_size,
+                         float loss_rate);
+  ~SendAlgorithmSimulator();
+
+  // Sends |num_bytes| in full sized packets, and runs until all of them,
+  // including retransmissions of lost ones, have been acked.
+  void TransferBytes(QuicByteCount num_bytes);
+
+  // Statistics over the lifetime of the simulator.
+  QuicByteCount bytes_acked() const { return bytes_acked_; }
+  size_t packets_sent() const { return packets_sent_; }
+  size_t packets_lost() const { return packets_lost_; }
+  QuicTime::Delta max_rtt() const { return max_rtt_; }
+  QuicTime::Delta AverageRtt() const;
+
+  // How long the last TransferBytes() call took.
+  QuicTime::Delta transfer_time() const { return transfer_time_; }
+  // The goodput of the last TransferBytes() call.
+  QuicBandwidth Goodput() const;
+
+ private:
+  struct SentPacket {
+    SentPacket(QuicPacketSequenceNumber sequence_number,
+               QuicByteCount bytes,
+               QuicTime send_time);
+
+    QuicPacketSequenceNumber sequence_number;
+    QuicByteCount bytes;
+    QuicTime send_time;
+    // When the ack reaches the sender, unless the packet was |lost|.
+    QuicTime ack_time;
+    bool lost;
+  };
+  typedef std::list<SentPacket> SentPacketList;
+
+  void SendPacket();
+  void AckPacket(SentPacketList::iterator packet);
+  // Abandons the lost packets before |end| that are at least |nack_threshold|
+  // below |largest_acked|.  Returns true if any were.
+  bool DetectLosses(SentPacketList::iterator end,
+                    QuicPacketSequenceNumber largest_acked,
+                    QuicPacketSequenceNumber nack_threshold);
+  void AdvanceTo(QuicTime time);
+  bool IsRandomlyLost();
+
+  MockClock* clock_;
+  SendAlgorithmInterface* send_algorithm_;
+  const QuicBandwidth bandwidth_;
+  const QuicTime::Delta one_way_delay_;
+  const QuicByteCount buffer_size_;
+  const float loss_rate_;
+  uint64 random_state_;
+
+  SentPacketList in_flight_;
+  QuicPacketSequenceNumber last_sequence_number_;
+  QuicByteCount bytes_to_send_;
+  // When the bottleneck queue will be empty.
+  QuicTime link_free_time_;
+
+  QuicByteCount bytes_acked_;
+  size_t packets_sent_;
+  size_t packets_lost_;
+  int64 rtt_sum_us_;
+  size_t rtt_samples_;
+  QuicTime::Delta max_rtt_;
+  QuicByteCount transfer_bytes_;
+  QuicTime::Delta transfer_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(SendAlgorithmSimulator);
+};
+
+}  // namespace test
+}  // namespace net
+
+#endif  // NET_QUIC_TEST_TOOLS_SEND_ALGORITHM_SIMULATOR_H_
@@ -111,7 +111,12 @@ void HttpServer::DidRead(StreamListenSocket* socket,
     return;
 
   connection->recv_data_.append(data, len);
-  while (connection->recv_data_.length()) {
+  // Pipelined requests are consumed by advancing |pos|, and the parsed data is
+  // only shifted out of recv_data_ once per read, rather than once per
+  // request. WebSocket frames are parsed from the start of recv_data_, so
+  // |pos| is always 0 while a WebSocket is attached.
+  size_t pos = 0;
+  while (pos < connection->recv_data_.length()) {
     if (connection->web_socket_.get()) {
       std::string message;
       WebSocket::ParseResult result = connection->web_socket_->Read(&message);
@@ -128,20 +133,23 @@ void HttpServer::DidRead(StreamListenSocket* socket,
     }
 
     HttpServerRequestInfo request;
-    size_t pos = 0;
-    if (!ParseHeaders(connection, &request, &pos))
+    size_t request_end = pos;
+    if (!ParseHeaders(connection, &request, &request_end))
       break;
 
     std::string connection_header = request.GetHeaderValue("connection");
     if (connection_header == "Upgrade") {
+      connection->Shift(pos);
+      request_end -= pos;
+      pos = 0;
       connection->web_socket_.reset(WebSocket::CreateWebSocket(connection,
                                                                request,
-                                                               &pos));
+                                                               &request_end));
 
       if (!connection->web_socket_.get())  // Not enough data was received.
         break;
       delegate_->OnWebSocketRequest(connection->id(), request);
-      connection->Shift(pos);
+      connection->Shift(request_end);
       continue;
     }
 
@@ -156,18 +164,20 @@ void HttpServer::DidRead(StreamListenSocket* socket,
             "request content-length too big or unknown: " +
             request.GetHeaderValue(kContentLength)));
         DidClose(socket);
-        break;
+        return;
       }
 
-      if (connection->recv_data_.length() - pos < content_length)
+      if (connection->recv_data_.length() - request_end < content_length)
         break;  // Not enough data was received yet.
-      request.data = connection->recv_data_.substr(pos, content_length);
-      pos += content_length;
+      request.data = connection->recv_data_.substr(request_end, content_length);
+      request_end += content_length;
     }
 
     delegate_->OnHttpRequest(connection->id(), request);
-    connection->Shift(pos);
+    pos = request_end;
   }
+  if (pos > 0)
+    connection->Shift(pos);
 }
 
 void HttpServer::DidClose(StreamListenSocket* socket) {
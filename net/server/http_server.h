@@ -78,9 +78,9 @@ class HttpServer : public StreamListenSocket::Delegate,
   friend class base::RefCountedThreadSafe<HttpServer>;
   friend class HttpConnection;
 
-  // Expects the raw data to be stored in recv_data_. If parsing is successful,
-  // will remove the data parsed from recv_data_, leaving only the unused
-  // recv data.
+  // Parses the request headers in recv_data_ starting at |*pos|. If parsing
+  // is successful, returns true and leaves |*pos| just past the headers;
+  // recv_data_ itself is left untouched.
   bool ParseHeaders(HttpConnection* connection,
                     HttpServerRequestInfo* info,
                     size_t* pos);
@@ -293,6 +293,29 @@ TEST_F(HttpServerTest, RequestWithBodySplitAcrossPackets) {
   ASSERT_EQ(body, requests_[0].data);
 }
 
+TEST_F(HttpServerTest, PipelinedRequestsInOnePacket) {
+  StreamListenSocket* socket =
+      new MockStreamListenSocket(server_.get());
+  server_->DidAccept(NULL, make_scoped_ptr(socket));
+  std::string body("body");
+  std::string requests = base::StringPrintf(
+      "GET /test HTTP/1.1\r\n"
+      "Content-Length: %" PRIuS "\r\n\r\n%s"
+      "GET /test2 HTTP/1.1\r\n\r\n"
+      "GET /test3 HTTP/1.1\r\n",
+      body.length(),
+      body.c_str());
+  server_->DidRead(socket, requests.c_str(), requests.length());
+  ASSERT_EQ(2u, requests_.size());
+  EXPECT_EQ(body, requests_[0].data);
+  EXPECT_EQ("/test2", requests_[1].path);
+
+  // The incomplete third request is kept until the rest of it arrives.
+  server_->DidRead(socket, "\r\n", 2);
+  ASSERT_EQ(3u, requests_.size());
+  EXPECT_EQ("/test3", requests_[2].path);
+}
+
 TEST_F(HttpServerTest, MultipleRequestsOnSameConnection) {
   // The idea behind this test is that requests with or without bodies should
   // not break parsing of the next request.
@@ -92,6 +92,12 @@ bool ClientSocketHandle::IsPoolStalled() const {
   return pool_->IsStalled();
 }
 
+int ClientSocketHandle::ActiveSocketCountInGroup() const {
+  if (!pool_)
+    return 0;
+  return pool_->ActiveSocketCountInGroup(group_name_);
+}
+
 void ClientSocketHandle::AddHigherLayeredPool(HigherLayeredPool* higher_pool) {
   CHECK(higher_pool);
   CHECK(!higher_pool_);
@@ -94,6 +94,10 @@ class NET_EXPORT ClientSocketHandle {
 
   bool IsPoolStalled() const;
 
+  // Returns the number of sockets handed out from this handle's connection
+  // group, including this handle's own, or 0 before Init() is called.
+  int ActiveSocketCountInGroup() const;
+
   // Adds a higher layered pool on top of the socket pool that |socket_| belongs
   // to.  At most one higher layered pool can be added to a
   // ClientSocketHandle at a time.  On destruction or reset, automatically
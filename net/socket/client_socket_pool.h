@@ -154,6 +154,10 @@ class NET_EXPORT ClientSocketPool : public LowerLayeredPool {
   // The total number of idle sockets in a connection group.
   virtual int IdleSocketCountInGroup(const std::string& group_name) const = 0;
 
+  // The number of sockets of a connection group that have been handed out and
+  // not yet released.
+  virtual int ActiveSocketCountInGroup(const std::string& group_name) const = 0;
+
   // Determine the LoadState of a connecting ClientSocketHandle.
   virtual LoadState GetLoadState(const std::string& group_name,
                                  const ClientSocketHandle* handle) const = 0;
@@ -547,6 +547,15 @@ int ClientSocketPoolBaseHelper::IdleSocketCountInGroup(
   return i->second->idle_sockets().size();
 }
 
+int ClientSocketPoolBaseHelper::ActiveSocketCountInGroup(
+    const std::string& group_name) const {
+  GroupMap::const_iterator i = group_map_.find(group_name);
+  if (i == group_map_.end())
+    return 0;
+
+  return i->second->active_socket_count();
+}
+
 LoadState ClientSocketPoolBaseHelper::GetLoadState(
     const std::string& group_name,
     const ClientSocketHandle* handle) const {
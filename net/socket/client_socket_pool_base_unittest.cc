@@ -540,6 +540,11 @@ class TestClientSocketPool : public ClientSocketPool {
     return base_.IdleSocketCountInGroup(group_name);
   }
 
+  virtual int ActiveSocketCountInGroup(
+      const std::string& group_name) const OVERRIDE {
+    return base_.ActiveSocketCountInGroup(group_name);
+  }
+
   virtual LoadState GetLoadState(
       const std::string& group_name,
       const ClientSocketHandle* handle) const OVERRIDE {
@@ -148,6 +148,9 @@ class NET_EXPORT_PRIVATE SOCKSClientSocketPool
   virtual int IdleSocketCountInGroup(
       const std::string& group_name) const OVERRIDE;
 
+  virtual int ActiveSocketCountInGroup(
+      const std::string& group_name) const OVERRIDE;
+
   virtual LoadState GetLoadState(
       const std::string& group_name,
       const ClientSocketHandle* handle) const OVERRIDE;
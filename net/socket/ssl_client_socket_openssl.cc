@@ -1166,7 +1166,12 @@ int SSLClientSocketOpenSSL::BufferRecv(void) {
   if (!max_write)
     return ERR_IO_PENDING;
 
-  recv_buffer_ = new IOBuffer(max_write);
+  // The write guarantee is bounded by the size of the BIO pair, so after the
+  // first read the previous buffer is almost always big enough to reuse.
+  if (!recv_buffer_.get() || !recv_buffer_->HasOneRef() ||
+      recv_buffer_->size() < static_cast<int>(max_write)) {
+    recv_buffer_ = new IOBufferWithSize(max_write);
+  }
   int rv = transport_->socket()->Read(
       recv_buffer_.get(),
       max_write,
@@ -1202,7 +1207,6 @@ void SSLClientSocketOpenSSL::TransportReadComplete(int result) {
     // A write into a memory BIO should always succeed.
     CHECK_EQ(result, ret);
   }
-  recv_buffer_ = NULL;
   transport_recv_busy_ = false;
 }
 
@@ -136,7 +136,8 @@ class SSLClientSocketOpenSSL : public SSLClientSocket {
   bool transport_recv_eof_;
 
   scoped_refptr<DrainableIOBuffer> send_buffer_;
-  scoped_refptr<IOBuffer> recv_buffer_;
+  // Kept across transport reads and reused while nothing else references it.
+  scoped_refptr<IOBufferWithSize> recv_buffer_;
 
   CompletionCallback user_connect_callback_;
   CompletionCallback user_read_callback_;
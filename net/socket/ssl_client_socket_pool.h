@@ -228,6 +228,9 @@ class NET_EXPORT_PRIVATE SSLClientSocketPool
   virtual int IdleSocketCountInGroup(
       const std::string& group_name) const OVERRIDE;
 
+  virtual int ActiveSocketCountInGroup(
+      const std::string& group_name) const OVERRIDE;
+
   virtual LoadState GetLoadState(
       const std::string& group_name,
       const ClientSocketHandle* handle) const OVERRIDE;
@@ -5,6 +5,7 @@
 #include "net/socket/transport_client_socket_pool.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/lazy_instance.h"
@@ -33,8 +34,14 @@ namespace net {
 // don't synchronize.
 const int TransportConnectJob::kIPv6FallbackTimerInMs = 300;
 
+// How long a raced connection attempt gets before the next one is started.
+const int TransportConnectJob::kConnectionAttemptDelayMs = 250;
+
 namespace {
 
+// Whether new TransportConnectJobs race their connection attempts.
+bool g_connection_racing_enabled = false;
+
 // Returns true iff all addresses in |list| are in the IPv6 family.
 bool AddressListOnlyContainsIPv6(const AddressList& list) {
   DCHECK(!list.empty());
@@ -96,6 +103,9 @@ TransportConnectJob::TransportConnectJob(
       client_socket_factory_(client_socket_factory),
       resolver_(host_resolver),
       next_state_(STATE_NONE),
+      racing_enabled_(g_connection_racing_enabled),
+      next_racing_address_(0),
+      last_racing_error_(ERR_CONNECTION_FAILED),
       less_than_20ms_since_connect_(true) {
 }
 
@@ -129,6 +139,35 @@ void TransportConnectJob::MakeAddressListStartWithIPv4(AddressList* list) {
   }
 }
 
+// static
+void TransportConnectJob::InterleaveAddressFamilies(AddressList* list) {
+  if (list->size() < 2)
+    return;
+  const AddressFamily first_family = list->front().GetFamily();
+  std::vector<IPEndPoint> first;
+  std::vector<IPEndPoint> rest;
+  for (AddressList::const_iterator i = list->begin(); i != list->end(); ++i) {
+    if (i->GetFamily() == first_family)
+      first.push_back(*i);
+    else
+      rest.push_back(*i);
+  }
+  list->clear();
+  for (size_t i = 0; i < first.size() || i < rest.size(); ++i) {
+    if (i < first.size())
+      list->push_back(first[i]);
+    if (i < rest.size())
+      list->push_back(rest[i]);
+  }
+}
+
+// static
+bool TransportConnectJob::set_connection_racing_enabled(bool enabled) {
+  bool old_value = g_connection_racing_enabled;
+  g_connection_racing_enabled = enabled;
+  return old_value;
+}
+
 void TransportConnectJob::OnIOComplete(int result) {
   int rv = DoLoop(result);
   if (rv != ERR_IO_PENDING)
@@ -212,6 +251,9 @@ int TransportConnectJob::DoTransportConnect() {
   }
 
   next_state_ = STATE_TRANSPORT_CONNECT_COMPLETE;
+  if (racing_enabled_ && addresses_.size() > 1)
+    return DoRacingTransportConnect();
+
   transport_socket_ = client_socket_factory_->CreateTransportClientSocket(
         addresses_, net_log().net_log(), net_log().source());
   int rv = transport_socket_->Connect(
@@ -227,6 +269,10 @@ int TransportConnectJob::DoTransportConnect() {
 }
 
 int TransportConnectJob::DoTransportConnectComplete(int result) {
+  // Abandon any raced attempts which are still pending.
+  racing_timer_.Stop();
+  racing_sockets_.clear();
+
   if (result == OK) {
     bool is_ipv4 = addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV4;
     DCHECK(!connect_timing_.connect_start.is_null());
@@ -263,7 +309,13 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
           100);
     }
 
-    if (is_ipv4) {
+    if (!racing_addresses_.empty()) {
+      UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_Raced",
+                                 connect_duration,
+                                 base::TimeDelta::FromMilliseconds(1),
+                                 base::TimeDelta::FromMinutes(10),
+                                 100);
+    } else if (is_ipv4) {
       UMA_HISTOGRAM_CUSTOM_TIMES("Net.TCP_Connection_Latency_IPv4_No_Race",
                                  connect_duration,
                                  base::TimeDelta::FromMilliseconds(1),
@@ -366,6 +418,71 @@ void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
   NotifyDelegateOfCompletion(result);  // Deletes |this|
 }
 
+int TransportConnectJob::DoRacingTransportConnect() {
+  DCHECK(racing_sockets_.empty());
+  racing_addresses_ = addresses_;
+  InterleaveAddressFamilies(&racing_addresses_);
+  next_racing_address_ = 0;
+  return StartNextRacingAttempt();
+}
+
+int TransportConnectJob::StartNextRacingAttempt() {
+  while (next_racing_address_ < racing_addresses_.size()) {
+    AddressList address(racing_addresses_[next_racing_address_++]);
+    scoped_ptr<StreamSocket> socket =
+        client_socket_factory_->CreateTransportClientSocket(
+            address, net_log().net_log(), net_log().source());
+    StreamSocket* raw_socket = socket.get();
+    int rv = socket->Connect(
+        base::Bind(&TransportConnectJob::OnRacingAttemptComplete,
+                   base::Unretained(this), raw_socket));
+    if (rv == OK) {
+      transport_socket_ = socket.Pass();
+      return OK;
+    }
+    if (rv == ERR_IO_PENDING) {
+      racing_sockets_.push_back(socket.release());
+      if (next_racing_address_ < racing_addresses_.size()) {
+        racing_timer_.Start(FROM_HERE,
+            base::TimeDelta::FromMilliseconds(kConnectionAttemptDelayMs),
+            this, &TransportConnectJob::OnRacingAttemptTimer);
+      }
+      return ERR_IO_PENDING;
+    }
+    last_racing_error_ = rv;
+  }
+  return racing_sockets_.empty() ? last_racing_error_ : ERR_IO_PENDING;
+}
+
+void TransportConnectJob::OnRacingAttemptTimer() {
+  DCHECK_EQ(STATE_TRANSPORT_CONNECT_COMPLETE, next_state_);
+  int rv = StartNextRacingAttempt();
+  if (rv != ERR_IO_PENDING)
+    OnIOComplete(rv);  // Deletes |this|
+}
+
+void TransportConnectJob::OnRacingAttemptComplete(StreamSocket* socket,
+                                                  int result) {
+  DCHECK_EQ(STATE_TRANSPORT_CONNECT_COMPLETE, next_state_);
+  DCHECK_NE(ERR_IO_PENDING, result);
+  ScopedVector<StreamSocket>::iterator it =
+      std::find(racing_sockets_.begin(), racing_sockets_.end(), socket);
+  DCHECK(it != racing_sockets_.end());
+
+  if (result == OK) {
+    transport_socket_.reset(*it);
+    racing_sockets_.weak_erase(it);
+  } else {
+    racing_sockets_.erase(it);
+    last_racing_error_ = result;
+    // Don't wait for the timer to move on to the next address.
+    result = StartNextRacingAttempt();
+    if (result == ERR_IO_PENDING)
+      return;
+  }
+  OnIOComplete(result);  // Deletes |this|
+}
+
 int TransportConnectJob::ConnectInternal() {
   next_state_ = STATE_RESOLVE_HOST;
   return DoLoop(OK);
@@ -481,6 +598,11 @@ int TransportClientSocketPool::IdleSocketCountInGroup(
   return base_.IdleSocketCountInGroup(group_name);
 }
 
+int TransportClientSocketPool::ActiveSocketCountInGroup(
+    const std::string& group_name) const {
+  return base_.ActiveSocketCountInGroup(group_name);
+}
+
 LoadState TransportClientSocketPool::GetLoadState(
     const std::string& group_name, const ClientSocketHandle* handle) const {
   return base_.GetLoadState(group_name, handle);
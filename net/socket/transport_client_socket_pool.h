@@ -10,6 +10,7 @@
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "net/base/host_port_pair.h"
@@ -63,6 +64,12 @@ class NET_EXPORT_PRIVATE TransportSocketParams
 // (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
 // fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
 // a headstart) and return the one that completes first to the socket pool.
+//
+// When connection racing is enabled, the fallback timer is replaced by
+// staggered attempts to the individual addresses: they are tried in the order
+// the resolver sorted them, alternating between address families, starting a
+// new attempt every kConnectionAttemptDelayMs or as soon as the previous one
+// fails. The first attempt to succeed wins and the rest are abandoned.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
   TransportConnectJob(const std::string& group_name,
@@ -82,7 +89,17 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // WARNING: this method should only be used to implement the prefer-IPv4 hack.
   static void MakeAddressListStartWithIPv4(AddressList* addrlist);
 
+  // Reorders |list| so that address families alternate, starting with the
+  // family of the first address. The relative order of the addresses of each
+  // family is kept.
+  static void InterleaveAddressFamilies(AddressList* list);
+
+  // Enables or disables connection racing for new TransportConnectJobs.
+  // Returns the previous setting.
+  static bool set_connection_racing_enabled(bool enabled);
+
   static const int kIPv6FallbackTimerInMs;
+  static const int kConnectionAttemptDelayMs;
 
  private:
   enum State {
@@ -107,6 +124,17 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   void DoIPv6FallbackTransportConnect();
   void DoIPv6FallbackTransportConnectComplete(int result);
 
+  // Connection racing, also not part of the state machine. The state machine
+  // waits in STATE_TRANSPORT_CONNECT_COMPLETE until an attempt wins or all of
+  // them have failed.
+  int DoRacingTransportConnect();
+  // Starts attempts to the remaining addresses until one is pending or has
+  // succeeded. Returns OK if one succeeded synchronously, ERR_IO_PENDING if
+  // any attempt is pending, and otherwise the error of the last attempt.
+  int StartNextRacingAttempt();
+  void OnRacingAttemptTimer();
+  void OnRacingAttemptComplete(StreamSocket* socket, int result);
+
   // Begins the host resolution and the TCP connect.  Returns OK on success
   // and ERR_IO_PENDING if it cannot immediately service the request.
   // Otherwise, it returns a net error code.
@@ -125,6 +153,16 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   base::TimeTicks fallback_connect_start_time_;
   base::OneShotTimer<TransportConnectJob> fallback_timer_;
 
+  // Whether this job races its connection attempts.
+  const bool racing_enabled_;
+  // The addresses to race, in the order they are tried.
+  AddressList racing_addresses_;
+  size_t next_racing_address_;
+  int last_racing_error_;
+  // The attempts which are still pending.
+  ScopedVector<StreamSocket> racing_sockets_;
+  base::OneShotTimer<TransportConnectJob> racing_timer_;
+
   // If the interval between this connect and previous connect is less than
   // 20ms, then |less_than_20ms_since_connect_| is set to true.
   bool less_than_20ms_since_connect_;
@@ -167,6 +205,8 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
   virtual int IdleSocketCount() const OVERRIDE;
   virtual int IdleSocketCountInGroup(
       const std::string& group_name) const OVERRIDE;
+  virtual int ActiveSocketCountInGroup(
+      const std::string& group_name) const OVERRIDE;
   virtual LoadState GetLoadState(
       const std::string& group_name,
       const ClientSocketHandle* handle) const OVERRIDE;
@@ -561,6 +561,45 @@ TEST(TransportConnectJobTest, MakeAddrListStartWithIPv4) {
   EXPECT_EQ(ADDRESS_FAMILY_IPV6, addrlist[3].GetFamily());
 }
 
+TEST(TransportConnectJobTest, InterleaveAddressFamilies) {
+  IPAddressNumber ip_number;
+  ASSERT_TRUE(ParseIPLiteralToNumber("192.168.1.1", &ip_number));
+  IPEndPoint addrlist_v4_1(ip_number, 80);
+  ASSERT_TRUE(ParseIPLiteralToNumber("192.168.1.2", &ip_number));
+  IPEndPoint addrlist_v4_2(ip_number, 80);
+  ASSERT_TRUE(ParseIPLiteralToNumber("2001:4860:b006::64", &ip_number));
+  IPEndPoint addrlist_v6_1(ip_number, 80);
+  ASSERT_TRUE(ParseIPLiteralToNumber("2001:4860:b006::66", &ip_number));
+  IPEndPoint addrlist_v6_2(ip_number, 80);
+  ASSERT_TRUE(ParseIPLiteralToNumber("2001:4860:b006::68", &ip_number));
+  IPEndPoint addrlist_v6_3(ip_number, 80);
+
+  AddressList addrlist;
+  addrlist.push_back(addrlist_v6_1);
+  addrlist.push_back(addrlist_v6_2);
+  addrlist.push_back(addrlist_v6_3);
+  addrlist.push_back(addrlist_v4_1);
+  addrlist.push_back(addrlist_v4_2);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(5u, addrlist.size());
+  EXPECT_TRUE(addrlist_v6_1 == addrlist[0]);
+  EXPECT_TRUE(addrlist_v4_1 == addrlist[1]);
+  EXPECT_TRUE(addrlist_v6_2 == addrlist[2]);
+  EXPECT_TRUE(addrlist_v4_2 == addrlist[3]);
+  EXPECT_TRUE(addrlist_v6_3 == addrlist[4]);
+
+  // The family of the first address goes first.
+  addrlist.clear();
+  addrlist.push_back(addrlist_v4_1);
+  addrlist.push_back(addrlist_v4_2);
+  addrlist.push_back(addrlist_v6_1);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(3u, addrlist.size());
+  EXPECT_TRUE(addrlist_v4_1 == addrlist[0]);
+  EXPECT_TRUE(addrlist_v6_1 == addrlist[1]);
+  EXPECT_TRUE(addrlist_v4_2 == addrlist[2]);
+}
+
 TEST_F(TransportClientSocketPoolTest, Basic) {
   TestCompletionCallback callback;
   ClientSocketHandle handle;
@@ -1359,6 +1398,106 @@ TEST_F(TransportClientSocketPoolTest, IPv4HasNoFallback) {
   EXPECT_EQ(1, client_socket_factory_.allocation_count());
 }
 
+// With connection racing, a stalled IPv6 attempt is overtaken by an attempt to
+// the IPv4 address, which starts after kConnectionAttemptDelayMs.
+TEST_F(TransportClientSocketPoolTest, RacingStalledIPv6AttemptLoses) {
+  bool racing_enabled =
+      TransportConnectJob::set_connection_racing_enabled(true);
+  // Create a pool without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+
+  MockClientSocketFactory::ClientSocketType case_types[] = {
+    // This is the first IPv6 socket.
+    MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET,
+    // This is the IPv4 socket, which is tried before the second IPv6 address.
+    MockClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET,
+    // This is the second IPv6 socket, which should never be created.
+    MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET
+  };
+
+  client_socket_factory_.set_client_socket_types(case_types, 3);
+
+  host_resolver_->rules()->AddIPLiteralRule(
+      "*", "2:abcd::3:4:ff,3:abcd::3:4:ff,2.2.2.2", std::string());
+
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  int rv = handle.Init("a", params_, LOW, callback.callback(), &pool,
+                       BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_TRUE(handle.is_initialized());
+  ASSERT_TRUE(handle.socket());
+  IPEndPoint endpoint;
+  handle.socket()->GetLocalAddress(&endpoint);
+  EXPECT_EQ(kIPv4AddressSize, endpoint.address().size());
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+
+  TransportConnectJob::set_connection_racing_enabled(racing_enabled);
+}
+
+// With connection racing, a failed attempt starts the next one right away, and
+// the job only fails once every address has.
+TEST_F(TransportClientSocketPoolTest, RacingFailedAttemptsMoveOn) {
+  bool racing_enabled =
+      TransportConnectJob::set_connection_racing_enabled(true);
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+
+  MockClientSocketFactory::ClientSocketType case_types[] = {
+    MockClientSocketFactory::MOCK_FAILING_CLIENT_SOCKET,
+    MockClientSocketFactory::MOCK_PENDING_FAILING_CLIENT_SOCKET,
+    MockClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET,
+    MockClientSocketFactory::MOCK_FAILING_CLIENT_SOCKET,
+    MockClientSocketFactory::MOCK_PENDING_FAILING_CLIENT_SOCKET
+  };
+
+  client_socket_factory_.set_client_socket_types(case_types, 5);
+
+  host_resolver_->rules()->AddIPLiteralRule(
+      "*", "2:abcd::3:4:ff,3:abcd::3:4:ff,2.2.2.2", std::string());
+
+  TestCompletionCallback callback;
+  ClientSocketHandle handle;
+  int rv = handle.Init("a", params_, LOW, callback.callback(), &pool,
+                       BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+
+  // The first IPv6 and the IPv4 attempts fail, the second IPv6 one succeeds.
+  EXPECT_EQ(OK, callback.WaitForResult());
+  ASSERT_TRUE(handle.socket());
+  IPEndPoint endpoint;
+  handle.socket()->GetLocalAddress(&endpoint);
+  EXPECT_EQ(kIPv6AddressSize, endpoint.address().size());
+  EXPECT_EQ(3, client_socket_factory_.allocation_count());
+  handle.Reset();
+
+  // Now every attempt fails.
+  host_resolver_->rules()->ClearRules();
+  host_resolver_->rules()->AddIPLiteralRule(
+      "*", "2:abcd::3:4:ff,2.2.2.2", std::string());
+  rv = handle.Init("b", params_, LOW, callback.callback(), &pool,
+                   BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(ERR_CONNECTION_FAILED, callback.WaitForResult());
+  EXPECT_FALSE(handle.socket());
+  EXPECT_EQ(5, client_socket_factory_.allocation_count());
+
+  TransportConnectJob::set_connection_racing_enabled(racing_enabled);
+}
+
 }  // namespace
 
 }  // namespace net
@@ -54,6 +54,10 @@ void BufferedSpdyFramer::set_debug_visitor(
   spdy_framer_.set_debug_visitor(debug_visitor);
 }
 
+void BufferedSpdyFramer::set_enable_header_indexing(bool value) {
+  spdy_framer_.set_enable_header_indexing(value);
+}
+
 void BufferedSpdyFramer::OnError(SpdyFramer* spdy_framer) {
   DCHECK(spdy_framer);
   visitor_->OnError(spdy_framer->error_code());
@@ -118,17 +122,21 @@ bool BufferedSpdyFramer::OnControlFrameHeaderData(SpdyStreamId stream_id,
     // Indicates end-of-header-block.
     CHECK(header_buffer_valid_);
 
+    DCHECK(control_frame_fields_.get());
     SpdyHeaderBlock headers;
-    size_t parsed_len = spdy_framer_.ParseHeaderBlockInBuffer(
-        header_buffer_, header_buffer_used_, &headers);
-    // TODO(rch): this really should be checking parsed_len != len,
-    // but a bunch of tests fail.  Need to figure out why.
-    if (parsed_len == 0) {
-      visitor_->OnStreamError(
-          stream_id, "Could not parse Spdy Control Frame Header.");
-      return false;
+    if (control_frame_fields_->headers_decoded) {
+      headers.swap(control_frame_fields_->headers);
+    } else {
+      size_t parsed_len = spdy_framer_.ParseHeaderBlockInBuffer(
+          header_buffer_, header_buffer_used_, &headers);
+      // TODO(rch): this really should be checking parsed_len != len,
+      // but a bunch of tests fail.  Need to figure out why.
+      if (parsed_len == 0) {
+        visitor_->OnStreamError(
+            stream_id, "Could not parse Spdy Control Frame Header.");
+        return false;
+      }
     }
-    DCHECK(control_frame_fields_.get());
     switch (control_frame_fields_->type) {
       case SYN_STREAM:
         visitor_->OnSynStream(control_frame_fields_->stream_id,
@@ -170,6 +178,35 @@ bool BufferedSpdyFramer::OnControlFrameHeaderData(SpdyStreamId stream_id,
   return true;
 }
 
+bool BufferedSpdyFramer::AcceptsHeaderPieces() const {
+  return true;
+}
+
+bool BufferedSpdyFramer::OnControlFrameHeaderPieces(
+    SpdyStreamId stream_id,
+    const HpackHeaderPieces& headers) {
+  CHECK_EQ(header_stream_id_, stream_id);
+  DCHECK(control_frame_fields_.get());
+  DCHECK(!control_frame_fields_->headers_decoded);
+
+  // Build the header block straight from the decoded pieces, skipping the
+  // name/value block round trip through |header_buffer_|. As in
+  // ParseHeaderBlockInBuffer(), a repeated header name is an error.
+  SpdyHeaderBlock* block = &control_frame_fields_->headers;
+  for (HpackHeaderPieces::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    std::string name = it->first.as_string();
+    if (block->find(name) != block->end()) {
+      visitor_->OnStreamError(
+          stream_id, "Could not parse Spdy Control Frame Header.");
+      return false;
+    }
+    (*block)[name] = it->second.as_string();
+  }
+  control_frame_fields_->headers_decoded = true;
+  return true;
+}
+
 void BufferedSpdyFramer::OnDataFrameHeader(SpdyStreamId stream_id,
                                            size_t length,
                                            bool fin) {
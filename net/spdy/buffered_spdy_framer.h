@@ -117,6 +117,10 @@ class NET_EXPORT_PRIVATE BufferedSpdyFramer
   // If this is called multiple times, only the last visitor will be used.
   void set_debug_visitor(SpdyFramerDebugVisitorInterface* debug_visitor);
 
+  // Compresses header blocks with the indexed header table rather than zlib.
+  // See SpdyFramer::set_enable_header_indexing().
+  void set_enable_header_indexing(bool value);
+
   // SpdyFramerVisitorInterface
   virtual void OnError(SpdyFramer* spdy_framer) OVERRIDE;
   virtual void OnSynStream(SpdyStreamId stream_id,
@@ -132,6 +136,10 @@ class NET_EXPORT_PRIVATE BufferedSpdyFramer
   virtual bool OnControlFrameHeaderData(SpdyStreamId stream_id,
                                         const char* header_data,
                                         size_t len) OVERRIDE;
+  virtual bool AcceptsHeaderPieces() const OVERRIDE;
+  virtual bool OnControlFrameHeaderPieces(
+      SpdyStreamId stream_id,
+      const HpackHeaderPieces& headers) OVERRIDE;
   virtual void OnStreamFrameData(SpdyStreamId stream_id,
                                  const char* data,
                                  size_t len,
@@ -249,6 +257,10 @@ class NET_EXPORT_PRIVATE BufferedSpdyFramer
     uint8 credential_slot;
     bool fin;
     bool unidirectional;
+    // Set if the header block was delivered already decoded, into |headers|,
+    // rather than buffered in |header_buffer_|.
+    bool headers_decoded;
+    SpdyHeaderBlock headers;
   };
   scoped_ptr<ControlFrameFields> control_frame_fields_;
 
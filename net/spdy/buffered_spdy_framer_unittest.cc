@@ -281,4 +281,46 @@ TEST_P(BufferedSpdyFramerTest, ReadHeadersHeaderBlock) {
   EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
 }
 
+TEST_P(BufferedSpdyFramerTest, ReadIndexedHeaderBlocks) {
+  if (spdy_version() < SPDY4)
+    return;
+  SpdyHeaderBlock headers;
+  headers[":status"] = "200";
+  headers["alpha"] = "beta";
+  headers["gamma"] = "delta";
+  BufferedSpdyFramer framer(spdy_version(), true);
+  framer.set_enable_header_indexing(true);
+  scoped_ptr<SpdyFrame> first_frame(
+      framer.CreateSynReply(1,                        // stream_id
+                            CONTROL_FLAG_NONE,
+                            true,                     // compress
+                            &headers));
+  headers["gamma"] = "epsilon";
+  scoped_ptr<SpdyFrame> second_frame(
+      framer.CreateSynReply(3,                        // stream_id
+                            CONTROL_FLAG_NONE,
+                            true,                     // compress
+                            &headers));
+
+  // The headers are built from the decoded pieces, which refer to the header
+  // table for the second frame.
+  TestBufferedSpdyVisitor visitor(spdy_version());
+  visitor.buffered_spdy_framer_.set_enable_header_indexing(true);
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(first_frame.get()->data()),
+      first_frame.get()->size());
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(1, visitor.syn_reply_frame_count_);
+  headers["gamma"] = "delta";
+  EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
+
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(second_frame.get()->data()),
+      second_frame.get()->size());
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(2, visitor.syn_reply_frame_count_);
+  headers["gamma"] = "epsilon";
+  EXPECT_TRUE(CompareHeaderBlocks(&headers, &visitor.headers_));
+}
+
 }  // namespace net
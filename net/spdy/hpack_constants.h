@@ -0,0 +1,38 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_CONSTANTS_H_
+#define NET_SPDY_HPACK_CONSTANTS_H_
+
+#include "base/basictypes.h"
+
+// Wire format of the HPACK-style header block representations. Each
+// representation starts with an opcode in the high bits of its first byte,
+// followed by an integer in the remaining (prefix) bits.
+
+namespace net {
+
+// An indexed header: the integer is the index of a table entry.
+const uint8 kHpackIndexedOpcode = 0x80;
+const uint8 kHpackIndexedPrefixBits = 7;
+
+// A literal header which is added to the dynamic table. The integer is the
+// index of an entry whose name is used, or 0 if a literal name follows. The
+// value string follows.
+const uint8 kHpackLiteralIncrementalOpcode = 0x40;
+const uint8 kHpackLiteralIncrementalPrefixBits = 6;
+
+// A literal header which is not added to the dynamic table. Coded as above.
+const uint8 kHpackLiteralNoIndexOpcode = 0x00;
+const uint8 kHpackLiteralNoIndexPrefixBits = 4;
+
+// A string is a length, with a 7 bit prefix, followed by its bytes. The high
+// bit of the first byte would mark a Huffman coded string, which isn't
+// supported.
+const uint8 kHpackStringLengthPrefixBits = 7;
+const uint8 kHpackHuffmanFlag = 0x80;
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_CONSTANTS_H_
@@ -0,0 +1,130 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_decoder.h"
+
+#include "net/spdy/hpack_constants.h"
+
+namespace net {
+
+namespace {
+
+// Reads an integer with a |prefix_bits| bit prefix from the front of |input|.
+// The opcode bits of the first byte are ignored.
+bool ReadInteger(uint8 prefix_bits, base::StringPiece* input, uint32* value) {
+  if (input->empty()) {
+    return false;
+  }
+  const uint32 prefix_max = (1u << prefix_bits) - 1;
+  *value = static_cast<uint8>((*input)[0]) & prefix_max;
+  input->remove_prefix(1);
+  if (*value < prefix_max) {
+    return true;
+  }
+  // Five continuation bytes hold 35 bits, which is more than enough.
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (input->empty()) {
+      return false;
+    }
+    const uint8 byte = (*input)[0];
+    input->remove_prefix(1);
+    const uint64 next = *value + (static_cast<uint64>(byte & 0x7f) << shift);
+    if (next > kuint32max) {
+      return false;
+    }
+    *value = static_cast<uint32>(next);
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ReadString(base::StringPiece* input, base::StringPiece* str) {
+  if (input->empty() || ((*input)[0] & kHpackHuffmanFlag) != 0) {
+    return false;
+  }
+  uint32 length = 0;
+  if (!ReadInteger(kHpackStringLengthPrefixBits, input, &length) ||
+      length > input->size()) {
+    return false;
+  }
+  *str = base::StringPiece(input->data(), length);
+  input->remove_prefix(length);
+  return true;
+}
+
+}  // namespace
+
+const size_t HpackDecoder::kMaxDecodedHeaderSetSize = 256 * 1024;
+
+HpackDecoder::HpackDecoder(size_t max_table_size)
+    : header_table_(max_table_size) {
+}
+
+HpackDecoder::~HpackDecoder() {
+}
+
+bool HpackDecoder::DecodeHeaderSet(base::StringPiece input,
+                                   HpackHeaderPieces* headers) {
+  headers->clear();
+  header_table_.ReleaseEvictedEntries();
+
+  size_t decoded_size = 0;
+  while (!input.empty()) {
+    const uint8 first_byte = input[0];
+    base::StringPiece name;
+    base::StringPiece value;
+    if ((first_byte & kHpackIndexedOpcode) != 0) {
+      uint32 index = 0;
+      if (!ReadInteger(kHpackIndexedPrefixBits, &input, &index) ||
+          !header_table_.GetEntry(index, &name, &value)) {
+        return false;
+      }
+    } else {
+      bool add_to_table = false;
+      uint8 prefix_bits = 0;
+      if ((first_byte & 0xc0) == kHpackLiteralIncrementalOpcode) {
+        add_to_table = true;
+        prefix_bits = kHpackLiteralIncrementalPrefixBits;
+      } else if ((first_byte & 0xe0) == kHpackLiteralNoIndexOpcode) {
+        // Also accepts the "never indexed" variant, 0001xxxx, which
+        // intermediaries must treat the same way.
+        prefix_bits = kHpackLiteralNoIndexPrefixBits;
+      } else {
+        // Header table size updates aren't negotiated, so aren't allowed.
+        return false;
+      }
+      uint32 name_index = 0;
+      if (!ReadInteger(prefix_bits, &input, &name_index)) {
+        return false;
+      }
+      if (name_index == 0) {
+        if (!ReadString(&input, &name)) {
+          return false;
+        }
+      } else {
+        base::StringPiece unused_value;
+        if (!header_table_.GetEntry(name_index, &name, &unused_value)) {
+          return false;
+        }
+      }
+      if (!ReadString(&input, &value)) {
+        return false;
+      }
+      if (add_to_table) {
+        header_table_.AddEntry(name, value);
+      }
+    }
+
+    decoded_size += name.size() + value.size();
+    if (decoded_size > kMaxDecodedHeaderSetSize) {
+      return false;
+    }
+    headers->push_back(std::make_pair(name, value));
+  }
+  return true;
+}
+
+}  // namespace net
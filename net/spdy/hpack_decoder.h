@@ -0,0 +1,51 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_DECODER_H_
+#define NET_SPDY_HPACK_DECODER_H_
+
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+#include "net/spdy/hpack_header_table.h"
+
+namespace net {
+
+// A header block whose names and values refer to storage owned elsewhere, in
+// the order they were decoded.
+typedef std::vector<std::pair<base::StringPiece, base::StringPiece> >
+    HpackHeaderPieces;
+
+// An HpackDecoder decodes the header blocks produced by an HpackEncoder,
+// keeping its header table in step with the encoder's.
+class NET_EXPORT_PRIVATE HpackDecoder {
+ public:
+  // The most bytes of names and values that a header set may decode to. As
+  // indexed headers are tiny, this stops a small block from expanding into
+  // a huge one.
+  static const size_t kMaxDecodedHeaderSetSize;
+
+  explicit HpackDecoder(size_t max_table_size);
+  ~HpackDecoder();
+
+  // Decodes |input| into |headers|, which refer into |input| and the header
+  // table and stay valid until the next call. Returns false if |input| is
+  // malformed, after which the header table may be out of step with the
+  // encoder's and the connection must not be used further.
+  bool DecodeHeaderSet(base::StringPiece input, HpackHeaderPieces* headers);
+
+  const HpackHeaderTable& header_table() const { return header_table_; }
+
+ private:
+  HpackHeaderTable header_table_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackDecoder);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_DECODER_H_
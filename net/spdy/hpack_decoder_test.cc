@@ -0,0 +1,124 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_decoder.h"
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+bool Decode(HpackDecoder* decoder, const char* data, size_t len,
+            HpackHeaderPieces* headers) {
+  return decoder->DecodeHeaderSet(base::StringPiece(data, len), headers);
+}
+
+TEST(HpackDecoderTest, StaticEntries) {
+  HpackDecoder decoder(kDefaultHpackHeaderTableSize);
+  HpackHeaderPieces headers;
+  // :method GET, then :path with a literal value which isn't indexed.
+  const char kInput[] = { '\x82', '\x04', '\x02', '/', 'a' };
+  ASSERT_TRUE(Decode(&decoder, kInput, arraysize(kInput), &headers));
+  ASSERT_EQ(2u, headers.size());
+  EXPECT_EQ(":method", headers[0].first);
+  EXPECT_EQ("GET", headers[0].second);
+  EXPECT_EQ(":path", headers[1].first);
+  EXPECT_EQ("/a", headers[1].second);
+  EXPECT_EQ(0u, decoder.header_table().dynamic_entry_count());
+}
+
+TEST(HpackDecoderTest, LiteralAddedToTable) {
+  HpackDecoder decoder(kDefaultHpackHeaderTableSize);
+  HpackHeaderPieces headers;
+  // A literal name and value, added to the table, then referenced.
+  const char kInput[] = { '\x40', '\x01', 'x', '\x01', 'y',
+                          static_cast<char>(
+                              0x80 |
+                              (HpackHeaderTable::GetStaticEntryCount() + 1)) };
+  ASSERT_TRUE(Decode(&decoder, kInput, arraysize(kInput), &headers));
+  ASSERT_EQ(2u, headers.size());
+  EXPECT_EQ("x", headers[1].first);
+  EXPECT_EQ("y", headers[1].second);
+  EXPECT_EQ(1u, decoder.header_table().dynamic_entry_count());
+  EXPECT_EQ(HpackHeaderTable::EntrySize("x", "y"),
+            decoder.header_table().size());
+}
+
+TEST(HpackDecoderTest, PiecesSurviveEviction) {
+  // The table only has room for one of these entries, so adding the second
+  // evicts the first while it is still referenced by the decoded headers.
+  const size_t kTableSize = HpackHeaderTable::EntrySize("aaaa", "bbbb");
+  HpackDecoder decoder(kTableSize);
+  HpackHeaderPieces headers;
+  const char kFirst[] = { '\x40', '\x04', 'a', 'a', 'a', 'a',
+                          '\x04', 'b', 'b', 'b', 'b' };
+  ASSERT_TRUE(Decode(&decoder, kFirst, arraysize(kFirst), &headers));
+  const char kIndexed = static_cast<char>(
+      0x80 | (HpackHeaderTable::GetStaticEntryCount() + 1));
+  std::string second(1, kIndexed);
+  second.append("\x40\x04" "cccc" "\x04" "dddd");
+  ASSERT_TRUE(decoder.DecodeHeaderSet(second, &headers));
+  ASSERT_EQ(2u, headers.size());
+  EXPECT_EQ("aaaa", headers[0].first);
+  EXPECT_EQ("bbbb", headers[0].second);
+  EXPECT_EQ(1u, decoder.header_table().dynamic_entry_count());
+}
+
+TEST(HpackDecoderTest, InvalidInput) {
+  const struct {
+    const char* data;
+    size_t len;
+  } kInvalidInputs[] = {
+    // Index 0.
+    { "\x80", 1 },
+    // Index past the end of the table.
+    { "\xff\x10", 2 },
+    // Truncated integer.
+    { "\xff", 1 },
+    // Integer overflow.
+    { "\xff\xff\xff\xff\xff\xff\x01", 7 },
+    // Truncated string.
+    { "\x40\x05" "abc", 5 },
+    // Huffman coded string.
+    { "\x40\x81" "a" "\x01" "b", 5 },
+    // Literal name index past the end of the table.
+    { "\x7f\x00\x01" "a", 4 },
+    // Header table size update.
+    { "\x20", 1 },
+  };
+  for (size_t i = 0; i < arraysize(kInvalidInputs); ++i) {
+    HpackDecoder decoder(kDefaultHpackHeaderTableSize);
+    HpackHeaderPieces headers;
+    EXPECT_FALSE(Decode(&decoder, kInvalidInputs[i].data,
+                        kInvalidInputs[i].len, &headers)) << i;
+  }
+}
+
+TEST(HpackDecoderTest, DecodedSizeIsLimited) {
+  HpackDecoder decoder(kDefaultHpackHeaderTableSize);
+  HpackHeaderPieces headers;
+  // One large entry, then references to it until past the limit.
+  const std::string value(1000, 'v');
+  std::string input("\x40\x01" "x" "\x7f", 4);
+  uint32 length = value.size() - 0x7f;
+  while (length >= 0x80) {
+    input.push_back(static_cast<char>(0x80 | (length & 0x7f)));
+    length >>= 7;
+  }
+  input.push_back(static_cast<char>(length));
+  input.append(value);
+  const char kIndexed = static_cast<char>(
+      0x80 | (HpackHeaderTable::GetStaticEntryCount() + 1));
+  ASSERT_TRUE(decoder.DecodeHeaderSet(input, &headers));
+  input.append(HpackDecoder::kMaxDecodedHeaderSetSize / value.size(),
+               kIndexed);
+  EXPECT_FALSE(decoder.DecodeHeaderSet(input, &headers));
+}
+
+}  // namespace
+
+}  // namespace net
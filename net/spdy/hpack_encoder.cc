@@ -0,0 +1,94 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_encoder.h"
+
+#include "net/spdy/hpack_constants.h"
+
+namespace net {
+
+namespace {
+
+// A 32 bit integer takes at most this many bytes, prefix included.
+const size_t kMaxIntegerLength = 6;
+
+// Appends |value| with an |prefix_bits| bit prefix, ORing |opcode| into the
+// first byte.
+void AppendInteger(uint8 opcode, uint8 prefix_bits, uint32 value,
+                   std::string* output) {
+  const uint32 prefix_max = (1u << prefix_bits) - 1;
+  if (value < prefix_max) {
+    output->push_back(static_cast<char>(opcode | value));
+    return;
+  }
+  output->push_back(static_cast<char>(opcode | prefix_max));
+  value -= prefix_max;
+  while (value >= 0x80) {
+    output->push_back(static_cast<char>(0x80 | (value & 0x7f)));
+    value >>= 7;
+  }
+  output->push_back(static_cast<char>(value));
+}
+
+void AppendString(base::StringPiece str, std::string* output) {
+  AppendInteger(0, kHpackStringLengthPrefixBits, str.size(), output);
+  output->append(str.data(), str.size());
+}
+
+}  // namespace
+
+HpackEncoder::HpackEncoder(size_t max_table_size)
+    : header_table_(max_table_size) {
+}
+
+HpackEncoder::~HpackEncoder() {
+}
+
+// static
+size_t HpackEncoder::GetEncodedLengthBound(const SpdyNameValueBlock& headers) {
+  size_t length = 0;
+  for (SpdyNameValueBlock::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    length += 3 * kMaxIntegerLength + it->first.size() + it->second.size();
+  }
+  return length;
+}
+
+void HpackEncoder::EncodeHeaderSet(const SpdyNameValueBlock& headers,
+                                   std::string* output) {
+  for (SpdyNameValueBlock::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    const base::StringPiece name(it->first);
+    const base::StringPiece value(it->second);
+    uint32 name_index = 0;
+    const uint32 index = header_table_.FindEntry(name, value, &name_index);
+    if (index != 0) {
+      AppendInteger(kHpackIndexedOpcode, kHpackIndexedPrefixBits, index,
+                    output);
+      continue;
+    }
+
+    // Headers too large for the table would just empty it, so send those
+    // without indexing.
+    const bool add_to_table = HpackHeaderTable::EntrySize(name, value) <=
+        header_table_.max_size();
+    if (add_to_table) {
+      AppendInteger(kHpackLiteralIncrementalOpcode,
+                    kHpackLiteralIncrementalPrefixBits, name_index, output);
+    } else {
+      AppendInteger(kHpackLiteralNoIndexOpcode,
+                    kHpackLiteralNoIndexPrefixBits, name_index, output);
+    }
+    if (name_index == 0) {
+      AppendString(name, output);
+    }
+    AppendString(value, output);
+    if (add_to_table) {
+      header_table_.AddEntry(name, value);
+    }
+  }
+  header_table_.ReleaseEvictedEntries();
+}
+
+}  // namespace net
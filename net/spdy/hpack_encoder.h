@@ -0,0 +1,42 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_ENCODER_H_
+#define NET_SPDY_HPACK_ENCODER_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+#include "net/spdy/hpack_header_table.h"
+#include "net/spdy/spdy_protocol.h"
+
+namespace net {
+
+// An HpackEncoder encodes header blocks as a sequence of references to, and
+// additions to, an indexed header table which the peer's HpackDecoder keeps
+// in step. Header sets must be decoded in the order they were encoded.
+class NET_EXPORT_PRIVATE HpackEncoder {
+ public:
+  explicit HpackEncoder(size_t max_table_size);
+  ~HpackEncoder();
+
+  // Returns an upper bound on the encoded size of |headers|.
+  static size_t GetEncodedLengthBound(const SpdyNameValueBlock& headers);
+
+  // Appends the encoding of |headers| to |output|, updating the header table.
+  void EncodeHeaderSet(const SpdyNameValueBlock& headers, std::string* output);
+
+  const HpackHeaderTable& header_table() const { return header_table_; }
+
+ private:
+  HpackHeaderTable header_table_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackEncoder);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_ENCODER_H_
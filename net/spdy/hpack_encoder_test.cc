@@ -0,0 +1,132 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_encoder.h"
+
+#include <string>
+
+#include "net/spdy/hpack_decoder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+SpdyNameValueBlock ToBlock(const HpackHeaderPieces& pieces) {
+  SpdyNameValueBlock block;
+  for (HpackHeaderPieces::const_iterator it = pieces.begin();
+       it != pieces.end(); ++it) {
+    block[it->first.as_string()] = it->second.as_string();
+  }
+  return block;
+}
+
+SpdyNameValueBlock MakeRequestHeaders() {
+  SpdyNameValueBlock headers;
+  headers[":host"] = "www.example.com";
+  headers[":method"] = "GET";
+  headers[":path"] = "/index.html";
+  headers[":scheme"] = "https";
+  headers[":version"] = "HTTP/1.1";
+  headers["accept-encoding"] = "gzip,deflate";
+  headers["user-agent"] = "Mozilla/5.0 (X11; Linux x86_64)";
+  headers["cookie"] = "session=0123456789abcdef";
+  return headers;
+}
+
+TEST(HpackEncoderTest, RoundTrip) {
+  HpackEncoder encoder(kDefaultHpackHeaderTableSize);
+  HpackDecoder decoder(kDefaultHpackHeaderTableSize);
+  const SpdyNameValueBlock headers = MakeRequestHeaders();
+
+  std::string encoded;
+  encoder.EncodeHeaderSet(headers, &encoded);
+  EXPECT_GE(HpackEncoder::GetEncodedLengthBound(headers), encoded.size());
+
+  HpackHeaderPieces decoded;
+  ASSERT_TRUE(decoder.DecodeHeaderSet(encoded, &decoded));
+  EXPECT_EQ(headers.size(), decoded.size());
+  EXPECT_EQ(headers, ToBlock(decoded));
+  EXPECT_EQ(encoder.header_table().size(), decoder.header_table().size());
+}
+
+TEST(HpackEncoderTest, RepeatedHeadersAreIndexed) {
+  HpackEncoder encoder(kDefaultHpackHeaderTableSize);
+  HpackDecoder decoder(kDefaultHpackHeaderTableSize);
+  SpdyNameValueBlock headers = MakeRequestHeaders();
+
+  std::string first;
+  encoder.EncodeHeaderSet(headers, &first);
+  HpackHeaderPieces decoded;
+  ASSERT_TRUE(decoder.DecodeHeaderSet(first, &decoded));
+
+  // Every header of the second set is in the table, so takes one byte.
+  std::string second;
+  encoder.EncodeHeaderSet(headers, &second);
+  EXPECT_EQ(headers.size(), second.size());
+  ASSERT_TRUE(decoder.DecodeHeaderSet(second, &decoded));
+  EXPECT_EQ(headers, ToBlock(decoded));
+
+  // Only the changed header is sent as a literal, with an indexed name.
+  headers[":path"] = "/style.css";
+  std::string third;
+  encoder.EncodeHeaderSet(headers, &third);
+  EXPECT_EQ(headers.size() - 1 + 2 + headers[":path"].size(), third.size());
+  ASSERT_TRUE(decoder.DecodeHeaderSet(third, &decoded));
+  EXPECT_EQ(headers, ToBlock(decoded));
+}
+
+TEST(HpackEncoderTest, EvictsOldestEntries) {
+  const size_t kTableSize = 128;
+  HpackEncoder encoder(kTableSize);
+  HpackDecoder decoder(kTableSize);
+  HpackHeaderPieces decoded;
+  for (int i = 0; i < 20; ++i) {
+    SpdyNameValueBlock headers;
+    headers["x-counter"] = std::string(i + 1, 'a' + i);
+    headers["x-fixed"] = "fixed";
+    std::string encoded;
+    encoder.EncodeHeaderSet(headers, &encoded);
+    ASSERT_TRUE(decoder.DecodeHeaderSet(encoded, &decoded));
+    EXPECT_EQ(headers, ToBlock(decoded));
+    EXPECT_GE(kTableSize, encoder.header_table().size());
+    EXPECT_EQ(encoder.header_table().size(), decoder.header_table().size());
+    EXPECT_EQ(encoder.header_table().dynamic_entry_count(),
+              decoder.header_table().dynamic_entry_count());
+  }
+}
+
+TEST(HpackEncoderTest, OversizedHeaderIsNotIndexed) {
+  const size_t kTableSize = 64;
+  HpackEncoder encoder(kTableSize);
+  HpackDecoder decoder(kTableSize);
+  SpdyNameValueBlock headers;
+  headers["small"] = "a";
+  headers["x-large"] = std::string(kTableSize, 'x');
+
+  std::string encoded;
+  encoder.EncodeHeaderSet(headers, &encoded);
+  EXPECT_EQ(1u, encoder.header_table().dynamic_entry_count());
+  HpackHeaderPieces decoded;
+  ASSERT_TRUE(decoder.DecodeHeaderSet(encoded, &decoded));
+  EXPECT_EQ(headers, ToBlock(decoded));
+  EXPECT_EQ(1u, decoder.header_table().dynamic_entry_count());
+}
+
+TEST(HpackEncoderTest, LongLengths) {
+  HpackEncoder encoder(kDefaultHpackHeaderTableSize);
+  HpackDecoder decoder(kDefaultHpackHeaderTableSize);
+  SpdyNameValueBlock headers;
+  headers[std::string(300, 'n')] = std::string(70000, 'v');
+  std::string encoded;
+  encoder.EncodeHeaderSet(headers, &encoded);
+  EXPECT_GE(HpackEncoder::GetEncodedLengthBound(headers), encoded.size());
+  HpackHeaderPieces decoded;
+  ASSERT_TRUE(decoder.DecodeHeaderSet(encoded, &decoded));
+  EXPECT_EQ(headers, ToBlock(decoded));
+}
+
+}  // namespace
+
+}  // namespace net
@@ -0,0 +1,164 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_header_table.h"
+
+#include "base/logging.h"
+#include "base/stl_util.h"
+
+namespace net {
+
+namespace {
+
+// Per-entry overhead counted against the table size, as in HPACK.
+const size_t kEntryOverhead = 32;
+
+struct StaticEntry {
+  const char* name;
+  const char* value;
+};
+
+// Headers which are common in SPDY requests and responses. Entries with an
+// empty value are there for their names.
+const StaticEntry kStaticTable[] = {
+  { ":host", "" },
+  { ":method", "GET" },
+  { ":method", "POST" },
+  { ":path", "/" },
+  { ":scheme", "http" },
+  { ":scheme", "https" },
+  { ":status", "200" },
+  { ":status", "304" },
+  { ":status", "404" },
+  { ":version", "HTTP/1.1" },
+  { "accept", "" },
+  { "accept-encoding", "gzip,deflate" },
+  { "accept-language", "" },
+  { "cache-control", "" },
+  { "content-encoding", "" },
+  { "content-length", "" },
+  { "content-type", "" },
+  { "cookie", "" },
+  { "date", "" },
+  { "etag", "" },
+  { "expires", "" },
+  { "if-modified-since", "" },
+  { "if-none-match", "" },
+  { "last-modified", "" },
+  { "location", "" },
+  { "referer", "" },
+  { "server", "" },
+  { "set-cookie", "" },
+  { "user-agent", "" },
+  { "vary", "" },
+};
+
+}  // namespace
+
+HpackHeaderTable::Entry::Entry(base::StringPiece name, base::StringPiece value)
+    : name(name.data(), name.size()),
+      value(value.data(), value.size()) {
+}
+
+HpackHeaderTable::HpackHeaderTable(size_t max_size)
+    : size_(0),
+      max_size_(max_size) {
+}
+
+HpackHeaderTable::~HpackHeaderTable() {
+  STLDeleteElements(&dynamic_entries_);
+}
+
+// static
+size_t HpackHeaderTable::EntrySize(base::StringPiece name,
+                                   base::StringPiece value) {
+  return name.size() + value.size() + kEntryOverhead;
+}
+
+// static
+uint32 HpackHeaderTable::GetStaticEntryCount() {
+  return arraysize(kStaticTable);
+}
+
+bool HpackHeaderTable::GetEntry(uint32 index,
+                                base::StringPiece* name,
+                                base::StringPiece* value) const {
+  if (index == 0) {
+    return false;
+  }
+  if (index <= GetStaticEntryCount()) {
+    *name = kStaticTable[index - 1].name;
+    *value = kStaticTable[index - 1].value;
+    return true;
+  }
+  const size_t dynamic_index = index - GetStaticEntryCount() - 1;
+  if (dynamic_index >= dynamic_entries_.size()) {
+    return false;
+  }
+  const Entry* entry = dynamic_entries_[dynamic_index];
+  *name = entry->name;
+  *value = entry->value;
+  return true;
+}
+
+uint32 HpackHeaderTable::FindEntry(base::StringPiece name,
+                                   base::StringPiece value,
+                                   uint32* name_index) const {
+  uint32 index = 0;
+  uint32 found_name_index = 0;
+  for (uint32 i = 0; i < GetStaticEntryCount() && index == 0; ++i) {
+    if (name != kStaticTable[i].name) {
+      continue;
+    }
+    if (found_name_index == 0) {
+      found_name_index = i + 1;
+    }
+    if (value == kStaticTable[i].value) {
+      index = i + 1;
+    }
+  }
+  for (size_t i = 0; i < dynamic_entries_.size() && index == 0; ++i) {
+    const Entry* entry = dynamic_entries_[i];
+    if (name != entry->name) {
+      continue;
+    }
+    if (found_name_index == 0) {
+      found_name_index = GetStaticEntryCount() + i + 1;
+    }
+    if (value == entry->value) {
+      index = GetStaticEntryCount() + i + 1;
+    }
+  }
+  if (name_index) {
+    *name_index = found_name_index;
+  }
+  return index;
+}
+
+void HpackHeaderTable::AddEntry(base::StringPiece name,
+                                base::StringPiece value) {
+  const size_t entry_size = EntrySize(name, value);
+  // |name| and |value| may point into an entry which is about to be evicted,
+  // so copy them before evicting anything.
+  Entry* entry = entry_size <= max_size_ ? new Entry(name, value) : NULL;
+  while (!dynamic_entries_.empty() &&
+         (entry == NULL || size_ + entry_size > max_size_)) {
+    Entry* oldest = dynamic_entries_.back();
+    dynamic_entries_.pop_back();
+    size_ -= EntrySize(oldest->name, oldest->value);
+    evicted_entries_.push_back(oldest);
+  }
+  if (entry == NULL) {
+    DCHECK_EQ(0u, size_);
+    return;
+  }
+  dynamic_entries_.push_front(entry);
+  size_ += entry_size;
+}
+
+void HpackHeaderTable::ReleaseEvictedEntries() {
+  evicted_entries_.clear();
+}
+
+}  // namespace net
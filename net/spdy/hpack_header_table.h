@@ -0,0 +1,85 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_HPACK_HEADER_TABLE_H_
+#define NET_SPDY_HPACK_HEADER_TABLE_H_
+
+#include <deque>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+// The default (and, as nothing negotiates it yet, only) maximum size of a
+// dynamic header table, in the units of HpackHeaderTable::EntrySize().
+const size_t kDefaultHpackHeaderTableSize = 4096;
+
+// An HpackHeaderTable is the indexed header table shared by an HPACK-style
+// encoder and decoder. Indices are 1-based: the fixed static entries come
+// first, followed by the dynamic entries from newest to oldest. Adding a
+// dynamic entry evicts the oldest ones until the table fits in its maximum
+// size.
+class NET_EXPORT_PRIVATE HpackHeaderTable {
+ public:
+  explicit HpackHeaderTable(size_t max_size);
+  ~HpackHeaderTable();
+
+  // The size that an entry with |name| and |value| counts against
+  // the table's maximum size.
+  static size_t EntrySize(base::StringPiece name, base::StringPiece value);
+
+  // Returns the number of static entries, which occupy indices
+  // 1 to GetStaticEntryCount().
+  static uint32 GetStaticEntryCount();
+
+  // Sets |name| and |value| to the entry at |index|, returning false if there
+  // is no such entry. The pieces stay valid until ReleaseEvictedEntries() is
+  // called, even if the entry is evicted in the meantime.
+  bool GetEntry(uint32 index,
+                base::StringPiece* name,
+                base::StringPiece* value) const;
+
+  // Returns the index of an entry matching both |name| and |value|, or 0 if
+  // there is none. If |name_index| is not NULL it is set to the index of an
+  // entry with a matching name, or 0.
+  uint32 FindEntry(base::StringPiece name,
+                   base::StringPiece value,
+                   uint32* name_index) const;
+
+  // Adds |name| and |value| as the newest dynamic entry. An entry larger than
+  // the maximum size empties the table and isn't added.
+  void AddEntry(base::StringPiece name, base::StringPiece value);
+
+  // Frees the entries evicted since the last call.
+  void ReleaseEvictedEntries();
+
+  size_t size() const { return size_; }
+  size_t max_size() const { return max_size_; }
+  size_t dynamic_entry_count() const { return dynamic_entries_.size(); }
+
+ private:
+  struct Entry {
+    Entry(base::StringPiece name, base::StringPiece value);
+
+    std::string name;
+    std::string value;
+  };
+
+  // Newest entries are at the front. The entries are heap-allocated so that
+  // StringPieces into them survive eviction to |evicted_entries_|.
+  std::deque<Entry*> dynamic_entries_;
+  ScopedVector<Entry> evicted_entries_;
+  size_t size_;
+  const size_t max_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(HpackHeaderTable);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_HPACK_HEADER_TABLE_H_
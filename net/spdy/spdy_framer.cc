@@ -12,6 +12,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/stats_counters.h"
 #include "base/third_party/valgrind/memcheck.h"
+#include "net/spdy/hpack_encoder.h"
 #include "net/spdy/spdy_frame_builder.h"
 #include "net/spdy/spdy_frame_reader.h"
 #include "net/spdy/spdy_bitmasks.h"
@@ -117,6 +118,7 @@ SpdyCredential::~SpdyCredential() {}
 SpdyFramer::SpdyFramer(SpdyMajorVersion version)
     : current_frame_buffer_(new char[kControlFrameBufferSize]),
       enable_compression_(true),
+      enable_header_indexing_(false),
       visitor_(NULL),
       debug_visitor_(NULL),
       display_protocol_("SPDY"),
@@ -137,6 +139,11 @@ SpdyFramer::~SpdyFramer() {
   }
 }
 
+void SpdyFramer::set_enable_header_indexing(bool value) {
+  DCHECK(!value || spdy_version_ >= SPDY4);
+  enable_header_indexing_ = value;
+}
+
 void SpdyFramer::Reset() {
   state_ = SPDY_RESET;
   previous_state_ = SPDY_RESET;
@@ -1231,7 +1238,10 @@ size_t SpdyFramer::ProcessControlFrameHeaderBlock(const char* data,
   }
   size_t process_bytes = std::min(data_len, remaining_data_length_);
   if (process_bytes > 0) {
-    if (enable_compression_) {
+    if (UseHeaderIndexing()) {
+      // Indexed header blocks are decoded once all of their bytes are in.
+      indexed_header_block_.append(data, process_bytes);
+    } else if (enable_compression_) {
       processed_successfully = IncrementallyDecompressControlFrameHeaderData(
           current_frame_stream_id_, data, process_bytes);
     } else {
@@ -1242,6 +1252,11 @@ size_t SpdyFramer::ProcessControlFrameHeaderBlock(const char* data,
     remaining_data_length_ -= process_bytes;
   }
 
+  if (remaining_data_length_ == 0 && UseHeaderIndexing()) {
+    processed_successfully =
+        DeliverIndexedControlFrameHeaderBlock(current_frame_stream_id_);
+  }
+
   // Handle the case that there is no futher data in this frame.
   if (remaining_data_length_ == 0 && processed_successfully) {
     // The complete header block has been delivered. We send a zero-length
@@ -2108,6 +2123,9 @@ size_t SpdyFramer::GetSerializedLength(const SpdyHeaderBlock& headers) {
   if (!enable_compression_) {
     return uncompressed_length;
   }
+  if (enable_header_indexing_) {
+    return HpackEncoder::GetEncodedLengthBound(headers);
+  }
   z_stream* compressor = GetHeaderCompressor();
   // Since we'll be performing lots of flushes when compressing the data,
   // zlib's lower bounds may be insufficient.
@@ -2174,6 +2192,18 @@ z_stream* SpdyFramer::GetHeaderDecompressor() {
   return header_decompressor_.get();
 }
 
+HpackEncoder* SpdyFramer::GetHpackEncoder() {
+  if (!hpack_encoder_.get())
+    hpack_encoder_.reset(new HpackEncoder(kDefaultHpackHeaderTableSize));
+  return hpack_encoder_.get();
+}
+
+HpackDecoder* SpdyFramer::GetHpackDecoder() {
+  if (!hpack_decoder_.get())
+    hpack_decoder_.reset(new HpackDecoder(kDefaultHpackHeaderTableSize));
+  return hpack_decoder_.get();
+}
+
 // Incrementally decompress the control frame's header block, feeding the
 // result to the visitor in chunks. Continue this until the visitor
 // indicates that it cannot process any more data, or (more commonly) we
@@ -2265,6 +2295,47 @@ bool SpdyFramer::IncrementallyDeliverControlFrameHeaderData(
   return read_successfully;
 }
 
+bool SpdyFramer::DeliverIndexedControlFrameHeaderBlock(
+    SpdyStreamId stream_id) {
+  HpackHeaderPieces headers;
+  if (!GetHpackDecoder()->DecodeHeaderSet(indexed_header_block_, &headers)) {
+    DLOG(WARNING) << "Invalid indexed header block.";
+    set_error(SPDY_DECOMPRESS_FAILURE);
+    return false;
+  }
+  indexed_header_block_.clear();
+
+  if (visitor_->AcceptsHeaderPieces()) {
+    if (!visitor_->OnControlFrameHeaderPieces(stream_id, headers)) {
+      set_error(SPDY_CONTROL_PAYLOAD_TOO_LARGE);
+      return false;
+    }
+    return true;
+  }
+
+  // Other visitors parse the uncompressed name/value block format, so write the
+  // decoded headers out in that format. SPDY4 and later use 32-bit lengths.
+  DCHECK_GE(protocol_version(), SPDY4);
+  std::string* block = &indexed_header_scratch_;
+  block->clear();
+  const uint32 num_headers = htonl(headers.size());
+  block->append(reinterpret_cast<const char*>(&num_headers),
+                sizeof(num_headers));
+  for (HpackHeaderPieces::const_iterator it = headers.begin();
+       it != headers.end(); ++it) {
+    const uint32 name_length = htonl(it->first.size());
+    block->append(reinterpret_cast<const char*>(&name_length),
+                  sizeof(name_length));
+    block->append(it->first.data(), it->first.size());
+    const uint32 value_length = htonl(it->second.size());
+    block->append(reinterpret_cast<const char*>(&value_length),
+                  sizeof(value_length));
+    block->append(it->second.data(), it->second.size());
+  }
+  return IncrementallyDeliverControlFrameHeaderData(stream_id, block->data(),
+                                                    block->size());
+}
+
 void SpdyFramer::SerializeNameValueBlockWithoutCompression(
     SpdyFrameBuilder* builder,
     const SpdyNameValueBlock& name_value_block) const {
@@ -2297,6 +2368,15 @@ void SpdyFramer::SerializeNameValueBlock(
                                                      frame.name_value_block());
   }
 
+  if (enable_header_indexing_) {
+    std::string* encoded = &indexed_header_scratch_;
+    encoded->clear();
+    GetHpackEncoder()->EncodeHeaderSet(frame.name_value_block(), encoded);
+    builder->WriteBytes(encoded->data(), encoded->size());
+    builder->RewriteLength(*this);
+    return;
+  }
+
   // First build an uncompressed version to be fed into the compressor.
   const size_t uncompressed_len = GetSerializedLength(
       protocol_version(), &(frame.name_value_block()));
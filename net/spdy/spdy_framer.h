@@ -16,6 +16,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/sys_byteorder.h"
 #include "net/base/net_export.h"
+#include "net/spdy/hpack_decoder.h"
 #include "net/spdy/spdy_header_block.h"
 #include "net/spdy/spdy_protocol.h"
 
@@ -25,6 +26,7 @@ typedef struct z_stream_s z_stream;  // Forward declaration for zlib.
 
 namespace net {
 
+class HpackEncoder;
 class HttpProxyClientSocketPoolTest;
 class HttpNetworkLayer;
 class HttpNetworkTransactionTest;
@@ -169,6 +171,22 @@ class NET_EXPORT_PRIVATE SpdyFramerVisitorInterface {
                                         const char* header_data,
                                         size_t len) = 0;
 
+  // Returns true if the visitor takes blocks compressed with the indexed
+  // header table as decoded headers, through OnControlFrameHeaderPieces().
+  // Otherwise they are delivered through OnControlFrameHeaderData() in the
+  // uncompressed name/value block format.
+  virtual bool AcceptsHeaderPieces() const { return false; }
+
+  // Called with the complete, decoded headers of an indexed header block, in
+  // place of the non-empty OnControlFrameHeaderData() calls. |headers| refer
+  // into the framer's buffers and are only valid for the duration of the
+  // call. The zero-length OnControlFrameHeaderData() still follows. Returning
+  // false indicates an unrecoverable error, as for OnControlFrameHeaderData().
+  virtual bool OnControlFrameHeaderPieces(SpdyStreamId stream_id,
+                                          const HpackHeaderPieces& headers) {
+    return false;
+  }
+
   // Called when a SYN_STREAM frame is received.
   // Note that header block data is not included. See
   // OnControlFrameHeaderData().
@@ -492,6 +510,14 @@ class NET_EXPORT_PRIVATE SpdyFramer {
     enable_compression_ = value;
   }
 
+  // Compresses header blocks with an HPACK-style indexed header table
+  // instead of zlib, when compression is enabled. The table is cheaper to
+  // encode against than deflate. Visitors that accept header pieces get the
+  // decoded headers without them being re-serialized; see
+  // AcceptsHeaderPieces(). Only supported for SPDY4 and later, and both
+  // endpoints must agree to use it.
+  void set_enable_header_indexing(bool value);
+
   // Used only in log messages.
   void set_display_protocol(const std::string& protocol) {
     display_protocol_ = protocol;
@@ -594,6 +620,15 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   z_stream* GetHeaderCompressor();
   z_stream* GetHeaderDecompressor();
 
+  // Get (and lazily initialize) the indexed header table state.
+  HpackEncoder* GetHpackEncoder();
+  HpackDecoder* GetHpackDecoder();
+
+  // Whether header blocks are compressed with the indexed header table.
+  bool UseHeaderIndexing() const {
+    return enable_compression_ && enable_header_indexing_;
+  }
+
  private:
   // Deliver the given control frame's uncompressed headers block to the
   // visitor in chunks. Returns true if the visitor has accepted all of the
@@ -611,6 +646,12 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   size_t UpdateCurrentFrameBuffer(const char** data, size_t* len,
                                   size_t max_bytes);
 
+  // Decodes the indexed header block accumulated in |indexed_header_block_|
+  // and delivers it to the visitor, either as header pieces or, in chunks, in
+  // the uncompressed name/value block format. Returns true if the visitor has
+  // accepted the headers.
+  bool DeliverIndexedControlFrameHeaderBlock(SpdyStreamId stream_id);
+
   void WriteHeaderBlockToZ(const SpdyHeaderBlock* headers,
                            z_stream* out) const;
 
@@ -687,6 +728,18 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   scoped_ptr<z_stream> header_compressor_;
   scoped_ptr<z_stream> header_decompressor_;
 
+  // Indexed header table compression, used instead of zlib when
+  // enable_header_indexing_ is set.
+  bool enable_header_indexing_;
+  scoped_ptr<HpackEncoder> hpack_encoder_;
+  scoped_ptr<HpackDecoder> hpack_decoder_;
+  // The indexed header block of the frame being read. It can only be decoded
+  // once complete.
+  std::string indexed_header_block_;
+  // Scratch space for encoding and decoding indexed header blocks, kept to
+  // avoid reallocating it for every frame.
+  std::string indexed_header_scratch_;
+
   SpdyFramerVisitorInterface* visitor_;
   SpdyFramerDebugVisitorInterface* debug_visitor_;
 
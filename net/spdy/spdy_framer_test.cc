@@ -1211,6 +1211,61 @@ TEST_P(SpdyFramerTest, CompressEmptyHeaders) {
                              &headers));
 }
 
+TEST_P(SpdyFramerTest, IndexedHeaderCompression) {
+  if (spdy_version_ < SPDY4) {
+    return;
+  }
+  SpdyHeaderBlock headers;
+  headers[":status"] = "200";
+  headers[":version"] = "HTTP/1.1";
+  headers["server"] = "SpdyServer 1.0";
+  headers["date"] = "Mon 12 Jan 2009 12:12:12 PST";
+  headers["content-type"] = "text/html";
+  headers["x-empty-header"] = "";
+
+  SpdyFramer framer(spdy_version_);
+  framer.set_enable_header_indexing(true);
+  scoped_ptr<SpdyFrame> frame1(
+      framer.CreateSynReply(1, CONTROL_FLAG_NONE, true, &headers));
+  headers["date"] = "Mon 12 Jan 2009 12:12:13 PST";
+  scoped_ptr<SpdyFrame> frame2(
+      framer.CreateSynReply(3, CONTROL_FLAG_NONE, true, &headers));
+  // The second frame refers to the table for all but the changed header.
+  EXPECT_GT(frame1->size(), frame2->size());
+  EXPECT_GT(framer.GetSynReplyMinimumSize() + headers.size() + 2 +
+                headers["date"].size() + 1,
+            frame2->size());
+
+  TestSpdyVisitor visitor(spdy_version_);
+  visitor.use_compression_ = true;
+  visitor.framer_.set_enable_header_indexing(true);
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(frame1->data()), frame1->size());
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(1, visitor.syn_reply_frame_count_);
+  headers["date"] = "Mon 12 Jan 2009 12:12:12 PST";
+  EXPECT_EQ(headers, visitor.headers_);
+
+  visitor.headers_.clear();
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(frame2->data()), frame2->size());
+  EXPECT_EQ(0, visitor.error_count_);
+  EXPECT_EQ(2, visitor.syn_reply_frame_count_);
+  headers["date"] = "Mon 12 Jan 2009 12:12:13 PST";
+  EXPECT_EQ(headers, visitor.headers_);
+
+  // A framer indexing headers can't read zlib compressed header blocks.
+  SpdyFramer zlib_framer(spdy_version_);
+  scoped_ptr<SpdyFrame> zlib_frame(
+      zlib_framer.CreateSynReply(5, CONTROL_FLAG_NONE, true, &headers));
+  visitor.SimulateInFramer(
+      reinterpret_cast<unsigned char*>(zlib_frame->data()),
+      zlib_frame->size());
+  EXPECT_EQ(1, visitor.error_count_);
+  EXPECT_EQ(SpdyFramer::SPDY_DECOMPRESS_FAILURE,
+            visitor.framer_.error_code());
+}
+
 TEST_P(SpdyFramerTest, Basic) {
   const unsigned char kV2Input[] = {
     0x80, spdy_version_ch_, 0x00, 0x01,  // SYN Stream #1
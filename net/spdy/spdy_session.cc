@@ -372,12 +372,24 @@ SpdySession::PushedStreamInfo::PushedStreamInfo(
 
 SpdySession::PushedStreamInfo::~PushedStreamInfo() {}
 
+SpdySession::InFlightWrite::InFlightWrite(
+    SpdyFrameType frame_type,
+    scoped_ptr<SpdyBuffer> frame_buffer,
+    const base::WeakPtr<SpdyStream>& stream)
+    : frame_type(frame_type),
+      buffer(frame_buffer.Pass()),
+      frame_size(buffer->GetRemainingSize()),
+      stream(stream) {}
+
+SpdySession::InFlightWrite::~InFlightWrite() {}
+
 SpdySession::SpdySession(
     const SpdySessionKey& spdy_session_key,
     const base::WeakPtr<HttpServerProperties>& http_server_properties,
     bool verify_domain_authentication,
     bool enable_sending_initial_data,
     bool enable_compression,
+    bool enable_header_indexing,
     bool enable_ping_based_connection_checking,
     NextProto default_protocol,
     size_t stream_initial_recv_window_size,
@@ -393,8 +405,6 @@ SpdySession::SpdySession(
       http_server_properties_(http_server_properties),
       read_buffer_(new IOBuffer(kReadBufferSize)),
       stream_hi_water_mark_(kFirstStreamId),
-      in_flight_write_frame_type_(DATA),
-      in_flight_write_frame_size_(0),
       is_secure_(false),
       certificate_error_code_(OK),
       availability_state_(STATE_AVAILABLE),
@@ -516,6 +526,11 @@ Error SpdySession::InitializeWithSocket(
   buffered_spdy_framer_.reset(
       new BufferedSpdyFramer(NextProtoToSpdyMajorVersion(protocol_),
                              enable_compression_));
+  // Indexed header tables are only defined for SPDY4 and later.
+  if (enable_header_indexing &&
+      buffered_spdy_framer_->protocol_version() >= SPDY4) {
+    buffered_spdy_framer_->set_enable_header_indexing(true);
+  }
   buffered_spdy_framer_->set_visitor(this);
   buffered_spdy_framer_->set_debug_visitor(this);
   UMA_HISTOGRAM_ENUMERATION("Net.SpdyVersion", protocol_, kProtoMaximumVersion);
@@ -1296,44 +1311,66 @@ int SpdySession::DoWrite() {
   DCHECK_NE(availability_state_, STATE_CLOSED);
 
   DCHECK(buffered_spdy_framer_);
-  if (in_flight_write_) {
-    DCHECK_GT(in_flight_write_->GetRemainingSize(), 0u);
+  if (!in_flight_writes_.empty()) {
+    DCHECK_GT(in_flight_writes_.front()->buffer->GetRemainingSize(), 0u);
   } else {
-    // Grab the next frame to send.
-    SpdyFrameType frame_type = DATA;
-    scoped_ptr<SpdyBufferProducer> producer;
-    base::WeakPtr<SpdyStream> stream;
-    if (!write_queue_.Dequeue(&frame_type, &producer, &stream)) {
-      write_state_ = WRITE_STATE_IDLE;
-      return ERR_IO_PENDING;
-    }
+    // Grab the next frames to send. Everything dequeued here goes out in
+    // this write, so stop once the frames fill a coalesced buffer; anything
+    // queued later, or at a higher priority, is then picked up next time
+    // rather than waiting behind frames that were taken too early.
+    size_t coalesced_size = 0;
+    while (in_flight_writes_.size() < kMaxFramesPerWrite &&
+           coalesced_size < kMaxCoalescedWriteSize) {
+      SpdyFrameType frame_type = DATA;
+      scoped_ptr<SpdyBufferProducer> producer;
+      base::WeakPtr<SpdyStream> stream;
+      if (!write_queue_.Dequeue(&frame_type, &producer, &stream))
+        break;
+
+      if (stream.get())
+        DCHECK(!stream->IsClosed());
+
+      // Activate the stream only when sending the SYN_STREAM frame to
+      // guarantee monotonically-increasing stream IDs.
+      if (frame_type == SYN_STREAM) {
+        if (stream.get() && stream->stream_id() == 0) {
+          scoped_ptr<SpdyStream> owned_stream =
+              ActivateCreatedStream(stream.get());
+          InsertActivatedStream(owned_stream.Pass());
+        } else {
+          NOTREACHED();
+          return ERR_UNEXPECTED;
+        }
+      }
 
-    if (stream.get())
-      DCHECK(!stream->IsClosed());
-
-    // Activate the stream only when sending the SYN_STREAM frame to
-    // guarantee monotonically-increasing stream IDs.
-    if (frame_type == SYN_STREAM) {
-      if (stream.get() && stream->stream_id() == 0) {
-        scoped_ptr<SpdyStream> owned_stream =
-            ActivateCreatedStream(stream.get());
-        InsertActivatedStream(owned_stream.Pass());
-      } else {
+      scoped_ptr<SpdyBuffer> buffer = producer->ProduceBuffer();
+      if (!buffer) {
         NOTREACHED();
         return ERR_UNEXPECTED;
       }
+      DCHECK_GE(buffer->GetRemainingSize(),
+                buffered_spdy_framer_->GetFrameMinimumSize());
+      coalesced_size += buffer->GetRemainingSize();
+      in_flight_writes_.push_back(
+          new InFlightWrite(frame_type, buffer.Pass(), stream));
+    }
+
+    if (in_flight_writes_.empty()) {
+      write_state_ = WRITE_STATE_IDLE;
+      return ERR_IO_PENDING;
     }
 
-    in_flight_write_ = producer->ProduceBuffer();
-    if (!in_flight_write_) {
-      NOTREACHED();
-      return ERR_UNEXPECTED;
+    // Copy the frames into one buffer, unless there is only one of them.
+    if (in_flight_writes_.size() > 1) {
+      in_flight_write_buffer_ = new DrainableIOBuffer(
+          new IOBuffer(coalesced_size), coalesced_size);
+      char* data = in_flight_write_buffer_->data();
+      for (size_t i = 0; i < in_flight_writes_.size(); ++i) {
+        const SpdyBuffer* buffer = in_flight_writes_[i]->buffer.get();
+        memcpy(data, buffer->GetRemainingData(), buffer->GetRemainingSize());
+        data += buffer->GetRemainingSize();
+      }
     }
-    in_flight_write_frame_type_ = frame_type;
-    in_flight_write_frame_size_ = in_flight_write_->GetRemainingSize();
-    DCHECK_GE(in_flight_write_frame_size_,
-              buffered_spdy_framer_->GetFrameMinimumSize());
-    in_flight_write_stream_ = stream;
   }
 
   write_state_ = WRITE_STATE_DO_WRITE_COMPLETE;
@@ -1341,11 +1378,19 @@ int SpdySession::DoWrite() {
   // Explicitly store in a scoped_refptr<IOBuffer> to avoid problems
   // with Socket implementations that don't store their IOBuffer
   // argument in a scoped_refptr<IOBuffer> (see crbug.com/232345).
-  scoped_refptr<IOBuffer> write_io_buffer =
-      in_flight_write_->GetIOBufferForRemainingData();
+  scoped_refptr<IOBuffer> write_io_buffer;
+  size_t write_size = 0;
+  if (in_flight_write_buffer_.get()) {
+    write_io_buffer = in_flight_write_buffer_;
+    write_size = in_flight_write_buffer_->BytesRemaining();
+  } else {
+    SpdyBuffer* buffer = in_flight_writes_.front()->buffer.get();
+    write_io_buffer = buffer->GetIOBufferForRemainingData();
+    write_size = buffer->GetRemainingSize();
+  }
   return connection_->socket()->Write(
       write_io_buffer.get(),
-      in_flight_write_->GetRemainingSize(),
+      write_size,
       base::Bind(&SpdySession::PumpWriteLoop,
                  weak_factory_.GetWeakPtr(), WRITE_STATE_DO_WRITE_COMPLETE));
 }
@@ -1354,16 +1399,14 @@ int SpdySession::DoWriteComplete(int result) {
   CHECK(in_io_loop_);
   DCHECK_NE(availability_state_, STATE_CLOSED);
   DCHECK_NE(result, ERR_IO_PENDING);
-  DCHECK_GT(in_flight_write_->GetRemainingSize(), 0u);
+  DCHECK(!in_flight_writes_.empty());
 
   last_activity_time_ = time_func_();
 
   if (result < 0) {
     DCHECK_NE(result, ERR_IO_PENDING);
-    in_flight_write_.reset();
-    in_flight_write_frame_type_ = DATA;
-    in_flight_write_frame_size_ = 0;
-    in_flight_write_stream_.reset();
+    in_flight_writes_.clear();
+    in_flight_write_buffer_ = NULL;
     CloseSessionResult close_session_result =
         DoCloseSession(static_cast<Error>(result), "Write error");
     DCHECK_EQ(close_session_result, SESSION_CLOSED_BUT_NOT_REMOVED);
@@ -1372,30 +1415,46 @@ int SpdySession::DoWriteComplete(int result) {
     return result;
   }
 
-  // It should not be possible to have written more bytes than our
-  // in_flight_write_.
-  DCHECK_LE(static_cast<size_t>(result),
-            in_flight_write_->GetRemainingSize());
-
-  if (result > 0) {
-    in_flight_write_->Consume(static_cast<size_t>(result));
-
-    // We only notify the stream when we've fully written the pending frame.
-    if (in_flight_write_->GetRemainingSize() == 0) {
-      // It is possible that the stream was cancelled while we were
-      // writing to the socket.
-      if (in_flight_write_stream_.get()) {
-        DCHECK_GT(in_flight_write_frame_size_, 0u);
-        in_flight_write_stream_->OnFrameWriteComplete(
-            in_flight_write_frame_type_,
-            in_flight_write_frame_size_);
-      }
-
+  // It should not be possible to have written more bytes than we
+  // passed to the socket.
+  if (in_flight_write_buffer_.get()) {
+    DCHECK_LE(result, in_flight_write_buffer_->BytesRemaining());
+    in_flight_write_buffer_->DidConsume(result);
+    if (in_flight_write_buffer_->BytesRemaining() == 0)
+      in_flight_write_buffer_ = NULL;
+  } else {
+    DCHECK_LE(static_cast<size_t>(result),
+              in_flight_writes_.front()->buffer->GetRemainingSize());
+  }
+
+  // Consume the written bytes from the frames in order. The frames which
+  // have been written completely are kept until all of the bytes have been
+  // accounted for, as notifying their streams may delete other streams.
+  ScopedVector<InFlightWrite> completed_writes;
+  size_t remaining = static_cast<size_t>(result);
+  while (remaining > 0) {
+    DCHECK(!in_flight_writes_.empty());
+    SpdyBuffer* buffer = in_flight_writes_.front()->buffer.get();
+    const size_t consume_size =
+        std::min(remaining, buffer->GetRemainingSize());
+    buffer->Consume(consume_size);
+    remaining -= consume_size;
+    if (buffer->GetRemainingSize() == 0) {
       // Cleanup the write which just completed.
-      in_flight_write_.reset();
-      in_flight_write_frame_type_ = DATA;
-      in_flight_write_frame_size_ = 0;
-      in_flight_write_stream_.reset();
+      completed_writes.push_back(in_flight_writes_.front());
+      in_flight_writes_.weak_erase(in_flight_writes_.begin());
+    }
+  }
+
+  // We only notify a stream when we've fully written its pending frame.
+  for (size_t i = 0; i < completed_writes.size(); ++i) {
+    // It is possible that the stream was cancelled while we were
+    // writing to the socket.
+    const InFlightWrite* write = completed_writes[i];
+    if (write->stream.get()) {
+      DCHECK_GT(write->frame_size, 0u);
+      write->stream->OnFrameWriteComplete(write->frame_type,
+                                          write->frame_size);
     }
   }
 
@@ -1674,7 +1733,7 @@ void SpdySession::EnqueueWrite(RequestPriority priority,
   write_queue_.Enqueue(priority, frame_type, producer.Pass(), stream);
   if (write_state_ == WRITE_STATE_IDLE) {
     DCHECK(was_idle);
-    DCHECK(!in_flight_write_);
+    DCHECK(in_flight_writes_.empty());
     write_state_ = WRITE_STATE_DO_WRITE;
     base::MessageLoop::current()->PostTask(
         FROM_HERE,
@@ -1712,12 +1771,13 @@ void SpdySession::InsertActivatedStream(scoped_ptr<SpdyStream> stream) {
 }
 
 void SpdySession::DeleteStream(scoped_ptr<SpdyStream> stream, int status) {
-  if (in_flight_write_stream_.get() == stream.get()) {
-    // If we're deleting the stream for the in-flight write, we still
-    // need to let the write complete, so we clear
-    // |in_flight_write_stream_| and let the write finish on its own
-    // without notifying |in_flight_write_stream_|.
-    in_flight_write_stream_.reset();
+  for (size_t i = 0; i < in_flight_writes_.size(); ++i) {
+    if (in_flight_writes_[i]->stream.get() == stream.get()) {
+      // If we're deleting the stream for an in-flight write, we still
+      // need to let the write complete, so we clear its stream and let
+      // the write finish on its own without notifying the stream.
+      in_flight_writes_[i]->stream.reset();
+    }
   }
 
   write_queue_.RemovePendingWritesForStream(stream->GetWeakPtr());
@@ -14,6 +14,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "net/base/io_buffer.h"
@@ -58,6 +59,14 @@ const int kMaxConcurrentPushedStreams = 1000;
 // yielding.
 const int kMaxReadBytesWithoutYielding = 32 * 1024;
 
+// Up to this many queued frames are dequeued together, and copied into a
+// single buffer so that they go out in one socket write.
+const size_t kMaxFramesPerWrite = 16;
+
+// No more frames are dequeued for a write once it holds this many bytes,
+// which keeps a coalesced write to about one SSL record.
+const size_t kMaxCoalescedWriteSize = 16 * 1024;
+
 // The initial receive window size for both streams and sessions.
 const int32 kDefaultInitialRecvWindowSize = 10 * 1024 * 1024;  // 10MB
 
@@ -207,6 +216,7 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
               bool verify_domain_authentication,
               bool enable_sending_initial_data,
               bool enable_compression,
+              bool enable_header_indexing,
               bool enable_ping_based_connection_checking,
               NextProto default_protocol,
               size_t stream_initial_recv_window_size,
@@ -970,17 +980,30 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   // The write queue.
   SpdyWriteQueue write_queue_;
 
-  // Data for the frame we are currently sending.
-
-  // The buffer we're currently writing.
-  scoped_ptr<SpdyBuffer> in_flight_write_;
-  // The type of the frame in |in_flight_write_|.
-  SpdyFrameType in_flight_write_frame_type_;
-  // The size of the frame in |in_flight_write_|.
-  size_t in_flight_write_frame_size_;
-  // The stream to notify when |in_flight_write_| has been written to
-  // the socket completely.
-  base::WeakPtr<SpdyStream> in_flight_write_stream_;
+  // Data for the frames we are currently sending.
+
+  // A frame which has been dequeued from |write_queue_| but not yet
+  // completely written to the socket.
+  struct InFlightWrite {
+    InFlightWrite(SpdyFrameType frame_type,
+                  scoped_ptr<SpdyBuffer> frame_buffer,
+                  const base::WeakPtr<SpdyStream>& stream);
+    ~InFlightWrite();
+
+    SpdyFrameType frame_type;
+    scoped_ptr<SpdyBuffer> buffer;
+    // The size of the frame in |buffer|.
+    size_t frame_size;
+    // The stream to notify when |buffer| has been written to the
+    // socket completely.
+    base::WeakPtr<SpdyStream> stream;
+  };
+
+  // The frames we're currently writing, in the order they go out.
+  ScopedVector<InFlightWrite> in_flight_writes_;
+  // When the current socket write covers more than one frame, a copy of
+  // their data. The frames' buffers are consumed as this is written.
+  scoped_refptr<DrainableIOBuffer> in_flight_write_buffer_;
 
   // Flag if we're using an SSL connection for this SpdySession.
   bool is_secure_;
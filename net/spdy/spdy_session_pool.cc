@@ -34,6 +34,7 @@ SpdySessionPool::SpdySessionPool(
     bool force_single_domain,
     bool enable_ip_pooling,
     bool enable_compression,
+    bool enable_header_indexing,
     bool enable_ping_based_connection_checking,
     NextProto default_protocol,
     size_t stream_initial_recv_window_size,
@@ -49,6 +50,7 @@ SpdySessionPool::SpdySessionPool(
       force_single_domain_(force_single_domain),
       enable_ip_pooling_(enable_ip_pooling),
       enable_compression_(enable_compression),
+      enable_header_indexing_(enable_header_indexing),
       enable_ping_based_connection_checking_(
           enable_ping_based_connection_checking),
       // TODO(akalin): Force callers to have a valid value of
@@ -98,6 +100,7 @@ net::Error SpdySessionPool::CreateAvailableSessionFromSocket(
                       verify_domain_authentication_,
                       enable_sending_initial_data_,
                       enable_compression_,
+                      enable_header_indexing_,
                       enable_ping_based_connection_checking_,
                       default_protocol_,
                       stream_initial_recv_window_size_,
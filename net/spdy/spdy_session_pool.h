@@ -53,6 +53,7 @@ class NET_EXPORT SpdySessionPool
       bool force_single_domain,
       bool enable_ip_pooling,
       bool enable_compression,
+      bool enable_header_indexing,
       bool enable_ping_based_connection_checking,
       NextProto default_protocol,
       size_t stream_initial_recv_window_size,
@@ -214,6 +215,7 @@ class NET_EXPORT SpdySessionPool
   bool force_single_domain_;
   bool enable_ip_pooling_;
   bool enable_compression_;
+  bool enable_header_indexing_;
   bool enable_ping_based_connection_checking_;
   const NextProto default_protocol_;
   size_t stream_initial_recv_window_size_;
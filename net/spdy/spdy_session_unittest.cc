@@ -1554,6 +1554,158 @@ TEST_P(SpdySessionTest, CancelStream) {
   EXPECT_EQ(NULL, spdy_stream2.get());
 }
 
+// Frames which are queued together should go out in a single socket
+// write, in priority order.
+TEST_P(SpdySessionTest, CoalesceQueuedFrames) {
+  MockConnect connect_data(SYNCHRONOUS, OK);
+  scoped_ptr<SpdyFrame> req1(
+      spdy_util_.ConstructSpdyGet(NULL, 0, false, 1, HIGHEST, true));
+  scoped_ptr<SpdyFrame> req2(
+      spdy_util_.ConstructSpdyGet(NULL, 0, false, 3, LOWEST, true));
+  const SpdyFrame* reqs[] = { req1.get(), req2.get() };
+  char combined_reqs[1000];
+  int combined_reqs_len = CombineFrames(reqs, arraysize(reqs),
+                                        combined_reqs,
+                                        arraysize(combined_reqs));
+  MockWrite writes[] = {
+    MockWrite(ASYNC, combined_reqs, combined_reqs_len, 0),
+  };
+
+  MockRead reads[] = {
+    MockRead(ASYNC, 0, 1)  // EOF
+  };
+
+  session_deps_.host_resolver->set_synchronous_mode(true);
+
+  DeterministicSocketData data(reads, arraysize(reads),
+                               writes, arraysize(writes));
+  data.set_connect_data(connect_data);
+  session_deps_.deterministic_socket_factory->AddSocketDataProvider(&data);
+
+  CreateDeterministicNetworkSession();
+
+  base::WeakPtr<SpdySession> session =
+      CreateInsecureSpdySession(http_session_, key_, BoundNetLog());
+
+  GURL url("http://www.google.com");
+  base::WeakPtr<SpdyStream> spdy_stream2 =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM,
+                                session, url, LOWEST, BoundNetLog());
+  ASSERT_TRUE(spdy_stream2.get() != NULL);
+  test::StreamDelegateDoNothing delegate2(spdy_stream2);
+  spdy_stream2->SetDelegate(&delegate2);
+
+  base::WeakPtr<SpdyStream> spdy_stream1 =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM,
+                                session, url, HIGHEST, BoundNetLog());
+  ASSERT_TRUE(spdy_stream1.get() != NULL);
+  test::StreamDelegateDoNothing delegate1(spdy_stream1);
+  spdy_stream1->SetDelegate(&delegate1);
+
+  spdy_stream2->SendRequestHeaders(
+      spdy_util_.ConstructGetHeaderBlock(url.spec()), NO_MORE_DATA_TO_SEND);
+  spdy_stream1->SendRequestHeaders(
+      spdy_util_.ConstructGetHeaderBlock(url.spec()), NO_MORE_DATA_TO_SEND);
+
+  data.RunFor(1);
+
+  EXPECT_EQ(1u, delegate1.stream_id());
+  EXPECT_EQ(3u, delegate2.stream_id());
+  EXPECT_TRUE(data.at_write_eof());
+
+  data.RunFor(1);
+  EXPECT_TRUE(session == NULL);
+}
+
+// Once a write is full, further queued frames stay in the write queue, so
+// a higher-priority frame queued during the write overtakes them.
+TEST_P(SpdySessionTest, CoalescedWriteLeavesRestQueued) {
+  MockConnect connect_data(SYNCHRONOUS, OK);
+  // Two of these headers don't fit in one coalesced write.
+  const std::string big_value(9000, 'x');
+  const char* const kBigHeaders[] = { "x-big", big_value.c_str() };
+  scoped_ptr<SpdyFrame> low1(spdy_util_.ConstructSpdyGet(
+      kBigHeaders, 1, false, 1, LOWEST, true));
+  scoped_ptr<SpdyFrame> low2(spdy_util_.ConstructSpdyGet(
+      kBigHeaders, 1, false, 3, LOWEST, true));
+  scoped_ptr<SpdyFrame> high(
+      spdy_util_.ConstructSpdyGet(NULL, 0, false, 5, HIGHEST, true));
+  scoped_ptr<SpdyFrame> low3(
+      spdy_util_.ConstructSpdyGet(NULL, 0, false, 7, LOWEST, true));
+  const SpdyFrame* first_write[] = { low1.get(), low2.get() };
+  const SpdyFrame* second_write[] = { high.get(), low3.get() };
+  char first_data[2 * kMaxCoalescedWriteSize];
+  int first_len = CombineFrames(first_write, arraysize(first_write),
+                                first_data, arraysize(first_data));
+  char second_data[1000];
+  int second_len = CombineFrames(second_write, arraysize(second_write),
+                                 second_data, arraysize(second_data));
+  MockWrite writes[] = {
+    MockWrite(ASYNC, first_data, first_len, 0),
+    MockWrite(ASYNC, second_data, second_len, 1),
+  };
+
+  MockRead reads[] = {
+    MockRead(ASYNC, 0, 2)  // EOF
+  };
+
+  session_deps_.host_resolver->set_synchronous_mode(true);
+
+  DeterministicSocketData data(reads, arraysize(reads),
+                               writes, arraysize(writes));
+  data.set_connect_data(connect_data);
+  session_deps_.deterministic_socket_factory->AddSocketDataProvider(&data);
+
+  CreateDeterministicNetworkSession();
+
+  base::WeakPtr<SpdySession> session =
+      CreateInsecureSpdySession(http_session_, key_, BoundNetLog());
+
+  GURL url("http://www.google.com");
+  base::WeakPtr<SpdyStream> low_streams[3];
+  scoped_ptr<test::StreamDelegateDoNothing> low_delegates[3];
+  for (size_t i = 0; i < arraysize(low_streams); ++i) {
+    low_streams[i] =
+        CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM,
+                                  session, url, LOWEST, BoundNetLog());
+    ASSERT_TRUE(low_streams[i].get() != NULL);
+    low_delegates[i].reset(
+        new test::StreamDelegateDoNothing(low_streams[i]));
+    low_streams[i]->SetDelegate(low_delegates[i].get());
+  }
+
+  base::WeakPtr<SpdyStream> high_stream =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM,
+                                session, url, HIGHEST, BoundNetLog());
+  ASSERT_TRUE(high_stream.get() != NULL);
+  test::StreamDelegateDoNothing high_delegate(high_stream);
+  high_stream->SetDelegate(&high_delegate);
+
+  for (size_t i = 0; i < arraysize(low_streams); ++i) {
+    scoped_ptr<SpdyHeaderBlock> headers(
+        spdy_util_.ConstructGetHeaderBlock(url.spec()));
+    if (i < 2)
+      (*headers)["x-big"] = big_value;
+    low_streams[i]->SendRequestHeaders(headers.Pass(), NO_MORE_DATA_TO_SEND);
+  }
+
+  // Start the first write, then queue the high-priority request behind it.
+  base::MessageLoop::current()->RunUntilIdle();
+  high_stream->SendRequestHeaders(
+      spdy_util_.ConstructGetHeaderBlock(url.spec()), NO_MORE_DATA_TO_SEND);
+
+  data.RunFor(2);
+
+  EXPECT_EQ(1u, low_delegates[0]->stream_id());
+  EXPECT_EQ(3u, low_delegates[1]->stream_id());
+  EXPECT_EQ(5u, high_delegate.stream_id());
+  EXPECT_EQ(7u, low_delegates[2]->stream_id());
+  EXPECT_TRUE(data.at_write_eof());
+
+  data.RunFor(1);
+  EXPECT_TRUE(session == NULL);
+}
+
 // Create two streams that are set to re-close themselves on close,
 // and then close the session. Nothing should blow up. Also a
 // regression test for http://crbug.com/139518 .
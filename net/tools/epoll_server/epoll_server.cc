@@ -617,12 +617,19 @@ void EpollServer::ModifyFD(int fd, int remove_event, int add_event) {
     int & event_mask = fd_i->event_mask;
     VLOG(3) << "fd= " << fd
             << " event_mask before: " << EventMaskToString(event_mask);
+    const int old_event_mask = event_mask;
     event_mask &= ~remove_event;
     event_mask |= add_event;
 
     VLOG(3) << " event_mask after: " << EventMaskToString(event_mask);
 
-    ModFD(fd, event_mask);
+    // Callbacks often StartRead() or StopRead() without the mask actually
+    // changing; skip the system call then. A one-shot or edge-triggered fd
+    // still needs the EPOLL_CTL_MOD, which re-arms it.
+    if (event_mask != old_event_mask ||
+        (event_mask & (EPOLLONESHOT | EPOLLET)) != 0) {
+      ModFD(fd, event_mask);
+    }
 
     fd_i->cb->OnModification(fd, event_mask);
   }
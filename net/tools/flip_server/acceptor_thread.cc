@@ -4,6 +4,7 @@
 
 #include "net/tools/flip_server/acceptor_thread.h"
 
+#include <errno.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>  // For TCP_NODELAY
 #include <sys/socket.h>
@@ -77,7 +78,15 @@ SMConnection* SMAcceptorThread::FindOrMakeNewSMConnection() {
 }
 
 void SMAcceptorThread::InitWorker() {
-  epoll_server_.RegisterFD(acceptor_->listen_fd_, this, EPOLLIN | EPOLLET);
+  // When accepts per wake are capped, connections can still be pending after
+  // AcceptFromListenFD() returns. An edge-triggered registration would not
+  // report them again until yet another connection arrived, so use level
+  // triggering, which lets the remaining accepts interleave with connection
+  // work on later epoll waits.
+  int event_mask = EPOLLIN;
+  if (acceptor_->accepts_per_wake_ <= 0)
+    event_mask |= EPOLLET;
+  epoll_server_.RegisterFD(acceptor_->listen_fd_, this, event_mask);
 }
 
 void SMAcceptorThread::HandleConnection(int server_fd,
@@ -114,38 +123,22 @@ void SMAcceptorThread::HandleConnection(int server_fd,
 }
 
 void SMAcceptorThread::AcceptFromListenFD() {
-  if (acceptor_->accepts_per_wake_ > 0) {
-    for (int i = 0; i < acceptor_->accepts_per_wake_; ++i) {
-      struct sockaddr address;
-      socklen_t socklen = sizeof(address);
-      int fd = accept(acceptor_->listen_fd_, &address, &socklen);
-      if (fd == -1) {
-        if (errno != 11) {
-          VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Acceptor: accept fail("
-                  << acceptor_->listen_fd_ << "): " << errno << ": "
-                  << strerror(errno);
-        }
-        break;
+  // A non-positive accepts_per_wake_ means accept until the backlog drains.
+  const int max_accepts = acceptor_->accepts_per_wake_;
+  for (int i = 0; max_accepts <= 0 || i < max_accepts; ++i) {
+    struct sockaddr address;
+    socklen_t socklen = sizeof(address);
+    int fd = accept(acceptor_->listen_fd_, &address, &socklen);
+    if (fd == -1) {
+      if (errno != EAGAIN) {
+        VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Acceptor: accept fail("
+                << acceptor_->listen_fd_ << "): " << errno << ": "
+                << strerror(errno);
       }
-      VLOG(1) << ACCEPTOR_CLIENT_IDENT << " Accepted connection";
-      HandleConnection(fd, (struct sockaddr_in *)&address);
-    }
-  } else {
-    while (true) {
-      struct sockaddr address;
-      socklen_t socklen = sizeof(address);
-      int fd = accept(acceptor_->listen_fd_, &address, &socklen);
-      if (fd == -1) {
-        if (errno != 11) {
-          VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Acceptor: accept fail("
-                  << acceptor_->listen_fd_ << "): " << errno << ": "
-                  << strerror(errno);
-        }
-        break;
-      }
-      VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Accepted connection";
-      HandleConnection(fd, (struct sockaddr_in *)&address);
+      break;
     }
+    VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Accepted connection";
+    HandleConnection(fd, (struct sockaddr_in *)&address);
   }
 }
 
@@ -127,7 +127,12 @@ void MemoryCache::ReadToString(const char* filename, std::string* output) {
   int fd = open(filename, 0, "r");
   if (fd == -1)
     return;
-  char buffer[4096];
+  // Size the string up front so that large captures aren't reallocated and
+  // copied over and over as they are read in.
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+    output->reserve(static_cast<size_t>(file_stat.st_size));
+  char buffer[64 * 1024];
   ssize_t read_status = read(fd, buffer, sizeof(buffer));
   while (read_status > 0) {
     output->append(buffer, static_cast<size_t>(read_status));
@@ -170,7 +175,7 @@ void MemoryCache::ReadAndStoreFileContents(const char* filename) {
       // file, then the rest of the data is the body.  Many of the captures
       // from within Chrome don't have content-lengths.
       if (!visitor.body.length())
-        visitor.body = filename_contents.substr(pos);
+        visitor.body.assign(filename_contents, pos, std::string::npos);
       break;
     }
   }
@@ -4,6 +4,7 @@
 
 #include "net/tools/flip_server/output_ordering.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "net/tools/flip_server/flip_config.h"
@@ -12,6 +13,19 @@
 
 namespace net {
 
+namespace {
+
+// Each step up in priority multiplies a level's share of the output by this.
+const uint32 kPriorityWeightFactor = 2;
+
+int ClampPriority(int priority) {
+  return std::min(std::max(priority, 0), OutputOrdering::kNumPriorities - 1);
+}
+
+}  // namespace
+
+const int OutputOrdering::kNumPriorities;
+
 OutputOrdering::PriorityMapPointer::PriorityMapPointer()
     : ring(NULL),
       alarm_enabled(false) {
@@ -25,6 +39,8 @@ OutputOrdering::OutputOrdering(SMConnectionInterface* connection)
       connection_(connection) {
   if (connection)
     epoll_server_ = connection->epoll_server();
+  for (int i = 0; i < kNumPriorities; ++i)
+    round_credits_[i] = WeightForPriority(i);
 }
 
 OutputOrdering::~OutputOrdering() {
@@ -37,11 +53,13 @@ void OutputOrdering::Reset() {
     PriorityMapPointer& pmp = sitpmi->second;
     if (pmp.alarm_enabled) {
       epoll_server_->UnregisterAlarm(pmp.alarm_token);
+    } else {
+      pmp.ring->erase(pmp.it);
     }
     stream_ids_.erase(sitpmi);
   }
-  priority_map_.clear();
-  first_data_senders_.clear();
+  for (int i = 0; i < kNumPriorities; ++i)
+    DCHECK(priority_rings_[i].empty());
 }
 
 bool OutputOrdering::ExistsInPriorityMaps(uint32 stream_id) const {
@@ -91,9 +109,10 @@ void OutputOrdering::BeginOutputtingAlarm::OnShutdown(EpollServer* eps) {
 
 void OutputOrdering::MoveToActive(PriorityMapPointer* pmp, MemCacheIter mci) {
   VLOG(2) << "Moving to active!";
-  first_data_senders_.push_back(mci);
-  pmp->ring = &first_data_senders_;
-  pmp->it = first_data_senders_.end();
+  PriorityRing* ring = &priority_rings_[ClampPriority(mci.priority)];
+  ring->push_back(mci);
+  pmp->ring = ring;
+  pmp->it = ring->end();
   --pmp->it;
   connection_->ReadyToSend();
 }
@@ -128,46 +147,27 @@ void OutputOrdering::AddToOutputOrder(const MemCacheIter& mci) {
       think_time_in_s * 1000000, boa);
 }
 
-void OutputOrdering::SpliceToPriorityRing(PriorityRing::iterator pri) {
-  MemCacheIter& mci = *pri;
-  PriorityMap::iterator pmi = priority_map_.find(mci.priority);
-  if (pmi == priority_map_.end()) {
-    pmi = priority_map_.insert(
-        std::pair<uint32, PriorityRing>(mci.priority, PriorityRing())).first;
-  }
-
-  pmi->second.splice(pmi->second.end(),
-                     first_data_senders_,
-                     pri);
-  StreamIdToPriorityMap::iterator sitpmi = stream_ids_.find(mci.stream_id);
-  sitpmi->second.ring = &(pmi->second);
-}
-
 MemCacheIter* OutputOrdering::GetIter() {
-  while (!first_data_senders_.empty()) {
-    MemCacheIter& mci = first_data_senders_.front();
-    if (mci.bytes_sent >= first_data_senders_threshold_) {
-      SpliceToPriorityRing(first_data_senders_.begin());
-    } else {
-      first_data_senders_.splice(first_data_senders_.end(),
-                                first_data_senders_,
-                                first_data_senders_.begin());
-      mci.max_segment_size = kInitialDataSendersThreshold;
+  // Serve the highest priority level that still has credit this round. Once
+  // every level with output has used its credit, start a new round.
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < kNumPriorities; ++i) {
+      PriorityRing& ring = priority_rings_[i];
+      if (ring.empty() || round_credits_[i] == 0)
+        continue;
+      --round_credits_[i];
+      MemCacheIter& mci = ring.front();
+      ring.splice(ring.end(), ring, ring.begin());
+      // Streams which have only just started get small segments, so that
+      // every new stream gets its first bytes out quickly.
+      if (mci.bytes_sent < first_data_senders_threshold_)
+        mci.max_segment_size = kInitialDataSendersThreshold;
+      else
+        mci.max_segment_size = kSpdySegmentSize;
       return &mci;
     }
-  }
-  while (!priority_map_.empty()) {
-    PriorityRing& first_ring = priority_map_.begin()->second;
-    if (first_ring.empty()) {
-      priority_map_.erase(priority_map_.begin());
-      continue;
-    }
-    MemCacheIter& mci = first_ring.front();
-    first_ring.splice(first_ring.end(),
-                      first_ring,
-                      first_ring.begin());
-    mci.max_segment_size = kSpdySegmentSize;
-    return &mci;
+    for (int i = 0; i < kNumPriorities; ++i)
+      round_credits_[i] = WeightForPriority(i);
   }
   return NULL;
 }
@@ -185,4 +185,12 @@ void OutputOrdering::RemoveStreamId(uint32 stream_id) {
   stream_ids_.erase(sitpmi);
 }
 
+// static
+uint32 OutputOrdering::WeightForPriority(int priority) {
+  uint32 weight = 1;
+  for (int i = ClampPriority(priority); i < kNumPriorities - 1; ++i)
+    weight *= kPriorityWeightFactor;
+  return weight;
+}
+
 }  // namespace net
@@ -19,13 +19,22 @@ namespace net {
 
 class SMConnectionInterface;
 
+// OutputOrdering decides which stream's output goes next. Streams which are
+// ready to send sit in one ring per SPDY priority, and are served round-robin
+// within their ring. Each round, a priority level gets a number of segments
+// that halves with every step down in priority, so higher priority streams
+// get most of the connection without starving lower priority ones.
 class OutputOrdering {
  public:
   typedef std::list<MemCacheIter> PriorityRing;
-  typedef std::map<uint32, PriorityRing> PriorityMap;
+
+  // The number of SPDY priorities; SPDY/2's priorities are a prefix of
+  // these.
+  static const int kNumPriorities = 8;
 
   struct PriorityMapPointer {
     PriorityMapPointer();
+    // Valid once the stream has been moved to active.
     PriorityRing* ring;
     PriorityRing::iterator it;
     bool alarm_enabled;
@@ -35,8 +44,10 @@ class OutputOrdering {
   typedef std::map<uint32, PriorityMapPointer> StreamIdToPriorityMap;
 
   StreamIdToPriorityMap stream_ids_;
-  PriorityMap priority_map_;
-  PriorityRing first_data_senders_;
+  // The active streams, i.e. those with output ready to send, by priority.
+  PriorityRing priority_rings_[kNumPriorities];
+  // The segments each priority level may still send in the current round.
+  uint32 round_credits_[kNumPriorities];
   uint32 first_data_senders_threshold_;  // when you've passed this, you're no
                                          // longer a first_data_sender...
   SMConnectionInterface* connection_;
@@ -70,7 +81,6 @@ class OutputOrdering {
 
   void MoveToActive(PriorityMapPointer* pmp, MemCacheIter mci);
   void AddToOutputOrder(const MemCacheIter& mci);
-  void SpliceToPriorityRing(PriorityRing::iterator pri);
   MemCacheIter* GetIter();
   void RemoveStreamId(uint32 stream_id);
 
@@ -80,6 +90,9 @@ class OutputOrdering {
   }
 
  private:
+  // Returns the number of segments SPDY |priority| gets in each round.
+  static uint32 WeightForPriority(int priority);
+
   static double server_think_time_in_s_;
 };
 
@@ -0,0 +1,193 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/flip_server/output_ordering.h"
+
+#include <map>
+
+#include "net/tools/balsa/balsa_headers.h"
+#include "net/tools/epoll_server/epoll_server.h"
+#include "net/tools/flip_server/constants.h"
+#include "net/tools/flip_server/mem_cache.h"
+#include "net/tools/flip_server/sm_interface.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+class MockSMConnection : public SMConnectionInterface {
+ public:
+  MockSMConnection() {}
+  virtual ~MockSMConnection() {}
+
+  MOCK_METHOD0(ReadyToSend, void());
+  virtual EpollServer* epoll_server() OVERRIDE { return &epoll_server_; }
+
+ private:
+  EpollServer epoll_server_;
+};
+
+class FlipOutputOrderingTest : public ::testing::Test {
+ public:
+  FlipOutputOrderingTest()
+      : file_data_(&headers_, "file", "body"),
+        output_ordering_(&connection_) {
+  }
+
+ protected:
+  // Makes |stream_id| ready to send at |priority|, as if its begin
+  // outputting alarm had fired.
+  void Activate(uint32 stream_id, int priority) {
+    MemCacheIter mci(&file_data_);
+    mci.stream_id = stream_id;
+    mci.priority = priority;
+    OutputOrdering::PriorityMapPointer* pmp =
+        &output_ordering_.stream_ids_[stream_id];
+    output_ordering_.MoveToActive(pmp, mci);
+  }
+
+  // Adds |stream_id| waiting for its begin outputting alarm.
+  void AddPending(uint32 stream_id, int priority) {
+    MemCacheIter mci(&file_data_);
+    mci.stream_id = stream_id;
+    mci.priority = priority;
+    output_ordering_.AddToOutputOrder(mci);
+  }
+
+  // Returns the stream GetIter() picks, or 0 if there is none.
+  uint32 NextStreamId() {
+    MemCacheIter* mci = output_ordering_.GetIter();
+    return mci ? mci->stream_id : 0;
+  }
+
+  BalsaHeaders headers_;
+  FileData file_data_;
+  ::testing::NiceMock<MockSMConnection> connection_;
+  OutputOrdering output_ordering_;
+};
+
+TEST_F(FlipOutputOrderingTest, Empty) {
+  EXPECT_EQ(0u, NextStreamId());
+}
+
+TEST_F(FlipOutputOrderingTest, MoveToActiveSignalsConnection) {
+  EXPECT_CALL(connection_, ReadyToSend());
+  Activate(1, 0);
+  EXPECT_TRUE(output_ordering_.ExistsInPriorityMaps(1));
+}
+
+TEST_F(FlipOutputOrderingTest, RoundRobinWithinPriority) {
+  Activate(1, 2);
+  Activate(3, 2);
+  Activate(5, 2);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(1u, NextStreamId());
+    EXPECT_EQ(3u, NextStreamId());
+    EXPECT_EQ(5u, NextStreamId());
+  }
+}
+
+TEST_F(FlipOutputOrderingTest, PriorityShare) {
+  // Streams at priority 0 get twice the segments of those at priority 1,
+  // and go first.
+  Activate(1, 1);
+  Activate(3, 0);
+  std::map<uint32, int> segments;
+  for (int i = 0; i < 3 * 64; ++i)
+    ++segments[NextStreamId()];
+  EXPECT_EQ(2u, segments.size());
+  EXPECT_EQ(128, segments[3]);
+  EXPECT_EQ(64, segments[1]);
+
+  // The next round starts over at the highest priority.
+  EXPECT_EQ(3u, NextStreamId());
+}
+
+TEST_F(FlipOutputOrderingTest, LowestPriorityIsNotStarved) {
+  Activate(1, 0);
+  Activate(3, OutputOrdering::kNumPriorities - 1);
+  std::map<uint32, int> segments;
+  for (int i = 0; i < 129; ++i)
+    ++segments[NextStreamId()];
+  EXPECT_EQ(128, segments[1]);
+  EXPECT_EQ(1, segments[3]);
+}
+
+TEST_F(FlipOutputOrderingTest, CreditIsRefilledForLoneStream) {
+  // A lone lowest priority stream uses up its one segment each round, and
+  // keeps being served as rounds are started over.
+  Activate(1, OutputOrdering::kNumPriorities - 1);
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(1u, NextStreamId());
+}
+
+TEST_F(FlipOutputOrderingTest, OutOfRangePriorityIsClamped) {
+  Activate(1, OutputOrdering::kNumPriorities + 3);
+  Activate(3, -1);
+  EXPECT_EQ(3u, NextStreamId());
+  EXPECT_EQ(1u, output_ordering_.priority_rings_[
+      OutputOrdering::kNumPriorities - 1].size());
+}
+
+TEST_F(FlipOutputOrderingTest, SegmentSize) {
+  Activate(1, 0);
+  MemCacheIter* mci = output_ordering_.GetIter();
+  ASSERT_TRUE(mci != NULL);
+  EXPECT_EQ(static_cast<uint32>(kInitialDataSendersThreshold),
+            mci->max_segment_size);
+
+  // Once a stream has sent its first data, it gets full segments.
+  mci->bytes_sent = kInitialDataSendersThreshold;
+  mci = output_ordering_.GetIter();
+  ASSERT_TRUE(mci != NULL);
+  EXPECT_EQ(static_cast<uint32>(kSpdySegmentSize), mci->max_segment_size);
+}
+
+TEST_F(FlipOutputOrderingTest, RemoveStreamId) {
+  Activate(1, 0);
+  Activate(3, 0);
+  Activate(5, 0);
+  AddPending(7, 0);
+  EXPECT_EQ(1u, NextStreamId());
+
+  output_ordering_.RemoveStreamId(3);
+  EXPECT_FALSE(output_ordering_.ExistsInPriorityMaps(3));
+  output_ordering_.RemoveStreamId(7);
+  EXPECT_FALSE(output_ordering_.ExistsInPriorityMaps(7));
+  // Unknown streams are ignored.
+  output_ordering_.RemoveStreamId(9);
+
+  EXPECT_EQ(5u, NextStreamId());
+  EXPECT_EQ(1u, NextStreamId());
+  EXPECT_EQ(5u, NextStreamId());
+
+  output_ordering_.RemoveStreamId(1);
+  output_ordering_.RemoveStreamId(5);
+  EXPECT_EQ(0u, NextStreamId());
+}
+
+TEST_F(FlipOutputOrderingTest, Reset) {
+  Activate(1, 0);
+  Activate(3, 4);
+  AddPending(5, 2);
+  EXPECT_TRUE(output_ordering_.ExistsInPriorityMaps(5));
+
+  output_ordering_.Reset();
+  EXPECT_FALSE(output_ordering_.ExistsInPriorityMaps(1));
+  EXPECT_FALSE(output_ordering_.ExistsInPriorityMaps(3));
+  EXPECT_FALSE(output_ordering_.ExistsInPriorityMaps(5));
+  for (int i = 0; i < OutputOrdering::kNumPriorities; ++i)
+    EXPECT_TRUE(output_ordering_.priority_rings_[i].empty());
+  EXPECT_EQ(0u, NextStreamId());
+
+  // The ordering is usable again after a reset.
+  Activate(7, 0);
+  EXPECT_EQ(7u, NextStreamId());
+}
+
+}  // namespace
+
+}  // namespace net
@@ -166,12 +166,15 @@ int SpdySM::SpdyHandleNewStream(
     NewStream(stream_id, priority, filename);
   } else {
     SpdyHeaderBlock::const_iterator version = headers.find("version");
-    http_data += method->second + " " + uri + " " + version->second + "\r\n";
+    http_data.append(method->second).append(" ").append(uri).append(" ")
+        .append(version->second).append("\r\n");
     VLOG(1) << ACCEPTOR_CLIENT_IDENT << "Request: " << method->second << " "
             << uri << " " << version->second;
     for (SpdyHeaderBlock::const_iterator i = headers.begin();
          i != headers.end(); ++i) {
-      http_data += i->first + ": " + i->second + "\r\n";
+      // Append piecewise; operator+ would build a temporary per header.
+      http_data.append(i->first).append(": ").append(i->second)
+          .append("\r\n");
       VLOG(2) << ACCEPTOR_CLIENT_IDENT << i->first.c_str() << ":"
               << i->second.c_str();
     }
@@ -399,11 +402,12 @@ void SpdySM::CopyHeaders(SpdyHeaderBlock& dest, const BalsaHeaders& headers) {
     std::transform(key.begin(), key.end(), key.begin(), ::tolower);
     SpdyHeaderBlock::iterator fhi = dest.find(key);
     if (fhi == dest.end()) {
-      dest[key] = hi->second.as_string();
+      dest[key].assign(hi->second.data(), hi->second.size());
     } else {
-      dest[key] = (
-          std::string(fhi->second.data(), fhi->second.size()) + "\0" +
-          std::string(hi->second.data(), hi->second.size()));
+      // Repeated headers are joined into one NUL-separated value. Append in
+      // place rather than rebuilding the value through temporaries.
+      fhi->second.push_back('\0');
+      fhi->second.append(hi->second.data(), hi->second.size());
     }
   }
 
@@ -457,6 +457,32 @@ TEST_F(FlipSpdySMTest, SendSynReply) {
   ASSERT_EQ("value1", actual_header_block["key1"]);
 }
 
+TEST_F(FlipSpdySMTest, SendSynReplyRepeatedHeader) {
+  uint32 stream_id = 82;
+  BalsaHeaders headers;
+  SpdyHeaderBlock actual_header_block;
+  headers.AppendHeader("key1", "value1");
+  headers.AppendHeader("Key1", "value2");
+  headers.SetResponseFirstlineFromStringPieces("HTTP/1.1", "200", "OK");
+
+  interface_->SendSynReply(stream_id, headers);
+
+  ASSERT_EQ(1u, connection_->output_list()->size());
+  std::list<DataFrame*>::const_iterator i = connection_->output_list()->begin();
+  DataFrame* df = *i++;
+
+  {
+    InSequence s;
+    EXPECT_CALL(*spdy_framer_visitor_, OnSynReply(stream_id, false, _))
+        .WillOnce(SaveArg<2>(&actual_header_block));
+  }
+
+  spdy_framer_->ProcessInput(df->data, df->size);
+  ASSERT_EQ(1, spdy_framer_->frames_received());
+  ASSERT_EQ(3u, actual_header_block.size());
+  ASSERT_EQ(std::string("value1\0value2", 13), actual_header_block["key1"]);
+}
+
 TEST_F(FlipSpdySMTest, SendDataFrame) {
   uint32 stream_id = 133;
   SpdyDataFlags flags = DATA_FLAG_NONE;
@@ -4,8 +4,6 @@
 
 #include "net/tools/quic/quic_default_packet_writer.h"
 
-#include "net/tools/quic/quic_socket_utils.h"
-
 namespace net {
 namespace tools {
 
@@ -20,6 +18,14 @@ WriteResult QuicDefaultPacketWriter::WritePacket(
                                       self_address, peer_address);
 }
 
+WriteResult QuicDefaultPacketWriter::WritePackets(
+    const QuicSocketUtils::PacketToWrite* packets,
+    size_t num_packets,
+    size_t* packets_written) {
+  return QuicSocketUtils::WritePackets(fd_, packets, num_packets,
+                                       packets_written);
+}
+
 bool QuicDefaultPacketWriter::IsWriteBlockedDataBuffered() const {
   return false;
 }
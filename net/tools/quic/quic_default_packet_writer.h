@@ -8,6 +8,7 @@
 #include "base/basictypes.h"
 #include "net/base/ip_endpoint.h"
 #include "net/quic/quic_packet_writer.h"
+#include "net/tools/quic/quic_socket_utils.h"
 
 namespace net {
 
@@ -30,6 +31,12 @@ class QuicDefaultPacketWriter : public QuicPacketWriter {
       QuicBlockedWriterInterface* blocked_writer) OVERRIDE;
   virtual bool IsWriteBlockedDataBuffered() const OVERRIDE;
 
+  // Writes a batch of packets with as few system calls as possible.  See
+  // QuicSocketUtils::WritePackets.
+  WriteResult WritePackets(const QuicSocketUtils::PacketToWrite* packets,
+                           size_t num_packets,
+                           size_t* packets_written);
+
  private:
   int fd_;
 };
@@ -0,0 +1,112 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_multithreaded_server.h"
+
+#include <string>
+
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/simple_thread.h"
+#include "net/quic/crypto/crypto_handshake.h"
+#include "net/quic/crypto/quic_random.h"
+#include "net/tools/epoll_server/epoll_server.h"
+#include "net/tools/quic/quic_epoll_clock.h"
+#include "net/tools/quic/quic_server.h"
+
+namespace net {
+namespace tools {
+
+namespace {
+
+const char kSourceAddressTokenSecret[] = "secret";
+
+}  // namespace
+
+// Runs the event loop of one listening QuicServer until told to quit.
+class QuicMultiThreadedServer::ListenerThread : public base::SimpleThread {
+ public:
+  ListenerThread(const std::string& name, scoped_ptr<QuicServer> server)
+      : SimpleThread(name),
+        quit_(true, false),
+        server_(server.Pass()) {
+  }
+
+  virtual ~ListenerThread() {}
+
+  virtual void Run() OVERRIDE {
+    while (!quit_.IsSignaled()) {
+      server_->WaitForEvents();
+    }
+    server_->Shutdown();
+  }
+
+  // Makes the thread leave its loop after the current WaitForEvents().
+  void Quit() { quit_.Signal(); }
+
+ private:
+  base::WaitableEvent quit_;
+  scoped_ptr<QuicServer> server_;
+
+  DISALLOW_COPY_AND_ASSIGN(ListenerThread);
+};
+
+QuicMultiThreadedServer::QuicMultiThreadedServer(
+    const QuicConfig& config,
+    const QuicVersionVector& supported_versions)
+    : config_(config),
+      supported_versions_(supported_versions),
+      crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
+      port_(0) {
+  EpollServer epoll_server;
+  QuicEpollClock clock(&epoll_server);
+  scoped_ptr<CryptoHandshakeMessage> scfg(
+      crypto_config_.AddDefaultConfig(
+          QuicRandom::GetInstance(), &clock,
+          QuicCryptoServerConfig::ConfigOptions()));
+}
+
+QuicMultiThreadedServer::~QuicMultiThreadedServer() {
+  Shutdown();
+}
+
+bool QuicMultiThreadedServer::Start(const IPEndPoint& address,
+                                    int num_threads) {
+  DCHECK(threads_.empty());
+  DCHECK_LT(0, num_threads);
+  port_ = address.port();
+  // Every listener validates client hellos against the shared config.
+  crypto_config_.set_strike_register_num_shards(num_threads);
+
+  for (int i = 0; i < num_threads; ++i) {
+    scoped_ptr<QuicServer> server(
+        new QuicServer(config_, supported_versions_, &crypto_config_));
+    server->set_reuse_port(true);
+    if (!server->Listen(IPEndPoint(address.address(), port_))) {
+      LOG(ERROR) << "Listener " << i << " failed to listen";
+      Shutdown();
+      return false;
+    }
+    // With an ephemeral port, the remaining listeners join the first one.
+    port_ = server->port();
+
+    threads_.push_back(new ListenerThread(
+        "quic_listener_" + base::IntToString(i), server.Pass()));
+    threads_.back()->Start();
+  }
+  return true;
+}
+
+void QuicMultiThreadedServer::Shutdown() {
+  for (size_t i = 0; i < threads_.size(); ++i)
+    threads_[i]->Quit();
+  for (size_t i = 0; i < threads_.size(); ++i)
+    threads_[i]->Join();
+  threads_.clear();
+}
+
+}  // namespace tools
+}  // namespace net
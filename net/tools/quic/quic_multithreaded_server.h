@@ -0,0 +1,60 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Runs several QuicServers on one address, each on its own thread with its own
+// EpollServer, QuicDispatcher and QuicTimeWaitListManager.  The sockets are
+// bound with SO_REUSEPORT, so the kernel shards incoming flows across the
+// threads by their 4-tuple.  All of the servers share one
+// QuicCryptoServerConfig.
+
+#ifndef NET_TOOLS_QUIC_QUIC_MULTITHREADED_SERVER_H_
+#define NET_TOOLS_QUIC_QUIC_MULTITHREADED_SERVER_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
+#include "net/base/ip_endpoint.h"
+#include "net/quic/crypto/quic_crypto_server_config.h"
+#include "net/quic/quic_config.h"
+#include "net/quic/quic_protocol.h"
+
+namespace net {
+namespace tools {
+
+class QuicMultiThreadedServer {
+ public:
+  QuicMultiThreadedServer(const QuicConfig& config,
+                          const QuicVersionVector& supported_versions);
+  ~QuicMultiThreadedServer();
+
+  // Binds |num_threads| servers to |address| and starts their threads.  If the
+  // port of |address| is 0, the first server picks a port and the others join
+  // it.  Returns false if any server fails to listen, in which case none are
+  // left running.
+  bool Start(const IPEndPoint& address, int num_threads);
+
+  // Stops all threads and shuts their servers down.
+  void Shutdown();
+
+  // The port the servers are listening on, valid after Start().
+  int port() const { return port_; }
+
+ private:
+  class ListenerThread;
+
+  QuicConfig config_;
+  QuicVersionVector supported_versions_;
+
+  // Shared by the dispatchers of all listener threads.
+  QuicCryptoServerConfig crypto_config_;
+
+  ScopedVector<ListenerThread> threads_;
+  int port_;
+
+  DISALLOW_COPY_AND_ASSIGN(QuicMultiThreadedServer);
+};
+
+}  // namespace tools
+}  // namespace net
+
+#endif  // NET_TOOLS_QUIC_QUIC_MULTITHREADED_SERVER_H_
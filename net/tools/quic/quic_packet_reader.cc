@@ -0,0 +1,106 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_packet_reader.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include "base/logging.h"
+#include "net/tools/quic/quic_server.h"
+#include "net/tools/quic/quic_socket_utils.h"
+
+namespace net {
+namespace tools {
+
+QuicPacketReader::QuicPacketReader() {
+  InitializeHeaders();
+}
+
+QuicPacketReader::~QuicPacketReader() {
+}
+
+void QuicPacketReader::InitializeHeaders() {
+  for (int i = 0; i < kNumPacketsPerMmsgCall; ++i) {
+    iovs_[i].iov_base = buffers_[i];
+    iovs_[i].iov_len = sizeof(buffers_[i]);
+    memset(cbufs_[i], 0, sizeof(cbufs_[i]));
+    packet_lengths_[i] = 0;
+#if MMSG_MORE
+    msghdr* hdr = &mmsg_headers_[i].msg_hdr;
+    hdr->msg_name = &raw_addresses_[i];
+    hdr->msg_namelen = sizeof(sockaddr_storage);
+    hdr->msg_iov = &iovs_[i];
+    hdr->msg_iovlen = 1;
+    hdr->msg_flags = 0;
+
+    cmsghdr* cmsg = reinterpret_cast<cmsghdr*>(cbufs_[i]);
+    cmsg->cmsg_len = sizeof(cbufs_[i]);
+    hdr->msg_control = cmsg;
+    hdr->msg_controllen = sizeof(cbufs_[i]);
+    mmsg_headers_[i].msg_len = 0;
+#endif
+  }
+}
+
+int QuicPacketReader::ReadPackets(int fd, int* packets_dropped) {
+#if MMSG_MORE
+  InitializeHeaders();
+  int packets_read =
+      recvmmsg(fd, mmsg_headers_, kNumPacketsPerMmsgCall, 0, NULL);
+  if (packets_read <= 0) {
+    if (packets_read < 0 && errno != EAGAIN)
+      LOG(ERROR) << "Error reading " << strerror(errno);
+    return -1;
+  }
+
+  for (int i = 0; i < packets_read; ++i) {
+    msghdr* hdr = &mmsg_headers_[i].msg_hdr;
+    packet_lengths_[i] = mmsg_headers_[i].msg_len;
+    if (packets_dropped != NULL)
+      QuicSocketUtils::GetOverflowFromMsghdr(hdr, packets_dropped);
+    self_addresses_[i] = QuicSocketUtils::GetAddressFromMsghdr(hdr);
+
+    const sockaddr* raw_address =
+        reinterpret_cast<const sockaddr*>(&raw_addresses_[i]);
+    if (raw_addresses_[i].ss_family == AF_INET) {
+      CHECK(peer_addresses_[i].FromSockAddr(raw_address,
+                                            sizeof(sockaddr_in)));
+    } else if (raw_addresses_[i].ss_family == AF_INET6) {
+      CHECK(peer_addresses_[i].FromSockAddr(raw_address,
+                                            sizeof(sockaddr_in6)));
+    }
+  }
+  return packets_read;
+#else
+  int bytes_read = QuicSocketUtils::ReadPacket(
+      fd, buffers_[0], sizeof(buffers_[0]), packets_dropped,
+      &self_addresses_[0], &peer_addresses_[0]);
+  if (bytes_read < 0)
+    return -1;
+  packet_lengths_[0] = bytes_read;
+  return 1;
+#endif
+}
+
+bool QuicPacketReader::ReadAndDispatchPackets(int fd,
+                                              int port,
+                                              QuicDispatcher* dispatcher,
+                                              int* packets_dropped) {
+  int packets_read = ReadPackets(fd, packets_dropped);
+  if (packets_read <= 0)
+    return false;
+
+  for (int i = 0; i < packets_read; ++i) {
+    QuicEncryptedPacket packet(buffers_[i], packet_lengths_[i]);
+    IPEndPoint server_address(self_addresses_[i], port);
+    QuicServer::MaybeDispatchPacket(dispatcher, packet, server_address,
+                                    peer_addresses_[i]);
+  }
+  return true;
+}
+
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,85 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Reads a batch of packets from a socket with a single recvmmsg() call.
+
+#ifndef NET_TOOLS_QUIC_QUIC_PACKET_READER_H_
+#define NET_TOOLS_QUIC_QUIC_PACKET_READER_H_
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "base/basictypes.h"
+#include "net/base/ip_endpoint.h"
+#include "net/quic/quic_protocol.h"
+
+// recvmmsg() and sendmmsg() are only available on Linux.
+#if defined(__linux__)
+#define MMSG_MORE 1
+#else
+#define MMSG_MORE 0
+#endif
+
+namespace net {
+namespace tools {
+
+class QuicDispatcher;
+
+// Number of packets read, or written, with one *mmsg() system call.
+const int kNumPacketsPerMmsgCall = 16;
+
+class QuicPacketReader {
+ public:
+  QuicPacketReader();
+  ~QuicPacketReader();
+
+  // Reads up to kNumPacketsPerMmsgCall packets from |fd| and hands each one to
+  // |dispatcher|.  Returns true if at least one packet was read, false if the
+  // socket had nothing to read or an error occurred.  |packets_dropped| has
+  // the same meaning as for QuicServer::ReadAndDispatchSinglePacket.
+  bool ReadAndDispatchPackets(int fd, int port, QuicDispatcher* dispatcher,
+                              int* packets_dropped);
+
+  // Reads up to kNumPacketsPerMmsgCall packets from |fd| into the internal
+  // buffers.  Returns the number of packets read, or -1 if none could be.
+  // The packets are valid until the next call.
+  int ReadPackets(int fd, int* packets_dropped);
+
+  // Accessors for the packets of the last successful ReadPackets() call.
+  const char* GetPacketData(int i) const { return buffers_[i]; }
+  int GetPacketLength(int i) const { return packet_lengths_[i]; }
+  const IPAddressNumber& GetSelfAddress(int i) const {
+    return self_addresses_[i];
+  }
+  const IPEndPoint& GetPeerAddress(int i) const { return peer_addresses_[i]; }
+
+ private:
+  // Resets the msghdrs for the next recvmmsg() call; the kernel overwrites the
+  // lengths in them on every read.
+  void InitializeHeaders();
+
+  static const int kSpaceForOverflowAndIp =
+      CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(in6_pktinfo));
+
+  // Allocate some extra space so we can send an error if the client goes over
+  // the limit.
+  char buffers_[kNumPacketsPerMmsgCall][2 * kMaxPacketSize];
+  char cbufs_[kNumPacketsPerMmsgCall][kSpaceForOverflowAndIp];
+  iovec iovs_[kNumPacketsPerMmsgCall];
+  sockaddr_storage raw_addresses_[kNumPacketsPerMmsgCall];
+#if MMSG_MORE
+  mmsghdr mmsg_headers_[kNumPacketsPerMmsgCall];
+#endif
+
+  int packet_lengths_[kNumPacketsPerMmsgCall];
+  IPAddressNumber self_addresses_[kNumPacketsPerMmsgCall];
+  IPEndPoint peer_addresses_[kNumPacketsPerMmsgCall];
+
+  DISALLOW_COPY_AND_ASSIGN(QuicPacketReader);
+};
+
+}  // namespace tools
+}  // namespace net
+
+#endif  // NET_TOOLS_QUIC_QUIC_PACKET_READER_H_
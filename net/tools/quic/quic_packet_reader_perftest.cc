@@ -0,0 +1,119 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "base/test/perf_time_logger.h"
+#include "net/base/net_util.h"
+#include "net/tools/quic/quic_packet_reader.h"
+#include "net/tools/quic/quic_socket_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace tools {
+namespace test {
+namespace {
+
+const int kNumBatches = 2000;
+
+// Creates a non-blocking UDP socket bound to an ephemeral loopback port, and
+// returns it along with its address.
+int CreateLoopbackSocket(IPEndPoint* address) {
+  int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+  if (fd < 0)
+    return -1;
+  QuicSocketUtils::SetGetAddressInfo(fd, AF_INET);
+
+  IPAddressNumber loopback;
+  CHECK(ParseIPLiteralToNumber("127.0.0.1", &loopback));
+  SockaddrStorage storage;
+  CHECK(IPEndPoint(loopback, 0).ToSockAddr(storage.addr, &storage.addr_len));
+  if (bind(fd, storage.addr, storage.addr_len) != 0 ||
+      getsockname(fd, storage.addr, &storage.addr_len) != 0 ||
+      !address->FromSockAddr(storage.addr, storage.addr_len)) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+class QuicPacketReaderPerfTest : public ::testing::Test {
+ protected:
+  QuicPacketReaderPerfTest()
+      : payloads_(kNumPacketsPerMmsgCall, std::string(kMaxPacketSize, 'q')) {
+  }
+
+  virtual void SetUp() OVERRIDE {
+    client_fd_ = CreateLoopbackSocket(&client_address_);
+    server_fd_ = CreateLoopbackSocket(&server_address_);
+    ASSERT_LE(0, client_fd_);
+    ASSERT_LE(0, server_fd_);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    close(client_fd_);
+    close(server_fd_);
+  }
+
+  // Sends one batch of |payloads_| from the client to the server.
+  void SendBatch() {
+    std::vector<QuicSocketUtils::PacketToWrite> packets(payloads_.size());
+    for (size_t i = 0; i < payloads_.size(); ++i) {
+      packets[i].buffer = payloads_[i].data();
+      packets[i].buf_len = payloads_[i].size();
+      packets[i].peer_address = server_address_;
+    }
+    size_t packets_written = 0;
+    QuicSocketUtils::WritePackets(
+        client_fd_, &packets[0], packets.size(), &packets_written);
+  }
+
+  std::vector<std::string> payloads_;
+  int client_fd_;
+  int server_fd_;
+  IPEndPoint client_address_;
+  IPEndPoint server_address_;
+};
+
+TEST_F(QuicPacketReaderPerfTest, ReadPacketsOneByOne) {
+  char buffer[2 * kMaxPacketSize];
+  int packets_read = 0;
+  base::PerfTimeLogger timer("QuicPacketReader_recvmsg");
+  for (int i = 0; i < kNumBatches; ++i) {
+    SendBatch();
+    IPAddressNumber self_address;
+    IPEndPoint peer_address;
+    while (QuicSocketUtils::ReadPacket(server_fd_, buffer, sizeof(buffer),
+                                       NULL, &self_address,
+                                       &peer_address) >= 0) {
+      ++packets_read;
+    }
+  }
+  timer.Done();
+  EXPECT_LT(0, packets_read);
+}
+
+TEST_F(QuicPacketReaderPerfTest, ReadPacketsBatched) {
+  QuicPacketReader reader;
+  int packets_read = 0;
+  base::PerfTimeLogger timer("QuicPacketReader_recvmmsg");
+  for (int i = 0; i < kNumBatches; ++i) {
+    SendBatch();
+    int rv;
+    while ((rv = reader.ReadPackets(server_fd_, NULL)) > 0)
+      packets_read += rv;
+  }
+  timer.Done();
+  EXPECT_LT(0, packets_read);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,117 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_packet_reader.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "net/base/net_util.h"
+#include "net/tools/quic/quic_socket_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace tools {
+namespace test {
+namespace {
+
+// Creates a non-blocking UDP socket bound to an ephemeral loopback port, and
+// returns it along with its address.
+int CreateLoopbackSocket(IPEndPoint* address) {
+  int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+  if (fd < 0)
+    return -1;
+  QuicSocketUtils::SetGetAddressInfo(fd, AF_INET);
+
+  IPAddressNumber loopback;
+  CHECK(ParseIPLiteralToNumber("127.0.0.1", &loopback));
+  sockaddr_storage raw_address;
+  socklen_t raw_address_len = sizeof(raw_address);
+  CHECK(IPEndPoint(loopback, 0).ToSockAddr(
+      reinterpret_cast<sockaddr*>(&raw_address), &raw_address_len));
+  if (bind(fd, reinterpret_cast<sockaddr*>(&raw_address),
+           raw_address_len) != 0) {
+    close(fd);
+    return -1;
+  }
+
+  SockaddrStorage storage;
+  if (getsockname(fd, storage.addr, &storage.addr_len) != 0 ||
+      !address->FromSockAddr(storage.addr, storage.addr_len)) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+class QuicPacketReaderTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    client_fd_ = CreateLoopbackSocket(&client_address_);
+    server_fd_ = CreateLoopbackSocket(&server_address_);
+    ASSERT_LE(0, client_fd_);
+    ASSERT_LE(0, server_fd_);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    close(client_fd_);
+    close(server_fd_);
+  }
+
+  // Sends |payloads| from the client to the server in one batch.
+  void SendBatch(const std::vector<std::string>& payloads) {
+    std::vector<QuicSocketUtils::PacketToWrite> packets(payloads.size());
+    for (size_t i = 0; i < payloads.size(); ++i) {
+      packets[i].buffer = payloads[i].data();
+      packets[i].buf_len = payloads[i].size();
+      packets[i].peer_address = server_address_;
+    }
+    size_t packets_written = 0;
+    WriteResult result = QuicSocketUtils::WritePackets(
+        client_fd_, &packets[0], packets.size(), &packets_written);
+    EXPECT_EQ(WRITE_STATUS_OK, result.status);
+    EXPECT_EQ(packets.size(), packets_written);
+  }
+
+  int client_fd_;
+  int server_fd_;
+  IPEndPoint client_address_;
+  IPEndPoint server_address_;
+};
+
+TEST_F(QuicPacketReaderTest, ReadsBatch) {
+  std::vector<std::string> payloads;
+  for (int i = 0; i < kNumPacketsPerMmsgCall; ++i)
+    payloads.push_back("packet " + base::IntToString(i));
+  SendBatch(payloads);
+
+  QuicPacketReader reader;
+  int packets_read = 0;
+  while (packets_read < kNumPacketsPerMmsgCall) {
+    int rv = reader.ReadPackets(server_fd_, NULL);
+    ASSERT_LT(0, rv);
+    for (int i = 0; i < rv; ++i) {
+      EXPECT_EQ(payloads[packets_read + i],
+                std::string(reader.GetPacketData(i),
+                            reader.GetPacketLength(i)));
+      EXPECT_EQ(client_address_.ToString(),
+                reader.GetPeerAddress(i).ToString());
+      EXPECT_EQ(server_address_.address(), reader.GetSelfAddress(i));
+    }
+    packets_read += rv;
+  }
+
+  // Nothing left to read.
+  EXPECT_EQ(-1, reader.ReadPackets(server_fd_, NULL));
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -19,14 +19,17 @@
 #include "net/quic/quic_data_reader.h"
 #include "net/quic/quic_protocol.h"
 #include "net/tools/quic/quic_in_memory_cache.h"
+#include "net/tools/quic/quic_packet_reader.h"
 #include "net/tools/quic/quic_socket_utils.h"
 
-#define MMSG_MORE 0
-
 #ifndef SO_RXQ_OVFL
 #define SO_RXQ_OVFL 40
 #endif
 
+#ifndef SO_REUSEPORT
+#define SO_REUSEPORT 15
+#endif
+
 const int kEpollFlags = EPOLLIN | EPOLLOUT | EPOLLET;
 static const char kSourceAddressTokenSecret[] = "secret";
 
@@ -40,7 +43,10 @@ QuicServer::QuicServer()
       overflow_supported_(false),
       use_recvmmsg_(false),
       crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
-      supported_versions_(QuicSupportedVersions()) {
+      supported_versions_(QuicSupportedVersions()),
+      shared_crypto_config_(NULL),
+      reuse_port_(false),
+      packet_reader_(new QuicPacketReader()) {
   // Use hardcoded crypto parameters for now.
   config_.SetDefaults();
   config_.set_initial_round_trip_time_us(kMaxInitialRoundTripTimeUs, 0);
@@ -56,7 +62,28 @@ QuicServer::QuicServer(const QuicConfig& config,
       use_recvmmsg_(false),
       config_(config),
       crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
-      supported_versions_(supported_versions) {
+      supported_versions_(supported_versions),
+      shared_crypto_config_(NULL),
+      reuse_port_(false),
+      packet_reader_(new QuicPacketReader()) {
+  Initialize();
+}
+
+QuicServer::QuicServer(const QuicConfig& config,
+                       const QuicVersionVector& supported_versions,
+                       const QuicCryptoServerConfig* shared_crypto_config)
+    : port_(0),
+      fd_(-1),
+      packets_dropped_(0),
+      overflow_supported_(false),
+      use_recvmmsg_(false),
+      config_(config),
+      crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
+      supported_versions_(supported_versions),
+      shared_crypto_config_(shared_crypto_config),
+      reuse_port_(false),
+      packet_reader_(new QuicPacketReader()) {
+  DCHECK(shared_crypto_config_);
   Initialize();
 }
 
@@ -68,6 +95,11 @@ void QuicServer::Initialize() {
   // Initialize the in memory cache now.
   QuicInMemoryCache::GetInstance();
 
+  // A shared config already holds the server config; |crypto_config_| is left
+  // unused.
+  if (shared_crypto_config_)
+    return;
+
   QuicEpollClock clock(&epoll_server_);
 
   scoped_ptr<CryptoHandshakeMessage> scfg(
@@ -119,6 +151,16 @@ bool QuicServer::Listen(const IPEndPoint& address) {
     return false;
   }
 
+  if (reuse_port_) {
+    int reuse_port = 1;
+    rc = setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT,
+                    &reuse_port, sizeof(reuse_port));
+    if (rc != 0) {
+      LOG(ERROR) << "SO_REUSEPORT not supported: " << strerror(errno);
+      return false;
+    }
+  }
+
   sockaddr_storage raw_addr;
   socklen_t raw_addr_len = sizeof(raw_addr);
   CHECK(address.ToSockAddr(reinterpret_cast<sockaddr*>(&raw_addr),
@@ -145,7 +187,10 @@ bool QuicServer::Listen(const IPEndPoint& address) {
   }
 
   epoll_server_.RegisterFD(fd_, this, kEpollFlags);
-  dispatcher_.reset(new QuicDispatcher(config_, crypto_config_,
+  dispatcher_.reset(new QuicDispatcher(config_,
+                                       shared_crypto_config_ ?
+                                           *shared_crypto_config_ :
+                                           crypto_config_,
                                        supported_versions_,
                                        fd_, &epoll_server_));
 
@@ -170,12 +215,17 @@ void QuicServer::OnEvent(int fd, EpollEvent* event) {
   event->out_ready_mask = 0;
 
   if (event->in_events & EPOLLIN) {
-    LOG(ERROR) << "EPOLLIN";
     bool read = true;
     while (read) {
+      if (use_recvmmsg_) {
+        read = packet_reader_->ReadAndDispatchPackets(
+            fd_, port_, dispatcher_.get(),
+            overflow_supported_ ? &packets_dropped_ : NULL);
+      } else {
         read = ReadAndDispatchSinglePacket(
             fd_, port_, dispatcher_.get(),
             overflow_supported_ ? &packets_dropped_ : NULL);
+      }
     }
   }
   if (event->in_events & EPOLLOUT) {
@@ -25,15 +25,27 @@ class QuicServerPeer;
 }  // namespace test
 
 class QuicDispatcher;
+class QuicPacketReader;
 
 class QuicServer : public EpollCallbackInterface {
  public:
   QuicServer();
   QuicServer(const QuicConfig& config,
              const QuicVersionVector& supported_versions);
+  // Uses |shared_crypto_config|, which must outlive the server, instead of a
+  // config of its own.  QuicCryptoServerConfig locks its mutable state, so one
+  // config can back servers on several threads.
+  QuicServer(const QuicConfig& config,
+             const QuicVersionVector& supported_versions,
+             const QuicCryptoServerConfig* shared_crypto_config);
 
   virtual ~QuicServer();
 
+  // If set before Listen(), the socket is bound with SO_REUSEPORT so that
+  // several servers can share the address, with the kernel spreading
+  // incoming flows across them.
+  void set_reuse_port(bool reuse_port) { reuse_port_ = reuse_port; }
+
   // Start listening on the specified address.
   bool Listen(const IPEndPoint& address);
 
@@ -121,6 +133,15 @@ class QuicServer : public EpollCallbackInterface {
   // skipped as necessary).
   QuicVersionVector supported_versions_;
 
+  // If non-NULL, used by the dispatcher instead of |crypto_config_|.
+  const QuicCryptoServerConfig* shared_crypto_config_;
+
+  // If true, Listen() sets SO_REUSEPORT on the socket.
+  bool reuse_port_;
+
+  // Reads packets in batches when |use_recvmmsg_| is true.
+  scoped_ptr<QuicPacketReader> packet_reader_;
+
   DISALLOW_COPY_AND_ASSIGN(QuicServer);
 };
 
@@ -11,14 +11,21 @@
 #include "base/basictypes.h"
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
 #include "net/base/ip_endpoint.h"
 #include "net/tools/quic/quic_in_memory_cache.h"
+#include "net/tools/quic/quic_multithreaded_server.h"
 #include "net/tools/quic/quic_server.h"
 
 // The port the quic server will listen on.
 
 int32 FLAGS_port = 6121;
 
+// The number of listener threads; more than one shards the port between them
+// with SO_REUSEPORT.
+int32 FLAGS_num_threads = 1;
+
 int main(int argc, char *argv[]) {
   CommandLine::Init(argc, argv);
   CommandLine* line = CommandLine::ForCurrentProcess();
@@ -29,6 +36,8 @@ int main(int argc, char *argv[]) {
         "Options:\n"
         "-h, --help                  show this help message and exit\n"
         "--port=<port>               specify the port to listen on\n"
+        "--num_threads=<n>           number of listener threads sharing\n"
+        "                            the port\n"
         "--quic_in_memory_cache_dir  directory containing response data\n"
         "                            to load\n";
     std::cout << help_str;
@@ -47,11 +56,34 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  if (line->HasSwitch("num_threads")) {
+    int num_threads;
+    if (base::StringToInt(line->GetSwitchValueASCII("num_threads"),
+                          &num_threads) && num_threads > 0) {
+      FLAGS_num_threads = num_threads;
+    }
+  }
+
   base::AtExitManager exit_manager;
 
   net::IPAddressNumber ip;
   CHECK(net::ParseIPLiteralToNumber("::", &ip));
 
+  if (FLAGS_num_threads > 1) {
+    net::QuicConfig config;
+    config.SetDefaults();
+    config.set_initial_round_trip_time_us(net::kMaxInitialRoundTripTimeUs, 0);
+    net::tools::QuicMultiThreadedServer server(config,
+                                               net::QuicSupportedVersions());
+    if (!server.Start(net::IPEndPoint(ip, FLAGS_port), FLAGS_num_threads)) {
+      return 1;
+    }
+    // The listener threads run until the process is killed.
+    while (1) {
+      base::PlatformThread::Sleep(base::TimeDelta::FromSeconds(1));
+    }
+  }
+
   net::tools::QuicServer server;
 
   if (!server.Listen(net::IPEndPoint(ip, FLAGS_port))) {
@@ -5,7 +5,9 @@
 #include "net/tools/quic/quic_server.h"
 
 #include "net/quic/crypto/quic_random.h"
+#include "net/base/net_util.h"
 #include "net/quic/quic_utils.h"
+#include "net/tools/quic/quic_multithreaded_server.h"
 #include "net/tools/quic/test_tools/mock_quic_dispatcher.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -68,6 +70,23 @@ TEST_F(QuicServerDispatchPacketTest, DispatchValidPacket) {
   MaybeDispatchPacket(encrypted_valid_packet);
 }
 
+TEST(QuicMultiThreadedServerTest, ListenersShareThePort) {
+  QuicConfig config;
+  config.SetDefaults();
+  QuicMultiThreadedServer server(config, QuicSupportedVersions());
+
+  IPAddressNumber loopback;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &loopback));
+  ASSERT_TRUE(server.Start(IPEndPoint(loopback, 0), 4));
+  EXPECT_NE(0, server.port());
+
+  // Without SO_REUSEPORT, a plain server cannot bind the same port.
+  QuicServer other_server(config, QuicSupportedVersions());
+  EXPECT_FALSE(other_server.Listen(IPEndPoint(loopback, server.port())));
+
+  server.Shutdown();
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace tools
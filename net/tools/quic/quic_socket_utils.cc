@@ -9,6 +9,8 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/uio.h>
+
+#include <algorithm>
 #include <string>
 
 #include "base/logging.h"
@@ -135,39 +137,45 @@ int QuicSocketUtils::ReadPacket(int fd, char* buffer, size_t buf_len,
   return bytes_read;
 }
 
-// static
-WriteResult QuicSocketUtils::WritePacket(int fd,
-                                         const char* buffer,
-                                         size_t buf_len,
-                                         const IPAddressNumber& self_address,
-                                         const IPEndPoint& peer_address) {
-  sockaddr_storage raw_address;
-  socklen_t address_len = sizeof(raw_address);
+namespace {
+
+const int kSpaceForIpv4 = CMSG_SPACE(sizeof(in_pktinfo));
+const int kSpaceForIpv6 = CMSG_SPACE(sizeof(in6_pktinfo));
+// kSpaceForIp should be big enough to hold both IPv4 and IPv6 packet info.
+const int kSpaceForIp =
+    (kSpaceForIpv4 < kSpaceForIpv6) ? kSpaceForIpv6 : kSpaceForIpv4;
+
+// Fills in |hdr| to send |buf_len| bytes of |buffer| from |self_address| to
+// |peer_address|.  |iov|, |raw_address| and |cbuf|, which must hold
+// kSpaceForIp bytes, provide the storage |hdr| points to.
+void InitializeSendMsghdr(const char* buffer,
+                          size_t buf_len,
+                          const IPAddressNumber& self_address,
+                          const IPEndPoint& peer_address,
+                          iovec* iov,
+                          sockaddr_storage* raw_address,
+                          char* cbuf,
+                          msghdr* hdr) {
+  socklen_t address_len = sizeof(*raw_address);
   CHECK(peer_address.ToSockAddr(
-      reinterpret_cast<struct sockaddr*>(&raw_address),
+      reinterpret_cast<struct sockaddr*>(raw_address),
       &address_len));
-  iovec iov = {const_cast<char*>(buffer), buf_len};
+  iov->iov_base = const_cast<char*>(buffer);
+  iov->iov_len = buf_len;
 
-  msghdr hdr;
-  hdr.msg_name = &raw_address;
-  hdr.msg_namelen = address_len;
-  hdr.msg_iov = &iov;
-  hdr.msg_iovlen = 1;
-  hdr.msg_flags = 0;
+  hdr->msg_name = raw_address;
+  hdr->msg_namelen = address_len;
+  hdr->msg_iov = iov;
+  hdr->msg_iovlen = 1;
+  hdr->msg_flags = 0;
 
-  const int kSpaceForIpv4 = CMSG_SPACE(sizeof(in_pktinfo));
-  const int kSpaceForIpv6 = CMSG_SPACE(sizeof(in6_pktinfo));
-  // kSpaceForIp should be big enough to hold both IPv4 and IPv6 packet info.
-  const int kSpaceForIp =
-      (kSpaceForIpv4 < kSpaceForIpv6) ? kSpaceForIpv6 : kSpaceForIpv4;
-  char cbuf[kSpaceForIp];
   if (self_address.empty()) {
-    hdr.msg_control = 0;
-    hdr.msg_controllen = 0;
+    hdr->msg_control = 0;
+    hdr->msg_controllen = 0;
   } else if (GetAddressFamily(self_address) == ADDRESS_FAMILY_IPV4) {
-    hdr.msg_control = cbuf;
-    hdr.msg_controllen = kSpaceForIp;
-    cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    hdr->msg_control = cbuf;
+    hdr->msg_controllen = kSpaceForIp;
+    cmsghdr* cmsg = CMSG_FIRSTHDR(hdr);
 
     cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
     cmsg->cmsg_level = IPPROTO_IP;
@@ -176,11 +184,11 @@ WriteResult QuicSocketUtils::WritePacket(int fd,
     memset(pktinfo, 0, sizeof(in_pktinfo));
     pktinfo->ipi_ifindex = 0;
     memcpy(&pktinfo->ipi_spec_dst, &self_address[0], self_address.size());
-    hdr.msg_controllen = cmsg->cmsg_len;
+    hdr->msg_controllen = cmsg->cmsg_len;
   } else {
-    hdr.msg_control = cbuf;
-    hdr.msg_controllen = kSpaceForIp;
-    cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    hdr->msg_control = cbuf;
+    hdr->msg_controllen = kSpaceForIp;
+    cmsghdr* cmsg = CMSG_FIRSTHDR(hdr);
 
     cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
     cmsg->cmsg_level = IPPROTO_IPV6;
@@ -188,15 +196,84 @@ WriteResult QuicSocketUtils::WritePacket(int fd,
     in6_pktinfo* pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
     memset(pktinfo, 0, sizeof(in6_pktinfo));
     memcpy(&pktinfo->ipi6_addr, &self_address[0], self_address.size());
-    hdr.msg_controllen = cmsg->cmsg_len;
+    hdr->msg_controllen = cmsg->cmsg_len;
   }
+}
+
+WriteResult WriteResultFromErrno() {
+  return WriteResult((errno == EAGAIN || errno == EWOULDBLOCK) ?
+      WRITE_STATUS_BLOCKED : WRITE_STATUS_ERROR, errno);
+}
+
+}  // namespace
+
+// static
+WriteResult QuicSocketUtils::WritePacket(int fd,
+                                         const char* buffer,
+                                         size_t buf_len,
+                                         const IPAddressNumber& self_address,
+                                         const IPEndPoint& peer_address) {
+  iovec iov;
+  sockaddr_storage raw_address;
+  char cbuf[kSpaceForIp];
+  msghdr hdr;
+  InitializeSendMsghdr(buffer, buf_len, self_address, peer_address,
+                       &iov, &raw_address, cbuf, &hdr);
 
   int rc = sendmsg(fd, &hdr, 0);
   if (rc >= 0) {
     return WriteResult(WRITE_STATUS_OK, rc);
   }
-  return WriteResult((errno == EAGAIN || errno == EWOULDBLOCK) ?
-      WRITE_STATUS_BLOCKED : WRITE_STATUS_ERROR, errno);
+  return WriteResultFromErrno();
+}
+
+// static
+WriteResult QuicSocketUtils::WritePackets(int fd,
+                                          const PacketToWrite* packets,
+                                          size_t num_packets,
+                                          size_t* packets_written) {
+  *packets_written = 0;
+  int bytes_written = 0;
+#if defined(__linux__)
+  const size_t kMaxPacketsPerCall = 16;
+  iovec iovs[kMaxPacketsPerCall];
+  sockaddr_storage raw_addresses[kMaxPacketsPerCall];
+  char cbufs[kMaxPacketsPerCall][kSpaceForIp];
+  mmsghdr hdrs[kMaxPacketsPerCall];
+
+  while (*packets_written < num_packets) {
+    const PacketToWrite* batch = packets + *packets_written;
+    const size_t batch_size =
+        std::min(kMaxPacketsPerCall, num_packets - *packets_written);
+    for (size_t i = 0; i < batch_size; ++i) {
+      InitializeSendMsghdr(batch[i].buffer, batch[i].buf_len,
+                           batch[i].self_address, batch[i].peer_address,
+                           &iovs[i], &raw_addresses[i], cbufs[i],
+                           &hdrs[i].msg_hdr);
+      hdrs[i].msg_len = 0;
+    }
+
+    // A short count means the next packet in the batch failed; sending again
+    // from there either makes progress or reports the error.
+    int rc = sendmmsg(fd, hdrs, batch_size, 0);
+    if (rc < 0)
+      return WriteResultFromErrno();
+    for (int i = 0; i < rc; ++i)
+      bytes_written += hdrs[i].msg_len;
+    *packets_written += rc;
+  }
+#else
+  for (; *packets_written < num_packets; ++*packets_written) {
+    const PacketToWrite& packet = packets[*packets_written];
+    WriteResult result = WritePacket(fd, packet.buffer, packet.buf_len,
+                                     packet.self_address,
+                                     packet.peer_address);
+    if (result.status != WRITE_STATUS_OK)
+      return result;
+    bytes_written += result.bytes_written;
+  }
+#endif
+  return WriteResult(WRITE_STATUS_OK, bytes_written);
 }
 
 }  // namespace tools
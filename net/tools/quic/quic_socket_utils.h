@@ -19,6 +19,14 @@ namespace tools {
 
 class QuicSocketUtils {
  public:
+  // A packet to be sent with WritePackets.  |buffer| is not owned.
+  struct PacketToWrite {
+    const char* buffer;
+    size_t buf_len;
+    IPAddressNumber self_address;
+    IPEndPoint peer_address;
+  };
+
   // If the msghdr contains IP_PKTINFO or IPV6_PKTINFO, this will return the
   // IPAddressNumber in that header.  Returns an uninitialized IPAddress on
   // failure.
@@ -53,6 +61,16 @@ class QuicSocketUtils {
   static WriteResult WritePacket(int fd, const char* buffer, size_t buf_len,
                                  const IPAddressNumber& self_address,
                                  const IPEndPoint& peer_address);
+
+  // Writes |num_packets| packets to the socket, using sendmmsg() on Linux to
+  // send up to 16 of them per system call.  |packets_written| is set to the
+  // number of packets sent.  If all of them were sent, returns
+  // WRITE_STATUS_OK with the total bytes written; otherwise returns the result
+  // for the first packet that could not be sent, as WritePacket would.
+  static WriteResult WritePackets(int fd,
+                                  const PacketToWrite* packets,
+                                  size_t num_packets,
+                                  size_t* packets_written);
 };
 
 }  // namespace tools
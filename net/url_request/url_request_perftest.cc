@@ -0,0 +1,123 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_log.h"
+#include "base/test/perf_time_logger.h"
+#include "base/time/time.h"
+#include "net/base/net_errors.h"
+#include "net/socket/socket_test_util.h"
+#include "net/url_request/url_request_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+// One resource of a replayed page load, and the size of its response body.
+struct ReplayedResource {
+  const char* path;
+  int body_size;
+};
+
+// A typical page: a document and its subresources, all from one host.
+const ReplayedResource kPageLoad[] = {
+  { "/", 30000 },
+  { "/style.css", 12000 },
+  { "/app.js", 90000 },
+  { "/analytics.js", 25000 },
+  { "/logo.png", 8000 },
+  { "/hero.jpg", 120000 },
+  { "/icon1.png", 1500 },
+  { "/icon2.png", 1500 },
+  { "/icon3.png", 1500 },
+  { "/font.woff", 40000 },
+  { "/api/data.json", 4000 },
+  { "/beacon.gif", 43 },
+};
+
+const int kNumPageLoads = 20;
+
+// A canned response and the socket data which serves it. Each response closes
+// its connection, so every request gets a socket of its own.
+struct ReplayedResponse {
+  explicit ReplayedResponse(int body_size)
+      : data(base::StringPrintf("HTTP/1.1 200 OK\r\n"
+                                "Content-Length: %d\r\n"
+                                "Connection: close\r\n\r\n", body_size) +
+             std::string(body_size, 'x')) {
+    reads[0] = MockRead(ASYNC, data.data(), static_cast<int>(data.size()));
+    reads[1] = MockRead(SYNCHRONOUS, OK);
+    provider.reset(new StaticSocketDataProvider(reads, arraysize(reads),
+                                                NULL, 0));
+  }
+
+  std::string data;
+  MockRead reads[2];
+  scoped_ptr<StaticSocketDataProvider> provider;
+};
+
+class URLRequestPerfTest : public testing::Test {
+ protected:
+  URLRequestPerfTest() : context_(true) {
+    context_.set_client_socket_factory(&socket_factory_);
+    context_.Init();
+  }
+
+  // Fetches |resource| through the context, returning false if the request
+  // fails or the body doesn't come back whole.
+  bool Fetch(const ReplayedResource& resource) {
+    ReplayedResponse* response = new ReplayedResponse(resource.body_size);
+    responses_.push_back(response);
+    socket_factory_.AddSocketDataProvider(response->provider.get());
+
+    TestDelegate delegate;
+    TestURLRequest request(GURL(std::string("http://www.example.com") +
+                                resource.path),
+                           DEFAULT_PRIORITY, &delegate, &context_);
+    request.Start();
+    base::RunLoop().Run();
+    return !delegate.request_failed() &&
+        delegate.bytes_received() == resource.body_size;
+  }
+
+  base::MessageLoopForIO message_loop_;
+  MockClientSocketFactory socket_factory_;
+  TestURLRequestContext context_;
+  ScopedVector<ReplayedResponse> responses_;
+};
+
+}  // namespace
+
+// Replays the same page load repeatedly through a full URLRequestContext,
+// with the sockets mocked out, so the cost of the HTTP cache, socket pools
+// and cookie paths per request can be tracked.
+TEST_F(URLRequestPerfTest, ReplayPageLoads) {
+  const int kNumRequests = kNumPageLoads * arraysize(kPageLoad);
+  base::TimeTicks thread_start;
+  if (base::TimeTicks::IsThreadNowSupported())
+    thread_start = base::TimeTicks::ThreadNow();
+
+  base::PerfTimeLogger timer("Replay page loads");
+  for (int i = 0; i < kNumPageLoads; ++i) {
+    for (size_t j = 0; j < arraysize(kPageLoad); ++j)
+      ASSERT_TRUE(Fetch(kPageLoad[j]));
+  }
+  timer.Done();
+
+  if (base::TimeTicks::IsThreadNowSupported()) {
+    base::TimeDelta cpu_time = base::TimeTicks::ThreadNow() - thread_start;
+    base::LogPerfResult("Replay page loads CPU per request",
+                        cpu_time.InMillisecondsF() / kNumRequests, "ms");
+  }
+}
+
+}  // namespace net
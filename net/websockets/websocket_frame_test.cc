@@ -319,7 +319,8 @@ TEST(WebSocketFrameTest, MaskPayloadAlignment) {
       char* const aligned_scratch = scratch.get() + alignment;
       const size_t aligned_len = std::min(kScratchBufferSize - alignment,
                                           kTestInputSize - frame_offset);
-      for (size_t chunk_size = 1; chunk_size < kMaxVectorSize; ++chunk_size) {
+      // Chunks up to the whole input also exercise the unrolled main loop.
+      for (size_t chunk_size = 1; chunk_size <= kTestInputSize; ++chunk_size) {
         memcpy(aligned_scratch, kTestInput + frame_offset, aligned_len);
         for (size_t chunk_start = 0; chunk_start < aligned_len;
              chunk_start += chunk_size) {
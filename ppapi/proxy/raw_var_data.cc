@@ -432,8 +432,7 @@ bool ArrayBufferRawVarData::Init(const PP_Var& var,
   }
   if (!using_shmem) {
     type_ = ARRAY_BUFFER_NO_SHMEM;
-    data_ = std::string(static_cast<const char*>(buffer_var->Map()),
-                        buffer_var->ByteLength());
+    buffer_var_ = ScopedPPVar(var);
   }
   initialized_ = true;
   return true;
@@ -493,9 +492,18 @@ void ArrayBufferRawVarData::Write(
     case ARRAY_BUFFER_SHMEM_PLUGIN:
       handle_writer.Run(m, plugin_shm_handle_);
       break;
-    case ARRAY_BUFFER_NO_SHMEM:
-      m->WriteString(data_);
+    case ARRAY_BUFFER_NO_SHMEM: {
+      ArrayBufferVar* buffer_var =
+          ArrayBufferVar::FromPPVar(buffer_var_.get());
+      if (buffer_var) {
+        // Has the same layout as WriteString(), which Read() expects.
+        m->WriteData(static_cast<const char*>(buffer_var->Map()),
+                     static_cast<int>(buffer_var->ByteLength()));
+      } else {
+        m->WriteString(data_);
+      }
       break;
+    }
   }
 }
 
@@ -15,6 +15,7 @@
 #include "ppapi/proxy/ppapi_param_traits.h"
 #include "ppapi/proxy/ppapi_proxy_export.h"
 #include "ppapi/proxy/serialized_handle.h"
+#include "ppapi/shared_impl/scoped_pp_var.h"
 
 class PickleIterator;
 
@@ -199,7 +200,11 @@ class ArrayBufferRawVarData : public RawVarData {
  private:
   // The type of the storage underlying the array buffer.
   ShmemType type_;
-  // The data in the buffer. Valid for |type_| == ARRAY_BUFFER_NO_SHMEM.
+  // The buffer being sent, for |type_| == ARRAY_BUFFER_NO_SHMEM after Init().
+  // Holding a reference lets Write() copy the contents straight into the
+  // message instead of through |data_|.
+  ScopedPPVar buffer_var_;
+  // The data in the buffer, for |type_| == ARRAY_BUFFER_NO_SHMEM after Read().
   std::string data_;
   // Host shmem handle. Valid for |type_| == ARRAY_BUFFER_SHMEM_HOST.
   int host_shm_handle_id_;
@@ -328,6 +328,7 @@ void URLLoaderResource::OnPluginMsgUpdateProgress(
 }
 
 void URLLoaderResource::SetDefersLoading(bool defers_loading) {
+  is_asynchronous_load_suspended_ = defers_loading;
   Post(RENDERER, PpapiHostMsg_URLLoader_SetDeferLoading(defers_loading));
 }
 
@@ -0,0 +1,154 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "ppapi/c/pp_errors.h"
+#include "ppapi/c/ppb_url_loader.h"
+#include "ppapi/c/ppb_url_request_info.h"
+#include "ppapi/proxy/locking_resource_releaser.h"
+#include "ppapi/proxy/ppapi_messages.h"
+#include "ppapi/proxy/ppapi_proxy_test.h"
+#include "ppapi/proxy/resource_message_params.h"
+#include "ppapi/shared_impl/url_response_info_data.h"
+#include "ppapi/thunk/thunk.h"
+
+namespace ppapi {
+namespace proxy {
+
+namespace {
+
+bool g_callback_called;
+int32_t g_callback_result;
+
+void Callback(void* user_data, int32_t result) {
+  g_callback_called = true;
+  g_callback_result = result;
+}
+
+PP_CompletionCallback MakeCallback() {
+  g_callback_called = false;
+  g_callback_result = PP_OK;
+  return PP_MakeCompletionCallback(Callback, NULL);
+}
+
+const int32_t kUpperThreshold = 100;
+const int32_t kLowerThreshold = 50;
+
+class URLLoaderResourceTest : public PluginProxyTest {
+ public:
+  URLLoaderResourceTest()
+      : loader_iface_(thunk::GetPPB_URLLoader_1_0_Thunk()),
+        request_iface_(thunk::GetPPB_URLRequestInfo_1_0_Thunk()) {
+  }
+
+ protected:
+  // Opens |loader| with the test's prefetch thresholds and delivers the
+  // response, so that data can be streamed into it.
+  void OpenAndReceiveResponse(PP_Resource loader) {
+    LockingResourceReleaser request(request_iface_->Create(pp_instance()));
+    ASSERT_EQ(PP_TRUE, request_iface_->SetProperty(
+        request.get(),
+        PP_URLREQUESTPROPERTY_PREFETCHBUFFERUPPERTHRESHOLD,
+        PP_MakeInt32(kUpperThreshold)));
+    ASSERT_EQ(PP_TRUE, request_iface_->SetProperty(
+        request.get(),
+        PP_URLREQUESTPROPERTY_PREFETCHBUFFERLOWERTHRESHOLD,
+        PP_MakeInt32(kLowerThreshold)));
+
+    ASSERT_EQ(PP_OK_COMPLETIONPENDING,
+              loader_iface_->Open(loader, request.get(), MakeCallback()));
+    SendReply(loader, PpapiPluginMsg_URLLoader_ReceivedResponse(
+        URLResponseInfoData()));
+    ASSERT_TRUE(g_callback_called);
+    ASSERT_EQ(PP_OK, g_callback_result);
+    sink().ClearMessages();
+  }
+
+  // Sends |size| bytes of response body to |loader|.
+  void SendData(PP_Resource loader, size_t size) {
+    PpapiPluginMsg_URLLoader_SendData data_msg;
+    std::string data(size, 'x');
+    data_msg.WriteData(data.data(), static_cast<int>(data.size()));
+    SendReply(loader, data_msg);
+  }
+
+  // Reads up to |size| bytes from |loader|'s buffer and returns the result.
+  // The callback is optional so that reads from the buffer complete
+  // synchronously.
+  int32_t Read(PP_Resource loader, size_t size) {
+    std::vector<char> buffer(size);
+    return loader_iface_->ReadResponseBody(
+        loader, &buffer[0], static_cast<int32_t>(size),
+        PP_MakeOptionalCompletionCallback(Callback, NULL));
+  }
+
+  void SendReply(PP_Resource loader, const IPC::Message& reply) {
+    ResourceMessageReplyParams reply_params(loader, 0);
+    reply_params.set_result(PP_OK);
+    ASSERT_TRUE(plugin_dispatcher()->OnMessageReceived(
+        PpapiPluginMsg_ResourceReply(reply_params, reply)));
+  }
+
+  // Returns the values of the SetDeferLoading calls sent since the sink was
+  // last cleared, in order.
+  std::vector<bool> GetDeferLoadingCalls() {
+    std::vector<bool> calls;
+    for (size_t i = 0; i < sink().message_count(); ++i) {
+      const IPC::Message* msg = sink().GetMessageAt(i);
+      if (msg->type() != PpapiHostMsg_ResourceCall::ID)
+        continue;
+      ResourceMessageCallParams params;
+      IPC::Message nested_msg;
+      PpapiHostMsg_ResourceCall::Read(msg, &params, &nested_msg);
+      if (nested_msg.type() != PpapiHostMsg_URLLoader_SetDeferLoading::ID)
+        continue;
+      PpapiHostMsg_URLLoader_SetDeferLoading::Schema::Param p;
+      EXPECT_TRUE(
+          PpapiHostMsg_URLLoader_SetDeferLoading::Read(&nested_msg, &p));
+      calls.push_back(p.a);
+    }
+    return calls;
+  }
+
+  const PPB_URLLoader_1_0* loader_iface_;
+  const PPB_URLRequestInfo_1_0* request_iface_;
+};
+
+}  // namespace
+
+// Filling the buffer past the upper threshold defers loading once, and
+// draining it to the lower threshold resumes loading once.
+TEST_F(URLLoaderResourceTest, DefersLoadingBetweenThresholds) {
+  LockingResourceReleaser loader(loader_iface_->Create(pp_instance()));
+  OpenAndReceiveResponse(loader.get());
+
+  // Below the upper threshold, loading isn't deferred.
+  SendData(loader.get(), kUpperThreshold - 1);
+  EXPECT_TRUE(GetDeferLoadingCalls().empty());
+
+  // Reaching it defers loading, and more data doesn't defer it again.
+  SendData(loader.get(), 1);
+  SendData(loader.get(), 30);
+  std::vector<bool> calls = GetDeferLoadingCalls();
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_TRUE(calls[0]);
+  sink().ClearMessages();
+
+  // The buffer now holds 130 bytes. Staying above the lower threshold keeps
+  // loading deferred.
+  EXPECT_EQ(70, Read(loader.get(), 70));
+  EXPECT_TRUE(GetDeferLoadingCalls().empty());
+
+  // Reaching the lower threshold resumes loading, once.
+  EXPECT_EQ(10, Read(loader.get(), 10));
+  EXPECT_EQ(20, Read(loader.get(), 20));
+  calls = GetDeferLoadingCalls();
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_FALSE(calls[0]);
+}
+
+}  // namespace proxy
+}  // namespace ppapi
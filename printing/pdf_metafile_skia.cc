@@ -120,8 +120,7 @@ bool PdfMetafileSkia::GetData(void* dst_buffer,
   if (dst_buffer_size < GetDataSize())
     return false;
 
-  SkAutoDataUnref data(data_->pdf_stream_.copyToData());
-  memcpy(dst_buffer, data->bytes(), dst_buffer_size);
+  data_->pdf_stream_.copyTo(dst_buffer);
   return true;
 }
 
@@ -228,21 +227,19 @@ PdfMetafileSkia::PdfMetafileSkia()
 
 PdfMetafileSkia* PdfMetafileSkia::GetMetafileForCurrentPage() {
   SkPDFDocument pdf_doc(SkPDFDocument::kDraftMode_Flags);
-  SkDynamicMemoryWStream pdf_stream;
   if (!pdf_doc.appendPage(data_->current_page_.get()))
     return NULL;
 
-  if (!pdf_doc.emitPDF(&pdf_stream))
+  // Emit straight into the new metafile's stream, which is what
+  // InitFromData() would copy the page into anyway.
+  scoped_ptr<PdfMetafileSkia> metafile(new PdfMetafileSkia);
+  if (!pdf_doc.emitPDF(&metafile->data_->pdf_stream_))
     return NULL;
 
-  SkAutoDataUnref data(pdf_stream.copyToData());
-  if (data->size() == 0)
+  if (metafile->data_->pdf_stream_.getOffset() == 0)
     return NULL;
 
-  PdfMetafileSkia* metafile = new PdfMetafileSkia;
-  metafile->InitFromData(data->bytes(),
-                         base::checked_numeric_cast<uint32>(data->size()));
-  return metafile;
+  return metafile.release();
 }
 
 }  // namespace printing
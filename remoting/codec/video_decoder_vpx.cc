@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "base/logging.h"
+#include "base/sys_info.h"
 #include "media/base/media.h"
 #include "media/base/yuv_convert.h"
 #include "remoting/base/util.h"
@@ -39,18 +40,26 @@ void FillRect(uint8* buffer,
   }
 }
 
+// Returns the number of threads to have libvpx decode with. VP8 decodes token
+// partitions in parallel, of which the encoder emits up to four for large
+// frames, so more than four threads wouldn't be kept busy. A second thread
+// on a single core machine only adds contention.
+int GetDecoderThreadCount() {
+  const int kMaxDecoderThreads = 4;
+  return std::max(1, std::min(base::SysInfo::NumberOfProcessors(),
+                              kMaxDecoderThreads));
+}
+
 } // namespace
 
 // static
 scoped_ptr<VideoDecoderVpx> VideoDecoderVpx::CreateForVP8() {
   ScopedVpxCodec codec(new vpx_codec_ctx_t);
 
-  // TODO(hclam): Scale the number of threads with number of cores of the
-  // machine.
   vpx_codec_dec_cfg config;
   config.w = 0;
   config.h = 0;
-  config.threads = 2;
+  config.threads = GetDecoderThreadCount();
   vpx_codec_err_t ret =
       vpx_codec_dec_init(codec.get(), vpx_codec_vp8_dx(), &config, 0);
   if (ret != VPX_CODEC_OK) {
@@ -65,12 +74,10 @@ scoped_ptr<VideoDecoderVpx> VideoDecoderVpx::CreateForVP8() {
 scoped_ptr<VideoDecoderVpx> VideoDecoderVpx::CreateForVP9() {
   ScopedVpxCodec codec(new vpx_codec_ctx_t);
 
-  // TODO(hclam): Scale the number of threads with number of cores of the
-  // machine.
   vpx_codec_dec_cfg config;
   config.w = 0;
   config.h = 0;
-  config.threads = 2;
+  config.threads = GetDecoderThreadCount();
   vpx_codec_err_t ret =
       vpx_codec_dec_init(codec.get(), vpx_codec_vp9_dx(), &config, 0);
   if (ret != VPX_CODEC_OK) {
@@ -4,6 +4,8 @@
 
 #include "remoting/codec/video_encoder_vpx.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/logging.h"
 #include "base/sys_info.h"
@@ -29,6 +31,41 @@ namespace {
 // map for the encoder.
 const int kMacroBlockSize = 16;
 
+// Returns |rect| expanded outwards to macroblock boundaries.
+webrtc::DesktopRect AlignRectToMacroBlocks(const webrtc::DesktopRect& rect) {
+  int left = rect.left() - rect.left() % kMacroBlockSize;
+  int top = rect.top() - rect.top() % kMacroBlockSize;
+  int right = (rect.right() + kMacroBlockSize - 1) / kMacroBlockSize *
+      kMacroBlockSize;
+  int bottom = (rect.bottom() + kMacroBlockSize - 1) / kMacroBlockSize *
+      kMacroBlockSize;
+  return webrtc::DesktopRect::MakeLTRB(left, top, right, bottom);
+}
+
+// Frames with at least this many pixels are encoded with extra threads.
+const int kMinPixelsForExtraThreads = 1920 * 1080;
+
+// The maximum number of threads to have libvpx encode with.
+const int kMaxEncoderThreads = 4;
+
+// Returns the number of threads to encode frames of |size| with.
+int GetEncoderThreadCount(const webrtc::DesktopSize& size) {
+  // Using 2 threads gives a great boost in performance for most systems with
+  // adequate processing power. NB: Going to multiple threads on low end
+  // windows systems can really hurt performance.
+  // http://crbug.com/99179
+  int num_of_processors = base::SysInfo::NumberOfProcessors();
+  if (num_of_processors <= 2)
+    return 1;
+  if (size.width() * size.height() < kMinPixelsForExtraThreads)
+    return 2;
+
+  // Large frames keep two threads busy even on machines with plenty of cores,
+  // so use up to half of the processors, leaving the rest for capturing and
+  // for the rest of the system.
+  return std::max(2, std::min(num_of_processors / 2, kMaxEncoderThreads));
+}
+
 ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   ScopedVpxCodec codec(new vpx_codec_ctx_t);
 
@@ -51,11 +88,7 @@ ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   // encoding.
   config.g_profile = 2;
 
-  // Using 2 threads gives a great boost in performance for most systems with
-  // adequate processing power. NB: Going to multiple threads on low end
-  // windows systems can really hurt performance.
-  // http://crbug.com/99179
-  config.g_threads = (base::SysInfo::NumberOfProcessors() > 2) ? 2 : 1;
+  config.g_threads = GetEncoderThreadCount(size);
   config.rc_min_quantizer = 20;
   config.rc_max_quantizer = 30;
   config.g_timebase.num = 1;
@@ -74,6 +107,19 @@ ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   if (vpx_codec_control(codec.get(), VP8E_SET_NOISE_SENSITIVITY, 0))
     return ScopedVpxCodec();
 
+  // Split the DCT tokens into one partition per encoder thread, so that the
+  // threads don't serialize on packing them.
+  vp8e_token_partitions token_partitions = VP8_ONE_TOKENPARTITION;
+  if (config.g_threads >= 4) {
+    token_partitions = VP8_FOUR_TOKENPARTITION;
+  } else if (config.g_threads >= 2) {
+    token_partitions = VP8_TWO_TOKENPARTITION;
+  }
+  if (vpx_codec_control(codec.get(), VP8E_SET_TOKEN_PARTITIONS,
+                        token_partitions)) {
+    return ScopedVpxCodec();
+  }
+
   return codec.Pass();
 }
 
@@ -129,7 +175,9 @@ scoped_ptr<VideoPacket> VideoEncoderVpx::Encode(
   // TODO(hclam): Apply the proper timestamp here.
   last_timestamp_ += 50;
 
-  // Read the encoded data.
+  // Read the encoded data. Once vpx_codec_get_cx_data() returns NULL there is
+  // no more output for this frame, so stop rather than spin on the encode
+  // thread.
   vpx_codec_iter_t iter = NULL;
   bool got_data = false;
 
@@ -140,8 +188,10 @@ scoped_ptr<VideoPacket> VideoEncoderVpx::Encode(
   while (!got_data) {
     const vpx_codec_cx_pkt_t* vpx_packet =
         vpx_codec_get_cx_data(codec_.get(), &iter);
-    if (!vpx_packet)
-      continue;
+    if (!vpx_packet) {
+      LOG(ERROR) << "No encoded frame returned by libvpx";
+      break;
+    }
 
     switch (vpx_packet->kind) {
       case VPX_CODEC_CX_FRAME_PKT:
@@ -254,15 +304,17 @@ void VideoEncoderVpx::PrepareImage(const webrtc::DesktopFrame& frame,
     return;
   }
 
-  // Align the region to macroblocks, to avoid encoding artefacts.
-  // This also ensures that all rectangles have even-aligned top-left, which
-  // is required for ConvertRGBToYUVWithRect() to work.
+  // Align the region to macroblocks, to avoid encoding artefacts. The active
+  // map marks whole macroblocks, so this keeps the converted pixels and the
+  // dirty rectangles sent to the client in step with what gets encoded, and
+  // merges the many small rectangles that e.g. typing produces into a few
+  // macroblock-aligned spans. This also ensures that all rectangles have
+  // even-aligned top-left, which is required for ConvertRGBToYUVWithRect() to
+  // work.
   std::vector<webrtc::DesktopRect> aligned_rects;
   for (webrtc::DesktopRegion::Iterator r(frame.updated_region());
        !r.IsAtEnd(); r.Advance()) {
-    const webrtc::DesktopRect& rect = r.rect();
-    aligned_rects.push_back(AlignRect(webrtc::DesktopRect::MakeLTRB(
-        rect.left(), rect.top(), rect.right(), rect.bottom())));
+    aligned_rects.push_back(AlignRectToMacroBlocks(r.rect()));
   }
   DCHECK(!aligned_rects.empty());
   updated_region->Clear();
@@ -11,10 +11,10 @@ static const int kTestInputs[] = { 100, 50, 30, 20, 10, 30, 60, 80 };
 
 TEST(CaptureSchedulerTest, SingleSampleSameTimes) {
   const int kTestResults[][arraysize(kTestInputs)] = {
-    { 400, 200, 120, 80, 50, 120, 240, 320 }, // One core.
-    { 200, 100, 60, 50, 50, 60, 120, 160 },   // Two cores.
-    { 100, 50, 50, 50, 50, 50, 60, 80 },      // Four cores.
-    { 50, 50, 50, 50, 50, 50, 50, 50 }        // Eight cores.
+    { 400, 200, 120, 80, 40, 120, 240, 320 }, // One core.
+    { 200, 100, 60, 40, 33, 60, 120, 160 },   // Two cores.
+    { 100, 50, 33, 33, 33, 33, 60, 80 },      // Four cores.
+    { 50, 33, 33, 33, 33, 33, 33, 40 }        // Eight cores.
   };
 
   for (size_t i = 0; i < arraysize(kTestResults); ++i) {
@@ -34,9 +34,9 @@ TEST(CaptureSchedulerTest, SingleSampleSameTimes) {
 TEST(CaptureSchedulerTest, SingleSampleDifferentTimes) {
   const int kTestResults[][arraysize(kTestInputs)] = {
     { 360, 220, 120, 60, 60, 120, 220, 360 }, // One core.
-    { 180, 110, 60, 50, 50, 60, 110, 180 },   // Two cores.
-    { 90, 55, 50, 50, 50, 50, 55, 90 },       // Four cores.
-    { 50, 50, 50, 50, 50, 50, 50, 50 }        // Eight cores.
+    { 180, 110, 60, 33, 33, 60, 110, 180 },   // Two cores.
+    { 90, 55, 33, 33, 33, 33, 55, 90 },       // Four cores.
+    { 45, 33, 33, 33, 33, 33, 33, 45 }        // Eight cores.
   };
 
   for (size_t i = 0; i < arraysize(kTestResults); ++i) {
@@ -57,9 +57,9 @@ TEST(CaptureSchedulerTest, SingleSampleDifferentTimes) {
 TEST(CaptureSchedulerTest, RollingAverageDifferentTimes) {
   const int kTestResults[][arraysize(kTestInputs)] = {
     { 360, 290, 233, 133, 80, 80, 133, 233 }, // One core.
-    { 180, 145, 116, 66, 50, 50, 66, 116 },   // Two cores.
-    { 90, 72, 58, 50, 50, 50, 50, 58 },       // Four cores.
-    { 50, 50, 50, 50, 50, 50, 50, 50 }        // Eight cores.
+    { 180, 145, 116, 66, 40, 40, 66, 116 },   // Two cores.
+    { 90, 72, 58, 33, 33, 33, 33, 58 },       // Four cores.
+    { 45, 36, 33, 33, 33, 33, 33, 33 }        // Eight cores.
   };
 
   for (size_t i = 0; i < arraysize(kTestResults); ++i) {
@@ -777,6 +777,13 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
                 "encountered");
   }
 
+  // Compile both outcomes once, and have every comparison below jump to the
+  // same instructions. MergeTails() would fold the copies together again,
+  // but building a new copy for each comparison makes the compiler's work
+  // grow exponentially with the nesting depth of 64bit conditions.
+  Instruction *passed = RetExpression(gen, *cond.passed_);
+  Instruction *failed = RetExpression(gen, *cond.failed_);
+
   // BPF programs operate on 32bit entities. Load both halfs of the 64bit
   // system call argument and then generate suitable conditional statements.
   Instruction *msb_head =
@@ -794,8 +801,7 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
     // Compare the least significant bits for equality
     lsb_tail = gen->MakeInstruction(BPF_JMP+BPF_JEQ+BPF_K,
                                     static_cast<uint32_t>(cond.value_),
-                                    RetExpression(gen, *cond.passed_),
-                                    RetExpression(gen, *cond.failed_));
+                                    passed, failed);
     gen->JoinInstructions(lsb_head, lsb_tail);
 
     // If we are looking at a 64bit argument, we need to also compare the
@@ -804,7 +810,7 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
       msb_tail = gen->MakeInstruction(BPF_JMP+BPF_JEQ+BPF_K,
                                       static_cast<uint32_t>(cond.value_ >> 32),
                                       lsb_head,
-                                      RetExpression(gen, *cond.failed_));
+                                      failed);
       gen->JoinInstructions(msb_head, msb_tail);
     }
     break;
@@ -820,15 +826,14 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
       int lsb_bit_count = popcount(lsb_bits);
       if (lsb_bit_count == 0) {
         // No bits are set in the LSB half. The test will always pass.
-        lsb_head = RetExpression(gen, *cond.passed_);
+        lsb_head = passed;
         lsb_tail = NULL;
       } else if (lsb_bit_count == 1) {
         // Exactly one bit is set in the LSB half. We can use the BPF_JSET
         // operator.
         lsb_tail = gen->MakeInstruction(BPF_JMP+BPF_JSET+BPF_K,
                                         lsb_bits,
-                                        RetExpression(gen, *cond.passed_),
-                                        RetExpression(gen, *cond.failed_));
+                                        passed, failed);
         gen->JoinInstructions(lsb_head, lsb_tail);
       } else {
         // More than one bit is set in the LSB half. We need to combine
@@ -839,8 +844,7 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
                                           lsb_bits,
           lsb_tail = gen->MakeInstruction(BPF_JMP+BPF_JEQ+BPF_K,
                                           lsb_bits,
-                                          RetExpression(gen, *cond.passed_),
-                                          RetExpression(gen, *cond.failed_))));
+                                          passed, failed)));
       }
     }
 
@@ -858,7 +862,7 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
         msb_tail = gen->MakeInstruction(BPF_JMP+BPF_JSET+BPF_K,
                                         msb_bits,
                                         lsb_head,
-                                        RetExpression(gen, *cond.failed_));
+                                        failed);
         gen->JoinInstructions(msb_head, msb_tail);
       } else {
         // More than one bit is set in the MSB half. We need to combine
@@ -870,7 +874,7 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
           gen->MakeInstruction(BPF_JMP+BPF_JEQ+BPF_K,
                                msb_bits,
                                lsb_head,
-                               RetExpression(gen, *cond.failed_))));
+                               failed)));
       }
     }
     break;
@@ -882,13 +886,12 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
       uint32_t lsb_bits = static_cast<uint32_t>(cond.value_);
       if (!lsb_bits) {
         // No bits are set in the LSB half. The test will always fail.
-        lsb_head = RetExpression(gen, *cond.failed_);
+        lsb_head = failed;
         lsb_tail = NULL;
       } else {
         lsb_tail = gen->MakeInstruction(BPF_JMP+BPF_JSET+BPF_K,
                                         lsb_bits,
-                                        RetExpression(gen, *cond.passed_),
-                                        RetExpression(gen, *cond.failed_));
+                                        passed, failed);
         gen->JoinInstructions(lsb_head, lsb_tail);
       }
     }
@@ -903,7 +906,7 @@ Instruction *Sandbox::CondExpression(CodeGen *gen, const ErrorCode& cond) {
       } else {
         msb_tail = gen->MakeInstruction(BPF_JMP+BPF_JSET+BPF_K,
                                         msb_bits,
-                                        RetExpression(gen, *cond.passed_),
+                                        passed,
                                         lsb_head);
         gen->JoinInstructions(msb_head, msb_tail);
       }
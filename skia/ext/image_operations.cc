@@ -193,8 +193,16 @@ ResizeFilter::ResizeFilter(ImageOperations::ResizeMethod method,
 
   ComputeFilters(src_full_width, dest_subset.fLeft, dest_subset.width(),
                  scale_x, &x_filter_);
-  ComputeFilters(src_full_height, dest_subset.fTop, dest_subset.height(),
-                 scale_y, &y_filter_);
+  if (src_full_width == src_full_height && dest_width == dest_height &&
+      dest_subset.fLeft == dest_subset.fTop &&
+      dest_subset.width() == dest_subset.height()) {
+    // Square resizes (favicons, thumbnails) need the same filter in both
+    // directions, so don't compute it twice.
+    y_filter_ = x_filter_;
+  } else {
+    ComputeFilters(src_full_height, dest_subset.fTop, dest_subset.height(),
+                   scale_y, &y_filter_);
+  }
 }
 
 // TODO(egouriou): Take advantage of periods in the convolution.
@@ -117,6 +117,17 @@ class SQL_EXPORT Connection {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to use a write-ahead log instead of a rollback journal. Readers no
+  // longer block writers, and a commit appends to the log rather than
+  // rewriting pages in place, so it costs one sync instead of several. The
+  // log is checkpointed back into the database automatically. This also
+  // relaxes "PRAGMA synchronous" to NORMAL, which in WAL mode can lose the
+  // last transactions on power loss but cannot corrupt the database.
+  //
+  // This must be called before Open() to have an effect, and has none on
+  // in-memory databases.
+  void set_wal_mode() { wal_mode_ = true; }
+
   // Call to cause Open() to restrict access permissions of the
   // database file to only the owner.
   // TODO(shess): Currently only supported on OS_POSIX, is a noop on
@@ -549,6 +560,7 @@ class SQL_EXPORT Connection {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool wal_mode_;
   bool restrict_to_user_;
 
   // All cached statements. Keeping a reference to these statements means that
@@ -0,0 +1,92 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/connection_pool.h"
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/threading/sequenced_worker_pool.h"
+
+namespace sql {
+
+ConnectionPool::Reader::Reader()
+    : pending_reads(0) {
+}
+
+ConnectionPool::Reader::~Reader() {
+}
+
+ConnectionPool::ConnectionPool(base::SequencedWorkerPool* worker_pool,
+                               int num_readers) {
+  DCHECK_GT(num_readers, 0);
+  for (int i = 0; i < num_readers; ++i) {
+    Reader* reader = new Reader;
+    base::SequencedWorkerPool::SequenceToken token =
+        worker_pool->GetSequenceToken();
+    reader->task_runner =
+        worker_pool->GetSequencedTaskRunnerWithShutdownBehavior(
+            token, base::SequencedWorkerPool::SKIP_ON_SHUTDOWN);
+    reader->close_task_runner =
+        worker_pool->GetSequencedTaskRunnerWithShutdownBehavior(
+            token, base::SequencedWorkerPool::BLOCK_SHUTDOWN);
+    reader->connection.set_wal_mode();
+    readers_.push_back(reader);
+  }
+  writer_.set_wal_mode();
+}
+
+ConnectionPool::~ConnectionPool() {
+}
+
+bool ConnectionPool::Open(const base::FilePath& path) {
+  path_ = path;
+  return writer_.Open(path);
+}
+
+bool ConnectionPool::PostRead(const tracked_objects::Location& from_here,
+                              const ReadTask& task,
+                              const base::Closure& reply) {
+  DCHECK(writer_.is_open());
+
+  Reader* least_busy = readers_[0];
+  for (size_t i = 1; i < readers_.size(); ++i) {
+    if (base::subtle::NoBarrier_Load(&readers_[i]->pending_reads) <
+        base::subtle::NoBarrier_Load(&least_busy->pending_reads)) {
+      least_busy = readers_[i];
+    }
+  }
+
+  base::subtle::NoBarrier_AtomicIncrement(&least_busy->pending_reads, 1);
+  return least_busy->task_runner->PostTaskAndReply(
+      from_here,
+      base::Bind(&ConnectionPool::RunRead, this, least_busy, task),
+      reply);
+}
+
+void ConnectionPool::Close() {
+  writer_.Close();
+  for (size_t i = 0; i < readers_.size(); ++i) {
+    readers_[i]->close_task_runner->PostTask(
+        FROM_HERE,
+        base::Bind(&ConnectionPool::CloseReader, this, readers_[i]));
+  }
+}
+
+void ConnectionPool::RunRead(Reader* reader, const ReadTask& task) {
+  DCHECK(reader->task_runner->RunsTasksOnCurrentThread());
+
+  if (!reader->connection.is_open() && !reader->connection.Open(path_))
+    DLOG(ERROR) << "Unable to open reader for " << path_.value();
+  else
+    task.Run(&reader->connection);
+  base::subtle::NoBarrier_AtomicIncrement(&reader->pending_reads, -1);
+}
+
+void ConnectionPool::CloseReader(Reader* reader) {
+  reader->connection.Close();
+}
+
+}  // namespace sql
@@ -0,0 +1,109 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SQL_CONNECTION_POOL_H_
+#define SQL_CONNECTION_POOL_H_
+
+#include "base/atomicops.h"
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/compiler_specific.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_vector.h"
+#include "sql/connection.h"
+#include "sql/sql_export.h"
+
+namespace base {
+class SequencedTaskRunner;
+class SequencedWorkerPool;
+}
+
+namespace tracked_objects {
+class Location;
+}
+
+namespace sql {
+
+// Spreads the reads of one database over several connections, so that a long
+// query does not hold up the others or wait behind the writer. The database
+// is put in WAL mode, which lets readers run while a write transaction is
+// open; each read sees the database as of the last commit before it started.
+//
+// The writer is used on the thread that called Open(), just like a plain
+// Connection. Each reader lives on its own sequence of |worker_pool|, and
+// PostRead() hands each task to the reader with the fewest reads pending.
+// Read tasks must not modify the database; all writes go through writer().
+//
+// Example:
+//   scoped_refptr<sql::ConnectionPool> pool(
+//       new sql::ConnectionPool(worker_pool, 2));
+//   if (!pool->Open(path))
+//     return false;
+//   pool->PostRead(FROM_HERE, base::Bind(&QueryOnReader, &results),
+//                  base::Bind(&OnQueryDone, &results));
+class SQL_EXPORT ConnectionPool
+    : public base::RefCountedThreadSafe<ConnectionPool> {
+ public:
+  typedef base::Callback<void(Connection*)> ReadTask;
+
+  // |worker_pool| must outlive the pool's pending reads.
+  ConnectionPool(base::SequencedWorkerPool* worker_pool, int num_readers);
+
+  // Opens the writer on the current thread. Readers are opened on their own
+  // sequences when they are first used.
+  bool Open(const base::FilePath& path) WARN_UNUSED_RESULT;
+
+  // Returns the connection to use for writes, on the thread that called
+  // Open().
+  Connection* writer() { return &writer_; }
+
+  // Runs |task| with one of the reader connections on a worker thread, then
+  // |reply| on the current thread, which must have a MessageLoop. If the
+  // reader cannot be opened, |task| is dropped but |reply| still runs.
+  // Returns false if the task could not be posted.
+  bool PostRead(const tracked_objects::Location& from_here,
+                const ReadTask& task,
+                const base::Closure& reply);
+
+  // Closes the writer now, and each reader once the reads already posted to
+  // it have run. The pool cannot be reopened. This must be called before the
+  // last reference is released, since the readers may only be closed on
+  // their own sequences.
+  void Close();
+
+ private:
+  friend class base::RefCountedThreadSafe<ConnectionPool>;
+
+  struct Reader {
+    Reader();
+    ~Reader();
+
+    // Reads are skipped at shutdown, but closing the connection blocks it so
+    // that the handle and its statements are always released. Both runners
+    // share one sequence.
+    scoped_refptr<base::SequencedTaskRunner> task_runner;
+    scoped_refptr<base::SequencedTaskRunner> close_task_runner;
+    Connection connection;
+
+    // The number of reads posted to this reader which have not yet run.
+    base::subtle::Atomic32 pending_reads;
+  };
+
+  ~ConnectionPool();
+
+  // Runs on |reader|'s sequence.
+  void RunRead(Reader* reader, const ReadTask& task);
+  void CloseReader(Reader* reader);
+
+  base::FilePath path_;
+  Connection writer_;
+  ScopedVector<Reader> readers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConnectionPool);
+};
+
+}  // namespace sql
+
+#endif  // SQL_CONNECTION_POOL_H_
@@ -0,0 +1,94 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/connection_pool.h"
+
+#include "base/bind.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "base/threading/sequenced_worker_pool.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+void CountRows(int* count, sql::Connection* db) {
+  sql::Statement s(db->GetUniqueStatement("SELECT COUNT(*) FROM foo"));
+  *count = s.Step() ? s.ColumnInt(0) : -1;
+}
+
+// Quits |run_loop| once it has been called |*remaining| times.
+void QuitAfter(int* remaining, base::RunLoop* run_loop) {
+  if (--*remaining == 0)
+    run_loop->Quit();
+}
+
+class SQLConnectionPoolTest : public testing::Test {
+ public:
+  SQLConnectionPoolTest()
+      : worker_pool_(new base::SequencedWorkerPool(3, "SQLConnectionPool")) {
+  }
+
+  virtual void SetUp() {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    pool_ = new sql::ConnectionPool(worker_pool_.get(), 2);
+    ASSERT_TRUE(
+        pool_->Open(temp_dir_.path().AppendASCII("SQLConnectionPool.db")));
+    ASSERT_TRUE(pool_->writer()->Execute("CREATE TABLE foo (a)"));
+  }
+
+  virtual void TearDown() {
+    pool_->Close();
+    worker_pool_->Shutdown();
+    pool_ = NULL;
+  }
+
+ protected:
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+  scoped_refptr<base::SequencedWorkerPool> worker_pool_;
+  scoped_refptr<sql::ConnectionPool> pool_;
+};
+
+TEST_F(SQLConnectionPoolTest, ReadersSeeCommittedWrites) {
+  ASSERT_TRUE(pool_->writer()->Execute("INSERT INTO foo VALUES (1)"));
+  ASSERT_TRUE(pool_->writer()->Execute("INSERT INTO foo VALUES (2)"));
+
+  const int kReads = 4;
+  int counts[kReads];
+  int remaining = kReads;
+  base::RunLoop run_loop;
+  for (int i = 0; i < kReads; ++i) {
+    counts[i] = 0;
+    EXPECT_TRUE(pool_->PostRead(FROM_HERE,
+                                base::Bind(&CountRows, &counts[i]),
+                                base::Bind(&QuitAfter, &remaining, &run_loop)));
+  }
+  run_loop.Run();
+
+  for (int i = 0; i < kReads; ++i)
+    EXPECT_EQ(2, counts[i]);
+}
+
+// A write transaction held open on the writer does not block readers, which
+// keep seeing the last committed state.
+TEST_F(SQLConnectionPoolTest, ReadDuringWriteTransaction) {
+  ASSERT_TRUE(pool_->writer()->Execute("INSERT INTO foo VALUES (1)"));
+  ASSERT_TRUE(pool_->writer()->BeginTransaction());
+  ASSERT_TRUE(pool_->writer()->Execute("INSERT INTO foo VALUES (2)"));
+
+  int count = 0;
+  int remaining = 1;
+  base::RunLoop run_loop;
+  EXPECT_TRUE(pool_->PostRead(FROM_HERE,
+                              base::Bind(&CountRows, &count),
+                              base::Bind(&QuitAfter, &remaining, &run_loop)));
+  run_loop.Run();
+  EXPECT_EQ(1, count);
+
+  ASSERT_TRUE(pool_->writer()->CommitTransaction());
+}
+
+}  // namespace
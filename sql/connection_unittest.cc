@@ -680,6 +680,29 @@ TEST_F(SQLConnectionTest, Delete) {
   EXPECT_FALSE(base::PathExists(journal));
 }
 
+TEST_F(SQLConnectionTest, WALMode) {
+  db().Close();
+  sql::Connection::Delete(db_path());
+
+  db().set_wal_mode();
+  ASSERT_TRUE(db().Open(db_path()));
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("wal", s.ColumnString(0));
+  }
+
+  EXPECT_TRUE(db().Execute("CREATE TABLE x (x)"));
+  EXPECT_TRUE(db().Execute("INSERT INTO x VALUES (1)"));
+  base::FilePath wal(db_path().value() + FILE_PATH_LITERAL("-wal"));
+  EXPECT_TRUE(base::PathExists(wal));
+
+  db().Close();
+  sql::Connection::Delete(db_path());
+  EXPECT_FALSE(base::PathExists(db_path()));
+  EXPECT_FALSE(base::PathExists(wal));
+}
+
 #if defined(OS_POSIX)
 // Test that set_restrict_to_user() trims database permissions so that
 // only the owner (and root) can read.
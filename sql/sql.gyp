@@ -22,6 +22,8 @@
       'sources': [
         'connection.cc',
         'connection.h',
+        'connection_pool.cc',
+        'connection_pool.h',
         'error_delegate_util.cc',
         'error_delegate_util.h',
         'init_status.h',
@@ -86,6 +88,7 @@
         '../third_party/sqlite/sqlite.gyp:sqlite',
       ],
       'sources': [
+        'connection_pool_unittest.cc',
         'connection_unittest.cc',
         'meta_table_unittest.cc',
         'recovery_unittest.cc',
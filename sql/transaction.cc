@@ -6,6 +6,7 @@
 
 #include "base/logging.h"
 #include "sql/connection.h"
+#include "sql/statement.h"
 
 namespace sql {
 
@@ -48,4 +49,47 @@ bool Transaction::Commit() {
   return connection_->CommitTransaction();
 }
 
+BatchedTransaction::BatchedTransaction(Connection* connection,
+                                       int max_writes,
+                                       base::TimeDelta commit_delay)
+    : connection_(connection),
+      max_writes_(max_writes),
+      commit_delay_(commit_delay),
+      is_open_(false),
+      pending_writes_(0) {
+  DCHECK_GT(max_writes_, 0);
+}
+
+BatchedTransaction::~BatchedTransaction() {
+  ignore_result(Commit());
+}
+
+bool BatchedTransaction::Run(Statement* statement) {
+  if (!is_open_) {
+    if (!connection_->BeginTransaction())
+      return false;
+    is_open_ = true;
+    commit_timer_.Start(FROM_HERE, commit_delay_, this,
+                        &BatchedTransaction::OnCommitTimer);
+  }
+
+  bool succeeded = statement->Run();
+  if (++pending_writes_ >= max_writes_)
+    ignore_result(Commit());
+  return succeeded;
+}
+
+bool BatchedTransaction::Commit() {
+  if (!is_open_)
+    return true;
+  commit_timer_.Stop();
+  is_open_ = false;
+  pending_writes_ = 0;
+  return connection_->CommitTransaction();
+}
+
+void BatchedTransaction::OnCommitTimer() {
+  ignore_result(Commit());
+}
+
 }  // namespace sql
@@ -6,11 +6,14 @@
 #define SQL_TRANSACTION_H_
 
 #include "base/basictypes.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "sql/sql_export.h"
 
 namespace sql {
 
 class Connection;
+class Statement;
 
 class SQL_EXPORT Transaction {
  public:
@@ -55,6 +58,57 @@ class SQL_EXPORT Transaction {
   DISALLOW_COPY_AND_ASSIGN(Transaction);
 };
 
+// Groups a stream of small writes into larger transactions, so the journal is
+// synced once per batch instead of once per row. The open batch is committed
+// once |max_writes| statements have been run in it, once |commit_delay| has
+// passed since its first statement, or when Commit() is called or this object
+// is destroyed, whichever comes first.
+//
+// Writes are visible on |connection| as soon as they are run, but other
+// connections only see them once the batch commits, and a crash loses the
+// whole open batch. If a nested transaction inside the batch rolls back, the
+// entire batch is rolled back with it.
+//
+// The commit timer runs on the current MessageLoop, so this must be used on
+// the thread which owns |connection|, and that thread must have a loop.
+class SQL_EXPORT BatchedTransaction {
+ public:
+  BatchedTransaction(Connection* connection,
+                     int max_writes,
+                     base::TimeDelta commit_delay);
+  ~BatchedTransaction();
+
+  // Returns true if statements have been run which are not yet committed.
+  bool has_pending_writes() const { return is_open_; }
+
+  // Runs |statement| inside the current batch, beginning one if needed.
+  // Returns the result of running the statement, or false if a transaction
+  // could not be begun. The caller is responsible for resetting |statement|
+  // before reusing it.
+  bool Run(Statement* statement);
+
+  // Commits the open batch, if any. Returns false if there was a batch and
+  // it could not be committed.
+  bool Commit();
+
+ private:
+  void OnCommitTimer();
+
+  Connection* connection_;
+  const int max_writes_;
+  const base::TimeDelta commit_delay_;
+
+  // True while a batch transaction is open.
+  bool is_open_;
+
+  // The number of statements run in the open batch.
+  int pending_writes_;
+
+  base::OneShotTimer<BatchedTransaction> commit_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(BatchedTransaction);
+};
+
 }  // namespace sql
 
 #endif  // SQL_TRANSACTION_H_
@@ -4,6 +4,8 @@
 
 #include "base/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
 #include "sql/connection.h"
 #include "sql/statement.h"
 #include "sql/transaction.h"
@@ -14,8 +16,7 @@ class SQLTransactionTest : public testing::Test {
  public:
   virtual void SetUp() {
     ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
-    ASSERT_TRUE(db_.Open(
-        temp_dir_.path().AppendASCII("SQLTransactionTest.db")));
+    ASSERT_TRUE(db_.Open(db_path()));
 
     ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
   }
@@ -26,6 +27,10 @@ class SQLTransactionTest : public testing::Test {
 
   sql::Connection& db() { return db_; }
 
+  base::FilePath db_path() {
+    return temp_dir_.path().AppendASCII("SQLTransactionTest.db");
+  }
+
   // Returns the number of rows in table "foo".
   int CountFoo() {
     sql::Statement count(db().GetUniqueStatement("SELECT count(*) FROM foo"));
@@ -129,3 +134,48 @@ TEST_F(SQLTransactionTest, NestedRollback) {
   EXPECT_EQ(0, db().transaction_nesting());
   EXPECT_EQ(0, CountFoo());
 }
+
+// Rows written through a BatchedTransaction are invisible to other
+// connections until the batch fills up.
+TEST_F(SQLTransactionTest, BatchedCommitsWhenFull) {
+  base::MessageLoop message_loop;
+  sql::Connection reader;
+  ASSERT_TRUE(reader.Open(db_path()));
+  sql::Statement count(reader.GetUniqueStatement("SELECT count(*) FROM foo"));
+
+  sql::BatchedTransaction batch(&db(), 3, base::TimeDelta::FromHours(1));
+  sql::Statement insert(db().GetUniqueStatement(
+      "INSERT INTO foo (a, b) VALUES (?, ?)"));
+  for (int i = 0; i < 5; ++i) {
+    insert.BindInt(0, i);
+    insert.BindInt(1, i);
+    EXPECT_TRUE(batch.Run(&insert));
+    insert.Reset(true);
+  }
+  EXPECT_TRUE(batch.has_pending_writes());
+  EXPECT_EQ(5, CountFoo());
+
+  ASSERT_TRUE(count.Step());
+  EXPECT_EQ(3, count.ColumnInt(0));
+  count.Reset(true);
+
+  EXPECT_TRUE(batch.Commit());
+  EXPECT_FALSE(batch.has_pending_writes());
+  EXPECT_EQ(0, db().transaction_nesting());
+  ASSERT_TRUE(count.Step());
+  EXPECT_EQ(5, count.ColumnInt(0));
+}
+
+TEST_F(SQLTransactionTest, BatchedCommitsOnTimer) {
+  base::MessageLoop message_loop;
+  sql::BatchedTransaction batch(&db(), 100, base::TimeDelta());
+  sql::Statement insert(db().GetUniqueStatement(
+      "INSERT INTO foo (a, b) VALUES (1, 2)"));
+  EXPECT_TRUE(batch.Run(&insert));
+  EXPECT_EQ(1, db().transaction_nesting());
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(batch.has_pending_writes());
+  EXPECT_EQ(0, db().transaction_nesting());
+  EXPECT_EQ(1, CountFoo());
+}
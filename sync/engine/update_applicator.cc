@@ -58,12 +58,13 @@ void UpdateApplicator::AttemptApplications(
 
     for (std::vector<int64>::iterator i = to_apply.begin();
          i != to_apply.end(); ++i) {
-      syncable::Entry read_entry(trans, syncable::GET_BY_HANDLE, *i);
-      if (SkipUpdate(read_entry)) {
+      // Looking up a MutableEntry doesn't modify it, so one lookup serves
+      // both the skip check and the application.
+      syncable::MutableEntry entry(trans, syncable::GET_BY_HANDLE, *i);
+      if (SkipUpdate(entry)) {
         continue;
       }
 
-      syncable::MutableEntry entry(trans, syncable::GET_BY_HANDLE, *i);
       UpdateAttemptResponse result = AttemptToUpdateEntry(
           trans, &entry, cryptographer_);
 
@@ -534,6 +534,21 @@ bool Directory::VacuumAfterSaveChanges(const SaveChangesSnapshot& snapshot) {
   if (snapshot.dirty_metas.empty())
     return true;
 
+  // Only deleted entries can be purged. An entry deleted since the snapshot
+  // was taken is dirty again, so it isn't safe to purge either. If nothing in
+  // the snapshot was deleted, don't bother taking a write transaction, which
+  // would block the other threads for every save.
+  bool has_deleted_entries = false;
+  for (EntryKernelSet::const_iterator i = snapshot.dirty_metas.begin();
+       i != snapshot.dirty_metas.end(); ++i) {
+    if ((*i)->ref(IS_DEL)) {
+      has_deleted_entries = true;
+      break;
+    }
+  }
+  if (!has_deleted_entries)
+    return true;
+
   // Need a write transaction as we are about to permanently purge entries.
   WriteTransaction trans(FROM_HERE, VACUUM_AFTER_SAVE, this);
   ScopedKernelLock lock(this);
@@ -929,6 +944,13 @@ void Directory::GetUnappliedUpdateMetaHandles(
     std::vector<int64>* result) {
   result->clear();
   ScopedKernelLock lock(this);
+  size_t num_handles = 0;
+  for (int i = UNSPECIFIED; i < MODEL_TYPE_COUNT; ++i) {
+    const ModelType type = ModelTypeFromInt(i);
+    if (server_types.Has(type))
+      num_handles += kernel_->unapplied_update_metahandles[type].size();
+  }
+  result->reserve(num_handles);
   for (int i = UNSPECIFIED; i < MODEL_TYPE_COUNT; ++i) {
     const ModelType type = ModelTypeFromInt(i);
     if (server_types.Has(type)) {
@@ -86,27 +86,28 @@ scoped_ptr<EntryKernel> UnpackEntry(sql::Statement* statement) {
     kernel->put(static_cast<TimeField>(i),
                 ProtoTimeToTime(statement->ColumnInt64(i)));
   }
+  // Every entry is unpacked at startup, so swap the column strings into
+  // place and parse the blobs straight from sqlite's buffers rather than
+  // copying each value through a temporary.
   for ( ; i < ID_FIELDS_END; ++i) {
-    kernel->mutable_ref(static_cast<IdField>(i)).s_ =
-        statement->ColumnString(i);
+    statement->ColumnString(i).swap(
+        kernel->mutable_ref(static_cast<IdField>(i)).s_);
   }
   for ( ; i < BIT_FIELDS_END; ++i) {
     kernel->put(static_cast<BitField>(i), (0 != statement->ColumnInt(i)));
   }
   for ( ; i < STRING_FIELDS_END; ++i) {
-    kernel->put(static_cast<StringField>(i),
-                statement->ColumnString(i));
+    statement->ColumnString(i).swap(
+        kernel->mutable_ref(static_cast<StringField>(i)));
   }
   for ( ; i < PROTO_FIELDS_END; ++i) {
     kernel->mutable_ref(static_cast<ProtoField>(i)).ParseFromArray(
         statement->ColumnBlob(i), statement->ColumnByteLength(i));
   }
   for ( ; i < UNIQUE_POSITION_FIELDS_END; ++i) {
-    std::string temp;
-    statement->ColumnBlobAsString(i, &temp);
-
     sync_pb::UniquePosition proto;
-    if (!proto.ParseFromString(temp)) {
+    if (!proto.ParseFromArray(statement->ColumnBlob(i),
+                              statement->ColumnByteLength(i))) {
       DVLOG(1) << "Unpacked invalid position.  Assuming the DB is corrupt";
       return scoped_ptr<EntryKernel>();
     }
@@ -111,7 +111,7 @@ void DeleteJournal::TakeSnapshotAndClear(BaseTransaction* trans,
       ++it;
     }
   }
-  *journals_to_purge = delete_journals_to_purge_;
+  journals_to_purge->swap(delete_journals_to_purge_);
   delete_journals_to_purge_.clear();
 }
 
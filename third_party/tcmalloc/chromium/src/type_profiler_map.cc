@@ -93,7 +93,9 @@ void InsertType(void* address, size_t size, const std::type_info& type) {
 
 void EraseType(void* address) {
   SpinLockHolder lock(&g_type_profiler_lock);
-  InitializeTypeProfilerMemory();
+  // Nothing has been inserted yet, so there is nothing to erase.
+  if (g_type_profiler_map == NULL)
+    return;
 
   ObjectInfo obj;
   g_type_profiler_map->FindAndRemove(address, &obj);
@@ -101,7 +103,8 @@ void EraseType(void* address) {
 
 const std::type_info* LookupType(const void* address) {
   SpinLockHolder lock(&g_type_profiler_lock);
-  InitializeTypeProfilerMemory();
+  if (g_type_profiler_map == NULL)
+    return NULL;
 
   const ObjectInfo* found = g_type_profiler_map->Find(address);
   if (found == NULL)
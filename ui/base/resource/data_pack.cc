@@ -27,17 +27,25 @@ struct DataPackEntry {
   uint16 resource_id;
   uint32 file_offset;
 
-  static int CompareById(const void* void_key, const void* void_entry) {
-    uint16 key = *reinterpret_cast<const uint16*>(void_key);
-    const DataPackEntry* entry =
-        reinterpret_cast<const DataPackEntry*>(void_entry);
-    if (key < entry->resource_id) {
-      return -1;
-    } else if (key > entry->resource_id) {
-      return 1;
-    } else {
-      return 0;
+  // Binary searches the |count| entries of the index starting at |entries|
+  // for |resource_id|, returning NULL if it isn't there. This is inlined
+  // rather than using bsearch(), which calls a comparator through a function
+  // pointer for every probe.
+  static const DataPackEntry* Find(const DataPackEntry* entries,
+                                   size_t count,
+                                   uint16 resource_id) {
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (entries[mid].resource_id < resource_id)
+        lo = mid + 1;
+      else
+        hi = mid;
     }
+    if (lo < count && entries[lo].resource_id == resource_id)
+      return &entries[lo];
+    return NULL;
   }
 };
 #pragma pack(pop)
@@ -97,6 +105,10 @@ bool DataPack::LoadFromFile(base::PlatformFile file) {
 }
 
 bool DataPack::LoadImpl() {
+  // Resources are looked up all through startup; reading the pack in one go
+  // is much cheaper than taking a page fault per resource on a cold disk.
+  mmap_->Advise(base::MemoryMappedFile::ACCESS_WILL_NEED);
+
   // Sanity check the header of the file.
   if (kHeaderLength > mmap_->length()) {
     DLOG(ERROR) << "Data pack file corruption: incomplete file header.";
@@ -163,8 +175,9 @@ bool DataPack::LoadImpl() {
 }
 
 bool DataPack::HasResource(uint16 resource_id) const {
-  return !!bsearch(&resource_id, mmap_->data() + kHeaderLength, resource_count_,
-                   sizeof(DataPackEntry), DataPackEntry::CompareById);
+  return !!DataPackEntry::Find(
+      reinterpret_cast<const DataPackEntry*>(mmap_->data() + kHeaderLength),
+      resource_count_, resource_id);
 }
 
 bool DataPack::GetStringPiece(uint16 resource_id,
@@ -180,9 +193,9 @@ bool DataPack::GetStringPiece(uint16 resource_id,
   #error DataPack assumes little endian
 #endif
 
-  const DataPackEntry* target = reinterpret_cast<const DataPackEntry*>(
-      bsearch(&resource_id, mmap_->data() + kHeaderLength, resource_count_,
-              sizeof(DataPackEntry), DataPackEntry::CompareById));
+  const DataPackEntry* target = DataPackEntry::Find(
+      reinterpret_cast<const DataPackEntry*>(mmap_->data() + kHeaderLength),
+      resource_count_, resource_id);
   if (!target) {
     return false;
   }
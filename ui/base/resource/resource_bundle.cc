@@ -32,6 +32,7 @@
 #include "ui/gfx/image/image_skia_source.h"
 #include "ui/gfx/safe_integer_conversions.h"
 #include "ui/gfx/screen.h"
+#include "ui/gfx/size.h"
 #include "ui/gfx/size_conversions.h"
 #include "ui/gfx/skbitmap_operations.h"
 
@@ -61,6 +62,8 @@ const int kLargeFontSizeDelta = 8;
 // PNG-related constants.
 const unsigned char kPngMagic[8] = { 0x89, 'P', 'N', 'G', 13, 10, 26, 10 };
 const size_t kPngChunkMetadataSize = 12;  // length, type, crc32
+const unsigned char kPngHeaderChunkType[4] = { 'I', 'H', 'D', 'R' };
+const size_t kPngHeaderChunkMinLength = 8;  // width, height
 const unsigned char kPngScaleChunkType[4] = { 'c', 's', 'C', 'l' };
 const unsigned char kPngDataChunkType[4] = { 'I', 'D', 'A', 'T' };
 
@@ -359,14 +362,22 @@ gfx::Image& ResourceBundle::GetImageNamed(int resource_id) {
     ui::ScaleFactor scale_factor_to_load = ui::SCALE_FACTOR_100P;
 #endif
 
-    float scale = GetImageScale(scale_factor_to_load);
-    // TODO(oshima): Consider reading the image size from png IHDR chunk and
-    // skip decoding here and remove #ifdef below.
     // ResourceBundle::GetSharedInstance() is destroyed after the
     // BrowserMainLoop has finished running. |image_skia| is guaranteed to be
     // destroyed before the resource bundle is destroyed.
-    gfx::ImageSkia image_skia(new ResourceBundleImageSource(this, resource_id),
-                              scale);
+    gfx::ImageSkia image_skia;
+    gfx::Size size;
+    if (GetImageSize(resource_id, scale_factor_to_load, &size)) {
+      // The size is known from the PNG header, so nothing is decoded until a
+      // representation is actually requested.
+      image_skia = gfx::ImageSkia(
+          new ResourceBundleImageSource(this, resource_id), size);
+    } else {
+      // Not a PNG (or a missing resource); decode now to get the size.
+      image_skia = gfx::ImageSkia(
+          new ResourceBundleImageSource(this, resource_id),
+          GetImageScale(scale_factor_to_load));
+    }
     if (image_skia.isNull()) {
       LOG(WARNING) << "Unable to load image with id " << resource_id;
       NOTREACHED();  // Want to assert in debug mode.
@@ -749,6 +760,39 @@ bool ResourceBundle::LoadBitmap(int resource_id,
   return false;
 }
 
+bool ResourceBundle::GetImageSize(int resource_id,
+                                  ScaleFactor scale_factor,
+                                  gfx::Size* size) const {
+  for (size_t i = 0; i < data_packs_.size(); ++i) {
+    // Mirror the pack lookup order of LoadBitmap() above.
+    ScaleFactor pack_scale_factor = data_packs_[i]->GetScaleFactor();
+    if (pack_scale_factor != ui::SCALE_FACTOR_NONE &&
+        pack_scale_factor != scale_factor) {
+      continue;
+    }
+    scoped_refptr<base::RefCountedMemory> memory(
+        data_packs_[i]->GetStaticMemory(resource_id));
+    if (!memory.get())
+      continue;
+
+    gfx::Size pixel_size;
+    if (!PNGGetSize(memory->front(), memory->size(), &pixel_size))
+      return false;
+    if (pack_scale_factor == ui::SCALE_FACTOR_NONE ||
+        PNGContainsFallbackMarker(memory->front(), memory->size())) {
+      // The bitmap is 1x data, so its pixel size is the size in DIP.
+      *size = pixel_size;
+      return true;
+    }
+    // Match how gfx::ImageSkiaRep computes its size in DIP.
+    float scale = GetImageScale(scale_factor);
+    *size = gfx::Size(static_cast<int>(pixel_size.width() / scale),
+                      static_cast<int>(pixel_size.height() / scale));
+    return true;
+  }
+  return false;
+}
+
 gfx::Image& ResourceBundle::GetEmptyImage() {
   base::AutoLock lock(*images_and_fonts_lock_);
 
@@ -803,6 +847,32 @@ bool ResourceBundle::PNGContainsFallbackMarker(const unsigned char* buf,
   return false;
 }
 
+// static
+bool ResourceBundle::PNGGetSize(const unsigned char* buf,
+                                size_t size,
+                                gfx::Size* pixel_size) {
+  // IHDR must be the first chunk, right after the signature.
+  const size_t pos = arraysize(kPngMagic);
+  if (size < pos + kPngChunkMetadataSize + kPngHeaderChunkMinLength ||
+      memcmp(buf, kPngMagic, arraysize(kPngMagic)) != 0 ||
+      memcmp(buf + pos + sizeof(uint32), kPngHeaderChunkType,
+             arraysize(kPngHeaderChunkType)) != 0) {
+    return false;
+  }
+  const char* data =
+      reinterpret_cast<const char*>(buf + pos + 2 * sizeof(uint32));
+  uint32 width = 0;
+  uint32 height = 0;
+  net::ReadBigEndian(data, &width);
+  net::ReadBigEndian(data + sizeof(uint32), &height);
+  if (width == 0 || height == 0 || width > static_cast<uint32>(kint32max) ||
+      height > static_cast<uint32>(kint32max)) {
+    return false;
+  }
+  *pixel_size = gfx::Size(width, height);
+  return true;
+}
+
 // static
 bool ResourceBundle::DecodePNG(const unsigned char* buf,
                                size_t size,
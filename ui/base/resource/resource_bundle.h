@@ -31,6 +31,10 @@ class Lock;
 class RefCountedStaticMemory;
 }
 
+namespace gfx {
+class Size;
+}
+
 namespace ui {
 
 class DataPack;
@@ -333,6 +337,13 @@ class UI_EXPORT ResourceBundle {
                   SkBitmap* bitmap,
                   bool* fell_back_to_1x) const;
 
+  // Sets |size| to the size in DIP of the PNG image |resource_id| would be
+  // loaded from for |scale_factor|, reading only the PNG header. Returns false
+  // if the resource does not exist or is not a PNG.
+  bool GetImageSize(int resource_id,
+                    ScaleFactor scale_factor,
+                    gfx::Size* size) const;
+
   // Returns true if missing scaled resources should be visually indicated when
   // drawing the fallback (e.g., by tinting the image).
   static bool ShouldHighlightMissingScaledResources();
@@ -341,6 +352,12 @@ class UI_EXPORT ResourceBundle {
   // added by GRIT that indicates that the image is actually 1x data.
   static bool PNGContainsFallbackMarker(const unsigned char* buf, size_t size);
 
+  // Sets |pixel_size| to the dimensions in the IHDR chunk of the PNG in |buf|.
+  // Returns false if |buf| is not a PNG.
+  static bool PNGGetSize(const unsigned char* buf,
+                         size_t size,
+                         gfx::Size* pixel_size);
+
   // A wrapper for PNGCodec::Decode that returns information about custom
   // chunks. For security reasons we can't alter PNGCodec to return this
   // information. Our PNG files are preprocessed by GRIT, and any special chunks
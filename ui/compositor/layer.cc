@@ -557,10 +557,17 @@ bool Layer::SchedulePaint(const gfx::Rect& invalid_rect) {
   if (type_ == LAYER_SOLID_COLOR || (!delegate_ && !texture_.get()))
     return false;
 
-  damaged_region_.op(invalid_rect.x(),
-                     invalid_rect.y(),
-                     invalid_rect.right(),
-                     invalid_rect.bottom(),
+  // Damage outside the layer is never drawn, and resizing the layer repaints
+  // all of it anyway, so don't let it grow the region or trigger a frame.
+  gfx::Rect damaged(invalid_rect);
+  damaged.Intersect(gfx::Rect(bounds_.size()));
+  if (damaged.IsEmpty())
+    return false;
+
+  damaged_region_.op(damaged.x(),
+                     damaged.y(),
+                     damaged.right(),
+                     damaged.bottom(),
                      SkRegion::kUnion_Op);
   ScheduleDraw();
   return true;
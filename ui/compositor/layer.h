@@ -274,8 +274,9 @@ class COMPOSITOR_EXPORT Layer
   // Sets the layer's fill color.  May only be called for LAYER_SOLID_COLOR.
   void SetColor(SkColor color);
 
-  // Adds |invalid_rect| to the Layer's pending invalid rect and calls
-  // ScheduleDraw(). Returns false if the paint request is ignored.
+  // Adds |invalid_rect|, clipped to the Layer's bounds, to the Layer's pending
+  // invalid rect and calls ScheduleDraw(). Returns false if the paint request
+  // is ignored, including when |invalid_rect| lies outside the Layer.
   bool SchedulePaint(const gfx::Rect& invalid_rect);
 
   // Schedules a redraw of the layer tree at the compositor.
@@ -764,6 +764,18 @@ TEST_F(LayerWithNullDelegateTest, SetBoundsSchedulesPaint) {
   WaitForDraw();
 }
 
+// Verifies that paints entirely outside a layer are ignored.
+TEST_F(LayerWithNullDelegateTest, SchedulePaintOutsideBounds) {
+  scoped_ptr<Layer> l1(CreateTextureLayer(gfx::Rect(0, 0, 200, 200)));
+  compositor()->SetRootLayer(l1.get());
+
+  Draw();
+
+  EXPECT_TRUE(l1->SchedulePaint(gfx::Rect(190, 190, 20, 20)));
+  EXPECT_FALSE(l1->SchedulePaint(gfx::Rect(200, 0, 10, 10)));
+  EXPECT_FALSE(l1->SchedulePaint(gfx::Rect()));
+}
+
 // Checks that pixels are actually drawn to the screen with a read back.
 TEST_F(LayerWithRealCompositorTest, DrawPixels) {
   gfx::Size viewport_size = GetCompositor()->size();
@@ -145,17 +145,39 @@ void ConvertRGBARowToSkia(png_structp png_ptr,
       static_cast<PngDecoderState*>(png_get_user_transform_ptr(png_ptr));
   DCHECK(state) << "LibPNG user transform pointer is NULL";
 
+  bool is_opaque = true;
   unsigned char* const end = data + row_info->rowbytes;
   for (unsigned char* p = data; p < end; p += channels) {
     uint32_t* sk_pixel = reinterpret_cast<uint32_t*>(p);
     const unsigned char alpha = p[channels - 1];
-    if (alpha != 255) {
-      state->is_opaque = false;
-      *sk_pixel = SkPreMultiplyARGB(alpha, p[0], p[1], p[2]);
-    } else {
+    if (alpha == 255) {
       *sk_pixel = SkPackARGB32(alpha, p[0], p[1], p[2]);
+    } else if (alpha == 0) {
+      // Fully transparent pixels premultiply to zero; skip the multiplies.
+      is_opaque = false;
+      *sk_pixel = 0;
+    } else {
+      is_opaque = false;
+      *sk_pixel = SkPreMultiplyARGB(alpha, p[0], p[1], p[2]);
     }
   }
+  if (!is_opaque)
+    state->is_opaque = false;
+}
+
+// Like ConvertRGBARowToSkia, for images without alpha whose rows libpng has
+// padded with an opaque filler byte. No premultiplication is needed, so this
+// only packs the pixels.
+void ConvertRGBXRowToSkia(png_structp png_ptr,
+                          png_row_infop row_info,
+                          png_bytep data) {
+  const int channels = row_info->channels;
+  DCHECK_EQ(channels, 4);
+
+  unsigned char* const end = data + row_info->rowbytes;
+  for (unsigned char* p = data; p < end; p += channels) {
+    *reinterpret_cast<uint32_t*>(p) = SkPackARGB32(0xFF, p[0], p[1], p[2]);
+  }
 }
 
 // Called when the png header has been read. This code is based on the WebKit
@@ -265,7 +287,8 @@ void DecodeInfoCallback(png_struct* png_ptr, png_info* info_ptr) {
   // because all png_set_* calls need to be done in the specific order
   // mandated by libpng.
   if (state->output_format == PNGCodec::FORMAT_SkBitmap) {
-    png_set_read_user_transform_fn(png_ptr, ConvertRGBARowToSkia);
+    png_set_read_user_transform_fn(png_ptr, input_has_alpha ?
+        ConvertRGBARowToSkia : ConvertRGBXRowToSkia);
     png_set_user_transform_info(png_ptr, state, 0, 0);
   }
 
@@ -377,6 +377,12 @@ void RenderText::SetHorizontalAlignment(HorizontalAlignment alignment) {
 }
 
 void RenderText::SetFontList(const FontList& font_list) {
+  // Views re-apply their font on every update; don't throw away the layout
+  // and its shaping results when the fonts didn't change.
+  if (font_list.GetFontDescriptionString() ==
+      font_list_.GetFontDescriptionString()) {
+    return;
+  }
   font_list_ = font_list;
   baseline_ = kInvalidBaseline;
   cached_bounds_and_offset_valid_ = false;
@@ -1220,6 +1220,22 @@ TEST_F(RenderTextTest, SetFontList) {
   EXPECT_EQ(13, render_text->GetPrimaryFont().GetFontSize());
 }
 
+TEST_F(RenderTextTest, SetSameFontListKeepsLayout) {
+  scoped_ptr<RenderText> render_text(RenderText::CreateInstance());
+  render_text->SetText(ASCIIToUTF16("abcdef"));
+  render_text->SetFontList(FontList("Arial, 13px"));
+  render_text->GetUpdatedCursorBounds();
+  EXPECT_TRUE(render_text->cached_bounds_and_offset_valid_);
+
+  // Setting an equivalent font list keeps the layout.
+  render_text->SetFontList(FontList("Arial, 13px"));
+  EXPECT_TRUE(render_text->cached_bounds_and_offset_valid_);
+
+  // A different font list resets it.
+  render_text->SetFontList(FontList("Arial, 14px"));
+  EXPECT_FALSE(render_text->cached_bounds_and_offset_valid_);
+}
+
 TEST_F(RenderTextTest, StringSizeBoldWidth) {
   scoped_ptr<RenderText> render_text(RenderText::CreateInstance());
   render_text->SetText(UTF8ToUTF16("Hello World"));
@@ -28,10 +28,19 @@ void DoAppendStringOfType(const CHAR* source, int length,
     } else {
       // Just append the 7-bit character, possibly escaping it.
       unsigned char uch = static_cast<unsigned char>(source[i]);
-      if (!IsCharOfType(uch, type))
+      if (!IsCharOfType(uch, type)) {
         AppendEscapedChar(uch, output);
-      else
-        output->push_back(uch);
+      } else {
+        // Copy the whole run of characters that don't need escaping.
+        int run_end = i + 1;
+        while (run_end < length &&
+               static_cast<UCHAR>(source[run_end]) < 0x80 &&
+               IsCharOfType(static_cast<unsigned char>(source[run_end]),
+                            type))
+          run_end++;
+        AppendASCIIRun(source, i, run_end, output);
+        i = run_end - 1;
+      }
     }
   }
 }
@@ -81,6 +81,19 @@ void AppendStringOfType(const base::char16* source, int length,
                         SharedCharTypes type,
                         CanonOutput* output);
 
+// Appends the characters from |begin| to |end| of |source|, which must all be
+// 7-bit, to the output unchanged. Canonicalizers use this to copy a run of
+// characters that need no escaping at once rather than one at a time.
+inline void AppendASCIIRun(const char* source, int begin, int end,
+                           CanonOutput* output) {
+  output->Append(&source[begin], end - begin);
+}
+inline void AppendASCIIRun(const base::char16* source, int begin, int end,
+                           CanonOutput* output) {
+  for (int i = begin; i < end; i++)
+    output->push_back(static_cast<char>(source[i]));
+}
+
 // Maps the hex numerical values 0x0 to 0xf to the corresponding ASCII digit
 // that will be used to represent it.
 URL_EXPORT extern const char kHexCharLookup[0x10];
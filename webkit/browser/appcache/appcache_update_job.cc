@@ -213,6 +213,28 @@ void AppCacheUpdateJob::URLFetcher::AddConditionalHeaders(
     request_->SetExtraRequestHeaders(extra_headers);
 }
 
+bool AppCacheUpdateJob::URLFetcher::ResponseMatchesExistingEntry() const {
+  // The sizes can't be compared since they include the headers, which
+  // usually differ in their dates.
+  if (!existing_entry_.has_response_id() || !existing_response_headers_.get())
+    return false;
+
+  const std::string etag = "ETag";
+  std::string existing_etag_value;
+  existing_response_headers_->EnumerateHeader(NULL, etag,
+                                              &existing_etag_value);
+  if (existing_etag_value.empty() ||
+      StartsWithASCII(existing_etag_value, "W/", true)) {
+    return false;  // Weak validators don't promise identical bodies.
+  }
+
+  const net::HttpResponseHeaders* headers = request_->response_headers();
+  std::string etag_value;
+  if (headers)
+    headers->EnumerateHeader(NULL, etag, &etag_value);
+  return etag_value == existing_etag_value;
+}
+
 void  AppCacheUpdateJob::URLFetcher::OnWriteComplete(int result) {
   if (result < 0) {
     request_->Cancel();
@@ -551,12 +573,23 @@ void AppCacheUpdateJob::HandleUrlFetchCompleted(URLFetcher* fetcher) {
   AppCacheEntry& entry = url_file_list_.find(url)->second;
 
   if (response_code / 100 == 2) {
-    // Associate storage with the new entry.
     DCHECK(fetcher->response_writer());
-    entry.set_response_id(fetcher->response_writer()->response_id());
-    entry.set_response_size(fetcher->response_writer()->amount_written());
-    if (!inprogress_cache_->AddOrModifyEntry(url, entry))
-      duplicate_response_ids_.push_back(entry.response_id());
+    if (fetcher->ResponseMatchesExistingEntry()) {
+      // The server ignored our conditional request and sent the unchanged
+      // resource again. Keep sharing the stored copy with the newest cache
+      // instead of storing a second one.
+      duplicate_response_ids_.push_back(
+          fetcher->response_writer()->response_id());
+      entry.set_response_id(fetcher->existing_entry().response_id());
+      entry.set_response_size(fetcher->existing_entry().response_size());
+      inprogress_cache_->AddOrModifyEntry(url, entry);
+    } else {
+      // Associate storage with the new entry.
+      entry.set_response_id(fetcher->response_writer()->response_id());
+      entry.set_response_size(fetcher->response_writer()->amount_written());
+      if (!inprogress_cache_->AddOrModifyEntry(url, entry))
+        duplicate_response_ids_.push_back(entry.response_id());
+    }
 
     // TODO(michaeln): Check for <html manifest=xxx>
     // See http://code.google.com/p/chromium/issues/detail?id=97930
@@ -119,6 +119,11 @@ class WEBKIT_STORAGE_BROWSER_EXPORT AppCacheUpdateJob
       existing_entry_ = entry;
     }
 
+    // Returns true if the response just written has the same strong ETag as
+    // the existing entry, which means the server sent the stored resource
+    // again rather than a 304.
+    bool ResponseMatchesExistingEntry() const;
+
    private:
     // URLRequest::Delegate overrides
     virtual void OnReceivedRedirect(net::URLRequest* request,
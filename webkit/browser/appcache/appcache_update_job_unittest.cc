@@ -546,6 +546,31 @@ class IfModifiedSinceJobFactory
   }
 };
 
+// Serves files/explicit1 with an ETag header, ignoring any conditional
+// request headers, and defers everything else to the MockHttpServer.
+class ETagJobFactory : public net::URLRequestJobFactory::ProtocolHandler {
+ public:
+  explicit ETagJobFactory(const std::string& etag) : etag_(etag) {}
+
+  virtual net::URLRequestJob* MaybeCreateJob(
+      net::URLRequest* request,
+      net::NetworkDelegate* network_delegate) const OVERRIDE {
+    if (request->url() != MockHttpServer::GetMockUrl("files/explicit1"))
+      return MockHttpServer::JobFactory(request, network_delegate);
+
+    std::string headers("HTTP/1.1 200 OK");
+    headers.push_back('\0');
+    headers.append("ETag: " + etag_);
+    headers.push_back('\0');
+    headers.push_back('\0');
+    return new net::URLRequestTestJob(
+        request, network_delegate, headers, "explicit1", true);
+  }
+
+ private:
+  std::string etag_;
+};
+
 class IOThread : public base::Thread {
  public:
   explicit IOThread(const char* name)
@@ -1372,6 +1397,91 @@ class AppCacheUpdateJobTest : public testing::Test,
     // Start update after data write completes asynchronously.
   }
 
+  void UpgradeStrongETagReuseTest() {
+    UpgradeWithResentETag("\"LadeDade\"", true);
+  }
+
+  void UpgradeWeakETagNoReuseTest() {
+    UpgradeWithResentETag("W/\"LadeDade\"", false);
+  }
+
+  // Seeds the newest cache with an explicit1 response carrying |etag| that
+  // must be revalidated, then has the server resend it with a 200 and the
+  // same |etag|.
+  void UpgradeWithResentETag(const std::string& etag, bool expect_reuse) {
+    ASSERT_EQ(base::MessageLoop::TYPE_IO, base::MessageLoop::current()->type());
+
+    net::URLRequestJobFactoryImpl* new_factory(
+        new net::URLRequestJobFactoryImpl);
+    new_factory->SetProtocolHandler("http", new ETagJobFactory(etag));
+    io_thread_->SetNewJobFactory(new_factory);
+
+    MakeService();
+    group_ = new AppCacheGroup(
+        service_->storage(), MockHttpServer::GetMockUrl("files/manifest1"),
+        service_->storage()->NewGroupId());
+    AppCacheUpdateJob* update =
+        new AppCacheUpdateJob(service_.get(), group_.get());
+    group_->update_job_ = update;
+
+    AppCache* cache = MakeCacheForGroup(service_->storage()->NewCacheId(), 42);
+    MockFrontend* frontend = MakeMockFrontend();
+    AppCacheHost* host = MakeHost(1, frontend);
+    host->AssociateCompleteCache(cache);
+
+    // Give the newest cache an entry that is in storage.
+    response_writer_.reset(
+        service_->storage()->CreateResponseWriter(group_->manifest_url(),
+                                                  group_->group_id()));
+    cache->AddEntry(MockHttpServer::GetMockUrl("files/explicit1"),
+                    AppCacheEntry(AppCacheEntry::EXPLICIT,
+                                  response_writer_->response_id()));
+
+    // Set up checks for when update job finishes. Without an expected
+    // response id, the checks require explicit1 to get a new response.
+    do_checks_after_update_finished_ = true;
+    expect_group_obsolete_ = false;
+    expect_group_has_cache_ = true;
+    expect_old_cache_ = cache;
+    if (expect_reuse) {
+      expect_response_ids_.insert(
+          std::map<GURL, int64>::value_type(
+              MockHttpServer::GetMockUrl("files/explicit1"),
+              response_writer_->response_id()));
+    }
+    tested_manifest_ = MANIFEST1;
+    MockFrontend::HostIds ids(1, host->host_id());
+    frontend->AddExpectedEvent(ids, CHECKING_EVENT);
+    frontend->AddExpectedEvent(ids, DOWNLOADING_EVENT);
+    frontend->AddExpectedEvent(ids, PROGRESS_EVENT);
+    frontend->AddExpectedEvent(ids, PROGRESS_EVENT);
+    frontend->AddExpectedEvent(ids, PROGRESS_EVENT);  // final
+    frontend->AddExpectedEvent(ids, UPDATE_READY_EVENT);
+
+    // Seed storage with http response info for entry that has an ETag but
+    // is expired, so the update job has to fetch it again.
+    std::string data("HTTP/1.1 200 OK");
+    data.push_back('\0');
+    data.append("Expires: Thu, 01 Dec 1994 16:00:00 GMT");
+    data.push_back('\0');
+    data.append("ETag: " + etag);
+    data.push_back('\0');
+    data.push_back('\0');
+    net::HttpResponseHeaders* headers = new net::HttpResponseHeaders(data);
+    net::HttpResponseInfo* response_info = new net::HttpResponseInfo();
+    response_info->request_time = base::Time::Now();
+    response_info->response_time = base::Time::Now();
+    response_info->headers = headers;  // adds ref to headers
+    scoped_refptr<HttpResponseInfoIOBuffer> io_buffer(
+        new HttpResponseInfoIOBuffer(response_info));  // adds ref to info
+    response_writer_->WriteInfo(
+        io_buffer.get(),
+        base::Bind(&AppCacheUpdateJobTest::StartUpdateAfterSeedingStorageData,
+                   base::Unretained(this)));
+
+    // Start update after data write completes asynchronously.
+  }
+
   void UpgradeSuccessMergedTypesTest() {
     ASSERT_EQ(base::MessageLoop::TYPE_IO, base::MessageLoop::current()->type());
 
@@ -3548,6 +3658,14 @@ TEST_F(AppCacheUpdateJobTest, UpgradeLoadFromNewestCacheVaryHeader) {
       &AppCacheUpdateJobTest::UpgradeLoadFromNewestCacheVaryHeaderTest);
 }
 
+TEST_F(AppCacheUpdateJobTest, UpgradeStrongETagReuse) {
+  RunTestOnIOThread(&AppCacheUpdateJobTest::UpgradeStrongETagReuseTest);
+}
+
+TEST_F(AppCacheUpdateJobTest, UpgradeWeakETagNoReuse) {
+  RunTestOnIOThread(&AppCacheUpdateJobTest::UpgradeWeakETagNoReuseTest);
+}
+
 TEST_F(AppCacheUpdateJobTest, UpgradeSuccessMergedTypes) {
   RunTestOnIOThread(&AppCacheUpdateJobTest::UpgradeSuccessMergedTypesTest);
 }
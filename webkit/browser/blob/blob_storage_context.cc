@@ -4,6 +4,8 @@
 
 #include "webkit/browser/blob/blob_storage_context.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/location.h"
 #include "base/logging.h"
@@ -242,6 +244,18 @@ bool BlobStorageContext::ExpandStorageItems(
     }
   }
 
+  // Count the source items the range covers, each of which becomes one
+  // target item, so the target's item list grows at most once.
+  size_t item_count = 0;
+  uint64 remaining = length + offset;
+  for (std::vector<BlobData::Item>::const_iterator count_iter = iter;
+       count_iter != src_blob_data->items().end() && remaining > 0;
+       ++count_iter) {
+    ++item_count;
+    remaining -= std::min(remaining, count_iter->length());
+  }
+  target_blob_data->ReserveAdditionalItems(item_count);
+
   for (; iter != src_blob_data->items().end() && length > 0; ++iter) {
     uint64 current_length = iter->length() - offset;
     uint64 new_length = current_length > length ? length : current_length;
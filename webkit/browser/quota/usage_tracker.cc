@@ -328,6 +328,48 @@ void ClientUsageTracker::GetGlobalUsage(const GlobalUsageCallback& callback) {
     return;
   }
 
+  if (global_usage_retrieved_) {
+    // Everything but the non-cached origins is already in the global totals,
+    // so ask the client about just those rather than listing and walking
+    // every origin again.
+    AccumulateInfo* info = new AccumulateInfo;
+    info->limited_usage = global_limited_usage_;
+    info->unlimited_usage = global_unlimited_usage_;
+    info->pending_jobs = 1;
+    for (OriginSetByHost::iterator host_itr =
+             non_cached_limited_origins_by_host_.begin();
+         host_itr != non_cached_limited_origins_by_host_.end(); ++host_itr)
+      info->pending_jobs += host_itr->second.size();
+    for (OriginSetByHost::iterator host_itr =
+             non_cached_unlimited_origins_by_host_.begin();
+         host_itr != non_cached_unlimited_origins_by_host_.end(); ++host_itr)
+      info->pending_jobs += host_itr->second.size();
+
+    NonCachedUsageAccumulator accumulator = base::Bind(
+        &ClientUsageTracker::AccumulateNonCachedOriginUsage, AsWeakPtr(),
+        base::Owned(info), callback);
+    for (OriginSetByHost::iterator host_itr =
+             non_cached_limited_origins_by_host_.begin();
+         host_itr != non_cached_limited_origins_by_host_.end(); ++host_itr) {
+      for (std::set<GURL>::iterator origin_itr = host_itr->second.begin();
+           origin_itr != host_itr->second.end(); ++origin_itr)
+        client_->GetOriginUsage(*origin_itr, type_,
+                                base::Bind(accumulator, false));
+    }
+    for (OriginSetByHost::iterator host_itr =
+             non_cached_unlimited_origins_by_host_.begin();
+         host_itr != non_cached_unlimited_origins_by_host_.end(); ++host_itr) {
+      for (std::set<GURL>::iterator origin_itr = host_itr->second.begin();
+           origin_itr != host_itr->second.end(); ++origin_itr)
+        client_->GetOriginUsage(*origin_itr, type_,
+                                base::Bind(accumulator, true));
+    }
+
+    // Fire the sentinel as we've now called GetOriginUsage for all origins.
+    accumulator.Run(false, 0);
+    return;
+  }
+
   client_->GetOriginsForType(type_, base::Bind(
       &ClientUsageTracker::DidGetOriginsForGlobalUsage, AsWeakPtr(),
       callback));
@@ -357,12 +399,14 @@ void ClientUsageTracker::UpdateUsageCache(
     if (!IsUsageCacheEnabledForOrigin(origin))
       return;
 
-    cached_usage_by_host_[host][origin] += delta;
+    // This runs on every write that reports usage, so look the entry up once.
+    int64* usage = &cached_usage_by_host_[host][origin];
+    *usage += delta;
     if (IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
     else
       global_limited_usage_ += delta;
-    DCHECK_GE(cached_usage_by_host_[host][origin], 0);
+    DCHECK_GE(*usage, 0);
     DCHECK_GE(global_limited_usage_, 0);
     return;
   }
@@ -442,6 +486,24 @@ void ClientUsageTracker::AccumulateLimitedOriginUsage(
   callback.Run(info->limited_usage);
 }
 
+void ClientUsageTracker::AccumulateNonCachedOriginUsage(
+    AccumulateInfo* info,
+    const GlobalUsageCallback& callback,
+    bool is_unlimited,
+    int64 usage) {
+  if (usage < 0)
+    usage = 0;
+  if (is_unlimited)
+    info->unlimited_usage += usage;
+  else
+    info->limited_usage += usage;
+  if (--info->pending_jobs)
+    return;
+
+  callback.Run(info->limited_usage + info->unlimited_usage,
+               info->unlimited_usage);
+}
+
 void ClientUsageTracker::DidGetOriginsForGlobalUsage(
     const GlobalUsageCallback& callback,
     const std::set<GURL>& origins) {
@@ -96,6 +96,8 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
                               int64 unlimited_usage)> HostUsageAccumulator;
   typedef base::Callback<void(const GURL& origin,
                               int64 usage)> OriginUsageAccumulator;
+  typedef base::Callback<void(bool is_unlimited,
+                              int64 usage)> NonCachedUsageAccumulator;
   typedef std::map<std::string, std::set<GURL> > OriginSetByHost;
 
   ClientUsageTracker(UsageTracker* tracker,
@@ -135,6 +137,10 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   void AccumulateLimitedOriginUsage(AccumulateInfo* info,
                                     const UsageCallback& callback,
                                     int64 usage);
+  void AccumulateNonCachedOriginUsage(AccumulateInfo* info,
+                                      const GlobalUsageCallback& callback,
+                                      bool is_unlimited,
+                                      int64 usage);
   void DidGetOriginsForGlobalUsage(const GlobalUsageCallback& callback,
                                    const std::set<GURL>& origins);
   void AccumulateHostUsage(AccumulateInfo* info,
@@ -4,6 +4,8 @@
 
 #include "webkit/common/blob/blob_data.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "base/strings/sys_string_conversions.h"
 #include "base/strings/utf_string_conversions.h"
@@ -24,6 +26,13 @@ void BlobData::AppendData(const char* data, size_t length) {
   items_.back().SetToBytes(data, length);
 }
 
+void BlobData::ReserveAdditionalItems(size_t count) {
+  const size_t needed = items_.size() + count;
+  // Keep growing geometrically so that repeated calls stay amortized.
+  if (needed > items_.capacity())
+    items_.reserve(std::max(needed, 2 * items_.capacity()));
+}
+
 void BlobData::AppendFile(const base::FilePath& file_path,
                           uint64 offset, uint64 length,
                           const base::Time& expected_modification_time) {
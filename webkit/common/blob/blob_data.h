@@ -40,6 +40,11 @@ class WEBKIT_STORAGE_COMMON_EXPORT BlobData
   void AppendFileSystemFile(const GURL& url, uint64 offset, uint64 length,
                             const base::Time& expected_modification_time);
 
+  // Makes room for |count| more items up front. Growing the item list copies
+  // every existing item, bytes included, so callers appending a known number
+  // of items use this to pay for at most one such copy.
+  void ReserveAdditionalItems(size_t count);
+
   void AttachShareableFileReference(ShareableFileReference* reference) {
     shareable_files_.push_back(reference);
   }